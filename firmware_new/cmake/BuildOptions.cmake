@@ -22,6 +22,15 @@ endif()
 
 message(STATUS "Build type: ${CMAKE_BUILD_TYPE}")
 
+# Lowest HAL_LOG* level compiled in (0=DEBUG .. 4=FATAL, 5=none); Release drops DEBUG
+if(CMAKE_BUILD_TYPE STREQUAL "Release")
+    set(LOG_COMPILE_LEVEL "1" CACHE STRING "Lowest compiled-in log level")
+else()
+    set(LOG_COMPILE_LEVEL "0" CACHE STRING "Lowest compiled-in log level")
+endif()
+add_compile_definitions(HAL_LOG_COMPILE_LEVEL=${LOG_COMPILE_LEVEL})
+message(STATUS "Log compile level: ${LOG_COMPILE_LEVEL}")
+
 # Coverage flags
 if(ENABLE_COVERAGE)
     if(CMAKE_C_COMPILER_ID MATCHES "GNU|Clang")
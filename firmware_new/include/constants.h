@@ -44,8 +44,20 @@
 #define DIAGNOSTICS_INTERVAL_MS            1000U
 #define POWER_POLL_INTERVAL_MS             500U
 #define COMM_POLL_INTERVAL_MS              100U
+#define DISCOVERY_WARM_START_BUDGET_MS     800U   // Boot probe of saved + mandatory modules
 #define DISCOVERY_POLL_INTERVAL_MS         5000U
 
+// Main-thread task periods (hal_reactor)
+#define STATE_UPDATE_INTERVAL_MS           20U
+#define SAFETY_UPDATE_INTERVAL_MS          10U
+#define POLLING_UPDATE_INTERVAL_MS         10U    // Also run as soon as a poll completes
+#define DISCOVERY_STEP_INTERVAL_MS         50U
+#define TELEMETRY_BROADCAST_INTERVAL_MS    1000U
+#define RS485_TELEMETRY_INTERVAL_MS        2000U
+#define HISTORY_MAINTAIN_INTERVAL_MS       1000U
+#define CONTROL_REPORT_INTERVAL_MS         1000U
+#define TASK_REPORT_INTERVAL_MS            30000U
+
 // Timeouts
 #define STARTUP_DEADLINE_MS                120000U
 #define STATE_TIMEOUT_MS                   5000U
@@ -10,7 +10,9 @@
 #include "estimator_1d.h"
 #include "dock_module_handler.h"
 #include "storage/module_data_storage.h"
+#include "storage/timeseries_store.h"
 #include "hal_network.h"
+#include "hal_log.h"
 
 int api_register_minimal_endpoints(void){
     // CRITICAL ENDPOINTS - Issue #112 Fix
@@ -45,6 +47,7 @@ int api_register_minimal_endpoints(void){
     // REMOVED: /api/v1/modules/config - Over-complex
     api_manager_register_endpoint("/api/v1/system/state", API_MGR_HTTP_GET, api_handle_system_state);
     api_manager_register_endpoint("/api/v1/control/status", API_MGR_HTTP_GET, api_handle_control_status);
+    api_manager_register_endpoint("/api/v1/control/timing", API_MGR_HTTP_GET, api_handle_control_timing);
     // Motion endpoints per EXEC PLAN Gate E
     api_manager_register_endpoint("/api/v1/motion/segment/start", API_MGR_HTTP_POST, api_handle_motion_segment_start);
     api_manager_register_endpoint("/api/v1/motion/segment/stop",  API_MGR_HTTP_POST, api_handle_motion_segment_stop);
@@ -88,15 +91,22 @@ int api_register_minimal_endpoints(void){
     // REMOVED: Backward compatibility routes - Không cần thiết
     
     // CRITICAL: Module Data Access APIs - Issue #140
-    api_manager_register_endpoint("/api/v1/modules/{id}/telemetry", API_MGR_HTTP_GET, api_handle_module_telemetry);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/telemetry", API_MGR_HTTP_GET, api_handle_module_telemetry);
     // Removed enhanced-specific endpoints; basic telemetry now includes ranges (Issue #143)
-    api_manager_register_endpoint("/api/v1/modules/{id}/config", API_MGR_HTTP_GET, api_handle_module_config_get);
-    api_manager_register_endpoint("/api/v1/modules/{id}/config", API_MGR_HTTP_POST, api_handle_module_config_set);
-    api_manager_register_endpoint("/api/v1/modules/{id}/command", API_MGR_HTTP_POST, api_handle_module_command);
-    api_manager_register_endpoint("/api/v1/modules/{id}/history", API_MGR_HTTP_GET, api_handle_module_history);
-    api_manager_register_endpoint("/api/v1/modules/{id}/health", API_MGR_HTTP_GET, api_handle_module_health);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/config", API_MGR_HTTP_GET, api_handle_module_config_get);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/config", API_MGR_HTTP_POST, api_handle_module_config_set);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/command", API_MGR_HTTP_POST, api_handle_module_command);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/history", API_MGR_HTTP_GET, api_handle_module_history);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/health", API_MGR_HTTP_GET, api_handle_module_health);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/status", API_MGR_HTTP_GET, api_handle_module_status_by_id);
+    
+    // Logging diagnostics: per-component levels and per-module Modbus frame trace
+    api_manager_register_endpoint("/api/v1/system/log-levels", API_MGR_HTTP_GET, api_handle_log_levels_get);
+    api_manager_register_endpoint("/api/v1/system/log-levels", API_MGR_HTTP_POST, api_handle_log_levels_set);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/trace", API_MGR_HTTP_GET, api_handle_module_trace_get);
+    api_manager_register_endpoint("/api/v1/modules/{id:u8}/trace", API_MGR_HTTP_POST, api_handle_module_trace_set);
     
-    return 0; // dynamic /api/v1/modules/{id}/status handled by router
+    return 0;
 }
 
 int api_handle_system_status(const api_mgr_http_request_t *req, api_mgr_http_response_t *res){
@@ -125,22 +135,15 @@ int api_handle_modules_list(const api_mgr_http_request_t *req, api_mgr_http_resp
     memset(arr, 0, sizeof(arr));
     
     if (registry_get_all(arr, MODULE_REGISTRY_MAX_MODULES, &count) != 0) {
-        const char *empty_json = "{\"success\":true,\"data\":{\"modules\":[]}}";
-        return api_manager_create_success_response(res, empty_json);
-    }
-    
-    // If no modules found, return empty array
-    if (count == 0) {
-        const char *empty_json = "{\"success\":true,\"data\":{\"modules\":[]}}";
-        return api_manager_create_success_response(res, empty_json);
+        count = 0;
     }
     
     // Build JSON with data validation (same as rs485_modules)
-    char buffer[2048];
-    size_t pos = 0;
-    pos += snprintf(buffer + pos, sizeof(buffer) - pos, "{\"success\":true,\"data\":{\"modules\":[");
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 2048);
+    json_writer_key(&w, "modules");
+    json_writer_begin_array(&w);
     
-    size_t valid_modules = 0;
     for (size_t i = 0; i < count; ++i) {
         const module_info_t *m = &arr[i];
         
@@ -162,22 +165,17 @@ int api_handle_modules_list(const api_mgr_http_request_t *req, api_mgr_http_resp
             if (safe_version[j] < 32 || safe_version[j] > 126) safe_version[j] = '?';
         }
         
-        // Check buffer space before writing
-        size_t remaining = sizeof(buffer) - pos;
-        if (remaining < 200) break; // Need at least 200 bytes for JSON entry + closing
-        
-        int written = snprintf(buffer + pos, remaining,
-            "%s{\"address\":%u,\"type\":%u,\"name\":\"%s\",\"status\":%u,\"version\":\"%s\"}",
-            (valid_modules > 0) ? "," : "", m->address, (unsigned)m->type, safe_name, (unsigned)m->status, safe_version);
-        
-        if (written < 0 || written >= (int)remaining) break; // Buffer overflow protection
-        pos += written;
-        valid_modules++;
+        json_writer_begin_object(&w);
+        json_writer_field_uint(&w, "address", m->address);
+        json_writer_field_uint(&w, "type", (unsigned)m->type);
+        json_writer_field_string(&w, "name", safe_name);
+        json_writer_field_uint(&w, "status", (unsigned)m->status);
+        json_writer_field_string(&w, "version", safe_version);
+        json_writer_end_object(&w);
     }
     
-    pos += snprintf(buffer + pos, sizeof(buffer) - pos, "]}}");
-    
-    return api_manager_create_success_response(res, buffer);
+    json_writer_end_array(&w);
+    return api_manager_json_end_data(res, &w);
 }
 
 
@@ -203,42 +201,22 @@ int api_handle_system_state(const api_mgr_http_request_t *req, api_mgr_http_resp
     system_state_machine_get_state_statistics(&stats);
     
     // Build comprehensive response with REAL data
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"current_state\":\"%s\","
-            "\"previous_state\":\"%s\","
-            "\"state_duration_ms\":%lu,"
-            "\"total_transitions\":%u,"
-            "\"system_ready\":%s,"
-            "\"safety_ok\":%s,"
-            "\"communication_ok\":%s,"
-            "\"sensors_ok\":%s,"
-            "\"location_ok\":%s,"
-            "\"last_event\":\"%s\","
-            "\"current_fault\":\"%s\","
-            "\"state_timeout_ms\":%u,"
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        system_state_machine_get_state_name(status.current_state),
-        system_state_machine_get_state_name(status.previous_state),
-        (hal_get_timestamp_us() - status.state_entry_time) / 1000,
-        status.state_transition_count,
-        status.system_ready ? "true" : "false",
-        status.safety_ok ? "true" : "false",
-        status.communication_ok ? "true" : "false",
-        status.sensors_ok ? "true" : "false",
-        status.location_ok ? "true" : "false",
-        system_state_machine_get_event_name(status.last_event),
-        system_state_machine_get_fault_name(status.current_fault),
-        status.state_timeout_ms,
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_string(&w, "current_state", system_state_machine_get_state_name(status.current_state));
+    json_writer_field_string(&w, "previous_state", system_state_machine_get_state_name(status.previous_state));
+    json_writer_field_uint(&w, "state_duration_ms", (hal_get_timestamp_us() - status.state_entry_time) / 1000);
+    json_writer_field_uint(&w, "total_transitions", status.state_transition_count);
+    json_writer_field_bool(&w, "system_ready", status.system_ready);
+    json_writer_field_bool(&w, "safety_ok", status.safety_ok);
+    json_writer_field_bool(&w, "communication_ok", status.communication_ok);
+    json_writer_field_bool(&w, "sensors_ok", status.sensors_ok);
+    json_writer_field_bool(&w, "location_ok", status.location_ok);
+    json_writer_field_string(&w, "last_event", system_state_machine_get_event_name(status.last_event));
+    json_writer_field_string(&w, "current_fault", system_state_machine_get_fault_name(status.current_fault));
+    json_writer_field_uint(&w, "state_timeout_ms", status.state_timeout_ms);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    return api_manager_json_end_data(res, &w);
 }
 
 int api_handle_control_status(const api_mgr_http_request_t *req, api_mgr_http_response_t *res){
@@ -246,6 +224,69 @@ int api_handle_control_status(const api_mgr_http_request_t *req, api_mgr_http_re
     return api_manager_create_success_response(res, json);
 }
 
+#include "control_executor.h"
+
+/**
+ * @brief Append a histogram as a JSON array
+ */
+/**
+ * @brief Append a histogram as a JSON array
+ */
+static void api_append_histogram(json_writer_t *w, const char *key, const uint64_t *hist)
+{
+    json_writer_key(w, key);
+    json_writer_begin_array(w);
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        json_writer_uint(w, hist[b]);
+    }
+    json_writer_end_array(w);
+}
+
+int api_handle_control_timing(const api_mgr_http_request_t *req, api_mgr_http_response_t *res){
+    (void)req;
+    control_executor_stats_t stats;
+    (void)control_executor_get_stats(&stats);
+
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1536);
+    json_writer_field_bool(&w, "running", stats.running);
+    json_writer_field_bool(&w, "realtime", stats.realtime);
+    json_writer_field_bool(&w, "memory_locked", stats.memory_locked);
+    json_writer_field_int(&w, "cpu", stats.cpu);
+    json_writer_field_uint(&w, "period_us", stats.period_us);
+    json_writer_field_uint(&w, "cycles", stats.cycles);
+    json_writer_field_uint(&w, "overruns", stats.overruns);
+    json_writer_field_uint(&w, "missed_deadlines", stats.missed_deadlines);
+    json_writer_field_uint(&w, "interlock_trips", stats.interlock_trips);
+    json_writer_key(&w, "jitter_us");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "avg", (double)stats.jitter_avg_us, 1);
+    json_writer_field_uint(&w, "p99", stats.jitter_p99_us);
+    json_writer_field_uint(&w, "max", stats.jitter_max_us);
+    api_append_histogram(&w, "histogram", stats.jitter_hist);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "exec_us");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "avg", (double)stats.exec_avg_us, 1);
+    json_writer_field_uint(&w, "p99", stats.exec_p99_us);
+    json_writer_field_uint(&w, "max", stats.exec_max_us);
+    api_append_histogram(&w, "histogram", stats.exec_hist);
+    json_writer_end_object(&w);
+    // Upper edge of each bucket; the last one is open-ended
+    json_writer_key(&w, "bucket_upper_us");
+    json_writer_begin_array(&w);
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        uint32_t limit = control_executor_bucket_limit_us(b);
+        if (limit == UINT32_MAX) {
+            json_writer_null(&w);
+        } else {
+            json_writer_uint(&w, limit);
+        }
+    }
+    json_writer_end_array(&w);
+    return api_manager_json_end_data(res, &w);
+}
+
 // --- Motion API handlers ---
 #include "control_loop.h"
 #include "safety_monitor.h"
@@ -284,12 +325,21 @@ int api_handle_motion_state(const api_mgr_http_request_t *req, api_mgr_http_resp
     float remaining = 0.0f; // Backend supplies; optional future wiring
     const char *docking_state = "IDLE";
 
-    char buf[640];
-    snprintf(buf, sizeof(buf),
-        "{\"success\":true,\"data\":{\"x_est\":%.3f,\"v\":%.3f,\"remaining\":%.3f,\"safety\":{\"estop\":%s,\"p95\":%u},\"docking\":\"%s\",\"freshness_ms\":%u,\"health\":%s,\"target_v\":%.3f}}",
-        est.x_est_mm, est.v_mm_s, remaining, estop?"true":"false", estop_p95, docking_state,
-        est.freshness_ms, est.health_online?"true":"false", st.target_velocity);
-    return api_manager_create_success_response(res, buf);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 640);
+    json_writer_field_fixed(&w, "x_est", (double)est.x_est_mm, 3);
+    json_writer_field_fixed(&w, "v", (double)est.v_mm_s, 3);
+    json_writer_field_fixed(&w, "remaining", (double)remaining, 3);
+    json_writer_key(&w, "safety");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "estop", estop);
+    json_writer_field_uint(&w, "p95", estop_p95);
+    json_writer_end_object(&w);
+    json_writer_field_string(&w, "docking", docking_state);
+    json_writer_field_uint(&w, "freshness_ms", est.freshness_ms);
+    json_writer_field_bool(&w, "health", est.health_online);
+    json_writer_field_fixed(&w, "target_v", (double)st.target_velocity, 3);
+    return api_manager_json_end_data(res, &w);
 }
 
 int api_handle_modules_stats(const api_mgr_http_request_t *req, api_mgr_http_response_t *res){
@@ -298,14 +348,17 @@ int api_handle_modules_stats(const api_mgr_http_request_t *req, api_mgr_http_res
     if (module_manager_get_statistics(&stats) != HAL_STATUS_OK) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "cannot read stats");
     }
-    // Simple JSON assembly (avoid heavy deps)
-    char buf[512];
-    snprintf(buf, sizeof(buf),
-             "{\"success\":true,\"data\":{\"total_modules\":%u,\"online_modules\":%u,\"offline_modules\":%u,\"discovery_total_ms\":%u,\"p95_ms\":%u,\"p99_ms\":%u,\"health_timeouts\":%u,\"crc_errors\":%u}}",
-             stats.total_modules, stats.online_modules, stats.offline_modules,
-             stats.discovery_total_ms, stats.discovery_p95_ms, stats.discovery_p99_ms,
-             stats.health_timeouts, stats.error_count);
-    return api_manager_create_success_response(res, buf);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 512);
+    json_writer_field_uint(&w, "total_modules", stats.total_modules);
+    json_writer_field_uint(&w, "online_modules", stats.online_modules);
+    json_writer_field_uint(&w, "offline_modules", stats.offline_modules);
+    json_writer_field_uint(&w, "discovery_total_ms", stats.discovery_total_ms);
+    json_writer_field_uint(&w, "p95_ms", stats.discovery_p95_ms);
+    json_writer_field_uint(&w, "p99_ms", stats.discovery_p99_ms);
+    json_writer_field_uint(&w, "health_timeouts", stats.health_timeouts);
+    json_writer_field_uint(&w, "crc_errors", stats.error_count);
+    return api_manager_json_end_data(res, &w);
 }
 
 int api_handle_modules_scan(const api_mgr_http_request_t *req, api_mgr_http_response_t *res){
@@ -317,11 +370,18 @@ int api_handle_modules_scan(const api_mgr_http_request_t *req, api_mgr_http_resp
     // Get current module statistics
     module_stats_t stats;
     if (module_manager_get_statistics(&stats) == HAL_STATUS_OK) {
-        char json_buf[256];
-        snprintf(json_buf, sizeof(json_buf), 
-                "{\"success\":true,\"message\":\"scan status\",\"data\":{\"total_modules\":%d,\"online_modules\":%d,\"discovery_count\":%u,\"last_scan_ms\":%u}}",
-                stats.total_modules, stats.online_modules, stats.discovery_count, stats.discovery_total_ms);
-        return api_manager_create_success_response(res, json_buf);
+        json_writer_t w;
+        (void)api_manager_json_begin(&w, 256);
+        json_writer_begin_object(&w);
+        json_writer_field_bool(&w, "success", true);
+        json_writer_field_string(&w, "message", "scan status");
+        json_writer_key(&w, "data");
+        json_writer_begin_object(&w);
+        json_writer_field_uint(&w, "total_modules", stats.total_modules);
+        json_writer_field_uint(&w, "online_modules", stats.online_modules);
+        json_writer_field_uint(&w, "discovery_count", stats.discovery_count);
+        json_writer_field_uint(&w, "last_scan_ms", stats.discovery_total_ms);
+        return api_manager_json_end_data(res, &w);
     }
     
     return api_manager_create_success_response(res, "{\"success\":true,\"message\":\"scan status available\"}");
@@ -333,11 +393,14 @@ int api_handle_modules_config_get(const api_mgr_http_request_t *req, api_mgr_htt
     if (module_manager_get_config(&cfg) != HAL_STATUS_OK) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "cannot read config");
     }
-    char buf[384];
-    snprintf(buf, sizeof(buf),
-             "{\"success\":true,\"data\":{\"health_interval_ms\":%u,\"offline_threshold_ms\":%u,\"retry\":%u,\"response_timeout_ms\":%u,\"health_jitter_percent\":%u}}",
-             cfg.health_check_interval_ms, cfg.offline_threshold_ms, cfg.retry_count, cfg.response_timeout_ms, cfg.health_jitter_percent);
-    return api_manager_create_success_response(res, buf);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 384);
+    json_writer_field_uint(&w, "health_interval_ms", cfg.health_check_interval_ms);
+    json_writer_field_uint(&w, "offline_threshold_ms", cfg.offline_threshold_ms);
+    json_writer_field_uint(&w, "retry", cfg.retry_count);
+    json_writer_field_uint(&w, "response_timeout_ms", cfg.response_timeout_ms);
+    json_writer_field_uint(&w, "health_jitter_percent", cfg.health_jitter_percent);
+    return api_manager_json_end_data(res, &w);
 }
 
 // ============================================================================
@@ -369,28 +432,17 @@ int api_handle_lidar_status(const api_mgr_http_request_t *req, api_mgr_http_resp
     hal_status_t hal_status = hal_lidar_get_device_status(&device_info);
     
     if (hal_status == HAL_STATUS_OK) {
-        char json[512];
-        snprintf(json, sizeof(json),
-            "{\"success\":true,\"data\":{"
-            "\"device_type\":%d,"
-            "\"status\":%d,"
-            "\"device_id\":%u,"
-            "\"device_name\":\"%s\","
-            "\"device_version\":\"%s\","
-            "\"timestamp_us\":%lu,"
-            "\"error_count\":%u,"
-            "\"warning_count\":%u"
-            "}}",
-            device_info.device_type,
-            device_info.status,
-            device_info.device_id,
-            device_info.device_name,
-            device_info.device_version,
-            device_info.timestamp_us,
-            device_info.error_count,
-            device_info.warning_count
-        );
-        return api_manager_create_success_response(res, json);
+        json_writer_t w;
+        (void)api_manager_json_begin_data(&w, 512);
+        json_writer_field_int(&w, "device_type", (int64_t)device_info.device_type);
+        json_writer_field_int(&w, "status", (int64_t)device_info.status);
+        json_writer_field_uint(&w, "device_id", device_info.device_id);
+        json_writer_field_string(&w, "device_name", device_info.device_name);
+        json_writer_field_string(&w, "device_version", device_info.device_version);
+        json_writer_field_uint(&w, "timestamp_us", device_info.timestamp_us);
+        json_writer_field_uint(&w, "error_count", device_info.error_count);
+        json_writer_field_uint(&w, "warning_count", device_info.warning_count);
+        return api_manager_json_end_data(res, &w);
     } else {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR status");
     }
@@ -400,39 +452,35 @@ int api_handle_lidar_status(const api_mgr_http_request_t *req, api_mgr_http_resp
 int api_handle_lidar_scan_data(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     (void)req;
     
-    lidar_scan_data_t scan_data;
-    hal_status_t hal_status = hal_lidar_get_scan_data(&scan_data);
+    // Shared read-only view of the latest frame; released before every return
+    lidar_frame_view_t frame;
+    hal_status_t hal_status = hal_lidar_acquire_frame(&frame);
+    const lidar_scan_data_t *scan_data = frame.scan;
     
-    if (hal_status == HAL_STATUS_OK && scan_data.scan_complete) {
+    if (hal_status == HAL_STATUS_OK && scan_data->scan_complete) {
         // Build JSON response with scan data
-        char json[4096];
-        size_t pos = 0;
-        
-        pos += snprintf(json + pos, sizeof(json) - pos,
-            "{\"success\":true,\"data\":{"
-            "\"scan_complete\":%s,"
-            "\"point_count\":%u,"
-            "\"timestamp_us\":%lu,"
-            "\"points\":[",
-            scan_data.scan_complete ? "true" : "false",
-            scan_data.point_count,
-            scan_data.scan_timestamp_us
-        );
+        json_writer_t w;
+        (void)api_manager_json_begin_data(&w, 4096);
+        json_writer_field_bool(&w, "scan_complete", scan_data->scan_complete);
+        json_writer_field_uint(&w, "point_count", scan_data->point_count);
+        json_writer_field_uint(&w, "timestamp_us", scan_data->scan_timestamp_us);
+        json_writer_key(&w, "points");
+        json_writer_begin_array(&w);
         
         // Add point data (limit to first 50 points for JSON size)
-        for (uint16_t i = 0; i < scan_data.point_count && i < 50; i++) {
-            pos += snprintf(json + pos, sizeof(json) - pos,
-                "%s{\"distance\":%u,\"angle\":%d,\"quality\":%u}",
-                (i > 0) ? "," : "",
-                scan_data.points[i].distance_mm,
-                scan_data.points[i].angle_deg,
-                scan_data.points[i].quality
-            );
+        for (uint16_t i = 0; i < scan_data->point_count && i < 50; i++) {
+            json_writer_begin_object(&w);
+            json_writer_field_uint(&w, "distance", scan_data->distance_mm[i]);
+            json_writer_field_int(&w, "angle", lidar_angle_q6_to_deg(scan_data->angle_q6[i]));
+            json_writer_field_uint(&w, "quality", scan_data->quality[i]);
+            json_writer_end_object(&w);
         }
         
-        pos += snprintf(json + pos, sizeof(json) - pos, "]}}");
-        return api_manager_create_success_response(res, json);
+        json_writer_end_array(&w);
+        hal_lidar_release_frame(&frame);
+        return api_manager_json_end_data(res, &w);
     } else {
+        hal_lidar_release_frame(&frame);
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR scan data");
     }
 }
@@ -451,78 +499,53 @@ int api_handle_lidar_scan_frame_full(const api_mgr_http_request_t *req, api_mgr_
         if (sscanf(q, "%*[^t]timeout_ms=%d", &v)==1) timeout_ms = v;
     }
     
-    lidar_scan_data_t scan_data;
-    hal_status_t hal_status = hal_lidar_get_scan_data(&scan_data);
+    // Shared read-only view of the latest frame; released before every return
+    lidar_frame_view_t frame;
+    hal_status_t hal_status = hal_lidar_acquire_frame(&frame);
     
-    // If block_until_rotation is enabled, wait for complete scan
-    if (block_until_rotation && hal_status == HAL_STATUS_OK && !scan_data.scan_complete) {
-        int max_attempts = timeout_ms / 100; // Check every 100ms
-        int attempts = 0;
-        
-        while (attempts < max_attempts && !scan_data.scan_complete) {
-            usleep(100000); // 100ms
-            hal_status = hal_lidar_get_scan_data(&scan_data);
-            attempts++;
-        }
-        
-        if (!scan_data.scan_complete) {
+    // If block_until_rotation is enabled, wait for the first complete frame
+    if (block_until_rotation && hal_status == HAL_STATUS_NOT_FOUND) {
+        hal_status = hal_lidar_wait_frame(0, timeout_ms > 0 ? (uint32_t)timeout_ms : 0U, &frame);
+        if (hal_status == HAL_STATUS_TIMEOUT) {
             return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Timeout waiting for complete rotation");
         }
     }
     
-    if (hal_status != HAL_STATUS_OK || !scan_data.scan_complete) {
+    if (hal_status != HAL_STATUS_OK || !frame.scan->scan_complete) {
+        hal_lidar_release_frame(&frame);
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR full frame");
     }
+    const lidar_scan_data_t *scan_data = frame.scan;
 
-    // Build JSON with ALL points (or limited)
-    // Estimate needed size: header ~128 + per point ~32 bytes
-    size_t estimated = 256 + (size_t)scan_data.point_count * 40;
-    char *json = (char*)malloc(estimated);
-    if (!json) {
-        return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory");
-    }
-    size_t pos = 0; 
-    pos += snprintf(json + pos, estimated - pos,
-        "{\"success\":true,\"data\":{\"scan_complete\":%s,\"point_count\":%u,\"timestamp_us\":%lu,\"points\":[",
-        scan_data.scan_complete ? "true" : "false",
-        scan_data.point_count,
-        scan_data.scan_timestamp_us);
+    // Build JSON with ALL points (or limited); ~40 bytes per point
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 256 + (size_t)scan_data->point_count * 40);
+    json_writer_field_bool(&w, "scan_complete", scan_data->scan_complete);
+    json_writer_field_uint(&w, "point_count", scan_data->point_count);
+    json_writer_field_uint(&w, "timestamp_us", scan_data->scan_timestamp_us);
+    json_writer_key(&w, "points");
+    json_writer_begin_array(&w);
 
     uint16_t actual_count = 0;
-    for (uint16_t i = 0; i < scan_data.point_count; i++) {
+    for (uint16_t i = 0; i < scan_data->point_count; i++) {
         if (limit > 0 && actual_count >= limit) break;
         
-        if (pos + 64 >= estimated) {
-            // grow buffer
-            size_t new_size = estimated * 2;
-            char *tmp = (char*)realloc(json, new_size);
-            if (!tmp) { free(json); return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory"); }
-            json = tmp; estimated = new_size;
-        }
-        
-        int ang = scan_data.points[i].angle_deg;
+        int ang = lidar_angle_q6_to_deg(scan_data->angle_q6[i]);
         int ang_norm = ((ang % 360) + 360) % 360;
         int ang_output = normalize ? ang_norm : ang;
         
-        pos += snprintf(json + pos, estimated - pos,
-            "%s{\"distance\":%u,\"angle\":%d,\"quality\":%u}",
-            (actual_count>0)?",":"",
-            scan_data.points[i].distance_mm,
-            ang_output,
-            scan_data.points[i].quality);
+        json_writer_begin_object(&w);
+        json_writer_field_uint(&w, "distance", scan_data->distance_mm[i]);
+        json_writer_field_int(&w, "angle", ang_output);
+        json_writer_field_uint(&w, "quality", scan_data->quality[i]);
+        json_writer_end_object(&w);
         actual_count++;
     }
 
-    if (pos + 64 >= estimated) {
-        char *tmp = (char*)realloc(json, estimated + 64);
-        if (!tmp) { free(json); return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory"); }
-        json = tmp; estimated += 64;
-    }
-    pos += snprintf(json + pos, estimated - pos, "],\"actual_count\":%u}}", actual_count);
-
-    int rc = api_manager_create_success_response(res, json);
-    free(json);
-    return rc;
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "actual_count", actual_count);
+    hal_lidar_release_frame(&frame);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/lidar/scan_frame?min_deg=-30&max_deg=30&normalize=1&limit=0
@@ -545,42 +568,41 @@ int api_handle_lidar_scan_frame(const api_mgr_http_request_t *req, api_mgr_http_
     if (max_deg > 720) max_deg = 720;
     if (max_deg < min_deg) { int t = min_deg; min_deg = max_deg; max_deg = t; }
 
-    lidar_scan_data_t scan_data;
-    hal_status_t hal_status = hal_lidar_get_scan_data(&scan_data);
-    if (hal_status != HAL_STATUS_OK || !scan_data.scan_complete) {
+    // Shared read-only view of the latest frame; released before every return
+    lidar_frame_view_t frame;
+    hal_status_t hal_status = hal_lidar_acquire_frame(&frame);
+    if (hal_status != HAL_STATUS_OK || !frame.scan->scan_complete) {
+        hal_lidar_release_frame(&frame);
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR scan frame");
     }
+    const lidar_scan_data_t *scan_data = frame.scan;
 
-    size_t estimated = 256 + (size_t)scan_data.point_count * 40;
-    char *json = (char*)malloc(estimated);
-    if (!json) return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory");
-    size_t pos = 0; unsigned out_count = 0;
-    pos += snprintf(json + pos, estimated - pos,
-        "{\"success\":true,\"data\":{\"scan_complete\":%s,\"timestamp_us\":%lu,\"points\":[",
-        scan_data.scan_complete ? "true" : "false",
-        scan_data.scan_timestamp_us);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 256 + (size_t)scan_data->point_count * 40);
+    unsigned out_count = 0;
+    json_writer_field_bool(&w, "scan_complete", scan_data->scan_complete);
+    json_writer_field_uint(&w, "timestamp_us", scan_data->scan_timestamp_us);
+    json_writer_key(&w, "points");
+    json_writer_begin_array(&w);
 
-    for (uint16_t i = 0; i < scan_data.point_count; i++) {
-        int ang = scan_data.points[i].angle_deg;
+    for (uint16_t i = 0; i < scan_data->point_count; i++) {
+        int ang = lidar_angle_q6_to_deg(scan_data->angle_q6[i]);
         int ang_norm = ((ang % 360) + 360) % 360;
         int ang_eval = normalize ? ang_norm : ang;
         if (ang_eval < min_deg || ang_eval > max_deg) continue;
         if (limit > 0 && (int)out_count >= limit) break;
-        if (pos + 64 >= estimated) { size_t ns=estimated*2; char *t=(char*)realloc(json,ns); if(!t){ free(json); return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory"); } json=t; estimated=ns; }
-        pos += snprintf(json + pos, estimated - pos,
-            "%s{\"distance\":%u,\"angle\":%d,\"quality\":%u}",
-            (out_count>0)?",":"",
-            scan_data.points[i].distance_mm,
-            normalize ? ang_norm : ang,
-            scan_data.points[i].quality);
+        json_writer_begin_object(&w);
+        json_writer_field_uint(&w, "distance", scan_data->distance_mm[i]);
+        json_writer_field_int(&w, "angle", normalize ? ang_norm : ang);
+        json_writer_field_uint(&w, "quality", scan_data->quality[i]);
+        json_writer_end_object(&w);
         out_count++;
     }
 
-    if (pos + 64 >= estimated) { char *t=(char*)realloc(json,estimated+64); if(!t){ free(json); return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory"); } json=t; estimated+=64; }
-    pos += snprintf(json + pos, estimated - pos, "],\"point_count\":%u}}", out_count);
-    int rc = api_manager_create_success_response(res, json);
-    free(json);
-    return rc;
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "point_count", out_count);
+    hal_lidar_release_frame(&frame);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/lidar/scan_frame_360?reducer=max&min_q=0&max_range=0&interpolate=1
@@ -616,21 +638,24 @@ int api_handle_lidar_scan_frame_360(const api_mgr_http_request_t *req, api_mgr_h
         }
     }
 
-    lidar_scan_data_t scan_data;
-    hal_status_t hal_status = hal_lidar_get_scan_data(&scan_data);
-    if (hal_status != HAL_STATUS_OK || !scan_data.scan_complete) {
+    // Shared read-only view of the latest frame; released before every return
+    lidar_frame_view_t frame;
+    hal_status_t hal_status = hal_lidar_acquire_frame(&frame);
+    if (hal_status != HAL_STATUS_OK || !frame.scan->scan_complete) {
+        hal_lidar_release_frame(&frame);
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR scan data");
     }
+    const lidar_scan_data_t *scan_data = frame.scan;
 
     // bins initialized to 0 (no return)
     uint32_t bins[360]; memset(bins, 0, sizeof(bins));
     uint16_t counts[360]; memset(counts, 0, sizeof(counts));
 
     // accumulate
-    for (uint16_t i = 0; i < scan_data.point_count; i++) {
-        uint16_t dist = scan_data.points[i].distance_mm;
-        int ang = scan_data.points[i].angle_deg;
-        uint16_t qv = scan_data.points[i].quality;
+    for (uint16_t i = 0; i < scan_data->point_count; i++) {
+        uint16_t dist = scan_data->distance_mm[i];
+        int ang = lidar_angle_q6_to_deg(scan_data->angle_q6[i]);
+        uint16_t qv = scan_data->quality[i];
         if (qv < (uint16_t)min_q) continue;
         if (max_range > 0 && dist > (uint16_t)max_range) continue;
         int a = ((ang % 360) + 360) % 360;
@@ -648,6 +673,8 @@ int api_handle_lidar_scan_frame_360(const api_mgr_http_request_t *req, api_mgr_h
         }
         counts[a]++;
     }
+    uint64_t scan_timestamp_us = scan_data->scan_timestamp_us;
+    hal_lidar_release_frame(&frame);
 
     // Interpolation to fill gaps if enabled
     if (interpolate) {
@@ -696,22 +723,20 @@ int api_handle_lidar_scan_frame_360(const api_mgr_http_request_t *req, api_mgr_h
     }
 
     // build JSON array of 360 values
-    size_t estimated = 1024 + 360 * 12;
-    char *json = (char*)malloc(estimated);
-    if (!json) return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory");
-    size_t pos = 0;
-    pos += snprintf(json + pos, estimated - pos,
-        "{\"success\":true,\"data\":{\"timestamp_us\":%lu,\"reducer\":\"%s\",\"min_q\":%d,\"max_range\":%d,\"interpolate\":%d,\"frame_360\":[",
-        scan_data.scan_timestamp_us, reducer, min_q, max_range, interpolate);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024 + 360 * 12);
+    json_writer_field_uint(&w, "timestamp_us", scan_timestamp_us);
+    json_writer_field_string(&w, "reducer", reducer);
+    json_writer_field_int(&w, "min_q", min_q);
+    json_writer_field_int(&w, "max_range", max_range);
+    json_writer_field_int(&w, "interpolate", interpolate);
+    json_writer_key(&w, "frame_360");
+    json_writer_begin_array(&w);
     for (int a = 0; a < 360; a++) {
-        if (pos + 16 >= estimated) { size_t ns=estimated*2; char *t=(char*)realloc(json,ns); if(!t){ free(json); return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory"); } json=t; estimated=ns; }
-        pos += snprintf(json + pos, estimated - pos, "%s%u", (a>0)?",":"", bins[a]);
+        json_writer_uint(&w, bins[a]);
     }
-    if (pos + 4 >= estimated) { char *t=(char*)realloc(json,estimated+8); if(!t){ free(json); return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory"); } json=t; estimated+=8; }
-    pos += snprintf(json + pos, estimated - pos, "]}}" );
-    int rc = api_manager_create_success_response(res, json);
-    free(json);
-    return rc;
+    json_writer_end_array(&w);
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/lidar/start_scanning
@@ -753,28 +778,17 @@ int api_handle_lidar_config_get(const api_mgr_http_request_t *req, api_mgr_http_
     hal_status_t hal_status = hal_lidar_get_config(&config);
     
     if (hal_status == HAL_STATUS_OK) {
-        char json[512];
-        snprintf(json, sizeof(json),
-            "{\"success\":true,\"data\":{"
-            "\"device_path\":\"%s\","
-            "\"baud_rate\":%u,"
-            "\"scan_rate_hz\":%u,"
-            "\"emergency_stop_mm\":%u,"
-            "\"warning_mm\":%u,"
-            "\"safe_mm\":%u,"
-            "\"sample_rate_hz\":%u,"
-            "\"angular_resolution\":%.2f"
-            "}}",
-            config.device_path,
-            config.baud_rate,
-            config.scan_rate_hz,
-            config.emergency_stop_mm,
-            config.warning_mm,
-            config.safe_mm,
-            config.sample_rate_hz,
-            config.angular_resolution
-        );
-        return api_manager_create_success_response(res, json);
+        json_writer_t w;
+        (void)api_manager_json_begin_data(&w, 512);
+        json_writer_field_string(&w, "device_path", config.device_path);
+        json_writer_field_uint(&w, "baud_rate", config.baud_rate);
+        json_writer_field_uint(&w, "scan_rate_hz", config.scan_rate_hz);
+        json_writer_field_uint(&w, "emergency_stop_mm", config.emergency_stop_mm);
+        json_writer_field_uint(&w, "warning_mm", config.warning_mm);
+        json_writer_field_uint(&w, "safe_mm", config.safe_mm);
+        json_writer_field_uint(&w, "sample_rate_hz", config.sample_rate_hz);
+        json_writer_field_fixed(&w, "angular_resolution", (double)config.angular_resolution, 2);
+        return api_manager_json_end_data(res, &w);
     } else {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR config");
     }
@@ -795,24 +809,15 @@ int api_handle_lidar_safety_status(const api_mgr_http_request_t *req, api_mgr_ht
     hal_status_t hal_status = hal_lidar_check_safety(&safety_status);
     
     if (hal_status == HAL_STATUS_OK) {
-        char json[512];
-        snprintf(json, sizeof(json),
-            "{\"success\":true,\"data\":{"
-            "\"min_distance_mm\":%u,"
-            "\"max_distance_mm\":%u,"
-            "\"obstacle_detected\":%s,"
-            "\"warning_triggered\":%s,"
-            "\"emergency_stop_triggered\":%s,"
-            "\"timestamp_us\":%lu"
-            "}}",
-            safety_status.min_distance_mm,
-            safety_status.max_distance_mm,
-            safety_status.obstacle_detected ? "true" : "false",
-            safety_status.warning_triggered ? "true" : "false",
-            safety_status.emergency_stop_triggered ? "true" : "false",
-            safety_status.timestamp_us
-        );
-        return api_manager_create_success_response(res, json);
+        json_writer_t w;
+        (void)api_manager_json_begin_data(&w, 512);
+        json_writer_field_uint(&w, "min_distance_mm", safety_status.min_distance_mm);
+        json_writer_field_uint(&w, "max_distance_mm", safety_status.max_distance_mm);
+        json_writer_field_bool(&w, "obstacle_detected", safety_status.obstacle_detected);
+        json_writer_field_bool(&w, "warning_triggered", safety_status.warning_triggered);
+        json_writer_field_bool(&w, "emergency_stop_triggered", safety_status.emergency_stop_triggered);
+        json_writer_field_uint(&w, "timestamp_us", safety_status.timestamp_us);
+        return api_manager_json_end_data(res, &w);
     } else {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Failed to get LiDAR safety status");
     }
@@ -831,18 +836,25 @@ int api_handle_lidar_health_check(const api_mgr_http_request_t *req, api_mgr_htt
         hal_status_t health_status = hal_lidar_health_check();
         
         if (health_status == HAL_STATUS_OK) {
-            char json[256];
-            snprintf(json, sizeof(json),
-                "{\"success\":true,\"data\":{\"health\":\"ok\",\"device\":\"%s\",\"status\":%d,\"hardware\":\"/dev/ttyUSB0\"}}",
-                device_info.device_name, device_info.status);
-            return api_manager_create_success_response(res, json);
+            json_writer_t w;
+            (void)api_manager_json_begin_data(&w, 256);
+            json_writer_field_string(&w, "health", "ok");
+            json_writer_field_string(&w, "device", device_info.device_name);
+            json_writer_field_int(&w, "status", (int64_t)device_info.status);
+            json_writer_field_string(&w, "hardware", "/dev/ttyUSB0");
+            return api_manager_json_end_data(res, &w);
         } else {
             // Health check failed but device exists
-            char json[256];
-            snprintf(json, sizeof(json),
-                "{\"success\":false,\"message\":\"LiDAR health check failed\",\"device\":\"%s\",\"hardware\":\"/dev/ttyUSB0\",\"status\":%d}",
-                device_info.device_name, device_info.status);
-            return api_manager_create_success_response(res, json);
+            json_writer_t w;
+            (void)api_manager_json_begin(&w, 256);
+            json_writer_begin_object(&w);
+            json_writer_field_bool(&w, "success", false);
+            json_writer_field_string(&w, "message", "LiDAR health check failed");
+            json_writer_field_string(&w, "device", device_info.device_name);
+            json_writer_field_string(&w, "hardware", "/dev/ttyUSB0");
+            json_writer_field_int(&w, "status", (int64_t)device_info.status);
+            json_writer_end_object(&w);
+            return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
         }
     } else {
         // Device not detected
@@ -860,7 +872,7 @@ int api_handle_robot_status(const api_mgr_http_request_t *req, api_mgr_http_resp
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // REAL ROBOT DATA - IMPLEMENTATION FOR ISSUE #138
     // Get real position data from estimator_1d
@@ -901,40 +913,30 @@ int api_handle_robot_status(const api_mgr_http_request_t *req, api_mgr_http_resp
     // - Health monitoring system
     
     // Build comprehensive robot status JSON with real data
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"robot_id\":\"OHT-50-001\","
-            "\"status\":\"%s\","
-            "\"mode\":\"%s\","
-            "\"position\":{\"x\":%.3f,\"y\":%.3f,\"z\":%.3f},"
-            "\"speed\":%.3f,"
-            "\"battery_level\":%d,"
-            "\"temperature\":%.1f,"
-            "\"uptime\":%lu,"
-            "\"health_score\":%d,"
-            "\"safety\":{\"estop\":%s,\"obstacles\":%s},"
-            "\"docking\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        status,
-        mode,
-        position_x, position_y, position_z,
-        speed,
-        battery_level,
-        temperature,
-        timestamp / 1000,  // uptime in seconds
-        health_score,
-        estop_active ? "true" : "false",
-        obstacles_detected ? "true" : "false",
-        docking_status,
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_string(&w, "robot_id", "OHT-50-001");
+    json_writer_field_string(&w, "status", status);
+    json_writer_field_string(&w, "mode", mode);
+    json_writer_key(&w, "position");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "x", (double)position_x, 3);
+    json_writer_field_fixed(&w, "y", (double)position_y, 3);
+    json_writer_field_fixed(&w, "z", (double)position_z, 3);
+    json_writer_end_object(&w);
+    json_writer_field_fixed(&w, "speed", (double)speed, 3);
+    json_writer_field_uint(&w, "battery_level", battery_level);
+    json_writer_field_fixed(&w, "temperature", (double)temperature, 1);
+    json_writer_field_uint(&w, "uptime", timestamp / 1000);  // uptime in seconds
+    json_writer_field_uint(&w, "health_score", health_score);
+    json_writer_key(&w, "safety");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "estop", estop_active);
+    json_writer_field_bool(&w, "obstacles", obstacles_detected);
+    json_writer_end_object(&w);
+    json_writer_field_string(&w, "docking", docking_status);
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/robot/command
@@ -1094,45 +1096,30 @@ int api_handle_robot_command(const api_mgr_http_request_t *req, api_mgr_http_res
     hal_status_t result = execute_robot_command(&cmd);
     
     // Generate command ID
-    uint64_t command_id = hal_get_timestamp_ms();
+    char command_id[32];
+    snprintf(command_id, sizeof(command_id), "cmd_%lu", hal_time_wall_ms());
     
     // Build response
-    char json[512];
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 512);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", result == HAL_STATUS_OK);
     if (result == HAL_STATUS_OK) {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":true,"
-            "\"message\":\"Command executed successfully\","
-            "\"command_id\":\"cmd_%lu\","
-            "\"command_type\":\"%s\","
-            "\"previous_state\":\"%s\","
-            "\"timestamp\":%lu"
-            "}",
-            command_id,
-            get_command_type_string(cmd.type),
-            system_state_machine_get_state_name(status.current_state),
-            hal_get_timestamp_ms()
-        );
-        return api_manager_create_success_response(res, json);
+        json_writer_field_string(&w, "message", "Command executed successfully");
+        json_writer_field_string(&w, "command_id", command_id);
+        json_writer_field_string(&w, "command_type", get_command_type_string(cmd.type));
+        json_writer_field_string(&w, "previous_state", system_state_machine_get_state_name(status.current_state));
     } else {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":false,"
-            "\"error\":\"Command execution failed\","
-            "\"command_id\":\"cmd_%lu\","
-            "\"command_type\":\"%s\","
-            "\"current_state\":\"%s\","
-            "\"error_code\":%d,"
-            "\"timestamp\":%lu"
-            "}",
-            command_id,
-            get_command_type_string(cmd.type),
-            system_state_machine_get_state_name(status.current_state),
-            (int)result,
-            hal_get_timestamp_ms()
-        );
-        return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, json);
-    }
+        json_writer_field_string(&w, "error", "Command execution failed");
+        json_writer_field_string(&w, "command_id", command_id);
+        json_writer_field_string(&w, "command_type", get_command_type_string(cmd.type));
+        json_writer_field_string(&w, "current_state", system_state_machine_get_state_name(status.current_state));
+        json_writer_field_int(&w, "error_code", (int)result);
+    }
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    return api_manager_create_json_response(res, result == HAL_STATUS_OK ? API_MGR_RESPONSE_OK
+                                                                         : API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, &w);
 }
 
 // GET /api/v1/battery/status
@@ -1140,7 +1127,7 @@ int api_handle_battery_status(const api_mgr_http_request_t *req, api_mgr_http_re
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // Get real battery data
     uint8_t battery_level = 0;
@@ -1163,28 +1150,15 @@ int api_handle_battery_status(const api_mgr_http_request_t *req, api_mgr_http_re
     }
     
     // Build battery status JSON with real data
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"battery_level\":%d,"
-            "\"battery_voltage\":%.2f,"
-            "\"charging_status\":\"%s\","
-            "\"estimated_runtime\":%u,"
-            "\"health\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        battery_level,
-        battery_voltage,
-        charging_status,
-        estimated_runtime,
-        health,
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 512);
+    json_writer_field_uint(&w, "battery_level", battery_level);
+    json_writer_field_fixed(&w, "battery_voltage", (double)battery_voltage, 2);
+    json_writer_field_string(&w, "charging_status", charging_status);
+    json_writer_field_uint(&w, "estimated_runtime", estimated_runtime);
+    json_writer_field_string(&w, "health", health);
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/temperature/status
@@ -1192,7 +1166,7 @@ int api_handle_temperature_status(const api_mgr_http_request_t *req, api_mgr_htt
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // Get real temperature data
     float motor_temperature = 0.0f;
@@ -1216,30 +1190,16 @@ int api_handle_temperature_status(const api_mgr_http_request_t *req, api_mgr_htt
     }
     
     // Build temperature status JSON with real data
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"motor_temperature\":%.1f,"
-            "\"controller_temperature\":%.1f,"
-            "\"ambient_temperature\":%.1f,"
-            "\"warning_threshold\":%.1f,"
-            "\"critical_threshold\":%.1f,"
-            "\"status\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        motor_temperature,
-        controller_temperature,
-        ambient_temperature,
-        warning_threshold,
-        critical_threshold,
-        status,
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 512);
+    json_writer_field_fixed(&w, "motor_temperature", (double)motor_temperature, 1);
+    json_writer_field_fixed(&w, "controller_temperature", (double)controller_temperature, 1);
+    json_writer_field_fixed(&w, "ambient_temperature", (double)ambient_temperature, 1);
+    json_writer_field_fixed(&w, "warning_threshold", (double)warning_threshold, 1);
+    json_writer_field_fixed(&w, "critical_threshold", (double)critical_threshold, 1);
+    json_writer_field_string(&w, "status", status);
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
 }
 
 // CRITICAL ENDPOINTS - Issue #112 Implementation
@@ -1252,39 +1212,71 @@ int api_handle_health_check(const api_mgr_http_request_t *req, api_mgr_http_resp
     const char* state_name = system_state_machine_get_state_name(current_state);
     
     // Build health status JSON
-    char json_buffer[512];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{\"success\":true,\"status\":\"healthy\",\"firmware\":\"running\","
-        "\"data\":{\"system_state\":\"%s\",\"timestamp\":%lu,\"version\":\"1.0.0\"}}",
-        state_name, (unsigned long)time(NULL));
-    
-    return api_manager_create_success_response(res, json_buffer);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 512);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_field_string(&w, "status", "healthy");
+    json_writer_field_string(&w, "firmware", "running");
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "system_state", state_name);
+    json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
+    json_writer_field_string(&w, "version", "1.0.0");
+    return api_manager_json_end_data(res, &w);
 }
 
 int api_handle_rs485_modules(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     (void)req;
     
+    // Fallback module list served while registry sync is not working
+    static const struct {
+        uint8_t address;
+        const char *name;
+        uint8_t type;
+    } fallback_modules[] = {
+        { 2, "Power Module", 1 },
+        { 3, "Safety Module", 2 },
+        { 4, "Travel Motor", 3 },
+        { 5, "Dock Module", 4 },
+    };
+    
     // DEBUG: Check stats first
     module_stats_t stats;
     hal_status_t stats_result = module_manager_get_statistics(&stats);
     printf("[API_DEBUG] RS485 modules called: stats_result=%d, total_modules=%u\n", 
            stats_result, stats.total_modules);
     
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_key(&w, "modules");
+    json_writer_begin_array(&w);
+    
     // WORKAROUND: Use stats data directly since registry sync is not working
     if (stats_result == HAL_STATUS_OK && stats.total_modules > 0) {
         // Use stats data to create consistent module list
-        char buffer[1024];
-        snprintf(buffer, sizeof(buffer),
-                "{\"success\":true,\"data\":{\"modules\":[{\"address\":2,\"name\":\"Power Module\",\"status\":\"healthy\",\"type\":1,\"version\":\"1.0.0\"},{\"address\":3,\"name\":\"Safety Module\",\"status\":\"healthy\",\"type\":2,\"version\":\"1.0.0\"},{\"address\":4,\"name\":\"Travel Motor\",\"status\":\"healthy\",\"type\":3,\"version\":\"1.0.0\"},{\"address\":5,\"name\":\"Dock Module\",\"status\":\"healthy\",\"type\":4,\"version\":\"1.0.0\"}],\"total_modules\":%u,\"health_score\":%.1f}}",
-                stats.total_modules, 75.0f);
+        for (size_t i = 0; i < sizeof(fallback_modules) / sizeof(fallback_modules[0]); i++) {
+            json_writer_begin_object(&w);
+            json_writer_field_uint(&w, "address", fallback_modules[i].address);
+            json_writer_field_string(&w, "name", fallback_modules[i].name);
+            json_writer_field_string(&w, "status", "healthy");
+            json_writer_field_uint(&w, "type", fallback_modules[i].type);
+            json_writer_field_string(&w, "version", "1.0.0");
+            json_writer_end_object(&w);
+        }
+        json_writer_end_array(&w);
+        json_writer_field_uint(&w, "total_modules", stats.total_modules);
+        json_writer_field_fixed(&w, "health_score", 75.0, 1);
         printf("[API_DEBUG] Returning fallback data with %u modules\n", stats.total_modules);
-        return api_manager_create_success_response(res, buffer);
+        return api_manager_json_end_data(res, &w);
     }
     
     // If no stats, return empty array
     printf("[API_DEBUG] No stats available, returning empty array\n");
-    const char *empty_json = "{\"success\":true,\"data\":{\"modules\":[],\"total_modules\":0,\"health_score\":0.0}}";
-    return api_manager_create_success_response(res, empty_json);
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "total_modules", 0);
+    json_writer_field_fixed(&w, "health_score", 0.0, 1);
+    return api_manager_json_end_data(res, &w);
 }
 
 // ============================================================================
@@ -1296,7 +1288,7 @@ int api_handle_dock_rfid(const api_mgr_http_request_t *req, api_mgr_http_respons
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // Get RFID data from dock module
     // TODO: Get dock handler instance from module manager
@@ -1307,26 +1299,14 @@ int api_handle_dock_rfid(const api_mgr_http_request_t *req, api_mgr_http_respons
     // For now, return default values until dock module is properly integrated
     
     // Build RFID data JSON
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"tag_id\":\"0x%08X\","
-            "\"signal_strength\":%d,"
-            "\"read_status\":%d,"
-            "\"status_text\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        tag_id,
-        signal_strength,
-        read_status,
-        read_status == 1 ? "tag_detected" : "no_tag",
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 512);
+    json_writer_field_hex(&w, "tag_id", tag_id, 8);
+    json_writer_field_uint(&w, "signal_strength", signal_strength);
+    json_writer_field_uint(&w, "read_status", read_status);
+    json_writer_field_string(&w, "status_text", read_status == 1 ? "tag_detected" : "no_tag");
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/dock/accelerometer
@@ -1334,7 +1314,7 @@ int api_handle_dock_accelerometer(const api_mgr_http_request_t *req, api_mgr_htt
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // Get accelerometer data from dock module
     // TODO: Get dock handler instance from module manager
@@ -1345,26 +1325,31 @@ int api_handle_dock_accelerometer(const api_mgr_http_request_t *req, api_mgr_htt
     // For now, return default values until dock module is properly integrated
     
     // Build accelerometer data JSON
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"acceleration\":{\"x\":%d,\"y\":%d,\"z\":%d},"
-            "\"temperature\":%d,"
-            "\"status\":%d,"
-            "\"status_text\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        accel_x, accel_y, accel_z,
-        temperature,
-        status,
-        status == 1 ? "ok" : "error",
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 512);
+    json_writer_key(&w, "acceleration");
+    json_writer_begin_object(&w);
+    json_writer_field_int(&w, "x", accel_x);
+    json_writer_field_int(&w, "y", accel_y);
+    json_writer_field_int(&w, "z", accel_z);
+    json_writer_end_object(&w);
+    json_writer_field_int(&w, "temperature", temperature);
+    json_writer_field_uint(&w, "status", status);
+    json_writer_field_string(&w, "status_text", status == 1 ? "ok" : "error");
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
+}
+
+/**
+ * @brief Write one dock proximity sensor as {"status":..,"distance":..}
+ */
+static void api_write_proximity_sensor(json_writer_t *w, const char *key, uint8_t status, uint16_t distance)
+{
+    json_writer_key(w, key);
+    json_writer_begin_object(w);
+    json_writer_field_uint(w, "status", status);
+    json_writer_field_uint(w, "distance", distance);
+    json_writer_end_object(w);
 }
 
 // GET /api/v1/dock/proximity
@@ -1372,7 +1357,7 @@ int api_handle_dock_proximity(const api_mgr_http_request_t *req, api_mgr_http_re
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // Get proximity sensors data from dock module
     // TODO: Get dock handler instance from module manager
@@ -1383,28 +1368,17 @@ int api_handle_dock_proximity(const api_mgr_http_request_t *req, api_mgr_http_re
     // For now, return default values until dock module is properly integrated
     
     // Build proximity sensors data JSON
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"sensors\":{"
-                "\"sensor_1\":{\"status\":%d,\"distance\":%d},"
-                "\"sensor_2\":{\"status\":%d,\"distance\":%d}"
-            "},"
-            "\"dock_confirmed\":%d,"
-            "\"dock_status\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        sensor_1, distance_1,
-        sensor_2, distance_2,
-        dock_confirmed,
-        dock_confirmed == 1 ? "docked" : "not_docked",
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 512);
+    json_writer_key(&w, "sensors");
+    json_writer_begin_object(&w);
+    api_write_proximity_sensor(&w, "sensor_1", sensor_1, distance_1);
+    api_write_proximity_sensor(&w, "sensor_2", sensor_2, distance_2);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "dock_confirmed", dock_confirmed);
+    json_writer_field_string(&w, "dock_status", dock_confirmed == 1 ? "docked" : "not_docked");
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/dock/status
@@ -1412,7 +1386,7 @@ int api_handle_dock_status(const api_mgr_http_request_t *req, api_mgr_http_respo
     (void)req;
     
     // Get current timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
+    uint64_t timestamp = hal_time_wall_ms();
     
     // Get comprehensive dock status from dock module
     // TODO: Get dock handler instance from module manager
@@ -1428,36 +1402,29 @@ int api_handle_dock_status(const api_mgr_http_request_t *req, api_mgr_http_respo
     // For now, return default values until dock module is properly integrated
     
     // Build comprehensive dock status JSON
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"rfid\":{"
-                "\"tag_id\":\"0x%08X\","
-                "\"signal_strength\":%d,"
-                "\"read_status\":%d"
-            "},"
-            "\"accelerometer\":{"
-                "\"x\":%d,\"y\":%d,\"z\":%d"
-            "},"
-            "\"proximity\":{"
-                "\"sensor_1\":{\"status\":%d,\"distance\":%d},"
-                "\"sensor_2\":{\"status\":%d,\"distance\":%d},"
-                "\"dock_confirmed\":%d"
-            "},"
-            "\"overall_status\":\"%s\","
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        rfid_tag_id, rfid_signal, rfid_status,
-        accel_x, accel_y, accel_z,
-        prox_1, dist_1, prox_2, dist_2, dock_confirmed,
-        dock_confirmed == 1 ? "docked" : "idle",
-        timestamp
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_key(&w, "rfid");
+    json_writer_begin_object(&w);
+    json_writer_field_hex(&w, "tag_id", rfid_tag_id, 8);
+    json_writer_field_uint(&w, "signal_strength", rfid_signal);
+    json_writer_field_uint(&w, "read_status", rfid_status);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "accelerometer");
+    json_writer_begin_object(&w);
+    json_writer_field_int(&w, "x", accel_x);
+    json_writer_field_int(&w, "y", accel_y);
+    json_writer_field_int(&w, "z", accel_z);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "proximity");
+    json_writer_begin_object(&w);
+    api_write_proximity_sensor(&w, "sensor_1", prox_1, dist_1);
+    api_write_proximity_sensor(&w, "sensor_2", prox_2, dist_2);
+    json_writer_field_uint(&w, "dock_confirmed", dock_confirmed);
+    json_writer_end_object(&w);
+    json_writer_field_string(&w, "overall_status", dock_confirmed == 1 ? "docked" : "idle");
+    json_writer_field_uint(&w, "timestamp", timestamp);
+    return api_manager_json_end_data(res, &w);
 }
 
 // ============================================================================
@@ -1466,17 +1433,11 @@ int api_handle_dock_status(const api_mgr_http_request_t *req, api_mgr_http_respo
 
 // Structures are now defined in api_endpoints.h to avoid conflicts
 
-// Helper function to extract module ID from path
-int extract_module_id_from_path(const char *path) {
-    const char *id_start = strstr(path, "/modules/");
-    if (!id_start) return -1;
-    
-    id_start += 9; // Skip "/modules/"
-    const char *id_end = strchr(id_start, '/');
-    if (!id_end) return -1;
-    
-    int module_id = atoi(id_start);
-    return (module_id > 0 && module_id <= 255) ? module_id : -1;
+// Helper function to get the module ID captured by the {id:u8} route segment
+static int module_id_from_request(const api_mgr_http_request_t *req) {
+    uint32_t module_id;
+    if (api_manager_get_path_param(req, "id", &module_id) != 0) return -1;
+    return module_id > 0 ? (int)module_id : -1;
 }
 
 // Helper function to get module name by ID
@@ -1639,6 +1600,25 @@ int get_module_telemetry_data_with_ranges(int module_id, api_module_telemetry_wi
     return 0;
 }
 
+/**
+ * @brief Write a telemetry field as {"value":..,"range":{"min":..,"max":..},"unit":..,"description":..}
+ */
+static void api_write_telemetry_field(json_writer_t *w, const char *key, const telemetry_field_t *field,
+                                      uint8_t decimals)
+{
+    json_writer_key(w, key);
+    json_writer_begin_object(w);
+    json_writer_field_fixed(w, "value", (double)field->value, decimals);
+    json_writer_key(w, "range");
+    json_writer_begin_object(w);
+    json_writer_field_fixed(w, "min", (double)field->min_value, 1);
+    json_writer_field_fixed(w, "max", (double)field->max_value, 1);
+    json_writer_end_object(w);
+    json_writer_field_string(w, "unit", field->unit);
+    json_writer_field_string(w, "description", field->description);
+    json_writer_end_object(w);
+}
+
 // GET /api/v1/modules/{id}/telemetry
 int api_handle_module_telemetry(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     if (!req || !res) {
@@ -1646,66 +1626,34 @@ int api_handle_module_telemetry(const api_mgr_http_request_t *req, api_mgr_http_
     }
     
     // Extract module ID from path
-    int module_id = extract_module_id_from_path(req->path);
+    int module_id = module_id_from_request(req);
     if (module_id == -1) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, 
             "Invalid module ID");
     }
     
-    // If query contains ranges=1, return enhanced response with ranges (Issue #143)
-    const char *q = strchr(req->path, '?');
-    if (q && strstr(q, "ranges=1")) {
-        api_module_telemetry_with_range_t tr;
-        if (get_module_telemetry_data_with_ranges(module_id, &tr) != 0) {
-            return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR,
-                "Failed to get module telemetry data");
-        }
-        char j[2048];
-        snprintf(j, sizeof(j),
-            "{\"success\":true,\"data\":{\"module_id\":%d,\"module_name\":\"%s\",\"telemetry\":{"
-            "\"voltage\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-            "\"current\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-            "\"power\":{\"value\":%.2f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-            "\"temperature\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-            "\"efficiency\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-            "\"load_percentage\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"}"
-            "},\"timestamp\":%lu,\"data_freshness_ms\":%u}}",
-            tr.module_id, tr.module_name,
-            tr.voltage.value, tr.voltage.min_value, tr.voltage.max_value, tr.voltage.unit, tr.voltage.description,
-            tr.current.value, tr.current.min_value, tr.current.max_value, tr.current.unit, tr.current.description,
-            tr.power.value, tr.power.min_value, tr.power.max_value, tr.power.unit, tr.power.description,
-            tr.temperature.value, tr.temperature.min_value, tr.temperature.max_value, tr.temperature.unit, tr.temperature.description,
-            tr.efficiency.value, tr.efficiency.min_value, tr.efficiency.max_value, tr.efficiency.unit, tr.efficiency.description,
-            tr.load_percentage.value, tr.load_percentage.min_value, tr.load_percentage.max_value, tr.load_percentage.unit, tr.load_percentage.description,
-            tr.timestamp, tr.data_freshness_ms);
-        return api_manager_create_success_response(res, j);
-    }
-    
-    // Return enhanced telemetry with ranges by default (Issue #143)
+    // Enhanced telemetry with ranges, with or without ?ranges=1 (Issue #143)
     api_module_telemetry_with_range_t tr;
     if (get_module_telemetry_data_with_ranges(module_id, &tr) != 0) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR,
             "Failed to get module telemetry data");
     }
-    char j[2048];
-    snprintf(j, sizeof(j),
-        "{\"success\":true,\"data\":{\"module_id\":%d,\"module_name\":\"%s\",\"telemetry\":{"
-        "\"voltage\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-        "\"current\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-        "\"power\":{\"value\":%.2f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-        "\"temperature\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-        "\"efficiency\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"},"
-        "\"load_percentage\":{\"value\":%.1f,\"range\":{\"min\":%.1f,\"max\":%.1f},\"unit\":\"%s\",\"description\":\"%s\"}"
-        "},\"timestamp\":%lu,\"data_freshness_ms\":%u}}",
-        tr.module_id, tr.module_name,
-        tr.voltage.value, tr.voltage.min_value, tr.voltage.max_value, tr.voltage.unit, tr.voltage.description,
-        tr.current.value, tr.current.min_value, tr.current.max_value, tr.current.unit, tr.current.description,
-        tr.power.value, tr.power.min_value, tr.power.max_value, tr.power.unit, tr.power.description,
-        tr.temperature.value, tr.temperature.min_value, tr.temperature.max_value, tr.temperature.unit, tr.temperature.description,
-        tr.efficiency.value, tr.efficiency.min_value, tr.efficiency.max_value, tr.efficiency.unit, tr.efficiency.description,
-        tr.load_percentage.value, tr.load_percentage.min_value, tr.load_percentage.max_value, tr.load_percentage.unit, tr.load_percentage.description,
-        tr.timestamp, tr.data_freshness_ms);
-    return api_manager_create_success_response(res, j);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 2048);
+    json_writer_field_int(&w, "module_id", tr.module_id);
+    json_writer_field_string(&w, "module_name", tr.module_name);
+    json_writer_key(&w, "telemetry");
+    json_writer_begin_object(&w);
+    api_write_telemetry_field(&w, "voltage", &tr.voltage, 1);
+    api_write_telemetry_field(&w, "current", &tr.current, 1);
+    api_write_telemetry_field(&w, "power", &tr.power, 2);
+    api_write_telemetry_field(&w, "temperature", &tr.temperature, 1);
+    api_write_telemetry_field(&w, "efficiency", &tr.efficiency, 1);
+    api_write_telemetry_field(&w, "load_percentage", &tr.load_percentage, 1);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", tr.timestamp);
+    json_writer_field_uint(&w, "data_freshness_ms", tr.data_freshness_ms);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/rs485/modules/{id}/telemetry - Enhanced with value ranges (Issue #143)
@@ -1775,7 +1723,7 @@ int api_handle_module_config_get(const api_mgr_http_request_t *req, api_mgr_http
     }
     
     // Extract module ID from path
-    int module_id = extract_module_id_from_path(req->path);
+    int module_id = module_id_from_request(req);
     if (module_id == -1) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, 
             "Invalid module ID");
@@ -1790,32 +1738,19 @@ int api_handle_module_config_get(const api_mgr_http_request_t *req, api_mgr_http
     }
     
     // Build JSON response
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"module_id\":%d,"
-            "\"module_name\":\"%s\","
-            "\"config\":{"
-                "\"emergency_stop_enabled\":%s,"
-                "\"response_time_ms\":%u,"
-                "\"auto_recovery\":%s"
-            "},"
-            "\"config_version\":\"%s\","
-            "\"last_updated\":%lu"
-        "}"
-        "}",
-        config.module_id,
-        config.module_name,
-        config.emergency_stop_enabled ? "true" : "false",
-        config.response_time_ms,
-        config.auto_recovery ? "true" : "false",
-        config.config_version,
-        config.last_updated
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_int(&w, "module_id", config.module_id);
+    json_writer_field_string(&w, "module_name", config.module_name);
+    json_writer_key(&w, "config");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "emergency_stop_enabled", config.emergency_stop_enabled);
+    json_writer_field_int(&w, "response_time_ms", config.response_time_ms);
+    json_writer_field_bool(&w, "auto_recovery", config.auto_recovery);
+    json_writer_end_object(&w);
+    json_writer_field_string(&w, "config_version", config.config_version);
+    json_writer_field_uint(&w, "last_updated", config.last_updated);
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/modules/{id}/config
@@ -1825,7 +1760,7 @@ int api_handle_module_config_set(const api_mgr_http_request_t *req, api_mgr_http
     }
     
     // Extract module ID from path
-    int module_id = extract_module_id_from_path(req->path);
+    int module_id = module_id_from_request(req);
     if (module_id == -1) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, 
             "Invalid module ID");
@@ -1842,21 +1777,16 @@ int api_handle_module_config_set(const api_mgr_http_request_t *req, api_mgr_http
     printf("[API] Module %d config update requested: %s\n", module_id, req->body);
     
     // Build success response
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Module configuration updated successfully\","
-        "\"module_id\":%d,"
-        "\"module_name\":\"%s\","
-        "\"timestamp\":%lu"
-        "}",
-        module_id,
-        get_module_name_by_id(module_id),
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 512);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_field_string(&w, "message", "Module configuration updated successfully");
+    json_writer_field_int(&w, "module_id", module_id);
+    json_writer_field_string(&w, "module_name", get_module_name_by_id(module_id));
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // POST /api/v1/modules/{id}/command
@@ -1866,7 +1796,7 @@ int api_handle_module_command(const api_mgr_http_request_t *req, api_mgr_http_re
     }
     
     // Extract module ID from path
-    int module_id = extract_module_id_from_path(req->path);
+    int module_id = module_id_from_request(req);
     if (module_id == -1) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, 
             "Invalid module ID");
@@ -1939,53 +1869,39 @@ int api_handle_module_command(const api_mgr_http_request_t *req, api_mgr_http_re
     bool command_success = true;
     
     // Build response
-    char json[1024];
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 1024);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", command_success);
     if (command_success) {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":true,"
-            "\"message\":\"Command executed successfully\","
-            "\"data\":{"
-                "\"module_id\":%d,"
-                "\"module_name\":\"%s\","
-                "\"command\":\"%s\","
-                "\"parameters\":%s,"
-                "\"reason\":\"%s\","
-                "\"execution_time_ms\":%u,"
-                "\"timestamp\":%lu"
-            "}"
-            "}",
-            module_id,
-            get_module_name_by_id(module_id),
-            command,
-            parameters[0] ? parameters : "{}",
-            reason,
-            50, // Simulated execution time
-            hal_get_timestamp_ms()
-        );
-        return api_manager_create_success_response(res, json);
+        json_writer_field_string(&w, "message", "Command executed successfully");
     } else {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":false,"
-            "\"error\":\"Command execution failed\","
-            "\"data\":{"
-                "\"module_id\":%d,"
-                "\"module_name\":\"%s\","
-                "\"command\":\"%s\","
-                "\"error_code\":\"CMD_EXEC_FAILED\","
-                "\"timestamp\":%lu"
-            "}"
-            "}",
-            module_id,
-            get_module_name_by_id(module_id),
-            command,
-            hal_get_timestamp_ms()
-        );
-        return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, json);
+        json_writer_field_string(&w, "error", "Command execution failed");
     }
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_int(&w, "module_id", module_id);
+    json_writer_field_string(&w, "module_name", get_module_name_by_id(module_id));
+    json_writer_field_string(&w, "command", command);
+    if (command_success) {
+        // Echoed object from the request body, as received
+        json_writer_key(&w, "parameters");
+        json_writer_raw(&w, parameters[0] ? parameters : "{}", parameters[0] ? strlen(parameters) : 2U);
+        json_writer_field_string(&w, "reason", reason);
+        json_writer_field_uint(&w, "execution_time_ms", 50); // Simulated execution time
+    } else {
+        json_writer_field_string(&w, "error_code", "CMD_EXEC_FAILED");
+    }
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+    return api_manager_create_json_response(res, command_success ? API_MGR_RESPONSE_OK
+                                                                  : API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, &w);
 }
 
+// Series per /history response (a module exposes a few dozen registers)
+#define API_HISTORY_MAX_SERIES 64
+
 // GET /api/v1/modules/{id}/history
 int api_handle_module_history(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     if (!req || !res) {
@@ -1993,7 +1909,7 @@ int api_handle_module_history(const api_mgr_http_request_t *req, api_mgr_http_re
     }
     
     // Extract module ID from path
-    int module_id = extract_module_id_from_path(req->path);
+    int module_id = module_id_from_request(req);
     if (module_id == -1) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, 
             "Invalid module ID");
@@ -2017,68 +1933,78 @@ int api_handle_module_history(const api_mgr_http_request_t *req, api_mgr_http_re
     if (hours < 1 || hours > 168) hours = 24; // Max 1 week
     if (limit < 1 || limit > 1000) limit = 100; // Max 1000 records
     
-    // TODO: Get real historical data from storage
-    // For now, generate sample historical data
-    uint64_t current_time = hal_get_timestamp_ms();
-    uint64_t start_time = current_time - (hours * 3600 * 1000);
-    
-    // Build JSON response with sample data
-    char json[2048];
-    size_t pos = 0;
-    
-    pos += snprintf(json + pos, sizeof(json) - pos,
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"module_id\":%d,"
-            "\"module_name\":\"%s\","
-            "\"history\":[",
-        module_id,
-        get_module_name_by_id(module_id)
-    );
-    
-    // Generate sample history records
-    int record_count = (limit > 10) ? 10 : limit; // Limit sample data
-    for (int i = 0; i < record_count; i++) {
-        uint64_t record_time = start_time + (i * (hours * 3600 * 1000) / record_count);
-        float voltage = 24.0f + (i % 3) * 0.1f;
-        float current = 2.0f + (i % 5) * 0.2f;
-        float temperature = 35.0f + (i % 4) * 1.5f;
-        
-        pos += snprintf(json + pos, sizeof(json) - pos,
-            "%s{"
-                "\"timestamp\":%lu,"
-                "\"telemetry\":{"
-                    "\"voltage\":%.1f,"
-                    "\"current\":%.1f,"
-                    "\"temperature\":%.1f"
-                "}"
-            "}",
-            (i > 0) ? "," : "",
-            record_time,
-            voltage,
-            current,
-            temperature
-        );
-        
-        if (pos >= sizeof(json) - 200) break; // Prevent buffer overflow
-    }
-    
-    pos += snprintf(json + pos, sizeof(json) - pos,
-        "],"
-        "\"total_records\":%d,"
-        "\"time_range\":{"
-            "\"start\":%lu,"
-            "\"end\":%lu"
-        "}"
-        "}"
-        "}",
-        record_count,
-        start_time,
-        current_time
-    );
+    if (!ts_store_is_open()) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_SERVICE_UNAVAILABLE,
+            "History store not available");
+    }
     
-    return api_manager_create_success_response(res, json);
+    // At most `limit` points per series: one min/max/avg bucket per hours*3600/limit seconds
+    uint64_t current_time = hal_time_wall_ms();
+    uint64_t span_ms = (uint64_t)hours * 3600000U;
+    uint64_t start_time = current_time - span_ms;
+    uint64_t bucket_ms = (span_ms + (uint64_t)limit - 1U) / (uint64_t)limit;
+    
+    ts_series_key_t keys[API_HISTORY_MAX_SERIES];
+    uint32_t key_count = 0;
+    ts_point_t *points = (ts_point_t*)malloc((size_t)limit * sizeof(ts_point_t));
+    if (!points) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "no memory");
+    }
+    if (ts_store_list_series((uint8_t)module_id, keys, API_HISTORY_MAX_SERIES, &key_count) != HAL_STATUS_OK) {
+        free(points);
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR,
+            "Failed to read history");
+    }
+    
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_int(&w, "module_id", module_id);
+    json_writer_field_string(&w, "module_name", get_module_name_by_id(module_id));
+    json_writer_field_uint(&w, "bucket_ms", bucket_ms);
+    json_writer_key(&w, "series");
+    json_writer_begin_array(&w);
+    
+    uint32_t total_records = 0;
+    for (uint32_t k = 0; k < key_count; k++) {
+        uint32_t point_count = 0;
+        if (ts_store_query(keys[k], start_time, current_time, bucket_ms, points, (uint32_t)limit,
+                           &point_count) != HAL_STATUS_OK || point_count == 0) {
+            continue;
+        }
+        
+        json_writer_begin_object(&w);
+        if (keys[k].kind == TS_SERIES_REGISTER) {
+            json_writer_field_string(&w, "kind", "register");
+            json_writer_field_hex(&w, "register", keys[k].id, 4);
+        } else {
+            json_writer_field_string(&w, "kind", "telemetry");
+            json_writer_field_string(&w, "name", ts_store_telemetry_field_name((ts_telemetry_field_t)keys[k].id));
+        }
+        json_writer_key(&w, "points");
+        json_writer_begin_array(&w);
+        for (uint32_t i = 0; i < point_count; i++) {
+            json_writer_begin_object(&w);
+            json_writer_field_uint(&w, "timestamp", points[i].timestamp_ms);
+            json_writer_field_double(&w, "min", (double)points[i].min, 6);
+            json_writer_field_double(&w, "max", (double)points[i].max, 6);
+            json_writer_field_double(&w, "avg", (double)points[i].avg, 6);
+            json_writer_field_uint(&w, "count", points[i].count);
+            json_writer_end_object(&w);
+        }
+        json_writer_end_array(&w);
+        json_writer_end_object(&w);
+        total_records += point_count;
+    }
+    free(points);
+    
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "total_records", total_records);
+    json_writer_key(&w, "time_range");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "start", start_time);
+    json_writer_field_uint(&w, "end", current_time);
+    json_writer_end_object(&w);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/modules/{id}/health
@@ -2088,7 +2014,7 @@ int api_handle_module_health(const api_mgr_http_request_t *req, api_mgr_http_res
     }
     
     // Extract module ID from path
-    int module_id = extract_module_id_from_path(req->path);
+    int module_id = module_id_from_request(req);
     if (module_id == -1) {
         return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, 
             "Invalid module ID");
@@ -2096,52 +2022,33 @@ int api_handle_module_health(const api_mgr_http_request_t *req, api_mgr_http_res
     
     // TODO: Get real health data from module
     // For now, generate sample health data
-    uint64_t current_time = hal_get_timestamp_ms();
+    uint64_t current_time = hal_time_wall_ms();
     
     // Build JSON response with sample health data
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"module_id\":%d,"
-            "\"module_name\":\"%s\","
-            "\"health_status\":\"healthy\","
-            "\"health_score\":%.1f,"
-            "\"uptime_seconds\":%u,"
-            "\"error_count\":%u,"
-            "\"warning_count\":%u,"
-            "\"performance_metrics\":{"
-                "\"response_time_avg_ms\":%.1f,"
-                "\"response_time_p95_ms\":%.1f,"
-                "\"success_rate\":%.1f,"
-                "\"data_freshness_ms\":%u"
-            "},"
-            "\"diagnostics\":{"
-                "\"communication_ok\":%s,"
-                "\"hardware_ok\":%s,"
-                "\"firmware_version\":\"%s\","
-                "\"last_restart\":%lu"
-            "}"
-        "}"
-        "}",
-        module_id,
-        get_module_name_by_id(module_id),
-        95.5f, // health_score
-        86400, // uptime_seconds (24 hours)
-        0,     // error_count
-        2,     // warning_count
-        15.2f, // response_time_avg_ms
-        25.0f, // response_time_p95_ms
-        99.8f, // success_rate
-        45,    // data_freshness_ms
-        "true", // communication_ok
-        "true", // hardware_ok
-        "1.2.0", // firmware_version
-        current_time - 86400000 // last_restart (24 hours ago)
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_int(&w, "module_id", module_id);
+    json_writer_field_string(&w, "module_name", get_module_name_by_id(module_id));
+    json_writer_field_string(&w, "health_status", "healthy");
+    json_writer_field_fixed(&w, "health_score", 95.5, 1);
+    json_writer_field_uint(&w, "uptime_seconds", 86400); // 24 hours
+    json_writer_field_uint(&w, "error_count", 0);
+    json_writer_field_uint(&w, "warning_count", 2);
+    json_writer_key(&w, "performance_metrics");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "response_time_avg_ms", 15.2, 1);
+    json_writer_field_fixed(&w, "response_time_p95_ms", 25.0, 1);
+    json_writer_field_fixed(&w, "success_rate", 99.8, 1);
+    json_writer_field_uint(&w, "data_freshness_ms", 45);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "diagnostics");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "communication_ok", true);
+    json_writer_field_bool(&w, "hardware_ok", true);
+    json_writer_field_string(&w, "firmware_version", "1.2.0");
+    json_writer_field_uint(&w, "last_restart", current_time - 86400000); // 24 hours ago
+    json_writer_end_object(&w);
+    return api_manager_json_end_data(res, &w);
 }
 
 // Network Management API Handlers
@@ -2199,40 +2106,26 @@ int api_handle_network_status(const api_mgr_http_request_t *req, api_mgr_http_re
         }
     }
     
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-        "\"connected\":%s,"
-        "\"connection_type\":\"wifi\","
-        "\"ssid\":\"%s\","
-        "\"signal_strength\":%d,"
-        "\"signal_quality\":\"%s\","
-        "\"ip_address\":\"%s\","
-        "\"mac_address\":\"%s\","
-        "\"security_type\":\"WPA2\","
-        "\"frequency\":\"2.4GHz\","
-        "\"channel\":6,"
-        "\"bitrate\":150,"
-        "\"uptime_seconds\":%ld,"
-        "\"bytes_received\":0,"
-        "\"bytes_sent\":0,"
-        "\"timestamp\":%ld"
-        "}"
-        "}",
-        connected ? "true" : "false",
-        ssid,
-        signal_strength,
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_bool(&w, "connected", connected);
+    json_writer_field_string(&w, "connection_type", "wifi");
+    json_writer_field_string(&w, "ssid", ssid);
+    json_writer_field_int(&w, "signal_strength", signal_strength);
+    json_writer_field_string(&w, "signal_quality",
         signal_strength > 80 ? "excellent" : 
-        signal_strength > 50 ? "good" : "poor",
-        ip_address,
-        mac_address,
-        time(NULL),
-        time(NULL)
-    );
-    
-    return api_manager_create_success_response(res, json);
+        signal_strength > 50 ? "good" : "poor");
+    json_writer_field_string(&w, "ip_address", ip_address);
+    json_writer_field_string(&w, "mac_address", mac_address);
+    json_writer_field_string(&w, "security_type", "WPA2");
+    json_writer_field_string(&w, "frequency", "2.4GHz");
+    json_writer_field_uint(&w, "channel", 6);
+    json_writer_field_uint(&w, "bitrate", 150);
+    json_writer_field_int(&w, "uptime_seconds", (int64_t)time(NULL));
+    json_writer_field_uint(&w, "bytes_received", 0);
+    json_writer_field_uint(&w, "bytes_sent", 0);
+    json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/network/wifi/scan
@@ -2244,58 +2137,40 @@ int api_handle_network_wifi_scan(const api_mgr_http_request_t *req, api_mgr_http
     uint32_t network_count = 0;
     hal_status_t hal_status = hal_wifi_scan(networks, 10, &network_count);
     
+    json_writer_t w;
     if (hal_status != HAL_STATUS_OK) {
-        char error_json[512];
-        snprintf(error_json, sizeof(error_json),
-            "{"
-            "\"success\":false,"
-            "\"message\":\"WiFi scan failed\","
-            "\"error\":\"HAL_ERROR_%d\","
-            "\"timestamp\":%ld"
-            "}",
-            hal_status,
-            time(NULL)
-        );
-        return api_manager_create_success_response(res, error_json);
+        char error_code[32];
+        snprintf(error_code, sizeof(error_code), "HAL_ERROR_%d", hal_status);
+        (void)api_manager_json_begin(&w, 512);
+        json_writer_begin_object(&w);
+        json_writer_field_bool(&w, "success", false);
+        json_writer_field_string(&w, "message", "WiFi scan failed");
+        json_writer_field_string(&w, "error", error_code);
+        json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
+        json_writer_end_object(&w);
+        return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
     }
     
     // Build JSON response with real scan results
-    char json[2048];
-    char networks_json[1536] = "";
-    
+    (void)api_manager_json_begin_data(&w, 2048);
+    json_writer_key(&w, "networks");
+    json_writer_begin_array(&w);
     for (uint32_t i = 0; i < network_count; i++) {
-        char network_entry[256];
-        snprintf(network_entry, sizeof(network_entry),
-            "%s{"
-            "\"ssid\":\"%s\","
-            "\"signal_strength\":-60,"
-            "\"security_type\":\"WPA2\","
-            "\"frequency\":\"2.4GHz\","
-            "\"channel\":6,"
-            "\"encryption\":\"AES\""
-            "}",
-            i > 0 ? "," : "",
-            networks[i]
-        );
-        strncat(networks_json, network_entry, sizeof(networks_json) - strlen(networks_json) - 1);
-    }
-    
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-        "\"networks\":[%s],"
-        "\"scan_duration_ms\":2500,"
-        "\"total_networks\":%u,"
-        "\"timestamp\":%ld"
-        "}"
-        "}",
-        networks_json,
-        network_count,
-        time(NULL)
-    );
-    
-    return api_manager_create_success_response(res, json);
+        json_writer_begin_object(&w);
+        json_writer_key(&w, "ssid");
+        json_writer_string_len(&w, networks[i], strnlen(networks[i], sizeof(networks[i])));
+        json_writer_field_int(&w, "signal_strength", -60);
+        json_writer_field_string(&w, "security_type", "WPA2");
+        json_writer_field_string(&w, "frequency", "2.4GHz");
+        json_writer_field_uint(&w, "channel", 6);
+        json_writer_field_string(&w, "encryption", "AES");
+        json_writer_end_object(&w);
+    }
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "scan_duration_ms", 2500);
+    json_writer_field_uint(&w, "total_networks", network_count);
+    json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/network/wifi/connect
@@ -2343,7 +2218,9 @@ int api_handle_network_wifi_connect(const api_mgr_http_request_t *req, api_mgr_h
     
     int result = system(command);
     
-    char json[1024];
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 1024);
+    json_writer_begin_object(&w);
     if (result == 0) {
         // Success - get connection info
         char ip_cmd[256] = "ip addr show wlan0 | grep 'inet ' | awk '{print $2}' | cut -d/ -f1";
@@ -2356,41 +2233,27 @@ int api_handle_network_wifi_connect(const api_mgr_http_request_t *req, api_mgr_h
             pclose(fp);
         }
         
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":true,"
-            "\"message\":\"WiFi connection established\","
-            "\"data\":{"
-            "\"ssid\":\"%s\","
-            "\"connection_time_ms\":3500,"
-            "\"signal_strength\":-60,"
-            "\"ip_address\":\"%s\","
-            "\"connection_id\":\"conn_%ld\","
-            "\"timestamp\":%ld"
-            "}"
-            "}",
-            ssid[0] ? ssid : "Connected",
-            ip_output,
-            time(NULL),
-            time(NULL)
-        );
+        char connection_id[32];
+        snprintf(connection_id, sizeof(connection_id), "conn_%ld", (long)time(NULL));
+        json_writer_field_bool(&w, "success", true);
+        json_writer_field_string(&w, "message", "WiFi connection established");
+        json_writer_key(&w, "data");
+        json_writer_begin_object(&w);
+        json_writer_field_string(&w, "ssid", ssid[0] ? ssid : "Connected");
+        json_writer_field_uint(&w, "connection_time_ms", 3500);
+        json_writer_field_int(&w, "signal_strength", -60);
+        json_writer_field_string(&w, "ip_address", ip_output);
+        json_writer_field_string(&w, "connection_id", connection_id);
     } else {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":false,"
-            "\"message\":\"WiFi connection failed\","
-            "\"error\":\"CONNECTION_FAILED\","
-            "\"data\":{"
-            "\"ssid\":\"%s\","
-            "\"timestamp\":%ld"
-            "}"
-            "}",
-            ssid[0] ? ssid : "Unknown",
-            time(NULL)
-        );
-    }
-    
-    return api_manager_create_success_response(res, json);
+        json_writer_field_bool(&w, "success", false);
+        json_writer_field_string(&w, "message", "WiFi connection failed");
+        json_writer_field_string(&w, "error", "CONNECTION_FAILED");
+        json_writer_key(&w, "data");
+        json_writer_begin_object(&w);
+        json_writer_field_string(&w, "ssid", ssid[0] ? ssid : "Unknown");
+    }
+    json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/network/wifi/disconnect
@@ -2401,112 +2264,230 @@ int api_handle_network_wifi_disconnect(const api_mgr_http_request_t *req, api_mg
     char command[128] = "nmcli dev disconnect wlan0";
     int result = system(command);
     
-    char json[512];
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 512);
+    json_writer_begin_object(&w);
     if (result == 0) {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":true,"
-            "\"message\":\"WiFi disconnected successfully\","
-            "\"data\":{"
-            "\"previous_ssid\":\"Disconnected\","
-            "\"disconnect_time_ms\":500,"
-            "\"timestamp\":%ld"
-            "}"
-            "}",
-            time(NULL)
-        );
+        json_writer_field_bool(&w, "success", true);
+        json_writer_field_string(&w, "message", "WiFi disconnected successfully");
+        json_writer_key(&w, "data");
+        json_writer_begin_object(&w);
+        json_writer_field_string(&w, "previous_ssid", "Disconnected");
+        json_writer_field_uint(&w, "disconnect_time_ms", 500);
+        json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
+        json_writer_end_object(&w);
     } else {
-        snprintf(json, sizeof(json),
-            "{"
-            "\"success\":false,"
-            "\"message\":\"WiFi disconnect failed\","
-            "\"error\":\"DISCONNECT_FAILED\","
-            "\"timestamp\":%ld"
-            "}",
-            time(NULL)
-        );
+        json_writer_field_bool(&w, "success", false);
+        json_writer_field_string(&w, "message", "WiFi disconnect failed");
+        json_writer_field_string(&w, "error", "DISCONNECT_FAILED");
+        json_writer_field_int(&w, "timestamp", (int64_t)time(NULL));
     }
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_end_object(&w);
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // GET /api/v1/network/performance
 int api_handle_network_performance(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     (void)req;
     
-    // Mock network performance data
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-        "\"latency\":{"
-        "\"average_ms\":25.5,"
-        "\"min_ms\":12.0,"
-        "\"max_ms\":45.0,"
-        "\"packet_loss_percent\":0.1"
-        "},"
-        "\"throughput\":{"
-        "\"download_mbps\":45.2,"
-        "\"upload_mbps\":38.7,"
-        "\"total_bytes\":15728640"
-        "},"
-        "\"signal_quality\":{"
-        "\"strength_dbm\":-45,"
-        "\"quality_percent\":95,"
-        "\"noise_level\":-90"
-        "},"
-        "\"connection_stability\":{"
-        "\"uptime_percent\":99.8,"
-        "\"reconnection_count\":2,"
-        "\"last_reconnect\":%ld"
-        "},"
-        "\"timestamp\":%ld"
-        "}"
-        "}",
-        time(NULL) - 3600, // 1 hour ago
-        time(NULL)
-    );
-    
-    return api_manager_create_success_response(res, json);
+    // Placeholder network performance data
+    int64_t now = (int64_t)time(NULL);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_key(&w, "latency");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "average_ms", 25.5, 1);
+    json_writer_field_fixed(&w, "min_ms", 12.0, 1);
+    json_writer_field_fixed(&w, "max_ms", 45.0, 1);
+    json_writer_field_fixed(&w, "packet_loss_percent", 0.1, 1);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "throughput");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "download_mbps", 45.2, 1);
+    json_writer_field_fixed(&w, "upload_mbps", 38.7, 1);
+    json_writer_field_uint(&w, "total_bytes", 15728640);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "signal_quality");
+    json_writer_begin_object(&w);
+    json_writer_field_int(&w, "strength_dbm", -45);
+    json_writer_field_uint(&w, "quality_percent", 95);
+    json_writer_field_int(&w, "noise_level", -90);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "connection_stability");
+    json_writer_begin_object(&w);
+    json_writer_field_fixed(&w, "uptime_percent", 99.8, 1);
+    json_writer_field_uint(&w, "reconnection_count", 2);
+    json_writer_field_int(&w, "last_reconnect", now - 3600); // 1 hour ago
+    json_writer_end_object(&w);
+    json_writer_field_int(&w, "timestamp", now);
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/network/health
 int api_handle_network_health(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     (void)req;
     
-    // Mock network health data
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-        "\"overall_health\":\"excellent\","
-        "\"health_score\":95.5,"
-        "\"status\":{"
-        "\"connection_active\":true,"
-        "\"internet_accessible\":true,"
-        "\"dns_resolution\":true,"
-        "\"signal_stable\":true"
-        "},"
-        "\"diagnostics\":{"
-        "\"ping_test\":\"pass\","
-        "\"dns_test\":\"pass\","
-        "\"speed_test\":\"pass\","
-        "\"stability_test\":\"pass\""
-        "},"
-        "\"recommendations\":["
-        "\"Network performance is optimal\","
-        "\"Consider updating firmware for latest security patches\""
-        "],"
-        "\"last_check\":%ld,"
-        "\"next_check\":%ld"
-        "}"
-        "}",
-        time(NULL),
-        time(NULL) + 3600 // 1 hour from now
-    );
-    
-    return api_manager_create_success_response(res, json);
+    // Placeholder network health data
+    int64_t now = (int64_t)time(NULL);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_string(&w, "overall_health", "excellent");
+    json_writer_field_fixed(&w, "health_score", 95.5, 1);
+    json_writer_key(&w, "status");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "connection_active", true);
+    json_writer_field_bool(&w, "internet_accessible", true);
+    json_writer_field_bool(&w, "dns_resolution", true);
+    json_writer_field_bool(&w, "signal_stable", true);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "diagnostics");
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "ping_test", "pass");
+    json_writer_field_string(&w, "dns_test", "pass");
+    json_writer_field_string(&w, "speed_test", "pass");
+    json_writer_field_string(&w, "stability_test", "pass");
+    json_writer_end_object(&w);
+    json_writer_key(&w, "recommendations");
+    json_writer_begin_array(&w);
+    json_writer_string(&w, "Network performance is optimal");
+    json_writer_string(&w, "Consider updating firmware for latest security patches");
+    json_writer_end_array(&w);
+    json_writer_field_int(&w, "last_check", now);
+    json_writer_field_int(&w, "next_check", now + 3600); // 1 hour from now
+    return api_manager_json_end_data(res, &w);
+}
+
+// ============================================================================
+// Logging diagnostics: runtime log levels and Modbus frame trace
+// ============================================================================
+
+// Copy the string value of "key":"value" from a flat JSON body; 0 on success
+static int json_string_field(const char *json, const char *key, char *out, size_t out_len) {
+    char pattern[48];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    const char *p = strstr(json, pattern);
+    if (!p) return -1;
+    p = strchr(p + strlen(pattern), ':');
+    if (!p) return -1;
+    p = strchr(p, '"');
+    if (!p) return -1;
+    p++;
+    size_t n = 0;
+    while (p[n] && p[n] != '"' && n + 1 < out_len) { out[n] = p[n]; n++; }
+    if (p[n] != '"') return -1;
+    out[n] = '\0';
+    return 0;
+}
+
+// GET /api/v1/system/log-levels
+int api_handle_log_levels_get(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
+    (void)req;
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 1024);
+    json_writer_field_string(&w, "compile_level", hal_log_level_name((hal_log_level_t)HAL_LOG_COMPILE_LEVEL));
+    json_writer_key(&w, "levels");
+    json_writer_begin_object(&w);
+    for (int c = 0; c < HAL_LOG_COMP_COUNT; c++) {
+        json_writer_field_string(&w, hal_log_component_name((hal_log_component_t)c),
+                                 hal_log_level_name(hal_log_get_component_level((hal_log_component_t)c)));
+    }
+    json_writer_end_object(&w);
+    hal_log_stats_t stats = {0};
+    (void)hal_log_get_stats(&stats);
+    json_writer_key(&w, "stats");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "records_written", stats.records_written);
+    json_writer_field_uint(&w, "records_dropped", stats.records_dropped);
+    json_writer_field_uint(&w, "records_direct", stats.records_direct);
+    json_writer_field_uint(&w, "records_suppressed", stats.records_suppressed);
+    json_writer_field_uint(&w, "frames_traced", stats.frames_traced);
+    json_writer_field_uint(&w, "rings_in_use", stats.rings_in_use);
+    json_writer_end_object(&w);
+    return api_manager_json_end_data(res, &w);
 }
 
+// POST /api/v1/system/log-levels  {"component":"rs485"|"all","level":"debug"}
+int api_handle_log_levels_set(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
+    char comp_name[16], level_name[16];
+    if (!req->body || json_string_field(req->body, "component", comp_name, sizeof(comp_name)) != 0 ||
+        json_string_field(req->body, "level", level_name, sizeof(level_name)) != 0) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Expected {\"component\":...,\"level\":...}");
+    }
+    hal_log_level_t level;
+    if (hal_log_level_from_name(level_name, &level) != HAL_STATUS_OK) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Unknown log level");
+    }
+    if (strcmp(comp_name, "all") == 0) {
+        for (int c = 0; c < HAL_LOG_COMP_COUNT; c++) (void)hal_log_set_component_level((hal_log_component_t)c, level);
+    } else {
+        hal_log_component_t comp = hal_log_component_from_name(comp_name);
+        if (comp == HAL_LOG_COMP_COUNT) {
+            return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Unknown log component");
+        }
+        (void)hal_log_set_component_level(comp, level);
+    }
+    return api_handle_log_levels_get(req, res);
+}
+
+// GET /api/v1/modules/{id}/trace?after=<seq>
+int api_handle_module_trace_get(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
+    int module_id = module_id_from_request(req);
+    if (module_id == -1) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Invalid module ID");
+    }
+    unsigned int after = 0;
+    const char *query = strchr(req->path, '?');
+    if (query && (query = strstr(query, "after=")) != NULL) sscanf(query + 6, "%u", &after);
+    
+    enum { TRACE_PAGE = 64 };
+    hal_log_trace_record_t records[TRACE_PAGE];
+    uint32_t count = hal_log_trace_read((uint8_t)module_id, after, records, TRACE_PAGE);
+    
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 256 + (size_t)count * (HAL_LOG_TRACE_BYTES * 2 + 96));
+    json_writer_field_int(&w, "module_id", module_id);
+    json_writer_field_bool(&w, "enabled", hal_log_trace_is_enabled((uint8_t)module_id));
+    json_writer_key(&w, "frames");
+    json_writer_begin_array(&w);
+    uint32_t last_seq = after;
+    for (uint32_t i = 0; i < count; i++) {
+        const hal_log_trace_record_t *r = &records[i];
+        uint16_t kept = r->length < HAL_LOG_TRACE_BYTES ? r->length : HAL_LOG_TRACE_BYTES;
+        json_writer_begin_object(&w);
+        json_writer_field_uint(&w, "seq", r->seq);
+        json_writer_field_uint(&w, "timestamp_us", r->timestamp_us);
+        json_writer_field_string(&w, "dir", r->dir == HAL_LOG_TRACE_TX ? "tx" : "rx");
+        json_writer_field_uint(&w, "length", r->length);
+        json_writer_key(&w, "data");
+        json_writer_hex_bytes(&w, r->data, kept);
+        json_writer_end_object(&w);
+        last_seq = r->seq;
+    }
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "count", count);
+    json_writer_field_uint(&w, "next_after", last_seq);
+    return api_manager_json_end_data(res, &w);
+}
+
+// POST /api/v1/modules/{id}/trace  {"enabled":true}
+int api_handle_module_trace_set(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
+    int module_id = module_id_from_request(req);
+    if (module_id == -1) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Invalid module ID");
+    }
+    const char *p = req->body ? strstr(req->body, "\"enabled\"") : NULL;
+    if (!p || !(p = strchr(p, ':'))) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Expected {\"enabled\":true|false}");
+    }
+    while (*++p == ' ') {}
+    bool enable = strncmp(p, "true", 4) == 0;
+    if (!enable && strncmp(p, "false", 5) != 0) {
+        return api_manager_create_error_response(res, API_MGR_RESPONSE_BAD_REQUEST, "Expected {\"enabled\":true|false}");
+    }
+    hal_log_trace_enable((uint8_t)module_id, enable);
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 128);
+    json_writer_field_int(&w, "module_id", module_id);
+    json_writer_field_bool(&w, "enabled", enable);
+    return api_manager_json_end_data(res, &w);
+}
@@ -86,6 +86,7 @@ int api_handle_modules_list(const api_mgr_http_request_t *req, api_mgr_http_resp
 int api_handle_module_status_by_id(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
 int api_handle_system_state(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
 int api_handle_control_status(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
+int api_handle_control_timing(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
 // New: Module Manager extended endpoints
 int api_handle_modules_stats(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
 int api_handle_modules_scan(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
@@ -148,6 +149,12 @@ int api_handle_module_command(const api_mgr_http_request_t *req, api_mgr_http_re
 int api_handle_module_history(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
 int api_handle_module_health(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
 
+// Logging diagnostics: runtime log levels and per-module Modbus frame trace
+int api_handle_log_levels_get(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
+int api_handle_log_levels_set(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
+int api_handle_module_trace_get(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
+int api_handle_module_trace_set(const api_mgr_http_request_t *req, api_mgr_http_response_t *res);
+
 // Deprecated: WebSocket helper functions removed (Firmware is HTTP-only on port 8080)
 const char* get_module_name_by_id(int module_id);
 int get_module_telemetry_data(int module_id, api_module_telemetry_t *telemetry);
@@ -3,10 +3,17 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <sys/time.h>
+#include "http_event_server.h"
+#include "http_router.h"
+#include "json_writer.h"
 
 #define API_MANAGER_MAX_HEADERS 16
 #define API_MANAGER_MAX_PATH_LENGTH 256
 #define API_MANAGER_MAX_CLIENTS 8
+#define API_MANAGER_MAX_ENDPOINTS 128
+
+// Route flags for api_manager_register_route()
+#define API_ROUTE_FLAG_AUTH 0x01u   // Authorization header is checked before the handler runs
 
 typedef enum { API_MGR_HTTP_GET=0, API_MGR_HTTP_POST } api_mgr_http_method_t;
 typedef enum { 
@@ -14,8 +21,10 @@ typedef enum {
     API_MGR_RESPONSE_BAD_REQUEST=400, 
     API_MGR_RESPONSE_UNAUTHORIZED=401,
     API_MGR_RESPONSE_NOT_FOUND=404, 
+    API_MGR_RESPONSE_METHOD_NOT_ALLOWED=405,
     API_MGR_RESPONSE_INTERNAL_SERVER_ERROR=500,
-    API_MGR_RESPONSE_SERVICE_UNAVAILABLE=503
+    API_MGR_RESPONSE_SERVICE_UNAVAILABLE=503,
+    API_MGR_RESPONSE_GATEWAY_TIMEOUT=504
 } api_mgr_http_response_code_t;
 
 typedef struct { char name[64]; char value[256]; } api_mgr_http_header_t;
@@ -26,6 +35,8 @@ typedef struct {
     size_t body_length;
     api_mgr_http_header_t headers[API_MANAGER_MAX_HEADERS];
     int header_count;
+    http_router_param_t path_params[HTTP_ROUTER_MAX_PARAMS];   // Captured by the route pattern
+    uint32_t path_param_count;
 } api_mgr_http_request_t;
 
 typedef struct {
@@ -34,6 +45,7 @@ typedef struct {
     uint32_t header_count;
     char *body;
     size_t body_length;
+    bool body_borrowed;         // body lives in the request arena: sent by the core, not freed
 } api_mgr_http_response_t;
 
 typedef struct { uint16_t http_port; } api_mgr_config_t;
@@ -43,11 +55,31 @@ int api_manager_start(void);
 int api_manager_stop(void);
 int api_manager_deinit(void);
 
+// Connection/request counters and per-route latency histograms of the HTTP server core
+int api_manager_get_server_stats(http_event_server_stats_t *stats);
+int api_manager_get_route_stats(http_event_route_stats_t *routes, uint32_t max_routes, uint32_t *count);
+
+// Patterns may capture typed segments, e.g. "/api/v1/modules/{id:u8}/registers/{reg:hex16}"
+int api_manager_register_route(const char *pattern, api_mgr_http_method_t method,
+                               int (*handler)(const api_mgr_http_request_t*, api_mgr_http_response_t*), uint32_t flags);
+// Legacy form: POST routes under /config/ or /state/ get API_ROUTE_FLAG_AUTH
 int api_manager_register_endpoint(const char *path, api_mgr_http_method_t method,
                                   int (*handler)(const api_mgr_http_request_t*, api_mgr_http_response_t*));
+// Numeric value of a captured path parameter; 0 on success, -1 if the route has no such parameter
+int api_manager_get_path_param(const api_mgr_http_request_t *req, const char *name, uint32_t *value);
 
+// Response bodies are built in the API worker's request arena, reset at the start of each request
 int api_manager_create_success_response(api_mgr_http_response_t *response, const char *json);
 int api_manager_create_error_response(api_mgr_http_response_t *response, api_mgr_http_response_code_t code, const char *msg);
+// Start a JSON body: on the request arena inside a handler, on the heap elsewhere (tests, tools)
+int api_manager_json_begin(json_writer_t *writer, size_t size_hint);
+// Send the writer's document with the given status; a failed or unfinished document becomes a 500
+int api_manager_create_json_response(api_mgr_http_response_t *response, api_mgr_http_response_code_t code,
+                                     json_writer_t *writer);
+// The usual envelope: api_manager_json_begin_data() opens {"success":true,"data":{ and
+// api_manager_json_end_data() closes both objects and sends a 200
+int api_manager_json_begin_data(json_writer_t *writer, size_t size_hint);
+int api_manager_json_end_data(api_mgr_http_response_t *response, json_writer_t *writer);
 
 // Security functions
 int api_manager_validate_auth_header(const char *auth_header);
@@ -63,33 +63,25 @@ int api_handle_config_get(const api_mgr_http_request_t *req, api_mgr_http_respon
             "Failed to get system configuration");
     }
     
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"state_timeout_ms\":%u,"
-            "\"update_period_ms\":%u,"
-            "\"auto_recovery_enabled\":%s,"
-            "\"safety_monitoring_enabled\":%s,"
-            "\"communication_monitoring_enabled\":%s,"
-            "\"sensor_monitoring_enabled\":%s,"
-            "\"version\":\"1.0\","
-            "\"last_updated\":%lu"
-        "},"
-        "\"timestamp\":%lu"
-        "}",
-        config.state_timeout_ms,
-        config.update_period_ms,
-        config.auto_recovery_enabled ? "true" : "false",
-        config.safety_monitoring_enabled ? "true" : "false",
-        config.communication_monitoring_enabled ? "true" : "false",
-        config.sensor_monitoring_enabled ? "true" : "false",
-        hal_get_timestamp_ms(),
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 512);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "state_timeout_ms", config.state_timeout_ms);
+    json_writer_field_uint(&w, "update_period_ms", config.update_period_ms);
+    json_writer_field_bool(&w, "auto_recovery_enabled", config.auto_recovery_enabled);
+    json_writer_field_bool(&w, "safety_monitoring_enabled", config.safety_monitoring_enabled);
+    json_writer_field_bool(&w, "communication_monitoring_enabled", config.communication_monitoring_enabled);
+    json_writer_field_bool(&w, "sensor_monitoring_enabled", config.sensor_monitoring_enabled);
+    json_writer_field_string(&w, "version", "1.0");
+    json_writer_field_uint(&w, "last_updated", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // POST /api/v1/config/state-machine
@@ -129,25 +121,21 @@ int api_handle_config_set(const api_mgr_http_request_t *req, api_mgr_http_respon
             "Failed to apply configuration");
     }
     
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Configuration updated successfully\","
-        "\"applied_config\":{"
-            "\"state_timeout_ms\":%u,"
-            "\"update_period_ms\":%u,"
-            "\"auto_recovery_enabled\":%s"
-        "},"
-        "\"timestamp\":%lu"
-        "}",
-        config.state_timeout_ms,
-        config.update_period_ms,
-        config.auto_recovery_enabled ? "true" : "false",
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 256);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_field_string(&w, "message", "Configuration updated successfully");
+    json_writer_key(&w, "applied_config");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "state_timeout_ms", config.state_timeout_ms);
+    json_writer_field_uint(&w, "update_period_ms", config.update_period_ms);
+    json_writer_field_bool(&w, "auto_recovery_enabled", config.auto_recovery_enabled);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // PUT /api/v1/config/timeouts
@@ -192,23 +180,20 @@ int api_handle_config_timeouts(const api_mgr_http_request_t *req, api_mgr_http_r
             "Failed to apply timeout configuration");
     }
     
-    char json[256];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Timeout configuration updated\","
-        "\"timeouts\":{"
-            "\"state_timeout_ms\":%u,"
-            "\"update_period_ms\":%u"
-        "},"
-        "\"timestamp\":%lu"
-        "}",
-        config.state_timeout_ms,
-        config.update_period_ms,
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 256);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_field_string(&w, "message", "Timeout configuration updated");
+    json_writer_key(&w, "timeouts");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "state_timeout_ms", config.state_timeout_ms);
+    json_writer_field_uint(&w, "update_period_ms", config.update_period_ms);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // GET /api/v1/state/statistics
@@ -225,60 +210,45 @@ int api_handle_state_statistics(const api_mgr_http_request_t *req, api_mgr_http_
     system_status_t status;
     system_state_machine_get_status(&status);
     
-    char json[1536];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"current_state\":\"%s\","
-            "\"time_in_states\":{"
-                "\"boot_ms\":%lu,"
-                "\"idle_ms\":%lu,"
-                "\"moving_ms\":%lu,"
-                "\"paused_ms\":%lu,"
-                "\"docking_ms\":%lu,"
-                "\"config_ms\":%lu,"
-                "\"fault_ms\":%lu,"
-                "\"estop_ms\":%lu,"
-                "\"safe_ms\":%lu"
-            "},"
-            "\"transition_counters\":{"
-                "\"total_transitions\":%u,"
-                "\"emergency_count\":%u,"
-                "\"fault_count\":%u"
-            "},"
-            "\"performance_metrics\":{"
-                "\"current_state_duration_ms\":%u"
-            "},"
-            "\"system_health\":{"
-                "\"system_ready\":%s,"
-                "\"safety_ok\":%s,"
-                "\"communication_ok\":%s,"
-                "\"sensors_ok\":%s"
-            "}"
-        "},"
-        "\"timestamp\":%lu"
-        "}",
-        system_state_machine_get_state_name(status.current_state),
-        stats.time_in_boot_ms,
-        stats.time_in_idle_ms,
-        stats.time_in_moving_ms,
-        stats.time_in_paused_ms,
-        stats.time_in_docking_ms,
-        stats.time_in_config_ms,
-        stats.time_in_fault_ms,
-        stats.time_in_estop_ms,
-        stats.time_in_safe_ms,
-        stats.total_transitions,
-        stats.emergency_count,
-        stats.fault_count,
-10000U, // WORKAROUND: Fixed reasonable duration (10 seconds)
-        status.system_ready ? "true" : "false",
-        status.safety_ok ? "true" : "false",
-        status.communication_ok ? "true" : "false",
-        status.sensors_ok ? "true" : "false",
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 1024);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "current_state", system_state_machine_get_state_name(status.current_state));
+    json_writer_key(&w, "time_in_states");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "boot_ms", stats.time_in_boot_ms);
+    json_writer_field_uint(&w, "idle_ms", stats.time_in_idle_ms);
+    json_writer_field_uint(&w, "moving_ms", stats.time_in_moving_ms);
+    json_writer_field_uint(&w, "paused_ms", stats.time_in_paused_ms);
+    json_writer_field_uint(&w, "docking_ms", stats.time_in_docking_ms);
+    json_writer_field_uint(&w, "config_ms", stats.time_in_config_ms);
+    json_writer_field_uint(&w, "fault_ms", stats.time_in_fault_ms);
+    json_writer_field_uint(&w, "estop_ms", stats.time_in_estop_ms);
+    json_writer_field_uint(&w, "safe_ms", stats.time_in_safe_ms);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "transition_counters");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "total_transitions", stats.total_transitions);
+    json_writer_field_uint(&w, "emergency_count", stats.emergency_count);
+    json_writer_field_uint(&w, "fault_count", stats.fault_count);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "performance_metrics");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "current_state_duration_ms", 10000U); // WORKAROUND: Fixed reasonable duration (10 seconds)
+    json_writer_end_object(&w);
+    json_writer_key(&w, "system_health");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "system_ready", status.system_ready);
+    json_writer_field_bool(&w, "safety_ok", status.safety_ok);
+    json_writer_field_bool(&w, "communication_ok", status.communication_ok);
+    json_writer_field_bool(&w, "sensors_ok", status.sensors_ok);
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
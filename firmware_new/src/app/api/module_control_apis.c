@@ -17,6 +17,22 @@
 #include <stdio.h>
 #include <string.h>
 
+/**
+ * @brief Open {"success":true,"message":...,"data":{ for api_manager_json_end_data()
+ * @param writer Writer
+ * @param message Message
+ * @return 0 on success, -1 if the buffer cannot be allocated
+ */
+static int modules_json_begin_message(json_writer_t *writer, const char *message) {
+    int rc = api_manager_json_begin(writer, 256);
+    json_writer_begin_object(writer);
+    json_writer_field_bool(writer, "success", true);
+    json_writer_field_string(writer, "message", message);
+    json_writer_key(writer, "data");
+    json_writer_begin_object(writer);
+    return rc;
+}
+
 // GET /api/v1/modules/status
 int api_handle_modules_status_get(const api_mgr_http_request_t *req, api_mgr_http_response_t *res) {
     (void)req;
@@ -41,30 +57,27 @@ int api_handle_modules_status_get(const api_mgr_http_request_t *req, api_mgr_htt
     bool scan_active = comm_manager_is_scanning();
     
     // Create response JSON (polling details omitted in this build)
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"registry\":{"
-                "\"total_modules\":%u,"
-                "\"active_modules\":%u,"
-                "\"failed_modules\":%u"
-            "},"
-            "\"scanning\":{"
-                "\"scan_active\":%s"
-            "}"
-        "},"
-        "\"timestamp\":%lu"
-        "}",
-        total_modules,
-        active_modules,
-        failed_modules,
-        scan_active ? "true" : "false",
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 256);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_key(&w, "registry");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "total_modules", total_modules);
+    json_writer_field_uint(&w, "active_modules", active_modules);
+    json_writer_field_uint(&w, "failed_modules", failed_modules);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "scanning");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "scan_active", scan_active);
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // POST /api/v1/modules/start-scan
@@ -85,20 +98,12 @@ int api_handle_modules_start_scan(const api_mgr_http_request_t *req, api_mgr_htt
     }
     
     // Create success response
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Module scanning started\","
-        "\"data\":{"
-            "\"scan_active\":true,"
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        hal_get_timestamp_ms()
-    );
+    json_writer_t w;
+    (void)modules_json_begin_message(&w, "Module scanning started");
+    json_writer_field_bool(&w, "scan_active", true);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
     
-    return api_manager_create_success_response(res, json);
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/modules/stop-scan
@@ -117,21 +122,13 @@ int api_handle_modules_stop_scan(const api_mgr_http_request_t *req, api_mgr_http
     // Polling manager control is not available in this build; skip
     
     // Create success response
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Module scanning stopped\","
-        "\"data\":{"
-            "\"scan_active\":false,"
-            "\"polling_active\":false,"
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        hal_get_timestamp_ms()
-    );
+    json_writer_t w;
+    (void)modules_json_begin_message(&w, "Module scanning stopped");
+    json_writer_field_bool(&w, "scan_active", false);
+    json_writer_field_bool(&w, "polling_active", false);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
     
-    return api_manager_create_success_response(res, json);
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/modules/pause-scan
@@ -189,25 +186,14 @@ int api_handle_modules_discover(const api_mgr_http_request_t *req, api_mgr_http_
     }
     
     // Create success response
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Module discovery completed\","
-        "\"data\":{"
-            "\"total_modules\":%u,"
-            "\"active_modules\":%u,"
-            "\"failed_modules\":%u,"
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        total_modules,
-        active_modules,
-        failed_modules,
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)modules_json_begin_message(&w, "Module discovery completed");
+    json_writer_field_uint(&w, "total_modules", total_modules);
+    json_writer_field_uint(&w, "active_modules", active_modules);
+    json_writer_field_uint(&w, "failed_modules", failed_modules);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/modules/list
@@ -223,58 +209,30 @@ int api_handle_modules_list(const api_mgr_http_request_t *req, api_mgr_http_resp
             "Failed to get module list");
     }
     
-    // Create JSON response
-    char json[4096] = "{"
-        "\"success\":true,"
-        "\"data\":{"
-            "\"modules\":[";
-    
-    size_t json_len = strlen(json);
-    
+    // Create JSON response; the writer grows, so no module is dropped for space
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 256 + module_count * 96);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_key(&w, "modules");
+    json_writer_begin_array(&w);
     for (size_t i = 0; i < module_count; i++) {
-        char module_json[512];
-        snprintf(module_json, sizeof(module_json),
-            "%s{"
-                "\"address\":\"0x%02X\","
-                "\"type\":\"%s\","
-                "\"status\":\"%s\","
-                "\"last_seen_ms\":%lu"
-            "}",
-            i > 0 ? "," : "",
-            modules[i].address,
-            module_manager_get_type_name(modules[i].type),
-            module_manager_get_status_name(modules[i].status),
-            (unsigned long)modules[i].last_seen_ms
-        );
-        
-        // Check if we have space
-        if (json_len + strlen(module_json) < sizeof(json) - 100) {
-            strcat(json, module_json);
-            json_len += strlen(module_json);
-        } else {
-            break; // JSON too large
-        }
+        json_writer_begin_object(&w);
+        json_writer_field_hex(&w, "address", modules[i].address, 2);
+        json_writer_field_string(&w, "type", module_manager_get_type_name(modules[i].type));
+        json_writer_field_string(&w, "status", module_manager_get_status_name(modules[i].status));
+        json_writer_field_uint(&w, "last_seen_ms", modules[i].last_seen_ms);
+        json_writer_end_object(&w);
     }
+    json_writer_end_array(&w);
+    json_writer_field_uint(&w, "total_count", module_count);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
     
-    // Close JSON
-    strcat(json, "],"
-        "\"total_count\":");
-    
-    char count_str[16];
-    snprintf(count_str, sizeof(count_str), "%lu", (unsigned long)module_count);
-    strcat(json, count_str);
-    
-    strcat(json, ","
-        "\"timestamp\":");
-    
-    char timestamp_str[32];
-    snprintf(timestamp_str, sizeof(timestamp_str), "%lu", hal_get_timestamp_ms());
-    strcat(json, timestamp_str);
-    
-    strcat(json, "}"
-        "}");
-    
-    return api_manager_create_success_response(res, json);
+    return api_manager_create_json_response(res, API_MGR_RESPONSE_OK, &w);
 }
 
 // POST /api/v1/modules/reset
@@ -287,26 +245,16 @@ int api_handle_modules_reset(const api_mgr_http_request_t *req, api_mgr_http_res
     
     // Reset module registry
     int reset_rc = registry_clear();
-    (void)reset_rc;
     
     // Create success response
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Module system reset completed\","
-        "\"data\":{"
-            "\"scan_active\":false,"
-            "\"polling_active\":false,"
-            "\"registry_reset\":%s,"
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        reset_rc == 0 ? "true" : "false",
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)modules_json_begin_message(&w, "Module system reset completed");
+    json_writer_field_bool(&w, "scan_active", false);
+    json_writer_field_bool(&w, "polling_active", false);
+    json_writer_field_bool(&w, "registry_reset", reset_rc == 0);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    
+    return api_manager_json_end_data(res, &w);
 }
 
 // POST /api/v1/modules/health-check
@@ -332,27 +280,16 @@ int api_handle_modules_health_check(const api_mgr_http_request_t *req, api_mgr_h
     }
     
     // Create response
-    char json[1024];
-    snprintf(json, sizeof(json),
-        "{"
-        "\"success\":true,"
-        "\"message\":\"Module health check completed\","
-        "\"data\":{"
-            "\"total_modules\":%u,"
-            "\"healthy_modules\":%u,"
-            "\"unhealthy_modules\":%u,"
-            "\"health_percentage\":%.1f,"
-            "\"timestamp\":%lu"
-        "}"
-        "}",
-        total_modules,
-        healthy_modules,
-        unhealthy_modules,
-        total_modules > 0 ? (float)healthy_modules / total_modules * 100.0f : 0.0f,
-        hal_get_timestamp_ms()
-    );
-    
-    return api_manager_create_success_response(res, json);
+    json_writer_t w;
+    (void)modules_json_begin_message(&w, "Module health check completed");
+    json_writer_field_uint(&w, "total_modules", total_modules);
+    json_writer_field_uint(&w, "healthy_modules", healthy_modules);
+    json_writer_field_uint(&w, "unhealthy_modules", unhealthy_modules);
+    json_writer_field_fixed(&w, "health_percentage",
+        total_modules > 0 ? (float)healthy_modules / (float)total_modules * 100.0f : 0.0f, 1);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    
+    return api_manager_json_end_data(res, &w);
 }
 
 // GET /api/v1/modules/scan-status
@@ -365,42 +302,16 @@ int api_handle_modules_scan_status(const api_mgr_http_request_t *req, api_mgr_ht
     module_stats_t stats;
     int have_stats = (module_manager_get_statistics(&stats) == HAL_STATUS_OK);
 
-    char json[512];
+    json_writer_t w;
+    (void)api_manager_json_begin_data(&w, 256);
+    json_writer_field_bool(&w, "scan_active", scan_active);
+    json_writer_field_bool(&w, "registry_scanning", registry_scanning);
     if (have_stats) {
-        snprintf(json, sizeof(json),
-            "{\n"
-            "  \"success\": true,\n"
-            "  \"data\": {\n"
-            "    \"scan_active\": %s,\n"
-            "    \"registry_scanning\": %s,\n"
-            "    \"discovery_total_ms\": %u,\n"
-            "    \"p95_ms\": %u,\n"
-            "    \"p99_ms\": %u,\n"
-            "    \"timestamp\": %lu\n"
-            "  }\n"
-            "}",
-            scan_active ? "true" : "false",
-            registry_scanning ? "true" : "false",
-            stats.discovery_total_ms,
-            stats.discovery_p95_ms,
-            stats.discovery_p99_ms,
-            hal_get_timestamp_ms()
-        );
-    } else {
-        snprintf(json, sizeof(json),
-            "{\n"
-            "  \"success\": true,\n"
-            "  \"data\": {\n"
-            "    \"scan_active\": %s,\n"
-            "    \"registry_scanning\": %s,\n"
-            "    \"timestamp\": %lu\n"
-            "  }\n"
-            "}",
-            scan_active ? "true" : "false",
-            registry_scanning ? "true" : "false",
-            hal_get_timestamp_ms()
-        );
+        json_writer_field_uint(&w, "discovery_total_ms", stats.discovery_total_ms);
+        json_writer_field_uint(&w, "p95_ms", stats.discovery_p95_ms);
+        json_writer_field_uint(&w, "p99_ms", stats.discovery_p99_ms);
     }
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
 
-    return api_manager_create_success_response(res, json);
+    return api_manager_json_end_data(res, &w);
 }
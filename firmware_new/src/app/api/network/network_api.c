@@ -82,6 +82,7 @@ static const char* admin_token = "oht50_admin_token_2025";
 
 // Internal Functions
 static const char* get_current_timestamp(void);
+static void set_json_headers(http_response_t *resp, int status_code, size_t body_length);
 static void log_api_request(const char *method, const char *path, int status_code);
 
 /**
@@ -263,15 +264,14 @@ int network_api_wrapper_handler(const api_mgr_http_request_t *req, api_mgr_http_
     // Call Network API handler
     int result = network_api_handle_request(&network_req, &network_resp);
     
-    // Convert response back to API Manager format
-    res->status_code = network_resp.status_code;
-    if (network_resp.body && strlen(network_resp.body) > 0) {
-        res->body = strdup(network_resp.body);
-        res->body_length = strlen(network_resp.body);
+    // Convert response back to API Manager format (body copied into the request arena)
+    if (network_resp.body[0] != '\0') {
+        (void)api_manager_create_success_response(res, network_resp.body);
     } else {
         res->body = NULL;
         res->body_length = 0;
     }
+    res->status_code = network_resp.status_code;
     
     return result;
 }
@@ -307,22 +307,11 @@ int network_api_send_json_response(http_response_t *resp, int status_code, const
         return -1;
     }
     
-    resp->status_code = status_code;
-    resp->content_length = strlen(json_data);
-    
-    // Set headers
-    snprintf(resp->headers, sizeof(resp->headers),
-             "Content-Type: application/json\r\n"
-             "Content-Length: %u\r\n"
-             "Access-Control-Allow-Origin: *\r\n"
-             "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
-             "Access-Control-Allow-Headers: Content-Type, Authorization\r\n\r\n",
-             resp->content_length);
-    
     // Set body
     strncpy(resp->body, json_data, sizeof(resp->body) - 1);
     resp->body[sizeof(resp->body) - 1] = '\0';
     
+    set_json_headers(resp, status_code, strlen(resp->body));
     return 0;
 }
 
@@ -334,12 +323,44 @@ int network_api_send_error_response(http_response_t *resp, int status_code, cons
         return -1;
     }
     
-    char json_error[512];
-    snprintf(json_error, sizeof(json_error),
-             "{\"success\": false, \"error\": \"%s\", \"timestamp\": \"%s\"}",
-             error_message, get_current_timestamp());
+    json_writer_t w;
+    json_writer_init(&w, resp->body, sizeof(resp->body));
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", false);
+    json_writer_field_string(&w, "error", error_message);
+    json_writer_field_string(&w, "timestamp", get_current_timestamp());
+    json_writer_end_object(&w);
+    
+    size_t len = 0;
+    if (!json_writer_data(&w, &len)) {
+        return network_api_send_json_response(resp, status_code, "{\"success\":false,\"error\":\"error\"}");
+    }
+    set_json_headers(resp, status_code, len);
+    return 0;
+}
+
+/**
+ * @brief Start a JSON document in the response body
+ */
+void network_api_json_begin(http_response_t *resp, json_writer_t *writer) {
+    json_writer_init(writer, resp->body, sizeof(resp->body));
+    json_writer_begin_object(writer);
+    json_writer_field_bool(writer, "success", true);
+}
+
+/**
+ * @brief Close a JSON document with its timestamp and send it
+ */
+int network_api_send_json_writer(http_response_t *resp, int status_code, json_writer_t *writer) {
+    json_writer_field_string(writer, "timestamp", get_current_timestamp());
+    json_writer_end_object(writer);
     
-    return network_api_send_json_response(resp, status_code, json_error);
+    size_t len = 0;
+    if (!json_writer_data(writer, &len)) {
+        return network_api_send_error_response(resp, 500, "Response too large");
+    }
+    set_json_headers(resp, status_code, len);
+    return 0;
 }
 
 /**
@@ -457,33 +478,23 @@ int handle_get_network_status(http_request_t *req __attribute__((unused)), http_
         return network_api_send_error_response(resp, 500, "Failed to get network status");
     }
     
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"connected\": %s, "
-             "\"current_ssid\": \"%s\", "
-             "\"signal_strength\": %d, "
-             "\"ip_address\": \"%s\", "
-             "\"gateway\": \"%s\", "
-             "\"dns\": \"%s\", "
-             "\"bytes_sent\": %u, "
-             "\"bytes_received\": %u, "
-             "\"latency_ms\": %.1f, "
-             "\"roaming_active\": %s"
-             "}, \"timestamp\": \"%s\"}",
-             status.connected ? "true" : "false",
-             status.current_ssid,
-             status.signal_strength,
-             status.ip_address,
-             status.gateway,
-             status.dns,
-             status.bytes_sent,
-             status.bytes_received,
-             status.latency_ms,
-             status.roaming_active ? "true" : "false",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "connected", status.connected);
+    json_writer_field_string(&w, "current_ssid", status.current_ssid);
+    json_writer_field_int(&w, "signal_strength", status.signal_strength);
+    json_writer_field_string(&w, "ip_address", status.ip_address);
+    json_writer_field_string(&w, "gateway", status.gateway);
+    json_writer_field_string(&w, "dns", status.dns);
+    json_writer_field_uint(&w, "bytes_sent", status.bytes_sent);
+    json_writer_field_uint(&w, "bytes_received", status.bytes_received);
+    json_writer_field_fixed(&w, "latency_ms", (double)status.latency_ms, 1);
+    json_writer_field_bool(&w, "roaming_active", status.roaming_active);
+    json_writer_end_object(&w);
+    
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -504,12 +515,10 @@ int handle_post_wifi_connect(http_request_t *req, http_response_t *resp) {
         return network_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"WiFi connection successful\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "WiFi connection successful");
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -523,12 +532,10 @@ int handle_post_wifi_disconnect(http_request_t *req __attribute__((unused)), htt
         return network_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"WiFi disconnection successful\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "WiFi disconnection successful");
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -542,42 +549,34 @@ int handle_get_wifi_scan(http_request_t *req __attribute__((unused)), http_respo
         return network_api_send_error_response(resp, 500, "Failed to scan WiFi networks");
     }
     
-    char json_response[4096] = "{\"success\": true, \"data\": {\"networks\": [";
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_key(&w, "networks");
+    json_writer_begin_array(&w);
     
     for (int i = 0; i < count; i++) {
-        if (i > 0) {
-            strcat(json_response, ", ");
-        }
-        
-        char network_json[512];
-        snprintf(network_json, sizeof(network_json),
-                 "{\"ssid\": \"%s\", \"bssid\": \"%s\", \"signal_strength\": %d, "
-                 "\"frequency\": %d, \"channel\": %d, \"security\": \"%s\", "
-                 "\"band\": \"%s\", \"hidden\": %s, \"connected\": %s}",
-                 networks[i].ssid,
-                 networks[i].bssid,
-                 networks[i].signal_strength_dbm,
-                 networks[i].frequency_mhz,
-                 networks[i].channel,
-                  networks[i].security_type == OHT_WIFI_SECURITY_WPA2 ? "WPA2" : 
-                  networks[i].security_type == OHT_WIFI_SECURITY_WPA3 ? "WPA3" : "Open",
-                 networks[i].band == WIFI_BAND_5G ? "5G" : "2.4G",
-                 networks[i].hidden ? "true" : "false",
-                 networks[i].connected ? "true" : "false");
-        
-        strcat(json_response, network_json);
-    }
-    
-    strcat(json_response, "], \"count\": ");
-    char count_str[16];
-    snprintf(count_str, sizeof(count_str), "%d", count);
-    strcat(json_response, count_str);
-    
-    snprintf(json_response + strlen(json_response), 
-             sizeof(json_response) - strlen(json_response),
-             "}, \"timestamp\": \"%s\"}", get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+        json_writer_begin_object(&w);
+        json_writer_field_string(&w, "ssid", networks[i].ssid);
+        json_writer_field_string(&w, "bssid", networks[i].bssid);
+        json_writer_field_int(&w, "signal_strength", networks[i].signal_strength_dbm);
+        json_writer_field_int(&w, "frequency", networks[i].frequency_mhz);
+        json_writer_field_int(&w, "channel", networks[i].channel);
+        json_writer_field_string(&w, "security",
+                                 networks[i].security_type == OHT_WIFI_SECURITY_WPA2 ? "WPA2" : 
+                                 networks[i].security_type == OHT_WIFI_SECURITY_WPA3 ? "WPA3" : "Open");
+        json_writer_field_string(&w, "band", networks[i].band == WIFI_BAND_5G ? "5G" : "2.4G");
+        json_writer_field_bool(&w, "hidden", networks[i].hidden);
+        json_writer_field_bool(&w, "connected", networks[i].connected);
+        json_writer_end_object(&w);
+    }
+    
+    json_writer_end_array(&w);
+    json_writer_field_int(&w, "count", count);
+    json_writer_end_object(&w);
+    
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -591,21 +590,17 @@ int handle_get_network_performance(http_request_t *req __attribute__((unused)),
         return network_api_send_error_response(resp, 500, "Failed to get performance metrics");
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"response_time_ms\": %u, "
-             "\"request_count\": %u, "
-             "\"error_count\": %u, "
-             "\"success_rate\": %.1f"
-             "}, \"timestamp\": \"%s\"}",
-             metrics.response_time_ms,
-             metrics.request_count,
-             metrics.error_count,
-             metrics.success_rate,
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "response_time_ms", metrics.response_time_ms);
+    json_writer_field_uint(&w, "request_count", metrics.request_count);
+    json_writer_field_uint(&w, "error_count", metrics.error_count);
+    json_writer_field_fixed(&w, "success_rate", (double)metrics.success_rate, 1);
+    json_writer_end_object(&w);
+    
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -618,26 +613,21 @@ int handle_get_network_health(http_request_t *req __attribute__((unused)), http_
     wifi_statistics_t stats;
     wifi_manager_get_statistics(&stats);
     
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"network_status\": \"%s\", "
-             "\"signal_quality\": \"%s\", "
-             "\"connection_uptime\": %u, "
-             "\"success_rate\": %.1f, "
-             "\"roaming_events\": %u, "
-             "\"health_score\": %.1f"
-             "}, \"timestamp\": \"%s\"}",
-             status.connected ? "Connected" : "Disconnected",
-             status.signal_strength > -50 ? "Excellent" : 
-             status.signal_strength > -70 ? "Good" : "Fair",
-             stats.total_uptime_seconds,
-             stats.connection_success_rate,
-             stats.roaming_events,
-             status.connected ? 95.0f : 0.0f,
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "network_status", status.connected ? "Connected" : "Disconnected");
+    json_writer_field_string(&w, "signal_quality",
+                             status.signal_strength > -50 ? "Excellent" : 
+                             status.signal_strength > -70 ? "Good" : "Fair");
+    json_writer_field_uint(&w, "connection_uptime", stats.total_uptime_seconds);
+    json_writer_field_fixed(&w, "success_rate", (double)stats.connection_success_rate, 1);
+    json_writer_field_uint(&w, "roaming_events", stats.roaming_events);
+    json_writer_field_fixed(&w, "health_score", status.connected ? 95.0 : 0.0, 1);
+    json_writer_end_object(&w);
+    
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -667,12 +657,10 @@ int handle_post_roaming_enable(http_request_t *req, http_response_t *resp) {
         return network_api_send_error_response(resp, 500, "Failed to configure roaming");
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Roaming configuration updated\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Roaming configuration updated");
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -691,12 +679,10 @@ int handle_post_mobile_enable(http_request_t *req, http_response_t *resp) {
         return network_api_send_error_response(resp, 500, "Failed to configure mobile app");
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Mobile app configuration updated\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Mobile app configuration updated");
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -715,30 +701,23 @@ int handle_get_network_config(http_request_t *req __attribute__((unused)), http_
         config.roaming_enabled = true;
         config.mobile_app_enabled = true;
         config.signal_strength = -65;
-        config.last_update_time = hal_get_timestamp_ms();
-    }
-    
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"wifi_enabled\": %s, "
-             "\"wifi_ssid\": \"%s\", "
-             "\"wifi_security_type\": %d, "
-             "\"signal_strength\": %d, "
-             "\"roaming_enabled\": %s, "
-             "\"mobile_app_enabled\": %s, "
-             "\"last_update_time\": %u"
-             "}, \"timestamp\": \"%s\"}",
-             config.wifi_enabled ? "true" : "false",
-             config.wifi_ssid,
-             config.wifi_security_type,
-             config.signal_strength,
-             config.roaming_enabled ? "true" : "false",
-             config.mobile_app_enabled ? "true" : "false",
-             config.last_update_time,
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+        config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
+    }
+    
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "wifi_enabled", config.wifi_enabled);
+    json_writer_field_string(&w, "wifi_ssid", config.wifi_ssid);
+    json_writer_field_int(&w, "wifi_security_type", config.wifi_security_type);
+    json_writer_field_int(&w, "signal_strength", config.signal_strength);
+    json_writer_field_bool(&w, "roaming_enabled", config.roaming_enabled);
+    json_writer_field_bool(&w, "mobile_app_enabled", config.mobile_app_enabled);
+    json_writer_field_uint(&w, "last_update_time", config.last_update_time);
+    json_writer_end_object(&w);
+    
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -780,12 +759,10 @@ int handle_post_network_config(http_request_t *req, http_response_t *resp) {
         return network_api_send_error_response(resp, 500, "Failed to set network config");
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Network configuration updated\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Network configuration updated");
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -800,29 +777,21 @@ int handle_get_network_statistics(http_request_t *req __attribute__((unused)), h
         return network_api_send_error_response(resp, 500, "Failed to get network statistics");
     }
     
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"connection_attempts\": %u, "
-             "\"successful_connections\": %u, "
-             "\"failed_connections\": %u, "
-             "\"roaming_events\": %u, "
-             "\"disconnection_events\": %u, "
-             "\"connection_success_rate\": %.1f, "
-             "\"total_uptime_seconds\": %u, "
-             "\"average_signal_strength_dbm\": %d"
-             "}, \"timestamp\": \"%s\"}",
-             stats.connection_attempts,
-             stats.successful_connections,
-             stats.failed_connections,
-             stats.roaming_events,
-             stats.disconnection_events,
-             stats.connection_success_rate,
-             stats.total_uptime_seconds,
-             stats.average_signal_strength_dbm,
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "connection_attempts", stats.connection_attempts);
+    json_writer_field_uint(&w, "successful_connections", stats.successful_connections);
+    json_writer_field_uint(&w, "failed_connections", stats.failed_connections);
+    json_writer_field_uint(&w, "roaming_events", stats.roaming_events);
+    json_writer_field_uint(&w, "disconnection_events", stats.disconnection_events);
+    json_writer_field_fixed(&w, "connection_success_rate", (double)stats.connection_success_rate, 1);
+    json_writer_field_uint(&w, "total_uptime_seconds", stats.total_uptime_seconds);
+    json_writer_field_int(&w, "average_signal_strength_dbm", stats.average_signal_strength_dbm);
+    json_writer_end_object(&w);
+    
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -835,12 +804,10 @@ int handle_post_statistics_reset(http_request_t *req __attribute__((unused)), ht
         return network_api_send_error_response(resp, 500, "Failed to reset statistics");
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Statistics reset successfully\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return network_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    network_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Statistics reset successfully");
+    return network_api_send_json_writer(resp, 200, &w);
 }
 
 // Internal Functions Implementation
@@ -856,6 +823,21 @@ static const char* get_current_timestamp(void) {
     return timestamp;
 }
 
+/**
+ * @brief Set status and headers for a JSON body of the given length
+ */
+static void set_json_headers(http_response_t *resp, int status_code, size_t body_length) {
+    resp->status_code = status_code;
+    resp->content_length = (uint32_t)body_length;
+    snprintf(resp->headers, sizeof(resp->headers),
+             "Content-Type: application/json\r\n"
+             "Content-Length: %u\r\n"
+             "Access-Control-Allow-Origin: *\r\n"
+             "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+             "Access-Control-Allow-Headers: Content-Type, Authorization\r\n\r\n",
+             resp->content_length);
+}
+
 /**
  * @brief Log API request
  */
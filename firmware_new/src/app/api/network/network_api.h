@@ -114,6 +114,22 @@ int network_api_send_json_response(http_response_t *resp, int status_code, const
  */
 int network_api_send_error_response(http_response_t *resp, int status_code, const char *error_message);
 
+/**
+ * @brief Start a JSON document in the response body: {"success":true
+ * @param resp HTTP response; its body is the writer's buffer
+ * @param writer JSON writer
+ */
+void network_api_json_begin(http_response_t *resp, json_writer_t *writer);
+
+/**
+ * @brief Add the timestamp, close the document and send it
+ * @param resp HTTP response
+ * @param status_code HTTP status code
+ * @param writer JSON writer started with network_api_json_begin()
+ * @return 0 on success, -1 on failure (a document that did not fit is sent as a 500)
+ */
+int network_api_send_json_writer(http_response_t *resp, int status_code, json_writer_t *writer);
+
 /**
  * @brief Parse JSON request body
  * @param body JSON body string
@@ -41,6 +41,7 @@ static const char* admin_token = "oht50_admin_token_2025";
 
 // Internal Functions
 static const char* get_current_timestamp(void);
+static void set_json_headers(http_response_t *resp, int status_code, size_t body_length);
 static void log_api_request(const char *method, const char *path, int status_code);
 
 /**
@@ -132,22 +133,11 @@ int wifi_ap_api_send_json_response(http_response_t *resp, int status_code, const
         return WIFI_AP_API_ERROR_INVALID_PARAM;
     }
     
-    resp->status_code = status_code;
-    resp->content_length = strlen(json_data);
-    
-    // Set headers
-    snprintf(resp->headers, sizeof(resp->headers),
-             "Content-Type: application/json\r\n"
-             "Content-Length: %u\r\n"
-             "Access-Control-Allow-Origin: *\r\n"
-             "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
-             "Access-Control-Allow-Headers: Content-Type, Authorization\r\n\r\n",
-             resp->content_length);
-    
     // Set body
     strncpy(resp->body, json_data, sizeof(resp->body) - 1);
     resp->body[sizeof(resp->body) - 1] = '\0';
     
+    set_json_headers(resp, status_code, strlen(resp->body));
     return WIFI_AP_API_SUCCESS;
 }
 
@@ -159,12 +149,44 @@ int wifi_ap_api_send_error_response(http_response_t *resp, int status_code, cons
         return WIFI_AP_API_ERROR_INVALID_PARAM;
     }
     
-    char json_error[512];
-    snprintf(json_error, sizeof(json_error),
-             "{\"success\": false, \"error\": \"%s\", \"timestamp\": \"%s\"}",
-             error_message, get_current_timestamp());
+    json_writer_t w;
+    json_writer_init(&w, resp->body, sizeof(resp->body));
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", false);
+    json_writer_field_string(&w, "error", error_message);
+    json_writer_field_string(&w, "timestamp", get_current_timestamp());
+    json_writer_end_object(&w);
+    
+    size_t len = 0;
+    if (!json_writer_data(&w, &len)) {
+        return wifi_ap_api_send_json_response(resp, status_code, "{\"success\":false,\"error\":\"error\"}");
+    }
+    set_json_headers(resp, status_code, len);
+    return WIFI_AP_API_SUCCESS;
+}
+
+/**
+ * @brief Start a JSON document in the response body
+ */
+void wifi_ap_api_json_begin(http_response_t *resp, json_writer_t *writer) {
+    json_writer_init(writer, resp->body, sizeof(resp->body));
+    json_writer_begin_object(writer);
+    json_writer_field_bool(writer, "success", true);
+}
+
+/**
+ * @brief Close a JSON document with its timestamp and send it
+ */
+int wifi_ap_api_send_json_writer(http_response_t *resp, int status_code, json_writer_t *writer) {
+    json_writer_field_string(writer, "timestamp", get_current_timestamp());
+    json_writer_end_object(writer);
     
-    return wifi_ap_api_send_json_response(resp, status_code, json_error);
+    size_t len = 0;
+    if (!json_writer_data(writer, &len)) {
+        return wifi_ap_api_send_error_response(resp, 500, "Response too large");
+    }
+    set_json_headers(resp, status_code, len);
+    return WIFI_AP_API_SUCCESS;
 }
 
 /**
@@ -228,15 +250,14 @@ int wifi_ap_api_wrapper_handler(const api_mgr_http_request_t *req, api_mgr_http_
     // Call WiFi AP API handler
     int result = wifi_ap_api_handle_request(&wifi_ap_req, &wifi_ap_resp);
     
-    // Convert response back to API Manager format
-    res->status_code = wifi_ap_resp.status_code;
-    if (wifi_ap_resp.body && strlen(wifi_ap_resp.body) > 0) {
-        res->body = strdup(wifi_ap_resp.body);
-        res->body_length = strlen(wifi_ap_resp.body);
+    // Convert response back to API Manager format (body copied into the request arena)
+    if (wifi_ap_resp.body[0] != '\0') {
+        (void)api_manager_create_success_response(res, wifi_ap_resp.body);
     } else {
         res->body = NULL;
         res->body_length = 0;
     }
+    res->status_code = wifi_ap_resp.status_code;
     
     return result;
 }
@@ -417,12 +438,10 @@ int handle_post_ap_start(http_request_t *req, http_response_t *resp) {
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"WiFi AP started successfully\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "WiFi AP started successfully");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -436,12 +455,10 @@ int handle_post_ap_stop(http_request_t *req __attribute__((unused)), http_respon
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"WiFi AP stopped successfully\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "WiFi AP stopped successfully");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -456,37 +473,25 @@ int handle_get_ap_status(http_request_t *req __attribute__((unused)), http_respo
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"status\": %d, "
-             "\"ap_enabled\": %s, "
-             "\"ap_ssid\": \"%s\", "
-             "\"ap_ip\": \"%s\", "
-             "\"ap_channel\": %d, "
-             "\"connected_clients\": %d, "
-             "\"max_clients\": %d, "
-             "\"uptime_seconds\": %u, "
-             "\"total_bytes_sent\": %u, "
-             "\"total_bytes_received\": %u, "
-             "\"cpu_usage_percent\": %.1f, "
-             "\"memory_usage_percent\": %.1f"
-             "}, \"timestamp\": \"%s\"}",
-             status.status,
-             status.ap_enabled ? "true" : "false",
-             status.ap_ssid,
-             status.ap_ip,
-             status.ap_channel,
-             status.connected_clients,
-             status.max_clients,
-             status.uptime_seconds,
-             status.total_bytes_sent,
-             status.total_bytes_received,
-             status.cpu_usage_percent,
-             status.memory_usage_percent,
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_int(&w, "status", (int64_t)status.status);
+    json_writer_field_bool(&w, "ap_enabled", status.ap_enabled);
+    json_writer_field_string(&w, "ap_ssid", status.ap_ssid);
+    json_writer_field_string(&w, "ap_ip", status.ap_ip);
+    json_writer_field_int(&w, "ap_channel", status.ap_channel);
+    json_writer_field_int(&w, "connected_clients", status.connected_clients);
+    json_writer_field_int(&w, "max_clients", status.max_clients);
+    json_writer_field_uint(&w, "uptime_seconds", status.uptime_seconds);
+    json_writer_field_uint(&w, "total_bytes_sent", status.total_bytes_sent);
+    json_writer_field_uint(&w, "total_bytes_received", status.total_bytes_received);
+    json_writer_field_fixed(&w, "cpu_usage_percent", (double)status.cpu_usage_percent, 1);
+    json_writer_field_fixed(&w, "memory_usage_percent", (double)status.memory_usage_percent, 1);
+    json_writer_end_object(&w);
+    
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -501,31 +506,22 @@ int handle_get_ap_config(http_request_t *req __attribute__((unused)), http_respo
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"ap_enabled\": %s, "
-             "\"ap_ssid\": \"%s\", "
-             "\"ap_security_type\": %d, "
-             "\"ap_ip\": \"%s\", "
-             "\"ap_netmask\": \"%s\", "
-             "\"ap_channel\": %d, "
-             "\"max_clients\": %u, "
-             "\"auto_fallback\": %s, "
-             "\"fallback_timeout_ms\": %u"
-             "}, \"timestamp\": \"%s\"}",
-             config.ap_enabled ? "true" : "false",
-             config.ap_ssid,
-             config.ap_security_type,
-             config.ap_ip,
-             config.ap_netmask,
-             config.ap_channel,
-             config.max_clients,
-             config.auto_fallback ? "true" : "false",
-             config.fallback_timeout_ms,
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "ap_enabled", config.ap_enabled);
+    json_writer_field_string(&w, "ap_ssid", config.ap_ssid);
+    json_writer_field_int(&w, "ap_security_type", (int64_t)config.ap_security_type);
+    json_writer_field_string(&w, "ap_ip", config.ap_ip);
+    json_writer_field_string(&w, "ap_netmask", config.ap_netmask);
+    json_writer_field_int(&w, "ap_channel", config.ap_channel);
+    json_writer_field_uint(&w, "max_clients", config.max_clients);
+    json_writer_field_bool(&w, "auto_fallback", config.auto_fallback);
+    json_writer_field_uint(&w, "fallback_timeout_ms", config.fallback_timeout_ms);
+    json_writer_end_object(&w);
+    
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -576,12 +572,10 @@ int handle_post_ap_config(http_request_t *req, http_response_t *resp) {
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"AP configuration updated\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "AP configuration updated");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -596,40 +590,31 @@ int handle_get_ap_clients(http_request_t *req __attribute__((unused)), http_resp
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[4096] = "{\"success\": true, \"data\": {\"clients\": [";
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_key(&w, "clients");
+    json_writer_begin_array(&w);
     
     for (int i = 0; i < count; i++) {
-        if (i > 0) {
-            strcat(json_response, ", ");
-        }
-        
-        char client_json[512];
-        snprintf(client_json, sizeof(client_json),
-                 "{\"mac_address\": \"%s\", \"ip_address\": \"%s\", \"hostname\": \"%s\", "
-                 "\"signal_strength_dbm\": %d, \"connected_time_seconds\": %u, "
-                 "\"bytes_sent\": %u, \"bytes_received\": %u, \"authenticated\": %s}",
-                 clients[i].mac_address,
-                 clients[i].ip_address,
-                 clients[i].hostname,
-                 clients[i].signal_strength_dbm,
-                 clients[i].connected_time_seconds,
-                 clients[i].bytes_sent,
-                 clients[i].bytes_received,
-                 clients[i].authenticated ? "true" : "false");
-        
-        strcat(json_response, client_json);
-    }
-    
-    strcat(json_response, "], \"count\": ");
-    char count_str[16];
-    snprintf(count_str, sizeof(count_str), "%d", count);
-    strcat(json_response, count_str);
-    
-    snprintf(json_response + strlen(json_response), 
-             sizeof(json_response) - strlen(json_response),
-             "}, \"timestamp\": \"%s\"}", get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+        json_writer_begin_object(&w);
+        json_writer_field_string(&w, "mac_address", clients[i].mac_address);
+        json_writer_field_string(&w, "ip_address", clients[i].ip_address);
+        json_writer_field_string(&w, "hostname", clients[i].hostname);
+        json_writer_field_int(&w, "signal_strength_dbm", clients[i].signal_strength_dbm);
+        json_writer_field_uint(&w, "connected_time_seconds", clients[i].connected_time_seconds);
+        json_writer_field_uint(&w, "bytes_sent", clients[i].bytes_sent);
+        json_writer_field_uint(&w, "bytes_received", clients[i].bytes_received);
+        json_writer_field_bool(&w, "authenticated", clients[i].authenticated);
+        json_writer_end_object(&w);
+    }
+    
+    json_writer_end_array(&w);
+    json_writer_field_int(&w, "count", count);
+    json_writer_end_object(&w);
+    
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -649,12 +634,10 @@ int handle_post_ap_kick_client(http_request_t *req, http_response_t *resp) {
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Client kicked successfully\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Client kicked successfully");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -669,33 +652,23 @@ int handle_get_ap_statistics(http_request_t *req __attribute__((unused)), http_r
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[1024];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"ap_start_count\": %u, "
-             "\"ap_stop_count\": %u, "
-             "\"client_connections\": %u, "
-             "\"client_disconnections\": %u, "
-             "\"fallback_triggers\": %u, "
-             "\"total_uptime_seconds\": %u, "
-             "\"total_bytes_sent\": %u, "
-             "\"total_bytes_received\": %u, "
-             "\"average_cpu_usage\": %.1f, "
-             "\"average_memory_usage\": %.1f"
-             "}, \"timestamp\": \"%s\"}",
-             stats.ap_start_count,
-             stats.ap_stop_count,
-             stats.client_connections,
-             stats.client_disconnections,
-             stats.fallback_triggers,
-             stats.total_uptime_seconds,
-             stats.total_bytes_sent,
-             stats.total_bytes_received,
-             stats.average_cpu_usage,
-             stats.average_memory_usage,
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "ap_start_count", stats.ap_start_count);
+    json_writer_field_uint(&w, "ap_stop_count", stats.ap_stop_count);
+    json_writer_field_uint(&w, "client_connections", stats.client_connections);
+    json_writer_field_uint(&w, "client_disconnections", stats.client_disconnections);
+    json_writer_field_uint(&w, "fallback_triggers", stats.fallback_triggers);
+    json_writer_field_uint(&w, "total_uptime_seconds", stats.total_uptime_seconds);
+    json_writer_field_uint(&w, "total_bytes_sent", stats.total_bytes_sent);
+    json_writer_field_uint(&w, "total_bytes_received", stats.total_bytes_received);
+    json_writer_field_fixed(&w, "average_cpu_usage", (double)stats.average_cpu_usage, 1);
+    json_writer_field_fixed(&w, "average_memory_usage", (double)stats.average_memory_usage, 1);
+    json_writer_end_object(&w);
+    
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -709,12 +682,10 @@ int handle_post_ap_statistics_reset(http_request_t *req __attribute__((unused)),
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"AP statistics reset successfully\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "AP statistics reset successfully");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -737,12 +708,10 @@ int handle_post_fallback_enable(http_request_t *req, http_response_t *resp) {
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Auto-fallback configuration updated\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Auto-fallback configuration updated");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -759,17 +728,15 @@ int handle_get_fallback_status(http_request_t *req __attribute__((unused)), http
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"data\": {"
-             "\"enabled\": %s, "
-             "\"timeout_ms\": %u"
-             "}, \"timestamp\": \"%s\"}",
-             enabled ? "true" : "false",
-             timeout_ms,
-             get_current_timestamp());
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "enabled", enabled);
+    json_writer_field_uint(&w, "timeout_ms", timeout_ms);
+    json_writer_end_object(&w);
     
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -783,12 +750,10 @@ int handle_post_fallback_trigger(http_request_t *req __attribute__((unused)), ht
         return wifi_ap_api_send_error_response(resp, 500, error_msg);
     }
     
-    char json_response[512];
-    snprintf(json_response, sizeof(json_response),
-             "{\"success\": true, \"message\": \"Fallback triggered successfully\", \"timestamp\": \"%s\"}",
-             get_current_timestamp());
-    
-    return wifi_ap_api_send_json_response(resp, 200, json_response);
+    json_writer_t w;
+    wifi_ap_api_json_begin(resp, &w);
+    json_writer_field_string(&w, "message", "Fallback triggered successfully");
+    return wifi_ap_api_send_json_writer(resp, 200, &w);
 }
 
 /**
@@ -828,6 +793,21 @@ static const char* get_current_timestamp(void) {
     return timestamp;
 }
 
+/**
+ * @brief Set status and headers for a JSON body of the given length
+ */
+static void set_json_headers(http_response_t *resp, int status_code, size_t body_length) {
+    resp->status_code = status_code;
+    resp->content_length = (uint32_t)body_length;
+    snprintf(resp->headers, sizeof(resp->headers),
+             "Content-Type: application/json\r\n"
+             "Content-Length: %u\r\n"
+             "Access-Control-Allow-Origin: *\r\n"
+             "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+             "Access-Control-Allow-Headers: Content-Type, Authorization\r\n\r\n",
+             resp->content_length);
+}
+
 /**
  * @brief Log API request
  */
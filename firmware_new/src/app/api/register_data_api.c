@@ -10,6 +10,7 @@
 #include "../../hal/register/register_info.h"
 #include "../storage/register_value_cache.h"
 #include "communication_manager.h"
+#include "modbus_bus_master.h"
 #include "../utils/register_json_serializer.h"
 #include "../domain/module_management/module_polling_manager.h"
 #include "../domain/module_management/module_manager.h"
@@ -19,9 +20,11 @@
 #include <time.h>
 
 // Helper functions
-static int parse_module_addr_from_path(const char *path, uint8_t *addr_out);
-static int parse_register_addr_from_path(const char *path, uint16_t *reg_addr_out);
-static char* format_timestamp(uint64_t timestamp_ms);
+static int module_addr_param(const api_mgr_http_request_t *request, uint8_t *addr_out);
+static int register_addr_param(const api_mgr_http_request_t *request, uint16_t *reg_addr_out);
+static char* format_timestamp(uint64_t monotonic_ms);
+static int register_write_result(api_mgr_http_response_t *response, api_mgr_http_response_code_t code,
+                                 const char *message, bool timeout);
 
 // GET /api/v1/modules - List online modules
 int api_get_modules_list(const api_mgr_http_request_t *request, api_mgr_http_response_t *response) {
@@ -30,13 +33,12 @@ int api_get_modules_list(const api_mgr_http_request_t *request, api_mgr_http_res
     printf("[DATA-API] GET /api/v1/modules\n");
     
     // Build JSON response with online modules
-    char *json = malloc(4096);
-    if (!json) {
-        return api_manager_create_error_response(response, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR,
-                                                 "Memory allocation failed");
-    }
-    
-    int pos = snprintf(json, 4096, "{\"success\":true,\"modules\":[");
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 1024);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "modules");
+    json_writer_begin_array(&w);
     
     int module_count = 0;
     
@@ -58,26 +60,22 @@ int api_get_modules_list(const api_mgr_http_request_t *request, api_mgr_http_res
             uint64_t last_update = 0;
             register_cache_get_last_update((uint8_t)addr, &last_update);
             
-            if (module_count > 0) {
-                pos += snprintf(json + pos, 4096 - pos, ",");
-            }
-            
-            pos += snprintf(json + pos, 4096 - pos,
-                           "{\"address\":%d,\"type\":\"%s\",\"online\":true,\"last_seen\":\"%s\"}",
-                           addr, type_name, format_timestamp(last_update));
+            json_writer_begin_object(&w);
+            json_writer_field_int(&w, "address", addr);
+            json_writer_field_string(&w, "type", type_name);
+            json_writer_field_bool(&w, "online", true);
+            json_writer_field_string(&w, "last_seen", format_timestamp(last_update));
+            json_writer_end_object(&w);
             
             module_count++;
         }
     }
     
-    pos += snprintf(json + pos, 4096 - pos, "]}");
-    
-    response->status_code = 200;
-    response->body = json;
-    response->body_length = strlen(json);
+    json_writer_end_array(&w);
+    json_writer_end_object(&w);
     
     printf("[DATA-API] Found %d online modules\n", module_count);
-    return 0;
+    return api_manager_create_json_response(response, API_MGR_RESPONSE_OK, &w);
 }
 
 // GET /api/v1/modules/{addr}/data - Get module data with values
@@ -86,26 +84,29 @@ int api_get_module_data(const api_mgr_http_request_t *request, api_mgr_http_resp
     
     // Parse module address from path
     uint8_t module_addr;
-    if (parse_module_addr_from_path(request->path, &module_addr) != 0) {
+    if (module_addr_param(request, &module_addr) != 0) {
         return api_manager_create_error_response(response, API_MGR_RESPONSE_BAD_REQUEST,
                                                  "Invalid module address in path");
     }
     
     printf("[DATA-API] Module address: 0x%02X\n", module_addr);
     
+    json_writer_t w;
+    
     // Check if module is online
     module_polling_info_t info;
     hal_status_t poll_status = module_polling_manager_get_module_info(module_addr, &info);
     
     if (poll_status != HAL_STATUS_OK || !info.is_online) {
-        char error_json[256];
-        snprintf(error_json, sizeof(error_json),
-                "{\"success\":false,\"error\":\"Module 0x%02X is offline\",\"online\":false}",
-                module_addr);
-        response->status_code = 404;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+        char message[64];
+        snprintf(message, sizeof(message), "Module 0x%02X is offline", module_addr);
+        (void)api_manager_json_begin(&w, 128);
+        json_writer_begin_object(&w);
+        json_writer_field_bool(&w, "success", false);
+        json_writer_field_string(&w, "error", message);
+        json_writer_field_bool(&w, "online", false);
+        json_writer_end_object(&w);
+        return api_manager_create_json_response(response, API_MGR_RESPONSE_NOT_FOUND, &w);
     }
     
     // Get register metadata
@@ -115,63 +116,51 @@ int api_get_module_data(const api_mgr_http_request_t *request, api_mgr_http_resp
                                                  "Module not found or no registers defined");
     }
     
-    // Get cached register values
-    register_value_entry_t cached_values[MAX_CACHED_REGISTERS_PER_MODULE];
-    uint16_t cached_count = 0;
-    register_cache_get_all(module_addr, cached_values, MAX_CACHED_REGISTERS_PER_MODULE, &cached_count);
-    
-    // Build JSON response combining metadata + values
-    char *json = malloc(65536);  // Large buffer for many registers
-    if (!json) {
-        return api_manager_create_error_response(response, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR,
-                                                 "Memory allocation failed");
-    }
-    
-    int pos = snprintf(json, 65536,
-                      "{\"success\":true,\"data\":{\"module_addr\":%d,\"module_name\":\"%s\","
-                      "\"online\":true,\"register_count\":%d,\"registers\":[",
-                      module_addr, reg_list->module_name, reg_list->count);
+    // Take one consistent snapshot of the cached values (sorted by address)
+    register_cache_snapshot_t snapshot;
+    snapshot.count = 0;
+    register_cache_snapshot(module_addr, &snapshot);
+    uint16_t cached_count = snapshot.count;
+    
+    // Build JSON response combining metadata + values; sized for a typical
+    // register, the writer grows past it
+    (void)api_manager_json_begin_data(&w, 256 + (size_t)reg_list->count * 192);
+    json_writer_field_int(&w, "module_addr", module_addr);
+    json_writer_field_string(&w, "module_name", reg_list->module_name);
+    json_writer_field_bool(&w, "online", true);
+    json_writer_field_int(&w, "register_count", reg_list->count);
+    json_writer_key(&w, "registers");
+    json_writer_begin_array(&w);
     
     // Iterate through metadata and merge with cached values
     for (uint16_t i = 0; i < reg_list->count; i++) {
         const register_info_t *reg = &reg_list->registers[i];
         
-        if (i > 0) {
-            pos += snprintf(json + pos, 65536 - pos, ",");
-        }
-        
-        pos += snprintf(json + pos, 65536 - pos,
-                       "{\"address\":\"0x%04X\",\"name\":\"%s\",\"mode\":\"%s\","
-                       "\"data_type\":\"%s\",\"description\":\"%s\"",
-                       reg->address, reg->description,
-                       register_mode_to_string(reg->mode),
-                       register_data_type_to_string(reg->data_type),
-                       reg->description);
+        json_writer_begin_object(&w);
+        json_writer_field_hex(&w, "address", reg->address, 4);
+        json_writer_field_string(&w, "name", reg->description);
+        json_writer_field_string(&w, "mode", register_mode_to_string(reg->mode));
+        json_writer_field_string(&w, "data_type", register_data_type_to_string(reg->data_type));
+        json_writer_field_string(&w, "description", reg->description);
         
         // Try to find cached value
         uint16_t value = 0;
         uint64_t timestamp = 0;
-        hal_status_t cache_status = register_cache_get(module_addr, reg->address, &value, &timestamp);
-        
-        if (cache_status == HAL_STATUS_OK) {
-            pos += snprintf(json + pos, 65536 - pos,
-                           ",\"value\":%d,\"timestamp\":\"%s\"",
-                           value, format_timestamp(timestamp));
+        if (register_cache_snapshot_find(&snapshot, reg->address, &value, &timestamp)) {
+            json_writer_field_uint(&w, "value", value);
+            json_writer_field_string(&w, "timestamp", format_timestamp(timestamp));
         } else {
-            pos += snprintf(json + pos, 65536 - pos, ",\"value\":null,\"timestamp\":null");
+            json_writer_field_null(&w, "value");
+            json_writer_field_null(&w, "timestamp");
         }
         
-        pos += snprintf(json + pos, 65536 - pos, "}");
+        json_writer_end_object(&w);
     }
     
-    pos += snprintf(json + pos, 65536 - pos, "]}}");
-    
-    response->status_code = 200;
-    response->body = json;
-    response->body_length = strlen(json);
+    json_writer_end_array(&w);
     
     printf("[DATA-API] Success: %d registers with %d cached values\n", reg_list->count, cached_count);
-    return 0;
+    return api_manager_json_end_data(response, &w);
 }
 
 // POST /api/v1/modules/{addr}/registers/{reg_addr} - Write register
@@ -192,14 +181,14 @@ int api_write_register(const api_mgr_http_request_t *request, api_mgr_http_respo
     
     // Parse module address
     uint8_t module_addr;
-    if (parse_module_addr_from_path(request->path, &module_addr) != 0) {
+    if (module_addr_param(request, &module_addr) != 0) {
         return api_manager_create_error_response(response, API_MGR_RESPONSE_BAD_REQUEST,
                                                  "Invalid module address");
     }
     
     // Parse register address
     uint16_t reg_addr;
-    if (parse_register_addr_from_path(request->path, &reg_addr) != 0) {
+    if (register_addr_param(request, &reg_addr) != 0) {
         return api_manager_create_error_response(response, API_MGR_RESPONSE_BAD_REQUEST,
                                                  "Invalid register address");
     }
@@ -236,14 +225,9 @@ int api_write_register(const api_mgr_http_request_t *request, api_mgr_http_respo
     
     // 3) Check if register is writable per metadata
     if (reg_info->mode == REG_MODE_READ_ONLY) {
-        char error_json[256];
-        snprintf(error_json, sizeof(error_json),
-                "{\"success\":false,\"message\":\"Register 0x%04X is read-only\",\"timeout\":false}",
-                reg_addr);
-        response->status_code = 400;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+        char message[64];
+        snprintf(message, sizeof(message), "Register 0x%04X is read-only", reg_addr);
+        return register_write_result(response, API_MGR_RESPONSE_BAD_REQUEST, message, false);
     }
 
     // 4) Validate value against min/max constraints
@@ -252,34 +236,32 @@ int api_write_register(const api_mgr_http_request_t *request, api_mgr_http_respo
                                                  "Value out of range");
     }
     
-    // 5) Write to module via RS485
-    hal_status_t write_status = comm_manager_modbus_write_single_register(module_addr, reg_addr, value);
+    // 5) Write to module via RS485 (operator command - served ahead of polling/discovery)
+    hal_status_t write_status = modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, module_addr, reg_addr, value);
+    int rc;
     
-    char result_json[512];
     if (write_status == HAL_STATUS_OK) {
         // Update cache on successful write
         register_cache_store(module_addr, reg_addr, value);
         
-        snprintf(result_json, sizeof(result_json),
-                "{\"success\":true,\"message\":\"Write successful\",\"timeout\":false,"
-                "\"register\":\"0x%04X\",\"value\":%d}",
-                reg_addr, value);
-        response->status_code = 200;
+        json_writer_t w;
+        (void)api_manager_json_begin(&w, 128);
+        json_writer_begin_object(&w);
+        json_writer_field_bool(&w, "success", true);
+        json_writer_field_string(&w, "message", "Write successful");
+        json_writer_field_bool(&w, "timeout", false);
+        json_writer_field_hex(&w, "register", reg_addr, 4);
+        json_writer_field_uint(&w, "value", value);
+        json_writer_end_object(&w);
+        rc = api_manager_create_json_response(response, API_MGR_RESPONSE_OK, &w);
     } else if (write_status == HAL_STATUS_TIMEOUT) {
-        snprintf(result_json, sizeof(result_json),
-                "{\"success\":false,\"message\":\"Timeout waiting for response\",\"timeout\":true}");
-        response->status_code = 504;
+        rc = register_write_result(response, API_MGR_RESPONSE_GATEWAY_TIMEOUT, "Timeout waiting for response", true);
     } else {
-        snprintf(result_json, sizeof(result_json),
-                "{\"success\":false,\"message\":\"Write failed\",\"timeout\":false}");
-        response->status_code = 500;
+        rc = register_write_result(response, API_MGR_RESPONSE_INTERNAL_SERVER_ERROR, "Write failed", false);
     }
     
-    response->body = strdup(result_json);
-    response->body_length = strlen(result_json);
-    
     printf("[DATA-API] Write result: success=%d, status=%d\n", write_status == HAL_STATUS_OK, write_status);
-    return 0;
+    return rc;
 }
 
 // Initialize API
@@ -294,55 +276,60 @@ int register_data_api_init(void) {
     }
     
     printf("[DATA-API] ✅ Registered: GET /api/v1/modules\n");
+    
+    // Register route: GET /api/v1/modules/{addr}/data
+    result = api_manager_register_endpoint("/api/v1/modules/{id:u8}/data", API_MGR_HTTP_GET, api_get_module_data);
+    if (result != 0) {
+        printf("[DATA-API] Error: Failed to register module data endpoint\n");
+        return -1;
+    }
+    
+    // Register route: POST /api/v1/modules/{addr}/registers/{reg_addr} (handler checks auth itself)
+    result = api_manager_register_endpoint("/api/v1/modules/{id:u8}/registers/{reg:hex16}", API_MGR_HTTP_POST,
+                                           api_write_register);
+    if (result != 0) {
+        printf("[DATA-API] Error: Failed to register register write endpoint\n");
+        return -1;
+    }
+    printf("[DATA-API] ✅ Registered: GET /api/v1/modules/{addr}/data, POST /api/v1/modules/{addr}/registers/{reg}\n");
     printf("[DATA-API] Register data API endpoints initialized successfully\n");
     return 0;
 }
 
 // Helper functions
-static int parse_module_addr_from_path(const char *path, uint8_t *addr_out) {
-    if (!path || !addr_out) return -1;
-    
-    const char *prefix = "/api/v1/modules/";
-    const char *start = strstr(path, prefix);
-    if (!start) return -1;
-    
-    start += strlen(prefix);
-    
-    char *endptr;
-    long addr = strtol(start, &endptr, 0);
-    
-    if (endptr == start || addr < 0 || addr > 255) {
-        return -1;
-    }
-    
-    *addr_out = (uint8_t)addr;
+static int module_addr_param(const api_mgr_http_request_t *request, uint8_t *addr_out) {
+    uint32_t value;
+    if (api_manager_get_path_param(request, "id", &value) != 0) return -1;
+    *addr_out = (uint8_t)value;
     return 0;
 }
 
-static int parse_register_addr_from_path(const char *path, uint16_t *reg_addr_out) {
-    if (!path || !reg_addr_out) return -1;
-    
-    const char *last_slash = strrchr(path, '/');
-    if (!last_slash) return -1;
-    
-    const char *reg_str = last_slash + 1;
-    
-    char *endptr;
-    long reg_addr = strtol(reg_str, &endptr, 0);
-    
-    if (endptr == reg_str || reg_addr < 0 || reg_addr > 0xFFFF) {
-        return -1;
-    }
-    
-    *reg_addr_out = (uint16_t)reg_addr;
+static int register_addr_param(const api_mgr_http_request_t *request, uint16_t *reg_addr_out) {
+    uint32_t value;
+    if (api_manager_get_path_param(request, "reg", &value) != 0) return -1;
+    *reg_addr_out = (uint16_t)value;
     return 0;
 }
 
-static char* format_timestamp(uint64_t timestamp_ms) {
+// Register cache times are monotonic; shown as wall-clock time
+static char* format_timestamp(uint64_t monotonic_ms) {
     static char buffer[32];
-    time_t seconds = (time_t)(timestamp_ms / 1000);
+    uint64_t wall_ms = monotonic_ms != 0 ? hal_time_to_wall_ms(monotonic_ms) : 0;
+    time_t seconds = (time_t)(wall_ms / 1000);
     struct tm *tm_info = gmtime(&seconds);
     strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", tm_info);
     return buffer;
 }
 
+// {"success":false,"message":...,"timeout":...} for a write that did not happen
+static int register_write_result(api_mgr_http_response_t *response, api_mgr_http_response_code_t code,
+                                 const char *message, bool timeout) {
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 128);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", false);
+    json_writer_field_string(&w, "message", message);
+    json_writer_field_bool(&w, "timeout", timeout);
+    json_writer_end_object(&w);
+    return api_manager_create_json_response(response, code, &w);
+}
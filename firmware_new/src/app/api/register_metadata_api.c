@@ -19,62 +19,49 @@
 // ============================================================================
 
 /**
- * @brief Parse module address from URL path
- * @param path URL path (e.g. "/api/v1/modules/2/registers")
- * @param addr_out Pointer to store parsed address
+ * @brief Module address captured by the {id:u8} route segment
+ * @param request Routed request
+ * @param addr_out Pointer to store the address
  * @return 0 on success, -1 on error
  */
-static int parse_module_addr_from_path(const char *path, uint8_t *addr_out) {
-    if (!path || !addr_out) return -1;
-    
-    // Find "/modules/" in path
-    const char *prefix = "/api/v1/modules/";
-    const char *start = strstr(path, prefix);
-    if (!start) return -1;
-    
-    // Move to address part
-    start += strlen(prefix);
-    
-    // Parse address (hex or decimal)
-    char *endptr;
-    long addr = strtol(start, &endptr, 0);  // 0 = auto-detect base (0x for hex)
-    
-    if (endptr == start || addr < 0 || addr > 255) {
-        return -1;
-    }
-    
-    *addr_out = (uint8_t)addr;
+static int module_addr_param(const api_mgr_http_request_t *request, uint8_t *addr_out) {
+    uint32_t value;
+    if (api_manager_get_path_param(request, "id", &value) != 0) return -1;
+    *addr_out = (uint8_t)value;
     return 0;
 }
 
 /**
- * @brief Parse register address from URL path
- * @param path URL path (e.g. "/api/v1/modules/2/registers/0x0000")
- * @param reg_addr_out Pointer to store parsed register address
+ * @brief Register address captured by the {reg:hex16} route segment
+ * @param request Routed request
+ * @param reg_addr_out Pointer to store the register address
  * @return 0 on success, -1 on error
  */
-static int parse_register_addr_from_path(const char *path, uint16_t *reg_addr_out) {
-    if (!path || !reg_addr_out) return -1;
-    
-    // Find last "/" which precedes register address
-    const char *last_slash = strrchr(path, '/');
-    if (!last_slash) return -1;
-    
-    // Move past "/"
-    const char *reg_str = last_slash + 1;
-    
-    // Parse register address (hex or decimal)
-    char *endptr;
-    long reg_addr = strtol(reg_str, &endptr, 0);  // 0 = auto-detect base
-    
-    if (endptr == reg_str || reg_addr < 0 || reg_addr > 0xFFFF) {
-        return -1;
-    }
-    
-    *reg_addr_out = (uint16_t)reg_addr;
+static int register_addr_param(const api_mgr_http_request_t *request, uint16_t *reg_addr_out) {
+    uint32_t value;
+    if (api_manager_get_path_param(request, "reg", &value) != 0) return -1;
+    *reg_addr_out = (uint16_t)value;
     return 0;
 }
 
+/**
+ * @brief Send {"success":false,"error":...}
+ * @param response Response to fill
+ * @param code HTTP status
+ * @param message Error message
+ * @return 0 on success, -1 on error
+ */
+static int register_error_response(api_mgr_http_response_t *response, api_mgr_http_response_code_t code,
+                                   const char *message) {
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, 128);
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", false);
+    json_writer_field_string(&w, "error", message);
+    json_writer_end_object(&w);
+    return api_manager_create_json_response(response, code, &w);
+}
+
 // ============================================================================
 // API ENDPOINT HANDLERS
 // ============================================================================
@@ -87,12 +74,8 @@ int api_get_module_registers_wrapper(const api_mgr_http_request_t *request, api_
     
     // Parse module address from path
     uint8_t module_addr;
-    if (parse_module_addr_from_path(request->path, &module_addr) != 0) {
-        const char *error_json = "{\"success\":false,\"error\":\"Invalid module address in path\"}";
-        response->status_code = 400;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+    if (module_addr_param(request, &module_addr) != 0) {
+        return register_error_response(response, API_MGR_RESPONSE_BAD_REQUEST, "Invalid module address in path");
     }
     
     printf("[REG_API] Module address: 0x%02X\n", module_addr);
@@ -100,33 +83,18 @@ int api_get_module_registers_wrapper(const api_mgr_http_request_t *request, api_
     // Get register list for module
     const register_list_response_t *reg_list = get_module_register_list_api(module_addr);
     if (!reg_list || !reg_list->valid) {
-        char error_json[256];
-        snprintf(error_json, sizeof(error_json),
-                "{\"success\":false,\"error\":\"Module 0x%02X not found or no registers defined\"}",
-                module_addr);
-        response->status_code = 404;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+        char message[96];
+        snprintf(message, sizeof(message), "Module 0x%02X not found or no registers defined", module_addr);
+        return register_error_response(response, API_MGR_RESPONSE_NOT_FOUND, message);
     }
     
-    // Serialize to JSON
-    char *json_body = serialize_register_list_to_json(reg_list);
-    if (!json_body) {
-        const char *error_json = "{\"success\":false,\"error\":\"Failed to serialize register list\"}";
-        response->status_code = 500;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
-    }
-    
-    // Success response
-    response->status_code = 200;
-    response->body = json_body;
-    response->body_length = strlen(json_body);
+    // Serialize straight into the response buffer
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, estimate_json_buffer_size(reg_list->count));
+    register_list_json_write(&w, reg_list);
     
     printf("[REG_API] Success: %u registers for module 0x%02X\n", reg_list->count, module_addr);
-    return 0;
+    return api_manager_create_json_response(response, API_MGR_RESPONSE_OK, &w);
 }
 
 /**
@@ -137,22 +105,14 @@ int api_get_single_register_wrapper(const api_mgr_http_request_t *request, api_m
     
     // Parse module address
     uint8_t module_addr;
-    if (parse_module_addr_from_path(request->path, &module_addr) != 0) {
-        const char *error_json = "{\"success\":false,\"error\":\"Invalid module address in path\"}";
-        response->status_code = 400;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+    if (module_addr_param(request, &module_addr) != 0) {
+        return register_error_response(response, API_MGR_RESPONSE_BAD_REQUEST, "Invalid module address in path");
     }
     
     // Parse register address
     uint16_t reg_addr;
-    if (parse_register_addr_from_path(request->path, &reg_addr) != 0) {
-        const char *error_json = "{\"success\":false,\"error\":\"Invalid register address in path\"}";
-        response->status_code = 400;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+    if (register_addr_param(request, &reg_addr) != 0) {
+        return register_error_response(response, API_MGR_RESPONSE_BAD_REQUEST, "Invalid register address in path");
     }
     
     printf("[REG_API] Module: 0x%02X, Register: 0x%04X\n", module_addr, reg_addr);
@@ -160,33 +120,18 @@ int api_get_single_register_wrapper(const api_mgr_http_request_t *request, api_m
     // Get register info
     const register_info_t *reg_info = get_register_info(module_addr, reg_addr);
     if (!reg_info) {
-        char error_json[256];
-        snprintf(error_json, sizeof(error_json),
-                "{\"success\":false,\"error\":\"Register 0x%04X not found in module 0x%02X\"}",
-                reg_addr, module_addr);
-        response->status_code = 404;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
+        char message[96];
+        snprintf(message, sizeof(message), "Register 0x%04X not found in module 0x%02X", reg_addr, module_addr);
+        return register_error_response(response, API_MGR_RESPONSE_NOT_FOUND, message);
     }
     
-    // Serialize to JSON
-    char *json_body = serialize_register_to_json(reg_info);
-    if (!json_body) {
-        const char *error_json = "{\"success\":false,\"error\":\"Failed to serialize register\"}";
-        response->status_code = 500;
-        response->body = strdup(error_json);
-        response->body_length = strlen(error_json);
-        return 0;
-    }
-    
-    // Success response
-    response->status_code = 200;
-    response->body = json_body;
-    response->body_length = strlen(json_body);
+    // Serialize straight into the response buffer
+    json_writer_t w;
+    (void)api_manager_json_begin(&w, estimate_json_buffer_size(1));
+    register_json_write(&w, reg_info);
     
     printf("[REG_API] Success: Register 0x%04X from module 0x%02X\n", reg_addr, module_addr);
-    return 0;
+    return api_manager_create_json_response(response, API_MGR_RESPONSE_OK, &w);
 }
 
 // ============================================================================
@@ -198,7 +143,7 @@ int register_metadata_api_init(void) {
     
     // Register route: GET /api/v1/modules/{addr}/registers
     int result = api_manager_register_endpoint(
-        "/api/v1/modules/registers",  // Simplified path - will be parsed dynamically
+        "/api/v1/modules/{id:u8}/registers",
         API_MGR_HTTP_GET,
         api_get_module_registers_wrapper
     );
@@ -212,7 +157,7 @@ int register_metadata_api_init(void) {
     
     // Register route: GET /api/v1/modules/{addr}/registers/{reg_addr}
     result = api_manager_register_endpoint(
-        "/api/v1/modules/registers/single",  // Simplified path - will be parsed dynamically
+        "/api/v1/modules/{id:u8}/registers/{reg:hex16}",
         API_MGR_HTTP_GET,
         api_get_single_register_wrapper
     );
@@ -17,6 +17,7 @@
 #include "../../core/safety_integration/critical_module_detector.h"
 #include "../../core/safety_integration/graduated_response_system.h"
 #include "../../../hal/common/hal_common.h"
+#include "json_writer.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,15 +36,6 @@ static safety_api_statistics_t g_api_stats = {0};
 
 // 🕐 **UTILITY FUNCTIONS**
 
-/**
- * @brief Get current timestamp in milliseconds
- */
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)(tv.tv_sec) * 1000 + (uint64_t)(tv.tv_usec) / 1000;
-}
-
 /**
  * @brief Debug logging function
  */
@@ -84,6 +76,18 @@ static void warning_log(const char *format, ...) {
 
 // 🔧 **SYSTEM MANAGEMENT FUNCTIONS**
 
+/**
+ * @brief Copy a finished writer document into the response body
+ */
+static hal_status_t set_response_json(safety_api_response_t *response, const json_writer_t *writer) {
+    const char *json = json_writer_data(writer, NULL);
+    if (!json) {
+        error_log("Response JSON does not fit its buffer");
+        return HAL_ERROR;
+    }
+    return safety_config_api_set_response_body(response, json);
+}
+
 hal_status_t safety_config_api_init(void) {
     if (g_api_initialized) {
         warning_log("Safety configuration API already initialized");
@@ -169,7 +173,7 @@ hal_status_t safety_config_api_handle_request(const safety_api_request_t *reques
         return HAL_ERROR;
     }
     
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     g_api_stats.total_requests++;
     
     debug_log("Handling API request: %s %s", request->method, request->path);
@@ -233,7 +237,7 @@ hal_status_t safety_config_api_handle_request(const safety_api_request_t *reques
     }
     
     // Update statistics
-    uint64_t end_time = get_timestamp_ms();
+    uint64_t end_time = hal_time_now_ms();
     uint32_t processing_time = (uint32_t)(end_time - start_time);
     response->processing_time_ms = processing_time;
     response->response_timestamp = end_time;
@@ -444,42 +448,35 @@ hal_status_t safety_config_api_get_status(const safety_api_request_t *request,
     }
     
     // Create JSON response
-    char json_buffer[4096];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{"
-        "\"success\": true,"
-        "\"data\": {"
-            "\"system_active\": %s,"
-            "\"response_level\": \"%s\","
-            "\"modules_monitored\": %u,"
-            "\"modules_online\": %u,"
-            "\"modules_degraded\": %u,"
-            "\"modules_failed\": %u,"
-            "\"critical_modules_offline\": %u,"
-            "\"emergency_triggered\": %s,"
-            "\"total_emergencies\": %u,"
-            "\"led_patterns_active\": %s,"
-            "\"adaptive_polling_active\": %s,"
-            "\"last_check_time\": %llu"
-        "},"
-        "\"timestamp\": %llu"
-        "}",
-        detector_status.system_active ? "true" : "false",
-        critical_module_get_response_level_name(detector_status.overall_response_level),
-        detector_status.modules_monitored,
-        detector_status.modules_online,
-        detector_status.modules_degraded,
-        detector_status.modules_failed,
-        detector_status.critical_modules_offline,
-        detector_status.emergency_triggered ? "true" : "false",
-        detector_status.total_emergencies,
-        response_status.led_patterns_active ? "true" : "false",
-        response_status.adaptive_polling_active ? "true" : "false",
-        detector_status.last_system_check_ms,
-        get_timestamp_ms()
-    );
-    
-    safety_config_api_set_response_body(response, json_buffer);
+    char json_buffer[1024];
+    json_writer_t w;
+    json_writer_init(&w, json_buffer, sizeof(json_buffer));
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "system_active", detector_status.system_active);
+    json_writer_field_string(&w, "response_level",
+                             critical_module_get_response_level_name(detector_status.overall_response_level));
+    json_writer_field_uint(&w, "modules_monitored", detector_status.modules_monitored);
+    json_writer_field_uint(&w, "modules_online", detector_status.modules_online);
+    json_writer_field_uint(&w, "modules_degraded", detector_status.modules_degraded);
+    json_writer_field_uint(&w, "modules_failed", detector_status.modules_failed);
+    json_writer_field_uint(&w, "critical_modules_offline", detector_status.critical_modules_offline);
+    json_writer_field_bool(&w, "emergency_triggered", detector_status.emergency_triggered);
+    json_writer_field_uint(&w, "total_emergencies", detector_status.total_emergencies);
+    json_writer_field_bool(&w, "led_patterns_active", response_status.led_patterns_active);
+    json_writer_field_bool(&w, "adaptive_polling_active", response_status.adaptive_polling_active);
+    json_writer_field_uint(&w, "last_check_time", detector_status.last_system_check_ms);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    if (set_response_json(response, &w) != HAL_OK) {
+        safety_config_api_set_response_status(response, HTTP_STATUS_INTERNAL_ERROR, 
+                                             "Failed to build status response");
+        return HAL_ERROR;
+    }
     safety_config_api_set_response_status(response, HTTP_STATUS_OK, "Status retrieved successfully");
     
     return HAL_OK;
@@ -503,58 +500,48 @@ hal_status_t safety_config_api_get_statistics(const safety_api_request_t *reques
     }
     
     // Create JSON response
-    char json_buffer[8192];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{"
-        "\"success\": true,"
-        "\"data\": {"
-            "\"detector_statistics\": {"
-                "\"total_health_checks\": %llu,"
-                "\"total_failures_detected\": %llu,"
-                "\"total_recoveries\": %llu,"
-                "\"total_safety_actions\": %llu,"
-                "\"min_detection_time_ms\": %u,"
-                "\"max_detection_time_ms\": %u,"
-                "\"avg_detection_time_ms\": %u"
-            "},"
-            "\"response_statistics\": {"
-                "\"total_transitions\": %u,"
-                "\"escalation_count\": %u,"
-                "\"de_escalation_count\": %u,"
-                "\"auto_recoveries\": %u,"
-                "\"led_update_count\": %u,"
-                "\"polling_adjustments\": %u"
-            "},"
-            "\"api_statistics\": {"
-                "\"total_requests\": %u,"
-                "\"successful_requests\": %u,"
-                "\"failed_requests\": %u,"
-                "\"avg_processing_time_ms\": %u"
-            "}"
-        "},"
-        "\"timestamp\": %llu"
-        "}",
-        detector_stats.total_health_checks,
-        detector_stats.total_failures_detected,
-        detector_stats.total_recoveries,
-        detector_stats.total_safety_actions,
-        detector_stats.min_detection_time_ms,
-        detector_stats.max_detection_time_ms,
-        detector_stats.avg_detection_time_ms,
-        response_stats.total_transitions,
-        response_stats.escalation_count,
-        response_stats.de_escalation_count,
-        response_stats.auto_recoveries,
-        response_stats.led_update_count,
-        response_stats.polling_adjustments,
-        g_api_stats.total_requests,
-        g_api_stats.successful_requests,
-        g_api_stats.failed_requests,
-        g_api_stats.avg_processing_time_ms,
-        get_timestamp_ms()
-    );
-    
-    safety_config_api_set_response_body(response, json_buffer);
+    char json_buffer[1536];
+    json_writer_t w;
+    json_writer_init(&w, json_buffer, sizeof(json_buffer));
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_key(&w, "detector_statistics");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "total_health_checks", detector_stats.total_health_checks);
+    json_writer_field_uint(&w, "total_failures_detected", detector_stats.total_failures_detected);
+    json_writer_field_uint(&w, "total_recoveries", detector_stats.total_recoveries);
+    json_writer_field_uint(&w, "total_safety_actions", detector_stats.total_safety_actions);
+    json_writer_field_uint(&w, "min_detection_time_ms", detector_stats.min_detection_time_ms);
+    json_writer_field_uint(&w, "max_detection_time_ms", detector_stats.max_detection_time_ms);
+    json_writer_field_uint(&w, "avg_detection_time_ms", detector_stats.avg_detection_time_ms);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "response_statistics");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "total_transitions", response_stats.total_transitions);
+    json_writer_field_uint(&w, "escalation_count", response_stats.escalation_count);
+    json_writer_field_uint(&w, "de_escalation_count", response_stats.de_escalation_count);
+    json_writer_field_uint(&w, "auto_recoveries", response_stats.auto_recoveries);
+    json_writer_field_uint(&w, "led_update_count", response_stats.led_update_count);
+    json_writer_field_uint(&w, "polling_adjustments", response_stats.polling_adjustments);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "api_statistics");
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "total_requests", g_api_stats.total_requests);
+    json_writer_field_uint(&w, "successful_requests", g_api_stats.successful_requests);
+    json_writer_field_uint(&w, "failed_requests", g_api_stats.failed_requests);
+    json_writer_field_uint(&w, "avg_processing_time_ms", g_api_stats.avg_processing_time_ms);
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    if (set_response_json(response, &w) != HAL_OK) {
+        safety_config_api_set_response_status(response, HTTP_STATUS_INTERNAL_ERROR, 
+                                             "Failed to build statistics response");
+        return HAL_ERROR;
+    }
     safety_config_api_set_response_status(response, HTTP_STATUS_OK, "Statistics retrieved successfully");
     
     return HAL_OK;
@@ -641,26 +628,28 @@ hal_status_t safety_config_api_get_diagnostics(const safety_api_request_t *reque
         return HAL_ERROR;
     }
     
-    // Create JSON response
+    // Create JSON response; the diagnostics text is escaped, so it may hold quotes and newlines
     char json_buffer[8192];
-    snprintf(json_buffer, sizeof(json_buffer),
-        "{"
-        "\"success\": true,"
-        "\"data\": {"
-            "\"diagnostics\": \"%s\","
-            "\"system_health\": \"HEALTHY\","
-            "\"uptime_ms\": %llu,"
-            "\"memory_usage_kb\": 512,"
-            "\"cpu_usage_percent\": 15.5"
-        "},"
-        "\"timestamp\": %llu"
-        "}",
-        diagnostics_buffer,
-        get_timestamp_ms(),
-        get_timestamp_ms()
-    );
-    
-    safety_config_api_set_response_body(response, json_buffer);
+    json_writer_t w;
+    json_writer_init(&w, json_buffer, sizeof(json_buffer));
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "diagnostics", diagnostics_buffer);
+    json_writer_field_string(&w, "system_health", "HEALTHY");
+    json_writer_field_uint(&w, "uptime_ms", hal_time_now_ms());
+    json_writer_field_uint(&w, "memory_usage_kb", 512);
+    json_writer_field_fixed(&w, "cpu_usage_percent", 15.5, 1);
+    json_writer_end_object(&w);
+    json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+    json_writer_end_object(&w);
+    
+    if (set_response_json(response, &w) != HAL_OK) {
+        safety_config_api_set_response_status(response, HTTP_STATUS_INTERNAL_ERROR, 
+                                             "Failed to build diagnostics response");
+        return HAL_ERROR;
+    }
     safety_config_api_set_response_status(response, HTTP_STATUS_OK, "Diagnostics retrieved successfully");
     
     return HAL_OK;
@@ -687,7 +676,7 @@ hal_status_t safety_config_api_create_response(safety_api_response_t *response,
     
     strcpy(response->content_type, "application/json");
     strcpy(response->cache_control, "no-cache");
-    response->response_timestamp = get_timestamp_ms();
+    response->response_timestamp = hal_time_wall_ms();
     
     return HAL_OK;
 }
@@ -744,20 +733,16 @@ hal_status_t safety_config_api_set_response_status(safety_api_response_t *respon
     // If no body is set yet, create a simple status message
     if (!response->body || response->body_length == 0) {
         char status_json[512];
-        snprintf(status_json, sizeof(status_json),
-            "{"
-            "\"success\": %s,"
-            "\"message\": \"%s\","
-            "\"status_code\": %u,"
-            "\"timestamp\": %llu"
-            "}",
-            (status_code >= 200 && status_code < 300) ? "true" : "false",
-            message ? message : "No message",
-            status_code,
-            get_timestamp_ms()
-        );
+        json_writer_t w;
+        json_writer_init(&w, status_json, sizeof(status_json));
+        json_writer_begin_object(&w);
+        json_writer_field_bool(&w, "success", status_code >= 200 && status_code < 300);
+        json_writer_field_string(&w, "message", message ? message : "No message");
+        json_writer_field_uint(&w, "status_code", status_code);
+        json_writer_field_uint(&w, "timestamp", hal_time_wall_ms());
+        json_writer_end_object(&w);
         
-        safety_config_api_set_response_body(response, status_json);
+        return set_response_json(response, &w);
     }
     
     return HAL_OK;
@@ -815,31 +800,40 @@ hal_status_t safety_config_api_config_to_json(const safety_system_config_t *conf
         return HAL_ERROR;
     }
     
-    // Mock JSON generation - would use actual JSON library in real implementation
-    snprintf(json_output, max_len,
-        "{"
-        "\"config_version\": \"%s\","
-        "\"system_name\": \"%s\","
-        "\"config_timestamp\": %llu,"
-        "\"global_settings\": {"
-            "\"enable_module_monitoring\": %s,"
-            "\"enable_graduated_response\": %s,"
-            "\"system_update_interval_ms\": %u"
-        "},"
-        "\"modules\": {"
-            "\"power_module\": {\"address\": \"0x02\", \"timeout_ms\": 5000},"
-            "\"safety_module\": {\"address\": \"0x03\", \"timeout_ms\": 0},"
-            "\"travel_module\": {\"address\": \"0x04\", \"timeout_ms\": 1000},"
-            "\"dock_module\": {\"address\": \"0x06\", \"timeout_ms\": 10000}"
-        "}"
-        "}",
-        config->config_version,
-        config->system_name,
-        config->config_timestamp,
-        config->global_settings.enable_module_monitoring ? "true" : "false",
-        config->global_settings.enable_graduated_response ? "true" : "false",
-        config->global_settings.system_update_interval_ms
-    );
+    json_writer_t w;
+    json_writer_init(&w, json_output, max_len);
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "config_version", config->config_version);
+    json_writer_field_string(&w, "system_name", config->system_name);
+    json_writer_field_uint(&w, "config_timestamp", config->config_timestamp);
+    json_writer_key(&w, "global_settings");
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "enable_module_monitoring", config->global_settings.enable_module_monitoring);
+    json_writer_field_bool(&w, "enable_graduated_response", config->global_settings.enable_graduated_response);
+    json_writer_field_uint(&w, "system_update_interval_ms", config->global_settings.system_update_interval_ms);
+    json_writer_end_object(&w);
+    json_writer_key(&w, "modules");
+    json_writer_begin_object(&w);
+    static const struct { const char *name; uint8_t address; uint32_t timeout_ms; } modules[] = {
+        { "power_module", 0x02, 5000 },
+        { "safety_module", 0x03, 0 },
+        { "travel_module", 0x04, 1000 },
+        { "dock_module", 0x06, 10000 },
+    };
+    for (size_t i = 0; i < sizeof(modules) / sizeof(modules[0]); i++) {
+        json_writer_key(&w, modules[i].name);
+        json_writer_begin_object(&w);
+        json_writer_field_hex(&w, "address", modules[i].address, 2);
+        json_writer_field_uint(&w, "timeout_ms", modules[i].timeout_ms);
+        json_writer_end_object(&w);
+    }
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+    
+    if (json_writer_status(&w) != HAL_STATUS_OK) {
+        error_log("Configuration JSON does not fit %zu bytes", max_len);
+        return HAL_ERROR;
+    }
     
     debug_log("Configuration converted to JSON successfully");
     return HAL_OK;
@@ -0,0 +1,394 @@
+/**
+ * @file control_executor.c
+ * @brief Fixed-rate real-time thread driving the estimator, safety interlock and control loop
+ * @version 1.0.0
+ * @date 2025-02-26
+ * @team FW
+ */
+
+#include "control_executor.h"
+#include "control_loop.h"
+#include "estimator_1d.h"
+#include "hal_estop.h"
+#include "../safety/safety_monitor.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CONTROL_EXECUTOR_STACK_PREFAULT     (16U * 1024U)   // Stack touched once so cycles never page-fault on it
+#define CONTROL_EXECUTOR_NS_PER_US          1000ULL
+#define CONTROL_EXECUTOR_NS_PER_S           1000000000ULL
+
+// Executor state; counters have a single writer (the executor thread) and are read with atomic loads
+typedef struct {
+    control_executor_config_t config;
+    pthread_t thread;
+    bool running;
+    bool stop_requested;
+    bool reset_requested;
+    int16_t cpu;
+    bool realtime;
+    bool memory_locked;
+    bool interlock_latched;
+
+    uint64_t cycles;
+    uint64_t overruns;
+    uint64_t missed_deadlines;
+    uint64_t interlock_trips;
+    uint64_t jitter_sum_ns;
+    uint64_t jitter_max_ns;
+    uint64_t exec_sum_ns;
+    uint64_t exec_max_ns;
+    uint64_t jitter_hist[CONTROL_EXECUTOR_HIST_BUCKETS];
+    uint64_t exec_hist[CONTROL_EXECUTOR_HIST_BUCKETS];
+} control_executor_t;
+
+static control_executor_t g_executor = {0};
+static pthread_mutex_t g_executor_mutex = PTHREAD_MUTEX_INITIALIZER;   // Serialises start/stop/reset
+
+static struct timespec control_executor_timespec(uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / CONTROL_EXECUTOR_NS_PER_S);
+    ts.tv_nsec = (long)(ns % CONTROL_EXECUTOR_NS_PER_S);
+    return ts;
+}
+
+static uint32_t control_executor_bucket(uint64_t ns)
+{
+    uint64_t us = ns / CONTROL_EXECUTOR_NS_PER_US;
+    if (us == 0) {
+        return 0;
+    }
+    uint32_t bucket = (uint32_t)(64 - __builtin_clzll(us));
+    return bucket < CONTROL_EXECUTOR_HIST_BUCKETS ? bucket : CONTROL_EXECUTOR_HIST_BUCKETS - 1U;
+}
+
+static void control_executor_add(uint64_t *counter, uint64_t value)
+{
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+static void control_executor_max(uint64_t *counter, uint64_t value)
+{
+    if (value > __atomic_load_n(counter, __ATOMIC_RELAXED)) {
+        __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+    }
+}
+
+static void control_executor_clear_counters(void)
+{
+    __atomic_store_n(&g_executor.cycles, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.overruns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.missed_deadlines, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.interlock_trips, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.jitter_sum_ns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.jitter_max_ns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.exec_sum_ns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.exec_max_ns, 0, __ATOMIC_RELAXED);
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        __atomic_store_n(&g_executor.jitter_hist[b], 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&g_executor.exec_hist[b], 0, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief CPU for the executor thread
+ * @return CPU index, -1 to leave it unpinned
+ */
+static int control_executor_pick_cpu(int16_t requested, long online)
+{
+    if (requested >= 0) {
+        return requested < online ? requested : -1;
+    }
+    if (requested != CONTROL_EXECUTOR_CPU_AUTO || online < 3) {
+        return -1;
+    }
+    return (int)(online - 2);
+}
+
+/**
+ * @brief Pin, raise to SCHED_FIFO and lock memory for the calling thread, as far as permitted
+ */
+static void control_executor_enter_realtime(void)
+{
+    int cpu = control_executor_pick_cpu(g_executor.config.cpu, sysconf(_SC_NPROCESSORS_ONLN));
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET((size_t)cpu, &set);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (rc != 0) {
+            printf("[CONTROL-EXEC] Not pinned to CPU %d: %s\n", cpu, strerror(rc));
+            cpu = -1;
+        }
+    }
+
+    bool realtime = false;
+    if (g_executor.config.priority > 0) {
+        struct sched_param param = { .sched_priority = g_executor.config.priority };
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc == 0) {
+            realtime = true;
+        } else {
+            printf("[CONTROL-EXEC] SCHED_FIFO %u not permitted (%s), running at normal priority\n",
+                   g_executor.config.priority, strerror(rc));
+        }
+    }
+
+    bool locked = false;
+    if (g_executor.config.lock_memory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            locked = true;
+        } else {
+            printf("[CONTROL-EXEC] mlockall not permitted (%s), memory may page\n", strerror(errno));
+        }
+    }
+
+    // Fault the stack in now rather than in the first cycles
+    volatile uint8_t stack[CONTROL_EXECUTOR_STACK_PREFAULT];
+    memset((void *)stack, 0, sizeof(stack));
+
+    __atomic_store_n(&g_executor.cpu, (int16_t)cpu, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.realtime, realtime, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_executor.memory_locked, locked, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief One cycle: estimator, interlock, control
+ * @param now_ns Wake-up time on CLOCK_MONOTONIC
+ */
+static void control_executor_cycle(uint64_t now_ns)
+{
+    uint64_t now_ms = now_ns / 1000000ULL;
+
+    // Estimator: integrate the measured velocity while the loop is driving
+    bool enabled = false;
+    float velocity = 0.0f;
+    if (control_loop_is_enabled(&enabled) == HAL_STATUS_OK && enabled &&
+        control_loop_get_current_velocity(&velocity) == HAL_STATUS_OK) {
+        (void)estimator_1d_update_velocity_proxy(velocity, now_ms);
+    }
+
+    // Interlock: an active E-Stop holds the loop in EMERGENCY before it computes an output
+    bool estop = false;
+    bool active = false;
+    if (hal_estop_is_triggered(&active) == HAL_STATUS_OK && active) {
+        estop = true;
+    }
+    if (safety_monitor_is_estop_active(&active) == HAL_STATUS_OK && active) {
+        estop = true;
+    }
+    control_mode_t mode = CONTROL_MODE_IDLE;
+    if (estop && control_loop_get_mode(&mode) == HAL_STATUS_OK && mode != CONTROL_MODE_EMERGENCY) {
+        (void)control_loop_emergency_stop();
+        control_executor_add(&g_executor.interlock_trips, 1);
+    }
+    // Published only; the main thread logs changes (no stdio on this thread)
+    if (estop != __atomic_load_n(&g_executor.interlock_latched, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&g_executor.interlock_latched, estop, __ATOMIC_RELAXED);
+    }
+
+    (void)control_loop_run_cycle();
+}
+
+static void *control_executor_thread(void *arg)
+{
+    (void)arg;
+    control_executor_enter_realtime();
+
+    uint64_t period_ns = (uint64_t)g_executor.config.period_us * CONTROL_EXECUTOR_NS_PER_US;
+    uint64_t deadline = hal_time_now_ns();
+
+    while (!__atomic_load_n(&g_executor.stop_requested, __ATOMIC_ACQUIRE)) {
+        deadline += period_ns;
+        struct timespec wake_at = control_executor_timespec(deadline);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_at, NULL) == EINTR) {
+        }
+
+        uint64_t woke = hal_time_now_ns();
+        if (__atomic_exchange_n(&g_executor.reset_requested, false, __ATOMIC_ACQ_REL)) {
+            control_executor_clear_counters();
+        }
+
+        control_executor_cycle(woke);
+
+        uint64_t done = hal_time_now_ns();
+        uint64_t jitter = woke > deadline ? woke - deadline : 0;
+        uint64_t exec = done - woke;
+
+        control_executor_add(&g_executor.cycles, 1);
+        control_executor_add(&g_executor.jitter_sum_ns, jitter);
+        control_executor_add(&g_executor.exec_sum_ns, exec);
+        control_executor_max(&g_executor.jitter_max_ns, jitter);
+        control_executor_max(&g_executor.exec_max_ns, exec);
+        control_executor_add(&g_executor.jitter_hist[control_executor_bucket(jitter)], 1);
+        control_executor_add(&g_executor.exec_hist[control_executor_bucket(exec)], 1);
+
+        // Ran past the next deadline: skip the ones already gone instead of bursting to catch up
+        if (done >= deadline + period_ns) {
+            uint64_t skipped = (done - deadline) / period_ns;
+            deadline += skipped * period_ns;
+            control_executor_add(&g_executor.overruns, 1);
+            control_executor_add(&g_executor.missed_deadlines, skipped);
+        }
+    }
+    return NULL;
+}
+
+hal_status_t control_executor_get_default_config(control_executor_config_t *config)
+{
+    if (config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    memset(config, 0, sizeof(*config));
+    config->period_us = 1000;
+    config->cpu = CONTROL_EXECUTOR_CPU_AUTO;
+    config->priority = 85;
+    config->lock_memory = true;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t control_executor_start(const control_executor_config_t *config)
+{
+    if (config == NULL || config->period_us < CONTROL_EXECUTOR_MIN_PERIOD_US ||
+        config->period_us > CONTROL_EXECUTOR_MAX_PERIOD_US || config->priority > 99) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_executor_mutex);
+    if (__atomic_load_n(&g_executor.running, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_unlock(&g_executor_mutex);
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+
+    g_executor.config = *config;
+    g_executor.stop_requested = false;
+    g_executor.reset_requested = false;
+    g_executor.interlock_latched = false;
+    g_executor.cpu = -1;
+    g_executor.realtime = false;
+    g_executor.memory_locked = false;
+    control_executor_clear_counters();
+
+    int rc = pthread_create(&g_executor.thread, NULL, control_executor_thread, NULL);
+    if (rc != 0) {
+        pthread_mutex_unlock(&g_executor_mutex);
+        printf("[CONTROL-EXEC] Thread not created: %s\n", strerror(rc));
+        return HAL_STATUS_ERROR;
+    }
+    __atomic_store_n(&g_executor.running, true, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_executor_mutex);
+
+    printf("[CONTROL-EXEC] Running at %u Hz\n", 1000000U / config->period_us);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t control_executor_stop(void)
+{
+    pthread_mutex_lock(&g_executor_mutex);
+    if (!__atomic_load_n(&g_executor.running, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_unlock(&g_executor_mutex);
+        return HAL_STATUS_OK;
+    }
+    __atomic_store_n(&g_executor.stop_requested, true, __ATOMIC_RELEASE);
+    pthread_join(g_executor.thread, NULL);
+    __atomic_store_n(&g_executor.running, false, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_executor_mutex);
+
+    printf("[CONTROL-EXEC] Stopped after %llu cycles (%llu overruns)\n",
+           (unsigned long long)g_executor.cycles, (unsigned long long)g_executor.overruns);
+    return HAL_STATUS_OK;
+}
+
+bool control_executor_is_running(void)
+{
+    return __atomic_load_n(&g_executor.running, __ATOMIC_ACQUIRE);
+}
+
+uint32_t control_executor_bucket_limit_us(uint32_t bucket)
+{
+    if (bucket >= CONTROL_EXECUTOR_HIST_BUCKETS - 1U) {
+        return UINT32_MAX;
+    }
+    return 1U << bucket;
+}
+
+/**
+ * @brief Upper edge of the bucket holding the 99th percentile, capped at the observed maximum
+ */
+static uint32_t control_executor_p99_us(const uint64_t *hist, uint64_t total, uint32_t max_us)
+{
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = total - total / 100U;
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen >= target) {
+            uint32_t limit = control_executor_bucket_limit_us(b);
+            return limit < max_us ? limit : max_us;
+        }
+    }
+    return max_us;
+}
+
+hal_status_t control_executor_get_stats(control_executor_stats_t *stats)
+{
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    stats->cycles = __atomic_load_n(&g_executor.cycles, __ATOMIC_RELAXED);
+    stats->overruns = __atomic_load_n(&g_executor.overruns, __ATOMIC_RELAXED);
+    stats->missed_deadlines = __atomic_load_n(&g_executor.missed_deadlines, __ATOMIC_RELAXED);
+    stats->interlock_trips = __atomic_load_n(&g_executor.interlock_trips, __ATOMIC_RELAXED);
+    stats->interlock_active = __atomic_load_n(&g_executor.interlock_latched, __ATOMIC_RELAXED);
+    uint64_t jitter_total = 0;
+    uint64_t exec_total = 0;
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        stats->jitter_hist[b] = __atomic_load_n(&g_executor.jitter_hist[b], __ATOMIC_RELAXED);
+        stats->exec_hist[b] = __atomic_load_n(&g_executor.exec_hist[b], __ATOMIC_RELAXED);
+        jitter_total += stats->jitter_hist[b];
+        exec_total += stats->exec_hist[b];
+    }
+
+    stats->jitter_max_us = (uint32_t)(__atomic_load_n(&g_executor.jitter_max_ns, __ATOMIC_RELAXED) /
+                                      CONTROL_EXECUTOR_NS_PER_US);
+    stats->exec_max_us = (uint32_t)(__atomic_load_n(&g_executor.exec_max_ns, __ATOMIC_RELAXED) /
+                                    CONTROL_EXECUTOR_NS_PER_US);
+    if (jitter_total > 0) {
+        stats->jitter_avg_us = (float)((double)__atomic_load_n(&g_executor.jitter_sum_ns, __ATOMIC_RELAXED) /
+                                       (double)jitter_total / 1000.0);
+        stats->exec_avg_us = (float)((double)__atomic_load_n(&g_executor.exec_sum_ns, __ATOMIC_RELAXED) /
+                                     (double)exec_total / 1000.0);
+    }
+    stats->jitter_p99_us = control_executor_p99_us(stats->jitter_hist, jitter_total, stats->jitter_max_us);
+    stats->exec_p99_us = control_executor_p99_us(stats->exec_hist, exec_total, stats->exec_max_us);
+
+    stats->running = control_executor_is_running();
+    stats->period_us = g_executor.config.period_us;
+    stats->cpu = __atomic_load_n(&g_executor.cpu, __ATOMIC_RELAXED);
+    stats->realtime = __atomic_load_n(&g_executor.realtime, __ATOMIC_RELAXED);
+    stats->memory_locked = __atomic_load_n(&g_executor.memory_locked, __ATOMIC_RELAXED);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t control_executor_reset_stats(void)
+{
+    pthread_mutex_lock(&g_executor_mutex);
+    if (__atomic_load_n(&g_executor.running, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&g_executor.reset_requested, true, __ATOMIC_RELEASE);
+    } else {
+        control_executor_clear_counters();
+    }
+    pthread_mutex_unlock(&g_executor_mutex);
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file control_executor.h
+ * @brief Fixed-rate real-time thread driving the estimator, safety interlock and control loop
+ * @version 1.0.0
+ * @date 2025-02-26
+ * @team FW
+ *
+ * One thread sleeps to absolute deadlines on CLOCK_MONOTONIC
+ * (clock_nanosleep with TIMER_ABSTIME), so the period does not drift with
+ * the time the cycle itself takes. Each cycle:
+ *   1. estimator_1d integrates the measured velocity
+ *   2. the interlock forces the control loop to EMERGENCY while an E-Stop is active
+ *   3. control_loop_run_cycle() computes and applies the output
+ *
+ * Where the process is permitted to, the thread runs SCHED_FIFO, pinned to
+ * one CPU, with the process memory locked (mlockall). Without those rights
+ * it still runs, at normal priority, and the statistics say so.
+ *
+ * Wake-up jitter (wake time minus deadline) and cycle execution time are
+ * kept in log2 microsecond histograms. A cycle that ends after the next
+ * deadline is an overrun; the deadlines it ran over are skipped rather
+ * than run back to back.
+ */
+
+#ifndef CONTROL_EXECUTOR_H
+#define CONTROL_EXECUTOR_H
+
+#include "hal_common.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CONTROL_EXECUTOR_MIN_PERIOD_US  250     // 4 kHz
+#define CONTROL_EXECUTOR_MAX_PERIOD_US  10000   // 100 Hz
+#define CONTROL_EXECUTOR_HIST_BUCKETS   16      // Bucket 0: < 1 us, bucket b: [2^(b-1), 2^b) us, last: open-ended
+#define CONTROL_EXECUTOR_CPU_AUTO       (-1)    // Next to last online CPU (the last one is the LiDAR safety worker's)
+#define CONTROL_EXECUTOR_CPU_NONE       (-2)    // Do not pin
+
+// Executor configuration
+typedef struct {
+    uint32_t period_us;             // Cycle period, CONTROL_EXECUTOR_MIN_PERIOD_US..CONTROL_EXECUTOR_MAX_PERIOD_US
+    int16_t cpu;                    // CPU index, CONTROL_EXECUTOR_CPU_AUTO or CONTROL_EXECUTOR_CPU_NONE
+    uint8_t priority;               // SCHED_FIFO priority 1..99, 0 = normal scheduling
+    bool lock_memory;               // mlockall(MCL_CURRENT | MCL_FUTURE) before the first cycle
+} control_executor_config_t;
+
+// Executor statistics
+typedef struct {
+    uint64_t cycles;
+    uint64_t overruns;              // Cycles that ended after the next deadline
+    uint64_t missed_deadlines;      // Deadlines skipped after overruns
+    uint64_t interlock_trips;       // Cycles that forced the control loop to EMERGENCY
+    bool interlock_active;          // An E-Stop currently holds the control loop in EMERGENCY
+    uint32_t period_us;
+    uint32_t jitter_max_us;
+    uint32_t jitter_p99_us;         // Upper edge of the bucket holding the 99th percentile
+    float jitter_avg_us;
+    uint32_t exec_max_us;
+    uint32_t exec_p99_us;
+    float exec_avg_us;
+    uint64_t jitter_hist[CONTROL_EXECUTOR_HIST_BUCKETS];
+    uint64_t exec_hist[CONTROL_EXECUTOR_HIST_BUCKETS];
+    int16_t cpu;                    // CPU the thread is pinned to, -1 if not pinned
+    bool running;
+    bool realtime;                  // SCHED_FIFO granted
+    bool memory_locked;             // mlockall succeeded
+} control_executor_stats_t;
+
+/**
+ * @brief Fill a configuration with defaults (1 kHz, SCHED_FIFO 85, CPU auto, memory locked)
+ * @param config Output
+ * @return HAL status
+ */
+hal_status_t control_executor_get_default_config(control_executor_config_t *config);
+
+/**
+ * @brief Start the executor thread
+ *
+ * The control loop must already be initialized; its sample_time should
+ * match period_us since the PID uses sample_time as its step.
+ *
+ * @param config Configuration
+ * @return HAL_STATUS_ALREADY_INITIALIZED if running, HAL_STATUS_ERROR if the thread cannot be created
+ */
+hal_status_t control_executor_start(const control_executor_config_t *config);
+
+/**
+ * @brief Stop the executor thread and wait for it (at most one period)
+ * @return HAL status
+ */
+hal_status_t control_executor_stop(void);
+
+/**
+ * @brief Check whether the executor thread is running
+ * @return true if running
+ */
+bool control_executor_is_running(void);
+
+/**
+ * @brief Get executor statistics
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t control_executor_get_stats(control_executor_stats_t *stats);
+
+/**
+ * @brief Clear counters and histograms (applied by the thread at its next cycle when running)
+ * @return HAL status
+ */
+hal_status_t control_executor_reset_stats(void);
+
+/**
+ * @brief Upper edge of a histogram bucket
+ * @param bucket Bucket index
+ * @return Microseconds, UINT32_MAX for the open-ended last bucket
+ */
+uint32_t control_executor_bucket_limit_us(uint32_t bucket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONTROL_EXECUTOR_H
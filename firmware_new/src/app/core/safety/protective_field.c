@@ -0,0 +1,529 @@
+/**
+ * @file protective_field.c
+ * @brief Direction- and speed-dependent LiDAR protective fields
+ * @version 1.0.0
+ * @date 2025-02-22
+ * @team FW
+ */
+
+#include "protective_field.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROTECTIVE_FIELD_DEG_TO_RAD 0.017453292519943295f
+
+// Per-degree thresholds of one field, indexed by sensor degree
+typedef struct {
+    uint16_t stop_mm[PROTECTIVE_FIELD_DEGREES];
+    uint16_t warning_mm[PROTECTIVE_FIELD_DEGREES];
+} protective_field_lut_t;
+
+static const protective_field_options_t default_options = {
+    .standstill_mm_s = 20.0f,
+    .hysteresis_mm_s = 30.0f,
+    .hold_ms = 500,
+    .mount_offset_deg = 0
+};
+
+// Default OHT field set: sectors while slow, rail-width rectangles at speed
+static const protective_field_def_t default_fields[] = {
+    {
+        .name = "standstill",
+        .direction = PROTECTIVE_FIELD_DIR_ANY,
+        .min_speed_mm_s = 0.0f,
+        .max_speed_mm_s = 50.0f,
+        .shape = PROTECTIVE_FIELD_SHAPE_SECTORS,
+        .sector_count = 1,
+        .sectors = { { 0, 0, 500, 1000 } }
+    },
+    {
+        .name = "forward_slow",
+        .direction = PROTECTIVE_FIELD_DIR_FORWARD,
+        .min_speed_mm_s = 50.0f,
+        .max_speed_mm_s = 500.0f,
+        .shape = PROTECTIVE_FIELD_SHAPE_SECTORS,
+        .sector_count = 4,
+        .sectors = {
+            { 300, 60, 800, 1500 },         // Ahead
+            { 60, 120, 300, 500 },          // Beside
+            { 240, 300, 300, 500 },
+            { 120, 240, 0, 0 }              // Behind
+        }
+    },
+    {
+        .name = "forward_fast",
+        .direction = PROTECTIVE_FIELD_DIR_FORWARD,
+        .min_speed_mm_s = 500.0f,
+        .max_speed_mm_s = PROTECTIVE_FIELD_SPEED_UNBOUNDED,
+        .shape = PROTECTIVE_FIELD_SHAPE_POLYGON,
+        .stop_vertex_count = 4,
+        .stop_polygon = { { -200, -400 }, { 2000, -400 }, { 2000, 400 }, { -200, 400 } },
+        .warning_vertex_count = 4,
+        .warning_polygon = { { -200, -600 }, { 3500, -600 }, { 3500, 600 }, { -200, 600 } }
+    },
+    {
+        .name = "reverse_slow",
+        .direction = PROTECTIVE_FIELD_DIR_REVERSE,
+        .min_speed_mm_s = 50.0f,
+        .max_speed_mm_s = 500.0f,
+        .shape = PROTECTIVE_FIELD_SHAPE_SECTORS,
+        .sector_count = 4,
+        .sectors = {
+            { 120, 240, 800, 1500 },        // Behind
+            { 60, 120, 300, 500 },          // Beside
+            { 240, 300, 300, 500 },
+            { 300, 60, 0, 0 }               // Ahead
+        }
+    },
+    {
+        .name = "reverse_fast",
+        .direction = PROTECTIVE_FIELD_DIR_REVERSE,
+        .min_speed_mm_s = 500.0f,
+        .max_speed_mm_s = PROTECTIVE_FIELD_SPEED_UNBOUNDED,
+        .shape = PROTECTIVE_FIELD_SHAPE_POLYGON,
+        .stop_vertex_count = 4,
+        .stop_polygon = { { -2000, -400 }, { 200, -400 }, { 200, 400 }, { -2000, 400 } },
+        .warning_vertex_count = 4,
+        .warning_polygon = { { -3500, -600 }, { 200, -600 }, { 200, 600 }, { -3500, 600 } }
+    }
+};
+
+#define DEFAULT_FIELD_COUNT ((uint8_t)(sizeof(default_fields) / sizeof(default_fields[0])))
+
+static struct {
+    pthread_mutex_t mutex;
+    bool initialized;
+    protective_field_options_t options;
+    protective_field_def_t fields[PROTECTIVE_FIELD_MAX_FIELDS];
+    uint8_t field_count;
+    protective_field_lut_t luts[PROTECTIVE_FIELD_MAX_FIELDS];
+    protective_field_lut_t fallback;        // Per-degree maximum of all fields
+    uint8_t active_field;
+    uint8_t pending_field;
+    uint64_t pending_since_ms;
+    bool velocity_valid;
+    float velocity_mm_s;
+    uint32_t field_switches;
+    uint32_t evaluations;
+    uint32_t stop_violations;
+    uint32_t warning_violations;
+} g_protective_field = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+static bool protective_field_sector_covers(const protective_field_sector_t *sector, uint16_t deg)
+{
+    if (sector->start_deg == sector->end_deg) {
+        return true;
+    }
+    // A degree bin reaches half a degree either side, so both boundary bins are covered
+    if (sector->start_deg < sector->end_deg) {
+        return deg >= sector->start_deg && deg <= sector->end_deg;
+    }
+    return deg >= sector->start_deg || deg <= sector->end_deg;
+}
+
+/**
+ * @brief Distance from the origin to the far side of a polygon along a ray
+ * @return 0 if the ray does not cross the polygon
+ */
+static float protective_field_ray_distance(const protective_field_vertex_t *polygon, uint8_t count, float angle_rad)
+{
+    float dx = cosf(angle_rad);
+    float dy = sinf(angle_rad);
+    float farthest = 0.0f;
+
+    for (uint8_t i = 0; i < count; i++) {
+        const protective_field_vertex_t *p = &polygon[i];
+        const protective_field_vertex_t *q = &polygon[(i + 1U) % count];
+        float px = (float)p->x_mm;
+        float py = (float)p->y_mm;
+        float ex = (float)q->x_mm - px;
+        float ey = (float)q->y_mm - py;
+        float denom = dx * ey - dy * ex;
+        if (fabsf(denom) < 1e-6f) {
+            continue;
+        }
+        float t = (px * ey - py * ex) / denom;
+        float u = (px * dy - py * dx) / denom;
+        if (t >= 0.0f && u >= 0.0f && u <= 1.0f && t > farthest) {
+            farthest = t;
+        }
+    }
+    return farthest;
+}
+
+/**
+ * @brief Polygon boundary for one degree bin, the farthest of its centre and edges
+ */
+static uint16_t protective_field_polygon_bin(const protective_field_vertex_t *polygon, uint8_t count, uint16_t deg)
+{
+    static const float offsets[] = { -0.5f, 0.0f, 0.5f };
+    float farthest = 0.0f;
+
+    for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[0]); k++) {
+        float angle_rad = ((float)deg + offsets[k]) * PROTECTIVE_FIELD_DEG_TO_RAD;
+        float d = protective_field_ray_distance(polygon, count, angle_rad);
+        if (d > farthest) {
+            farthest = d;
+        }
+    }
+    float rounded = ceilf(farthest);
+    return rounded >= (float)UINT16_MAX ? UINT16_MAX : (uint16_t)rounded;
+}
+
+static bool protective_field_validate(const protective_field_def_t *field)
+{
+    if (field->direction > PROTECTIVE_FIELD_DIR_REVERSE ||
+        !(field->min_speed_mm_s >= 0.0f) || !(field->max_speed_mm_s > field->min_speed_mm_s)) {
+        return false;
+    }
+    if (field->shape == PROTECTIVE_FIELD_SHAPE_SECTORS) {
+        if (field->sector_count == 0 || field->sector_count > PROTECTIVE_FIELD_MAX_SECTORS) {
+            return false;
+        }
+        for (uint8_t s = 0; s < field->sector_count; s++) {
+            if (field->sectors[s].start_deg >= PROTECTIVE_FIELD_DEGREES ||
+                field->sectors[s].end_deg >= PROTECTIVE_FIELD_DEGREES) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (field->shape == PROTECTIVE_FIELD_SHAPE_POLYGON) {
+        if (field->stop_vertex_count < 3 || field->stop_vertex_count > PROTECTIVE_FIELD_MAX_VERTICES) {
+            return false;
+        }
+        return field->warning_vertex_count == 0 ||
+               (field->warning_vertex_count >= 3 && field->warning_vertex_count <= PROTECTIVE_FIELD_MAX_VERTICES);
+    }
+    return false;
+}
+
+/**
+ * @brief Compile a field into sensor-degree thresholds
+ */
+static void protective_field_compile(const protective_field_def_t *field, int16_t mount_offset_deg,
+                                     protective_field_lut_t *lut)
+{
+    int32_t offset = ((int32_t)mount_offset_deg % PROTECTIVE_FIELD_DEGREES + PROTECTIVE_FIELD_DEGREES) %
+                     PROTECTIVE_FIELD_DEGREES;
+
+    for (uint16_t deg = 0; deg < PROTECTIVE_FIELD_DEGREES; deg++) {
+        uint16_t stop_mm = 0;
+        uint16_t warning_mm = 0;
+
+        if (field->shape == PROTECTIVE_FIELD_SHAPE_SECTORS) {
+            // Overlapping sectors: the larger boundary wins
+            for (uint8_t s = 0; s < field->sector_count; s++) {
+                const protective_field_sector_t *sector = &field->sectors[s];
+                if (protective_field_sector_covers(sector, deg)) {
+                    if (sector->stop_mm > stop_mm) {
+                        stop_mm = sector->stop_mm;
+                    }
+                    if (sector->warning_mm > warning_mm) {
+                        warning_mm = sector->warning_mm;
+                    }
+                }
+            }
+        } else {
+            stop_mm = protective_field_polygon_bin(field->stop_polygon, field->stop_vertex_count, deg);
+            warning_mm = field->warning_vertex_count > 0
+                             ? protective_field_polygon_bin(field->warning_polygon, field->warning_vertex_count, deg)
+                             : stop_mm;
+        }
+        if (warning_mm < stop_mm) {
+            warning_mm = stop_mm;
+        }
+
+        uint16_t sensor_deg = (uint16_t)(((int32_t)deg + offset) % PROTECTIVE_FIELD_DEGREES);
+        lut->stop_mm[sensor_deg] = stop_mm;
+        lut->warning_mm[sensor_deg] = warning_mm;
+    }
+}
+
+static const char *protective_field_name(uint8_t field)
+{
+    return field < g_protective_field.field_count ? g_protective_field.fields[field].name : "fallback";
+}
+
+/**
+ * @brief Install a validated field set (caller holds the mutex)
+ */
+static void protective_field_install(const protective_field_def_t *fields, uint8_t count)
+{
+    memcpy(g_protective_field.fields, fields, (size_t)count * sizeof(fields[0]));
+    g_protective_field.field_count = count;
+    memset(&g_protective_field.fallback, 0, sizeof(g_protective_field.fallback));
+
+    for (uint8_t f = 0; f < count; f++) {
+        g_protective_field.fields[f].name[PROTECTIVE_FIELD_NAME_LEN - 1] = '\0';
+        protective_field_lut_t *lut = &g_protective_field.luts[f];
+        protective_field_compile(&g_protective_field.fields[f], g_protective_field.options.mount_offset_deg, lut);
+        for (uint16_t deg = 0; deg < PROTECTIVE_FIELD_DEGREES; deg++) {
+            if (lut->stop_mm[deg] > g_protective_field.fallback.stop_mm[deg]) {
+                g_protective_field.fallback.stop_mm[deg] = lut->stop_mm[deg];
+            }
+            if (lut->warning_mm[deg] > g_protective_field.fallback.warning_mm[deg]) {
+                g_protective_field.fallback.warning_mm[deg] = lut->warning_mm[deg];
+            }
+        }
+    }
+
+    // New fields: protect everything until the next velocity update selects one
+    g_protective_field.active_field = PROTECTIVE_FIELD_FALLBACK;
+    g_protective_field.pending_field = PROTECTIVE_FIELD_FALLBACK;
+    g_protective_field.velocity_valid = false;
+}
+
+/**
+ * @brief First field whose direction and speed band match the velocity
+ */
+static uint8_t protective_field_match(float velocity_mm_s)
+{
+    float speed = fabsf(velocity_mm_s);
+    protective_field_direction_t direction = PROTECTIVE_FIELD_DIR_ANY;
+    if (speed >= g_protective_field.options.standstill_mm_s) {
+        direction = velocity_mm_s > 0.0f ? PROTECTIVE_FIELD_DIR_FORWARD : PROTECTIVE_FIELD_DIR_REVERSE;
+    }
+
+    for (uint8_t f = 0; f < g_protective_field.field_count; f++) {
+        const protective_field_def_t *field = &g_protective_field.fields[f];
+        if (field->direction != PROTECTIVE_FIELD_DIR_ANY && field->direction != direction) {
+            continue;
+        }
+        if (speed >= field->min_speed_mm_s && speed < field->max_speed_mm_s) {
+            return f;
+        }
+    }
+    return PROTECTIVE_FIELD_FALLBACK;
+}
+
+static void protective_field_switch(uint8_t field, float velocity_mm_s)
+{
+    printf("[SAFETY] Protective field %s -> %s (v=%.0f mm/s)\n", protective_field_name(g_protective_field.active_field),
+           protective_field_name(field), (double)velocity_mm_s);
+    g_protective_field.active_field = field;
+    g_protective_field.pending_field = field;
+    g_protective_field.field_switches++;
+}
+
+hal_status_t protective_field_init(const protective_field_options_t *options)
+{
+    pthread_mutex_lock(&g_protective_field.mutex);
+    if (g_protective_field.initialized) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+    if (options != NULL && !(options->standstill_mm_s >= 0.0f && options->hysteresis_mm_s >= 0.0f)) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    g_protective_field.options = options != NULL ? *options : default_options;
+    g_protective_field.field_switches = 0;
+    g_protective_field.evaluations = 0;
+    g_protective_field.stop_violations = 0;
+    g_protective_field.warning_violations = 0;
+    protective_field_install(default_fields, DEFAULT_FIELD_COUNT);
+    g_protective_field.initialized = true;
+    pthread_mutex_unlock(&g_protective_field.mutex);
+
+    printf("[SAFETY] Protective fields initialized (%u fields, mount offset %d deg)\n", DEFAULT_FIELD_COUNT,
+           g_protective_field.options.mount_offset_deg);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t protective_field_deinit(void)
+{
+    pthread_mutex_lock(&g_protective_field.mutex);
+    if (!g_protective_field.initialized) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    g_protective_field.initialized = false;
+    g_protective_field.field_count = 0;
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t protective_field_set_fields(const protective_field_def_t *fields, uint8_t count)
+{
+    if (fields == NULL || count == 0 || count > PROTECTIVE_FIELD_MAX_FIELDS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    for (uint8_t f = 0; f < count; f++) {
+        if (!protective_field_validate(&fields[f])) {
+            printf("[SAFETY] Protective field %u rejected\n", f);
+            return HAL_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    pthread_mutex_lock(&g_protective_field.mutex);
+    if (!g_protective_field.initialized) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    protective_field_install(fields, count);
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t protective_field_load_defaults(void)
+{
+    return protective_field_set_fields(default_fields, DEFAULT_FIELD_COUNT);
+}
+
+hal_status_t protective_field_update_motion(float velocity_mm_s, bool velocity_valid, uint64_t now_ms)
+{
+    if (velocity_valid && !isfinite(velocity_mm_s)) {
+        velocity_valid = false;
+    }
+
+    pthread_mutex_lock(&g_protective_field.mutex);
+    if (!g_protective_field.initialized) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    g_protective_field.velocity_valid = velocity_valid;
+    g_protective_field.velocity_mm_s = velocity_valid ? velocity_mm_s : 0.0f;
+
+    uint8_t active = g_protective_field.active_field;
+    uint8_t candidate = velocity_valid ? protective_field_match(velocity_mm_s) : PROTECTIVE_FIELD_FALLBACK;
+
+    if (candidate == active) {
+        g_protective_field.pending_field = active;
+    } else if (candidate == PROTECTIVE_FIELD_FALLBACK || active == PROTECTIVE_FIELD_FALLBACK) {
+        // Unknown motion protects everything at once; known motion leaves the fallback at once
+        protective_field_switch(candidate, velocity_mm_s);
+    } else {
+        const protective_field_def_t *from = &g_protective_field.fields[active];
+        const protective_field_def_t *to = &g_protective_field.fields[candidate];
+        // A directional field only guards its own side: never hold it while moving
+        // the other way, even when the target (e.g. standstill) has no direction
+        bool reversal = (from->direction == PROTECTIVE_FIELD_DIR_FORWARD && velocity_mm_s < 0.0f) ||
+                        (from->direction == PROTECTIVE_FIELD_DIR_REVERSE && velocity_mm_s > 0.0f);
+        bool slower = to->max_speed_mm_s <= from->min_speed_mm_s;
+
+        if (reversal || !slower) {
+            protective_field_switch(candidate, velocity_mm_s);
+        } else if (fabsf(velocity_mm_s) >= from->min_speed_mm_s - g_protective_field.options.hysteresis_mm_s) {
+            // Still within the hysteresis margin of the active band
+            g_protective_field.pending_field = active;
+        } else if (g_protective_field.pending_field != candidate) {
+            g_protective_field.pending_field = candidate;
+            g_protective_field.pending_since_ms = now_ms;
+        } else if (now_ms - g_protective_field.pending_since_ms >= g_protective_field.options.hold_ms) {
+            protective_field_switch(candidate, velocity_mm_s);
+        }
+    }
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t protective_field_evaluate(const lidar_scan_data_t *scan, protective_field_result_t *result)
+{
+    if (scan == NULL || result == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_protective_field.mutex);
+    if (!g_protective_field.initialized) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    uint8_t field = g_protective_field.active_field;
+    const protective_field_lut_t *lut =
+        field < g_protective_field.field_count ? &g_protective_field.luts[field] : &g_protective_field.fallback;
+    uint16_t count = scan->point_count < LIDAR_POINTS_PER_SCAN ? scan->point_count : LIDAR_POINTS_PER_SCAN;
+    uint16_t stop_points = 0;
+    uint16_t warning_points = 0;
+    uint16_t nearest_mm = UINT16_MAX;
+    uint16_t nearest_deg = 0;
+
+    // Single pass: one table lookup per return
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t d = scan->distance_mm[i];
+        uint16_t deg = lidar_angle_q6_to_deg(scan->angle_q6[i]);
+        if (d == 0 || d >= lut->warning_mm[deg]) {
+            continue;
+        }
+        warning_points++;
+        if (d < lut->stop_mm[deg]) {
+            stop_points++;
+        }
+        if (d < nearest_mm) {
+            nearest_mm = d;
+            nearest_deg = deg;
+        }
+    }
+
+    result->field = field;
+    result->stop_points = stop_points;
+    result->warning_points = warning_points;
+    result->stop_violated = stop_points > 0;
+    result->warning_violated = warning_points > 0;
+    result->nearest_mm = warning_points > 0 ? nearest_mm : 0;
+    result->nearest_angle_deg = nearest_deg;
+
+    g_protective_field.evaluations++;
+    if (result->stop_violated) {
+        g_protective_field.stop_violations++;
+    } else if (result->warning_violated) {
+        g_protective_field.warning_violations++;
+    }
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t protective_field_get_thresholds(uint8_t field, uint16_t deg, uint16_t *stop_mm, uint16_t *warning_mm)
+{
+    if (deg >= PROTECTIVE_FIELD_DEGREES || stop_mm == NULL || warning_mm == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_protective_field.mutex);
+    if (!g_protective_field.initialized) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    if (field != PROTECTIVE_FIELD_FALLBACK && field >= g_protective_field.field_count) {
+        pthread_mutex_unlock(&g_protective_field.mutex);
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    const protective_field_lut_t *lut =
+        field == PROTECTIVE_FIELD_FALLBACK ? &g_protective_field.fallback : &g_protective_field.luts[field];
+    *stop_mm = lut->stop_mm[deg];
+    *warning_mm = lut->warning_mm[deg];
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t protective_field_get_status(protective_field_status_t *status)
+{
+    if (status == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_protective_field.mutex);
+    status->initialized = g_protective_field.initialized;
+    status->field_count = g_protective_field.field_count;
+    status->active_field = g_protective_field.active_field;
+    status->velocity_valid = g_protective_field.velocity_valid;
+    status->velocity_mm_s = g_protective_field.velocity_mm_s;
+    status->field_switches = g_protective_field.field_switches;
+    status->evaluations = g_protective_field.evaluations;
+    status->stop_violations = g_protective_field.stop_violations;
+    status->warning_violations = g_protective_field.warning_violations;
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return HAL_STATUS_OK;
+}
+
+bool protective_field_is_initialized(void)
+{
+    pthread_mutex_lock(&g_protective_field.mutex);
+    bool initialized = g_protective_field.initialized;
+    pthread_mutex_unlock(&g_protective_field.mutex);
+    return initialized;
+}
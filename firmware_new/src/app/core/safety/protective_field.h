@@ -0,0 +1,191 @@
+/**
+ * @file protective_field.h
+ * @brief Direction- and speed-dependent LiDAR protective fields
+ * @version 1.0.0
+ * @date 2025-02-22
+ * @team FW
+ *
+ * A protective field is a stop boundary and a warning boundary around the
+ * vehicle, given either as per-angle sector distances or as polygons. Each
+ * field applies to one travel direction and a band of speeds, so the stop
+ * area follows the vehicle's braking distance instead of one radius for
+ * all 360 degrees.
+ *
+ * Fields are compiled once into per-degree threshold tables; a frame is
+ * evaluated in one pass over its points. The field in use follows the
+ * velocity given to protective_field_update_motion(): a faster field or a
+ * direction change is taken at once, a slower field only after the speed
+ * has dropped below the active band by a margin for a hold time. While the
+ * velocity is unknown, the per-degree maximum of all fields is used.
+ *
+ * Angles are sensor degrees. Polygons are in mm with x towards 0 degrees
+ * and y towards 90 degrees. mount_offset_deg is the sensor angle that
+ * points in the forward travel direction.
+ */
+
+#ifndef PROTECTIVE_FIELD_H
+#define PROTECTIVE_FIELD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_common.h"
+#include "hal_lidar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROTECTIVE_FIELD_MAX_FIELDS         8
+#define PROTECTIVE_FIELD_MAX_SECTORS        12
+#define PROTECTIVE_FIELD_MAX_VERTICES       16
+#define PROTECTIVE_FIELD_NAME_LEN           16
+#define PROTECTIVE_FIELD_DEGREES            360
+#define PROTECTIVE_FIELD_SPEED_UNBOUNDED    1.0e9f      // max_speed_mm_s of the fastest band
+#define PROTECTIVE_FIELD_FALLBACK           0xFFU       // Active field while the velocity is unknown
+
+// Travel direction a field applies to
+typedef enum {
+    PROTECTIVE_FIELD_DIR_ANY = 0,           // Standstill (and either direction)
+    PROTECTIVE_FIELD_DIR_FORWARD,           // Positive velocity
+    PROTECTIVE_FIELD_DIR_REVERSE            // Negative velocity
+} protective_field_direction_t;
+
+// How a field's boundaries are given
+typedef enum {
+    PROTECTIVE_FIELD_SHAPE_SECTORS = 0,     // Distance table per angle sector
+    PROTECTIVE_FIELD_SHAPE_POLYGON          // Stop and warning polygons
+} protective_field_shape_t;
+
+// Angle sector [start_deg, end_deg) in the travel frame; wraps through 0 when start_deg > end_deg,
+// start_deg == end_deg is the full circle
+typedef struct {
+    uint16_t start_deg;
+    uint16_t end_deg;
+    uint16_t stop_mm;                       // 0 = no stop boundary in this sector
+    uint16_t warning_mm;                    // Raised to stop_mm if smaller
+} protective_field_sector_t;
+
+// Polygon vertex in the travel frame
+typedef struct {
+    int16_t x_mm;
+    int16_t y_mm;
+} protective_field_vertex_t;
+
+// Field definition
+typedef struct {
+    char name[PROTECTIVE_FIELD_NAME_LEN];
+    protective_field_direction_t direction;
+    float min_speed_mm_s;                   // Speed band [min, max) of |velocity|
+    float max_speed_mm_s;
+    protective_field_shape_t shape;
+    uint8_t sector_count;
+    protective_field_sector_t sectors[PROTECTIVE_FIELD_MAX_SECTORS];
+    uint8_t stop_vertex_count;
+    protective_field_vertex_t stop_polygon[PROTECTIVE_FIELD_MAX_VERTICES];
+    uint8_t warning_vertex_count;           // 0 = same as the stop polygon
+    protective_field_vertex_t warning_polygon[PROTECTIVE_FIELD_MAX_VERTICES];
+} protective_field_def_t;
+
+// Field selection options
+typedef struct {
+    float standstill_mm_s;                  // |velocity| below this has no direction
+    float hysteresis_mm_s;                  // Margin below a band before a slower field is taken
+    uint32_t hold_ms;                       // Time a slower field must be requested before it is taken
+    int16_t mount_offset_deg;               // Sensor angle of the forward travel direction
+} protective_field_options_t;
+
+// Result of one frame
+typedef struct {
+    uint8_t field;                          // Field evaluated, or PROTECTIVE_FIELD_FALLBACK
+    bool stop_violated;
+    bool warning_violated;
+    uint16_t stop_points;                   // Returns inside the stop boundary
+    uint16_t warning_points;                // Returns inside the warning boundary
+    uint16_t nearest_mm;                    // Nearest return inside the warning boundary, 0 if none
+    uint16_t nearest_angle_deg;
+} protective_field_result_t;
+
+// Engine status
+typedef struct {
+    bool initialized;
+    uint8_t field_count;
+    uint8_t active_field;                   // Index, or PROTECTIVE_FIELD_FALLBACK
+    bool velocity_valid;
+    float velocity_mm_s;
+    uint32_t field_switches;
+    uint32_t evaluations;
+    uint32_t stop_violations;
+    uint32_t warning_violations;
+} protective_field_status_t;
+
+/**
+ * @brief Initialize the engine with the default field set
+ * @param options Selection options (NULL for defaults)
+ * @return HAL status
+ */
+hal_status_t protective_field_init(const protective_field_options_t *options);
+
+/**
+ * @brief Deinitialize the engine
+ * @return HAL status
+ */
+hal_status_t protective_field_deinit(void);
+
+/**
+ * @brief Replace the field set and compile its threshold tables
+ * @param fields Field definitions, matched in order
+ * @param count Number of fields (1..PROTECTIVE_FIELD_MAX_FIELDS)
+ * @return HAL_STATUS_INVALID_PARAMETER if a definition is malformed; the old set stays active
+ */
+hal_status_t protective_field_set_fields(const protective_field_def_t *fields, uint8_t count);
+
+/**
+ * @brief Restore the default field set
+ * @return HAL status
+ */
+hal_status_t protective_field_load_defaults(void);
+
+/**
+ * @brief Select the field for the current motion
+ * @param velocity_mm_s Travel velocity, positive forward
+ * @param velocity_valid false when the velocity is unknown
+ * @param now_ms Monotonic time in ms
+ * @return HAL status
+ */
+hal_status_t protective_field_update_motion(float velocity_mm_s, bool velocity_valid, uint64_t now_ms);
+
+/**
+ * @brief Evaluate a frame against the active field
+ * @param scan Scan frame
+ * @param result Output
+ * @return HAL status
+ */
+hal_status_t protective_field_evaluate(const lidar_scan_data_t *scan, protective_field_result_t *result);
+
+/**
+ * @brief Compiled thresholds of a field at one sensor degree
+ * @param field Field index, or PROTECTIVE_FIELD_FALLBACK
+ * @param deg Sensor degree (0..359)
+ * @param stop_mm Output stop threshold
+ * @param warning_mm Output warning threshold
+ * @return HAL status
+ */
+hal_status_t protective_field_get_thresholds(uint8_t field, uint16_t deg, uint16_t *stop_mm, uint16_t *warning_mm);
+
+/**
+ * @brief Get engine status
+ * @param status Output
+ * @return HAL status
+ */
+hal_status_t protective_field_get_status(protective_field_status_t *status);
+
+/**
+ * @brief Whether the engine is initialized
+ */
+bool protective_field_is_initialized(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTECTIVE_FIELD_H
@@ -0,0 +1,1878 @@
+/**
+ * @file safety_monitor.c
+ * @brief Safety Monitor Implementation for OHT-50 Master Module
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @team FW
+ * @task FW-01 (Safety Monitor Implementation)
+ */
+
+#include "safety_monitor.h"
+#include "hal_common.h"
+#include "hal_estop.h"
+#include "hal_led.h"
+#include "hal_relay.h"
+#include "hal_lidar_kernels.h"
+// #include "hal_config_persistence.h" - REMOVED (config persistence simplified)
+#include "hal_rs485.h"
+#include "../state_management/system_state_machine.h"
+#include "critical_module_detector.h"
+#include "protective_field.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+// Safety Monitor Instance
+static struct {
+    safety_monitor_config_t config;
+    safety_monitor_status_t status;
+    safety_monitor_stats_t stats;
+    safety_monitor_event_callback_t event_callback;
+    safety_emergency_stop_callback_t estop_callback;
+    
+    // Safety zones
+    safety_zone_config_t zones[MAX_SAFETY_ZONES];
+    uint8_t zone_count;
+    
+    // Safety interlocks
+    safety_interlock_config_t interlocks[MAX_SAFETY_INTERLOCKS];
+    uint8_t interlock_count;
+    
+    // Safety sensors
+    safety_sensor_config_t sensors[MAX_SAFETY_SENSORS];
+    uint8_t sensor_count;
+    
+    // Timing
+    uint64_t last_zone_check;
+    uint64_t last_interlock_check;
+    uint64_t last_sensor_check;
+    uint64_t last_watchdog_check;
+    uint64_t last_estop_check;
+    uint64_t last_critical_module_check;
+    
+    // Protective field result of the last frame
+    protective_field_result_t field_result;
+    bool field_result_valid;
+    
+    // LiDAR decisions: motion input and the last revolution decided
+    safety_velocity_source_t velocity_source;
+    uint64_t last_lidar_frame_us;
+    
+    // State
+    bool initialized;
+    bool estop_shared;              // E-Stop HAL was initialized by the application
+    bool estop_hardware_active;
+    bool estop_software_active;
+    
+    // Error handling
+    uint32_t error_count;
+    uint64_t last_error_time;
+    char last_error_message[256];
+    safety_fault_code_t last_fault;
+    uint32_t last_estop_latency_ms;
+} safety_monitor_instance = {0};
+
+// Constants
+#define MAX_SAFETY_ZONES 8
+#define MAX_SAFETY_INTERLOCKS 16
+#define MAX_SAFETY_SENSORS 32
+#define SAFETY_MONITOR_VERSION "1.0.0"
+
+// Default configuration
+static const safety_monitor_config_t default_config = {
+    .update_period_ms = 10,           // 10ms update period
+    .estop_timeout_ms = 100,          // 100ms E-Stop timeout
+    .zone_check_period_ms = 50,       // 50ms zone check
+    .interlock_check_period_ms = 20,  // 20ms interlock check
+    .sensor_check_period_ms = 100,    // 100ms sensor check
+    .watchdog_timeout_ms = 1000,      // 1s watchdog timeout
+    .enable_zone_monitoring = true,
+    .enable_interlock_monitoring = true,
+    .enable_sensor_monitoring = true,
+    .enable_watchdog_monitoring = true,
+    .enable_emergency_procedures = true,
+    .max_retry_count = 3,
+    .retry_delay_ms = 10
+};
+
+// LiDAR decisions come from the pipeline's SCHED_FIFO safety worker and the
+// main loop; priority inheritance keeps a main-loop holder from stalling the worker
+static pthread_mutex_t safety_monitor_lidar_mutex;
+static pthread_once_t safety_monitor_lidar_mutex_once = PTHREAD_ONCE_INIT;
+
+static void safety_monitor_lidar_mutex_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&safety_monitor_lidar_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+static void safety_monitor_lidar_lock(void)
+{
+    (void)pthread_once(&safety_monitor_lidar_mutex_once, safety_monitor_lidar_mutex_init);
+    pthread_mutex_lock(&safety_monitor_lidar_mutex);
+}
+
+static void safety_monitor_lidar_unlock(void)
+{
+    pthread_mutex_unlock(&safety_monitor_lidar_mutex);
+}
+
+// Internal function prototypes
+static hal_status_t safety_monitor_check_estop(void);
+static hal_status_t safety_monitor_check_zones(void);
+static hal_status_t safety_monitor_check_interlocks(void);
+static hal_status_t safety_monitor_check_sensors(void);
+static hal_status_t safety_monitor_check_watchdog(void);
+static hal_status_t safety_monitor_transition_state(safety_monitor_state_t new_state);
+static hal_status_t safety_monitor_handle_estop_event(void);
+static hal_status_t safety_monitor_handle_zone_violation(void);
+static hal_status_t safety_monitor_handle_interlock_open(void);
+static hal_status_t safety_monitor_handle_sensor_fault(void);
+static hal_status_t safety_monitor_handle_communication_lost(void);
+static hal_status_t safety_monitor_handle_watchdog_timeout(void);
+static hal_status_t safety_monitor_execute_emergency_procedures(const char* reason);
+static void safety_monitor_log_event(safety_monitor_event_t event, const char* details);
+
+// Forward declarations for LED pattern functions
+static hal_status_t safety_monitor_set_safe_led_pattern(void);
+static hal_status_t safety_monitor_set_warning_led_pattern(void);
+static hal_status_t safety_monitor_set_critical_led_pattern(void);
+static hal_status_t safety_monitor_set_estop_led_pattern(void);
+static hal_status_t safety_monitor_set_fault_led_pattern(void);
+
+// Implementation
+
+hal_status_t safety_monitor_init(const safety_monitor_config_t *config)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    // Check if already initialized
+    if (safety_monitor_instance.initialized) {
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+    
+    // Initialize instance
+    memset(&safety_monitor_instance, 0, sizeof(safety_monitor_instance));
+    
+    // Set configuration
+    if (config != NULL) {
+        safety_monitor_instance.config = *config;
+    } else {
+        safety_monitor_instance.config = default_config;
+    }
+    
+    // Initialize HAL components; an E-Stop the application already set up is shared
+    estop_status_t estop_status;
+    safety_monitor_instance.estop_shared = (hal_estop_get_status(&estop_status) == HAL_STATUS_OK);
+    estop_config_t estop_config = {
+        .pin = 0,                           // Default E-Stop pin
+        .response_timeout_ms = 100,         // 100ms response timeout
+        .debounce_time_ms = 20,            // 20ms debounce (>= 10ms required)
+        .auto_reset_enabled = false        // Manual reset required
+    };
+    status = safety_monitor_instance.estop_shared ? HAL_STATUS_OK : hal_estop_init(&estop_config);
+    if (status != HAL_STATUS_OK) {
+        safety_monitor_instance.last_error_time = hal_time_now_ms();
+        strncpy(safety_monitor_instance.last_error_message, "E-Stop HAL init failed", sizeof(safety_monitor_instance.last_error_message) - 1);
+        return status;
+    }
+    
+    status = hal_led_init();
+    if (status != HAL_STATUS_OK) {
+        // Headless mode for unit tests / environments without GPIO access
+        printf("[SAFETY] LED HAL init failed (%d) - running in headless mode, continuing without LEDs\n", status);
+        // Do not return; proceed with limited functionality
+    }
+    
+    relay_config_t relay_config = {0};
+    status = hal_relay_init(&relay_config);
+    if (status != HAL_STATUS_OK) {
+        // Headless mode: continue even if relay init fails in test env
+        printf("[SAFETY] Relay HAL init failed (%d) - running in headless mode, continuing without relays\n", status);
+        // Do not return; proceed with limited functionality
+    }
+    
+    // Initialize status
+    safety_monitor_instance.status.current_state = SAFETY_MONITOR_STATE_INIT;
+    safety_monitor_instance.status.previous_state = SAFETY_MONITOR_STATE_INIT;
+    safety_monitor_instance.status.last_event = SAFETY_MONITOR_EVENT_NONE;
+    safety_monitor_instance.status.state_entry_time = hal_time_now_ms();
+    safety_monitor_instance.status.last_update_time = hal_time_now_ms();
+    
+    // Initialize basic safety zones with default values
+    safety_monitor_instance.status.safety_zones.emergency_zone_mm = 500;
+    safety_monitor_instance.status.safety_zones.warning_zone_mm = 1000;
+    safety_monitor_instance.status.safety_zones.safe_zone_mm = 2000;
+    safety_monitor_instance.status.safety_zones.emergency_violated = false;
+    safety_monitor_instance.status.safety_zones.warning_violated = false;
+    safety_monitor_instance.status.safety_zones.safe_violated = false;
+    safety_monitor_instance.status.safety_zones.min_distance_mm = 0;
+    safety_monitor_instance.status.safety_zones.min_distance_angle = 0;
+    safety_monitor_instance.status.safety_zones.last_violation_time = 0;
+    safety_monitor_instance.status.safety_zones.enabled = true;
+    
+    // Direction- and speed-dependent fields; the scalar zones above remain the fallback
+    status = protective_field_init(NULL);
+    if (status != HAL_STATUS_OK && status != HAL_STATUS_ALREADY_INITIALIZED) {
+        printf("[SAFETY] Protective fields unavailable (%d) - using basic zones\n", status);
+    }
+    
+    // Initialize timing
+    safety_monitor_instance.last_zone_check = hal_time_now_ms();
+    safety_monitor_instance.last_interlock_check = hal_time_now_ms();
+    safety_monitor_instance.last_sensor_check = hal_time_now_ms();
+    safety_monitor_instance.last_watchdog_check = hal_time_now_ms();
+    safety_monitor_instance.last_estop_check = hal_time_now_ms();
+    
+    // Set initialized flag
+    safety_monitor_instance.initialized = true;
+    safety_monitor_instance.last_fault = SAFETY_FAULT_CODE_ESTOP; // Default to E-Stop fault
+    safety_monitor_instance.last_estop_latency_ms = 0;
+    
+    // Set initial LED pattern for safe state
+    safety_monitor_set_safe_led_pattern();
+    
+    // Load configuration from persistent storage
+    hal_status_t config_status = safety_monitor_load_config();
+    if (config_status != HAL_STATUS_OK) {
+        printf("[SAFETY] Warning: Failed to load configuration, using defaults\n");
+    }
+    
+    // Log initialization
+    safety_monitor_log_event(SAFETY_MONITOR_EVENT_NONE, "Safety monitor initialized");
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_deinit(void)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Execute emergency procedures if needed
+    if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_ESTOP ||
+        safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_CRITICAL) {
+        safety_monitor_execute_emergency_procedures("Safety monitor deinit");
+    }
+    
+    // Deinitialize HAL components
+    if (!safety_monitor_instance.estop_shared) {
+        hal_estop_deinit();
+    }
+    hal_led_deinit();
+    hal_relay_deinit();
+    protective_field_deinit();
+    
+    // Clear instance
+    safety_monitor_lidar_lock();
+    memset(&safety_monitor_instance, 0, sizeof(safety_monitor_instance));
+    safety_monitor_lidar_unlock();
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_update(void)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    uint64_t current_time = hal_time_now_ms();
+    
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Update last update time
+    safety_monitor_instance.status.last_update_time = current_time;
+    
+    // OPTIMIZATION: Batch check all safety conditions with early exit
+    bool estop_check_needed = (current_time - safety_monitor_instance.last_estop_check >= safety_monitor_instance.config.estop_timeout_ms);
+    bool zone_check_needed = safety_monitor_instance.config.enable_zone_monitoring && 
+                            (current_time - safety_monitor_instance.last_zone_check >= safety_monitor_instance.config.zone_check_period_ms);
+    bool interlock_check_needed = safety_monitor_instance.config.enable_interlock_monitoring && 
+                                 (current_time - safety_monitor_instance.last_interlock_check >= safety_monitor_instance.config.interlock_check_period_ms);
+    bool sensor_check_needed = safety_monitor_instance.config.enable_sensor_monitoring && 
+                              (current_time - safety_monitor_instance.last_sensor_check >= safety_monitor_instance.config.sensor_check_period_ms);
+    bool watchdog_check_needed = safety_monitor_instance.config.enable_watchdog_monitoring && 
+                                (current_time - safety_monitor_instance.last_watchdog_check >= safety_monitor_instance.config.watchdog_timeout_ms);
+    bool module_check_needed = (current_time - safety_monitor_instance.last_critical_module_check >= 100); // 100ms interval
+    
+    // Check E-Stop (highest priority) - always check if needed
+    if (estop_check_needed) {
+        status = safety_monitor_check_estop();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+            // Early exit on E-Stop failure
+            safety_monitor_instance.last_estop_check = current_time;
+            goto update_statistics;
+        }
+        safety_monitor_instance.last_estop_check = current_time;
+    }
+    
+    // OPTIMIZATION: Only check other conditions if E-Stop is OK
+    if (zone_check_needed) {
+        status = safety_monitor_check_zones();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_zone_check = current_time;
+    }
+    
+    if (interlock_check_needed) {
+        status = safety_monitor_check_interlocks();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_interlock_check = current_time;
+    }
+    
+    if (sensor_check_needed) {
+        status = safety_monitor_check_sensors();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_sensor_check = current_time;
+    }
+    
+    if (watchdog_check_needed) {
+        status = safety_monitor_check_watchdog();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_watchdog_check = current_time;
+    }
+    
+    // Check critical module health (added in Phase 2.2)
+    if (module_check_needed) {
+        hal_status_t module_status = critical_module_safety_monitor_integration();
+        if (module_status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_critical_module_check = current_time;
+    }
+    
+update_statistics:
+    // OPTIMIZATION: Update statistics only when needed
+    safety_monitor_instance.stats.total_uptime_ms = current_time - safety_monitor_instance.status.state_entry_time;
+    if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE) {
+        safety_monitor_instance.stats.safe_uptime_ms = current_time - safety_monitor_instance.status.last_safe_time;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_update_with_lidar(const lidar_scan_data_t *scan_data)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    uint64_t current_time = hal_time_now_ms();
+    
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (!scan_data) {
+        // Fall back to regular update if no LiDAR data
+        return safety_monitor_update();
+    }
+    
+    // Update last update time
+    safety_monitor_instance.status.last_update_time = current_time;
+    
+    // Check E-Stop (highest priority)
+    if (current_time - safety_monitor_instance.last_estop_check >= safety_monitor_instance.config.estop_timeout_ms) {
+        status = safety_monitor_check_estop();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_estop_check = current_time;
+    }
+    
+    // Check LiDAR health before using scan data
+    hal_status_t lidar_health_status = hal_lidar_health_check();
+    if (lidar_health_status != HAL_STATUS_OK) {
+        printf("[SAFETY] LiDAR health check failed during update: %d\n", lidar_health_status);
+        safety_monitor_instance.error_count++;
+        safety_monitor_instance.last_error_time = current_time;
+        // Continue with fallback safety checks
+    }
+    
+    // Check safety zones with LiDAR data (only if LiDAR is healthy)
+    if (safety_monitor_instance.config.enable_zone_monitoring &&
+        current_time - safety_monitor_instance.last_zone_check >= safety_monitor_instance.config.zone_check_period_ms &&
+        lidar_health_status == HAL_STATUS_OK) {
+        status = safety_monitor_check_basic_zones(scan_data);
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_zone_check = current_time;
+    }
+    
+    // Check safety interlocks
+    if (safety_monitor_instance.config.enable_interlock_monitoring &&
+        current_time - safety_monitor_instance.last_interlock_check >= safety_monitor_instance.config.interlock_check_period_ms) {
+        status = safety_monitor_check_interlocks();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_interlock_check = current_time;
+    }
+    
+    // Check safety sensors
+    if (safety_monitor_instance.config.enable_sensor_monitoring &&
+        current_time - safety_monitor_instance.last_sensor_check >= safety_monitor_instance.config.sensor_check_period_ms) {
+        status = safety_monitor_check_sensors();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_sensor_check = current_time;
+    }
+    
+    // Check watchdog
+    if (safety_monitor_instance.config.enable_watchdog_monitoring &&
+        current_time - safety_monitor_instance.last_watchdog_check >= safety_monitor_instance.config.watchdog_timeout_ms) {
+        status = safety_monitor_check_watchdog();
+        if (status != HAL_STATUS_OK) {
+            safety_monitor_instance.error_count++;
+            safety_monitor_instance.last_error_time = current_time;
+        }
+        safety_monitor_instance.last_watchdog_check = current_time;
+    }
+    
+    // Update statistics
+    safety_monitor_instance.stats.total_uptime_ms = current_time - safety_monitor_instance.status.state_entry_time;
+    if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE) {
+        safety_monitor_instance.stats.safe_uptime_ms = current_time - safety_monitor_instance.status.last_safe_time;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_process_event(safety_monitor_event_t event, const char* details)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Log event
+    safety_monitor_log_event(event, details);
+    
+    // Update statistics
+    safety_monitor_instance.stats.total_events++;
+    
+    // Process event based on type
+    switch (event) {
+        case SAFETY_MONITOR_EVENT_ESTOP_TRIGGERED:
+            status = safety_monitor_handle_estop_event();
+            safety_monitor_instance.stats.estop_events++;
+            break;
+            
+        case SAFETY_MONITOR_EVENT_ZONE_VIOLATION:
+            status = safety_monitor_handle_zone_violation();
+            safety_monitor_instance.stats.zone_violations++;
+            break;
+            
+        case SAFETY_MONITOR_EVENT_INTERLOCK_OPEN:
+            status = safety_monitor_handle_interlock_open();
+            safety_monitor_instance.stats.interlock_opens++;
+            break;
+            
+        case SAFETY_MONITOR_EVENT_SENSOR_FAULT:
+            status = safety_monitor_handle_sensor_fault();
+            safety_monitor_instance.stats.sensor_faults++;
+            break;
+            
+        case SAFETY_MONITOR_EVENT_COMMUNICATION_LOST:
+            status = safety_monitor_handle_communication_lost();
+            safety_monitor_instance.stats.communication_failures++;
+            break;
+            
+        case SAFETY_MONITOR_EVENT_WATCHDOG_TIMEOUT:
+            status = safety_monitor_handle_watchdog_timeout();
+            safety_monitor_instance.stats.watchdog_timeouts++;
+            break;
+            
+        case SAFETY_MONITOR_EVENT_EMERGENCY_STOP:
+            status = safety_monitor_trigger_emergency_stop(details);
+            break;
+            
+        case SAFETY_MONITOR_EVENT_SAFETY_RESET:
+            status = safety_monitor_reset();
+            break;
+            
+        default:
+            // Unknown event - log but don't change state
+            break;
+    }
+    
+    // Update last event
+    safety_monitor_instance.status.last_event = event;
+    
+    return status;
+}
+
+hal_status_t safety_monitor_get_status(safety_monitor_status_t *status)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (status == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *status = safety_monitor_instance.status;
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_get_stats(safety_monitor_stats_t *stats)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *stats = safety_monitor_instance.stats;
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_is_safe(bool *safe)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (safe == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *safe = (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE);
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_trigger_lidar_emergency_stop(const lidar_scan_data_t *scan_data, const char* reason)
+{
+    if (!safety_monitor_instance.initialized || !scan_data) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    // Calculate minimum distance from LiDAR
+    uint16_t min_distance = lidar_calculate_min_distance(scan_data);
+    
+    // Create detailed reason with LiDAR data
+    char detailed_reason[256];
+    snprintf(detailed_reason, sizeof(detailed_reason), 
+             "%s (LiDAR min_distance=%dmm)", 
+             reason ? reason : "LiDAR emergency stop", 
+             min_distance);
+    
+    printf("[SAFETY] LiDAR Emergency Stop: %s\n", detailed_reason);
+    
+    // Trigger emergency stop
+    hal_status_t status = safety_monitor_trigger_emergency_stop(detailed_reason);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Log LiDAR-specific emergency event
+    safety_monitor_log_event(SAFETY_MONITOR_EVENT_EMERGENCY_STOP, detailed_reason);
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_trigger_emergency_stop(const char* reason)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Latch the stop first: a failed LED or relay output must not cancel it
+    safety_monitor_instance.estop_software_active = true;
+    
+    // Execute emergency procedures
+    hal_status_t procedures_status = safety_monitor_execute_emergency_procedures(reason);
+    if (procedures_status != HAL_STATUS_OK) {
+        safety_monitor_instance.error_count++;
+        safety_monitor_instance.last_error_time = hal_time_now_ms();
+    }
+    
+    // Transition to E-Stop state
+    status = safety_monitor_transition_state(SAFETY_MONITOR_STATE_ESTOP);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Log event
+    safety_monitor_log_event(SAFETY_MONITOR_EVENT_EMERGENCY_STOP, reason);
+    
+    return procedures_status;
+}
+
+hal_status_t safety_monitor_reset(void)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Check if reset is allowed
+    if (safety_monitor_instance.estop_hardware_active) {
+        return HAL_STATUS_ERROR;
+    }
+    
+    // Clear software E-Stop
+    safety_monitor_instance.estop_software_active = false;
+    
+    // Reset safety flags
+    safety_monitor_instance.status.zone_violation = false;
+    safety_monitor_instance.status.interlock_open = false;
+    safety_monitor_instance.status.sensor_fault = false;
+    safety_monitor_instance.status.communication_ok = true;
+    safety_monitor_instance.status.watchdog_ok = true;
+    
+    // Transition to safe state
+    status = safety_monitor_transition_state(SAFETY_MONITOR_STATE_SAFE);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Update last safe time
+    safety_monitor_instance.status.last_safe_time = hal_time_now_ms();
+    
+    // Increment recovery count
+    safety_monitor_instance.stats.recovery_count++;
+    
+    // Log event
+    safety_monitor_log_event(SAFETY_MONITOR_EVENT_SAFETY_RESET, "Safety system reset");
+    
+    return HAL_STATUS_OK;
+}
+
+// Internal functions
+
+static hal_status_t safety_monitor_check_estop(void)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    // Check hardware E-Stop
+    estop_status_t estop_status;
+    status = hal_estop_get_status(&estop_status);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Update hardware E-Stop state
+    bool estop_active = (estop_status.state == ESTOP_STATE_TRIGGERED);
+    safety_monitor_instance.estop_hardware_active = estop_active;
+    
+    // Check for E-Stop activation
+    if (estop_active && !safety_monitor_instance.estop_software_active) {
+        safety_monitor_process_event(SAFETY_MONITOR_EVENT_ESTOP_TRIGGERED, "Hardware E-Stop activated");
+        safety_monitor_handle_estop_event();
+    }
+    
+    // Check for E-Stop reset
+    if (!estop_active && safety_monitor_instance.estop_hardware_active) {
+        safety_monitor_process_event(SAFETY_MONITOR_EVENT_ESTOP_RESET, "Hardware E-Stop reset");
+        
+        // Clear hardware E-Stop flag
+        safety_monitor_instance.estop_hardware_active = false;
+        
+        // If software E-Stop is also clear, transition to safe state
+        if (!safety_monitor_instance.estop_software_active) {
+            safety_monitor_transition_state(SAFETY_MONITOR_STATE_SAFE);
+            hal_led_system_set(LED_STATE_ON); // Green LED solid
+        }
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_check_zones(void)
+{
+    // OPTIMIZATION: Early exit if no zones configured
+    if (safety_monitor_instance.zone_count == 0) {
+        return HAL_STATUS_OK;
+    }
+    
+    // OPTIMIZATION: Use static buffer to avoid stack allocation
+    static uint8_t zone_status_buffer[MAX_SAFETY_ZONES];
+    (void)zone_status_buffer; // Suppress unused warning
+    uint8_t violation_count = 0;
+    
+    // Check each configured safety zone with optimized logic
+    for (uint8_t i = 0; i < safety_monitor_instance.zone_count; i++) {
+        safety_zone_config_t *zone = &safety_monitor_instance.zones[i];
+        
+        if (!zone->enabled) {
+            zone_status_buffer[i] = 0;
+            continue;
+        }
+        
+        // OPTIMIZATION: Direct zone violation check without switch statement
+        bool zone_violated = false;
+        
+        // Use existing zone violation status for danger and emergency zones
+        if (zone->zone_type == SAFETY_ZONE_DANGER || zone->zone_type == SAFETY_ZONE_EMERGENCY) {
+            zone_violated = safety_monitor_instance.status.zone_violation;
+        }
+        // For operational and restricted zones, use placeholder logic
+        else if (zone->zone_type == SAFETY_ZONE_OPERATIONAL || zone->zone_type == SAFETY_ZONE_RESTRICTED) {
+            zone_violated = false; // Placeholder for future implementation
+        }
+        
+        zone_status_buffer[i] = zone_violated ? 1 : 0;
+        if (zone_violated) {
+            violation_count++;
+        }
+    }
+    
+    // OPTIMIZATION: Batch update statistics
+    if (violation_count > 0) {
+        safety_monitor_instance.stats.zone_violations += violation_count;
+        safety_monitor_instance.status.zone_violation = true;
+    } else {
+        safety_monitor_instance.status.zone_violation = false;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_check_basic_zones(const lidar_scan_data_t *scan_data)
+{
+    if (!safety_monitor_instance.initialized || !scan_data) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    if (!safety_monitor_instance.status.safety_zones.enabled) {
+        return HAL_STATUS_OK;
+    }
+    
+    // OPTIMIZATION: Vectorised minimum over the distance array (points without a return are skipped)
+    lidar_kernel_extremes_t extremes;
+    lidar_kernel_extremes(scan_data->distance_mm, scan_data->point_count, &extremes);
+    uint16_t min_distance = extremes.min_mm;
+    uint16_t min_angle = lidar_angle_q6_to_deg(scan_data->angle_q6[extremes.min_index]);
+    
+    // OPTIMIZATION: Use fallback if no valid points
+    if (min_distance == UINT16_MAX) {
+        min_distance = 0;
+    }
+    
+    // Update safety zones status
+    safety_monitor_instance.status.safety_zones.min_distance_mm = min_distance;
+    safety_monitor_instance.status.safety_zones.min_distance_angle = min_angle;
+    
+    // OPTIMIZATION: Batch zone violation checks
+    uint16_t emergency_zone = safety_monitor_instance.status.safety_zones.emergency_zone_mm;
+    uint16_t warning_zone = safety_monitor_instance.status.safety_zones.warning_zone_mm;
+    uint16_t safe_zone = safety_monitor_instance.status.safety_zones.safe_zone_mm;
+    
+    bool emergency_violated = (min_distance < emergency_zone);
+    bool warning_violated = (min_distance < warning_zone);
+    bool safe_violated = (min_distance < safe_zone);
+    
+    // Stop and warning follow the protective field for the current motion when available
+    protective_field_result_t *field_result = &safety_monitor_instance.field_result;
+    safety_monitor_instance.field_result_valid =
+        protective_field_is_initialized() && protective_field_evaluate(scan_data, field_result) == HAL_STATUS_OK;
+    if (safety_monitor_instance.field_result_valid) {
+        emergency_violated = field_result->stop_violated;
+        warning_violated = field_result->warning_violated;
+    }
+    
+    // Update violation status
+    safety_monitor_instance.status.safety_zones.emergency_violated = emergency_violated;
+    safety_monitor_instance.status.safety_zones.warning_violated = warning_violated;
+    safety_monitor_instance.status.safety_zones.safe_violated = safe_violated;
+    
+    // OPTIMIZATION: Single boolean operation for overall violation
+    bool any_violation = emergency_violated || warning_violated || safe_violated;
+    safety_monitor_instance.status.zone_violation = any_violation;
+    
+    // Handle zone violations
+    if (any_violation) {
+        safety_monitor_instance.status.safety_zones.last_violation_time = hal_time_now_ms();
+        safety_monitor_instance.stats.zone_violations++;
+        
+        // Call violation handling function
+        safety_monitor_handle_zone_violation();
+    } else {
+        // No violations - clear zone violation status
+        safety_monitor_instance.status.zone_violation = false;
+        
+        // If we were in warning state and now safe, transition back to safe
+        if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_WARNING) {
+            safety_monitor_transition_state(SAFETY_MONITOR_STATE_SAFE);
+            safety_monitor_set_safe_led_pattern();
+        }
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_velocity_source(safety_velocity_source_t source)
+{
+    safety_monitor_lidar_lock();
+    if (!safety_monitor_instance.initialized) {
+        safety_monitor_lidar_unlock();
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    safety_monitor_instance.velocity_source = source;
+    safety_monitor_lidar_unlock();
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_lidar_handler(void *ctx, const lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    
+    if (scan == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    safety_monitor_lidar_lock();
+    if (!safety_monitor_instance.initialized) {
+        safety_monitor_lidar_unlock();
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Already decided by the other caller
+    uint64_t frame_us = scan->base_timestamp_us;
+    if (frame_us != 0 && frame_us == safety_monitor_instance.last_lidar_frame_us) {
+        safety_monitor_lidar_unlock();
+        return HAL_STATUS_OK;
+    }
+    
+    // Select the protective field for the current motion (unknown velocity: all fields)
+    float velocity_mm_s = 0.0f;
+    bool velocity_valid = safety_monitor_instance.velocity_source != NULL &&
+                          safety_monitor_instance.velocity_source(&velocity_mm_s) == HAL_STATUS_OK;
+    (void)protective_field_update_motion(velocity_mm_s, velocity_valid, hal_time_now_ms());
+    
+    hal_status_t status = HAL_STATUS_OK;
+    if (scan->scan_complete) {
+        status = safety_monitor_check_basic_zones(scan);
+        if (status != HAL_STATUS_OK) {
+            // No zone decision for this revolution: stop instead
+            char reason[64];
+            snprintf(reason, sizeof(reason), "LiDAR zone check failed (%d)", status);
+            safety_monitor_instance.last_fault = SAFETY_FAULT_CODE_SENSOR;
+            (void)safety_monitor_trigger_emergency_stop(reason);
+            // The stop is latched even when an LED or relay output failed
+            if (safety_monitor_instance.estop_software_active) {
+                status = HAL_STATUS_OK;
+            }
+        }
+        if (status == HAL_STATUS_OK) {
+            safety_monitor_instance.last_lidar_frame_us = frame_us;
+        }
+    }
+    safety_monitor_lidar_unlock();
+    
+    return status;
+}
+
+static hal_status_t safety_monitor_check_interlocks(void)
+{
+    // Check each configured safety interlock
+    for (uint8_t i = 0; i < safety_monitor_instance.interlock_count; i++) {
+        safety_interlock_config_t *interlock = &safety_monitor_instance.interlocks[i];
+        
+        if (!interlock->enabled) {
+            continue;
+        }
+        
+        // Check interlock status based on type
+        bool interlock_active = false;
+        switch (interlock->interlock_type) {
+            case SAFETY_INTERLOCK_DOOR:
+                // Check door sensor status
+                interlock_active = false; // Placeholder - would read GPIO
+                break;
+                
+            case SAFETY_INTERLOCK_LIGHT_CURTAIN:
+                // Check light curtain interruption
+                interlock_active = false; // Placeholder - would read sensor
+                break;
+                
+            case SAFETY_INTERLOCK_EMERGENCY_STOP:
+                // Check emergency button status
+                interlock_active = false; // Placeholder - would read E-Stop
+                break;
+                
+            case SAFETY_INTERLOCK_SENSOR:
+                // Check safety sensor interlock
+                interlock_active = false; // Placeholder - would read sensor
+                break;
+                
+            default:
+                interlock_active = false;
+                break;
+        }
+        
+        // Log interlock activation if detected
+        if (interlock_active) {
+            safety_monitor_log_event(SAFETY_MONITOR_EVENT_INTERLOCK_OPEN, 
+                                   "Interlock activated");
+        }
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_check_sensors(void)
+{
+    // Check each configured safety sensor
+    for (uint8_t i = 0; i < safety_monitor_instance.sensor_count; i++) {
+        safety_sensor_config_t *sensor = &safety_monitor_instance.sensors[i];
+        
+        if (!sensor->enabled) {
+            continue;
+        }
+        
+        // Check sensor status based on type
+        bool sensor_fault = false;
+        switch (sensor->sensor_type) {
+            case SAFETY_SENSOR_PROXIMITY:
+                // Check proximity sensor status
+                sensor_fault = false; // Placeholder - would read sensor value
+                break;
+                
+            case SAFETY_SENSOR_PRESSURE:
+                // Check pressure sensor readings
+                sensor_fault = false; // Placeholder - would read sensor value
+                break;
+                
+            case SAFETY_SENSOR_TEMPERATURE:
+                // Check temperature sensor readings
+                sensor_fault = false; // Placeholder - would read sensor value
+                break;
+                
+            case SAFETY_SENSOR_LIDAR: {
+                // LiDAR sensor health check
+                hal_status_t lidar_health_status = hal_lidar_health_check();
+                if (lidar_health_status != HAL_STATUS_OK) {
+                    sensor_fault = true;
+                    printf("[SAFETY] LiDAR health check failed: %d\n", lidar_health_status);
+                } else {
+                    sensor_fault = false;
+                }
+                break;
+            }
+                
+            case SAFETY_SENSOR_CAMERA:
+                // Camera sensor health check
+                sensor_fault = false; // Placeholder - would check camera health
+                break;
+                
+            default:
+                sensor_fault = false;
+                break;
+        }
+        
+        // Log sensor fault if detected
+        if (sensor_fault) {
+            safety_monitor_log_event(SAFETY_MONITOR_EVENT_SENSOR_FAULT, 
+                                   "Sensor fault detected");
+        }
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_check_watchdog(void)
+{
+    uint64_t current_time = hal_time_now_ms();
+    
+    // Check if watchdog is enabled via watchdog_timeout_ms > 0
+    if (safety_monitor_instance.config.watchdog_timeout_ms == 0) {
+        return HAL_STATUS_OK;
+    }
+    
+    // Check watchdog timeout - basic implementation
+    // For now, we just check if we have been running and update watchdog OK status
+    safety_monitor_instance.status.watchdog_ok = true;
+    
+    // Log watchdog status periodically
+    static uint64_t last_watchdog_log = 0;
+    if (current_time - last_watchdog_log > 60000) { // Log every 60 seconds
+        safety_monitor_log_event(SAFETY_MONITOR_EVENT_WATCHDOG_TIMEOUT, 
+                               "Watchdog check OK");
+        last_watchdog_log = current_time;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_transition_state(safety_monitor_state_t new_state)
+{
+    safety_monitor_state_t old_state = safety_monitor_instance.status.current_state;
+    
+    // Validate state transition
+    switch (old_state) {
+        case SAFETY_MONITOR_STATE_INIT:
+            if (new_state != SAFETY_MONITOR_STATE_SAFE && 
+                new_state != SAFETY_MONITOR_STATE_FAULT &&
+                new_state != SAFETY_MONITOR_STATE_ESTOP) {
+                return HAL_STATUS_INVALID_STATE;
+            }
+            break;
+            
+        case SAFETY_MONITOR_STATE_SAFE:
+            // Can transition to any state
+            break;
+            
+        case SAFETY_MONITOR_STATE_WARNING:
+            if (new_state == SAFETY_MONITOR_STATE_INIT) {
+                return HAL_STATUS_INVALID_STATE;
+            }
+            break;
+            
+        case SAFETY_MONITOR_STATE_CRITICAL:
+            if (new_state == SAFETY_MONITOR_STATE_INIT || 
+                new_state == SAFETY_MONITOR_STATE_SAFE) {
+                return HAL_STATUS_INVALID_STATE;
+            }
+            break;
+            
+        case SAFETY_MONITOR_STATE_ESTOP:
+            if (new_state == SAFETY_MONITOR_STATE_INIT || 
+                new_state == SAFETY_MONITOR_STATE_SAFE) {
+                return HAL_STATUS_INVALID_STATE;
+            }
+            break;
+            
+        case SAFETY_MONITOR_STATE_FAULT:
+            if (new_state == SAFETY_MONITOR_STATE_INIT) {
+                return HAL_STATUS_INVALID_STATE;
+            }
+            break;
+            
+        default:
+            return HAL_STATUS_INVALID_STATE;
+    }
+    
+    // Update state
+    safety_monitor_instance.status.previous_state = old_state;
+    safety_monitor_instance.status.current_state = new_state;
+    safety_monitor_instance.status.state_entry_time = hal_time_now_ms();
+    safety_monitor_instance.status.state_transition_count++;
+    
+    // Set LED pattern based on new state
+    switch (new_state) {
+        case SAFETY_MONITOR_STATE_SAFE:
+            safety_monitor_set_safe_led_pattern();
+            break;
+        case SAFETY_MONITOR_STATE_WARNING:
+            safety_monitor_set_warning_led_pattern();
+            break;
+        case SAFETY_MONITOR_STATE_CRITICAL:
+            safety_monitor_set_critical_led_pattern();
+            break;
+        case SAFETY_MONITOR_STATE_ESTOP:
+            safety_monitor_set_estop_led_pattern();
+            break;
+        case SAFETY_MONITOR_STATE_FAULT:
+            safety_monitor_set_fault_led_pattern();
+            break;
+        default:
+            // No LED pattern for INIT state
+            break;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_handle_estop_event(void)
+{
+    printf("[SAFETY] E-Stop event triggered\n");
+    // Measure approximate latency from last check to now
+    uint64_t now_ms = hal_time_now_ms();
+    uint32_t latency_ms = (uint32_t)(now_ms - safety_monitor_instance.last_estop_check);
+    safety_monitor_instance.last_estop_latency_ms = latency_ms;
+    safety_monitor_instance.last_fault = SAFETY_FAULT_CODE_ESTOP;
+    
+    // Set LED pattern for E-Stop state
+    hal_led_system_error(); // Red LED blinking
+    hal_led_power_set(LED_STATE_ON); // Power LED solid
+    hal_led_system_set(LED_STATE_OFF); // System LED off
+    hal_led_comm_set(LED_STATE_OFF); // Comm LED off
+    hal_led_network_set(LED_STATE_OFF); // Network LED off
+    
+    return safety_monitor_transition_state(SAFETY_MONITOR_STATE_ESTOP);
+}
+
+static hal_status_t safety_monitor_handle_emergency_stop(const char* reason) __attribute__((unused));
+static hal_status_t safety_monitor_handle_emergency_stop(const char* reason)
+{
+    printf("[SAFETY] Emergency stop triggered: %s\n", reason ? reason : "Unknown");
+    
+    // Trigger software E-Stop
+    safety_monitor_instance.estop_software_active = true;
+    
+    // Set LED pattern for emergency stop state
+    hal_led_system_error(); // Red LED blinking
+    hal_led_power_set(LED_STATE_ON); // Power LED solid
+    hal_led_system_set(LED_STATE_OFF); // System LED off
+    hal_led_comm_set(LED_STATE_OFF); // Comm LED off
+    hal_led_network_set(LED_STATE_OFF); // Network LED off
+    
+    // Transition to E-Stop state
+    hal_status_t status = safety_monitor_transition_state(SAFETY_MONITOR_STATE_ESTOP);
+    
+    // Log emergency event
+    safety_monitor_log_event(SAFETY_MONITOR_EVENT_EMERGENCY_STOP, reason);
+    
+    return status;
+}
+
+static hal_status_t safety_monitor_handle_zone_violation(void)
+{
+    safety_monitor_instance.status.zone_violation = true;
+    safety_monitor_instance.status.violation_count++;
+    
+    // Get current safety zones status
+    const basic_safety_zones_t *zones = &safety_monitor_instance.status.safety_zones;
+    
+    // Handle different zone violations based on severity
+    const protective_field_result_t *field = safety_monitor_instance.field_result_valid ? 
+                                              &safety_monitor_instance.field_result : NULL;
+    
+    if (zones->emergency_violated) {
+        // Emergency zone violated - most critical
+        char emergency_reason[128];
+        if (field != NULL) {
+            snprintf(emergency_reason, sizeof(emergency_reason), 
+                    "Protective field %u stop violated - distance=%umm at %udeg", 
+                    field->field, field->nearest_mm, field->nearest_angle_deg);
+        } else {
+            snprintf(emergency_reason, sizeof(emergency_reason), 
+                    "Emergency zone violated - distance=%dmm < %dmm", 
+                    zones->min_distance_mm, zones->emergency_zone_mm);
+        }
+        printf("[SAFETY] EMERGENCY ZONE VIOLATED: %s\n", emergency_reason);
+        
+        // Trigger immediate E-Stop via safety monitor
+        
+        safety_monitor_instance.last_fault = SAFETY_FAULT_CODE_ZONE_VIOLATION;
+        safety_monitor_trigger_emergency_stop(emergency_reason);
+        
+        // Update LED status
+        hal_led_system_error(); // Red LED blinking
+        
+    } else if (zones->warning_violated) {
+        // Warning zone violated - reduce speed
+        if (field != NULL) {
+            printf("[SAFETY] WARNING ZONE VIOLATED: Protective field %u, distance=%umm at %udeg\n", 
+                   field->field, field->nearest_mm, field->nearest_angle_deg);
+        } else {
+            printf("[SAFETY] WARNING ZONE VIOLATED: Distance=%dmm < %dmm\n", 
+                   zones->min_distance_mm, zones->warning_zone_mm);
+        }
+        
+        // Show warning indication - LED pattern will be set by state transition
+        if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE) {
+            safety_monitor_transition_state(SAFETY_MONITOR_STATE_WARNING);
+        }
+        
+        // Log warning event
+        safety_monitor_log_event(SAFETY_MONITOR_EVENT_ZONE_VIOLATION, 
+                                "Warning zone violated - reduce speed");
+        
+    } else if (zones->safe_violated) {
+        // Safe zone violated - monitor closely
+        printf("[SAFETY] SAFE ZONE VIOLATED: Distance=%dmm < %dmm\n", 
+               zones->min_distance_mm, zones->safe_zone_mm);
+        
+        // Show normal operation with monitoring - LED pattern will be set by state transition
+        if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE) {
+            // Stay in safe state but monitor closely
+            safety_monitor_log_event(SAFETY_MONITOR_EVENT_ZONE_VIOLATION, 
+                                    "Safe zone violated - monitoring");
+        }
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_set_safe_led_pattern(void) __attribute__((unused));
+static hal_status_t safety_monitor_set_safe_led_pattern(void)
+{
+    // Set LED pattern for safe state
+    hal_led_power_set(LED_STATE_ON); // Power LED solid green
+    hal_led_system_set(LED_STATE_ON); // System LED solid blue
+    hal_led_comm_set(LED_STATE_ON); // Comm LED solid yellow (if modules online)
+    hal_led_network_set(LED_STATE_ON); // Network LED solid green
+    hal_led_error_set(LED_STATE_OFF); // Error LED off
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_set_warning_led_pattern(void) __attribute__((unused));
+static hal_status_t safety_monitor_set_warning_led_pattern(void)
+{
+    // Set LED pattern for warning state
+    hal_led_power_set(LED_STATE_ON); // Power LED solid green
+    hal_led_system_set(LED_STATE_BLINK_FAST); // System LED fast blink blue
+    hal_led_comm_set(LED_STATE_BLINK_SLOW); // Comm LED slow blink yellow
+    hal_led_network_set(LED_STATE_ON); // Network LED solid green
+    hal_led_error_set(LED_STATE_OFF); // Error LED off
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_set_critical_led_pattern(void) __attribute__((unused));
+static hal_status_t safety_monitor_set_critical_led_pattern(void)
+{
+    // Set LED pattern for critical state
+    hal_led_power_set(LED_STATE_ON); // Power LED solid green
+    hal_led_system_set(LED_STATE_BLINK_FAST); // System LED fast blink blue
+    hal_led_comm_set(LED_STATE_BLINK_FAST); // Comm LED fast blink yellow
+    hal_led_network_set(LED_STATE_BLINK_SLOW); // Network LED slow blink green
+    hal_led_error_set(LED_STATE_BLINK_SLOW); // Error LED slow blink red
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_set_estop_led_pattern(void) __attribute__((unused));
+static hal_status_t safety_monitor_set_estop_led_pattern(void)
+{
+    // Set LED pattern for E-Stop state
+    hal_led_power_set(LED_STATE_ON); // Power LED solid green
+    hal_led_system_set(LED_STATE_OFF); // System LED off
+    hal_led_comm_set(LED_STATE_OFF); // Comm LED off
+    hal_led_network_set(LED_STATE_OFF); // Network LED off
+    hal_led_error_set(LED_STATE_BLINK_FAST); // Error LED fast blink red
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_communication_led_pattern(bool modules_online, uint32_t online_count)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (modules_online && online_count >= 4) {
+        // All mandatory modules online - solid yellow
+        hal_led_comm_set(LED_STATE_ON);
+    } else if (modules_online && online_count > 0) {
+        // Some modules online - slow blink yellow
+        hal_led_comm_set(LED_STATE_BLINK_SLOW);
+    } else {
+        // No modules online - off
+        hal_led_comm_set(LED_STATE_OFF);
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+// Configuration Management Functions
+
+hal_status_t safety_monitor_load_config(void)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Use default configuration (config persistence simplified)
+    printf("[SAFETY] Using default configuration\n");
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_save_config(void)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Configuration saving simplified (config persistence removed)
+    printf("[SAFETY] Configuration saving not implemented (simplified)\n");
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_export_config_json(char *buffer, size_t buffer_size, size_t *actual_size)
+{
+    if (!safety_monitor_instance.initialized || !buffer || !actual_size) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    basic_safety_zones_t zones;
+    hal_status_t status = safety_monitor_get_basic_zones(&zones);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Create JSON configuration
+    int written = snprintf(buffer, buffer_size,
+        "{"
+        "\"safety_config\":{"
+        "\"version\":\"1.0.0\","
+        "\"timestamp\":%lu,"
+        "\"safety_zones\":{"
+        "\"enabled\":%s,"
+        "\"emergency_zone_mm\":%u,"
+        "\"warning_zone_mm\":%u,"
+        "\"safe_zone_mm\":%u"
+        "},"
+        "\"monitor_config\":{"
+        "\"estop_timeout_ms\":%u,"
+        "\"zone_check_period_ms\":%u,"
+        "\"interlock_check_period_ms\":%u,"
+        "\"sensor_check_period_ms\":%u,"
+        "\"watchdog_timeout_ms\":%u,"
+        "\"enable_zone_monitoring\":%s,"
+        "\"enable_interlock_monitoring\":%s,"
+        "\"enable_sensor_monitoring\":%s,"
+        "\"enable_watchdog_monitoring\":%s"
+        "}"
+        "}"
+        "}",
+        hal_time_now_ms(),
+        zones.enabled ? "true" : "false",
+        zones.emergency_zone_mm,
+        zones.warning_zone_mm,
+        zones.safe_zone_mm,
+        safety_monitor_instance.config.estop_timeout_ms,
+        safety_monitor_instance.config.zone_check_period_ms,
+        safety_monitor_instance.config.interlock_check_period_ms,
+        safety_monitor_instance.config.sensor_check_period_ms,
+        safety_monitor_instance.config.watchdog_timeout_ms,
+        safety_monitor_instance.config.enable_zone_monitoring ? "true" : "false",
+        safety_monitor_instance.config.enable_interlock_monitoring ? "true" : "false",
+        safety_monitor_instance.config.enable_sensor_monitoring ? "true" : "false",
+        safety_monitor_instance.config.enable_watchdog_monitoring ? "true" : "false");
+    
+    if (written < 0 || (size_t)written >= buffer_size) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *actual_size = (size_t)written;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_import_config_json(const char *json_string)
+{
+    if (!safety_monitor_instance.initialized || !json_string) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    // Simple JSON parsing for safety zones
+    basic_safety_zones_t zones = {0};
+    
+    // Parse emergency zone
+    char *emergency_str = strstr(json_string, "\"emergency_zone_mm\":");
+    if (emergency_str) {
+        emergency_str = strchr(emergency_str, ':') + 1;
+        zones.emergency_zone_mm = (uint16_t)strtoul(emergency_str, NULL, 10);
+    }
+    
+    // Parse warning zone
+    char *warning_str = strstr(json_string, "\"warning_zone_mm\":");
+    if (warning_str) {
+        warning_str = strchr(warning_str, ':') + 1;
+        zones.warning_zone_mm = (uint16_t)strtoul(warning_str, NULL, 10);
+    }
+    
+    // Parse safe zone
+    char *safe_str = strstr(json_string, "\"safe_zone_mm\":");
+    if (safe_str) {
+        safe_str = strchr(safe_str, ':') + 1;
+        zones.safe_zone_mm = (uint16_t)strtoul(safe_str, NULL, 10);
+    }
+    
+    // Parse enabled flag
+    char *enabled_str = strstr(json_string, "\"enabled\":");
+    if (enabled_str) {
+        enabled_str = strchr(enabled_str, ':') + 1;
+        zones.enabled = (strstr(enabled_str, "true") != NULL);
+    }
+    
+    // Validate zones configuration
+    if (zones.emergency_zone_mm >= zones.warning_zone_mm ||
+        zones.warning_zone_mm >= zones.safe_zone_mm) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    // Apply configuration
+    hal_status_t status = safety_monitor_set_basic_zones(&zones);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Save to persistent storage
+    return safety_monitor_save_config();
+}
+
+hal_status_t safety_monitor_reset_config_to_factory(void)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Reset safety zones to factory defaults
+    basic_safety_zones_t factory_zones = {
+        .enabled = true,
+        .emergency_zone_mm = 500,  // 500mm
+        .warning_zone_mm = 1000,   // 1000mm
+        .safe_zone_mm = 2000,      // 2000mm
+        .min_distance_mm = 0,
+        .min_distance_angle = 0,
+        .emergency_violated = false,
+        .warning_violated = false,
+        .safe_violated = false,
+        .last_violation_time = 0
+    };
+    
+    hal_status_t status = safety_monitor_set_basic_zones(&factory_zones);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    // Reset safety monitor configuration to factory defaults
+    safety_monitor_instance.config.estop_timeout_ms = 100;        // 100ms
+    safety_monitor_instance.config.zone_check_period_ms = 50;     // 50ms
+    safety_monitor_instance.config.interlock_check_period_ms = 100; // 100ms
+    safety_monitor_instance.config.sensor_check_period_ms = 200;  // 200ms
+    safety_monitor_instance.config.watchdog_timeout_ms = 1000;    // 1000ms
+    safety_monitor_instance.config.enable_zone_monitoring = true;
+    safety_monitor_instance.config.enable_interlock_monitoring = true;
+    safety_monitor_instance.config.enable_sensor_monitoring = true;
+    safety_monitor_instance.config.enable_watchdog_monitoring = true;
+    
+    // Save factory configuration
+    status = safety_monitor_save_config();
+    if (status == HAL_STATUS_OK) {
+        printf("[SAFETY] Configuration reset to factory defaults\n");
+    }
+    
+    return status;
+}
+
+hal_status_t safety_monitor_validate_config(bool *valid)
+{
+    if (!safety_monitor_instance.initialized || !valid) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *valid = true;
+    
+    // Validate safety zones
+    basic_safety_zones_t zones;
+    hal_status_t status = safety_monitor_get_basic_zones(&zones);
+    if (status != HAL_STATUS_OK) {
+        *valid = false;
+        return HAL_STATUS_OK;
+    }
+    
+    // Check zone distances
+    if (zones.emergency_zone_mm >= zones.warning_zone_mm ||
+        zones.warning_zone_mm >= zones.safe_zone_mm) {
+        *valid = false;
+        return HAL_STATUS_OK;
+    }
+    
+    // Check timeout values
+    if (safety_monitor_instance.config.estop_timeout_ms == 0 ||
+        safety_monitor_instance.config.zone_check_period_ms == 0 ||
+        safety_monitor_instance.config.interlock_check_period_ms == 0 ||
+        safety_monitor_instance.config.sensor_check_period_ms == 0 ||
+        safety_monitor_instance.config.watchdog_timeout_ms == 0) {
+        *valid = false;
+        return HAL_STATUS_OK;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_set_fault_led_pattern(void)
+{
+    // Set LED pattern for fault state
+    hal_led_power_set(LED_STATE_ON); // Power LED solid green
+    hal_led_system_set(LED_STATE_OFF); // System LED off
+    hal_led_comm_set(LED_STATE_OFF); // Comm LED off
+    hal_led_network_set(LED_STATE_OFF); // Network LED off
+    hal_led_error_set(LED_STATE_BLINK_SLOW); // Error LED slow blink red
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_handle_interlock_open(void)
+{
+    safety_monitor_instance.status.interlock_open = true;
+    
+    if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE ||
+        safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_WARNING) {
+        return safety_monitor_transition_state(SAFETY_MONITOR_STATE_CRITICAL);
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_handle_sensor_fault(void)
+{
+    safety_monitor_instance.status.sensor_fault = true;
+    safety_monitor_instance.status.fault_count++;
+    
+    if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE ||
+        safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_WARNING) {
+        return safety_monitor_transition_state(SAFETY_MONITOR_STATE_CRITICAL);
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_handle_communication_lost(void)
+{
+    safety_monitor_instance.status.communication_ok = false;
+    
+    if (safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_SAFE ||
+        safety_monitor_instance.status.current_state == SAFETY_MONITOR_STATE_WARNING) {
+        return safety_monitor_transition_state(SAFETY_MONITOR_STATE_CRITICAL);
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t safety_monitor_handle_watchdog_timeout(void)
+{
+    safety_monitor_instance.status.watchdog_ok = false;
+    
+    return safety_monitor_transition_state(SAFETY_MONITOR_STATE_FAULT);
+}
+
+static hal_status_t safety_monitor_execute_emergency_procedures(const char* reason)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    if (!safety_monitor_instance.config.enable_emergency_procedures) {
+        return HAL_STATUS_OK;
+    }
+    
+    // Every step is attempted; the first failure is reported
+    hal_status_t step_status;
+    
+    // Set error LED
+    step_status = hal_led_on(LED_ERROR_PIN);
+    if (step_status != HAL_STATUS_OK && status == HAL_STATUS_OK) {
+        status = step_status;
+    }
+    
+    // Turn off all relays (fail-safe)
+    step_status = hal_relay1_off();
+    if (step_status != HAL_STATUS_OK && status == HAL_STATUS_OK) {
+        status = step_status;
+    }
+    
+    step_status = hal_relay2_off();
+    if (step_status != HAL_STATUS_OK && status == HAL_STATUS_OK) {
+        status = step_status;
+    }
+    
+    // Log emergency procedures
+    safety_monitor_log_event(SAFETY_MONITOR_EVENT_EMERGENCY_STOP, reason);
+    
+    return status;
+}
+
+static void safety_monitor_log_event(safety_monitor_event_t event, const char* details)
+{
+    uint64_t timestamp = hal_time_now_ms();
+    const char* event_name;
+    
+    // Convert event enum to string
+    switch (event) {
+        case SAFETY_MONITOR_EVENT_ZONE_VIOLATION:
+            event_name = "ZONE_VIOLATION";
+            break;
+        case SAFETY_MONITOR_EVENT_INTERLOCK_OPEN:
+            event_name = "INTERLOCK_OPEN";
+            break;
+        case SAFETY_MONITOR_EVENT_SENSOR_FAULT:
+            event_name = "SENSOR_FAULT";
+            break;
+        case SAFETY_MONITOR_EVENT_WATCHDOG_TIMEOUT:
+            event_name = "WATCHDOG_TIMEOUT";
+            break;
+        case SAFETY_MONITOR_EVENT_EMERGENCY_STOP:
+            event_name = "EMERGENCY_STOP";
+            break;
+        case SAFETY_MONITOR_EVENT_COMMUNICATION_LOST:
+            event_name = "COMMUNICATION_LOST";
+            break;
+        case SAFETY_MONITOR_EVENT_SAFETY_RESET:
+            event_name = "SAFETY_RESET";
+            break;
+        default:
+            event_name = "UNKNOWN";
+            break;
+    }
+    
+    // Log to console/syslog
+    printf("[SAFETY][%lu] %s: %s\n", timestamp, event_name, details ? details : "");
+    
+    // Store in safety monitor event buffer for telemetry
+    safety_monitor_instance.stats.total_events++;
+    
+    // Trigger event callback if registered (simplified for now)
+    if (safety_monitor_instance.event_callback) {
+        // Note: callback signature may need adjustment
+        // For now, just log that callback would be triggered
+        printf("[SAFETY] Event callback triggered for %s\n", event_name);
+    }
+}
+
+// Additional public functions
+
+hal_status_t safety_monitor_set_zone_config(uint8_t zone_id, const safety_zone_config_t *config)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (zone_id >= MAX_SAFETY_ZONES || config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    safety_monitor_instance.zones[zone_id] = *config;
+    
+    if (zone_id >= safety_monitor_instance.zone_count) {
+        safety_monitor_instance.zone_count = zone_id + 1;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_interlock_config(uint8_t interlock_id, const safety_interlock_config_t *config)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (interlock_id >= MAX_SAFETY_INTERLOCKS || config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    safety_monitor_instance.interlocks[interlock_id] = *config;
+    
+    if (interlock_id >= safety_monitor_instance.interlock_count) {
+        safety_monitor_instance.interlock_count = interlock_id + 1;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_sensor_config(uint8_t sensor_id, const safety_sensor_config_t *config)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (sensor_id >= MAX_SAFETY_SENSORS || config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    safety_monitor_instance.sensors[sensor_id] = *config;
+    
+    if (sensor_id >= safety_monitor_instance.sensor_count) {
+        safety_monitor_instance.sensor_count = sensor_id + 1;
+    }
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_callback(safety_monitor_event_callback_t callback)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    safety_monitor_instance.event_callback = callback;
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_emergency_stop_callback(safety_emergency_stop_callback_t callback)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    safety_monitor_instance.estop_callback = callback;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_set_config(const safety_monitor_config_t *config)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    safety_monitor_instance.config = *config;
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_get_config(safety_monitor_config_t *config)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *config = safety_monitor_instance.config;
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_run_diagnostics(char* result, size_t max_size)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (result == NULL || max_size == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    snprintf(result, max_size,
+             "Safety Monitor Diagnostics:\n"
+             "State: %d\n"
+             "E-Stop Active: %s\n"
+             "Zone Violation: %s\n"
+             "Interlock Open: %s\n"
+             "Sensor Fault: %s\n"
+             "Communication OK: %s\n"
+             "Watchdog OK: %s\n"
+             "Error Count: %u\n"
+             "Violation Count: %u\n"
+             "Fault Count: %u\n",
+             safety_monitor_instance.status.current_state,
+             safety_monitor_instance.status.estop_active ? "Yes" : "No",
+             safety_monitor_instance.status.zone_violation ? "Yes" : "No",
+             safety_monitor_instance.status.interlock_open ? "Yes" : "No",
+             safety_monitor_instance.status.sensor_fault ? "Yes" : "No",
+             safety_monitor_instance.status.communication_ok ? "Yes" : "No",
+             safety_monitor_instance.status.watchdog_ok ? "Yes" : "No",
+             safety_monitor_instance.error_count,
+             safety_monitor_instance.status.violation_count,
+             safety_monitor_instance.status.fault_count);
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_clear_stats(void)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    memset(&safety_monitor_instance.stats, 0, sizeof(safety_monitor_instance.stats));
+    
+    return HAL_STATUS_OK;
+}
+
+const char* safety_monitor_get_version(void)
+{
+    return SAFETY_MONITOR_VERSION;
+}
+
+hal_status_t safety_monitor_set_basic_zones(const basic_safety_zones_t *zones)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (zones == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    // Validate zone distances
+    if (zones->emergency_zone_mm >= zones->warning_zone_mm ||
+        zones->warning_zone_mm >= zones->safe_zone_mm) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    safety_monitor_instance.status.safety_zones = *zones;
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_get_basic_zones(basic_safety_zones_t *zones)
+{
+    if (!safety_monitor_instance.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    if (zones == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *zones = safety_monitor_instance.status.safety_zones;
+    
+    return HAL_STATUS_OK;
+}
+
+
+
+hal_status_t safety_monitor_is_estop_active(bool* estop_active)
+{
+    if (!safety_monitor_instance.initialized || !estop_active) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    *estop_active = (safety_monitor_instance.estop_hardware_active || 
+                    safety_monitor_instance.estop_software_active);
+    
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_get_last_fault(safety_fault_code_t *fault)
+{
+    if (!safety_monitor_instance.initialized || !fault) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *fault = safety_monitor_instance.last_fault;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t safety_monitor_get_last_estop_latency(uint32_t *latency_ms)
+{
+    if (!safety_monitor_instance.initialized || !latency_ms) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *latency_ms = safety_monitor_instance.last_estop_latency_ms;
+    return HAL_STATUS_OK;
+}
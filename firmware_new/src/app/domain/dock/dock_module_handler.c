@@ -1,5 +1,5 @@
 #include "dock_module_handler.h"
-#include "communication_manager.h"
+#include "modbus_bus_master.h"
 #include "safety_manager.h"
 #include "hal_common.h"
 #include "safety_types.h"
@@ -13,26 +13,6 @@
 // PRIVATE FUNCTIONS
 // ============================================================================
 
-/**
- * @brief Get current timestamp in milliseconds
- * @return Current timestamp
- */
-static uint32_t get_current_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint32_t)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
-}
-
-/**
- * @brief Get current timestamp in seconds
- * @return Current timestamp
- */
-static uint32_t get_current_timestamp_s(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint32_t)tv.tv_sec;
-}
-
 /**
  * @brief Check if docking timeout has occurred
  * @param handler Pointer to dock module handler
@@ -43,7 +23,7 @@ static bool check_docking_timeout(dock_module_handler_t *handler) {
         return false;
     }
     
-    uint32_t current_time = get_current_timestamp_s();
+    uint32_t current_time = (uint32_t)(hal_time_now_ms() / 1000ULL);
     uint32_t elapsed_time = current_time - (handler->docking_start_time / 1000);
     
     return (elapsed_time > handler->config.timeout);
@@ -59,7 +39,7 @@ static bool check_calibration_timeout(dock_module_handler_t *handler) {
         return false;
     }
     
-    uint32_t current_time = get_current_timestamp_s();
+    uint32_t current_time = (uint32_t)(hal_time_now_ms() / 1000ULL);
     uint32_t elapsed_time = current_time - (handler->calibration_start_time / 1000);
     
     return (elapsed_time > 60); // 60 second calibration timeout
@@ -105,7 +85,7 @@ static hal_status_t check_safety_conditions(dock_module_handler_t *handler) {
  * @param handler Pointer to dock module handler
  */
 static void update_docking_state_machine(dock_module_handler_t *handler) {
-    uint32_t current_time = get_current_timestamp_ms();
+    uint32_t current_time = (uint32_t)hal_time_now_ms();
     
     // Check for timeout conditions
     if (check_docking_timeout(handler)) {
@@ -129,7 +109,7 @@ static void update_docking_state_machine(dock_module_handler_t *handler) {
     }
     
     // Update uptime
-    handler->data.uptime = get_current_timestamp_s();
+    handler->data.uptime = (uint32_t)(hal_time_now_ms() / 1000ULL);
     
     // REAL SENSOR DATA READING - IMPLEMENTATION FOR ISSUE #138
     // Read all sensor data from dock module via RS485
@@ -273,7 +253,7 @@ hal_status_t dock_module_init(dock_module_handler_t *handler, uint8_t address) {
     
     // Set initialization flag
     handler->initialized = true;
-    handler->last_update_time = get_current_timestamp_ms();
+    handler->last_update_time = (uint32_t)hal_time_now_ms();
     
     printf("[DOCK] Module initialized with address 0x%02X\n", address);
     return HAL_STATUS_OK;
@@ -311,7 +291,7 @@ hal_status_t dock_module_update(dock_module_handler_t *handler) {
     update_docking_state_machine(handler);
     
     // Update timestamp
-    handler->last_update_time = get_current_timestamp_ms();
+    handler->last_update_time = (uint32_t)hal_time_now_ms();
     
     return HAL_STATUS_OK;
 }
@@ -328,16 +308,9 @@ hal_status_t dock_module_enable(dock_module_handler_t *handler, bool enable) {
         return HAL_STATUS_ERROR;
     }
     
-    // In test environment, skip Modbus communication
-    // Write enable register via Modbus (commented out for test environment)
+    // Write enable register via Modbus (commented out for test safety)
     /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_ENABLE_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = enable ? 1 : 0;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_ENABLE_REG, enable ? 1 : 0) != HAL_STATUS_OK) {
         printf("[DOCK] Modbus write failed for register 0x%04X\n", DOCK_ENABLE_REG);
         return HAL_STATUS_ERROR;
     }
@@ -379,25 +352,17 @@ hal_status_t dock_module_start_docking(dock_module_handler_t *handler, uint16_t
     // Set target position
     handler->data.position_target = target_position;
     
-    // In test environment, skip Modbus communication
     // Write target position register (commented out for test safety)
     /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_POSITION_TARGET_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = target_position;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_POSITION_TARGET_REG, target_position) != HAL_STATUS_OK) {
         printf("[DOCK] Failed to write target position register\n");
         return HAL_STATUS_ERROR;
     }
+    */
     
-    // Start docking sequence
-    request.start_address = DOCK_START_DOCKING_REG;
-    request.data[0] = 1;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    // Start docking sequence (commented out for test safety)
+    /*
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_START_DOCKING_REG, 1) != HAL_STATUS_OK) {
         printf("[DOCK] Failed to start docking sequence\n");
         return HAL_STATUS_ERROR;
     }
@@ -405,7 +370,7 @@ hal_status_t dock_module_start_docking(dock_module_handler_t *handler, uint16_t
     
     // Update state
     handler->data.status = DOCK_STATUS_APPROACHING;
-    handler->docking_start_time = get_current_timestamp_ms();
+    handler->docking_start_time = (uint32_t)hal_time_now_ms();
     handler->retry_attempts = 0;
     
     printf("[DOCK] Started docking sequence to position %d mm\n", target_position);
@@ -420,16 +385,9 @@ hal_status_t dock_module_stop_docking(dock_module_handler_t *handler) {
         return HAL_STATUS_ERROR;
     }
     
-    // In test environment, skip Modbus communication
     // Write stop register (commented out for test safety)
     /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_STOP_DOCKING_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = 1;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_SAFETY, handler->address, DOCK_STOP_DOCKING_REG, 1) != HAL_STATUS_OK) {
         printf("[DOCK] Failed to stop docking sequence\n");
         return HAL_STATUS_ERROR;
     }
@@ -450,16 +408,9 @@ hal_status_t dock_module_emergency_stop(dock_module_handler_t *handler) {
         return HAL_STATUS_ERROR;
     }
     
-    // In test environment, skip Modbus communication
     // Write emergency stop register (commented out for test safety)
     /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_EMERGENCY_STOP_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = 1;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_SAFETY, handler->address, DOCK_EMERGENCY_STOP_REG, 1) != HAL_STATUS_OK) {
         printf("[DOCK] Failed to emergency stop\n");
         return HAL_STATUS_ERROR;
     }
@@ -530,19 +481,8 @@ hal_status_t dock_module_set_position(dock_module_handler_t *handler, uint16_t p
     
     handler->data.position_target = position;
     
-    // In test environment, skip Modbus communication
     // Write to register (commented out for test safety)
-    /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_POSITION_TARGET_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = position;
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
-    return HAL_STATUS_OK;
-    */
-    
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_POSITION_TARGET_REG, position);
     return HAL_STATUS_OK;
 }
 
@@ -590,19 +530,8 @@ hal_status_t dock_module_set_approach_distance(dock_module_handler_t *handler, u
     handler->config.approach_distance = distance;
     handler->data.approach_speed = distance / 10; // Simple calculation
     
-    // In test environment, skip Modbus communication
     // Write to register (commented out for test safety)
-    /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_CONFIG_;  // NOLINTAPPROACH_DISTANCE_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = distance;
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
-    return HAL_STATUS_OK;
-    */
-    
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_APPROACH_DISTANCE_REG, distance);
     return HAL_STATUS_OK;
 }
 
@@ -619,17 +548,8 @@ hal_status_t dock_module_set_final_speed(dock_module_handler_t *handler, uint16_
     handler->config.final_speed = speed;
     handler->data.final_speed = speed;
     
-    // In test environment, skip Modbus communication
     // Write to register (commented out for test safety)
-    /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_CONFIG_;  // NOLINTFINAL_SPEED_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = speed;
-    */
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_FINAL_SPEED_REG, speed);
     return HAL_STATUS_OK;
 }
 
@@ -646,14 +566,8 @@ hal_status_t dock_module_set_accuracy_threshold(dock_module_handler_t *handler,
     handler->config.accuracy_threshold = threshold;
     handler->data.accuracy_threshold = threshold;
     
-    // Write to register via communication manager
-    comm_mgr_modbus_request_t request = {0};  // NOLINT
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT  // NOLINT
-    request.start_address = DOCK_CONFIG_ACCURACY_REG;  // NOLINT
-    request.quantity = 1;  // NOLINT  // NOLINT
-    request.data[0] = threshold;  // NOLINT
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Write to register (commented out for test safety)
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_ACCURACY_REG, threshold);
     return HAL_STATUS_OK;
 }
 
@@ -669,14 +583,8 @@ hal_status_t dock_module_set_timeout(dock_module_handler_t *handler, uint16_t ti
     
     handler->config.timeout = timeout;
     
-    // Write to register via communication manager
-    comm_mgr_modbus_request_t request = {0};  // NOLINT
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT  // NOLINT
-    request.start_address = DOCK_CONFIG_TIMEOUT_REG;  // NOLINT
-    request.quantity = 1;  // NOLINT  // NOLINT
-    request.data[0] = timeout;  // NOLINT
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Write to register (commented out for test safety)
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_TIMEOUT_REG, timeout);
     return HAL_STATUS_OK;
 }
 
@@ -692,14 +600,8 @@ hal_status_t dock_module_set_retry_count(dock_module_handler_t *handler, uint8_t
     
     handler->config.retry_count = retry_count;
     
-    // Write to register via communication manager
-    comm_mgr_modbus_request_t request = {0};  // NOLINT
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT  // NOLINT
-    request.start_address = DOCK_CONFIG_RETRY_COUNT_REG;  // NOLINT
-    request.quantity = 1;  // NOLINT  // NOLINT
-    request.data[0] = retry_count;  // NOLINT
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Write to register (commented out for test safety)
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_RETRY_COUNT_REG, retry_count);
     return HAL_STATUS_OK;
 }
 
@@ -715,14 +617,8 @@ hal_status_t dock_module_set_debounce_time(dock_module_handler_t *handler, uint1
     
     handler->config.debounce_time = debounce_time;
     
-    // Write to register via communication manager
-    comm_mgr_modbus_request_t request = {0};  // NOLINT
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT  // NOLINT
-    request.start_address = DOCK_CONFIG_DEBOUNCE_TIME_REG;  // NOLINT
-    request.quantity = 1;  // NOLINT  // NOLINT
-    request.data[0] = debounce_time;  // NOLINT
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Write to register (commented out for test safety)
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_DEBOUNCE_TIME_REG, debounce_time);
     return HAL_STATUS_OK;
 }
 
@@ -738,14 +634,8 @@ hal_status_t dock_module_set_alignment_tolerance(dock_module_handler_t *handler,
     
     handler->config.alignment_tolerance = tolerance;
     
-    // Write to register via communication manager
-    comm_mgr_modbus_request_t request = {0};  // NOLINT
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT  // NOLINT
-    request.start_address = DOCK_CONFIG_ALIGNMENT_TOLERANCE_REG;  // NOLINT
-    request.quantity = 1;  // NOLINT  // NOLINT
-    request.data[0] = tolerance;  // NOLINT
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Write to register (commented out for test safety)
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CONFIG_ALIGNMENT_TOLERANCE_REG, tolerance);
     return HAL_STATUS_OK;
 }
 
@@ -770,16 +660,9 @@ hal_status_t dock_module_start_calibration(dock_module_handler_t *handler) {
         return HAL_STATUS_ERROR;
     }
     
-    // In test environment, skip Modbus communication
     // Write calibration register (commented out for test safety)
     /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_CALIBRATE_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = 1;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_CALIBRATE_REG, 1) != HAL_STATUS_OK) {
         printf("[DOCK] Failed to start calibration\n");
         return HAL_STATUS_ERROR;
     }
@@ -787,7 +670,7 @@ hal_status_t dock_module_start_calibration(dock_module_handler_t *handler) {
     
     // Update state
     handler->data.status = DOCK_STATUS_CALIBRATING;
-    handler->calibration_start_time = get_current_timestamp_s();
+    handler->calibration_start_time = (uint32_t)(hal_time_now_ms() / 1000ULL);
     
     printf("[DOCK] Started calibration sequence\n");
     dock_module_trigger_event(handler, DOCK_EVENT_CALIBRATION_STARTED);
@@ -820,14 +703,9 @@ hal_status_t dock_module_set_reference_position(dock_module_handler_t *handler,
         return HAL_STATUS_ERROR;
     }
     
-    // Write to register
-    comm_mgr_modbus_request_t request = {0};
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_SET_DOCK_POSITION_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = position;
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Write to register (commented out for test safety)
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_SET_DOCK_POSITION_REG, position);
+    (void)position;
     return HAL_STATUS_OK;
 }
 
@@ -841,16 +719,9 @@ hal_status_t dock_module_reset_faults(dock_module_handler_t *handler) {
         return HAL_STATUS_ERROR;
     }
     
-    // In test environment, skip Modbus communication
     // Write reset register (commented out for test safety)
     /*
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = DOCK_RESET_FAULTS_REG;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = 1;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, DOCK_RESET_FAULTS_REG, 1) != HAL_STATUS_OK) {
         printf("[DOCK] Failed to reset faults\n");
         return HAL_STATUS_ERROR;
     }
@@ -997,38 +868,10 @@ hal_status_t dock_module_read_register(dock_module_handler_t *handler, uint16_t
         return HAL_STATUS_ERROR;
     }
     
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_READ_HOLDING_REGISTERS;
-    request.start_address = reg;
-    request.quantity = 1;  // NOLINT
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address, reg, 1, value) != HAL_STATUS_OK) {
         return HAL_STATUS_ERROR;
     }
     
-    // In real implementation, this would read from the response
-    // For now, simulate reading from internal data
-    switch (reg) {
-        case DOCK_POSITION_TARGET_REG:
-            *value = handler->data.position_target;
-            break;
-        case DOCK_CURRENT_POSITION_REG:
-            *value = handler->data.current_position;
-            break;
-        case DOCK_STATUS_REG:
-            *value = handler->data.status;
-            break;
-        case DOCK_FAULT_STATUS_REG:
-            *value = handler->data.fault_status;
-            break;
-        case DOCK_FAULT_CODE_REG:
-            *value = handler->data.fault_code;
-            break;
-        default:
-            *value = 0;
-            break;
-    }
-    
     return HAL_STATUS_OK;
 }
 
@@ -1037,13 +880,10 @@ hal_status_t dock_module_write_register(dock_module_handler_t *handler, uint16_t
         return HAL_STATUS_ERROR;
     }
     
-    comm_mgr_modbus_request_t request = {0};
-    request.function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;  // NOLINT
-    request.start_address = reg;
-    request.quantity = 1;  // NOLINT
-    request.data[0] = value;
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Modbus write commented out for test safety
+    // return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, handler->address, reg, value);
+    (void)reg;
+    (void)value;
     return HAL_STATUS_OK;
 }
 
@@ -1052,21 +892,10 @@ hal_status_t dock_module_read_registers(dock_module_handler_t *handler, uint16_t
         return HAL_STATUS_ERROR;
     }
     
-    comm_mgr_modbus_request_t request;
-    request.function_code = MODBUS_FC_READ_HOLDING_REGISTERS;
-    request.start_address = start_reg;
-    request.quantity = count;
-    
-    if (comm_manager_modbus_send_request(&request, NULL) != HAL_STATUS_OK) {
+    if (modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address, start_reg, count, data) != HAL_STATUS_OK) {
         return HAL_STATUS_ERROR;
     }
     
-    // In real implementation, this would read from the response
-    // For now, simulate reading from internal data
-    for (uint16_t i = 0; i < count; i++) {
-        data[i] = 0; // Default value
-    }
-    
     return HAL_STATUS_OK;
 }
 
@@ -1075,16 +904,10 @@ hal_status_t dock_module_write_registers(dock_module_handler_t *handler, uint16_
         return HAL_STATUS_ERROR;
     }
     
-    comm_mgr_modbus_request_t request = {0};
-    request.function_code = MODBUS_FC_WRITE_MULTIPLE_REGISTERS;
-    request.start_address = start_reg;
-    request.quantity = count;
-    
-    for (uint16_t i = 0; i < count; i++) {
-        request.data[i] = data[i];
-    }
-    
-    // return comm_manager_modbus_send_request(&request, NULL);
+    // Modbus write commented out for test safety
+    // return modbus_bus_write_multiple(MODBUS_BUS_PRIO_COMMAND, handler->address, start_reg, count, data);
+    (void)start_reg;
+    (void)count;
     return HAL_STATUS_OK;
 }
 
@@ -1217,16 +1040,16 @@ hal_status_t dock_module_get_rfid_tag_id(dock_module_handler_t *handler, uint32_
     hal_status_t status;
     
     // Read RFID tag ID low word from register 0x7100
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_RFID_TAG_ID_LOW_REG, 1, &tag_id_low);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_RFID_TAG_ID_LOW_REG, 1, &tag_id_low);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read RFID tag ID low: %d\n", status);
         return status;
     }
     
     // Read RFID tag ID high word from register 0x7101
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_RFID_TAG_ID_HIGH_REG, 1, &tag_id_high);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_RFID_TAG_ID_HIGH_REG, 1, &tag_id_high);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read RFID tag ID high: %d\n", status);
         return status;
@@ -1237,7 +1060,7 @@ hal_status_t dock_module_get_rfid_tag_id(dock_module_handler_t *handler, uint32_
     
     // Update handler data
     handler->data.rfid.tag_id = *tag_id;
-    handler->data.rfid.last_read_time = get_current_timestamp_ms();
+    handler->data.rfid.last_read_time = (uint32_t)hal_time_now_ms();
     
     return HAL_STATUS_OK;
 }
@@ -1257,8 +1080,8 @@ hal_status_t dock_module_get_rfid_signal_strength(dock_module_handler_t *handler
     hal_status_t status;
     
     // Read RFID signal strength from register 0x7102
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_RFID_SIGNAL_STRENGTH_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_RFID_SIGNAL_STRENGTH_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read RFID signal strength: %d\n", status);
         return status;
@@ -1287,8 +1110,8 @@ hal_status_t dock_module_get_rfid_read_status(dock_module_handler_t *handler, ui
     hal_status_t status;
     
     // Read RFID read status from register 0x7103
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_RFID_READ_STATUS_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_RFID_READ_STATUS_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read RFID read status: %d\n", status);
         return status;
@@ -1319,8 +1142,8 @@ hal_status_t dock_module_get_accelerometer(dock_module_handler_t *handler, int16
     hal_status_t status;
     
     // Read accelerometer X-axis from register 0x7200
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_ACCEL_X_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_ACCEL_X_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read accelerometer X: %d\n", status);
         return status;
@@ -1328,8 +1151,8 @@ hal_status_t dock_module_get_accelerometer(dock_module_handler_t *handler, int16
     *accel_x = (int16_t)reg_value;
     
     // Read accelerometer Y-axis from register 0x7201
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_ACCEL_Y_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_ACCEL_Y_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read accelerometer Y: %d\n", status);
         return status;
@@ -1337,8 +1160,8 @@ hal_status_t dock_module_get_accelerometer(dock_module_handler_t *handler, int16
     *accel_y = (int16_t)reg_value;
     
     // Read accelerometer Z-axis from register 0x7202
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_ACCEL_Z_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_ACCEL_Z_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read accelerometer Z: %d\n", status);
         return status;
@@ -1368,8 +1191,8 @@ hal_status_t dock_module_get_accelerometer_temperature(dock_module_handler_t *ha
     hal_status_t status;
     
     // Read accelerometer temperature from register 0x7203
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_ACCEL_TEMPERATURE_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_ACCEL_TEMPERATURE_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read accelerometer temperature: %d\n", status);
         return status;
@@ -1398,8 +1221,8 @@ hal_status_t dock_module_get_accelerometer_status(dock_module_handler_t *handler
     hal_status_t hal_status;
     
     // Read accelerometer status from register 0x7204
-    hal_status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                          DOCK_ACCEL_STATUS_REG, 1, &reg_value);
+    hal_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                         DOCK_ACCEL_STATUS_REG, 1, &reg_value);
     if (hal_status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read accelerometer status: %d\n", hal_status);
         return hal_status;
@@ -1428,8 +1251,8 @@ hal_status_t dock_module_get_proximity_sensor_1(dock_module_handler_t *handler,
     hal_status_t hal_status;
     
     // Read proximity sensor 1 from register 0x7300
-    hal_status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                          DOCK_PROX_SENSOR_1_REG, 1, &reg_value);
+    hal_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                         DOCK_PROX_SENSOR_1_REG, 1, &reg_value);
     if (hal_status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read proximity sensor 1: %d\n", hal_status);
         return hal_status;
@@ -1458,8 +1281,8 @@ hal_status_t dock_module_get_proximity_sensor_2(dock_module_handler_t *handler,
     hal_status_t hal_status;
     
     // Read proximity sensor 2 from register 0x7301
-    hal_status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                          DOCK_PROX_SENSOR_2_REG, 1, &reg_value);
+    hal_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                         DOCK_PROX_SENSOR_2_REG, 1, &reg_value);
     if (hal_status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read proximity sensor 2: %d\n", hal_status);
         return hal_status;
@@ -1489,8 +1312,8 @@ hal_status_t dock_module_get_proximity_distances(dock_module_handler_t *handler,
     hal_status_t status;
     
     // Read proximity sensor 1 distance from register 0x7302
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_PROX_SENSOR_1_DISTANCE_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_PROX_SENSOR_1_DISTANCE_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read proximity sensor 1 distance: %d\n", status);
         return status;
@@ -1498,8 +1321,8 @@ hal_status_t dock_module_get_proximity_distances(dock_module_handler_t *handler,
     *distance_1 = reg_value;
     
     // Read proximity sensor 2 distance from register 0x7303
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_PROX_SENSOR_2_DISTANCE_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_PROX_SENSOR_2_DISTANCE_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read proximity sensor 2 distance: %d\n", status);
         return status;
@@ -1528,8 +1351,8 @@ hal_status_t dock_module_get_dock_confirmed(dock_module_handler_t *handler, uint
     hal_status_t status;
     
     // Read dock confirmed status from register 0x7304
-    status = comm_manager_modbus_read_holding_registers(handler->address, 
-                                                      DOCK_DOCK_CONFIRMED_REG, 1, &reg_value);
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, handler->address,
+                                     DOCK_DOCK_CONFIRMED_REG, 1, &reg_value);
     if (status != HAL_STATUS_OK) {
         printf("[DOCK] Failed to read dock confirmed status: %d\n", status);
         return status;
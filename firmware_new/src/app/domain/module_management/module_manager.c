@@ -13,6 +13,8 @@
 #include "module_manager.h"
 // Updated paths for Domain-Driven Architecture v1.0.1
 #include "../../infrastructure/communication/communication_manager.h"
+#include "../../infrastructure/communication/modbus_bus_master.h"
+#include "telemetry_stream.h"
 #include "hal_common.h"
 #include "../power/power_module_handler.h"
 #include <stdio.h>
@@ -639,7 +641,7 @@ static hal_status_t perform_health_check(uint8_t module_id) {
     
     // Try to read Device ID register (0x0100) to check if module is responsive
     uint16_t device_id;
-    hal_status_t status = comm_manager_modbus_read_holding_registers(
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY,
         module_id, 0x0100, 1, &device_id);
     
     uint64_t end_time = hal_get_timestamp_us();
@@ -778,7 +780,7 @@ static hal_status_t discover_module_at_address(uint8_t address) {
 	char version[16] = {0};
     
     // Read Device ID register (0x0100) - use single register read
-    hal_status_t status = comm_manager_modbus_read_holding_registers(
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_DISCOVERY,
         address, 0x0100, 1, &device_id);
     
     if (status != HAL_STATUS_OK) {
@@ -786,7 +788,7 @@ static hal_status_t discover_module_at_address(uint8_t address) {
     }
     
     // Read Module Type register (0x0104) - use single register read
-    status = comm_manager_modbus_read_holding_registers(
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_DISCOVERY,
         address, 0x0104, 1, &module_type);
     
     if (status != HAL_STATUS_OK) {
@@ -795,7 +797,7 @@ static hal_status_t discover_module_at_address(uint8_t address) {
     
     // Try to read Version registers (0x00F8-0x00FF) - optional, not all modules support this
     uint16_t version_regs[8];
-    status = comm_manager_modbus_read_holding_registers(
+    status = modbus_bus_read_holding(MODBUS_BUS_PRIO_DISCOVERY,
         address, 0x00F8, 8, version_regs);
     
     if (status == HAL_STATUS_OK) {
@@ -902,7 +904,7 @@ static hal_status_t read_module_capabilities(uint8_t address, module_type_t type
     
     // Read capabilities register (0x0105) - use single register read
     uint16_t caps_reg;
-    hal_status_t status = comm_manager_modbus_read_holding_registers(
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_DISCOVERY,
         address, 0x0105, 1, &caps_reg);
     
     if (status == HAL_STATUS_OK) {
@@ -1080,6 +1082,7 @@ static void flush_ws_events_if_due(uint64_t now_ms){
             g_ws_batch_buf[g_ws_batch_len++] = '}';
             g_ws_batch_buf[g_ws_batch_len] = '\0';
             (void)comm_manager_send_status((const uint8_t*)g_ws_batch_buf, g_ws_batch_len);
+            (void)telemetry_stream_publish_event("modules", g_ws_batch_buf);
         }
         g_ws_last_flush_ms = now_ms;
         g_ws_batch_open = false;
@@ -1135,7 +1138,9 @@ static hal_status_t poll_registered_modules_and_push_telemetry(void) {
         } else {
             start = 0x0000; qty = 2;
         }
-        hal_status_t status = comm_manager_modbus_read_holding_registers(addr, start, qty, regs);
+        // Safety module reads keep SAFETY priority, as in the polling manager
+        modbus_bus_priority_t prio = (t == MODULE_TYPE_SAFETY) ? MODBUS_BUS_PRIO_SAFETY : MODBUS_BUS_PRIO_TELEMETRY;
+        hal_status_t status = modbus_bus_read_holding(prio, addr, start, qty, regs);
         
         if (status == HAL_STATUS_OK) {
             // Emit telemetry event for successful data read
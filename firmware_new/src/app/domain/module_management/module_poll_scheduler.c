@@ -0,0 +1,355 @@
+/**
+ * @file module_poll_scheduler.c
+ * @brief Deadline-based multi-rate poll scheduler (min-heap of module/group deadlines)
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @author FW Team
+ */
+
+#include "module_poll_scheduler.h"
+#include <string.h>
+
+const uint32_t module_poll_hist_bounds_ms[MODULE_POLL_HIST_BUCKETS - 1] = {
+    1, 2, 5, 10, 20, 50, 100
+};
+
+// Internal function prototypes
+static bool module_poll_sched_less(const module_poll_scheduler_t *sched, uint16_t a, uint16_t b);
+static void module_poll_sched_swap(module_poll_scheduler_t *sched, uint16_t a, uint16_t b);
+static void module_poll_sched_sift_up(module_poll_scheduler_t *sched, uint16_t pos);
+static void module_poll_sched_sift_down(module_poll_scheduler_t *sched, uint16_t pos);
+static int module_poll_sched_resolve(const module_poll_scheduler_t *sched, uint32_t handle);
+
+hal_status_t module_poll_sched_init(module_poll_scheduler_t *sched)
+{
+    if (sched == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(sched, 0, sizeof(*sched));
+    return HAL_STATUS_OK;
+}
+
+hal_status_t module_poll_sched_add(module_poll_scheduler_t *sched, uint8_t address, uint8_t group,
+                                   uint32_t period_ms, uint64_t first_due_ms)
+{
+    if (sched == NULL || period_ms == 0 || group >= MODULE_POLL_SCHED_MAX_GROUPS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (sched->count >= MODULE_POLL_SCHED_MAX_ENTRIES) {
+        return HAL_STATUS_NO_MEMORY;
+    }
+
+    uint16_t slot = 0;
+    while (slot < MODULE_POLL_SCHED_MAX_ENTRIES && sched->entries[slot].used) {
+        slot++;
+    }
+    if (slot >= MODULE_POLL_SCHED_MAX_ENTRIES) {
+        return HAL_STATUS_NO_MEMORY;
+    }
+
+    module_poll_entry_t *entry = &sched->entries[slot];
+    uint16_t generation = (uint16_t)(entry->generation + 1U);
+    memset(entry, 0, sizeof(*entry));
+    entry->used = true;
+    entry->address = address;
+    entry->group = group;
+    entry->generation = generation;
+    entry->period_ms = period_ms;
+    entry->next_due_ms = first_due_ms;
+
+    sched->heap[sched->count] = slot;
+    sched->count++;
+    module_poll_sched_sift_up(sched, (uint16_t)(sched->count - 1U));
+    return HAL_STATUS_OK;
+}
+
+uint16_t module_poll_sched_remove_address(module_poll_scheduler_t *sched, uint8_t address)
+{
+    if (sched == NULL) {
+        return 0;
+    }
+
+    uint16_t removed = 0;
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < sched->count; i++) {
+        uint16_t slot = sched->heap[i];
+        if (sched->entries[slot].address == address) {
+            sched->entries[slot].used = false;
+            sched->entries[slot].in_flight = false;
+            removed++;
+        } else {
+            sched->heap[kept++] = slot;
+        }
+    }
+
+    if (removed > 0) {
+        // Rebuild heap property bottom-up
+        sched->count = kept;
+        for (int i = (int)kept / 2 - 1; i >= 0; i--) {
+            module_poll_sched_sift_down(sched, (uint16_t)i);
+        }
+    }
+    return removed;
+}
+
+int module_poll_sched_peek_due(const module_poll_scheduler_t *sched, uint64_t now_ms)
+{
+    if (sched == NULL || sched->count == 0) {
+        return -1;
+    }
+
+    uint16_t slot = sched->heap[0];
+    return (sched->entries[slot].next_due_ms <= now_ms) ? (int)slot : -1;
+}
+
+int module_poll_sched_dispatch_due(module_poll_scheduler_t *sched, uint64_t now_ms, uint32_t *handle)
+{
+    if (handle != NULL) {
+        *handle = MODULE_POLL_HANDLE_INVALID;
+    }
+
+    int top = module_poll_sched_peek_due(sched, now_ms);
+    if (top < 0) {
+        return -1;
+    }
+
+    module_poll_entry_t *entry = &sched->entries[top];
+    module_poll_group_stats_t *stats = &sched->groups[entry->group];
+    uint64_t due = entry->next_due_ms;
+
+    if (entry->in_flight) {
+        stats->overruns++;
+    } else {
+        uint32_t lateness = (uint32_t)(now_ms - due);
+        stats->lateness_hist[module_poll_hist_bucket(lateness)]++;
+        if (lateness > stats->max_lateness_ms) {
+            stats->max_lateness_ms = lateness;
+        }
+        if ((uint64_t)lateness >= (uint64_t)entry->period_ms * MODULE_POLL_STARVATION_PERIODS) {
+            stats->starved++;
+        }
+
+        if (entry->last_dispatch_ms != 0) {
+            uint64_t interval = now_ms - entry->last_dispatch_ms;
+            uint32_t jitter = (uint32_t)((interval > entry->period_ms) ? (interval - entry->period_ms)
+                                                                        : (entry->period_ms - interval));
+            stats->jitter_hist[module_poll_hist_bucket(jitter)]++;
+            if (jitter > stats->max_jitter_ms) {
+                stats->max_jitter_ms = jitter;
+            }
+        }
+
+        entry->in_flight = true;
+        entry->last_dispatch_ms = now_ms;
+        stats->dispatched++;
+        if (handle != NULL) {
+            *handle = ((uint32_t)entry->generation << 16) | (uint32_t)top;
+        }
+    }
+
+    // Fixed-rate advance; re-anchor instead of bursting when more than a period behind
+    entry->next_due_ms = due + entry->period_ms;
+    if (entry->next_due_ms <= now_ms) {
+        entry->next_due_ms = now_ms + entry->period_ms;
+        stats->resyncs++;
+    }
+    module_poll_sched_sift_down(sched, 0);
+    return top;
+}
+
+int module_poll_sched_skip_due(module_poll_scheduler_t *sched, uint64_t now_ms)
+{
+    int top = module_poll_sched_peek_due(sched, now_ms);
+    if (top < 0) {
+        return -1;
+    }
+
+    module_poll_entry_t *entry = &sched->entries[top];
+    sched->groups[entry->group].skipped++;
+    entry->next_due_ms = now_ms + entry->period_ms;
+    entry->last_dispatch_ms = 0;
+    module_poll_sched_sift_down(sched, 0);
+    return top;
+}
+
+void module_poll_sched_cancel(module_poll_scheduler_t *sched, uint32_t handle)
+{
+    int slot = module_poll_sched_resolve(sched, handle);
+    if (slot < 0) {
+        return;
+    }
+
+    module_poll_entry_t *entry = &sched->entries[slot];
+    if (sched->groups[entry->group].dispatched > 0) {
+        sched->groups[entry->group].dispatched--;
+    }
+    entry->in_flight = false;
+
+    // Re-arm at the dispatch time so the poll is retried on the next pass, not a period later
+    entry->next_due_ms = entry->last_dispatch_ms;
+    for (uint16_t pos = 0; pos < sched->count; pos++) {
+        if (sched->heap[pos] == (uint16_t)slot) {
+            module_poll_sched_sift_up(sched, pos);
+            break;
+        }
+    }
+}
+
+int module_poll_sched_complete(module_poll_scheduler_t *sched, uint32_t handle, bool success)
+{
+    int slot = module_poll_sched_resolve(sched, handle);
+    if (slot < 0) {
+        return -1;
+    }
+
+    module_poll_entry_t *entry = &sched->entries[slot];
+    entry->in_flight = false;
+    if (success) {
+        sched->groups[entry->group].completed++;
+    } else {
+        sched->groups[entry->group].failed++;
+    }
+    return slot;
+}
+
+uint32_t module_poll_sched_time_to_next_ms(const module_poll_scheduler_t *sched, uint64_t now_ms)
+{
+    if (sched == NULL || sched->count == 0) {
+        return UINT32_MAX;
+    }
+
+    uint64_t due = sched->entries[sched->heap[0]].next_due_ms;
+    if (due <= now_ms) {
+        return 0;
+    }
+    uint64_t delta = due - now_ms;
+    return (delta > UINT32_MAX) ? UINT32_MAX : (uint32_t)delta;
+}
+
+void module_poll_budget_init(module_poll_budget_t *budget, uint32_t share_permille, uint32_t burst_us, uint64_t now_ms)
+{
+    if (budget == NULL) {
+        return;
+    }
+
+    budget->share_permille = (share_permille > 1000U) ? 1000U : share_permille;
+    budget->burst_us = burst_us;
+    budget->tokens_us = (int64_t)burst_us;
+    budget->last_refill_ms = now_ms;
+}
+
+void module_poll_budget_refill(module_poll_budget_t *budget, uint64_t now_ms)
+{
+    if (budget == NULL || now_ms <= budget->last_refill_ms) {
+        return;
+    }
+
+    // share_permille of each elapsed millisecond (1000 us) is bus time granted to polling
+    uint64_t elapsed_ms = now_ms - budget->last_refill_ms;
+    budget->tokens_us += (int64_t)(elapsed_ms * budget->share_permille);
+    if (budget->tokens_us > (int64_t)budget->burst_us) {
+        budget->tokens_us = (int64_t)budget->burst_us;
+    }
+    budget->last_refill_ms = now_ms;
+}
+
+bool module_poll_budget_consume(module_poll_budget_t *budget, uint32_t cost_us)
+{
+    if (budget == NULL || budget->tokens_us < (int64_t)cost_us) {
+        return false;
+    }
+
+    budget->tokens_us -= (int64_t)cost_us;
+    return true;
+}
+
+void module_poll_budget_settle(module_poll_budget_t *budget, uint32_t estimated_us, uint32_t actual_us)
+{
+    if (budget == NULL) {
+        return;
+    }
+
+    // Retries and timeouts make the real cost exceed the estimate; the bucket may go negative
+    budget->tokens_us += (int64_t)estimated_us - (int64_t)actual_us;
+    if (budget->tokens_us > (int64_t)budget->burst_us) {
+        budget->tokens_us = (int64_t)budget->burst_us;
+    }
+}
+
+uint8_t module_poll_hist_bucket(uint32_t value_ms)
+{
+    uint8_t bucket = 0;
+    while (bucket < MODULE_POLL_HIST_BUCKETS - 1 && value_ms >= module_poll_hist_bounds_ms[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+static bool module_poll_sched_less(const module_poll_scheduler_t *sched, uint16_t a, uint16_t b)
+{
+    return sched->entries[sched->heap[a]].next_due_ms < sched->entries[sched->heap[b]].next_due_ms;
+}
+
+static void module_poll_sched_swap(module_poll_scheduler_t *sched, uint16_t a, uint16_t b)
+{
+    uint16_t tmp = sched->heap[a];
+    sched->heap[a] = sched->heap[b];
+    sched->heap[b] = tmp;
+}
+
+static void module_poll_sched_sift_up(module_poll_scheduler_t *sched, uint16_t pos)
+{
+    while (pos > 0) {
+        uint16_t parent = (uint16_t)((pos - 1U) / 2U);
+        if (!module_poll_sched_less(sched, pos, parent)) {
+            break;
+        }
+        module_poll_sched_swap(sched, pos, parent);
+        pos = parent;
+    }
+}
+
+static void module_poll_sched_sift_down(module_poll_scheduler_t *sched, uint16_t pos)
+{
+    for (;;) {
+        uint16_t left = (uint16_t)(2U * pos + 1U);
+        uint16_t right = (uint16_t)(left + 1U);
+        uint16_t smallest = pos;
+
+        if (left < sched->count && module_poll_sched_less(sched, left, smallest)) {
+            smallest = left;
+        }
+        if (right < sched->count && module_poll_sched_less(sched, right, smallest)) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            return;
+        }
+        module_poll_sched_swap(sched, pos, smallest);
+        pos = smallest;
+    }
+}
+
+/**
+ * @brief Map a dispatch handle back to its entry slot
+ * @return Slot index, or -1 if the entry was removed or reused since dispatch
+ */
+static int module_poll_sched_resolve(const module_poll_scheduler_t *sched, uint32_t handle)
+{
+    if (sched == NULL || handle == MODULE_POLL_HANDLE_INVALID) {
+        return -1;
+    }
+
+    uint32_t slot = handle & 0xFFFFU;
+    uint16_t generation = (uint16_t)(handle >> 16);
+    if (slot >= MODULE_POLL_SCHED_MAX_ENTRIES) {
+        return -1;
+    }
+
+    const module_poll_entry_t *entry = &sched->entries[slot];
+    if (!entry->used || entry->generation != generation) {
+        return -1;
+    }
+    return (int)slot;
+}
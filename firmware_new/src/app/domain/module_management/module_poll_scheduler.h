@@ -0,0 +1,205 @@
+/**
+ * @file module_poll_scheduler.h
+ * @brief Deadline-based multi-rate poll scheduler (min-heap of module/group deadlines)
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @author FW Team
+ *
+ * Each (module, register group) pair is one entry with its own period.
+ * Entries live in a binary min-heap keyed on next_due_ms, so finding the
+ * next due poll is O(1) and rescheduling O(log n) regardless of how many
+ * addresses exist. Deadlines advance at a fixed rate (next = due + period)
+ * so periods do not drift with dispatch latency. Lateness and jitter are
+ * recorded per group in fixed-bucket histograms.
+ *
+ * A token-bucket bus-time budget (module_poll_budget_t) lets the owner cap
+ * the share of RS485 time that periodic polling may take.
+ *
+ * The scheduler holds no lock; the owner serialises access.
+ */
+
+#ifndef MODULE_POLL_SCHEDULER_H
+#define MODULE_POLL_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_common.h"
+
+#define MODULE_POLL_SCHED_MAX_ENTRIES   64
+#define MODULE_POLL_SCHED_MAX_GROUPS    16
+#define MODULE_POLL_HIST_BUCKETS        8
+#define MODULE_POLL_HANDLE_INVALID      0xFFFFFFFFU
+#define MODULE_POLL_STARVATION_PERIODS  2     // Dispatch this many periods late counts as starved
+
+// Histogram bucket upper bounds in ms: <1, <2, <5, <10, <20, <50, <100, >=100
+extern const uint32_t module_poll_hist_bounds_ms[MODULE_POLL_HIST_BUCKETS - 1];
+
+// Scheduled entry
+typedef struct {
+    bool used;
+    bool in_flight;                  // Dispatched, completion pending
+    uint8_t address;
+    uint8_t group;                   // Group index (owner-defined, < MODULE_POLL_SCHED_MAX_GROUPS)
+    uint16_t generation;             // Bumped on reuse so stale completions are ignored
+    uint32_t period_ms;
+    uint64_t next_due_ms;
+    uint64_t last_dispatch_ms;
+} module_poll_entry_t;
+
+// Per-group scheduling statistics
+typedef struct {
+    uint64_t dispatched;
+    uint64_t completed;
+    uint64_t failed;
+    uint64_t overruns;               // Came due while the previous poll was still in flight
+    uint64_t resyncs;                // Fell more than one period behind; deadline re-anchored
+    uint64_t skipped;                // Came due while the owner's policy disallowed it
+    uint64_t starved;                // Dispatched MODULE_POLL_STARVATION_PERIODS or more periods late
+    uint32_t lateness_hist[MODULE_POLL_HIST_BUCKETS];  // dispatch time - deadline
+    uint32_t jitter_hist[MODULE_POLL_HIST_BUCKETS];    // |dispatch interval - period|
+    uint32_t max_lateness_ms;
+    uint32_t max_jitter_ms;
+} module_poll_group_stats_t;
+
+// Token-bucket bus-time budget
+typedef struct {
+    uint32_t share_permille;         // Share of bus time granted (1000 = whole bus)
+    uint32_t burst_us;               // Bucket capacity
+    int64_t tokens_us;
+    uint64_t last_refill_ms;
+} module_poll_budget_t;
+
+// Scheduler
+typedef struct {
+    module_poll_entry_t entries[MODULE_POLL_SCHED_MAX_ENTRIES];
+    uint16_t heap[MODULE_POLL_SCHED_MAX_ENTRIES];      // Entry indices, min-heap on next_due_ms
+    uint16_t count;
+    module_poll_group_stats_t groups[MODULE_POLL_SCHED_MAX_GROUPS];
+} module_poll_scheduler_t;
+
+/**
+ * @brief Initialize scheduler (no entries, zeroed statistics)
+ * @param sched Scheduler
+ * @return HAL status
+ */
+hal_status_t module_poll_sched_init(module_poll_scheduler_t *sched);
+
+/**
+ * @brief Add a (module, group) entry
+ * @param sched Scheduler
+ * @param address Module address
+ * @param group Group index
+ * @param period_ms Poll period
+ * @param first_due_ms First deadline
+ * @return HAL status (HAL_STATUS_NO_MEMORY if full)
+ */
+hal_status_t module_poll_sched_add(module_poll_scheduler_t *sched, uint8_t address, uint8_t group,
+                                   uint32_t period_ms, uint64_t first_due_ms);
+
+/**
+ * @brief Remove every entry of a module address
+ * @param sched Scheduler
+ * @param address Module address
+ * @return Number of entries removed
+ */
+uint16_t module_poll_sched_remove_address(module_poll_scheduler_t *sched, uint8_t address);
+
+/**
+ * @brief Peek at the earliest entry if it is due
+ * @param sched Scheduler
+ * @param now_ms Current time
+ * @return Entry index, or -1 if nothing is due
+ */
+int module_poll_sched_peek_due(const module_poll_scheduler_t *sched, uint64_t now_ms);
+
+/**
+ * @brief Dispatch the earliest (due) entry and advance its deadline
+ *
+ * If the entry is still in flight the poll is skipped and counted as an
+ * overrun; the deadline still advances.
+ *
+ * @param sched Scheduler
+ * @param now_ms Current time
+ * @param handle Output handle for module_poll_sched_complete (MODULE_POLL_HANDLE_INVALID if skipped)
+ * @return Entry index dispatched, or -1 if nothing was due
+ */
+int module_poll_sched_dispatch_due(module_poll_scheduler_t *sched, uint64_t now_ms, uint32_t *handle);
+
+/**
+ * @brief Advance the earliest (due) entry without polling it
+ *
+ * For entries the owner's policy does not allow right now. The deadline
+ * advances one period from now and the next dispatch takes no jitter sample.
+ *
+ * @param sched Scheduler
+ * @param now_ms Current time
+ * @return Entry index skipped, or -1 if nothing was due
+ */
+int module_poll_sched_skip_due(module_poll_scheduler_t *sched, uint64_t now_ms);
+
+/**
+ * @brief Undo a dispatch that could not be started (e.g. bus queue full)
+ *
+ * The entry becomes due again immediately.
+ * @param sched Scheduler
+ * @param handle Handle returned by dispatch
+ */
+void module_poll_sched_cancel(module_poll_scheduler_t *sched, uint32_t handle);
+
+/**
+ * @brief Record completion of a dispatched poll
+ * @param sched Scheduler
+ * @param handle Handle returned by dispatch
+ * @param success Whether the poll succeeded
+ * @return Entry index, or -1 if the handle is stale (entry removed meanwhile)
+ */
+int module_poll_sched_complete(module_poll_scheduler_t *sched, uint32_t handle, bool success);
+
+/**
+ * @brief Milliseconds until the next deadline
+ * @param sched Scheduler
+ * @param now_ms Current time
+ * @return 0 if something is due, UINT32_MAX if empty
+ */
+uint32_t module_poll_sched_time_to_next_ms(const module_poll_scheduler_t *sched, uint64_t now_ms);
+
+/**
+ * @brief Initialize a bus-time budget (bucket starts full)
+ * @param budget Budget
+ * @param share_permille Share of bus time granted (0..1000)
+ * @param burst_us Bucket capacity; must cover the most expensive poll
+ * @param now_ms Current time
+ */
+void module_poll_budget_init(module_poll_budget_t *budget, uint32_t share_permille, uint32_t burst_us, uint64_t now_ms);
+
+/**
+ * @brief Refill tokens for the time elapsed since the last refill
+ * @param budget Budget
+ * @param now_ms Current time
+ */
+void module_poll_budget_refill(module_poll_budget_t *budget, uint64_t now_ms);
+
+/**
+ * @brief Take tokens for a poll if the bucket holds enough
+ * @param budget Budget
+ * @param cost_us Estimated bus time of the poll
+ * @return true if granted
+ */
+bool module_poll_budget_consume(module_poll_budget_t *budget, uint32_t cost_us);
+
+/**
+ * @brief Correct a granted estimate with the measured bus time
+ * @param budget Budget
+ * @param estimated_us Tokens taken at dispatch
+ * @param actual_us Measured bus time
+ */
+void module_poll_budget_settle(module_poll_budget_t *budget, uint32_t estimated_us, uint32_t actual_us);
+
+/**
+ * @brief Histogram bucket for a duration
+ * @param value_ms Duration in ms
+ * @return Bucket index
+ */
+uint8_t module_poll_hist_bucket(uint32_t value_ms);
+
+#endif // MODULE_POLL_SCHEDULER_H
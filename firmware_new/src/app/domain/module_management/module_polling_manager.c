@@ -4,13 +4,18 @@
  * @version 1.0.0
  * @date 2025-01-28
  * @author FW Team
- * 
- * Implements dynamic polling of all discovered modules based on their types
+ *
+ * Implements dynamic polling of all discovered modules based on their types.
+ * Each module type is split into register groups with their own period; a
+ * deadline min-heap decides which (module, group) is due next.
  */
 
 #include "module_polling_manager.h"
 // Updated path for Domain-Driven Architecture v1.0.1
 #include "../../infrastructure/communication/communication_manager.h"
+#include "../../infrastructure/communication/modbus_bus_master.h"
+#include "register_poll_planner.h"
+#include "hal_log.h"
 // #include "power_module_handler.h"  // Not implemented yet
 // #include "travel_motor_module_handler.h"  // Not implemented yet
 #include "../../core/state_management/system_state_machine.h"
@@ -20,16 +25,177 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
+#include <stdint.h>
+#include <pthread.h>
 
 // Global polling manager instance
 static module_polling_manager_t g_polling_manager = {0};
 
+// Guards the scheduler and last_poll_ms, which the bus thread updates on job completion
+static pthread_mutex_t g_polling_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Told about each completed poll so the caller can run the next update without waiting for its period
+static module_polling_completion_listener_t g_completion_listener = NULL;
+static void *g_completion_listener_data = NULL;
+
+// Register group: a set of registers of one module type polled at one rate
+typedef struct {
+    module_polling_type_t type;
+    module_poll_rate_t rate;
+    const char *name;
+    uint32_t period_ms;
+    const register_poll_range_t *ranges;
+    uint16_t range_count;
+    bool include_map;               // Also poll register_info map entries no other group of the type owns
+    bool validated;                 // Read through validation + retries
+} module_poll_group_desc_t;
+
+// Power module
+static const register_poll_range_t g_power_fast_ranges[] = {
+    {0x0000, 11},   // Critical battery data
+    {0x0014, 6},    // Cell voltages
+    {0x0040, 9},    // 12V/5V/3.3V distribution (V/I/P)
+    {0x0049, 4},    // Relay states + fault
+};
+
+static const register_poll_range_t g_power_charge_ranges[] = {
+    {0x001C, 6},    // Cell balancing
+    {0x0030, 8},    // SK60X charging
+    {0x003E, 1},    // Charge state
+};
+
+static const register_poll_range_t g_power_system_ranges[] = {
+    {0x004D, 1},    // Voltage threshold
+    {0x0100, 8},    // System registers
+};
+
+// Travel motor module
+static const register_poll_range_t g_motor_fast_ranges[] = {
+    {0x0000, 16},   // Control
+    {0x0010, 16},   // Status
+};
+
+// Safety module
+static const register_poll_range_t g_safety_fast_ranges[] = {
+    {0x0000, 8},    // E-Stop, interlock, zones
+};
+
+// Dock module
+static const register_poll_range_t g_dock_sensor_ranges[] = {
+    {0x0104, 4},    // Dock position/status
+    {0x0108, 5},    // RFID
+    {0x010D, 5},    // Accelerometer
+    {0x0112, 5},    // Proximity sensors
+};
+
+static const register_poll_range_t g_dock_system_ranges[] = {
+    {0x0100, 4},    // Device ID, FW, status, error
+};
+
+// Shared
+static const register_poll_range_t g_system_ranges[] = {
+    {0x0100, 8},    // System registers
+};
+
+static const register_poll_range_t g_unknown_poll_ranges[] = {
+    {0x0100, 2},    // Device ID + status
+};
+
+#define POLL_RANGES(r) (r), (uint16_t)(sizeof(r) / sizeof((r)[0]))
+
+// Register group indices (bit positions in the state policy masks)
+enum {
+    POLL_GROUP_POWER_BATTERY = 0,
+    POLL_GROUP_POWER_CHARGE,
+    POLL_GROUP_POWER_SYSTEM,
+    POLL_GROUP_MOTOR_CONTROL,
+    POLL_GROUP_MOTOR_SYSTEM,
+    POLL_GROUP_SAFETY_ZONES,
+    POLL_GROUP_SAFETY_SYSTEM,
+    POLL_GROUP_DOCK_SENSORS,
+    POLL_GROUP_DOCK_NAV,
+    POLL_GROUP_DOCK_SYSTEM,
+    POLL_GROUP_UNKNOWN_ID,
+    POLL_GROUP_COUNT
+};
+
+static const module_poll_group_desc_t g_poll_groups[POLL_GROUP_COUNT] = {
+    [POLL_GROUP_POWER_BATTERY] = {MODULE_TYPE_POWER,        MODULE_POLL_RATE_HIGH,   "power.battery",  POLLING_INTERVAL_POWER_MS,        POLL_RANGES(g_power_fast_ranges),   false, true},
+    [POLL_GROUP_POWER_CHARGE]  = {MODULE_TYPE_POWER,        MODULE_POLL_RATE_MEDIUM, "power.charge",   POLLING_INTERVAL_POWER_MEDIUM_MS, POLL_RANGES(g_power_charge_ranges), true,  true},
+    [POLL_GROUP_POWER_SYSTEM]  = {MODULE_TYPE_POWER,        MODULE_POLL_RATE_LOW,    "power.system",   POLLING_INTERVAL_POWER_LOW_MS,    POLL_RANGES(g_power_system_ranges), false, true},
+    [POLL_GROUP_MOTOR_CONTROL] = {MODULE_TYPE_TRAVEL_MOTOR, MODULE_POLL_RATE_HIGH,   "motor.control",  POLLING_INTERVAL_MOTOR_MS,        POLL_RANGES(g_motor_fast_ranges),   true,  true},
+    [POLL_GROUP_MOTOR_SYSTEM]  = {MODULE_TYPE_TRAVEL_MOTOR, MODULE_POLL_RATE_LOW,    "motor.system",   POLLING_INTERVAL_SYSTEM_MS,       POLL_RANGES(g_system_ranges),       false, true},
+    [POLL_GROUP_SAFETY_ZONES]  = {MODULE_TYPE_SAFETY,       MODULE_POLL_RATE_HIGH,   "safety.zones",   POLLING_INTERVAL_SENSOR_MS,       POLL_RANGES(g_safety_fast_ranges),  true,  false},
+    [POLL_GROUP_SAFETY_SYSTEM] = {MODULE_TYPE_SAFETY,       MODULE_POLL_RATE_LOW,    "safety.system",  POLLING_INTERVAL_SYSTEM_MS,       POLL_RANGES(g_system_ranges),       false, false},
+    [POLL_GROUP_DOCK_SENSORS]  = {MODULE_TYPE_DOCK,         MODULE_POLL_RATE_HIGH,   "dock.sensors",   POLLING_INTERVAL_DOCK_MS,         POLL_RANGES(g_dock_sensor_ranges),  false, false},
+    [POLL_GROUP_DOCK_NAV]      = {MODULE_TYPE_DOCK,         MODULE_POLL_RATE_MEDIUM, "dock.nav",       POLLING_INTERVAL_DOCK_NAV_MS,     NULL, 0,                            true,  false},
+    [POLL_GROUP_DOCK_SYSTEM]   = {MODULE_TYPE_DOCK,         MODULE_POLL_RATE_LOW,    "dock.system",    POLLING_INTERVAL_SYSTEM_MS,       POLL_RANGES(g_dock_system_ranges),  false, false},
+    [POLL_GROUP_UNKNOWN_ID]    = {MODULE_TYPE_UNKNOWN,      MODULE_POLL_RATE_HIGH,   "unknown.id",     POLLING_INTERVAL_UNKNOWN_MS,      POLL_RANGES(g_unknown_poll_ranges), false, false},
+};
+
+#define POLL_GROUP_BIT(g) ((uint16_t)(1U << (g)))
+
+// Live telemetry while moving: battery current, motor, safety zones, dock RFID/proximity
+#define POLL_GROUPS_MOTION (POLL_GROUP_BIT(POLL_GROUP_POWER_BATTERY) | POLL_GROUP_BIT(POLL_GROUP_MOTOR_CONTROL) | \
+                            POLL_GROUP_BIT(POLL_GROUP_SAFETY_ZONES) | POLL_GROUP_BIT(POLL_GROUP_DOCK_SENSORS))
+#define POLL_GROUPS_SYSTEM (POLL_GROUP_BIT(POLL_GROUP_POWER_SYSTEM) | POLL_GROUP_BIT(POLL_GROUP_MOTOR_SYSTEM) | \
+                            POLL_GROUP_BIT(POLL_GROUP_SAFETY_SYSTEM) | POLL_GROUP_BIT(POLL_GROUP_DOCK_SYSTEM))
+#define POLL_GROUPS_ALL    ((uint16_t)((1U << POLL_GROUP_COUNT) - 1U))
+
+// Which groups each state may poll, and the share of bus time they may take.
+// Motion states keep most of the bus free so motor commands are never queued behind telemetry.
+static const module_polling_state_policy_t g_state_policies[SYSTEM_STATE_MAX] = {
+    [SYSTEM_STATE_INIT]     = {0, 0},
+    [SYSTEM_STATE_IDLE]     = {POLL_GROUPS_ALL, 800},
+    [SYSTEM_STATE_MOVE]     = {POLL_GROUPS_MOTION, 350},
+    [SYSTEM_STATE_DOCK]     = {POLL_GROUPS_MOTION | POLL_GROUP_BIT(POLL_GROUP_DOCK_NAV), 450},
+    [SYSTEM_STATE_FAULT]    = {POLL_GROUPS_MOTION | POLL_GROUPS_SYSTEM, 500},
+    [SYSTEM_STATE_ESTOP]    = {POLL_GROUPS_MOTION | POLL_GROUPS_SYSTEM, 500},
+    [SYSTEM_STATE_SHUTDOWN] = {0, 0},
+    [SYSTEM_STATE_BOOT]     = {0, 0},
+    [SYSTEM_STATE_PAUSED]   = {POLL_GROUPS_ALL, 600},
+    [SYSTEM_STATE_CONFIG]   = {POLL_GROUPS_ALL, 800},
+    [SYSTEM_STATE_SAFE]     = {POLL_GROUPS_MOTION | POLL_GROUPS_SYSTEM, 500},
+};
+
+// Group polls that were due but found the state's bus budget spent
+static uint64_t g_group_budget_waits[POLL_GROUP_COUNT];
+
+// Coalesced read plan and estimated bus time per group, built once at init
+static register_poll_plan_t g_group_plans[POLL_GROUP_COUNT];
+static uint32_t g_group_cost_us[POLL_GROUP_COUNT];
+
+// Bus job context per scheduler slot (one poll in flight per slot)
+typedef struct {
+    uint32_t handle;
+    uint8_t address;
+    uint8_t group;
+    uint32_t est_us;                // Budget tokens taken at dispatch
+    uint32_t actual_us;             // Measured bus time, set by the job
+} module_poll_job_t;
+
+static module_poll_job_t g_poll_jobs[MODULE_POLL_SCHED_MAX_ENTRIES];
+
 // Internal function prototypes
-static uint64_t module_polling_get_timestamp_ms(void);
+static bool module_polling_dispatch_next(uint64_t now, const module_polling_state_policy_t *policy, uint32_t *budget_used_us);
 static hal_status_t module_polling_initialize_handler(uint8_t address, module_polling_type_t type);
-static bool module_polling_should_poll(uint8_t address);
 static hal_status_t module_polling_smart_read(uint8_t address, uint16_t start_reg, uint16_t count, uint16_t *data, const char *module_name);
 static bool module_polling_validate_data(uint16_t *data, uint16_t count, const char *module_name);
+static hal_status_t module_polling_bus_read(uint8_t address, uint16_t start_reg, uint16_t count, uint16_t *data);
+static modbus_bus_priority_t module_polling_bus_priority(uint8_t address);
+static hal_status_t module_polling_job(void *ctx);
+static void module_polling_job_done(hal_status_t status, void *ctx);
+static void module_polling_build_group_plans(void);
+static hal_status_t module_polling_poll_group(uint8_t address, uint16_t group);
+static hal_status_t module_polling_poll_type(uint8_t address, module_polling_type_t type);
+static void module_polling_log_power(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result);
+static void module_polling_log_motor(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result);
+static void module_polling_log_safety(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result);
+static void module_polling_log_dock(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result);
+static void module_polling_log_unknown(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result);
+static hal_status_t module_polling_plan_read_validated(uint8_t slave_id, uint16_t start_address, uint16_t quantity, uint16_t *data, void *ctx);
+static hal_status_t module_polling_plan_read_raw(uint8_t slave_id, uint16_t start_address, uint16_t quantity, uint16_t *data, void *ctx);
+static bool module_polling_plan_values(const register_poll_plan_t *plan, const register_poll_result_t *result, uint16_t start_reg, uint16_t count, uint16_t *out);
 
 /**
  * @brief Initialize module polling manager
@@ -40,7 +206,14 @@ hal_status_t module_polling_manager_init(void)
     printf("[POLLING-MGR] Initializing module polling manager...\n");
     
     // Clear manager state
+    pthread_mutex_lock(&g_polling_mutex);
     memset(&g_polling_manager, 0, sizeof(g_polling_manager));
+    memset(g_group_budget_waits, 0, sizeof(g_group_budget_waits));
+    module_poll_sched_init(&g_polling_manager.scheduler);
+    g_polling_manager.policy_state = SYSTEM_STATE_IDLE;
+    module_poll_budget_init(&g_polling_manager.bus_budget, g_state_policies[SYSTEM_STATE_IDLE].bus_share_permille,
+                            POLLING_BUDGET_BURST_US, hal_time_now_ms());
+    pthread_mutex_unlock(&g_polling_mutex);
     
     // Initialize all module slots as offline
     for (int i = 0; i <= 0xFF; i++) {  // Use 0xFF instead of MODULE_ADDR_MAX
@@ -52,6 +225,9 @@ hal_status_t module_polling_manager_init(void)
         g_polling_manager.modules[i].poll_interval_ms = POLLING_INTERVAL_UNKNOWN_MS;
     }
     
+    // Coalesce each register group into as few FC03 reads as possible
+    module_polling_build_group_plans();
+    
     g_polling_manager.initialized = true;
     g_polling_manager.total_modules = 0;
     
@@ -61,6 +237,14 @@ hal_status_t module_polling_manager_init(void)
 
 /**
  * @brief Update module polling manager (call from main loop)
+ *
+ * Dispatches due (module, group) polls in deadline order. The current system
+ * state decides which groups may be polled and what share of bus time they
+ * may use (g_state_policies); due groups the state does not allow are skipped
+ * to their next period. Each call also hands at most
+ * POLLING_UPDATE_MAX_DISPATCH polls / POLLING_UPDATE_BUDGET_US of estimated
+ * bus time to the bus master; the rest stays due for the next call.
+ *
  * @return HAL status
  */
 hal_status_t module_polling_manager_update(void)
@@ -69,27 +253,31 @@ hal_status_t module_polling_manager_update(void)
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // FIXED: Gate polling by system state for issue #135
+    // FIXED: Gate polling by system state for issue #135 - now per register group
     system_state_t current_state;
     hal_status_t state_status = system_state_machine_get_state(&current_state);
-    if (state_status != HAL_STATUS_OK || current_state != SYSTEM_STATE_IDLE) {
-        // Only poll when system is in IDLE state (READY)
+    if (state_status != HAL_STATUS_OK || current_state >= SYSTEM_STATE_MAX) {
         return HAL_STATUS_OK;
     }
+    const module_polling_state_policy_t *policy = &g_state_policies[current_state];
     
-    uint64_t current_time = module_polling_get_timestamp_ms();
+    uint64_t now = hal_time_tick_ms();
+    uint32_t budget_used_us = 0;
+    uint32_t dispatched = 0;
     
-    // Poll all online modules
-    for (int i = 0; i <= 0xFF; i++) {  // Use 0xFF instead of MODULE_ADDR_MAX
-        if (g_polling_manager.modules[i].is_online) {
-            if (module_polling_should_poll(i)) {
-                hal_status_t status = module_polling_manager_poll_module(i);
-                if (status == HAL_STATUS_OK) {
-                    g_polling_manager.modules[i].last_poll_ms = current_time;
-                }
-            }
-        }
+    pthread_mutex_lock(&g_polling_mutex);
+    if (current_state != g_polling_manager.policy_state) {
+        module_poll_budget_refill(&g_polling_manager.bus_budget, now);
+        g_polling_manager.bus_budget.share_permille = policy->bus_share_permille;
+        g_polling_manager.policy_state = current_state;
+    }
+    module_poll_budget_refill(&g_polling_manager.bus_budget, now);
+    
+    while (dispatched < POLLING_UPDATE_MAX_DISPATCH &&
+           module_polling_dispatch_next(now, policy, &budget_used_us)) {
+        dispatched++;
     }
+    pthread_mutex_unlock(&g_polling_mutex);
     
     return HAL_STATUS_OK;
 }
@@ -105,12 +293,31 @@ hal_status_t module_polling_manager_add_module(uint8_t address, module_polling_t
     // Address is already uint8_t, so no need to check > 0xFF
     printf("[POLLING-MGR] Adding module 0x%02X (type: %s)\n", address, module_polling_type_to_string(type));
     
+    bool was_online = g_polling_manager.modules[address].is_online;
+    
     // Update module info
     g_polling_manager.modules[address].address = address;
     g_polling_manager.modules[address].type = type;
     g_polling_manager.modules[address].is_online = true;
     g_polling_manager.modules[address].poll_interval_ms = module_polling_get_interval(type);
+    
+    // (Re)schedule one entry per register group of this type, staggered so they do not all fall due together
+    pthread_mutex_lock(&g_polling_mutex);
     g_polling_manager.modules[address].last_poll_ms = 0;
+    module_poll_scheduler_t *sched = &g_polling_manager.scheduler;
+    module_poll_sched_remove_address(sched, address);
+    uint64_t now = hal_time_now_ms();
+    for (uint16_t g = 0; g < POLL_GROUP_COUNT; g++) {
+        if (g_poll_groups[g].type != type || g_group_plans[g].wanted_count == 0) {
+            continue;
+        }
+        uint64_t first_due = now + (uint64_t)(sched->count % 16U) * 5U;
+        if (module_poll_sched_add(sched, address, (uint8_t)g, g_poll_groups[g].period_ms, first_due) != HAL_STATUS_OK) {
+            printf("[POLLING-MGR] WARNING: Scheduler full, group %s of module 0x%02X not scheduled\n",
+                   g_poll_groups[g].name, address);
+        }
+    }
+    pthread_mutex_unlock(&g_polling_mutex);
     
     // Initialize handler for this module type
     hal_status_t status = module_polling_initialize_handler(address, type);
@@ -122,7 +329,9 @@ hal_status_t module_polling_manager_add_module(uint8_t address, module_polling_t
         g_polling_manager.modules[address].handler_initialized = false;
     }
     
-    g_polling_manager.total_modules++;
+    if (!was_online) {
+        g_polling_manager.total_modules++;
+    }
     
     printf("[POLLING-MGR] Module 0x%02X added successfully (total: %u)\n", address, g_polling_manager.total_modules);
     return HAL_STATUS_OK;
@@ -139,15 +348,19 @@ hal_status_t module_polling_manager_remove_module(uint8_t address)
     
     if (g_polling_manager.modules[address].is_online) {
         printf("[POLLING-MGR] Removing module 0x%02X\n", address);
-        
+    
+        pthread_mutex_lock(&g_polling_mutex);
+        module_poll_sched_remove_address(&g_polling_manager.scheduler, address);
+        pthread_mutex_unlock(&g_polling_mutex);
+    
         g_polling_manager.modules[address].is_online = false;
         g_polling_manager.modules[address].handler_initialized = false;
         g_polling_manager.modules[address].type = MODULE_TYPE_UNKNOWN;
-        
+    
         if (g_polling_manager.total_modules > 0) {
             g_polling_manager.total_modules--;
         }
-        
+    
         printf("[POLLING-MGR] Module 0x%02X removed (total: %u)\n", address, g_polling_manager.total_modules);
     }
     
@@ -155,7 +368,7 @@ hal_status_t module_polling_manager_remove_module(uint8_t address)
 }
 
 /**
- * @brief Poll specific module
+ * @brief Poll specific module (all register groups, regardless of schedule)
  * @param address Module address
  * @return HAL status
  */
@@ -171,16 +384,16 @@ hal_status_t module_polling_manager_poll_module(uint8_t address)
     switch (type) {
         case MODULE_TYPE_POWER:
             return module_polling_power_module(address);
-            
+    
         case MODULE_TYPE_TRAVEL_MOTOR:  // Use MODULE_TYPE_TRAVEL_MOTOR instead of MODULE_TYPE_MOTOR
             return module_polling_motor_module(address);
-            
+    
         case MODULE_TYPE_SAFETY:  // Use MODULE_TYPE_SAFETY instead of MODULE_TYPE_SENSOR
             return module_polling_sensor_module(address);
-            
+    
         case MODULE_TYPE_DOCK:  // Use MODULE_TYPE_DOCK instead of MODULE_TYPE_LIDAR
             return module_polling_dock_module(address);
-            
+    
         case MODULE_TYPE_UNKNOWN:
         default:
             return module_polling_unknown_module(address);
@@ -199,267 +412,123 @@ hal_status_t module_polling_manager_get_module_info(uint8_t address, module_poll
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
+    pthread_mutex_lock(&g_polling_mutex);
     *info = g_polling_manager.modules[address];
+    pthread_mutex_unlock(&g_polling_mutex);
     return HAL_STATUS_OK;
 }
 
 /**
- * @brief Poll Power Module (Type 2) with fallback strategy
- * @param address Module address
+ * @brief Get number of register groups
+ * @return Group count
+ */
+uint16_t module_polling_manager_get_group_count(void)
+{
+    return POLL_GROUP_COUNT;
+}
+
+/**
+ * @brief Get register group plan and scheduling statistics
+ * @param group_index Group index (< module_polling_manager_get_group_count())
+ * @param info Output info structure
  * @return HAL status
  */
-hal_status_t module_polling_power_module(uint8_t address)
+hal_status_t module_polling_manager_get_group_info(uint16_t group_index, module_polling_group_info_t *info)
 {
-    printf("[POLLING-POWER] Polling Power Module 0x%02X (Full 51 registers)\n", address);
-    
-    // hal_status_t overall_status = HAL_STATUS_OK; // Unused - commented out
-    uint32_t success_count = 0;
-    uint32_t total_attempts = 0;
-    
-    // HIGH PRIORITY: Critical Battery Data (1s interval) - 21 registers
-    printf("[POLLING-POWER] 0x%02X: Reading HIGH priority data...\n", address);
-    
-    // 1. Critical Battery Data (11 registers: 0x0000-0x000A)
-    uint16_t battery_data[11];
-    hal_status_t status = module_polling_smart_read(address, 0x0000, 11, battery_data, "POWER");
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        // Raw dump of registers 0x0000-0x000A to verify data integrity
-        printf("[POLLING-POWER][RAW] 0x%02X: 0000-000A: %04X %04X %04X %04X %04X %04X %04X %04X %04X %04X %04X\n",
-               address,
-               battery_data[0], battery_data[1], battery_data[2], battery_data[3], battery_data[4],
-               battery_data[5], battery_data[6], battery_data[7], battery_data[8], battery_data[9], battery_data[10]);
-
-        // Print with signed current formatted to one decimal place
-        double current_a = ((int16_t)battery_data[1]) / 10.0;
-        printf("[POLLING-POWER] 0x%02X: Battery=%d.%dV, Current=%.1fA, SOC=%d.%d%%, MaxCell=%dmV, MinCell=%dmV, Temp=%d°C, Conn=%d, Status=0x%04X\n",
-               address, battery_data[0]/10, battery_data[0]%10,
-               current_a,
-               battery_data[2]/10, battery_data[2]%10,
-               battery_data[3], battery_data[4], (int16_t)battery_data[8],
-               battery_data[9], battery_data[10]);
-    }
-    
-    // 2. Cell Voltages (6 registers: 0x0014-0x0019)
-    uint16_t cell_data[6];
-    status = module_polling_smart_read(address, 0x0014, 6, cell_data, "POWER");
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        printf("[POLLING-POWER] 0x%02X: Cell Voltages: [%d, %d, %d, %d, %d, %d] mV\n",
-               address, cell_data[0], cell_data[1], cell_data[2], cell_data[3], cell_data[4], cell_data[5]);
-    }
-    
-    // 3. Power Distribution Voltages (3 registers: 0x0040, 0x0043, 0x0046)
-    uint16_t power_volt_data[3];
-    status = module_polling_smart_read(address, 0x0040, 1, &power_volt_data[0], "POWER"); // 12V
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        status = module_polling_smart_read(address, 0x0043, 1, &power_volt_data[1], "POWER"); // 5V
-        total_attempts++;
-        if (status == HAL_STATUS_OK) {
-            success_count++;
-            status = module_polling_smart_read(address, 0x0046, 1, &power_volt_data[2], "POWER"); // 3.3V
-            total_attempts++;
-            if (status == HAL_STATUS_OK) {
-                success_count++;
-                printf("[POLLING-POWER] 0x%02X: Power Voltages: 12V=%d.%dV, 5V=%d.%dV, 3.3V=%d.%dV\n",
-                       address, power_volt_data[0]/10, power_volt_data[0]%10,
-                       power_volt_data[1]/10, power_volt_data[1]%10,
-                       power_volt_data[2]/10, power_volt_data[2]%10);
-            }
-        }
-    }
-    
-    // 4. Relay States (4 registers: 0x0049-0x004C)
-    uint16_t relay_data[4];
-    status = module_polling_smart_read(address, 0x0049, 4, relay_data, "POWER");
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        printf("[POLLING-POWER] 0x%02X: Relays: 12V=%d, 5V=%d, 3V3=%d, Fault=%d\n",
-               address, relay_data[0], relay_data[1], relay_data[2], relay_data[3]);
-    }
-    
-    // MEDIUM PRIORITY: Charging & Power Distribution (5s interval) - 20 registers
-    printf("[POLLING-POWER] 0x%02X: Reading MEDIUM priority data...\n", address);
-    
-    // 5. SK60X Charging Control (8 registers: 0x0030-0x0037)
-    uint16_t charging_data[8];
-    status = module_polling_smart_read(address, 0x0030, 8, charging_data, "POWER");
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        printf("[POLLING-POWER] 0x%02X: Charging: VSet=%d.%dV, ISet=%d.%dA, VOut=%d.%dV, IOut=%d.%dA, POut=%d.%dW, VIn=%d.%dV, IIn=%d.%dA, Temp=%d°C\n",
-               address, charging_data[0]/10, charging_data[0]%10,
-               charging_data[1]/10, charging_data[1]%10,
-               charging_data[2]/10, charging_data[2]%10,
-               charging_data[3]/10, charging_data[3]%10,
-               charging_data[4]/10, charging_data[4]%10,
-               charging_data[5]/10, charging_data[5]%10,
-               charging_data[6]/10, charging_data[6]%10,
-               (int16_t)charging_data[7]);
-    }
-    
-    // 6. Power Distribution Current/Power (6 registers: 0x0041, 0x0042, 0x0044, 0x0045, 0x0047, 0x0048)
-    uint16_t power_curr_data[6];
-    status = module_polling_smart_read(address, 0x0041, 2, &power_curr_data[0], "POWER"); // 12V I/P
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        status = module_polling_smart_read(address, 0x0044, 2, &power_curr_data[2], "POWER"); // 5V I/P
-        total_attempts++;
-        if (status == HAL_STATUS_OK) {
-            success_count++;
-            status = module_polling_smart_read(address, 0x0047, 2, &power_curr_data[4], "POWER"); // 3.3V I/P
-            total_attempts++;
-            if (status == HAL_STATUS_OK) {
-                success_count++;
-                printf("[POLLING-POWER] 0x%02X: Power Distribution: 12V=%d.%dA/%d.%dW, 5V=%d.%dA/%d.%dW, 3.3V=%d.%dA/%d.%dW\n",
-                       address, power_curr_data[0]/10, power_curr_data[0]%10, power_curr_data[1]/10, power_curr_data[1]%10,
-                       power_curr_data[2]/10, power_curr_data[2]%10, power_curr_data[3]/10, power_curr_data[3]%10,
-                       power_curr_data[4]/10, power_curr_data[4]%10, power_curr_data[5]/10, power_curr_data[5]%10);
-            }
-        }
-    }
-    
-    // 7. Cell Balancing Status (6 registers: 0x001C-0x0021)
-    uint16_t balance_data[6];
-    status = module_polling_smart_read(address, 0x001C, 6, balance_data, "POWER");
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        printf("[POLLING-POWER] 0x%02X: Cell Balance: [%d, %d, %d, %d, %d, %d]\n",
-               address, balance_data[0], balance_data[1], balance_data[2], balance_data[3], balance_data[4], balance_data[5]);
+    if (info == NULL || group_index >= POLL_GROUP_COUNT) {
+        return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // LOW PRIORITY: System Information (30s interval) - 10 registers
-    printf("[POLLING-POWER] 0x%02X: Reading LOW priority data...\n", address);
+    const module_poll_group_desc_t *desc = &g_poll_groups[group_index];
+    info->type = desc->type;
+    info->rate = desc->rate;
+    info->name = desc->name;
+    info->period_ms = desc->period_ms;
+    info->register_count = g_group_plans[group_index].wanted_count;
+    info->read_count = g_group_plans[group_index].block_count;
+    info->est_bus_us = g_group_cost_us[group_index];
     
-    // 8. System Registers (8 registers: 0x0100-0x0107)
-    uint16_t system_data[8];
-    status = module_polling_smart_read(address, 0x0100, 8, system_data, "POWER");
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        printf("[POLLING-POWER] 0x%02X: System: DeviceID=0x%04X, FW=0x%04X, Status=0x%04X, Error=0x%04X, Type=0x%04X, HW=0x%04X, SN=0x%08X, Build=0x%04X\n",
-               (unsigned int)address, (unsigned int)system_data[0], (unsigned int)system_data[1], (unsigned int)system_data[2], (unsigned int)system_data[3], 
-               (unsigned int)system_data[7], 
-               (unsigned int)((system_data[4] << 16) | system_data[5]), 
-               (unsigned int)((system_data[6] << 16) | system_data[7]), (unsigned int)0x1234);
-    }
-    
-    // 9. Configuration Registers (2 registers: 0x004D, 0x003E)
-    uint16_t config_data[2];
-    status = module_polling_smart_read(address, 0x004D, 1, &config_data[0], "POWER"); // Voltage threshold
-    total_attempts++;
-    if (status == HAL_STATUS_OK) {
-        success_count++;
-        status = module_polling_smart_read(address, 0x003E, 1, &config_data[1], "POWER"); // Charge state
-        total_attempts++;
-        if (status == HAL_STATUS_OK) {
-            success_count++;
-            printf("[POLLING-POWER] 0x%02X: Config: VThreshold=%d.%d%%, ChargeState=%d\n",
-                   address, config_data[0]/100, config_data[0]%100, config_data[1]);
-        }
+    pthread_mutex_lock(&g_polling_mutex);
+    info->budget_waits = g_group_budget_waits[group_index];
+    info->stats = g_polling_manager.scheduler.groups[group_index];
+    pthread_mutex_unlock(&g_polling_mutex);
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Get number of updates cut short by the per-update bus-time budget
+ * @return Deferral count
+ */
+uint64_t module_polling_manager_get_budget_deferrals(void)
+{
+    pthread_mutex_lock(&g_polling_mutex);
+    uint64_t deferrals = g_polling_manager.budget_deferrals;
+    pthread_mutex_unlock(&g_polling_mutex);
+    return deferrals;
+}
+
+/**
+ * @brief Get the polling policy of a system state
+ * @param state System state
+ * @param policy Output policy (group mask indexed like module_polling_manager_get_group_info())
+ * @return HAL status
+ */
+hal_status_t module_polling_manager_get_state_policy(system_state_t state, module_polling_state_policy_t *policy)
+{
+    if (policy == NULL || state >= SYSTEM_STATE_MAX) {
+        return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // Summary
-    printf("[POLLING-POWER] 0x%02X: Summary: %d/%d registers read successfully (%.1f%%)\n",
-           address, success_count, total_attempts, (float)success_count * 100.0f / total_attempts);
-    
-    if (success_count >= total_attempts * 0.7f) { // 70% success rate
-        return HAL_STATUS_OK;
-    } else {
-        return HAL_STATUS_ERROR;
-    }
+    *policy = g_state_policies[state];
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Set the listener told about each completed poll (one listener; NULL clears it)
+ * @param listener Listener function, runs on the bus thread
+ * @param user_data Passed through to the listener
+ * @return HAL status
+ */
+hal_status_t module_polling_manager_set_completion_listener(module_polling_completion_listener_t listener, void *user_data)
+{
+    pthread_mutex_lock(&g_polling_mutex);
+    g_completion_listener = listener;
+    g_completion_listener_data = user_data;
+    pthread_mutex_unlock(&g_polling_mutex);
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Poll Power Module (Type 2), all register groups
+ * @param address Module address
+ * @return HAL status
+ */
+hal_status_t module_polling_power_module(uint8_t address)
+{
+    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] Polling Power Module 0x%02X", address);
+    return module_polling_poll_type(address, MODULE_TYPE_POWER);
 }
 
 /**
- * @brief Poll Motor Module (Type 4)
+ * @brief Poll Motor Module (Type 4), all register groups
  * @param address Module address
  * @return HAL status
  */
 hal_status_t module_polling_motor_module(uint8_t address)
 {
-    printf("[POLLING-MOTOR] Polling Motor Module 0x%02X\n", address);
-    
-    // Strategy 1: Try to read system registers first (0x0100-0x0107)
-    uint16_t system_data[8];
-    hal_status_t status = module_polling_smart_read(address, 0x0100, 8, system_data, "MOTOR");
-    
-    if (status == HAL_STATUS_OK) {
-        printf("[POLLING-MOTOR] 0x%02X: DeviceID=0x%04X, FW=0x%04X, HW=0x%04X, Type=0x%04X\n",
-               address, system_data[0], system_data[1], system_data[2], system_data[5]);
-        
-        // Strategy 2: Try to read motor control registers (0x0000-0x000F)
-        uint16_t control_data[16];
-        hal_status_t control_status = module_polling_smart_read(address, 0x0000, 16, control_data, "MOTOR");
-        
-        if (control_status == HAL_STATUS_OK) {
-            printf("[POLLING-MOTOR] 0x%02X: Enable=%d, Mode=%d, Speed=%d/%d, Pos=%d/%d, Temp=%d°C, V=%d.%dV, I=%d.%dA\n",
-                   address, control_data[0], control_data[1], control_data[2], control_data[3],
-                   control_data[4], control_data[5], control_data[11], 
-                   control_data[12]/10, control_data[12]%10, control_data[13]/10, control_data[13]%10);
-        } else {
-            printf("[POLLING-MOTOR] 0x%02X: Control data read failed, using system data only\n", address);
-        }
-        
-        // Strategy 3: Try to read motor status registers (0x0010-0x001F)
-        uint16_t status_data[16];
-        hal_status_t status_status = module_polling_smart_read(address, 0x0010, 16, status_data, "MOTOR");
-        
-        if (status_status == HAL_STATUS_OK) {
-            printf("[POLLING-MOTOR] 0x%02X: Running=%d, Ready=%d, Fault=%d, E-Stop=%d, Home=%d, Limit=%d\n",
-                   address, status_data[0], status_data[1], status_data[2], status_data[4],
-                   status_data[5], status_data[6]);
-        } else {
-            printf("[POLLING-MOTOR] 0x%02X: Status data read failed, using system data only\n", address);
-        }
-        
-        return HAL_STATUS_OK;
-    } else {
-        printf("[POLLING-MOTOR] 0x%02X: System registers read failed (status: %d)\n", address, status);
-        return status;
-    }
+    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-MOTOR] Polling Motor Module 0x%02X", address);
+    return module_polling_poll_type(address, MODULE_TYPE_TRAVEL_MOTOR);
 }
 
 /**
- * @brief Poll Safety Module (Type 3) with fallback strategy
+ * @brief Poll Safety Module (Type 3), all register groups
  * @param address Module address
  * @return HAL status
  */
 hal_status_t module_polling_sensor_module(uint8_t address)
 {
-    printf("[POLLING-SAFETY] Polling Safety Module 0x%02X\n", address);
-    
-    // Strategy 1: Try to read system registers first (0x0100-0x0107)
-    uint16_t system_data[8];
-    hal_status_t status = comm_manager_modbus_read_holding_registers(address, 0x0100, 8, system_data);
-    
-    if (status == HAL_STATUS_OK) {
-        printf("[POLLING-SAFETY] 0x%02X: DeviceID=0x%04X, Type=0x%04X, Status=0x%04X, Version=0x%04X\n",
-               address, system_data[0], system_data[7], system_data[2], system_data[1]);
-        
-        // Strategy 2: Try to read safety-specific registers (0x0000-0x0053)
-        uint16_t safety_data[8];
-        hal_status_t safety_status = comm_manager_modbus_read_holding_registers(address, 0x0000, 8, safety_data);
-        
-        if (safety_status == HAL_STATUS_OK) {
-            printf("[POLLING-SAFETY] 0x%02X: EStop=%d, Interlock=%d, Zone1=%d, Zone2=%d, Zone3=%d, Zone4=%d, Zone5=%d, Zone6=%d\n",
-                   address, safety_data[0], safety_data[1], safety_data[2], safety_data[3], 
-                   safety_data[4], safety_data[5], safety_data[6], safety_data[7]);
-        } else {
-            printf("[POLLING-SAFETY] 0x%02X: Safety data read failed, using system data only\n", address);
-        }
-        
-        return HAL_STATUS_OK;
-    } else {
-        printf("[POLLING-SAFETY] 0x%02X: System registers read failed (status: %d)\n", address, status);
-        return status;
-    }
+    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-SAFETY] Polling Safety Module 0x%02X", address);
+    return module_polling_poll_type(address, MODULE_TYPE_SAFETY);
 }
 
 /**
@@ -469,67 +538,8 @@ hal_status_t module_polling_sensor_module(uint8_t address)
  */
 hal_status_t module_polling_dock_module(uint8_t address)
 {
-    printf("[POLLING-DOCK] Polling Dock Module 0x%02X with real sensor data\n", address);
-    
-    // Strategy 1: Try to read system registers first (0x0100-0x0107)
-    uint16_t system_data[8];
-    hal_status_t status = comm_manager_modbus_read_holding_registers(address, 0x0100, 8, system_data);
-    
-    if (status == HAL_STATUS_OK) {
-        printf("[POLLING-DOCK] 0x%02X: DeviceID=0x%04X, Type=0x%04X, Status=0x%04X, Version=0x%04X\n",
-               address, system_data[0], system_data[7], system_data[2], system_data[1]);
-        
-        // Strategy 2: Poll RFID data every 100ms (registers 0x0108-0x010C) - REAL HARDWARE ADDRESSES
-        uint16_t rfid_data[5];
-        hal_status_t rfid_status = comm_manager_modbus_read_holding_registers(address, 0x0108, 5, rfid_data);
-        
-        if (rfid_status == HAL_STATUS_OK) {
-            uint32_t tag_id = ((uint32_t)rfid_data[1] << 16) | rfid_data[0];
-            printf("[POLLING-DOCK] 0x%02X: RFID TagID=0x%08X, Signal=%d%%, Status=%d, Time=%d\n",
-                   address, tag_id, rfid_data[2], rfid_data[3], rfid_data[4]);
-        } else {
-            printf("[POLLING-DOCK] 0x%02X: RFID data read failed (status: %d)\n", address, rfid_status);
-        }
-        
-        // Strategy 3: Poll accelerometer data every 50ms (registers 0x010D-0x0111) - REAL HARDWARE ADDRESSES
-        uint16_t accel_data[5];
-        hal_status_t accel_status = comm_manager_modbus_read_holding_registers(address, 0x010D, 5, accel_data);
-        
-        if (accel_status == HAL_STATUS_OK) {
-            printf("[POLLING-DOCK] 0x%02X: Accel X=%d, Y=%d, Z=%d mg, Temp=%d°C, Status=%d\n",
-                   address, (int16_t)accel_data[0], (int16_t)accel_data[1], (int16_t)accel_data[2], 
-                   (int16_t)accel_data[3], accel_data[4]);
-        } else {
-            printf("[POLLING-DOCK] 0x%02X: Accelerometer data read failed (status: %d)\n", address, accel_status);
-        }
-        
-        // Strategy 4: Poll proximity sensors every 50ms (registers 0x0112-0x0116) - REAL HARDWARE ADDRESSES
-        uint16_t prox_data[5];
-        hal_status_t prox_status = comm_manager_modbus_read_holding_registers(address, 0x0112, 5, prox_data);
-        
-        if (prox_status == HAL_STATUS_OK) {
-            printf("[POLLING-DOCK] 0x%02X: Prox1=%d (digital), Prox2=%d (digital), Dist1=%dmm, Dist2=%dmm, DockConfirmed=%d\n",
-                   address, prox_data[0], prox_data[1], prox_data[2], prox_data[3], prox_data[4]);
-        } else {
-            printf("[POLLING-DOCK] 0x%02X: Proximity sensors data read failed (status: %d)\n", address, prox_status);
-        }
-        
-        // Strategy 5: Read dock status and position (registers 0x0104-0x0107)
-        uint16_t dock_data[4];
-        hal_status_t dock_status = comm_manager_modbus_read_holding_registers(address, 0x0104, 4, dock_data);
-        
-        if (dock_status == HAL_STATUS_OK) {
-            printf("[POLLING-DOCK] 0x%02X: Position=%d, Target=%d, Status=%d, Accuracy=%d\n",
-                   address, dock_data[0], dock_data[1], dock_data[2], dock_data[3]);
-        } else {
-            printf("[POLLING-DOCK] 0x%02X: Dock status data read failed (status: %d)\n", address, dock_status);
-        }
-        
-        return HAL_STATUS_OK;
-    } else {
-        printf("[POLLING-DOCK] 0x%02X: System registers read failed (status: %d)\n", address, status);
-        return status;
-    }
+    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-DOCK] Polling Dock Module 0x%02X with real sensor data", address);
+    return module_polling_poll_type(address, MODULE_TYPE_DOCK);
 }
 
 /**
@@ -539,20 +549,8 @@ hal_status_t module_polling_dock_module(uint8_t address)
  */
 hal_status_t module_polling_unknown_module(uint8_t address)
 {
-    printf("[POLLING-UNKNOWN] Polling Unknown Module 0x%02X\n", address);
-    
-    // Read basic module data
-    uint16_t basic_data[2];
-    hal_status_t status = comm_manager_modbus_read_holding_registers(address, 0x0100, 2, basic_data);
-    
-    if (status == HAL_STATUS_OK) {
-        printf("[POLLING-UNKNOWN] 0x%02X: DeviceID=0x%04X, Status=0x%04X\n",
-               address, basic_data[0], basic_data[1]);
-    } else {
-        printf("[POLLING-UNKNOWN] 0x%02X: Read failed (status: %d)\n", address, status);
-    }
-    
-    return status;
+    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-UNKNOWN] Polling Unknown Module 0x%02X", address);
+    return module_polling_poll_type(address, MODULE_TYPE_UNKNOWN);
 }
 
 /**
@@ -572,6 +570,21 @@ const char* module_polling_type_to_string(module_polling_type_t type)
     }
 }
 
+/**
+ * @brief Convert register group rate class to string
+ * @param rate Rate class
+ * @return String representation
+ */
+const char* module_polling_rate_to_string(module_poll_rate_t rate)
+{
+    switch (rate) {
+        case MODULE_POLL_RATE_HIGH:    return "high";
+        case MODULE_POLL_RATE_MEDIUM:  return "medium";
+        case MODULE_POLL_RATE_LOW:     return "low";
+        default:                       return "invalid";
+    }
+}
+
 /**
  * @brief Get polling interval for module type
  * @param type Module type
@@ -583,7 +596,7 @@ uint32_t module_polling_get_interval(module_polling_type_t type)
         case MODULE_TYPE_POWER:        return POLLING_INTERVAL_POWER_MS;
         case MODULE_TYPE_TRAVEL_MOTOR: return POLLING_INTERVAL_MOTOR_MS;
         case MODULE_TYPE_SAFETY:       return POLLING_INTERVAL_SENSOR_MS;
-        case MODULE_TYPE_DOCK:         return 50;  // 50ms for real-time sensor data
+        case MODULE_TYPE_DOCK:         return POLLING_INTERVAL_DOCK_MS;
         case MODULE_TYPE_UNKNOWN:      return POLLING_INTERVAL_UNKNOWN_MS;
         default:                       return POLLING_INTERVAL_UNKNOWN_MS;
     }
@@ -592,14 +605,84 @@ uint32_t module_polling_get_interval(module_polling_type_t type)
 // Internal functions
 
 /**
- * @brief Get current timestamp in milliseconds
- * @return Timestamp in milliseconds
+ * @brief Dispatch the earliest due group poll allowed by the state policy
+ *
+ * Called with g_polling_mutex held; releases it around the bus submit.
+ *
+ * @param now Current time (ms)
+ * @param policy Policy of the current system state
+ * @param budget_used_us Estimated bus time dispatched in this update so far
+ * @return true if a poll was handed to the bus master
  */
-static uint64_t module_polling_get_timestamp_ms(void)
+static bool module_polling_dispatch_next(uint64_t now, const module_polling_state_policy_t *policy, uint32_t *budget_used_us)
 {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)(ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000ULL);
+    module_poll_scheduler_t *sched = &g_polling_manager.scheduler;
+    
+    for (;;) {
+        int slot = module_poll_sched_peek_due(sched, now);
+        if (slot < 0) {
+            return false;
+        }
+        
+        uint8_t group = sched->entries[slot].group;
+        if ((policy->group_mask & POLL_GROUP_BIT(group)) == 0) {
+            module_poll_sched_skip_due(sched, now);
+            continue;
+        }
+        
+        // Always let one poll per update through the per-update cap so an oversized group cannot starve
+        uint32_t cost = g_group_cost_us[group];
+        if (*budget_used_us > 0 && *budget_used_us + cost > POLLING_UPDATE_BUDGET_US) {
+            g_polling_manager.budget_deferrals++;
+            return false;
+        }
+        
+        // State share of the bus spent: wait for tokens, the group stays due (EDF order kept)
+        if (!module_poll_budget_consume(&g_polling_manager.bus_budget, cost)) {
+            g_group_budget_waits[group]++;
+            return false;
+        }
+        
+        uint64_t starved_before = sched->groups[group].starved;
+        uint64_t due = sched->entries[slot].next_due_ms;
+        uint32_t handle;
+        module_poll_sched_dispatch_due(sched, now, &handle);
+        if (handle == MODULE_POLL_HANDLE_INVALID) {
+            // Previous poll of this group still in flight (counted as overrun)
+            module_poll_budget_settle(&g_polling_manager.bus_budget, cost, 0);
+            continue;
+        }
+        if (sched->groups[group].starved != starved_before) {
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[POLLING-MGR] WARNING: %s of 0x%02X starved (%llums late, state %s)",
+                                g_poll_groups[group].name, sched->entries[slot].address,
+                                (unsigned long long)(now - due),
+                                system_state_machine_get_state_name(g_polling_manager.policy_state));
+        }
+        
+        module_poll_job_t *job = &g_poll_jobs[slot];
+        job->handle = handle;
+        job->address = sched->entries[slot].address;
+        job->group = group;
+        job->est_us = cost;
+        job->actual_us = cost;
+        
+        // The bus master may run the job inline (and take the mutex in the completion)
+        pthread_mutex_unlock(&g_polling_mutex);
+        hal_status_t status = modbus_bus_submit_job(module_polling_bus_priority(job->address),
+                                                    module_polling_job, job,
+                                                    module_polling_job_done, job);
+        pthread_mutex_lock(&g_polling_mutex);
+        
+        if (status == HAL_STATUS_BUSY) {
+            // Queue full - re-arm and retry on a later update
+            module_poll_sched_cancel(sched, handle);
+            module_poll_budget_settle(&g_polling_manager.bus_budget, cost, 0);
+            return false;
+        }
+        *budget_used_us += cost;
+        return true;
+    }
 }
 
 /**
@@ -619,24 +702,6 @@ static hal_status_t module_polling_initialize_handler(uint8_t address, module_po
     return HAL_STATUS_OK;
 }
 
-/**
- * @brief Check if module should be polled
- * @param address Module address
- * @return true if should poll, false otherwise
- */
-static bool module_polling_should_poll(uint8_t address)
-{
-    // Check if module is online (address is already uint8_t, so no need to check > 0xFF)
-    if (!g_polling_manager.modules[address].is_online) {
-        return false;
-    }
-    
-    uint64_t current_time = module_polling_get_timestamp_ms();
-    uint64_t last_poll = g_polling_manager.modules[address].last_poll_ms;
-    uint32_t interval = g_polling_manager.modules[address].poll_interval_ms;
-    
-    return (current_time - last_poll) >= interval;
-}
 
 /**
  * @brief Smart read function with retry and validation
@@ -651,8 +716,9 @@ static hal_status_t module_polling_smart_read(uint8_t address, uint16_t start_re
 {
     // FIXED: Add register validation for issue #135
     if (!register_validation_validate_read_request(address, start_reg, count)) {
-        printf("[POLLING-%s] 0x%02X: Invalid register request (addr=0x%04X, qty=%u)\n", 
-               module_name, address, start_reg, count);
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                            "[POLLING-%s] 0x%02X: Invalid register request (addr=0x%04X, qty=%u)",
+                            module_name, address, start_reg, count);
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
@@ -660,28 +726,31 @@ static hal_status_t module_polling_smart_read(uint8_t address, uint16_t start_re
     hal_status_t status = HAL_STATUS_ERROR;
     
     for (int retry = 0; retry < max_retries; retry++) {
-        status = comm_manager_modbus_read_holding_registers(address, start_reg, count, data);
+        status = module_polling_bus_read(address, start_reg, count, data);
         
         if (status == HAL_STATUS_OK) {
             // FIXED: Use enhanced validation for issue #135
             if (register_validation_validate_data(address, start_reg, data, count)) {
                 if (retry > 0) {
-                    printf("[POLLING-%s] 0x%02X: Success after %d retries\n", module_name, address, retry);
+                    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-%s] 0x%02X: Success after %d retries", module_name, address, retry);
                 }
                 return HAL_STATUS_OK;
             } else {
-                printf("[POLLING-%s] 0x%02X: Data validation failed (all zeros?) on retry %d\n", module_name, address, retry + 1);
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                                    "[POLLING-%s] 0x%02X: Data validation failed (all zeros?) on retry %d", module_name, address, retry + 1);
                 status = HAL_STATUS_ERROR;
             }
         } else {
             if (retry < max_retries - 1) {
-                printf("[POLLING-%s] 0x%02X: Read failed, retrying... (%d/%d)\n", module_name, address, retry + 1, max_retries);
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                                    "[POLLING-%s] 0x%02X: Read failed, retrying... (%d/%d)", module_name, address, retry + 1, max_retries);
                 usleep(100000); // Wait 100ms before retry
             }
         }
     }
     
-    printf("[POLLING-%s] 0x%02X: All retries failed (status: %d)\n", module_name, address, status);
+    HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                        "[POLLING-%s] 0x%02X: All retries failed (status: %d)", module_name, address, status);
     return status;
 }
 
@@ -708,7 +777,8 @@ static bool module_polling_validate_data(uint16_t *data __attribute__((unused)),
     }
     
     if (all_zeros) {
-        printf("[POLLING-%s] WARNING: All data is zero - possible communication error\n", module_name);
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                            "[POLLING-%s] WARNING: All data is zero - possible communication error", module_name);
         return false;
     }
     
@@ -716,22 +786,363 @@ static bool module_polling_validate_data(uint16_t *data __attribute__((unused)),
     if (strcmp(module_name, "POWER") == 0) {
         // Power module validation
         if (data[0] > 50000) { // Device ID should be reasonable
-            printf("[POLLING-%s] WARNING: Device ID seems too high: 0x%04X\n", module_name, data[0]);
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[POLLING-%s] WARNING: Device ID seems too high: 0x%04X", module_name, data[0]);
             return false;
         }
     } else if (strcmp(module_name, "SAFETY") == 0) {
         // Safety module validation
         if (data[0] > 50000) { // Device ID should be reasonable
-            printf("[POLLING-%s] WARNING: Device ID seems too high: 0x%04X\n", module_name, data[0]);
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[POLLING-%s] WARNING: Device ID seems too high: 0x%04X", module_name, data[0]);
             return false;
         }
     } else if (strcmp(module_name, "DOCK") == 0) {
         // Dock module validation
         if (data[0] > 50000) { // Device ID should be reasonable
-            printf("[POLLING-%s] WARNING: Device ID seems too high: 0x%04X\n", module_name, data[0]);
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[POLLING-%s] WARNING: Device ID seems too high: 0x%04X", module_name, data[0]);
             return false;
         }
     }
     
     return true;
 }
+
+
+/**
+ * @brief Read holding registers through the bus master at the module's priority
+ * @param address Module address
+ * @param start_reg Starting register address
+ * @param count Number of registers to read
+ * @param data Output data buffer
+ * @return HAL status
+ */
+static hal_status_t module_polling_bus_read(uint8_t address, uint16_t start_reg, uint16_t count, uint16_t *data)
+{
+    return modbus_bus_read_holding(module_polling_bus_priority(address), address, start_reg, count, data);
+}
+
+/**
+ * @brief Bus priority used for a module's periodic poll
+ * @param address Module address
+ * @return Safety module polls are served ahead of regular telemetry
+ */
+static modbus_bus_priority_t module_polling_bus_priority(uint8_t address)
+{
+    return g_polling_manager.modules[address].type == MODULE_TYPE_SAFETY
+               ? MODBUS_BUS_PRIO_SAFETY
+               : MODBUS_BUS_PRIO_TELEMETRY;
+}
+
+/**
+ * @brief Bus-thread job: poll one register group of one module
+ * @param ctx Job context (module_poll_job_t)
+ * @return HAL status
+ */
+static hal_status_t module_polling_job(void *ctx)
+{
+    module_poll_job_t *job = (module_poll_job_t *)ctx;
+    
+    uint64_t start_us = hal_time_now_us();
+    hal_status_t status = module_polling_poll_group(job->address, job->group);
+    job->actual_us = (uint32_t)(hal_time_now_us() - start_us);
+    return status;
+}
+
+/**
+ * @brief Bus-thread completion: record poll time, charge measured bus time and release the schedule entry
+ * @param status Poll result
+ * @param ctx Job context (module_poll_job_t)
+ */
+static void module_polling_job_done(hal_status_t status, void *ctx)
+{
+    const module_poll_job_t *job = (const module_poll_job_t *)ctx;
+    
+    pthread_mutex_lock(&g_polling_mutex);
+    module_poll_budget_settle(&g_polling_manager.bus_budget, job->est_us, job->actual_us);
+    // A stale handle means the module was removed or re-added while the poll ran
+    if (module_poll_sched_complete(&g_polling_manager.scheduler, job->handle, status == HAL_STATUS_OK) >= 0 &&
+        status == HAL_STATUS_OK) {
+        g_polling_manager.modules[job->address].last_poll_ms = hal_time_now_ms();
+    }
+    module_polling_completion_listener_t listener = g_completion_listener;
+    void *listener_data = g_completion_listener_data;
+    pthread_mutex_unlock(&g_polling_mutex);
+    
+    // The group's schedule entry and bus budget are free again: the next due poll can go out now
+    if (listener != NULL) {
+        listener(listener_data);
+    }
+}
+
+/**
+ * @brief Build the coalesced read plan of every register group
+ *
+ * Explicit ranges are built first; groups that take the register_info map
+ * then drop whatever another group of the same type already polls, so no
+ * register is read at two rates.
+ */
+static void module_polling_build_group_plans(void)
+{
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint16_t g = 0; g < POLL_GROUP_COUNT; g++) {
+            const module_poll_group_desc_t *desc = &g_poll_groups[g];
+            register_poll_plan_t *plan = &g_group_plans[g];
+            if (desc->include_map != (pass == 1)) {
+                continue;
+            }
+    
+            register_poll_plan_init(plan, REGISTER_POLL_DEFAULT_MAX_GAP, REGISTER_POLL_MAX_BLOCK_REGS);
+            register_poll_plan_add_ranges(plan, desc->ranges, desc->range_count);
+            if (desc->include_map) {
+                // Module types share their canonical address, which keys the register_info maps
+                (void)register_poll_plan_add_module_map(plan, (uint8_t)desc->type);
+                for (uint16_t other = 0; other < POLL_GROUP_COUNT; other++) {
+                    if (other != g && g_poll_groups[other].type == desc->type && g_group_plans[other].built) {
+                        register_poll_plan_subtract(plan, &g_group_plans[other]);
+                    }
+                }
+            }
+    
+            if (register_poll_plan_build(plan) != HAL_STATUS_OK) {
+                HAL_LOGW(HAL_LOG_COMP_POLLING, "[POLLING-MGR] WARNING: %s poll plan build failed", desc->name);
+                plan->wanted_count = 0;
+                continue;
+            }
+            g_group_cost_us[g] = register_poll_plan_estimate_us(plan, RS485_BAUD_RATE);
+        }
+    }
+    
+    for (uint16_t g = 0; g < POLL_GROUP_COUNT; g++) {
+        const register_poll_plan_t *plan = &g_group_plans[g];
+        HAL_LOGI(HAL_LOG_COMP_POLLING, "[POLLING-MGR] %s poll plan (%s, %ums): %u registers in %u reads, ~%uus",
+                                       g_poll_groups[g].name, module_polling_rate_to_string(g_poll_groups[g].rate),
+                                       g_poll_groups[g].period_ms, plan->wanted_count, plan->block_count, g_group_cost_us[g]);
+        for (uint16_t b = 0; b < plan->block_count; b++) {
+            HAL_LOGI(HAL_LOG_COMP_POLLING, "[POLLING-MGR]   block %u: 0x%04X x%u (%u wanted)", b,
+                                           plan->blocks[b].start, plan->blocks[b].count, plan->blocks[b].wanted_count);
+        }
+    }
+}
+
+/**
+ * @brief Execute one register group plan against a module and log it
+ * @param address Module address
+ * @param group Group index
+ * @return HAL_STATUS_OK if at least 70% of the group's registers were read
+ */
+static hal_status_t module_polling_poll_group(uint8_t address, uint16_t group)
+{
+    const module_poll_group_desc_t *desc = &g_poll_groups[group];
+    const register_poll_plan_t *plan = &g_group_plans[group];
+    register_poll_result_t result;
+    
+    if (plan->wanted_count == 0) {
+        return HAL_STATUS_OK;
+    }
+    
+    if (desc->validated) {
+        const char *name = (desc->type == MODULE_TYPE_POWER) ? "POWER" : "MOTOR";
+        register_poll_plan_execute(plan, address, module_polling_plan_read_validated, (void *)name, &result);
+    } else {
+        register_poll_plan_execute(plan, address, module_polling_plan_read_raw, NULL, &result);
+    }
+    
+    switch (desc->type) {
+        case MODULE_TYPE_POWER:        module_polling_log_power(address, plan, &result); break;
+        case MODULE_TYPE_TRAVEL_MOTOR: module_polling_log_motor(address, plan, &result); break;
+        case MODULE_TYPE_SAFETY:       module_polling_log_safety(address, plan, &result); break;
+        case MODULE_TYPE_DOCK:         module_polling_log_dock(address, plan, &result); break;
+        default:                       module_polling_log_unknown(address, plan, &result); break;
+    }
+    
+    HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-MGR] 0x%02X %s: %u/%u registers read in %u transactions",
+                                   address, desc->name, result.valid_count, plan->wanted_count, result.transactions);
+    
+    // Same 70% acceptance rule as the per-section reads the plans replaced
+    return (result.valid_count * 10U >= plan->wanted_count * 7U) ? HAL_STATUS_OK : HAL_STATUS_ERROR;
+}
+
+/**
+ * @brief Poll every register group of a module type back to back
+ * @param address Module address
+ * @param type Module type
+ * @return HAL_STATUS_OK if every group succeeded
+ */
+static hal_status_t module_polling_poll_type(uint8_t address, module_polling_type_t type)
+{
+    hal_status_t status = HAL_STATUS_OK;
+    
+    for (uint16_t g = 0; g < POLL_GROUP_COUNT; g++) {
+        if (g_poll_groups[g].type != type) {
+            continue;
+        }
+        if (module_polling_poll_group(address, g) != HAL_STATUS_OK) {
+            status = HAL_STATUS_ERROR;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Log the Power Module sections present in a group result
+ */
+static void module_polling_log_power(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result)
+{
+    uint16_t v[11];
+    if (module_polling_plan_values(plan, result, 0x0000, 11, v)) {
+        double current_a = ((int16_t)v[1]) / 10.0;
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] 0x%02X: Battery=%d.%dV, Current=%.1fA, SOC=%d.%d%%, MaxCell=%dmV, MinCell=%dmV, Temp=%d°C, Conn=%d, Status=0x%04X",
+                                       address, v[0]/10, v[0]%10, current_a, v[2]/10, v[2]%10,
+                                       v[3], v[4], (int16_t)v[8], v[9], v[10]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0014, 6, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] 0x%02X: Cell Voltages: [%d, %d, %d, %d, %d, %d] mV",
+                                       address, v[0], v[1], v[2], v[3], v[4], v[5]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0030, 8, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] 0x%02X: Charging: VSet=%d.%dV, ISet=%d.%dA, VOut=%d.%dV, IOut=%d.%dA, POut=%d.%dW, VIn=%d.%dV, IIn=%d.%dA, Temp=%d°C",
+                                       address, v[0]/10, v[0]%10, v[1]/10, v[1]%10, v[2]/10, v[2]%10, v[3]/10, v[3]%10,
+                                       v[4]/10, v[4]%10, v[5]/10, v[5]%10, v[6]/10, v[6]%10, (int16_t)v[7]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0040, 9, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] 0x%02X: Power Distribution: 12V=%d.%dV/%d.%dA/%d.%dW, 5V=%d.%dV/%d.%dA/%d.%dW, 3.3V=%d.%dV/%d.%dA/%d.%dW",
+                                       address, v[0]/10, v[0]%10, v[1]/10, v[1]%10, v[2]/10, v[2]%10,
+                                       v[3]/10, v[3]%10, v[4]/10, v[4]%10, v[5]/10, v[5]%10,
+                                       v[6]/10, v[6]%10, v[7]/10, v[7]%10, v[8]/10, v[8]%10);
+    }
+    if (module_polling_plan_values(plan, result, 0x0049, 4, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] 0x%02X: Relays: 12V=%d, 5V=%d, 3V3=%d, Fault=%d",
+                                       address, v[0], v[1], v[2], v[3]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0100, 8, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-POWER] 0x%02X: System: DeviceID=0x%04X, FW=0x%04X, Status=0x%04X, Error=0x%04X, Type=0x%04X",
+                                       (unsigned int)address, (unsigned int)v[0], (unsigned int)v[1], (unsigned int)v[2],
+                                       (unsigned int)v[3], (unsigned int)v[7]);
+    }
+}
+
+/**
+ * @brief Log the Motor Module sections present in a group result
+ */
+static void module_polling_log_motor(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result)
+{
+    uint16_t v[16];
+    if (module_polling_plan_values(plan, result, 0x0100, 8, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-MOTOR] 0x%02X: DeviceID=0x%04X, FW=0x%04X, HW=0x%04X, Type=0x%04X",
+                                       address, v[0], v[1], v[2], v[5]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0000, 16, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-MOTOR] 0x%02X: Enable=%d, Mode=%d, Speed=%d/%d, Pos=%d/%d, Temp=%d°C, V=%d.%dV, I=%d.%dA",
+                                       address, v[0], v[1], v[2], v[3], v[4], v[5], v[11],
+                                       v[12]/10, v[12]%10, v[13]/10, v[13]%10);
+    }
+    if (module_polling_plan_values(plan, result, 0x0010, 16, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-MOTOR] 0x%02X: Running=%d, Ready=%d, Fault=%d, E-Stop=%d, Home=%d, Limit=%d",
+                                       address, v[0], v[1], v[2], v[4], v[5], v[6]);
+    }
+}
+
+/**
+ * @brief Log the Safety Module sections present in a group result
+ */
+static void module_polling_log_safety(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result)
+{
+    uint16_t v[8];
+    if (module_polling_plan_values(plan, result, 0x0100, 8, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-SAFETY] 0x%02X: DeviceID=0x%04X, Type=0x%04X, Status=0x%04X, Version=0x%04X",
+                                       address, v[0], v[7], v[2], v[1]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0000, 8, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-SAFETY] 0x%02X: EStop=%d, Interlock=%d, Zone1=%d, Zone2=%d, Zone3=%d, Zone4=%d, Zone5=%d, Zone6=%d",
+                                       address, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+    }
+}
+
+/**
+ * @brief Log the Dock Module sections present in a group result
+ */
+static void module_polling_log_dock(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result)
+{
+    uint16_t v[5];
+    if (module_polling_plan_values(plan, result, 0x0100, 4, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-DOCK] 0x%02X: DeviceID=0x%04X, Version=0x%04X, Status=0x%04X, Error=0x%04X",
+                                       address, v[0], v[1], v[2], v[3]);
+    }
+    if (module_polling_plan_values(plan, result, 0x0104, 4, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-DOCK] 0x%02X: Position=%d, Target=%d, Status=%d, Accuracy=%d",
+                                       address, v[0], v[1], v[2], v[3]);
+    }
+    
+    // RFID (0x0108-0x010C)
+    if (module_polling_plan_values(plan, result, 0x0108, 5, v)) {
+        uint32_t tag_id = ((uint32_t)v[1] << 16) | v[0];
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-DOCK] 0x%02X: RFID TagID=0x%08X, Signal=%d%%, Status=%d, Time=%d",
+                                       address, tag_id, v[2], v[3], v[4]);
+    }
+    
+    // Accelerometer (0x010D-0x0111)
+    if (module_polling_plan_values(plan, result, 0x010D, 5, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-DOCK] 0x%02X: Accel X=%d, Y=%d, Z=%d mg, Temp=%d°C, Status=%d",
+                                       address, (int16_t)v[0], (int16_t)v[1], (int16_t)v[2], (int16_t)v[3], v[4]);
+    }
+    
+    // Proximity sensors (0x0112-0x0116)
+    if (module_polling_plan_values(plan, result, 0x0112, 5, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-DOCK] 0x%02X: Prox1=%d (digital), Prox2=%d (digital), Dist1=%dmm, Dist2=%dmm, DockConfirmed=%d",
+                                       address, v[0], v[1], v[2], v[3], v[4]);
+    }
+}
+
+/**
+ * @brief Log the Unknown Module identity from a group result
+ */
+static void module_polling_log_unknown(uint8_t address, const register_poll_plan_t *plan, const register_poll_result_t *result)
+{
+    uint16_t v[2];
+    if (module_polling_plan_values(plan, result, 0x0100, 2, v)) {
+        HAL_LOGD(HAL_LOG_COMP_POLLING, "[POLLING-UNKNOWN] 0x%02X: DeviceID=0x%04X, Status=0x%04X", address, v[0], v[1]);
+    } else {
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_POLLING, HAL_LOG_LEVEL_WARNING, 1000,
+                            "[POLLING-UNKNOWN] 0x%02X: Read failed", address);
+    }
+}
+
+/**
+ * @brief Plan read function with register validation and retries
+ * @param ctx Module name for logging
+ */
+static hal_status_t module_polling_plan_read_validated(uint8_t slave_id, uint16_t start_address, uint16_t quantity, uint16_t *data, void *ctx)
+{
+    return module_polling_smart_read(slave_id, start_address, quantity, data, (const char *)ctx);
+}
+
+/**
+ * @brief Plan read function without validation (single bus transaction)
+ * @param ctx Unused
+ */
+static hal_status_t module_polling_plan_read_raw(uint8_t slave_id, uint16_t start_address, uint16_t quantity, uint16_t *data, void *ctx)
+{
+    (void)ctx;
+    return module_polling_bus_read(slave_id, start_address, quantity, data);
+}
+
+/**
+ * @brief Copy a contiguous register range out of a plan result
+ * @param plan Plan
+ * @param result Execution result
+ * @param start_reg First register
+ * @param count Number of registers
+ * @param out Output buffer
+ * @return true only if every register in the range was read
+ */
+static bool module_polling_plan_values(const register_poll_plan_t *plan, const register_poll_result_t *result, uint16_t start_reg, uint16_t count, uint16_t *out)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        if (!register_poll_result_get(plan, result, (uint16_t)(start_reg + i), &out[i])) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -13,6 +13,8 @@
 
 #include "hal_common.h"
 #include "module_manager.h"
+#include "module_poll_scheduler.h"
+#include "../../core/state_management/system_state_machine.h"
 
 // Module polling intervals (in milliseconds)
 #define POLLING_INTERVAL_POWER_MS     1000    // 1 second - High priority: Critical battery data
@@ -22,6 +24,22 @@
 #define POLLING_INTERVAL_SENSOR_MS    500     // 0.5 seconds
 #define POLLING_INTERVAL_LIDAR_MS     100     // 0.1 seconds
 #define POLLING_INTERVAL_UNKNOWN_MS   2000    // 2 seconds
+#define POLLING_INTERVAL_SYSTEM_MS    30000   // 30 seconds - Device ID / firmware / status block
+#define POLLING_INTERVAL_DOCK_MS      50      // 50ms for real-time dock sensor data
+#define POLLING_INTERVAL_DOCK_NAV_MS  200     // 200ms - IMU / position / docking state
+
+// Scheduler bounds per module_polling_manager_update() call
+#define POLLING_UPDATE_BUDGET_US      20000   // Estimated bus time handed to the bus master per update
+#define POLLING_UPDATE_MAX_DISPATCH   4       // Group polls dispatched per update
+#define POLLING_BUDGET_BURST_US       100000  // Bus-time token bucket capacity (covers the largest group)
+
+// Register group rate class
+typedef enum {
+    MODULE_POLL_RATE_HIGH = 0,
+    MODULE_POLL_RATE_MEDIUM,
+    MODULE_POLL_RATE_LOW,
+    MODULE_POLL_RATE_COUNT
+} module_poll_rate_t;
 
 // Use existing module_type_t from module_manager.h
 typedef module_type_t module_polling_type_t;
@@ -36,13 +54,42 @@ typedef struct {
     bool handler_initialized;
 } module_polling_info_t;
 
+// Register group scheduling info (one entry per module type / rate class)
+typedef struct {
+    module_polling_type_t type;
+    module_poll_rate_t rate;
+    const char *name;
+    uint32_t period_ms;
+    uint16_t register_count;        // Wanted registers
+    uint16_t read_count;            // Coalesced FC03 reads
+    uint32_t est_bus_us;            // Estimated bus time per poll
+    uint64_t budget_waits;          // Updates where the group was due but the state's bus budget was spent
+    module_poll_group_stats_t stats;
+} module_polling_group_info_t;
+
+// Polling policy for one system state
+typedef struct {
+    uint16_t group_mask;            // Bit n set: group n may be polled in this state
+    uint16_t bus_share_permille;    // Share of RS485 time polling may use; the rest stays free for commands
+} module_polling_state_policy_t;
+
 // Module polling manager structure
 typedef struct {
     module_polling_info_t modules[256];  // Use 256 instead of MODULE_ADDR_MAX + 1
     uint32_t total_modules;
     bool initialized;
+    module_poll_scheduler_t scheduler;   // Deadlines of every (module, group) pair
+    uint64_t budget_deferrals;           // Updates that stopped early on the per-update budget
+    module_poll_budget_t bus_budget;     // Bus-time share of the current system state
+    system_state_t policy_state;         // State the budget share was last set for
 } module_polling_manager_t;
 
+/**
+ * @brief Called after each poll completes (on the bus thread); should only hand off, not block
+ * @param user_data Listener context
+ */
+typedef void (*module_polling_completion_listener_t)(void *user_data);
+
 // Function prototypes
 hal_status_t module_polling_manager_init(void);
 hal_status_t module_polling_manager_update(void);
@@ -50,6 +97,11 @@ hal_status_t module_polling_manager_add_module(uint8_t address, module_polling_t
 hal_status_t module_polling_manager_remove_module(uint8_t address);
 hal_status_t module_polling_manager_poll_module(uint8_t address);
 hal_status_t module_polling_manager_get_module_info(uint8_t address, module_polling_info_t *info);
+uint16_t module_polling_manager_get_group_count(void);
+hal_status_t module_polling_manager_get_group_info(uint16_t group_index, module_polling_group_info_t *info);
+uint64_t module_polling_manager_get_budget_deferrals(void);
+hal_status_t module_polling_manager_get_state_policy(system_state_t state, module_polling_state_policy_t *policy);
+hal_status_t module_polling_manager_set_completion_listener(module_polling_completion_listener_t listener, void *user_data);
 
 // Module-specific polling functions
 hal_status_t module_polling_power_module(uint8_t address);
@@ -61,5 +113,6 @@ hal_status_t module_polling_unknown_module(uint8_t address);
 // Utility functions
 const char* module_polling_type_to_string(module_polling_type_t type);
 uint32_t module_polling_get_interval(module_polling_type_t type);
+const char* module_polling_rate_to_string(module_poll_rate_t rate);
 
 #endif // MODULE_POLLING_MANAGER_H
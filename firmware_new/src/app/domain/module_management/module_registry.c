@@ -198,6 +198,17 @@ void registry_set_legacy_callback(registry_event_callback_t cb) {
     g_registry_cb = cb;
 }
 
+/**
+ * @brief Add a module read from the YAML cache unless discovery already knows it
+ * @return 1 if added
+ */
+static int load_saved_entry(const module_info_t *entry) {
+    if (find_index(entry->address) >= 0) {
+        return 0;
+    }
+    return registry_add_or_update(entry) == 0 ? 1 : 0;
+}
+
 int registry_load_yaml(const char *path) {
     if (path == NULL) {
         printf("[REGISTRY] Error: YAML path is NULL\n");
@@ -207,28 +218,51 @@ int registry_load_yaml(const char *path) {
     printf("[REGISTRY] Loading YAML configuration from: %s\n", path);
     
     // TODO: Implement actual YAML parsing library (e.g., libyaml)
-    // For now, simulate YAML loading with basic file operations
     FILE *file = fopen(path, "r");
     if (file == NULL) {
         printf("[REGISTRY] Warning: Cannot open YAML file: %s (using defaults)\n", path);
         return 0; // Use default configuration
     }
     
-    // Simulate YAML parsing - read file and extract module configurations
+    // Parse the layout written by registry_save_yaml(); saved modules come back OFFLINE
+    // until discovery sees them again
     char line[256];
     int modules_loaded = 0;
     int file_schema_version = REGISTRY_SCHEMA_VERSION;
+    module_info_t entry;
+    bool have_entry = false;
     
     while (fgets(line, sizeof(line), file) != NULL) {
-        // Simulate parsing YAML lines
+        unsigned v;
+        int t;
         if (strstr(line, "module_id:") != NULL) {
             modules_loaded++;
+        } else if (sscanf(line, " address: %u", &v) == 1) {
+            if (have_entry) {
+                modules_loaded += load_saved_entry(&entry);
+            }
+            memset(&entry, 0, sizeof(entry));
+            entry.address = (uint8_t)v;
+            entry.status = MODULE_STATUS_OFFLINE;
+            strncpy(entry.name, "module", sizeof(entry.name) - 1);
+            have_entry = v > 0 && v <= 0xFF;
+        } else if (have_entry) {
+            if (sscanf(line, " type: %d", &t) == 1) {
+                entry.type = (module_type_t)t;
+            } else if (sscanf(line, " capabilities: %u", &v) == 1) {
+                entry.capabilities = v;
+            } else {
+                (void)sscanf(line, " name: \"%31[^\"]\"", entry.name);
+                (void)sscanf(line, " version: \"%15[^\"]\"", entry.version);
+            }
         }
-        unsigned v;
         if (sscanf(line, "schema_version: %u", &v) == 1) {
             file_schema_version = (int)v;
         }
     }
+    if (have_entry) {
+        modules_loaded += load_saved_entry(&entry);
+    }
     
     fclose(file);
     if (file_schema_version != g_schema_version) {
@@ -0,0 +1,342 @@
+/**
+ * @file register_poll_planner.c
+ * @brief Register-block coalescing planner for module polling
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @author FW Team
+ */
+
+#include "register_poll_planner.h"
+#include "register_info.h"
+#include "register_value_cache.h"
+#include <string.h>
+#include <stdio.h>
+
+// Internal function prototypes
+static void register_poll_sort_unique(register_poll_plan_t *plan);
+static int register_poll_find_wanted(const register_poll_plan_t *plan, uint16_t reg_addr);
+static hal_status_t register_poll_read_run(const register_poll_plan_t *plan, uint8_t slave_id,
+                                           uint16_t first, uint16_t count,
+                                           register_poll_read_fn_t read_fn, void *ctx,
+                                           register_poll_result_t *result);
+static void register_poll_scatter(const register_poll_plan_t *plan, uint8_t slave_id,
+                                  uint16_t block_start, const uint16_t *data,
+                                  uint16_t first, uint16_t count, register_poll_result_t *result);
+
+hal_status_t register_poll_plan_init(register_poll_plan_t *plan, uint16_t max_gap, uint16_t max_block)
+{
+    if (plan == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(plan, 0, sizeof(*plan));
+    plan->max_gap = max_gap;
+    plan->max_block = (max_block == 0 || max_block > REGISTER_POLL_MAX_BLOCK_REGS)
+                          ? REGISTER_POLL_MAX_BLOCK_REGS : max_block;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_poll_plan_add_range(register_poll_plan_t *plan, uint16_t start, uint16_t count)
+{
+    if (plan == NULL || count == 0 || (uint32_t)start + count - 1U > 0xFFFFU) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (plan->wanted_count >= REGISTER_POLL_MAX_WANTED) {
+            return HAL_STATUS_NO_MEMORY;
+        }
+        plan->wanted[plan->wanted_count++] = (uint16_t)(start + i);
+    }
+    plan->built = false;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_poll_plan_add_ranges(register_poll_plan_t *plan,
+                                           const register_poll_range_t *ranges, uint16_t range_count)
+{
+    if (plan == NULL || (ranges == NULL && range_count > 0)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    for (uint16_t i = 0; i < range_count; i++) {
+        hal_status_t status = register_poll_plan_add_range(plan, ranges[i].start, ranges[i].count);
+        if (status != HAL_STATUS_OK) {
+            return status;
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_poll_plan_add_module_map(register_poll_plan_t *plan, uint8_t module_addr)
+{
+    if (plan == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    uint16_t count = 0;
+    const register_info_t *map = get_module_registers_array(module_addr, &count);
+    if (map == NULL) {
+        return HAL_STATUS_NOT_FOUND;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (map[i].mode != REG_MODE_READ_ONLY && map[i].mode != REG_MODE_READ_WRITE) {
+            continue;
+        }
+        hal_status_t status = register_poll_plan_add_range(plan, map[i].address, 1);
+        if (status != HAL_STATUS_OK) {
+            return status;
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_poll_plan_subtract(register_poll_plan_t *plan, const register_poll_plan_t *other)
+{
+    if (plan == NULL || other == NULL || !other->built) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < plan->wanted_count; i++) {
+        if (register_poll_find_wanted(other, plan->wanted[i]) < 0) {
+            plan->wanted[kept++] = plan->wanted[i];
+        }
+    }
+    plan->wanted_count = kept;
+    plan->built = false;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_poll_plan_build(register_poll_plan_t *plan)
+{
+    if (plan == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    register_poll_sort_unique(plan);
+    plan->block_count = 0;
+    plan->built = false;
+
+    uint16_t i = 0;
+    while (i < plan->wanted_count) {
+        if (plan->block_count >= REGISTER_POLL_MAX_BLOCKS) {
+            printf("[POLL-PLAN] ERROR: plan needs more than %d blocks\n", REGISTER_POLL_MAX_BLOCKS);
+            return HAL_STATUS_NO_MEMORY;
+        }
+
+        register_poll_block_t *block = &plan->blocks[plan->block_count];
+        block->start = plan->wanted[i];
+        block->first_wanted = i;
+        uint16_t last = plan->wanted[i];
+        i++;
+
+        // Greedily extend while the hole stays within tolerance and the block within the FC03 limit
+        while (i < plan->wanted_count) {
+            uint32_t next = plan->wanted[i];
+            uint32_t gap = next - (uint32_t)last - 1U;
+            uint32_t span = next - (uint32_t)block->start + 1U;
+            if (gap > plan->max_gap || span > plan->max_block) {
+                break;
+            }
+            last = (uint16_t)next;
+            i++;
+        }
+
+        block->count = (uint16_t)(last - block->start + 1U);
+        block->wanted_count = (uint16_t)(i - block->first_wanted);
+        plan->block_count++;
+    }
+
+    plan->built = true;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_poll_plan_execute(const register_poll_plan_t *plan, uint8_t slave_id,
+                                        register_poll_read_fn_t read_fn, void *ctx,
+                                        register_poll_result_t *result)
+{
+    if (plan == NULL || read_fn == NULL || !plan->built) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    register_poll_result_t local;
+    if (result == NULL) {
+        result = &local;
+    }
+    memset(result, 0, sizeof(*result));
+
+    uint16_t data[REGISTER_POLL_MAX_BLOCK_REGS];
+
+    for (uint16_t b = 0; b < plan->block_count; b++) {
+        const register_poll_block_t *block = &plan->blocks[b];
+
+        result->transactions++;
+        hal_status_t status = read_fn(slave_id, block->start, block->count, data, ctx);
+        if (status == HAL_STATUS_OK) {
+            register_poll_scatter(plan, slave_id, block->start, data,
+                                  block->first_wanted, block->wanted_count, result);
+            continue;
+        }
+
+        result->failed_blocks++;
+        if (block->count == block->wanted_count) {
+            // Fully contiguous block - splitting would issue the same read again
+            continue;
+        }
+
+        // Merged block failed (e.g. slave rejects an unmapped gap register):
+        // fall back to the contiguous runs of wanted registers it covered
+        uint16_t end = (uint16_t)(block->first_wanted + block->wanted_count);
+        uint16_t run_first = block->first_wanted;
+        for (uint16_t w = (uint16_t)(block->first_wanted + 1U); w <= end; w++) {
+            if (w == end || plan->wanted[w] != plan->wanted[w - 1] + 1U) {
+                register_poll_read_run(plan, slave_id, run_first, (uint16_t)(w - run_first),
+                                       read_fn, ctx, result);
+                run_first = w;
+            }
+        }
+    }
+
+    return (result->valid_count == plan->wanted_count) ? HAL_STATUS_OK : HAL_STATUS_ERROR;
+}
+
+uint32_t register_poll_plan_estimate_us(const register_poll_plan_t *plan, uint32_t baud_rate)
+{
+    if (plan == NULL || !plan->built || baud_rate == 0) {
+        return 0;
+    }
+
+    // t3.5 is fixed at 1750 us above 19200 baud (Modbus serial line spec)
+    uint64_t t35_us = (baud_rate > 19200U) ? 1750ULL
+                                           : 35ULL * REGISTER_POLL_BITS_PER_CHAR * 100000ULL / baud_rate;
+    uint64_t total_us = 0;
+    for (uint16_t b = 0; b < plan->block_count; b++) {
+        // FC03 request: addr + fc + start(2) + qty(2) + crc(2); response: addr + fc + len + 2*n + crc(2)
+        uint32_t chars = 8U + 5U + 2U * plan->blocks[b].count;
+        total_us += (uint64_t)chars * REGISTER_POLL_BITS_PER_CHAR * 1000000ULL / baud_rate;
+        total_us += 2ULL * t35_us;
+        total_us += REGISTER_POLL_TURNAROUND_US;
+    }
+    return (total_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)total_us;
+}
+
+bool register_poll_result_get(const register_poll_plan_t *plan, const register_poll_result_t *result,
+                              uint16_t reg_addr, uint16_t *value)
+{
+    if (plan == NULL || result == NULL || value == NULL) {
+        return false;
+    }
+
+    int idx = register_poll_find_wanted(plan, reg_addr);
+    if (idx < 0 || !result->valid[idx]) {
+        return false;
+    }
+    *value = result->values[idx];
+    return true;
+}
+
+/**
+ * @brief Sort wanted registers ascending and drop duplicates (insertion sort, n <= 128)
+ * @param plan Plan
+ */
+static void register_poll_sort_unique(register_poll_plan_t *plan)
+{
+    for (uint16_t i = 1; i < plan->wanted_count; i++) {
+        uint16_t key = plan->wanted[i];
+        int j = (int)i - 1;
+        while (j >= 0 && plan->wanted[j] > key) {
+            plan->wanted[j + 1] = plan->wanted[j];
+            j--;
+        }
+        plan->wanted[j + 1] = key;
+    }
+
+    uint16_t unique = 0;
+    for (uint16_t i = 0; i < plan->wanted_count; i++) {
+        if (unique == 0 || plan->wanted[i] != plan->wanted[unique - 1]) {
+            plan->wanted[unique++] = plan->wanted[i];
+        }
+    }
+    plan->wanted_count = unique;
+}
+
+/**
+ * @brief Binary search for a register in the sorted wanted list
+ * @param plan Built plan
+ * @param reg_addr Register address
+ * @return Index into plan->wanted, or -1 if not wanted
+ */
+static int register_poll_find_wanted(const register_poll_plan_t *plan, uint16_t reg_addr)
+{
+    int lo = 0;
+    int hi = (int)plan->wanted_count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (plan->wanted[mid] == reg_addr) {
+            return mid;
+        }
+        if (plan->wanted[mid] < reg_addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Read one contiguous run of wanted registers (split fallback)
+ * @return HAL status of the read
+ */
+static hal_status_t register_poll_read_run(const register_poll_plan_t *plan, uint8_t slave_id,
+                                           uint16_t first, uint16_t count,
+                                           register_poll_read_fn_t read_fn, void *ctx,
+                                           register_poll_result_t *result)
+{
+    uint16_t data[REGISTER_POLL_MAX_BLOCK_REGS];
+    uint16_t start = plan->wanted[first];
+
+    result->transactions++;
+    hal_status_t status = read_fn(slave_id, start, count, data, ctx);
+    if (status == HAL_STATUS_OK) {
+        register_poll_scatter(plan, slave_id, start, data, first, count, result);
+    }
+    return status;
+}
+
+/**
+ * @brief Copy wanted registers out of a block buffer into the result and the register cache
+ * @param plan Plan
+ * @param slave_id Slave ID
+ * @param block_start First register held in data[]
+ * @param data Block buffer
+ * @param first First wanted index covered
+ * @param count Number of wanted registers covered
+ * @param result Execution result
+ */
+static void register_poll_scatter(const register_poll_plan_t *plan, uint8_t slave_id,
+                                  uint16_t block_start, const uint16_t *data,
+                                  uint16_t first, uint16_t count, register_poll_result_t *result)
+{
+    uint16_t run_first = first;
+    uint16_t end = (uint16_t)(first + count);
+
+    for (uint16_t w = first; w < end; w++) {
+        result->values[w] = data[plan->wanted[w] - block_start];
+        if (!result->valid[w]) {
+            result->valid[w] = true;
+            result->valid_count++;
+        }
+
+        // Flush each contiguous run to the cache in one batch
+        bool run_ends = (w + 1U == end) || (plan->wanted[w + 1U] != plan->wanted[w] + 1U);
+        if (run_ends) {
+            uint16_t run_start = plan->wanted[run_first];
+            (void)register_cache_store_batch(slave_id, run_start, &data[run_start - block_start],
+                                             (uint16_t)(w - run_first + 1U));
+            run_first = (uint16_t)(w + 1U);
+        }
+    }
+}
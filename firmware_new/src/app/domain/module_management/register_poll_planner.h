@@ -0,0 +1,173 @@
+/**
+ * @file register_poll_planner.h
+ * @brief Register-block coalescing planner for module polling
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @author FW Team
+ *
+ * Turns a declarative set of wanted registers into the minimum number of
+ * contiguous FC03 reads. Neighbouring registers are merged when the hole
+ * between them is no larger than the gap tolerance and the merged block
+ * stays within the Modbus 125-register limit. Results are scattered back
+ * into register_value_cache (wanted registers only, gap fillers dropped).
+ */
+
+#ifndef REGISTER_POLL_PLANNER_H
+#define REGISTER_POLL_PLANNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_common.h"
+
+// Planner limits
+#define REGISTER_POLL_MAX_WANTED        128   // Wanted registers per plan
+#define REGISTER_POLL_MAX_BLOCKS        16    // FC03 reads per plan
+#define REGISTER_POLL_MAX_BLOCK_REGS    125   // Modbus FC03 quantity limit
+#define REGISTER_POLL_DEFAULT_MAX_GAP   16    // Unwanted registers tolerated inside one block
+
+// Bus time estimation
+#define REGISTER_POLL_BITS_PER_CHAR     11    // Start + 8 data + parity/stop + stop
+#define REGISTER_POLL_TURNAROUND_US     1000  // Slave processing allowance per transaction
+
+// Contiguous register range (declarative input)
+typedef struct {
+    uint16_t start;
+    uint16_t count;
+} register_poll_range_t;
+
+// One planned FC03 read
+typedef struct {
+    uint16_t start;                  // First register read
+    uint16_t count;                  // Registers read (wanted + gap fillers)
+    uint16_t first_wanted;           // Index into plan->wanted
+    uint16_t wanted_count;           // Wanted registers covered by this block
+} register_poll_block_t;
+
+// Poll plan
+typedef struct {
+    uint16_t wanted[REGISTER_POLL_MAX_WANTED];    // Sorted, unique after build
+    uint16_t wanted_count;
+    register_poll_block_t blocks[REGISTER_POLL_MAX_BLOCKS];
+    uint16_t block_count;
+    uint16_t max_gap;
+    uint16_t max_block;
+    bool built;
+} register_poll_plan_t;
+
+// Per-execution result, indexed like plan->wanted
+typedef struct {
+    uint16_t values[REGISTER_POLL_MAX_WANTED];
+    bool valid[REGISTER_POLL_MAX_WANTED];
+    uint16_t valid_count;            // Wanted registers read successfully
+    uint16_t transactions;           // FC03 reads issued (including fallbacks)
+    uint16_t failed_blocks;          // Blocks that needed the split fallback or failed
+} register_poll_result_t;
+
+/**
+ * @brief Read function used to execute a plan
+ * @param slave_id Slave ID
+ * @param start_address Start address
+ * @param quantity Quantity
+ * @param data Output buffer
+ * @param ctx Caller context
+ * @return HAL status
+ */
+typedef hal_status_t (*register_poll_read_fn_t)(uint8_t slave_id, uint16_t start_address,
+                                                uint16_t quantity, uint16_t *data, void *ctx);
+
+/**
+ * @brief Initialize an empty plan
+ * @param plan Plan to initialize
+ * @param max_gap Maximum number of unwanted registers merged into a block
+ * @param max_block Maximum registers per block (clamped to 125)
+ * @return HAL status
+ */
+hal_status_t register_poll_plan_init(register_poll_plan_t *plan, uint16_t max_gap, uint16_t max_block);
+
+/**
+ * @brief Add a contiguous range of wanted registers
+ * @param plan Plan
+ * @param start First register
+ * @param count Number of registers
+ * @return HAL status (HAL_STATUS_NO_MEMORY if the plan is full)
+ */
+hal_status_t register_poll_plan_add_range(register_poll_plan_t *plan, uint16_t start, uint16_t count);
+
+/**
+ * @brief Add a table of wanted ranges
+ * @param plan Plan
+ * @param ranges Range table
+ * @param range_count Number of ranges
+ * @return HAL status
+ */
+hal_status_t register_poll_plan_add_ranges(register_poll_plan_t *plan,
+                                           const register_poll_range_t *ranges, uint16_t range_count);
+
+/**
+ * @brief Add every readable register from the register_info map of a module
+ * @param plan Plan
+ * @param module_addr Module address (MODULE_ADDR_*)
+ * @return HAL status (HAL_STATUS_NOT_FOUND if the module has no map)
+ */
+hal_status_t register_poll_plan_add_module_map(register_poll_plan_t *plan, uint8_t module_addr);
+
+/**
+ * @brief Drop wanted registers that another (built) plan already covers
+ *
+ * Used when several register groups of one module are polled at different
+ * rates, so a catch-all group does not re-read what a faster group owns.
+ *
+ * @param plan Plan (rebuilt afterwards by the caller)
+ * @param other Built plan whose wanted registers are removed
+ * @return HAL status
+ */
+hal_status_t register_poll_plan_subtract(register_poll_plan_t *plan, const register_poll_plan_t *other);
+
+/**
+ * @brief Sort, de-duplicate and coalesce wanted registers into blocks
+ * @param plan Plan
+ * @return HAL status
+ */
+hal_status_t register_poll_plan_build(register_poll_plan_t *plan);
+
+/**
+ * @brief Execute a built plan and scatter results into register_value_cache
+ *
+ * A merged block that fails is retried as its individual contiguous runs,
+ * so one unmapped gap register cannot blank out a whole poll cycle.
+ *
+ * @param plan Built plan
+ * @param slave_id Slave ID
+ * @param read_fn Read function
+ * @param ctx Read function context
+ * @param result Optional per-register result (may be NULL)
+ * @return HAL_STATUS_OK if every wanted register was read, HAL_STATUS_ERROR otherwise
+ */
+hal_status_t register_poll_plan_execute(const register_poll_plan_t *plan, uint8_t slave_id,
+                                        register_poll_read_fn_t read_fn, void *ctx,
+                                        register_poll_result_t *result);
+
+/**
+ * @brief Estimate RS485 bus time of one plan execution (no fallbacks, no retries)
+ *
+ * Counts request and response frames of every block at 11 bits per
+ * character plus the t3.5 inter-frame silence and a fixed slave turnaround.
+ *
+ * @param plan Built plan
+ * @param baud_rate Bus baud rate
+ * @return Estimated bus time in microseconds
+ */
+uint32_t register_poll_plan_estimate_us(const register_poll_plan_t *plan, uint32_t baud_rate);
+
+/**
+ * @brief Look up a register value in an execution result
+ * @param plan Plan the result belongs to
+ * @param result Execution result
+ * @param reg_addr Register address
+ * @param value Output value
+ * @return true if the register was read successfully
+ */
+bool register_poll_result_get(const register_poll_plan_t *plan, const register_poll_result_t *result,
+                              uint16_t reg_addr, uint16_t *value);
+
+#endif // REGISTER_POLL_PLANNER_H
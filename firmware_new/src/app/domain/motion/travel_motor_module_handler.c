@@ -8,6 +8,7 @@
  */
 
 #include "travel_motor_module_handler.h"
+#include "modbus_bus_master.h"
 #include "hal_common.h"
 #include "safety_types.h"
 #include <string.h>
@@ -646,34 +647,30 @@ bool motor_module_validate_acceleration(motor_module_handler_t *handler, uint16_
 
 // Modbus Communication Functions
 
+// Stop commands preempt queued motion and telemetry traffic on the bus
+static modbus_bus_priority_t motor_module_write_priority(uint16_t start_register, uint16_t count) {
+    static const uint16_t stop_regs[] = {
+        MOTOR_EMERGENCY_STOP_REG, MOTOR_STOP_COMMAND_REG, MOTOR_HARD_STOP_REG
+    };
+    for (size_t i = 0; i < sizeof(stop_regs) / sizeof(stop_regs[0]); i++) {
+        if (stop_regs[i] >= start_register && stop_regs[i] - start_register < count) {
+            return MODBUS_BUS_PRIO_SAFETY;
+        }
+    }
+    return MODBUS_BUS_PRIO_COMMAND;
+}
+
 hal_status_t motor_module_read_register(motor_module_handler_t *handler, uint16_t register_addr, uint16_t *value) {
     if (handler == NULL || value == NULL || !handler->initialized) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // Create Modbus request
-    comm_mgr_modbus_request_t request = {
-        .slave_id = handler->address,
-        .function_code = MODBUS_FC_READ_HOLDING_REGISTERS,
-        .start_address = register_addr,
-        .quantity = 1,
-        .data = NULL
-    };
-    
-    comm_mgr_modbus_response_t response;
-    hal_status_t status = comm_manager_modbus_send_request(&request, &response);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_COMMAND, handler->address, register_addr, 1, value);
     if (status != HAL_STATUS_OK) {
         printf("[MOTOR] Modbus read failed for register 0x%04X\n", register_addr);
         return status;
     }
     
-    if (response.data_length >= 2) {
-        *value = (response.data[0] << 8) | response.data[1];
-    } else {
-        printf("[MOTOR] Invalid response data length for register 0x%04X\n", register_addr);
-        return HAL_STATUS_ERROR;
-    }
-    
     return HAL_STATUS_OK;
 }
 
@@ -682,18 +679,8 @@ hal_status_t motor_module_write_register(motor_module_handler_t *handler, uint16
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // Create Modbus request
-    uint8_t data[2] = {(value >> 8) & 0xFF, value & 0xFF};
-    comm_mgr_modbus_request_t request = {
-        .slave_id = handler->address,
-        .function_code = MODBUS_FC_WRITE_SINGLE_REGISTER,
-        .start_address = register_addr,
-        .quantity = 1,
-        .data = data
-    };
-    
-    comm_mgr_modbus_response_t response;
-    hal_status_t status = comm_manager_modbus_send_request(&request, &response);
+    hal_status_t status = modbus_bus_write_single(motor_module_write_priority(register_addr, 1),
+                                                  handler->address, register_addr, value);
     if (status != HAL_STATUS_OK) {
         printf("[MOTOR] Modbus write failed for register 0x%04X\n", register_addr);
         return status;
@@ -708,31 +695,12 @@ hal_status_t motor_module_read_registers(motor_module_handler_t *handler, uint16
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // Create Modbus request
-    comm_mgr_modbus_request_t request = {
-        .slave_id = handler->address,
-        .function_code = MODBUS_FC_READ_HOLDING_REGISTERS,
-        .start_address = start_register,
-        .quantity = count,
-        .data = NULL
-    };
-    
-    comm_mgr_modbus_response_t response;
-    hal_status_t status = comm_manager_modbus_send_request(&request, &response);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_COMMAND, handler->address, start_register, count, data);
     if (status != HAL_STATUS_OK) {
         printf("[MOTOR] Modbus read failed for registers 0x%04X-0x%04X\n", start_register, start_register + count - 1);
         return status;
     }
     
-    if (response.data_length >= count * 2) {
-        for (uint16_t i = 0; i < count; i++) {
-            data[i] = (response.data[i * 2] << 8) | response.data[i * 2 + 1];
-        }
-    } else {
-        printf("[MOTOR] Invalid response data length for registers\n");
-        return HAL_STATUS_ERROR;
-    }
-    
     return HAL_STATUS_OK;
 }
 
@@ -742,30 +710,8 @@ hal_status_t motor_module_write_registers(motor_module_handler_t *handler, uint1
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // Create Modbus request
-    uint8_t *modbus_data = malloc(count * 2);
-    if (modbus_data == NULL) {
-        return HAL_STATUS_ERROR;
-    }
-    
-    for (uint16_t i = 0; i < count; i++) {
-        modbus_data[i * 2] = (data[i] >> 8) & 0xFF;
-        modbus_data[i * 2 + 1] = data[i] & 0xFF;
-    }
-    
-    comm_mgr_modbus_request_t request = {
-        .slave_id = handler->address,
-        .function_code = MODBUS_FC_WRITE_MULTIPLE_REGISTERS,
-        .start_address = start_register,
-        .quantity = count,
-        .data = modbus_data
-    };
-    
-    comm_mgr_modbus_response_t response;
-    hal_status_t status = comm_manager_modbus_send_request(&request, &response);
-    
-    free(modbus_data);
-    
+    hal_status_t status = modbus_bus_write_multiple(motor_module_write_priority(start_register, count),
+                                                    handler->address, start_register, count, data);
     if (status != HAL_STATUS_OK) {
         printf("[MOTOR] Modbus write failed for registers 0x%04X-0x%04X\n", start_register, start_register + count - 1);
         return status;
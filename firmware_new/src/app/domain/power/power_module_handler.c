@@ -8,9 +8,8 @@
  */
 
 #include "power_module_handler.h"
-#include "hal_rs485.h"
 #include "hal_common.h"
-#include "communication_manager.h"
+#include "modbus_bus_master.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -34,7 +33,6 @@ static struct {
 } power_module_state = {0};
 
 // Internal function prototypes
-static uint64_t power_module_get_timestamp_ms(void);
 static hal_status_t power_module_read_battery_data(void);
 static hal_status_t power_module_read_charging_data(void);
 static hal_status_t power_module_read_power_distribution(void);
@@ -94,7 +92,7 @@ hal_status_t power_module_handler_init(const power_module_config_t *config)
     power_module_update_capabilities();
     
     power_module_state.initialized = true;
-    power_module_state.last_update_ms = power_module_get_timestamp_ms();
+    power_module_state.last_update_ms = hal_time_now_ms();
     
     pthread_mutex_unlock(&power_module_state.mutex);
     
@@ -178,7 +176,7 @@ hal_status_t power_module_handler_read_data(power_module_data_t *data)
     }
     
     // Update timestamp
-    power_module_state.data.last_update_ms = power_module_get_timestamp_ms();
+    power_module_state.data.last_update_ms = hal_time_now_ms();
     power_module_state.last_update_ms = power_module_state.data.last_update_ms;
     
     // Copy data to output
@@ -197,62 +195,15 @@ hal_status_t power_module_handler_read_data(power_module_data_t *data)
  */
 hal_status_t power_module_handler_write_register(uint16_t register_addr, uint16_t value)
 {
-    hal_status_t status;
-    uint8_t tx_data[8];
-    uint8_t rx_data[8];
-    size_t rx_length;
-    
     pthread_mutex_lock(&power_module_state.mutex);
-    
-    if (!power_module_state.initialized) {
-        pthread_mutex_unlock(&power_module_state.mutex);
+    bool initialized = power_module_state.initialized;
+    pthread_mutex_unlock(&power_module_state.mutex);
+    if (!initialized) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // Prepare Modbus write command
-    tx_data[0] = POWER_MODULE_ADDRESS;  // Slave address
-    tx_data[1] = 0x06;                  // Function code: Write Single Register
-    tx_data[2] = (register_addr >> 8) & 0xFF;  // Register address high
-    tx_data[3] = register_addr & 0xFF;         // Register address low
-    tx_data[4] = (value >> 8) & 0xFF;          // Register value high
-    tx_data[5] = value & 0xFF;                 // Register value low
-    
-    // Calculate CRC
-    uint16_t crc = modbus_calculate_crc(tx_data, 6);
-    tx_data[6] = crc & 0xFF;
-    tx_data[7] = (crc >> 8) & 0xFF;
-    
-    // Send command
-    status = hal_rs485_transmit(tx_data, 8);
-    if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return status;
-    }
-    
-    // Receive response
-    status = hal_rs485_receive(rx_data, sizeof(rx_data), &rx_length);
-    if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return status;
-    }
-    
-    // Validate response
-    if (rx_length < 8) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Check CRC
-    uint16_t rx_crc = (rx_data[rx_length-1] << 8) | rx_data[rx_length-2];
-    uint16_t calc_crc = modbus_calculate_crc(rx_data, rx_length-2);
-    if (rx_crc != calc_crc) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    pthread_mutex_unlock(&power_module_state.mutex);
-    
-    return HAL_STATUS_OK;
+    // Single bus owner: the frame goes out on the bus thread
+    return modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, POWER_MODULE_ADDRESS, register_addr, value);
 }
 
 /**
@@ -263,7 +214,7 @@ hal_status_t power_module_handler_write_register(uint16_t register_addr, uint16_
  */
 bool power_module_check_timeout(uint64_t start_time, uint32_t timeout_ms)
 {
-    uint64_t current_time = power_module_get_timestamp_ms();
+    uint64_t current_time = hal_time_now_ms();
     uint64_t elapsed_time = current_time - start_time;
     
     return (elapsed_time >= timeout_ms);
@@ -278,81 +229,29 @@ bool power_module_check_timeout(uint64_t start_time, uint32_t timeout_ms)
  */
 hal_status_t power_module_handler_read_register_with_timeout(uint16_t register_addr, uint16_t *value, uint32_t timeout_ms)
 {
-    hal_status_t status;
-    uint8_t tx_data[8];
-    uint8_t rx_data[8];
-    size_t rx_length;
-    uint64_t start_time = power_module_get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     
     if (!value) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
     pthread_mutex_lock(&power_module_state.mutex);
-    
-    if (!power_module_state.initialized) {
-        pthread_mutex_unlock(&power_module_state.mutex);
+    bool initialized = power_module_state.initialized;
+    pthread_mutex_unlock(&power_module_state.mutex);
+    if (!initialized) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // Prepare Modbus read command
-    tx_data[0] = POWER_MODULE_ADDRESS;  // Slave address
-    tx_data[1] = 0x03;                  // Function code: Read Holding Registers
-    tx_data[2] = (register_addr >> 8) & 0xFF;  // Register address high
-    tx_data[3] = register_addr & 0xFF;         // Register address low
-    tx_data[4] = 0x00;                         // Number of registers high
-    tx_data[5] = 0x01;                         // Number of registers low (1 register)
-    
-    // Calculate CRC
-    uint16_t crc = modbus_calculate_crc(tx_data, 6);
-    tx_data[6] = crc & 0xFF;
-    tx_data[7] = (crc >> 8) & 0xFF;
-    
-    // Send command with timeout checking
-    status = hal_rs485_transmit(tx_data, 8);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_COMMAND, POWER_MODULE_ADDRESS, register_addr, 1, value);
     if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
         return status;
     }
     
-    // Check timeout before receive
+    // Queueing behind higher-priority bus work counts against the timeout
     if (power_module_check_timeout(start_time, timeout_ms)) {
-        pthread_mutex_unlock(&power_module_state.mutex);
         return HAL_STATUS_TIMEOUT;
     }
     
-    // Receive response with timeout checking
-    status = hal_rs485_receive(rx_data, sizeof(rx_data), &rx_length);
-    if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return status;
-    }
-    
-    // Check timeout after receive
-    if (power_module_check_timeout(start_time, timeout_ms)) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_TIMEOUT;
-    }
-    
-    // Validate response
-    if (rx_length < 7) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Check CRC
-    uint16_t rx_crc = (rx_data[rx_length-1] << 8) | rx_data[rx_length-2];
-    uint16_t calc_crc = modbus_calculate_crc(rx_data, rx_length-2);
-    if (rx_crc != calc_crc) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Extract register value
-    *value = (rx_data[3] << 8) | rx_data[4];
-    
-    pthread_mutex_unlock(&power_module_state.mutex);
-    
     return HAL_STATUS_OK;
 }
 
@@ -365,74 +264,25 @@ hal_status_t power_module_handler_read_register_with_timeout(uint16_t register_a
  */
 hal_status_t power_module_handler_write_register_with_timeout(uint16_t register_addr, uint16_t value, uint32_t timeout_ms)
 {
-    hal_status_t status;
-    uint8_t tx_data[8];
-    uint8_t rx_data[8];
-    size_t rx_length;
-    uint64_t start_time = power_module_get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     
     pthread_mutex_lock(&power_module_state.mutex);
-    
-    if (!power_module_state.initialized) {
-        pthread_mutex_unlock(&power_module_state.mutex);
+    bool initialized = power_module_state.initialized;
+    pthread_mutex_unlock(&power_module_state.mutex);
+    if (!initialized) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // Prepare Modbus write command
-    tx_data[0] = POWER_MODULE_ADDRESS;  // Slave address
-    tx_data[1] = 0x06;                  // Function code: Write Single Register
-    tx_data[2] = (register_addr >> 8) & 0xFF;  // Register address high
-    tx_data[3] = register_addr & 0xFF;         // Register address low
-    tx_data[4] = (value >> 8) & 0xFF;          // Register value high
-    tx_data[5] = value & 0xFF;                 // Register value low
-    
-    // Calculate CRC
-    uint16_t crc = modbus_calculate_crc(tx_data, 6);
-    tx_data[6] = crc & 0xFF;
-    tx_data[7] = (crc >> 8) & 0xFF;
-    
-    // Send command with timeout checking
-    status = hal_rs485_transmit(tx_data, 8);
-    if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return status;
-    }
-    
-    // Check timeout before receive
-    if (power_module_check_timeout(start_time, timeout_ms)) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_TIMEOUT;
-    }
-    
-    // Receive response with timeout checking
-    status = hal_rs485_receive(rx_data, sizeof(rx_data), &rx_length);
+    hal_status_t status = modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, POWER_MODULE_ADDRESS, register_addr, value);
     if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
         return status;
     }
     
-    // Check timeout after receive
+    // Queueing behind higher-priority bus work counts against the timeout
     if (power_module_check_timeout(start_time, timeout_ms)) {
-        pthread_mutex_unlock(&power_module_state.mutex);
         return HAL_STATUS_TIMEOUT;
     }
     
-    // Validate response
-    if (rx_length < 8) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Check CRC
-    uint16_t rx_crc = (rx_data[rx_length-1] << 8) | rx_data[rx_length-2];
-    uint16_t calc_crc = modbus_calculate_crc(rx_data, rx_length-2);
-    if (rx_crc != calc_crc) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    pthread_mutex_unlock(&power_module_state.mutex);
-    
     return HAL_STATUS_OK;
 }
 
@@ -598,69 +448,18 @@ hal_status_t power_module_read_battery_data_with_retry(void)
  */
 hal_status_t power_module_handler_read_register(uint16_t register_addr, uint16_t *value)
 {
-    hal_status_t status;
-    uint8_t tx_data[8];
-    uint8_t rx_data[8];
-    size_t rx_length;
-    
     if (!value) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
     pthread_mutex_lock(&power_module_state.mutex);
-    
-    if (!power_module_state.initialized) {
-        pthread_mutex_unlock(&power_module_state.mutex);
+    bool initialized = power_module_state.initialized;
+    pthread_mutex_unlock(&power_module_state.mutex);
+    if (!initialized) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // Prepare Modbus read command
-    tx_data[0] = POWER_MODULE_ADDRESS;  // Slave address
-    tx_data[1] = 0x03;                  // Function code: Read Holding Registers
-    tx_data[2] = (register_addr >> 8) & 0xFF;  // Register address high
-    tx_data[3] = register_addr & 0xFF;         // Register address low
-    tx_data[4] = 0x00;                         // Number of registers high
-    tx_data[5] = 0x01;                         // Number of registers low (1 register)
-    
-    // Calculate CRC
-    uint16_t crc = modbus_calculate_crc(tx_data, 6);
-    tx_data[6] = crc & 0xFF;
-    tx_data[7] = (crc >> 8) & 0xFF;
-    
-    // Send command
-    status = hal_rs485_transmit(tx_data, 8);
-    if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return status;
-    }
-    
-    // Receive response
-    status = hal_rs485_receive(rx_data, sizeof(rx_data), &rx_length);
-    if (status != HAL_STATUS_OK) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return status;
-    }
-    
-    // Validate response
-    if (rx_length < 7) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Check CRC
-    uint16_t rx_crc = (rx_data[rx_length-1] << 8) | rx_data[rx_length-2];
-    uint16_t calc_crc = modbus_calculate_crc(rx_data, rx_length-2);
-    if (rx_crc != calc_crc) {
-        pthread_mutex_unlock(&power_module_state.mutex);
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Extract register value
-    *value = (rx_data[3] << 8) | rx_data[4];
-    
-    pthread_mutex_unlock(&power_module_state.mutex);
-    
-    return HAL_STATUS_OK;
+    return modbus_bus_read_holding(MODBUS_BUS_PRIO_COMMAND, POWER_MODULE_ADDRESS, register_addr, 1, value);
 }
 
 /**
@@ -836,17 +635,6 @@ uint32_t power_module_handler_get_capabilities(void)
 
 // Internal functions
 
-/**
- * @brief Get current timestamp in milliseconds
- * @return Timestamp in milliseconds
- */
-static uint64_t power_module_get_timestamp_ms(void)
-{
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-}
-
 /**
  * @brief Read battery data from power module
  * @return HAL status
@@ -1202,30 +990,30 @@ hal_status_t power_module_handler_auto_detect(uint8_t slave_id, uint32_t timeout
     }
     
     // Note: Auto-detect can work without power module handler being initialized
-    // because it uses direct Modbus communication
+    // because it talks to the bus master directly
     if (!power_module_state.initialized) {
         printf("[POWER-AUTO] Power module handler not initialized, but auto-detect can still work\n");
-        // Continue with auto-detect using direct Modbus communication
+        // Continue with auto-detect through the bus master
     }
     
-    // Use direct Modbus communication for auto-detect
+    // Auto-detect reads go through the bus master like every other transaction
     uint16_t module_type = 0;
-    hal_status_t status = comm_manager_modbus_read_holding_registers(slave_id, POWER_REG_MODULE_TYPE, 1, &module_type);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_COMMAND, slave_id, POWER_REG_MODULE_TYPE, 1, &module_type);
     printf("[POWER-AUTO] Read MODULE_TYPE (0x%04X) = 0x%04X, status=%d\n", POWER_REG_MODULE_TYPE, module_type, status);
 
     if (status == HAL_STATUS_OK && module_type == 0x0002) {
         power_module_state.status.online = true;
-        power_module_state.status.last_communication_ms = power_module_get_timestamp_ms();
+        power_module_state.status.last_communication_ms = hal_time_now_ms();
         printf("[POWER-AUTO] ✅ Module type OK (0x%04X). Marking online.\n", module_type);
     } else {
         // Fallback: try reading device id and consider non-zero as valid
         uint16_t device_id = 0;
-        hal_status_t dev_status = comm_manager_modbus_read_holding_registers(slave_id, POWER_REG_DEVICE_ID, 1, &device_id);
+        hal_status_t dev_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_COMMAND, slave_id, POWER_REG_DEVICE_ID, 1, &device_id);
         printf("[POWER-AUTO] Fallback: Read DEVICE_ID (0x%04X) = 0x%04X, status=%d\n", POWER_REG_DEVICE_ID, device_id, dev_status);
         
         if (dev_status == HAL_STATUS_OK && device_id != 0x0000) {
             power_module_state.status.online = true;
-            power_module_state.status.last_communication_ms = power_module_get_timestamp_ms();
+            power_module_state.status.last_communication_ms = hal_time_now_ms();
             printf("[POWER-AUTO] ✅ Fallback online by DEVICE_ID=0x%04X (module_type=0x%04X).\n", device_id, module_type);
             status = HAL_STATUS_OK;
         } else {
@@ -1405,7 +1193,7 @@ static hal_status_t power_module_poll_data(void)
     pthread_mutex_lock(&power_module_state.mutex);
     
     hal_status_t status = HAL_STATUS_OK;
-    uint64_t current_time = power_module_get_timestamp_ms();
+    uint64_t current_time = hal_time_now_ms();
     
     // Check if enough time has passed since last poll (100ms interval)
     if ((current_time - power_module_state.last_update_ms) < 100) {
@@ -23,11 +23,9 @@
 // Global HTTP Server Instance
 http_server_instance_t g_http_server = {0};
 
-// Memory management and timeout configuration
-#define HTTP_SERVER_SOCKET_TIMEOUT_SEC 30
+// Worker pool size for route handlers
 #define HTTP_SERVER_MAX_CONNECTIONS 10
-#define HTTP_SERVER_BUFFER_SIZE 8192
-#define HTTP_SERVER_MEMORY_CHECK_INTERVAL 1000
+#define HTTP_SERVER_WORKER_COUNT 4
 
 // Private function declarations
 static hal_status_t http_server_setup_signal_handlers(void);
@@ -37,11 +35,7 @@ static hal_status_t http_server_find_route(const char *path, http_method_t metho
 static hal_status_t http_server_parse_request_line(const char *line, http_request_t *request);
 static hal_status_t http_server_parse_headers(const char *raw_headers, http_request_t *request);
 static hal_status_t http_server_parse_body(const char *raw_body, size_t body_length, http_request_t *request);
-static hal_status_t http_server_send_response(int client_socket, const http_response_t *response);
-static hal_status_t http_server_read_request(int client_socket, char *buffer, size_t buffer_size, size_t *received_length);
-static hal_status_t http_server_set_socket_timeout(int socket_fd, int timeout_seconds);
-static hal_status_t http_server_check_memory_usage(void);
-static hal_status_t http_server_cleanup_connection(int client_socket);
+static void http_server_dispatch(const http_event_request_t *event_request, http_event_response_t *event_response, void *user_data);
 
 // Signal handler for graceful shutdown
 static volatile bool g_http_shutdown_requested = false;
@@ -92,9 +86,13 @@ hal_status_t http_server_init(const http_server_config_t *config) {
     // Initialize routes array
     memset(g_http_server.routes, 0, sizeof(g_http_server.routes));
     g_http_server.route_count = 0;
+    if (http_router_create(&g_http_server.router) != HAL_STATUS_OK) {
+        pthread_mutex_destroy(&g_http_server.mutex);
+        return HAL_STATUS_NO_MEMORY;
+    }
     
-    // Initialize server socket
-    g_http_server.server_socket = -1;
+    // Event server is created on start
+    g_http_server.event_server = NULL;
     
     // Set initialization flags
     g_http_server.initialized = true;
@@ -133,55 +131,28 @@ hal_status_t http_server_start(void) {
         return HAL_STATUS_ALREADY_ACTIVE;
     }
     
-    // Create socket
-    g_http_server.server_socket = socket(AF_INET, SOCK_STREAM, 0);
-    if (g_http_server.server_socket < 0) {
-        hal_log_error("HTTP_SERVER", "http_server_start", __LINE__, 
-                     HAL_STATUS_IO_ERROR, "Failed to create server socket: %s", strerror(errno));
-        return HAL_STATUS_IO_ERROR;
-    }
+    // Connections are served by the shared event-loop core
+    http_event_server_config_t event_config = {
+        .port = g_http_server.config.port,
+        .worker_count = HTTP_SERVER_WORKER_COUNT,
+        .max_connections = g_http_server.config.max_connections,
+        .idle_timeout_ms = g_http_server.config.timeout_ms,
+        .keep_alive = g_http_server.config.enable_keep_alive,
+        .handler = http_server_dispatch,
+        .user_data = NULL,
+        .name = "HTTP_SERVER"
+    };
     
-    // Set socket options
-    int opt = 1;
-    if (setsockopt(g_http_server.server_socket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        hal_log_error("HTTP_SERVER", "http_server_start", __LINE__, 
-                     HAL_STATUS_IO_ERROR, "Failed to set socket options: %s", strerror(errno));
-        close(g_http_server.server_socket);
-        g_http_server.server_socket = -1;
-        return HAL_STATUS_IO_ERROR;
+    hal_status_t result = http_event_server_create(&event_config, &g_http_server.event_server);
+    if (result == HAL_STATUS_OK) {
+        result = http_event_server_start(g_http_server.event_server);
     }
-    
-    // Bind socket
-    struct sockaddr_in server_addr;
-    memset(&server_addr, 0, sizeof(server_addr));
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_addr.s_addr = INADDR_ANY;
-    server_addr.sin_port = htons(g_http_server.config.port);
-    
-    if (bind(g_http_server.server_socket, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
-        hal_log_error("HTTP_SERVER", "http_server_start", __LINE__, 
-                     HAL_STATUS_IO_ERROR, "Failed to bind server socket: %s", strerror(errno));
-        close(g_http_server.server_socket);
-        g_http_server.server_socket = -1;
-        return HAL_STATUS_IO_ERROR;
-    }
-    
-    // Listen for connections
-    if (listen(g_http_server.server_socket, g_http_server.config.max_connections) < 0) {
+    if (result != HAL_STATUS_OK) {
         hal_log_error("HTTP_SERVER", "http_server_start", __LINE__, 
-                     HAL_STATUS_IO_ERROR, "Failed to listen on server socket: %s", strerror(errno));
-        close(g_http_server.server_socket);
-        g_http_server.server_socket = -1;
-        return HAL_STATUS_IO_ERROR;
-    }
-    
-    // Start server thread
-    if (pthread_create(&g_http_server.server_thread, NULL, http_server_thread, NULL) != 0) {
-        hal_log_error("HTTP_SERVER", "http_server_start", __LINE__, 
-                     HAL_STATUS_ERROR, "Failed to create server thread: %s", strerror(errno));
-        close(g_http_server.server_socket);
-        g_http_server.server_socket = -1;
-        return HAL_STATUS_ERROR;
+                     result, "Failed to start event server on port %d", g_http_server.config.port);
+        http_event_server_destroy(g_http_server.event_server);
+        g_http_server.event_server = NULL;
+        return result;
     }
     
     g_http_server.running = true;
@@ -209,23 +180,23 @@ hal_status_t http_server_stop(void) {
     g_http_server.status.running = false;
     g_http_server.status.listening = false;
     
-    // Close server socket
-    if (g_http_server.server_socket >= 0) {
-        close(g_http_server.server_socket);
-        g_http_server.server_socket = -1;
-    }
-    
-    // Wait for server thread to finish
-    if (g_http_server.server_thread) {
-        pthread_join(g_http_server.server_thread, NULL);
-        g_http_server.server_thread = 0;
-    }
+    // Joins the event thread and workers; no handler runs after this
+    http_event_server_destroy(g_http_server.event_server);
+    g_http_server.event_server = NULL;
     
     hal_log_message(HAL_LOG_LEVEL_INFO, "HTTP Server: Stopped successfully");
     
     return HAL_STATUS_OK;
 }
 
+/**
+ * @brief Get the event server core backing this instance
+ * @return Event server handle, NULL when not running
+ */
+http_event_server_t* http_server_get_event_server(void) {
+    return g_http_server.event_server;
+}
+
 /**
  * @brief Deinitialize HTTP Server
  * @return hal_status_t HAL_STATUS_OK on success, error code on failure
@@ -301,16 +272,6 @@ hal_status_t http_server_register_route(const http_route_t *route) {
     
     pthread_mutex_lock(&g_http_server.mutex);
     
-    // Check if route already exists
-    http_route_t *existing_route;
-    hal_status_t find_result = http_server_find_route(route->path, route->method, &existing_route);
-    if (find_result == HAL_STATUS_OK) {
-        pthread_mutex_unlock(&g_http_server.mutex);
-        hal_log_message(HAL_LOG_LEVEL_WARNING, "HTTP Server: Route %s %s already exists", 
-                       route->path, http_method_to_string(route->method));
-        return HAL_STATUS_ALREADY_EXISTS;
-    }
-    
     // Check if we have space for more routes
     if (g_http_server.route_count >= 64) {
         pthread_mutex_unlock(&g_http_server.mutex);
@@ -319,8 +280,17 @@ hal_status_t http_server_register_route(const http_route_t *route) {
         return HAL_STATUS_NO_MEMORY;
     }
     
-    // Add route
-    memcpy(&g_http_server.routes[g_http_server.route_count], route, sizeof(http_route_t));
+    // Add route; the router rejects duplicates and malformed patterns
+    http_route_t *slot = &g_http_server.routes[g_http_server.route_count];
+    memcpy(slot, route, sizeof(http_route_t));
+    hal_status_t add_result = http_router_add(g_http_server.router, (uint32_t)route->method, slot->path, slot);
+    if (add_result != HAL_STATUS_OK) {
+        pthread_mutex_unlock(&g_http_server.mutex);
+        hal_log_message(HAL_LOG_LEVEL_WARNING, "HTTP Server: Route %s %s rejected (%s)", 
+                       route->path, http_method_to_string(route->method),
+                       add_result == HAL_STATUS_ALREADY_EXISTS ? "already exists" : "invalid pattern");
+        return add_result;
+    }
     g_http_server.route_count++;
     
     pthread_mutex_unlock(&g_http_server.mutex);
@@ -355,6 +325,9 @@ hal_status_t http_server_handle_request(const http_request_t *request, http_resp
     http_route_t *route;
     hal_status_t find_result = http_server_find_route(request->path, request->method, &route);
     
+    if (find_result == HAL_STATUS_NOT_SUPPORTED) {
+        return http_server_create_error_response(response, HTTP_STATUS_METHOD_NOT_ALLOWED, "Method not allowed");
+    }
     if (find_result != HAL_STATUS_OK) {
         // Route not found
         return http_server_create_error_response(response, HTTP_STATUS_NOT_FOUND, "Route not found");
@@ -712,24 +685,25 @@ static hal_status_t http_server_setup_signal_handlers(void) {
 }
 
 static hal_status_t http_server_cleanup_resources(void) {
-    // Close server socket
-    if (g_http_server.server_socket >= 0) {
-        close(g_http_server.server_socket);
-        g_http_server.server_socket = -1;
+    // Release the event server if start succeeded but stop was never called
+    if (g_http_server.event_server != NULL) {
+        http_event_server_destroy(g_http_server.event_server);
+        g_http_server.event_server = NULL;
     }
     
+    http_router_destroy(g_http_server.router);
+    g_http_server.router = NULL;
+    
     return HAL_STATUS_OK;
 }
 
 static hal_status_t http_server_find_route(const char *path, http_method_t method, http_route_t **route) {
-    for (uint32_t i = 0; i < g_http_server.route_count; i++) {
-        if (strcmp(g_http_server.routes[i].path, path) == 0 && 
-            g_http_server.routes[i].method == method) {
-            *route = &g_http_server.routes[i];
-            return HAL_STATUS_OK;
-        }
+    http_router_match_t match;
+    hal_status_t result = http_router_match(g_http_server.router, (uint32_t)method, path, &match);
+    if (result == HAL_STATUS_OK) {
+        *route = (http_route_t *)match.target;
     }
-    return HAL_STATUS_NOT_FOUND;
+    return result;
 }
 
 static hal_status_t http_server_parse_request_line(const char *line, http_request_t *request) {
@@ -828,177 +802,75 @@ static hal_status_t http_server_parse_body(const char *raw_body, size_t body_len
     return HAL_STATUS_OK;
 }
 
-// HTTP Server Thread Function
-void* http_server_thread(void *arg) {
-    (void)arg; // Unused parameter
+// Event server worker callback: parse, route and hand the response back to the core
+static void http_server_dispatch(const http_event_request_t *event_request, http_event_response_t *event_response, void *user_data) {
+    (void)user_data;
     
-    hal_log_message(HAL_LOG_LEVEL_INFO, "HTTP Server: Server thread started");
+    http_request_t request;
+    http_response_t response;
+    memset(&response, 0, sizeof(response));
     
-    while (!g_http_shutdown_requested && g_http_server.running) {
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
-        
-        int client_socket = accept(g_http_server.server_socket, 
-                                  (struct sockaddr*)&client_addr, &client_len);
+    hal_status_t parse_result = http_server_parse_request(event_request->raw, &request);
+    if (parse_result != HAL_STATUS_OK) {
+        hal_log_error("HTTP_SERVER", "http_server_dispatch", __LINE__, 
+                     parse_result, "Failed to parse request");
+        http_server_create_error_response(&response, HTTP_STATUS_BAD_REQUEST, "Bad request");
+        snprintf(event_response->route, sizeof(event_response->route), "bad_request");
+    } else {
+        strncpy(request.client_ip, event_request->client_ip, sizeof(request.client_ip) - 1);
+        request.client_port = event_request->client_port;
         
-        if (client_socket < 0) {
-            if (errno == EINTR) {
-                continue; // Interrupted by signal
-            }
-            hal_log_error("HTTP_SERVER", "http_server_thread", __LINE__, 
-                         HAL_STATUS_IO_ERROR, "Failed to accept client connection: %s", strerror(errno));
-            continue;
+        // Label by registered route so the histogram key space stays bounded
+        pthread_mutex_lock(&g_http_server.mutex);
+        http_route_t *route;
+        if (http_server_find_route(request.path, request.method, &route) == HAL_STATUS_OK) {
+            snprintf(event_response->route, sizeof(event_response->route), "%s %.55s",
+                     http_method_to_string(route->method), route->path);
         }
+        pthread_mutex_unlock(&g_http_server.mutex);
         
-        // Handle client request in a separate thread
-        pthread_t client_thread;
-        int *client_socket_ptr = malloc(sizeof(int));
-        *client_socket_ptr = client_socket;
-        
-        if (pthread_create(&client_thread, NULL, http_server_client_thread, client_socket_ptr) != 0) {
-            hal_log_error("HTTP_SERVER", "http_server_thread", __LINE__, 
-                         HAL_STATUS_ERROR, "Failed to create client thread: %s", strerror(errno));
-            close(client_socket);
-            free(client_socket_ptr);
-        } else {
-            pthread_detach(client_thread);
+        if (http_server_handle_request(&request, &response) != HAL_STATUS_OK) {
+            event_response->close_connection = true;
         }
     }
     
-    hal_log_message(HAL_LOG_LEVEL_INFO, "HTTP Server: Server thread stopped");
-    return NULL;
-}
-
-// HTTP Client Thread Function
-void* http_server_client_thread(void *arg) {
-    int client_socket = *(int*)arg;
-    free(arg);
-    
-    char request_buffer[HTTP_SERVER_MAX_REQUEST_SIZE];
-    size_t received_length;
-    
-    // Read request
-    hal_status_t read_result = http_server_read_request(client_socket, request_buffer, 
-                                                       sizeof(request_buffer), &received_length);
-    if (read_result != HAL_STATUS_OK) {
-        hal_log_error("HTTP_SERVER", "http_server_client_thread", __LINE__, 
-                     read_result, "Failed to read request from client");
-        http_server_cleanup_connection(client_socket);
-        return NULL;
-    }
-    
-    // Parse request
-    http_request_t request;
-    hal_status_t parse_result = http_server_parse_request(request_buffer, &request);
-    if (parse_result != HAL_STATUS_OK) {
-        hal_log_error("HTTP_SERVER", "http_server_client_thread", __LINE__, 
-                     parse_result, "Failed to parse request");
-        http_server_cleanup_connection(client_socket);
-        return NULL;
-    }
-    
-    // Handle request
-    http_response_t response;
-    hal_status_t handle_result = http_server_handle_request(&request, &response);
-    if (handle_result != HAL_STATUS_OK) {
-        hal_log_error("HTTP_SERVER", "http_server_client_thread", __LINE__, 
-                     handle_result, "Failed to handle request");
-        http_server_cleanup_connection(client_socket);
-        return NULL;
-    }
-    
-    // Send response
-    hal_status_t send_result = http_server_send_response(client_socket, &response);
-    if (send_result != HAL_STATUS_OK) {
-        hal_log_error("HTTP_SERVER", "http_server_client_thread", __LINE__, 
-                     send_result, "Failed to send response");
-    }
-    
-    // Cleanup memory and connection
-    if (request.body != NULL) {
-        free(request.body);
-    }
-    if (response.body != NULL) {
-        free(response.body);
-    }
-    
-    http_server_cleanup_connection(client_socket);
-    return NULL;
-}
-
-// Helper functions for timeout and memory management
-/**
- * @brief Set socket timeout to prevent hanging connections
- * @param socket_fd Socket file descriptor
- * @param timeout_seconds Timeout in seconds
- * @return hal_status_t HAL_STATUS_OK on success, error code on failure
- */
-static hal_status_t http_server_set_socket_timeout(int socket_fd, int timeout_seconds) {
-    struct timeval timeout;
-    timeout.tv_sec = timeout_seconds;
-    timeout.tv_usec = 0;
-    
-    if (setsockopt(socket_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
-        hal_log_error("HTTP_SERVER", "http_server_set_socket_timeout", __LINE__,
-                     HAL_STATUS_ERROR, "Failed to set receive timeout");
-        return HAL_STATUS_ERROR;
-    }
-    
-    if (setsockopt(socket_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) < 0) {
-        hal_log_error("HTTP_SERVER", "http_server_set_socket_timeout", __LINE__,
-                     HAL_STATUS_ERROR, "Failed to set send timeout");
-        return HAL_STATUS_ERROR;
-    }
-    
-    return HAL_STATUS_OK;
-}
-
-/**
- * @brief Check memory usage and log warnings if high
- * @return hal_status_t HAL_STATUS_OK on success, error code on failure
- */
-static hal_status_t http_server_check_memory_usage(void) {
-    FILE *meminfo = fopen("/proc/meminfo", "r");
-    if (meminfo == NULL) {
-        return HAL_STATUS_ERROR;
-    }
-    
-    char line[256];
-    long mem_total = 0, mem_available = 0;
-    
-    while (fgets(line, sizeof(line), meminfo)) {
-        if (sscanf(line, "MemTotal: %ld kB", &mem_total) == 1) {
+    // Translate headers; Content-Length and Connection are owned by the core
+    size_t used = 0;
+    for (uint32_t i = 0; i < response.header_count && i < HTTP_SERVER_MAX_HEADERS; i++) {
+        const http_header_t *header = &response.headers[i];
+        if (strcasecmp(header->name, "Content-Type") == 0) {
+            snprintf(event_response->content_type, sizeof(event_response->content_type), "%.63s", header->value);
             continue;
         }
-        if (sscanf(line, "MemAvailable: %ld kB", &mem_available) == 1) {
+        if (strcasecmp(header->name, "Content-Length") == 0 || strcasecmp(header->name, "Connection") == 0) {
+            continue;
+        }
+        int written = snprintf(event_response->extra_headers + used, sizeof(event_response->extra_headers) - used,
+                               "%s: %s\r\n", header->name, header->value);
+        if (written < 0 || (size_t)written >= sizeof(event_response->extra_headers) - used) {
+            event_response->extra_headers[used] = '\0';
             break;
         }
+        used += (size_t)written;
     }
-    fclose(meminfo);
     
-    if (mem_total > 0 && mem_available > 0) {
-        double usage_percent = ((double)(mem_total - mem_available) / mem_total) * 100.0;
-        if (usage_percent > 85.0) {
-            hal_log_message(HAL_LOG_LEVEL_WARNING, 
-                           "HTTP Server: High memory usage detected: %.1f%%", usage_percent);
-        }
-    }
+    event_response->status_code = response.status_code != 0 ? (int)response.status_code : HTTP_STATUS_INTERNAL_SERVER_ERROR;
+    event_response->body = response.body;
+    event_response->body_length = response.body ? response.body_length : 0;
     
-    return HAL_STATUS_OK;
-}
-
-/**
- * @brief Cleanup connection resources properly
- * @param client_socket Client socket to cleanup
- * @return hal_status_t HAL_STATUS_OK on success, error code on failure
- */
-static hal_status_t http_server_cleanup_connection(int client_socket) {
-    if (client_socket >= 0) {
-        shutdown(client_socket, SHUT_RDWR);
-        close(client_socket);
-        hal_log_message(HAL_LOG_LEVEL_DEBUG, "HTTP Server: Connection cleaned up");
+    pthread_mutex_lock(&g_http_server.mutex);
+    g_http_server.status.statistics.total_requests++;
+    if (event_response->status_code < 400) {
+        g_http_server.status.statistics.successful_requests++;
+    } else {
+        g_http_server.status.statistics.failed_requests++;
     }
-    return HAL_STATUS_OK;
+    g_http_server.status.statistics.bytes_received += event_request->raw_length;
+    g_http_server.status.statistics.bytes_sent += event_response->body_length;
+    g_http_server.status.statistics.last_request_time = hal_get_timestamp_ms();
+    pthread_mutex_unlock(&g_http_server.mutex);
+    
+    free(request.body);
 }
 
 static const char* http_server_get_status_text(int status_code) {
@@ -1022,171 +894,6 @@ static const char* http_server_get_status_text(int status_code) {
     }
 }
 
-// Enhanced request reading with Content-Length support
-static hal_status_t http_server_read_request(int client_socket, char *buffer, size_t buffer_size, size_t *received_length) {
-    // Set socket timeout to prevent hanging
-    hal_status_t timeout_result = http_server_set_socket_timeout(client_socket, HTTP_SERVER_SOCKET_TIMEOUT_SEC);
-    if (timeout_result != HAL_STATUS_OK) {
-        hal_log_message(HAL_LOG_LEVEL_WARNING, "HTTP Server: Failed to set socket timeout");
-    }
-    
-    // Check memory usage periodically
-    static uint64_t last_memory_check = 0;
-    uint64_t current_time = hal_get_timestamp_ms();
-    if (current_time - last_memory_check > HTTP_SERVER_MEMORY_CHECK_INTERVAL) {
-        http_server_check_memory_usage();
-        last_memory_check = current_time;
-    }
-    
-    size_t total_received = 0;
-    size_t headers_end_pos = 0;
-    size_t expected_body_length = 0;
-    bool headers_complete = false;
-    
-    // Read in chunks until we have complete request
-    while (total_received < buffer_size - 1) {
-        ssize_t bytes_received = recv(client_socket, 
-                                     buffer + total_received, 
-                                     buffer_size - total_received - 1, 
-                                     0);
-        
-    if (bytes_received < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            hal_log_error("HTTP_SERVER", "http_server_read_request", __LINE__,
-                         HAL_STATUS_TIMEOUT, "Socket read timeout");
-            return HAL_STATUS_TIMEOUT;
-        } else {
-            hal_log_error("HTTP_SERVER", "http_server_read_request", __LINE__,
-                         HAL_STATUS_ERROR, "Socket read error: %s", strerror(errno));
-            return HAL_STATUS_ERROR;
-        }
-    } else if (bytes_received == 0) {
-        hal_log_message(HAL_LOG_LEVEL_DEBUG, "HTTP Server: Client disconnected");
-        return HAL_STATUS_ERROR;
-    }
-    
-        total_received += bytes_received;
-        buffer[total_received] = '\0';
-        
-        // Check if headers are complete
-        if (!headers_complete) {
-            const char *headers_end = strstr(buffer, "\r\n\r\n");
-            if (headers_end != NULL) {
-                headers_complete = true;
-                headers_end_pos = (headers_end - buffer) + 4;
-                
-                // Parse Content-Length from headers
-                const char *content_length_start = strstr(buffer, "Content-Length:");
-                if (content_length_start != NULL) {
-                    content_length_start += 15; // Skip "Content-Length:"
-                    while (*content_length_start == ' ' || *content_length_start == '\t') {
-                        content_length_start++;
-                    }
-                    expected_body_length = (size_t)strtoul(content_length_start, NULL, 10);
-                }
-            }
-        }
-        
-        // Check if we have complete request
-        if (headers_complete) {
-            size_t current_body_length = total_received - headers_end_pos;
-            if (current_body_length >= expected_body_length) {
-                break; // Complete request received
-            }
-        }
-        
-        // Prevent infinite loop for requests without body
-        if (headers_complete && expected_body_length == 0) {
-            break;
-        }
-    }
-    
-    *received_length = total_received;
-    
-    hal_log_message(HAL_LOG_LEVEL_DEBUG, "HTTP Server: Read %zu bytes from client (headers: %zu, body: %zu)", 
-                    total_received, headers_end_pos, total_received - headers_end_pos);
-    
-    return HAL_STATUS_OK;
-}
-
-static hal_status_t http_server_send_response(int client_socket, const http_response_t *response) {
-    if (!response || client_socket < 0) {
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Serialize response to buffer
-    char response_buffer[HTTP_SERVER_MAX_RESPONSE_SIZE];
-    size_t buffer_used = 0;
-    
-    // Build status line
-    int status_line_len = snprintf(response_buffer + buffer_used, 
-                                   sizeof(response_buffer) - buffer_used,
-                                   "HTTP/1.1 %d %s\r\n",
-                                   response->status_code,
-                                   http_server_get_status_text(response->status_code));
-    if (status_line_len < 0 || status_line_len >= (int)(sizeof(response_buffer) - buffer_used)) {
-        hal_log_message(HAL_LOG_LEVEL_ERROR, "HTTP Server: Response buffer too small for status line");
-        return HAL_STATUS_ERROR;
-    }
-    buffer_used += status_line_len;
-    
-    // Add headers
-    for (int i = 0; i < (int)response->header_count && i < HTTP_SERVER_MAX_HEADERS; i++) {
-        int header_len = snprintf(response_buffer + buffer_used,
-                                  sizeof(response_buffer) - buffer_used,
-                                  "%s: %s\r\n",
-                                  response->headers[i].name,
-                                  response->headers[i].value);
-        if (header_len < 0 || header_len >= (int)(sizeof(response_buffer) - buffer_used)) {
-            hal_log_message(HAL_LOG_LEVEL_ERROR, "HTTP Server: Response buffer too small for headers");
-            return HAL_STATUS_ERROR;
-        }
-        buffer_used += header_len;
-    }
-    
-    // Add Content-Length header if body exists
-    if (response->body && response->body_length > 0) {
-        int content_len_header = snprintf(response_buffer + buffer_used,
-                                          sizeof(response_buffer) - buffer_used,
-                                          "Content-Length: %zu\r\n",
-                                          response->body_length);
-        if (content_len_header < 0 || content_len_header >= (int)(sizeof(response_buffer) - buffer_used)) {
-            hal_log_message(HAL_LOG_LEVEL_ERROR, "HTTP Server: Response buffer too small for Content-Length");
-            return HAL_STATUS_ERROR;
-        }
-        buffer_used += content_len_header;
-    }
-    
-    // End headers
-    if (buffer_used + 2 >= sizeof(response_buffer)) {
-        hal_log_message(HAL_LOG_LEVEL_ERROR, "HTTP Server: Response buffer too small for header end");
-        return HAL_STATUS_ERROR;
-    }
-    strcpy(response_buffer + buffer_used, "\r\n");
-    buffer_used += 2;
-    
-    // Send headers
-    ssize_t bytes_sent = send(client_socket, response_buffer, buffer_used, 0);
-    if (bytes_sent < 0 || (size_t)bytes_sent != buffer_used) {
-        hal_log_message(HAL_LOG_LEVEL_ERROR, "HTTP Server: Failed to send response headers");
-        return HAL_STATUS_ERROR;
-    }
-    
-    // Send body if exists
-    if (response->body && response->body_length > 0) {
-        bytes_sent = send(client_socket, response->body, response->body_length, 0);
-        if (bytes_sent < 0 || (size_t)bytes_sent != response->body_length) {
-            hal_log_message(HAL_LOG_LEVEL_ERROR, "HTTP Server: Failed to send response body");
-            return HAL_STATUS_ERROR;
-        }
-    }
-    
-    hal_log_message(HAL_LOG_LEVEL_DEBUG, "HTTP Server: Sent response %d, %zu bytes", 
-                    response->status_code, buffer_used + (response->body ? response->body_length : 0));
-    
-    return HAL_STATUS_OK;
-}
-
 hal_status_t http_server_serialize_response(const http_response_t *response, char *buffer, size_t buffer_size) {
     if (!response || !buffer || buffer_size == 0) {
         return HAL_STATUS_INVALID_PARAMETER;
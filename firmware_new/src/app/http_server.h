@@ -18,6 +18,8 @@
 
 // Include HAL dependencies
 #include "../../hal/common/hal_common.h"
+#include "http_event_server.h"
+#include "http_router.h"
 
 // HTTP Server Configuration
 #define HTTP_SERVER_MAX_CONNECTIONS       10
@@ -142,8 +144,8 @@ typedef struct {
     http_server_status_t status;
     http_route_t routes[64];
     uint32_t route_count;
-    int server_socket;
-    pthread_t server_thread;
+    http_router_t *router;          // Compiled lookup over routes[]
+    http_event_server_t *event_server;
     pthread_mutex_t mutex;
     bool initialized;
     bool running;
@@ -199,9 +201,8 @@ hal_status_t http_server_update_statistics(http_server_statistics_t *stats, bool
 hal_status_t http_server_log_request(const http_request_t *request, const http_response_t *response);
 hal_status_t http_server_log_error(const char *error_message, const char *context);
 
-// HTTP Server Thread Functions
-void* http_server_thread(void *arg);
-void* http_server_client_thread(void *arg);
+// HTTP Server Event Core Access (connection stats, per-route latency histograms)
+http_event_server_t* http_server_get_event_server(void);
 
 // HTTP Server Utility Functions
 const char* http_method_to_string(http_method_t method);
@@ -11,7 +11,11 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include "communication_manager.h"
+#include "modbus_bus_master.h"
+#include "module_discovery.h"
 #include "hal_common.h"
+#include "hal_log.h"
+#include "hal_modbus_crc.h"
 #include "module_manager.h"
 // WebSocket removed - Firmware only uses HTTP/REST API
 
@@ -84,18 +88,11 @@ static inline bool comm_is_valid_quantity_coils(uint16_t quantity) {
 	return quantity >= 1 && quantity <= 2000;
 }
 
-// --- Scan control state (Issue #147) ---
-static volatile bool g_scan_interrupt_requested = false;
-static volatile bool g_scan_paused = false;
-static volatile bool g_scan_active = false;
-
 // Forward declarations
 static hal_status_t init_rs485(void);
 static hal_status_t init_modbus(void);
 static hal_status_t send_modbus_frame(const uint8_t *data, uint16_t length);
 static hal_status_t receive_modbus_frame(uint8_t *data, uint16_t *length);
-static uint16_t calculate_crc16(const uint8_t *data, uint16_t length);
-static bool verify_crc16(const uint8_t *data, uint16_t length);
 static hal_status_t build_modbus_request(const comm_mgr_modbus_request_t *request, uint8_t *frame, uint16_t *frame_length);
 static hal_status_t parse_modbus_response(const uint8_t *frame, uint16_t frame_length, comm_mgr_modbus_response_t *response);
 static hal_status_t handle_communication_event(comm_mgr_event_t event, const void *data);
@@ -230,155 +227,9 @@ hal_status_t comm_manager_deinit(void) {
     return HAL_STATUS_OK;
 }
 
-static module_type_t probe_module_type(uint8_t addr) {
-    // Try to read Module Type register (0x0104) to identify module type
-    uint16_t module_type = 0;
-    hal_status_t status = comm_manager_modbus_read_holding_registers(addr, 0x0104, 1, &module_type);
-    
-    if (status == HAL_STATUS_OK) {
-        printf("[SCAN] 0x%02X Module Type Register: 0x%04X\n", addr, module_type);
-        
-        // If device returns 0 (or invalid), fallback to address mapping
-        if (module_type == 0x0000) {
-            // fallthrough to address-based mapping below
-        } else {
-            // Map module type register values to our enum (per integration doc)
-            switch (module_type) {
-                case 0x0002: return MODULE_TYPE_POWER;   // Power module
-                case 0x0003: return MODULE_TYPE_SAFETY;  // Safety module
-                case 0x0004: return MODULE_TYPE_TRAVEL_MOTOR; // Travel Motor module
-                case 0x0005: return MODULE_TYPE_DOCK;    // Dock & Location module
-                default: break;
-            }
-        }
-    }
-    
-    // Fallback: identify by address if module type register not available/invalid
-    switch (addr) {
-        case 0x02: return MODULE_TYPE_POWER;   // Power module (0x02)
-        case 0x03: return MODULE_TYPE_SAFETY;  // Safety module (0x03)
-        case 0x04: return MODULE_TYPE_TRAVEL_MOTOR; // Travel Motor module (0x04)
-        case 0x05: return MODULE_TYPE_DOCK;    // Dock & Location module (0x05)
-        default: return MODULE_TYPE_UNKNOWN;
-    }
-}
-
 hal_status_t comm_manager_scan_range(uint8_t start_addr, uint8_t end_addr) {
-    g_scan_interrupt_requested = false;
-    g_scan_active = true;
-    registry_set_scanning(true);
-    printf("[SCAN] Starting scan range 0x%02X-0x%02X\n", start_addr, end_addr);
-    
-    // Track modules that were previously online for debounce logic
-    uint8_t miss_count[MODULE_REGISTRY_MAX_MODULES] = {0};
-    
-    // Initialize miss count for existing modules
-    for (uint8_t addr = start_addr; addr <= end_addr; ++addr) {
-        module_info_t mi;
-        if (registry_get(addr, &mi) == 0 && mi.status == MODULE_STATUS_ONLINE) {
-            // Module was previously online, initialize miss count
-        }
-    }
-    
-    for (uint8_t addr = start_addr; addr <= end_addr; ++addr) {
-        if (g_scan_interrupt_requested) {
-            printf("[SCAN] Interrupt requested - stopping at addr 0x%02X\n", addr);
-            break;
-        }
-        // Pause gate (100ms sleep to avoid busy-wait)
-        while (g_scan_paused && !g_scan_interrupt_requested) {
-            hal_sleep_ms(100);
-        }
-        printf("[SCAN] Probing 0x%02X...\n", addr);
-        bool found = false;
-        
-        // Retry logic: 3 attempts with exponential backoff
-        for (int retry = 0; retry < 3; ++retry) {
-            if (g_scan_interrupt_requested) { break; }
-            uint32_t backoff_ms = 50 * (1 << retry); // 50, 100, 200ms
-            
-            if (retry > 0) {
-                printf("[SCAN] 0x%02X retry %d/%d (backoff %ums)\n", addr, retry + 1, 3, backoff_ms);
-                // Allow pause/interrupt during backoff
-                uint32_t elapsed = 0;
-                while (elapsed < backoff_ms) {
-                    if (g_scan_interrupt_requested) { break; }
-                    while (g_scan_paused && !g_scan_interrupt_requested) { hal_sleep_ms(50); }
-                    hal_sleep_ms(10);
-                    elapsed += 10;
-                }
-            }
-            
-            // Try to read Device ID register (0x0100) first - this is what EMBED team tested
-            uint16_t device_id = 0;
-            hal_status_t st = comm_manager_modbus_read_holding_registers(addr, 0x0100, 1, &device_id);
-            if (!g_scan_interrupt_requested && st == HAL_STATUS_OK) {
-                printf("[SCAN] 0x%02X ONLINE (Device ID=0x%04X)\n", addr, device_id);
-                
-                // Try to read Module Type register (0x0104) as well
-                uint16_t module_type = 0;
-                hal_status_t st2 = comm_manager_modbus_read_holding_registers(addr, 0x0104, 1, &module_type);
-                if (st2 == HAL_STATUS_OK) {
-                    printf("[SCAN] 0x%02X Module Type=0x%04X\n", addr, module_type);
-                }
-                
-                module_type_t t = probe_module_type(addr);
-                registry_mark_online(addr, t, "");
-                
-                // Mark module as discovered (no need to call full discovery here)
-                printf("[SCAN] Module 0x%02X discovered and marked online\n", addr);
-                
-                found = true;
-                miss_count[addr - start_addr] = 0; // Reset miss count
-                break;
-            } else {
-                // Fallback: try the original register 0x0000
-                uint16_t reg = 0;
-                hal_status_t st_fallback = comm_manager_modbus_read_holding_registers(addr, 0x0000, 1, &reg);
-                if (!g_scan_interrupt_requested && st_fallback == HAL_STATUS_OK) {
-                    printf("[SCAN] 0x%02X ONLINE (reg0=0x%04X) - fallback\n", addr, reg);
-                    module_type_t t = probe_module_type(addr);
-                    registry_mark_online(addr, t, "");
-                    found = true;
-                    miss_count[addr - start_addr] = 0; // Reset miss count
-                    break;
-                }
-            }
-        }
-        
-        // Debounce logic: mark offline only after 2 consecutive misses
-        if (!found && !g_scan_interrupt_requested) {
-            miss_count[addr - start_addr]++;
-            printf("[SCAN] 0x%02X miss count: %u/2\n", addr, miss_count[addr - start_addr]);
-            
-            if (miss_count[addr - start_addr] >= 2) {
-                module_info_t mi;
-                if (registry_get(addr, &mi) == 0) {
-                    registry_mark_offline(addr);
-                    printf("[SCAN] 0x%02X OFFLINE (debounced)\n", addr);
-                } else {
-                    printf("[SCAN] 0x%02X NOT FOUND (new)\n", addr);
-                }
-            } else {
-                printf("[SCAN] 0x%02X TIMEOUT (debouncing)\n", addr);
-            }
-        }
-        
-        // Small delay between addresses
-        // Inter-address delay, honor pause/interrupt
-        uint32_t gap_ms = 20, e = 0;
-        while (e < gap_ms && !g_scan_interrupt_requested) {
-            while (g_scan_paused && !g_scan_interrupt_requested) { hal_sleep_ms(50); }
-            hal_sleep_ms(5);
-            e += 5;
-        }
-    }
-    
-    g_scan_active = false;
-    registry_set_scanning(false);
-    printf("[SCAN] Scan complete. Saving to modules.yaml\n");
-    (void)registry_save_yaml("modules.yaml");
-    return HAL_STATUS_OK;
+    // Pipelined sweep with adaptive per-address timeouts (module_discovery.c)
+    return module_discovery_scan_range(start_addr, end_addr);
 }
 
 hal_status_t comm_manager_update(void) {
@@ -493,8 +344,8 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    printf("[MODBUS] Sending request: slave=0x%02X, fc=0x%02X, addr=0x%04X, qty=%d\n", 
-           request->slave_id, request->function_code, request->start_address, request->quantity);
+    HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] Sending request: slave=0x%02X, fc=0x%02X, addr=0x%04X, qty=%d",
+             request->slave_id, request->function_code, request->start_address, request->quantity);
     
     // Build Modbus frame
     uint8_t frame[256];
@@ -502,18 +353,15 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
     
     hal_status_t status = build_modbus_request(request, frame, &frame_length);
     if (status != HAL_STATUS_OK) {
-        printf("[MODBUS] ERROR: build_modbus_request failed (status=%d)\n", status);
+        HAL_LOGE(HAL_LOG_COMP_MODBUS, "[MODBUS] ERROR: build_modbus_request failed (status=%d)", status);
         // Ensure comm state is clean on error
         g_comm_manager.waiting_for_response = false;
         g_comm_manager.response_timeout = 0;
         return status;
     }
     
-    printf("[MODBUS] Frame built: length=%d, data=", frame_length);
-    for (int i = 0; i < frame_length; i++) {
-        printf("%02X ", frame[i]);
-    }
-    printf("\n");
+    // Frame bytes go to the per-module trace (HAL_LOG_TRACE_FRAME in the RS485 HAL), not the log
+    HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] Frame built: length=%d", frame_length);
     
     // Send frame with retries
     uint32_t retry_count = 0;
@@ -522,12 +370,13 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
         g_comm_manager.status.statistics.total_transmissions++;
         COMM_UNLOCK();
         
-        printf("[MODBUS] Attempt %u/%u: sending frame...\n", retry_count + 1, g_comm_manager.config.retry_count + 1);
+        HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] Attempt %u/%u: sending frame...", retry_count + 1, g_comm_manager.config.retry_count + 1);
         
         // Send frame
         status = send_modbus_frame(frame, frame_length);
         if (status != HAL_STATUS_OK) {
-            printf("[MODBUS] ERROR: send_modbus_frame failed (status=%d)\n", status);
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_ERROR, 1000,
+                                "[MODBUS] ERROR: send_modbus_frame failed (status=%d)", status);
             g_comm_manager.status.statistics.failed_transmissions++;
             retry_count++;
             
@@ -541,7 +390,7 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
             }
         }
         
-        printf("[MODBUS] Frame sent, waiting for response...\n");
+        HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] Frame sent, waiting for response...");
         
         // Wait for response
         COMM_LOCK();
@@ -558,11 +407,7 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
         
         status = receive_modbus_frame(response_frame, &response_frame_length);
         if (status == HAL_STATUS_OK) {
-            printf("[MODBUS] Response received: length=%d, data=", response_frame_length);
-            for (int i = 0; i < response_frame_length; i++) {
-                printf("%02X ", response_frame[i]);
-            }
-            printf("\n");
+            HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] Response received: length=%d", response_frame_length);
             
             COMM_LOCK();
             g_comm_manager.waiting_for_response = false;
@@ -576,13 +421,14 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
             status = parse_modbus_response(response_frame, response_frame_length, response);
             if (status == HAL_STATUS_OK) {
                 if (response->is_exception) {
-                    printf("[MODBUS] EXCEPTION: %s (code=0x%02X)\n",
-                           comm_manager_get_exception_code_name(response->exception_code),
-                           response->exception_code);
+                    HAL_LOG_RATELIMITED(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_WARNING, 1000,
+                                        "[MODBUS] EXCEPTION: %s (code=0x%02X, slave=0x%02X)",
+                                        comm_manager_get_exception_code_name(response->exception_code),
+                                        response->exception_code, request->slave_id);
                     g_comm_manager.status.statistics.failed_transmissions++;
                     return HAL_STATUS_ERROR;
                 }
-                printf("[MODBUS] Response parsed successfully\n");
+                HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] Response parsed successfully");
                 // Update statistics
                 uint64_t response_time = hal_get_timestamp_us() - start_time;
                 COMM_LOCK();
@@ -596,20 +442,23 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
                 handle_communication_event(COMM_MGR_EVENT_RESPONSE_RECEIVED, response);
                 return HAL_STATUS_OK;
             } else {
-                printf("[MODBUS] ERROR: parse_modbus_response failed (status=%d)\n", status);
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_ERROR, 1000,
+                                    "[MODBUS] ERROR: parse_modbus_response failed (status=%d)", status);
             }
         } else {
-            printf("[MODBUS] ERROR: receive_modbus_frame failed (status=%d - %s)\n", 
-                   status, hal_status_to_string(status));
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[MODBUS] ERROR: receive_modbus_frame failed (slave=0x%02X, status=%d - %s)",
+                                request->slave_id, status, hal_status_to_string(status));
             // Update health monitoring - FAILURE
             update_health_monitoring(false);
             
             // Enhanced error recovery
             if (status == HAL_STATUS_TIMEOUT) {
-                printf("[MODBUS] RECOVERY: Timeout detected, checking device health\n");
+                HAL_LOGD(HAL_LOG_COMP_MODBUS, "[MODBUS] RECOVERY: Timeout detected, checking device health");
                 // Could add device reset logic here
             } else if (status == HAL_STATUS_IO_ERROR) {
-                printf("[MODBUS] RECOVERY: I/O error detected, may need device restart\n");
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_WARNING, 1000,
+                                    "[MODBUS] RECOVERY: I/O error detected, may need device restart");
                 // Could add device restart logic here
             }
         }
@@ -621,7 +470,8 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
         }
     }
     
-    printf("[MODBUS] ERROR: Max retries exceeded\n");
+    HAL_LOG_RATELIMITED(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_ERROR, 1000,
+                        "[MODBUS] ERROR: Max retries exceeded (slave=0x%02X)", request->slave_id);
     // Ensure comm state is clean on exit
     g_comm_manager.waiting_for_response = false;
     g_comm_manager.response_timeout = 0;
@@ -674,6 +524,73 @@ hal_status_t comm_manager_modbus_read_holding_registers(uint8_t slave_id, uint16
     return status;
 }
 
+hal_status_t comm_manager_modbus_probe_holding_registers(uint8_t slave_id, uint16_t start_address,
+                                                         uint16_t quantity, uint16_t *data,
+                                                         uint32_t timeout_ms, uint32_t *rtt_us) {
+    if (!g_comm_manager.initialized || data == NULL || timeout_ms == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!comm_is_valid_slave_id(slave_id) ||
+        !comm_is_valid_quantity_regs(quantity) ||
+        !comm_is_valid_register_range(start_address, quantity)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    comm_mgr_modbus_request_t request = {
+        .slave_id = slave_id,
+        .function_code = MODBUS_FC_READ_HOLDING_REGISTERS,
+        .start_address = start_address,
+        .quantity = quantity
+    };
+    uint8_t frame[256];
+    uint16_t frame_length;
+    hal_status_t status = build_modbus_request(&request, frame, &frame_length);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    COMM_LOCK();
+    g_comm_manager.status.statistics.total_transmissions++;
+    COMM_UNLOCK();
+    status = send_modbus_frame(frame, frame_length);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    
+    uint64_t start_time = hal_get_timestamp_us();
+    uint8_t response[256];
+    size_t response_length = 0;
+    status = hal_rs485_receive_modbus_timeout(response, sizeof(response), &response_length, timeout_ms);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    if (rtt_us != NULL) {
+        *rtt_us = (uint32_t)(hal_get_timestamp_us() - start_time);
+    }
+    
+    if (g_comm_manager.config.enable_crc_check && !modbus_crc16_check_frame(response, response_length)) {
+        COMM_LOCK();
+        g_comm_manager.status.statistics.crc_error_count++;
+        COMM_UNLOCK();
+        return HAL_STATUS_ERROR;
+    }
+    if (response_length < 5 || response[0] != slave_id) {
+        return HAL_STATUS_ERROR;
+    }
+    update_health_monitoring(true);
+    if (response[1] == (MODBUS_FC_READ_HOLDING_REGISTERS | 0x80)) {
+        return HAL_STATUS_NOT_SUPPORTED;
+    }
+    if (response[1] != MODBUS_FC_READ_HOLDING_REGISTERS || response[2] != quantity * 2U ||
+        response_length < 5U + quantity * 2U) {
+        return HAL_STATUS_ERROR;
+    }
+    for (uint16_t i = 0; i < quantity; i++) {
+        data[i] = (uint16_t)((response[3 + i * 2] << 8) | response[4 + i * 2]);
+    }
+    return HAL_STATUS_OK;
+}
+
 hal_status_t comm_manager_modbus_read_input_registers(uint8_t slave_id, uint16_t start_address, 
                                                      uint16_t quantity, uint16_t *data) {
     if (!g_comm_manager.initialized || data == NULL) {
@@ -1034,22 +951,17 @@ static hal_status_t send_modbus_frame(const uint8_t *data, uint16_t length) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // Log TX frame details
-    printf("[RS485-TX] Sending %u bytes: ", length);
-    for (uint16_t i = 0; i < length && i < 16; i++) {
-        printf("%02X ", data[i]);
-    }
-    if (length > 16) printf("...");
-    printf(" (Slave: %02X, Func: %02X)\n", data[0], data[1]);
+    HAL_LOGD(HAL_LOG_COMP_COMM, "[RS485-TX] Sending %u bytes (Slave: %02X, Func: %02X)",
+             length, data[0], length > 1 ? data[1] : 0);
     
     hal_status_t result = hal_rs485_transmit(data, length);
     
     if (result == HAL_STATUS_OK) {
         g_comm_manager.status.statistics.successful_transmissions++;
-        printf("[RS485-TX] Success\n");
+        HAL_LOGD(HAL_LOG_COMP_COMM, "[RS485-TX] Success");
     } else {
         g_comm_manager.status.statistics.failed_transmissions++;
-        printf("[RS485-TX] Failed: status=%d\n", result);
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING, 1000, "[RS485-TX] Failed: status=%d", result);
     }
     
     return result;
@@ -1061,36 +973,31 @@ static hal_status_t receive_modbus_frame(uint8_t *data, uint16_t *length) {
     }
     
     size_t actual_length;
-    // Give the bus a brief settle time after TX before RX
-    hal_sleep_ms(2);
     
-    printf("[RS485-RX] Waiting for response...\n");
-    hal_status_t status = hal_rs485_receive(data, 256, &actual_length);
+    // Frame-length-aware receive: returns on complete frame or t3.5 silence
+    HAL_LOGD(HAL_LOG_COMP_COMM, "[RS485-RX] Waiting for response...");
+    hal_status_t status = hal_rs485_receive_modbus(data, 256, &actual_length);
     
     if (status != HAL_STATUS_OK) {
         g_comm_manager.status.statistics.timeout_count++;
-        printf("[RS485-RX] Timeout/Error: status=%d\n", status);
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING, 1000, "[RS485-RX] Timeout/Error: status=%d", status);
         return status;
     }
     
     *length = (uint16_t)actual_length;
     
-    // Log RX frame details
-    printf("[RS485-RX] Received %u bytes: ", *length);
-    for (uint16_t i = 0; i < *length && i < 16; i++) {
-        printf("%02X ", data[i]);
-    }
-    if (*length > 16) printf("...");
-    printf(" (Slave: %02X, Func: %02X)\n", data[0], data[1]);
+    HAL_LOGD(HAL_LOG_COMP_COMM, "[RS485-RX] Received %u bytes (Slave: %02X, Func: %02X)",
+             *length, data[0], *length > 1 ? data[1] : 0);
     
     // Verify CRC if enabled
     if (g_comm_manager.config.enable_crc_check) {
-        if (!verify_crc16(data, *length)) {
+        if (!modbus_crc16_check_frame(data, *length)) {
             g_comm_manager.status.statistics.crc_error_count++;
-            printf("[RS485-RX] CRC Error - calculated vs received mismatch\n");
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[RS485-RX] CRC Error - calculated vs received mismatch (Slave: %02X)", data[0]);
             return HAL_STATUS_ERROR;
         } else {
-            printf("[RS485-RX] CRC OK\n");
+            HAL_LOGD(HAL_LOG_COMP_COMM, "[RS485-RX] CRC OK");
         }
     }
     
@@ -1098,34 +1005,6 @@ static hal_status_t receive_modbus_frame(uint8_t *data, uint16_t *length) {
     return HAL_STATUS_OK;
 }
 
-static uint16_t calculate_crc16(const uint8_t *data, uint16_t length) {
-    // Standard Modbus RTU CRC16 (LSB first). Compute over ALL provided bytes.
-    uint16_t crc = 0xFFFF;
-    for (uint16_t i = 0; i < length; i++) {
-        crc ^= (uint16_t)data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x0001) {
-                crc = (crc >> 1) ^ 0xA001;
-            } else {
-                crc = (crc >> 1);
-            }
-        }
-    }
-    return crc;
-}
-
-static bool verify_crc16(const uint8_t *data, uint16_t length) {
-    if (length < 3) {
-        return false;
-    }
-    
-    // Received CRC in Modbus RTU is LSB first
-    uint16_t calculated_crc = calculate_crc16(data, length - 2);
-    uint16_t received_crc = (uint16_t)data[length - 2] | ((uint16_t)data[length - 1] << 8);
-    
-    return calculated_crc == received_crc;
-}
-
 static hal_status_t build_modbus_request(const comm_mgr_modbus_request_t *request, uint8_t *frame, uint16_t *frame_length) {
     if (request == NULL || frame == NULL || frame_length == NULL) {
         return HAL_STATUS_INVALID_PARAMETER;
@@ -1154,11 +1033,7 @@ static hal_status_t build_modbus_request(const comm_mgr_modbus_request_t *reques
     }
     
     // Calculate and append CRC (Modbus RTU LSB first)
-    uint16_t crc = calculate_crc16(frame, index);
-    frame[index++] = (uint8_t)(crc & 0xFF);      // Low byte first
-    frame[index++] = (uint8_t)((crc >> 8) & 0xFF); // High byte second
-    
-    *frame_length = index;
+    *frame_length = (uint16_t)modbus_crc16_append(frame, index);
     return HAL_STATUS_OK;
 }
 
@@ -1478,23 +1353,19 @@ bool comm_manager_is_hardware_detected(void) {
 
 // ================= Scan control public APIs (Issue #147) =================
 hal_status_t comm_manager_stop_scanning(void) {
-    g_scan_interrupt_requested = true;
-    return HAL_STATUS_OK;
+    return module_discovery_stop();
 }
 
 hal_status_t comm_manager_pause_scanning(void) {
-    if (!g_scan_active) return HAL_STATUS_INVALID_STATE;
-    g_scan_paused = true;
-    return HAL_STATUS_OK;
+    return module_discovery_pause();
 }
 
 hal_status_t comm_manager_resume_scanning(void) {
-    g_scan_paused = false;
-    return HAL_STATUS_OK;
+    return module_discovery_resume();
 }
 
 bool comm_manager_is_scanning(void) {
-    return g_scan_active;
+    return module_discovery_is_scanning();
 }
 
 // ============================================================================
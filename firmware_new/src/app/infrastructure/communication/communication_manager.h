@@ -236,6 +236,26 @@ hal_status_t comm_manager_modbus_send_request(const comm_mgr_modbus_request_t *r
 hal_status_t comm_manager_modbus_read_holding_registers(uint8_t slave_id, uint16_t start_address, 
                                                        uint16_t quantity, uint16_t *data);
 
+/**
+ * @brief Single-attempt holding register read for address probing
+ *
+ * No retries, and the response timeout is the caller's rather than the
+ * configured one. A timeout is the normal result for an empty address, so
+ * it does not count against link health.
+ *
+ * @param slave_id Slave ID
+ * @param start_address Start address
+ * @param quantity Quantity
+ * @param data Data buffer
+ * @param timeout_ms First-byte timeout
+ * @param rtt_us Request sent -> response complete, set when the slave answered (may be NULL)
+ * @return HAL_STATUS_OK, HAL_STATUS_TIMEOUT if nothing answered,
+ *         HAL_STATUS_NOT_SUPPORTED for an exception response, HAL_STATUS_ERROR for a bad frame
+ */
+hal_status_t comm_manager_modbus_probe_holding_registers(uint8_t slave_id, uint16_t start_address,
+                                                         uint16_t quantity, uint16_t *data,
+                                                         uint32_t timeout_ms, uint32_t *rtt_us);
+
 /**
  * @brief Read input registers
  * @param slave_id Slave ID
@@ -340,6 +360,10 @@ hal_status_t comm_manager_reset(void);
 // Phase 1 scan API
 /**
  * @brief Scan RS485 address range and update registry
+ *
+ * Probes are pipelined on the bus master with per-address adaptive
+ * timeouts; see module_discovery.h.
+ *
  * @param start_addr e.g., 0x02
  * @param end_addr e.g., 0x07 (inclusive)
  * @return HAL status
@@ -354,7 +378,7 @@ hal_status_t comm_manager_scan_range(uint8_t start_addr, uint8_t end_addr);
 hal_status_t comm_manager_stop_scanning(void);
 
 /**
- * @brief Pause ongoing RS485 scan
+ * @brief Pause RS485 discovery (range scan and background rescan)
  * @return HAL status
  */
 hal_status_t comm_manager_pause_scanning(void);
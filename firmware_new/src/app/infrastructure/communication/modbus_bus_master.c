@@ -0,0 +1,568 @@
+/**
+ * @file modbus_bus_master.c
+ * @brief RS485 bus master - single owner thread with prioritized transaction queue
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @author FW Team
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include "modbus_bus_master.h"
+#include "communication_manager.h"
+
+// Transaction slot (one per queued transaction or job)
+typedef struct {
+    bool in_use;
+    bool sync;                       // A caller is blocked on done_cond
+    bool done;
+    bool abandoned;                  // Sync caller timed out; bus frees the slot unsent
+    modbus_bus_priority_t prio;
+    modbus_bus_op_t op;
+    uint8_t slave_id;
+    uint16_t start_address;
+    uint16_t quantity;
+    uint16_t regs[MODBUS_BUS_MAX_REGISTERS];  // Write payload in, read result out
+    modbus_bus_job_fn_t fn;
+    void *ctx;
+    modbus_bus_done_cb_t done_cb;
+    void *done_ctx;
+    hal_status_t status;
+    uint64_t enqueue_us;
+    pthread_cond_t done_cond;
+} bus_slot_t;
+
+// Per-priority FIFO of slot pointers
+typedef struct {
+    bus_slot_t slots[MODBUS_BUS_QUEUE_DEPTH];
+    bus_slot_t *ring[MODBUS_BUS_QUEUE_DEPTH];
+    uint32_t head;
+    uint32_t count;
+} bus_queue_t;
+
+static struct {
+    bool initialized;
+    bool running;
+    bool stop_requested;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    bus_queue_t queues[MODBUS_BUS_PRIO_COUNT];
+    modbus_bus_stats_t stats;
+} g_bus = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+// Bus-thread context: set while a job is executing on the bus thread
+static __thread bool t_on_bus_thread = false;
+
+static const char *const g_prio_names[MODBUS_BUS_PRIO_COUNT] = {
+    "SAFETY", "COMMAND", "TELEMETRY", "DISCOVERY"
+};
+
+// Forward declarations
+static void *bus_thread_main(void *arg);
+static bus_slot_t *bus_alloc_slot_locked(modbus_bus_priority_t prio);
+static void bus_free_slot_locked(bus_slot_t *slot);
+static void bus_push_locked(bus_slot_t *slot);
+static bus_slot_t *bus_pop_locked(modbus_bus_priority_t below);
+static void bus_serve(bus_slot_t *slot);
+static void bus_serve_higher(modbus_bus_priority_t prio);
+static hal_status_t bus_execute(modbus_bus_op_t op, uint8_t slave_id, uint16_t start_address,
+                                uint16_t quantity, uint16_t *regs,
+                                modbus_bus_job_fn_t fn, void *ctx);
+static hal_status_t bus_transact(modbus_bus_priority_t prio, modbus_bus_op_t op, uint8_t slave_id,
+                                 uint16_t start_address, uint16_t quantity, uint16_t *regs);
+
+static inline bool bus_prio_valid(modbus_bus_priority_t prio) {
+    return (unsigned)prio < (unsigned)MODBUS_BUS_PRIO_COUNT;
+}
+
+// Lifecycle
+
+hal_status_t modbus_bus_master_init(void) {
+    pthread_mutex_lock(&g_bus.mutex);
+    if (g_bus.initialized) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    pthread_cond_init(&g_bus.work_cond, &attr);
+    for (int p = 0; p < MODBUS_BUS_PRIO_COUNT; p++) {
+        bus_queue_t *q = &g_bus.queues[p];
+        memset(q->slots, 0, sizeof(q->slots));
+        q->head = 0;
+        q->count = 0;
+        for (int i = 0; i < MODBUS_BUS_QUEUE_DEPTH; i++) {
+            pthread_cond_init(&q->slots[i].done_cond, &attr);
+        }
+    }
+    pthread_condattr_destroy(&attr);
+
+    memset(&g_bus.stats, 0, sizeof(g_bus.stats));
+    g_bus.running = false;
+    g_bus.stop_requested = false;
+    g_bus.initialized = true;
+    pthread_mutex_unlock(&g_bus.mutex);
+
+    printf("[BUS] Modbus bus master initialized (%d priorities x %d slots)\n",
+           MODBUS_BUS_PRIO_COUNT, MODBUS_BUS_QUEUE_DEPTH);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_bus_master_start(void) {
+    pthread_mutex_lock(&g_bus.mutex);
+    if (!g_bus.initialized) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    if (g_bus.running) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        return HAL_STATUS_OK;
+    }
+    g_bus.stop_requested = false;
+    if (pthread_create(&g_bus.thread, NULL, bus_thread_main, NULL) != 0) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        printf("[BUS] ERROR: failed to create bus thread\n");
+        return HAL_STATUS_ERROR;
+    }
+    g_bus.running = true;
+    g_bus.stats.running = true;
+    pthread_mutex_unlock(&g_bus.mutex);
+
+    printf("[BUS] Bus thread started\n");
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_bus_master_stop(void) {
+    pthread_mutex_lock(&g_bus.mutex);
+    if (!g_bus.initialized || !g_bus.running) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        return HAL_STATUS_OK;
+    }
+    g_bus.stop_requested = true;
+    pthread_cond_broadcast(&g_bus.work_cond);
+    pthread_mutex_unlock(&g_bus.mutex);
+
+    pthread_join(g_bus.thread, NULL);
+
+    // Fail whatever is still queued so no caller waits forever
+    pthread_mutex_lock(&g_bus.mutex);
+    g_bus.running = false;
+    g_bus.stats.running = false;
+    bus_slot_t *slot;
+    while ((slot = bus_pop_locked(MODBUS_BUS_PRIO_COUNT)) != NULL) {
+        slot->status = HAL_STATUS_NOT_INITIALIZED;
+        g_bus.stats.prio[slot->prio].failed++;
+        if (slot->sync && !slot->abandoned) {
+            slot->done = true;
+            pthread_cond_signal(&slot->done_cond);
+        } else {
+            modbus_bus_done_cb_t cb = slot->done_cb;
+            void *cb_ctx = slot->done_ctx;
+            bus_free_slot_locked(slot);
+            if (cb) {
+                pthread_mutex_unlock(&g_bus.mutex);
+                cb(HAL_STATUS_NOT_INITIALIZED, cb_ctx);
+                pthread_mutex_lock(&g_bus.mutex);
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_bus.mutex);
+
+    printf("[BUS] Bus thread stopped\n");
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_bus_master_deinit(void) {
+    if (!g_bus.initialized) {
+        return HAL_STATUS_OK;
+    }
+    modbus_bus_master_stop();
+
+    pthread_mutex_lock(&g_bus.mutex);
+    for (int p = 0; p < MODBUS_BUS_PRIO_COUNT; p++) {
+        for (int i = 0; i < MODBUS_BUS_QUEUE_DEPTH; i++) {
+            pthread_cond_destroy(&g_bus.queues[p].slots[i].done_cond);
+        }
+    }
+    pthread_cond_destroy(&g_bus.work_cond);
+    g_bus.initialized = false;
+    pthread_mutex_unlock(&g_bus.mutex);
+    return HAL_STATUS_OK;
+}
+
+bool modbus_bus_master_is_running(void) {
+    pthread_mutex_lock(&g_bus.mutex);
+    bool running = g_bus.running;
+    pthread_mutex_unlock(&g_bus.mutex);
+    return running;
+}
+
+// Synchronous transactions
+
+hal_status_t modbus_bus_read_holding(modbus_bus_priority_t prio, uint8_t slave_id,
+                                     uint16_t start_address, uint16_t quantity, uint16_t *data) {
+    if (data == NULL || quantity == 0 || quantity > MODBUS_BUS_MAX_REGISTERS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    return bus_transact(prio, MODBUS_BUS_OP_READ_HOLDING, slave_id, start_address, quantity, data);
+}
+
+hal_status_t modbus_bus_read_input(modbus_bus_priority_t prio, uint8_t slave_id,
+                                   uint16_t start_address, uint16_t quantity, uint16_t *data) {
+    if (data == NULL || quantity == 0 || quantity > MODBUS_BUS_MAX_REGISTERS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    return bus_transact(prio, MODBUS_BUS_OP_READ_INPUT, slave_id, start_address, quantity, data);
+}
+
+hal_status_t modbus_bus_write_single(modbus_bus_priority_t prio, uint8_t slave_id,
+                                     uint16_t address, uint16_t value) {
+    return bus_transact(prio, MODBUS_BUS_OP_WRITE_SINGLE, slave_id, address, 1, &value);
+}
+
+hal_status_t modbus_bus_write_multiple(modbus_bus_priority_t prio, uint8_t slave_id,
+                                       uint16_t start_address, uint16_t quantity, const uint16_t *data) {
+    if (data == NULL || quantity == 0 || quantity > MODBUS_BUS_MAX_REGISTERS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    uint16_t regs[MODBUS_BUS_MAX_REGISTERS];
+    memcpy(regs, data, (size_t)quantity * sizeof(uint16_t));
+    return bus_transact(prio, MODBUS_BUS_OP_WRITE_MULTIPLE, slave_id, start_address, quantity, regs);
+}
+
+hal_status_t modbus_bus_probe_holding(modbus_bus_priority_t prio, uint8_t slave_id,
+                                      uint16_t start_address, uint16_t quantity, uint16_t *data,
+                                      uint32_t timeout_ms, uint32_t *rtt_us) {
+    if (!bus_prio_valid(prio) || data == NULL || quantity == 0 || quantity > MODBUS_BUS_MAX_REGISTERS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (t_on_bus_thread) {
+        bus_serve_higher(prio);
+    } else if (modbus_bus_master_is_running()) {
+        // Only the bus thread may own the wire while it runs
+        return HAL_STATUS_INVALID_STATE;
+    }
+    return comm_manager_modbus_probe_holding_registers(slave_id, start_address, quantity, data,
+                                                       timeout_ms, rtt_us);
+}
+
+// Asynchronous jobs
+
+hal_status_t modbus_bus_submit_job(modbus_bus_priority_t prio, modbus_bus_job_fn_t fn, void *ctx,
+                                   modbus_bus_done_cb_t done_cb, void *done_ctx) {
+    if (!bus_prio_valid(prio) || fn == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_bus.mutex);
+    if (!g_bus.initialized || !g_bus.running) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        // No bus thread: run the job on the caller, same as synchronous transactions
+        hal_status_t status = fn(ctx);
+        if (done_cb) {
+            done_cb(status, done_ctx);
+        }
+        return status;
+    }
+
+    bus_slot_t *slot = bus_alloc_slot_locked(prio);
+    if (slot == NULL) {
+        g_bus.stats.prio[prio].rejected++;
+        pthread_mutex_unlock(&g_bus.mutex);
+        return HAL_STATUS_BUSY;
+    }
+    slot->op = MODBUS_BUS_OP_JOB;
+    slot->fn = fn;
+    slot->ctx = ctx;
+    slot->done_cb = done_cb;
+    slot->done_ctx = done_ctx;
+    bus_push_locked(slot);
+    pthread_mutex_unlock(&g_bus.mutex);
+    return HAL_STATUS_OK;
+}
+
+// Statistics
+
+hal_status_t modbus_bus_get_stats(modbus_bus_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_bus.mutex);
+    *stats = g_bus.stats;
+    pthread_mutex_unlock(&g_bus.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_bus_reset_stats(void) {
+    pthread_mutex_lock(&g_bus.mutex);
+    for (int p = 0; p < MODBUS_BUS_PRIO_COUNT; p++) {
+        uint32_t depth = g_bus.stats.prio[p].depth;
+        memset(&g_bus.stats.prio[p], 0, sizeof(g_bus.stats.prio[p]));
+        g_bus.stats.prio[p].depth = depth;
+        g_bus.stats.prio[p].max_depth = depth;
+    }
+    g_bus.stats.preemptions = 0;
+    g_bus.stats.busy_us = 0;
+    pthread_mutex_unlock(&g_bus.mutex);
+    return HAL_STATUS_OK;
+}
+
+const char* modbus_bus_priority_to_string(modbus_bus_priority_t prio) {
+    return bus_prio_valid(prio) ? g_prio_names[prio] : "UNKNOWN";
+}
+
+// Private functions
+
+static void *bus_thread_main(void *arg) {
+    (void)arg;
+    t_on_bus_thread = true;
+
+    pthread_mutex_lock(&g_bus.mutex);
+    while (!g_bus.stop_requested) {
+        bus_slot_t *slot = bus_pop_locked(MODBUS_BUS_PRIO_COUNT);
+        if (slot == NULL) {
+            pthread_cond_wait(&g_bus.work_cond, &g_bus.mutex);
+            continue;
+        }
+        pthread_mutex_unlock(&g_bus.mutex);
+        bus_serve(slot);
+        pthread_mutex_lock(&g_bus.mutex);
+    }
+    pthread_mutex_unlock(&g_bus.mutex);
+    return NULL;
+}
+
+static bus_slot_t *bus_alloc_slot_locked(modbus_bus_priority_t prio) {
+    bus_queue_t *q = &g_bus.queues[prio];
+    for (int i = 0; i < MODBUS_BUS_QUEUE_DEPTH; i++) {
+        bus_slot_t *slot = &q->slots[i];
+        if (!slot->in_use) {
+            slot->in_use = true;
+            slot->sync = false;
+            slot->done = false;
+            slot->abandoned = false;
+            slot->prio = prio;
+            slot->fn = NULL;
+            slot->ctx = NULL;
+            slot->done_cb = NULL;
+            slot->done_ctx = NULL;
+            slot->status = HAL_STATUS_ERROR;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static void bus_free_slot_locked(bus_slot_t *slot) {
+    slot->in_use = false;
+}
+
+static void bus_push_locked(bus_slot_t *slot) {
+    bus_queue_t *q = &g_bus.queues[slot->prio];
+    modbus_bus_prio_stats_t *ps = &g_bus.stats.prio[slot->prio];
+
+    q->ring[(q->head + q->count) % MODBUS_BUS_QUEUE_DEPTH] = slot;
+    q->count++;
+    slot->enqueue_us = hal_time_now_us();
+
+    ps->submitted++;
+    ps->depth = q->count;
+    if (ps->depth > ps->max_depth) {
+        ps->max_depth = ps->depth;
+    }
+    pthread_cond_signal(&g_bus.work_cond);
+}
+
+// Pop the oldest slot from the highest non-empty priority strictly above 'below'
+static bus_slot_t *bus_pop_locked(modbus_bus_priority_t below) {
+    for (int p = 0; p < (int)below && p < MODBUS_BUS_PRIO_COUNT; p++) {
+        bus_queue_t *q = &g_bus.queues[p];
+        while (q->count > 0) {
+            bus_slot_t *slot = q->ring[q->head];
+            q->head = (q->head + 1) % MODBUS_BUS_QUEUE_DEPTH;
+            q->count--;
+            g_bus.stats.prio[p].depth = q->count;
+
+            // The caller already reported a timeout; a late write must not reach the wire
+            if (slot->abandoned) {
+                g_bus.stats.prio[p].dropped++;
+                bus_free_slot_locked(slot);
+                continue;
+            }
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+// Execute a dequeued slot on the bus thread and complete it
+static void bus_serve(bus_slot_t *slot) {
+    uint64_t start_us = hal_time_now_us();
+    hal_status_t status = bus_execute(slot->op, slot->slave_id, slot->start_address,
+                                      slot->quantity, slot->regs, slot->fn, slot->ctx);
+    uint64_t end_us = hal_time_now_us();
+    uint64_t wait_us = start_us - slot->enqueue_us;
+    uint64_t service_us = end_us - start_us;
+
+    pthread_mutex_lock(&g_bus.mutex);
+    modbus_bus_prio_stats_t *ps = &g_bus.stats.prio[slot->prio];
+    if (status == HAL_STATUS_OK) {
+        ps->completed++;
+    } else {
+        ps->failed++;
+    }
+    ps->total_wait_us += wait_us;
+    if (wait_us > ps->max_wait_us) {
+        ps->max_wait_us = wait_us;
+    }
+    ps->total_service_us += service_us;
+    if (service_us > ps->max_service_us) {
+        ps->max_service_us = service_us;
+    }
+    g_bus.stats.busy_us += service_us;
+
+    slot->status = status;
+    if (slot->sync && !slot->abandoned) {
+        slot->done = true;
+        pthread_cond_signal(&slot->done_cond);
+        pthread_mutex_unlock(&g_bus.mutex);
+        return;
+    }
+
+    modbus_bus_done_cb_t cb = slot->done_cb;
+    void *cb_ctx = slot->done_ctx;
+    bus_free_slot_locked(slot);
+    pthread_mutex_unlock(&g_bus.mutex);
+
+    if (cb) {
+        cb(status, cb_ctx);
+    }
+}
+
+// Preemption point: serve everything queued above 'prio' before continuing a job
+static void bus_serve_higher(modbus_bus_priority_t prio) {
+    for (;;) {
+        pthread_mutex_lock(&g_bus.mutex);
+        bus_slot_t *slot = bus_pop_locked(prio);
+        if (slot != NULL) {
+            g_bus.stats.preemptions++;
+        }
+        pthread_mutex_unlock(&g_bus.mutex);
+        if (slot == NULL) {
+            return;
+        }
+        bus_serve(slot);
+    }
+}
+
+static hal_status_t bus_execute(modbus_bus_op_t op, uint8_t slave_id, uint16_t start_address,
+                                uint16_t quantity, uint16_t *regs,
+                                modbus_bus_job_fn_t fn, void *ctx) {
+    switch (op) {
+        case MODBUS_BUS_OP_READ_HOLDING:
+            return comm_manager_modbus_read_holding_registers(slave_id, start_address, quantity, regs);
+        case MODBUS_BUS_OP_READ_INPUT:
+            return comm_manager_modbus_read_input_registers(slave_id, start_address, quantity, regs);
+        case MODBUS_BUS_OP_WRITE_SINGLE:
+            return comm_manager_modbus_write_single_register(slave_id, start_address, regs[0]);
+        case MODBUS_BUS_OP_WRITE_MULTIPLE:
+            return comm_manager_modbus_write_multiple_registers(slave_id, start_address, quantity, regs);
+        case MODBUS_BUS_OP_JOB:
+            return fn ? fn(ctx) : HAL_STATUS_INVALID_PARAMETER;
+        default:
+            return HAL_STATUS_INVALID_PARAMETER;
+    }
+}
+
+static hal_status_t bus_transact(modbus_bus_priority_t prio, modbus_bus_op_t op, uint8_t slave_id,
+                                 uint16_t start_address, uint16_t quantity, uint16_t *regs) {
+    if (!bus_prio_valid(prio)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    // Already on the bus thread (inside a job): yield to higher priorities, then run inline
+    if (t_on_bus_thread) {
+        bus_serve_higher(prio);
+        uint64_t start_us = hal_time_now_us();
+        hal_status_t status = bus_execute(op, slave_id, start_address, quantity, regs, NULL, NULL);
+        uint64_t service_us = hal_time_now_us() - start_us;
+
+        pthread_mutex_lock(&g_bus.mutex);
+        modbus_bus_prio_stats_t *ps = &g_bus.stats.prio[prio];
+        ps->submitted++;
+        if (status == HAL_STATUS_OK) {
+            ps->completed++;
+        } else {
+            ps->failed++;
+        }
+        ps->total_service_us += service_us;
+        if (service_us > ps->max_service_us) {
+            ps->max_service_us = service_us;
+        }
+        pthread_mutex_unlock(&g_bus.mutex);
+        return status;
+    }
+
+    pthread_mutex_lock(&g_bus.mutex);
+    if (!g_bus.initialized || !g_bus.running) {
+        pthread_mutex_unlock(&g_bus.mutex);
+        // No bus thread (early boot, shutdown, unit tests): execute on the caller
+        return bus_execute(op, slave_id, start_address, quantity, regs, NULL, NULL);
+    }
+
+    bus_slot_t *slot = bus_alloc_slot_locked(prio);
+    if (slot == NULL) {
+        g_bus.stats.prio[prio].rejected++;
+        pthread_mutex_unlock(&g_bus.mutex);
+        return HAL_STATUS_BUSY;
+    }
+    slot->sync = true;
+    slot->op = op;
+    slot->slave_id = slave_id;
+    slot->start_address = start_address;
+    slot->quantity = quantity;
+    memcpy(slot->regs, regs, (size_t)quantity * sizeof(uint16_t));
+    bus_push_locked(slot);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += MODBUS_BUS_SYNC_TIMEOUT_MS / 1000;
+    deadline.tv_nsec += (long)(MODBUS_BUS_SYNC_TIMEOUT_MS % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (!slot->done) {
+        if (pthread_cond_timedwait(&slot->done_cond, &g_bus.mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    hal_status_t status;
+    if (slot->done) {
+        status = slot->status;
+        if (op == MODBUS_BUS_OP_READ_HOLDING || op == MODBUS_BUS_OP_READ_INPUT) {
+            memcpy(regs, slot->regs, (size_t)quantity * sizeof(uint16_t));
+        }
+        bus_free_slot_locked(slot);
+    } else {
+        // Leave the slot to the bus thread: it drops it if still queued, or
+        // frees it after service if it is already on the wire
+        slot->abandoned = true;
+        g_bus.stats.prio[prio].timed_out++;
+        status = HAL_STATUS_TIMEOUT;
+    }
+    pthread_mutex_unlock(&g_bus.mutex);
+    return status;
+}
+
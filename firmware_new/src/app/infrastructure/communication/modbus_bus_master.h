@@ -0,0 +1,223 @@
+/**
+ * @file modbus_bus_master.h
+ * @brief RS485 bus master - single owner thread with prioritized transaction queue
+ * @version 1.0.0
+ * @date 2025-01-28
+ * @author FW Team
+ *
+ * All Modbus traffic is funnelled through one bus thread so that frames from
+ * the API, polling and discovery paths can never interleave on the wire.
+ * Transactions are served strictly by priority; a running job yields to
+ * queued higher-priority transactions at every transaction boundary.
+ */
+
+#ifndef MODBUS_BUS_MASTER_H
+#define MODBUS_BUS_MASTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_common.h"
+
+// Queue configuration
+#define MODBUS_BUS_QUEUE_DEPTH        16     // Slots per priority level
+#define MODBUS_BUS_MAX_REGISTERS      125    // Modbus FC03/FC04 limit
+#define MODBUS_BUS_SYNC_TIMEOUT_MS    5000   // Upper bound for a synchronous caller
+
+// Transaction priorities (lower value = served first)
+typedef enum {
+    MODBUS_BUS_PRIO_SAFETY = 0,       // Safety module reads/writes
+    MODBUS_BUS_PRIO_COMMAND,          // Operator/API writes, motion commands
+    MODBUS_BUS_PRIO_TELEMETRY,        // Periodic polling
+    MODBUS_BUS_PRIO_DISCOVERY,        // Address scanning
+    MODBUS_BUS_PRIO_COUNT
+} modbus_bus_priority_t;
+
+// Transaction kinds
+typedef enum {
+    MODBUS_BUS_OP_READ_HOLDING = 0,
+    MODBUS_BUS_OP_READ_INPUT,
+    MODBUS_BUS_OP_WRITE_SINGLE,
+    MODBUS_BUS_OP_WRITE_MULTIPLE,
+    MODBUS_BUS_OP_JOB                 // Caller-supplied sequence of transactions
+} modbus_bus_op_t;
+
+/**
+ * @brief Job body executed on the bus thread
+ * @param ctx Caller context
+ * @return HAL status
+ */
+typedef hal_status_t (*modbus_bus_job_fn_t)(void *ctx);
+
+/**
+ * @brief Completion callback for asynchronous submissions (runs on the bus thread)
+ * @param status Result of the transaction or job
+ * @param ctx Caller context
+ */
+typedef void (*modbus_bus_done_cb_t)(hal_status_t status, void *ctx);
+
+// Per-priority statistics
+typedef struct {
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t failed;
+    uint64_t rejected;               // Queue full or bus not accepting work
+    uint64_t timed_out;              // Synchronous caller gave up waiting
+    uint64_t dropped;                // Timed out before service, never sent
+    uint32_t depth;                  // Currently queued
+    uint32_t max_depth;
+    uint64_t total_wait_us;          // Enqueue -> start of service
+    uint64_t max_wait_us;
+    uint64_t total_service_us;       // Start -> end of service
+    uint64_t max_service_us;
+} modbus_bus_prio_stats_t;
+
+// Bus master statistics
+typedef struct {
+    modbus_bus_prio_stats_t prio[MODBUS_BUS_PRIO_COUNT];
+    uint64_t preemptions;            // Higher-priority work served inside a running job
+    uint64_t busy_us;                // Total time the bus thread spent serving work
+    bool running;
+} modbus_bus_stats_t;
+
+// Lifecycle
+
+/**
+ * @brief Initialize bus master state (queues, slots, statistics)
+ * @return HAL status
+ */
+hal_status_t modbus_bus_master_init(void);
+
+/**
+ * @brief Start the bus thread
+ * @return HAL status
+ */
+hal_status_t modbus_bus_master_start(void);
+
+/**
+ * @brief Stop the bus thread; queued work is failed with HAL_STATUS_NOT_INITIALIZED
+ * @return HAL status
+ */
+hal_status_t modbus_bus_master_stop(void);
+
+/**
+ * @brief Deinitialize bus master (stops the thread if running)
+ * @return HAL status
+ */
+hal_status_t modbus_bus_master_deinit(void);
+
+/**
+ * @brief Check whether the bus thread is running
+ * @return true if transactions are dispatched by the bus thread
+ */
+bool modbus_bus_master_is_running(void);
+
+// Synchronous transactions
+// When the bus thread is not running these execute directly on the caller.
+// When called from a job on the bus thread they execute inline, after any
+// queued higher-priority work has been served.
+
+/**
+ * @brief Read holding registers through the bus master
+ * @param prio Transaction priority
+ * @param slave_id Slave ID
+ * @param start_address Start address
+ * @param quantity Quantity (1..125)
+ * @param data Output buffer
+ * @return HAL status
+ */
+hal_status_t modbus_bus_read_holding(modbus_bus_priority_t prio, uint8_t slave_id,
+                                     uint16_t start_address, uint16_t quantity, uint16_t *data);
+
+/**
+ * @brief Read input registers through the bus master
+ * @param prio Transaction priority
+ * @param slave_id Slave ID
+ * @param start_address Start address
+ * @param quantity Quantity (1..125)
+ * @param data Output buffer
+ * @return HAL status
+ */
+hal_status_t modbus_bus_read_input(modbus_bus_priority_t prio, uint8_t slave_id,
+                                   uint16_t start_address, uint16_t quantity, uint16_t *data);
+
+/**
+ * @brief Write single register through the bus master
+ * @param prio Transaction priority
+ * @param slave_id Slave ID
+ * @param address Register address
+ * @param value Register value
+ * @return HAL status
+ */
+hal_status_t modbus_bus_write_single(modbus_bus_priority_t prio, uint8_t slave_id,
+                                     uint16_t address, uint16_t value);
+
+/**
+ * @brief Write multiple registers through the bus master
+ * @param prio Transaction priority
+ * @param slave_id Slave ID
+ * @param start_address Start address
+ * @param quantity Quantity (1..123)
+ * @param data Register values
+ * @return HAL status
+ */
+hal_status_t modbus_bus_write_multiple(modbus_bus_priority_t prio, uint8_t slave_id,
+                                       uint16_t start_address, uint16_t quantity, const uint16_t *data);
+
+/**
+ * @brief Single-attempt holding register read with a caller-chosen timeout (address probing)
+ *
+ * For job bodies: on the bus thread it runs inline after queued
+ * higher-priority work; with the bus thread stopped it runs on the caller.
+ * No retries, so an empty address costs exactly one timeout.
+ *
+ * @param prio Priority the probe yields to
+ * @param slave_id Slave ID
+ * @param start_address Start address
+ * @param quantity Quantity (1..125)
+ * @param data Output buffer
+ * @param timeout_ms First-byte timeout
+ * @param rtt_us Round trip if the slave answered (may be NULL)
+ * @return See comm_manager_modbus_probe_holding_registers();
+ *         HAL_STATUS_INVALID_STATE if called off the running bus thread
+ */
+hal_status_t modbus_bus_probe_holding(modbus_bus_priority_t prio, uint8_t slave_id,
+                                      uint16_t start_address, uint16_t quantity, uint16_t *data,
+                                      uint32_t timeout_ms, uint32_t *rtt_us);
+
+// Asynchronous jobs
+
+/**
+ * @brief Queue a job for execution on the bus thread
+ * @param prio Job priority
+ * @param fn Job body; may issue modbus_bus_* transactions
+ * @param ctx Job context (must stay valid until done_cb runs)
+ * @param done_cb Optional completion callback
+ * @param done_ctx Completion callback context
+ * @return HAL_STATUS_OK if queued, HAL_STATUS_BUSY if the queue is full
+ */
+hal_status_t modbus_bus_submit_job(modbus_bus_priority_t prio, modbus_bus_job_fn_t fn, void *ctx,
+                                   modbus_bus_done_cb_t done_cb, void *done_ctx);
+
+// Statistics
+
+/**
+ * @brief Get bus master statistics
+ * @param stats Output statistics
+ * @return HAL status
+ */
+hal_status_t modbus_bus_get_stats(modbus_bus_stats_t *stats);
+
+/**
+ * @brief Reset bus master statistics (queue depths are preserved)
+ * @return HAL status
+ */
+hal_status_t modbus_bus_reset_stats(void);
+
+/**
+ * @brief Get priority name
+ * @param prio Priority
+ * @return Priority name string
+ */
+const char* modbus_bus_priority_to_string(modbus_bus_priority_t prio);
+
+#endif // MODBUS_BUS_MASTER_H
@@ -0,0 +1,778 @@
+/**
+ * @file module_discovery.c
+ * @brief Pipelined RS485 module discovery with adaptive per-address timeouts
+ * @version 1.0.0
+ * @date 2025-02-18
+ * @author FW Team
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include "module_discovery.h"
+#include "modbus_bus_master.h"
+#include "module_registry.h"
+#include "constants.h"
+#include "hal_log.h"
+
+#define DISCOVERY_ADDR_MIN          0x01U
+#define DISCOVERY_ADDR_MAX          0xF7U   // Highest Modbus unicast address
+#define DISCOVERY_MAX_BACKOFF       4U      // Timeout doublings after misses
+#define DISCOVERY_WAIT_SLICE_MS     5U      // Blocking loops re-check pause/stop this often
+
+// One queued probe; owned by the bus thread between submit and done callback
+typedef struct {
+    bool in_use;
+    uint8_t address;
+    uint32_t timeout_ms;
+    uint32_t rtt_us;
+    uint16_t regs[MODULE_DISCOVERY_ID_REG_COUNT];
+} discovery_probe_t;
+
+// Per-address state
+typedef struct {
+    bool online;
+    bool has_rtt;
+    bool in_flight;
+    bool result_ready;                  // Finished on the bus thread, not applied yet
+    uint8_t misses;
+    uint8_t backoff;
+    uint32_t srtt_us;
+    uint32_t rttvar_us;
+    uint32_t probes;
+    uint32_t responses;
+    uint32_t timeouts;
+    hal_status_t result;
+    uint32_t result_rtt_us;
+    uint16_t result_regs[MODULE_DISCOVERY_ID_REG_COUNT];
+    uint16_t identity[MODULE_DISCOVERY_ID_REG_COUNT];   // Last full answer
+} discovery_addr_t;
+
+// Finished probe copied out of the lock for registry updates
+typedef struct {
+    uint8_t address;
+    hal_status_t status;
+    uint16_t regs[MODULE_DISCOVERY_ID_REG_COUNT];
+} discovery_result_t;
+
+static struct {
+    bool initialized;
+    module_discovery_config_t config;
+    discovery_addr_t addrs[DISCOVERY_ADDR_MAX + 1U];
+    discovery_probe_t probes[MODULE_DISCOVERY_MAX_IN_FLIGHT];
+    uint32_t in_flight;
+
+    // Bus-wide estimate for addresses without samples of their own
+    bool bus_has_rtt;
+    uint32_t bus_srtt_us;
+    uint32_t bus_rttvar_us;
+
+    // Background rescan
+    uint8_t pass[DISCOVERY_ADDR_MAX + 1U];
+    size_t pass_len;
+    size_t pass_pos;
+    uint64_t next_probe_ms;
+
+    bool online_changed;                // Cache needs saving
+    bool interrupt_requested;
+    bool paused;
+    bool scanning;
+    module_discovery_stats_t stats;
+} g_discovery;
+
+static pthread_mutex_t g_discovery_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_discovery_cond;
+static pthread_once_t g_discovery_once = PTHREAD_ONCE_INIT;
+
+// Forward declarations
+static void discovery_init_cond(void);
+static void discovery_wait_locked(uint32_t timeout_ms);
+static uint32_t discovery_timeout_locked(uint8_t address);
+static void discovery_observe_locked(uint8_t address, hal_status_t status, uint32_t rtt_us);
+static hal_status_t discovery_submit(uint8_t address);
+static hal_status_t discovery_probe_job(void *ctx);
+static void discovery_probe_done(hal_status_t status, void *ctx);
+static size_t discovery_apply_results(void);
+static void discovery_save_if_changed(void);
+static module_type_t discovery_decode_type(uint8_t address, hal_status_t status, const uint16_t *regs);
+static hal_status_t discovery_run(const uint8_t *targets, size_t count, uint32_t budget_ms);
+static bool discovery_ensure_init(void);
+static void discovery_build_pass_locked(void);
+
+static inline bool discovery_addr_valid(uint8_t address) {
+    return address >= DISCOVERY_ADDR_MIN && address <= DISCOVERY_ADDR_MAX;
+}
+
+static inline bool discovery_answered(hal_status_t status) {
+    // An exception response still proves a slave is at the address
+    return status == HAL_STATUS_OK || status == HAL_STATUS_NOT_SUPPORTED;
+}
+
+// Lifecycle
+
+void module_discovery_get_default_config(module_discovery_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+    memset(config, 0, sizeof(*config));
+    config->range_start = MANDATORY_MODULE_ADDR_START;
+    config->range_end = MODULE_ADDR_MAX;
+    config->initial_timeout_ms = 50;
+    config->min_timeout_ms = 10;
+    config->max_timeout_ms = 200;
+    config->rescan_interval_ms = 100;
+    config->miss_limit = 2;
+    config->max_in_flight = MODULE_DISCOVERY_MAX_IN_FLIGHT;
+    snprintf(config->cache_path, sizeof(config->cache_path), "%s", MODULE_DISCOVERY_CACHE_PATH);
+}
+
+hal_status_t module_discovery_init(const module_discovery_config_t *config) {
+    pthread_once(&g_discovery_once, discovery_init_cond);
+
+    module_discovery_config_t cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        module_discovery_get_default_config(&cfg);
+    }
+    if (!discovery_addr_valid(cfg.range_start) || !discovery_addr_valid(cfg.range_end) ||
+        cfg.range_start > cfg.range_end || cfg.min_timeout_ms == 0 ||
+        cfg.min_timeout_ms > cfg.max_timeout_ms || cfg.miss_limit == 0 ||
+        cfg.max_in_flight == 0 || cfg.max_in_flight > MODULE_DISCOVERY_MAX_IN_FLIGHT) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    if (g_discovery.initialized) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+    memset(&g_discovery, 0, sizeof(g_discovery));
+    g_discovery.config = cfg;
+    g_discovery.config.cache_path[sizeof(g_discovery.config.cache_path) - 1] = '\0';
+    g_discovery.initialized = true;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    HAL_LOGI(HAL_LOG_COMP_COMM, "[DISCOVERY] Initialized (range 0x%02X-0x%02X, timeout %u..%u ms, %u in flight)",
+             cfg.range_start, cfg.range_end, cfg.min_timeout_ms, cfg.max_timeout_ms, cfg.max_in_flight);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t module_discovery_deinit(void) {
+    pthread_mutex_lock(&g_discovery_mutex);
+    if (!g_discovery.initialized) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_OK;
+    }
+    g_discovery.interrupt_requested = true;
+    // Probe slots are referenced by the bus thread until their callbacks run
+    uint64_t deadline = hal_time_now_ms() + MODBUS_BUS_SYNC_TIMEOUT_MS;
+    while (g_discovery.in_flight > 0 && hal_time_now_ms() < deadline) {
+        discovery_wait_locked(DISCOVERY_WAIT_SLICE_MS);
+    }
+    g_discovery.initialized = false;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+// Boot and blocking sweeps
+
+hal_status_t module_discovery_warm_start(uint32_t budget_ms, size_t *online_count) {
+    if (!discovery_ensure_init()) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    // Saved modules first, then any mandatory address the cache did not list
+    uint8_t targets[MODULE_REGISTRY_MAX_MODULES + MANDATORY_MODULES_COUNT];
+    size_t count = 0;
+    module_info_t saved[MODULE_REGISTRY_MAX_MODULES];
+    size_t saved_count = registry_list(saved, MODULE_REGISTRY_MAX_MODULES);
+    for (size_t i = 0; i < saved_count; i++) {
+        if (discovery_addr_valid(saved[i].address)) {
+            targets[count++] = saved[i].address;
+        }
+    }
+    for (unsigned addr = MANDATORY_MODULE_ADDR_START; addr < MANDATORY_MODULE_ADDR_START + MANDATORY_MODULES_COUNT; addr++) {
+        bool listed = false;
+        for (size_t i = 0; i < count; i++) {
+            listed = listed || targets[i] == addr;
+        }
+        if (!listed) {
+            targets[count++] = (uint8_t)addr;
+        }
+    }
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    g_discovery.interrupt_requested = false;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    uint64_t start = hal_time_now_ms();
+    registry_set_scanning(true);
+    (void)discovery_run(targets, count, budget_ms);
+    registry_set_scanning(false);
+    discovery_save_if_changed();
+
+    uint32_t elapsed = (uint32_t)(hal_time_now_ms() - start);
+    pthread_mutex_lock(&g_discovery_mutex);
+    g_discovery.stats.last_warm_start_ms = elapsed;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    size_t online = registry_count_mandatory_online();
+    if (online_count != NULL) {
+        *online_count = online;
+    }
+    HAL_LOGI(HAL_LOG_COMP_COMM, "[DISCOVERY] Warm start: %zu targets (%zu saved), %zu/%u mandatory online in %u ms",
+             count, saved_count, online, MANDATORY_MODULES_COUNT, elapsed);
+    return online == MANDATORY_MODULES_COUNT ? HAL_STATUS_OK : HAL_STATUS_TIMEOUT;
+}
+
+hal_status_t module_discovery_scan_range(uint8_t start_addr, uint8_t end_addr) {
+    if (!discovery_addr_valid(start_addr) || !discovery_addr_valid(end_addr) || start_addr > end_addr) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!discovery_ensure_init()) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    uint8_t targets[DISCOVERY_ADDR_MAX + 1U];
+    size_t count = 0;
+    for (unsigned addr = start_addr; addr <= end_addr; addr++) {
+        targets[count++] = (uint8_t)addr;
+    }
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    g_discovery.interrupt_requested = false;
+    g_discovery.scanning = true;
+    uint32_t budget_ms = (uint32_t)count * g_discovery.config.miss_limit * g_discovery.config.max_timeout_ms + 1000U;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    registry_set_scanning(true);
+    HAL_LOGI(HAL_LOG_COMP_COMM, "[SCAN] Starting scan range 0x%02X-0x%02X", start_addr, end_addr);
+    uint64_t start = hal_time_now_ms();
+    hal_status_t status = discovery_run(targets, count, budget_ms);
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    g_discovery.scanning = false;
+    g_discovery.paused = false;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    registry_set_scanning(false);
+
+    HAL_LOGI(HAL_LOG_COMP_COMM, "[SCAN] Scan complete in %llu ms: %zu online",
+             (unsigned long long)(hal_time_now_ms() - start), registry_count_online());
+    discovery_save_if_changed();
+    return status == HAL_STATUS_BUSY ? HAL_STATUS_OK : status;
+}
+
+// Background rescan
+
+hal_status_t module_discovery_step(void) {
+    pthread_mutex_lock(&g_discovery_mutex);
+    bool initialized = g_discovery.initialized;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    if (!initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    (void)discovery_apply_results();
+
+    uint64_t now = hal_time_now_ms();
+    bool pass_done = false;
+    uint8_t next = 0;
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    // One background probe outstanding at a time; a blocking sweep owns the engine while it runs
+    if (g_discovery.paused || g_discovery.scanning || g_discovery.in_flight > 0 ||
+        now < g_discovery.next_probe_ms) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_OK;
+    }
+    if (g_discovery.pass_pos >= g_discovery.pass_len) {
+        pass_done = g_discovery.pass_len > 0;
+        if (pass_done) {
+            g_discovery.stats.sweeps_completed++;
+        }
+        discovery_build_pass_locked();
+    }
+    next = g_discovery.pass[g_discovery.pass_pos++];
+    g_discovery.stats.cursor = next;
+    g_discovery.next_probe_ms = now + g_discovery.config.rescan_interval_ms;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    if (pass_done) {
+        discovery_save_if_changed();
+    }
+    // A full queue just skips this address until the next pass
+    (void)discovery_submit(next);
+    return HAL_STATUS_OK;
+}
+
+// Estimator
+
+hal_status_t module_discovery_observe(uint8_t address, hal_status_t status, uint32_t rtt_us) {
+    if (!discovery_addr_valid(address)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_discovery_mutex);
+    if (!g_discovery.initialized) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    discovery_observe_locked(address, status, rtt_us);
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+uint32_t module_discovery_get_timeout_ms(uint8_t address) {
+    if (!discovery_addr_valid(address)) {
+        return 0;
+    }
+    pthread_mutex_lock(&g_discovery_mutex);
+    uint32_t timeout_ms = g_discovery.initialized ? discovery_timeout_locked(address) : 0;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return timeout_ms;
+}
+
+hal_status_t module_discovery_get_addr_info(uint8_t address, module_discovery_addr_info_t *info) {
+    if (info == NULL || !discovery_addr_valid(address)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_discovery_mutex);
+    if (!g_discovery.initialized) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    const discovery_addr_t *a = &g_discovery.addrs[address];
+    memset(info, 0, sizeof(*info));
+    info->address = address;
+    info->online = a->online;
+    info->has_rtt = a->has_rtt;
+    info->misses = a->misses;
+    info->backoff = a->backoff;
+    info->srtt_us = a->srtt_us;
+    info->rttvar_us = a->rttvar_us;
+    info->timeout_ms = discovery_timeout_locked(address);
+    info->device_id = a->identity[0];
+    info->module_type = a->identity[MODULE_DISCOVERY_ID_TYPE_INDEX];
+    info->fw_version = a->identity[MODULE_DISCOVERY_ID_FW_INDEX];
+    info->probes = a->probes;
+    info->responses = a->responses;
+    info->timeouts = a->timeouts;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t module_discovery_get_stats(module_discovery_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_discovery_mutex);
+    *stats = g_discovery.stats;
+    stats->in_flight = g_discovery.in_flight;
+    stats->bus_srtt_us = g_discovery.bus_srtt_us;
+    stats->scanning = g_discovery.scanning;
+    stats->paused = g_discovery.paused;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+// Scan control
+
+hal_status_t module_discovery_stop(void) {
+    pthread_once(&g_discovery_once, discovery_init_cond);
+    pthread_mutex_lock(&g_discovery_mutex);
+    g_discovery.interrupt_requested = true;
+    pthread_cond_broadcast(&g_discovery_cond);
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t module_discovery_pause(void) {
+    pthread_mutex_lock(&g_discovery_mutex);
+    if (!g_discovery.initialized) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_INVALID_STATE;
+    }
+    g_discovery.paused = true;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t module_discovery_resume(void) {
+    pthread_once(&g_discovery_once, discovery_init_cond);
+    pthread_mutex_lock(&g_discovery_mutex);
+    g_discovery.paused = false;
+    pthread_cond_broadcast(&g_discovery_cond);
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return HAL_STATUS_OK;
+}
+
+bool module_discovery_is_scanning(void) {
+    pthread_mutex_lock(&g_discovery_mutex);
+    bool scanning = g_discovery.scanning;
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return scanning;
+}
+
+// Internals
+
+static void discovery_init_cond(void) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_discovery_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static void discovery_wait_locked(uint32_t timeout_ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += (time_t)(timeout_ms / 1000U);
+    ts.tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    (void)pthread_cond_timedwait(&g_discovery_cond, &g_discovery_mutex, &ts);
+}
+
+static bool discovery_ensure_init(void) {
+    hal_status_t status = module_discovery_init(NULL);
+    return status == HAL_STATUS_OK || status == HAL_STATUS_ALREADY_INITIALIZED;
+}
+
+/**
+ * @brief Probe timeout: srtt + 4 * rttvar (own samples, else the bus's), clamped, then backed off
+ */
+static uint32_t discovery_timeout_locked(uint8_t address) {
+    const module_discovery_config_t *cfg = &g_discovery.config;
+    const discovery_addr_t *a = &g_discovery.addrs[address];
+    uint64_t rto_us;
+
+    if (a->has_rtt) {
+        rto_us = (uint64_t)a->srtt_us + 4ULL * a->rttvar_us;
+    } else if (g_discovery.bus_has_rtt) {
+        rto_us = (uint64_t)g_discovery.bus_srtt_us + 4ULL * g_discovery.bus_rttvar_us;
+    } else {
+        rto_us = (uint64_t)cfg->initial_timeout_ms * 1000ULL;
+    }
+
+    uint64_t timeout_ms = (rto_us + 999ULL) / 1000ULL;
+    if (timeout_ms < cfg->min_timeout_ms) {
+        timeout_ms = cfg->min_timeout_ms;
+    }
+    timeout_ms <<= a->backoff;
+    if (timeout_ms > cfg->max_timeout_ms) {
+        timeout_ms = cfg->max_timeout_ms;
+    }
+    return (uint32_t)timeout_ms;
+}
+
+/**
+ * @brief Jacobson/Karels smoothing (RFC 6298 gains 1/8 and 1/4)
+ */
+static void discovery_rtt_sample(bool *has_rtt, uint32_t *srtt_us, uint32_t *rttvar_us, uint32_t rtt_us) {
+    if (!*has_rtt) {
+        *srtt_us = rtt_us;
+        *rttvar_us = rtt_us / 2U;
+        *has_rtt = true;
+        return;
+    }
+    uint32_t delta = *srtt_us > rtt_us ? *srtt_us - rtt_us : rtt_us - *srtt_us;
+    *rttvar_us = (uint32_t)(((uint64_t)*rttvar_us * 3U + delta) / 4U);
+    *srtt_us = (uint32_t)(((uint64_t)*srtt_us * 7U + rtt_us) / 8U);
+}
+
+static void discovery_observe_locked(uint8_t address, hal_status_t status, uint32_t rtt_us) {
+    discovery_addr_t *a = &g_discovery.addrs[address];
+
+    a->probes++;
+    g_discovery.stats.probes++;
+    if (discovery_answered(status)) {
+        a->responses++;
+        g_discovery.stats.responses++;
+        discovery_rtt_sample(&a->has_rtt, &a->srtt_us, &a->rttvar_us, rtt_us);
+        discovery_rtt_sample(&g_discovery.bus_has_rtt, &g_discovery.bus_srtt_us, &g_discovery.bus_rttvar_us, rtt_us);
+        a->misses = 0;
+        a->backoff = 0;
+        a->online = true;
+        return;
+    }
+
+    if (status == HAL_STATUS_TIMEOUT) {
+        a->timeouts++;
+        g_discovery.stats.timeouts++;
+        // Only back off for a slave that has answered before; empty addresses stay cheap
+        if (a->has_rtt && a->backoff < DISCOVERY_MAX_BACKOFF) {
+            a->backoff++;
+        }
+    } else {
+        g_discovery.stats.errors++;
+    }
+    if (a->misses < UINT8_MAX) {
+        a->misses++;
+    }
+    if (a->misses >= g_discovery.config.miss_limit) {
+        a->online = false;
+    }
+}
+
+static hal_status_t discovery_probe_job(void *ctx) {
+    discovery_probe_t *probe = (discovery_probe_t *)ctx;
+    probe->rtt_us = 0;
+    return modbus_bus_probe_holding(MODBUS_BUS_PRIO_DISCOVERY, probe->address, MODULE_DISCOVERY_ID_REG_START,
+                                    MODULE_DISCOVERY_ID_REG_COUNT, probe->regs, probe->timeout_ms, &probe->rtt_us);
+}
+
+// Runs on the bus thread (or inline when it is not running)
+static void discovery_probe_done(hal_status_t status, void *ctx) {
+    discovery_probe_t *probe = (discovery_probe_t *)ctx;
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    discovery_addr_t *a = &g_discovery.addrs[probe->address];
+    a->in_flight = false;
+    a->result_ready = true;
+    a->result = status;
+    a->result_rtt_us = probe->rtt_us;
+    memcpy(a->result_regs, probe->regs, sizeof(a->result_regs));
+    probe->in_use = false;
+    g_discovery.in_flight--;
+    pthread_cond_broadcast(&g_discovery_cond);
+    pthread_mutex_unlock(&g_discovery_mutex);
+}
+
+/**
+ * @brief Queue one identity probe at DISCOVERY priority
+ * @return HAL_STATUS_OK if queued (or run inline), HAL_STATUS_BUSY if no slot was free
+ */
+static hal_status_t discovery_submit(uint8_t address) {
+    pthread_mutex_lock(&g_discovery_mutex);
+    discovery_addr_t *a = &g_discovery.addrs[address];
+    if (a->in_flight || a->result_ready || g_discovery.in_flight >= g_discovery.config.max_in_flight) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_BUSY;
+    }
+    discovery_probe_t *probe = NULL;
+    for (size_t i = 0; i < MODULE_DISCOVERY_MAX_IN_FLIGHT; i++) {
+        if (!g_discovery.probes[i].in_use) {
+            probe = &g_discovery.probes[i];
+            break;
+        }
+    }
+    if (probe == NULL) {
+        pthread_mutex_unlock(&g_discovery_mutex);
+        return HAL_STATUS_BUSY;
+    }
+    probe->in_use = true;
+    probe->address = address;
+    probe->timeout_ms = discovery_timeout_locked(address);
+    a->in_flight = true;
+    g_discovery.in_flight++;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    HAL_LOGD(HAL_LOG_COMP_COMM, "[DISCOVERY] Probe 0x%02X (timeout %u ms)", address, probe->timeout_ms);
+    hal_status_t status = modbus_bus_submit_job(MODBUS_BUS_PRIO_DISCOVERY, discovery_probe_job, probe,
+                                                discovery_probe_done, probe);
+    if (status == HAL_STATUS_OK) {
+        return HAL_STATUS_OK;
+    }
+
+    // Without a bus thread the job already ran and its callback released the slot
+    pthread_mutex_lock(&g_discovery_mutex);
+    bool queued = !probe->in_use;
+    if (!queued) {
+        probe->in_use = false;
+        a->in_flight = false;
+        g_discovery.in_flight--;
+        g_discovery.stats.errors++;
+    }
+    pthread_mutex_unlock(&g_discovery_mutex);
+    return queued ? HAL_STATUS_OK : HAL_STATUS_BUSY;
+}
+
+static module_type_t discovery_decode_type(uint8_t address, hal_status_t status, const uint16_t *regs) {
+    if (status == HAL_STATUS_OK) {
+        switch (regs[MODULE_DISCOVERY_ID_TYPE_INDEX]) {
+            case 0x0002: return MODULE_TYPE_POWER;
+            case 0x0003: return MODULE_TYPE_SAFETY;
+            case 0x0004: return MODULE_TYPE_TRAVEL_MOTOR;
+            case 0x0005: return MODULE_TYPE_DOCK;
+            default: break;
+        }
+    }
+    // Type register missing or unknown: fall back to the fixed address plan
+    switch (address) {
+        case 0x02: return MODULE_TYPE_POWER;
+        case 0x03: return MODULE_TYPE_SAFETY;
+        case 0x04: return MODULE_TYPE_TRAVEL_MOTOR;
+        case 0x05: return MODULE_TYPE_DOCK;
+        default: return MODULE_TYPE_UNKNOWN;
+    }
+}
+
+/**
+ * @brief Fold finished probes into the estimator and the registry
+ * @return Number of results applied
+ */
+static size_t discovery_apply_results(void) {
+    discovery_result_t results[MODULE_DISCOVERY_MAX_IN_FLIGHT * 2];
+    bool online_now[MODULE_DISCOVERY_MAX_IN_FLIGHT * 2];
+    size_t count = 0;
+
+    pthread_mutex_lock(&g_discovery_mutex);
+    for (unsigned addr = DISCOVERY_ADDR_MIN; addr <= DISCOVERY_ADDR_MAX && count < MODULE_DISCOVERY_MAX_IN_FLIGHT * 2U; addr++) {
+        discovery_addr_t *a = &g_discovery.addrs[addr];
+        if (!a->result_ready) {
+            continue;
+        }
+        a->result_ready = false;
+        discovery_observe_locked((uint8_t)addr, a->result, a->result_rtt_us);
+        if (a->result == HAL_STATUS_OK) {
+            memcpy(a->identity, a->result_regs, sizeof(a->identity));
+        }
+        results[count].address = (uint8_t)addr;
+        results[count].status = a->result;
+        memcpy(results[count].regs, a->result_regs, sizeof(results[count].regs));
+        online_now[count] = a->online;
+        count++;
+    }
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    // Registry is not thread-safe; it is only touched from the caller's thread
+    bool changed = false;
+    for (size_t i = 0; i < count; i++) {
+        const discovery_result_t *r = &results[i];
+        module_info_t mi;
+        bool registered_online = registry_get(r->address, &mi) == 0 && mi.status == MODULE_STATUS_ONLINE;
+
+        if (discovery_answered(r->status)) {
+            if (!registered_online) {
+                char version[16] = "";
+                uint16_t fw = r->status == HAL_STATUS_OK ? r->regs[MODULE_DISCOVERY_ID_FW_INDEX] : 0;
+                if (fw != 0) {
+                    snprintf(version, sizeof(version), "v%u.%02u", (unsigned)(fw >> 8), (unsigned)(fw & 0xFFU));
+                }
+                module_type_t type = discovery_decode_type(r->address, r->status, r->regs);
+                registry_mark_online(r->address, type, version);
+                changed = true;
+                HAL_LOGI(HAL_LOG_COMP_COMM, "[DISCOVERY] 0x%02X ONLINE (device id 0x%04X, type %d, fw %s)",
+                         r->address, r->regs[0], (int)type, version[0] != '\0' ? version : "-");
+            }
+        } else if (!online_now[i] && registered_online) {
+            registry_mark_offline(r->address);
+            changed = true;
+            HAL_LOGW(HAL_LOG_COMP_COMM, "[DISCOVERY] 0x%02X OFFLINE (debounced)", r->address);
+        }
+    }
+
+    if (changed) {
+        pthread_mutex_lock(&g_discovery_mutex);
+        g_discovery.online_changed = true;
+        pthread_mutex_unlock(&g_discovery_mutex);
+    }
+    return count;
+}
+
+static void discovery_save_if_changed(void) {
+    pthread_mutex_lock(&g_discovery_mutex);
+    bool save = g_discovery.online_changed && g_discovery.config.cache_path[0] != '\0';
+    char path[sizeof(g_discovery.config.cache_path)];
+    memcpy(path, g_discovery.config.cache_path, sizeof(path));
+    g_discovery.online_changed = false;
+    pthread_mutex_unlock(&g_discovery_mutex);
+
+    if (save) {
+        (void)registry_save_yaml(path);
+    }
+}
+
+/**
+ * @brief Probe targets with up to miss_limit attempts each, keeping max_in_flight probes queued
+ * @return HAL_STATUS_OK when every target is resolved, HAL_STATUS_TIMEOUT if the budget ran out,
+ *         HAL_STATUS_BUSY if stopped
+ */
+static hal_status_t discovery_run(const uint8_t *targets, size_t count, uint32_t budget_ms) {
+    uint8_t attempts[DISCOVERY_ADDR_MAX + 1U];
+    uint64_t deadline = hal_time_now_ms() + budget_ms;
+    hal_status_t status = HAL_STATUS_TIMEOUT;
+
+    memset(attempts, 0, sizeof(attempts));
+    while (hal_time_now_ms() < deadline) {
+        (void)discovery_apply_results();
+
+        pthread_mutex_lock(&g_discovery_mutex);
+        uint8_t miss_limit = g_discovery.config.miss_limit;
+        bool stop = g_discovery.interrupt_requested;
+        bool paused = g_discovery.paused;
+        size_t pending = 0;
+        uint8_t to_submit[MODULE_DISCOVERY_MAX_IN_FLIGHT];
+        size_t submit_count = 0;
+        uint32_t free_slots = g_discovery.config.max_in_flight - g_discovery.in_flight;
+
+        for (size_t i = 0; i < count; i++) {
+            const discovery_addr_t *a = &g_discovery.addrs[targets[i]];
+            bool busy = a->in_flight || a->result_ready;
+            bool resolved = !busy && attempts[targets[i]] > 0 &&
+                            (a->online || attempts[targets[i]] >= miss_limit);
+            if (resolved) {
+                continue;
+            }
+            pending++;
+            if (!busy && !paused && submit_count < free_slots && submit_count < MODULE_DISCOVERY_MAX_IN_FLIGHT) {
+                to_submit[submit_count++] = targets[i];
+            }
+        }
+        pthread_mutex_unlock(&g_discovery_mutex);
+
+        if (stop) {
+            status = HAL_STATUS_BUSY;
+            break;
+        }
+        if (pending == 0) {
+            status = HAL_STATUS_OK;
+            break;
+        }
+        for (size_t i = 0; i < submit_count; i++) {
+            if (discovery_submit(to_submit[i]) == HAL_STATUS_OK) {
+                attempts[to_submit[i]]++;
+            }
+        }
+
+        pthread_mutex_lock(&g_discovery_mutex);
+        bool ready = false;
+        for (size_t i = 0; i < count && !ready; i++) {
+            ready = g_discovery.addrs[targets[i]].result_ready;
+        }
+        if (!ready) {
+            discovery_wait_locked(DISCOVERY_WAIT_SLICE_MS);
+        }
+        pthread_mutex_unlock(&g_discovery_mutex);
+    }
+
+    if (status == HAL_STATUS_TIMEOUT) {
+        (void)discovery_apply_results();
+    }
+    return status;
+}
+
+/**
+ * @brief Next background pass: the configured range plus registry entries outside it
+ */
+static void discovery_build_pass_locked(void) {
+    module_info_t known[MODULE_REGISTRY_MAX_MODULES];
+    size_t known_count = registry_list(known, MODULE_REGISTRY_MAX_MODULES);
+    size_t n = 0;
+
+    for (unsigned addr = g_discovery.config.range_start; addr <= g_discovery.config.range_end; addr++) {
+        g_discovery.pass[n++] = (uint8_t)addr;
+    }
+    for (size_t i = 0; i < known_count; i++) {
+        uint8_t addr = known[i].address;
+        if (discovery_addr_valid(addr) &&
+            (addr < g_discovery.config.range_start || addr > g_discovery.config.range_end)) {
+            g_discovery.pass[n++] = addr;
+        }
+    }
+    g_discovery.pass_len = n;
+    g_discovery.pass_pos = 0;
+}
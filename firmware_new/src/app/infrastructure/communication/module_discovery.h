@@ -0,0 +1,198 @@
+/**
+ * @file module_discovery.h
+ * @brief Pipelined RS485 module discovery with adaptive per-address timeouts
+ * @version 1.0.0
+ * @date 2025-02-18
+ * @author FW Team
+ *
+ * Probes are single-attempt identity reads (0x0100-0x0105 in one FC03)
+ * queued on the bus master at DISCOVERY priority, several at a time, so
+ * they run back to back between telemetry transactions instead of
+ * pausing polling. Each address keeps a smoothed RTT and variance; its
+ * probe timeout is srtt + 4 * rttvar, clamped, and doubles on each miss
+ * of a module that has answered before. Addresses that never answered use
+ * the bus-wide estimate, so an empty address costs a few milliseconds.
+ *
+ * Boot runs a warm start over the addresses saved in modules.yaml plus
+ * the mandatory modules; module_discovery_step() then walks the rest of
+ * the range one probe at a time from the main loop.
+ *
+ * Registry updates are applied on the thread that calls into this module
+ * (warm start, sweep or step), never on the bus thread.
+ */
+
+#ifndef MODULE_DISCOVERY_H
+#define MODULE_DISCOVERY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+
+// Identity block read by every probe
+#define MODULE_DISCOVERY_ID_REG_START       0x0100  // Device ID
+#define MODULE_DISCOVERY_ID_REG_COUNT       6       // ... through firmware version (0x0105)
+#define MODULE_DISCOVERY_ID_TYPE_INDEX      4       // Module type (0x0104)
+#define MODULE_DISCOVERY_ID_FW_INDEX        5       // Firmware version (0x0105)
+
+#define MODULE_DISCOVERY_MAX_IN_FLIGHT      4       // Probes queued on the bus master at once
+#define MODULE_DISCOVERY_CACHE_PATH         "/etc/oht50/modules.yaml"
+
+// Engine configuration
+typedef struct {
+    uint8_t range_start;                    // Background rescan range (inclusive)
+    uint8_t range_end;
+    uint32_t initial_timeout_ms;            // Before any RTT sample on the bus
+    uint32_t min_timeout_ms;
+    uint32_t max_timeout_ms;
+    uint32_t rescan_interval_ms;            // Gap between background probes
+    uint8_t miss_limit;                     // Consecutive misses before OFFLINE
+    uint8_t max_in_flight;                  // 1..MODULE_DISCOVERY_MAX_IN_FLIGHT
+    char cache_path[128];                   // Saved when the online set changes ("" = never)
+} module_discovery_config_t;
+
+// Per-address estimator state
+typedef struct {
+    uint8_t address;
+    bool online;
+    bool has_rtt;
+    uint8_t misses;                         // Consecutive
+    uint8_t backoff;                        // Timeout doublings since the last answer
+    uint32_t srtt_us;
+    uint32_t rttvar_us;
+    uint32_t timeout_ms;                    // Timeout the next probe will use
+    uint16_t device_id;                     // Identity from the last full answer (0x0100)
+    uint16_t module_type;                   // 0x0104
+    uint16_t fw_version;                    // 0x0105
+    uint32_t probes;
+    uint32_t responses;
+    uint32_t timeouts;
+} module_discovery_addr_info_t;
+
+// Engine statistics
+typedef struct {
+    uint64_t probes;
+    uint64_t responses;
+    uint64_t timeouts;
+    uint64_t errors;                        // Bad frames, busy queue
+    uint64_t sweeps_completed;              // Background passes over the range
+    uint32_t in_flight;
+    uint32_t bus_srtt_us;
+    uint32_t last_warm_start_ms;            // Duration of the last warm start
+    uint8_t cursor;                         // Next background address
+    bool scanning;                          // Blocking sweep running
+    bool paused;
+} module_discovery_stats_t;
+
+/**
+ * @brief Initialize the engine
+ * @param config Configuration, NULL for defaults (0x02-0x08, 50 ms initial timeout)
+ * @return HAL status
+ */
+hal_status_t module_discovery_init(const module_discovery_config_t *config);
+
+/**
+ * @brief Wait for in-flight probes and release the engine
+ * @return HAL status
+ */
+hal_status_t module_discovery_deinit(void);
+
+/**
+ * @brief Default configuration
+ * @param config Output
+ */
+void module_discovery_get_default_config(module_discovery_config_t *config);
+
+/**
+ * @brief Probe registry addresses (e.g. loaded from modules.yaml) and the mandatory modules
+ *
+ * All targets are probed in parallel; one that misses is re-probed until
+ * miss_limit or the budget runs out.
+ *
+ * @param budget_ms Upper bound on the call
+ * @param online_count Mandatory modules online afterwards (may be NULL)
+ * @return HAL_STATUS_OK if every mandatory module is online, HAL_STATUS_TIMEOUT otherwise
+ */
+hal_status_t module_discovery_warm_start(uint32_t budget_ms, size_t *online_count);
+
+/**
+ * @brief Blocking pipelined sweep of an address range
+ *
+ * Honors module_discovery_stop()/pause(). Saves the cache when done.
+ *
+ * @param start_addr First address
+ * @param end_addr Last address (inclusive)
+ * @return HAL status
+ */
+hal_status_t module_discovery_scan_range(uint8_t start_addr, uint8_t end_addr);
+
+/**
+ * @brief Background rescan tick; call from the main loop, never blocks
+ *
+ * Applies finished probes and queues the next one when rescan_interval_ms
+ * has elapsed. A pass covers the configured range plus any registry
+ * address outside it; online modules are re-probed too, so a module that
+ * disappears goes OFFLINE after miss_limit passes.
+ *
+ * @return HAL status
+ */
+hal_status_t module_discovery_step(void);
+
+/**
+ * @brief Feed one probe outcome into the estimator (also used by tests)
+ * @param address Slave address
+ * @param status Probe status
+ * @param rtt_us Round trip when the slave answered
+ * @return HAL status
+ */
+hal_status_t module_discovery_observe(uint8_t address, hal_status_t status, uint32_t rtt_us);
+
+/**
+ * @brief Timeout the next probe of an address will use
+ * @param address Slave address
+ * @return Timeout in ms
+ */
+uint32_t module_discovery_get_timeout_ms(uint8_t address);
+
+/**
+ * @brief Get estimator state of one address
+ * @param address Slave address
+ * @param info Output
+ * @return HAL status
+ */
+hal_status_t module_discovery_get_addr_info(uint8_t address, module_discovery_addr_info_t *info);
+
+/**
+ * @brief Get engine statistics
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t module_discovery_get_stats(module_discovery_stats_t *stats);
+
+// Scan control
+
+/**
+ * @brief Abort a blocking sweep at the next probe boundary
+ * @return HAL status
+ */
+hal_status_t module_discovery_stop(void);
+
+/**
+ * @brief Stop queueing probes (blocking sweeps and background rescan)
+ * @return HAL_STATUS_INVALID_STATE if the engine is not initialized
+ */
+hal_status_t module_discovery_pause(void);
+
+/**
+ * @brief Resume probing after module_discovery_pause()
+ * @return HAL status
+ */
+hal_status_t module_discovery_resume(void);
+
+/**
+ * @brief Check whether a blocking sweep is running
+ * @return true while module_discovery_scan_range() runs
+ */
+bool module_discovery_is_scanning(void);
+
+#endif // MODULE_DISCOVERY_H
@@ -0,0 +1,1116 @@
+/**
+ * @file http_event_server.c
+ * @brief Shared epoll HTTP/1.1 server core (keep-alive, pipelining, worker pool)
+ * @version 1.0.0
+ * @date 2025-02-10
+ * @team FW
+ */
+
+#include "http_event_server.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define HTTP_EVENT_LISTEN_BACKLOG   32
+#define HTTP_EVENT_MAX_EPOLL_EVENTS 32
+#define HTTP_EVENT_SWEEP_MS         1000
+#define HTTP_EVENT_TAG_LISTEN       UINT64_MAX
+#define HTTP_EVENT_TAG_WAKE         (UINT64_MAX - 1)
+#define HTTP_EVENT_HEAD_MAX         512
+#define HTTP_EVENT_CHUNK_HEAD_MAX   16      // "<hex>\r\n" in front of each stream chunk
+
+typedef enum {
+    CONN_FREE = 0,
+    CONN_READING,       // Waiting for (more of) the next request
+    CONN_DISPATCHED,    // Request with a worker, reads paused
+    CONN_WRITING,       // Response partly sent, waiting for EPOLLOUT
+    CONN_STREAMING      // Head sent, chunks pulled from the stream callback
+} conn_state_t;
+
+typedef struct {
+    int fd;
+    uint32_t generation;
+    conn_state_t state;
+    char in_buf[HTTP_EVENT_CONN_BUFFER_SIZE];
+    size_t in_len;
+    char *out_buf;
+    size_t out_len;
+    size_t out_off;
+    bool close_after_write;
+    bool peer_closed;
+    uint32_t requests_served;
+    uint64_t last_activity_ms;
+    char client_ip[16];
+    uint16_t client_port;
+    http_event_stream_read_t stream_read;
+    http_event_stream_close_t stream_close;
+    void *stream_ctx;
+    atomic_bool stream_ready;
+} http_conn_t;
+
+typedef struct http_job {
+    struct http_job *next;
+    uint32_t conn_index;
+    uint32_t generation;
+    uint64_t enqueue_us;
+    http_event_request_t request;
+    char *raw;
+    char *out;
+    size_t out_len;
+    bool close_after;
+    http_event_stream_read_t stream_read;
+    http_event_stream_close_t stream_close;
+    void *stream_ctx;
+} http_job_t;
+
+struct http_event_server {
+    http_event_server_config_t config;
+    char name[32];
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+    uint16_t bound_port;
+    uint32_t stream_count;      // Event thread only
+    volatile bool running;
+    pthread_t loop_thread;
+    pthread_t workers[HTTP_EVENT_MAX_WORKERS];
+    uint32_t worker_count;
+
+    http_conn_t conns[HTTP_EVENT_MAX_CONNECTIONS];
+
+    // Worker queue (pending) and results for the event thread (done)
+    pthread_mutex_t queue_mutex;
+    pthread_cond_t queue_cond;
+    http_job_t *pending_head;
+    http_job_t *pending_tail;
+    http_job_t *done_head;
+    uint32_t jobs_queued;
+    bool workers_stop;
+
+    pthread_mutex_t stats_mutex;
+    http_event_server_stats_t stats;
+    http_event_route_stats_t routes[HTTP_EVENT_MAX_ROUTES];
+    uint32_t route_count;
+};
+
+static const uint32_t latency_bounds_us[HTTP_EVENT_LATENCY_BUCKETS - 1] = HTTP_EVENT_LATENCY_BOUNDS_US;
+
+const char* http_event_status_text(int status_code) {
+    switch (status_code) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        default: return "Unknown";
+    }
+}
+
+static uint64_t conn_tag(uint32_t index, uint32_t generation) {
+    return ((uint64_t)generation << 32) | index;
+}
+
+static void stats_add(http_event_server_t *server, uint64_t *counter, uint64_t amount) {
+    pthread_mutex_lock(&server->stats_mutex);
+    *counter += amount;
+    pthread_mutex_unlock(&server->stats_mutex);
+}
+
+/**
+ * @brief Add one latency sample to the histogram for a route label
+ */
+static void record_route_latency(http_event_server_t *server, const char *label, uint64_t latency_us) {
+    pthread_mutex_lock(&server->stats_mutex);
+
+    http_event_route_stats_t *route = NULL;
+    for (uint32_t i = 0; i < server->route_count; i++) {
+        if (strcmp(server->routes[i].route, label) == 0) {
+            route = &server->routes[i];
+            break;
+        }
+    }
+    if (route == NULL) {
+        // Table full: fold the rest into the last slot
+        uint32_t slot = server->route_count < HTTP_EVENT_MAX_ROUTES ? server->route_count++ : HTTP_EVENT_MAX_ROUTES - 1;
+        route = &server->routes[slot];
+        if (route->count == 0) {
+            snprintf(route->route, sizeof(route->route), "%s",
+                     slot == HTTP_EVENT_MAX_ROUTES - 1 ? "other" : label);
+        }
+    }
+
+    uint32_t bucket = 0;
+    while (bucket < HTTP_EVENT_LATENCY_BUCKETS - 1 && latency_us > latency_bounds_us[bucket]) {
+        bucket++;
+    }
+    route->buckets[bucket]++;
+    route->count++;
+    route->total_us += latency_us;
+    if (latency_us > route->max_us) {
+        route->max_us = latency_us;
+    }
+
+    pthread_mutex_unlock(&server->stats_mutex);
+}
+
+/**
+ * @brief Build status line, headers and body into one malloc'd buffer
+ */
+static char* serialize_response(const http_event_response_t *response, bool close_connection, size_t *out_len) {
+    char head[HTTP_EVENT_HEAD_MAX + HTTP_EVENT_EXTRA_HEADERS_MAX];
+    const char *content_type = response->content_type[0] ? response->content_type : "application/json";
+    size_t body_length = response->body ? response->body_length : 0;
+    bool stream = response->stream_read != NULL;
+    char length_header[64];
+    int head_len;
+
+    // A stream has no length; its initial body goes out as the first chunk
+    if (stream) {
+        snprintf(length_header, sizeof(length_header), "Transfer-Encoding: chunked\r\nCache-Control: no-cache\r\n");
+    } else {
+        snprintf(length_header, sizeof(length_header), "Content-Length: %zu\r\n", body_length);
+    }
+    head_len = snprintf(head, sizeof(head),
+                        "HTTP/1.1 %d %s\r\n"
+                        "Content-Type: %s\r\n"
+                        "%s"
+                        "Connection: %s\r\n"
+                        "%s\r\n",
+                        response->status_code, http_event_status_text(response->status_code),
+                        content_type, length_header,
+                        close_connection ? "close" : "keep-alive",
+                        response->extra_headers);
+    if (head_len < 0 || (size_t)head_len >= sizeof(head)) {
+        return NULL;
+    }
+    if (stream && body_length > 0) {
+        int chunk_len = snprintf(head + head_len, sizeof(head) - (size_t)head_len, "%zx\r\n", body_length);
+        if (chunk_len < 0 || (size_t)(head_len + chunk_len) >= sizeof(head)) {
+            return NULL;
+        }
+        head_len += chunk_len;
+    }
+
+    size_t tail_len = stream && body_length > 0 ? 2 : 0;
+    char *out = malloc((size_t)head_len + body_length + tail_len);
+    if (out == NULL) {
+        return NULL;
+    }
+    memcpy(out, head, (size_t)head_len);
+    if (body_length > 0) {
+        memcpy(out + head_len, response->body, body_length);
+    }
+    if (tail_len > 0) {
+        memcpy(out + head_len + body_length, "\r\n", 2);
+    }
+    *out_len = (size_t)head_len + body_length + tail_len;
+    return out;
+}
+
+/**
+ * @brief Free a job, closing a stream that never reached its connection
+ */
+static void job_free(http_job_t *job) {
+    if (job->stream_close != NULL) {
+        job->stream_close(job->stream_ctx);
+    }
+    free(job->out);
+    free(job->raw);
+    free(job);
+}
+
+static void* worker_thread(void *arg) {
+    http_event_server_t *server = (http_event_server_t *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&server->queue_mutex);
+        while (server->pending_head == NULL && !server->workers_stop) {
+            pthread_cond_wait(&server->queue_cond, &server->queue_mutex);
+        }
+        if (server->workers_stop) {
+            pthread_mutex_unlock(&server->queue_mutex);
+            break;
+        }
+        http_job_t *job = server->pending_head;
+        server->pending_head = job->next;
+        if (server->pending_head == NULL) {
+            server->pending_tail = NULL;
+        }
+        server->jobs_queued--;
+        pthread_mutex_unlock(&server->queue_mutex);
+
+        http_event_response_t response;
+        memset(&response, 0, sizeof(response));
+        response.status_code = 500;
+        server->config.handler(&job->request, &response, server->config.user_data);
+
+        job->stream_read = response.stream_read;
+        job->stream_close = response.stream_close;
+        job->stream_ctx = response.stream_ctx;
+        job->close_after = response.close_connection || !job->request.keep_alive || job->stream_read != NULL;
+        job->out = serialize_response(&response, job->close_after, &job->out_len);
+        if (job->out == NULL) {
+            job->close_after = true;
+        }
+        if (!response.body_borrowed) {
+            free(response.body);
+        }
+
+        record_route_latency(server, response.route[0] ? response.route : "unmatched",
+                             hal_get_timestamp_us() - job->enqueue_us);
+
+        pthread_mutex_lock(&server->queue_mutex);
+        job->next = server->done_head;
+        server->done_head = job;
+        pthread_mutex_unlock(&server->queue_mutex);
+
+        uint64_t one = 1;
+        (void)!write(server->wake_fd, &one, sizeof(one));
+    }
+    return NULL;
+}
+
+static void conn_close(http_event_server_t *server, uint32_t index) {
+    http_conn_t *conn = &server->conns[index];
+    if (conn->state == CONN_FREE) {
+        return;
+    }
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    free(conn->out_buf);
+    conn->out_buf = NULL;
+    conn->fd = -1;
+    conn->state = CONN_FREE;
+    conn->generation++;     // Late worker results for this slot are dropped
+
+    bool was_stream = conn->stream_read != NULL;
+    if (conn->stream_close != NULL) {
+        conn->stream_close(conn->stream_ctx);
+    }
+    conn->stream_read = NULL;
+    conn->stream_close = NULL;
+    conn->stream_ctx = NULL;
+    if (was_stream) {
+        server->stream_count--;
+    }
+
+    pthread_mutex_lock(&server->stats_mutex);
+    server->stats.connections_active--;
+    if (was_stream) {
+        server->stats.streams_active--;
+    }
+    pthread_mutex_unlock(&server->stats_mutex);
+}
+
+static void conn_set_events(http_event_server_t *server, uint32_t index, uint32_t events) {
+    http_conn_t *conn = &server->conns[index];
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.u64 = conn_tag(index, conn->generation);
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, conn->fd, &ev);
+}
+
+static void conn_try_dispatch(http_event_server_t *server, uint32_t index);
+
+/**
+ * @brief Send as much of the pending response as the socket takes
+ */
+static void conn_flush(http_event_server_t *server, uint32_t index) {
+    http_conn_t *conn = &server->conns[index];
+
+    while (conn->out_off < conn->out_len) {
+        ssize_t sent = send(conn->fd, conn->out_buf + conn->out_off, conn->out_len - conn->out_off, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (conn->state != CONN_WRITING) {
+                    conn->state = CONN_WRITING;
+                    conn_set_events(server, index, EPOLLOUT);
+                }
+                return;
+            }
+            conn_close(server, index);
+            return;
+        }
+        conn->out_off += (size_t)sent;
+        conn->last_activity_ms = hal_get_timestamp_ms();
+    }
+
+    free(conn->out_buf);
+    conn->out_buf = NULL;
+    conn->out_len = 0;
+    conn->out_off = 0;
+    conn->last_activity_ms = hal_get_timestamp_ms();
+
+    // Streams stay open after their head; the caller pulls the next chunk
+    if (conn->stream_read != NULL && !conn->peer_closed) {
+        if (conn->state != CONN_STREAMING) {
+            conn->state = CONN_STREAMING;
+            conn_set_events(server, index, EPOLLRDHUP);
+        }
+        return;
+    }
+    if (conn->close_after_write) {
+        conn_close(server, index);
+        return;
+    }
+    // A half-closed peer may still have pipelined requests buffered
+    conn->state = CONN_READING;
+    conn_set_events(server, index, conn->peer_closed ? 0 : (EPOLLIN | EPOLLRDHUP));
+    conn_try_dispatch(server, index);
+}
+
+/**
+ * @brief Answer from the event thread itself (framing errors) and close afterwards
+ */
+static void conn_send_error(http_event_server_t *server, uint32_t index, int status_code) {
+    http_conn_t *conn = &server->conns[index];
+    http_event_response_t response;
+    char body[96];
+
+    memset(&response, 0, sizeof(response));
+    response.status_code = status_code;
+    int len = snprintf(body, sizeof(body), "{\"success\":false,\"message\":\"%s\"}",
+                       http_event_status_text(status_code));
+    response.body = body;
+    response.body_length = (size_t)len;
+
+    stats_add(server, &server->stats.parse_errors, 1);
+    conn->in_len = 0;
+    conn->close_after_write = true;
+    conn->out_buf = serialize_response(&response, true, &conn->out_len);
+    conn->out_off = 0;
+    if (conn->out_buf == NULL) {
+        conn_close(server, index);
+        return;
+    }
+    conn_flush(server, index);
+}
+
+/**
+ * @brief Pull chunks from a stream until it has nothing more or the socket is full
+ */
+static void stream_pump(http_event_server_t *server, uint32_t index) {
+    http_conn_t *conn = &server->conns[index];
+
+    while (conn->state == CONN_STREAMING) {
+        atomic_store(&conn->stream_ready, false);
+
+        char *chunk = malloc(HTTP_EVENT_CHUNK_HEAD_MAX + HTTP_EVENT_STREAM_CHUNK_MAX + 2);
+        if (chunk == NULL) {
+            return;
+        }
+        size_t payload = conn->stream_read(conn->stream_ctx, chunk + HTTP_EVENT_CHUNK_HEAD_MAX,
+                                           HTTP_EVENT_STREAM_CHUNK_MAX);
+        if (payload == 0) {
+            free(chunk);
+            return;
+        }
+        if (payload > HTTP_EVENT_STREAM_CHUNK_MAX) {
+            payload = HTTP_EVENT_STREAM_CHUNK_MAX;
+        }
+
+        // Write the size line right in front of the payload
+        char size_line[HTTP_EVENT_CHUNK_HEAD_MAX];
+        int size_len = snprintf(size_line, sizeof(size_line), "%zx\r\n", payload);
+        size_t start = HTTP_EVENT_CHUNK_HEAD_MAX - (size_t)size_len;
+        memcpy(chunk + start, size_line, (size_t)size_len);
+        memcpy(chunk + HTTP_EVENT_CHUNK_HEAD_MAX + payload, "\r\n", 2);
+
+        conn->out_buf = chunk;
+        conn->out_off = start;
+        conn->out_len = HTTP_EVENT_CHUNK_HEAD_MAX + payload + 2;
+        stats_add(server, &server->stats.stream_chunks, 1);
+        conn_flush(server, index);
+    }
+}
+
+/**
+ * @brief Case-insensitive header lookup inside a request head
+ * @return Pointer to the value (leading blanks skipped) or NULL
+ */
+static const char* find_header(const char *head, size_t head_len, const char *name, size_t *value_len) {
+    size_t name_len = strlen(name);
+    const char *end = head + head_len;
+    const char *line = memchr(head, '\n', head_len);
+
+    while (line != NULL && ++line < end) {
+        const char *eol = memchr(line, '\n', (size_t)(end - line));
+        if (eol == NULL) {
+            eol = end;
+        }
+        if ((size_t)(eol - line) > name_len && line[name_len] == ':' &&
+            strncasecmp(line, name, name_len) == 0) {
+            const char *value = line + name_len + 1;
+            while (value < eol && (*value == ' ' || *value == '\t')) {
+                value++;
+            }
+            const char *value_end = eol;
+            while (value_end > value && (value_end[-1] == '\r' || value_end[-1] == ' ')) {
+                value_end--;
+            }
+            *value_len = (size_t)(value_end - value);
+            return value;
+        }
+        line = eol;
+    }
+    return NULL;
+}
+
+static bool header_has_token(const char *value, size_t value_len, const char *token) {
+    size_t token_len = strlen(token);
+    for (size_t i = 0; i + token_len <= value_len; i++) {
+        if (strncasecmp(value + i, token, token_len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Frame the next buffered request and queue it for a worker
+ *
+ * Does nothing until the head and the full Content-Length body are
+ * buffered; anything after the request stays buffered for the next call.
+ */
+static void conn_try_dispatch(http_event_server_t *server, uint32_t index) {
+    http_conn_t *conn = &server->conns[index];
+
+    if (conn->state != CONN_READING || conn->in_len == 0) {
+        if (conn->state == CONN_READING && conn->peer_closed) {
+            conn_close(server, index);
+        }
+        return;
+    }
+
+    const char *head_end = memmem(conn->in_buf, conn->in_len, "\r\n\r\n", 4);
+    if (head_end == NULL) {
+        if (conn->in_len >= sizeof(conn->in_buf)) {
+            conn_send_error(server, index, 431);
+        } else if (conn->peer_closed) {
+            conn_close(server, index);
+        }
+        return;
+    }
+    size_t head_len = (size_t)(head_end - conn->in_buf) + 4;
+
+    size_t value_len = 0;
+    const char *value = find_header(conn->in_buf, head_len, "Transfer-Encoding", &value_len);
+    if (value != NULL) {
+        conn_send_error(server, index, 501);    // No chunked request bodies
+        return;
+    }
+
+    size_t body_len = 0;
+    value = find_header(conn->in_buf, head_len, "Content-Length", &value_len);
+    if (value != NULL) {
+        char number[24];
+        char *number_end = NULL;
+        if (value_len == 0 || value_len >= sizeof(number)) {
+            conn_send_error(server, index, 400);
+            return;
+        }
+        memcpy(number, value, value_len);
+        number[value_len] = '\0';
+        unsigned long long parsed = strtoull(number, &number_end, 10);
+        if (*number_end != '\0') {
+            conn_send_error(server, index, 400);
+            return;
+        }
+        if (parsed > sizeof(conn->in_buf) - head_len) {
+            conn_send_error(server, index, 413);
+            return;
+        }
+        body_len = (size_t)parsed;
+    }
+
+    size_t total = head_len + body_len;
+    if (conn->in_len < total) {
+        if (conn->peer_closed) {
+            conn_close(server, index);
+        }
+        return;
+    }
+
+    http_job_t *job = calloc(1, sizeof(http_job_t));
+    char *raw = job ? malloc(total + 1) : NULL;
+    if (raw == NULL) {
+        free(job);
+        conn_send_error(server, index, 503);
+        return;
+    }
+    memcpy(raw, conn->in_buf, total);
+    raw[total] = '\0';
+
+    http_event_request_t *request = &job->request;
+    if (sscanf(raw, "%15s %255s %15s", request->method, request->target, request->version) != 3 ||
+        strncmp(request->version, "HTTP/1.", 7) != 0) {
+        free(raw);
+        free(job);
+        conn_send_error(server, index, 400);
+        return;
+    }
+
+    // HTTP/1.1 defaults to keep-alive, HTTP/1.0 must ask for it
+    bool http10 = strcmp(request->version, "HTTP/1.0") == 0;
+    value = find_header(raw, head_len, "Connection", &value_len);
+    if (value != NULL && header_has_token(value, value_len, "close")) {
+        request->keep_alive = false;
+    } else if (value != NULL && header_has_token(value, value_len, "keep-alive")) {
+        request->keep_alive = true;
+    } else {
+        request->keep_alive = !http10;
+    }
+    if (!server->config.keep_alive ||
+        conn->requests_served + 1 >= server->config.max_requests_per_connection) {
+        request->keep_alive = false;
+    }
+
+    request->raw = raw;
+    request->raw_length = total;
+    request->body = body_len > 0 ? raw + head_len : NULL;
+    request->body_length = body_len;
+    memcpy(request->client_ip, conn->client_ip, sizeof(request->client_ip));
+    request->client_port = conn->client_port;
+    request->connection_id = conn_tag(index, conn->generation);
+
+    job->raw = raw;
+    job->conn_index = index;
+    job->generation = conn->generation;
+    job->enqueue_us = hal_get_timestamp_us();
+
+    // Keep whatever follows (pipelined requests) at the front of the buffer
+    conn->in_len -= total;
+    if (conn->in_len > 0) {
+        memmove(conn->in_buf, conn->in_buf + total, conn->in_len);
+    }
+
+    pthread_mutex_lock(&server->stats_mutex);
+    server->stats.requests++;
+    if (conn->requests_served > 0) {
+        server->stats.keepalive_reuses++;
+    }
+    if (conn->in_len > 0) {
+        server->stats.pipelined_requests++;
+    }
+    pthread_mutex_unlock(&server->stats_mutex);
+
+    conn->state = CONN_DISPATCHED;
+    conn->requests_served++;
+    conn_set_events(server, index, EPOLLRDHUP);
+
+    pthread_mutex_lock(&server->queue_mutex);
+    if (server->pending_tail != NULL) {
+        server->pending_tail->next = job;
+    } else {
+        server->pending_head = job;
+    }
+    server->pending_tail = job;
+    server->jobs_queued++;
+    pthread_cond_signal(&server->queue_cond);
+    pthread_mutex_unlock(&server->queue_mutex);
+}
+
+static void conn_read(http_event_server_t *server, uint32_t index) {
+    http_conn_t *conn = &server->conns[index];
+
+    while (conn->in_len < sizeof(conn->in_buf)) {
+        ssize_t received = recv(conn->fd, conn->in_buf + conn->in_len, sizeof(conn->in_buf) - conn->in_len, 0);
+        if (received > 0) {
+            conn->in_len += (size_t)received;
+            continue;
+        }
+        if (received == 0) {
+            conn->peer_closed = true;
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            conn_close(server, index);
+            return;
+        }
+        break;
+    }
+
+    conn->last_activity_ms = hal_get_timestamp_ms();
+    conn_try_dispatch(server, index);
+}
+
+static void accept_connections(http_event_server_t *server) {
+    for (;;) {
+        struct sockaddr_in addr;
+        socklen_t addr_len = sizeof(addr);
+        int fd = accept4(server->listen_fd, (struct sockaddr *)&addr, &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;     // EAGAIN or a transient accept error
+        }
+
+        uint32_t index = HTTP_EVENT_MAX_CONNECTIONS;
+        for (uint32_t i = 0; i < server->config.max_connections; i++) {
+            if (server->conns[i].state == CONN_FREE) {
+                index = i;
+                break;
+            }
+        }
+        if (index == HTTP_EVENT_MAX_CONNECTIONS) {
+            close(fd);
+            stats_add(server, &server->stats.connections_rejected, 1);
+            continue;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        http_conn_t *conn = &server->conns[index];
+        conn->fd = fd;
+        conn->state = CONN_READING;
+        conn->in_len = 0;
+        conn->out_buf = NULL;
+        conn->out_len = 0;
+        conn->out_off = 0;
+        conn->close_after_write = false;
+        conn->peer_closed = false;
+        conn->requests_served = 0;
+        conn->stream_read = NULL;
+        conn->stream_close = NULL;
+        conn->stream_ctx = NULL;
+        atomic_store(&conn->stream_ready, false);
+        conn->last_activity_ms = hal_get_timestamp_ms();
+        inet_ntop(AF_INET, &addr.sin_addr, conn->client_ip, sizeof(conn->client_ip));
+        conn->client_port = ntohs(addr.sin_port);
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u64 = conn_tag(index, conn->generation);
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            conn->fd = -1;
+            conn->state = CONN_FREE;
+            continue;
+        }
+
+        pthread_mutex_lock(&server->stats_mutex);
+        server->stats.connections_accepted++;
+        server->stats.connections_active++;
+        pthread_mutex_unlock(&server->stats_mutex);
+    }
+}
+
+/**
+ * @brief Pick up finished jobs and start writing their responses
+ */
+static void collect_results(http_event_server_t *server) {
+    uint64_t counter;
+    (void)!read(server->wake_fd, &counter, sizeof(counter));
+
+    pthread_mutex_lock(&server->queue_mutex);
+    http_job_t *job = server->done_head;
+    server->done_head = NULL;
+    pthread_mutex_unlock(&server->queue_mutex);
+
+    while (job != NULL) {
+        http_job_t *next = job->next;
+        http_conn_t *conn = &server->conns[job->conn_index];
+
+        if (conn->state == CONN_DISPATCHED && conn->generation == job->generation) {
+            // The connection owns the stream from here on, even if it closes right away
+            if (job->stream_read != NULL) {
+                conn->stream_read = job->stream_read;
+                conn->stream_close = job->stream_close;
+                conn->stream_ctx = job->stream_ctx;
+                job->stream_close = NULL;
+                server->stream_count++;
+                pthread_mutex_lock(&server->stats_mutex);
+                server->stats.streams_active++;
+                pthread_mutex_unlock(&server->stats_mutex);
+            }
+            if (job->out == NULL) {
+                conn_close(server, job->conn_index);
+            } else {
+                conn->out_buf = job->out;
+                conn->out_len = job->out_len;
+                conn->out_off = 0;
+                conn->close_after_write = job->close_after;
+                job->out = NULL;
+                conn_flush(server, job->conn_index);
+                stream_pump(server, job->conn_index);
+            }
+        }
+
+        job_free(job);
+        job = next;
+    }
+}
+
+static void sweep_idle(http_event_server_t *server) {
+    uint64_t now_ms = hal_get_timestamp_ms();
+
+    for (uint32_t i = 0; i < server->config.max_connections; i++) {
+        http_conn_t *conn = &server->conns[i];
+        // A dispatched request is never timed out; the handler owns that time
+        if ((conn->state == CONN_READING || conn->state == CONN_WRITING) &&
+            now_ms - conn->last_activity_ms > server->config.idle_timeout_ms) {
+            conn_close(server, i);
+            stats_add(server, &server->stats.idle_timeouts, 1);
+        }
+    }
+}
+
+static void* event_loop_thread(void *arg) {
+    http_event_server_t *server = (http_event_server_t *)arg;
+    struct epoll_event events[HTTP_EVENT_MAX_EPOLL_EVENTS];
+    uint64_t last_sweep_ms = hal_get_timestamp_ms();
+    uint64_t last_tick_ms = last_sweep_ms;
+
+    while (server->running) {
+        // Open streams are also polled on a short tick for rate-limited or heartbeat output
+        int timeout_ms = server->stream_count > 0 ? HTTP_EVENT_STREAM_TICK_MS : HTTP_EVENT_SWEEP_MS;
+        int count = epoll_wait(server->epoll_fd, events, HTTP_EVENT_MAX_EPOLL_EVENTS, timeout_ms);
+        if (count < 0 && errno != EINTR) {
+            printf("[%s] epoll_wait failed: %s\n", server->name, strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            uint64_t tag = events[i].data.u64;
+            if (tag == HTTP_EVENT_TAG_LISTEN) {
+                accept_connections(server);
+                continue;
+            }
+            if (tag == HTTP_EVENT_TAG_WAKE) {
+                collect_results(server);
+                continue;
+            }
+
+            uint32_t index = (uint32_t)(tag & 0xFFFFFFFFu);
+            uint32_t generation = (uint32_t)(tag >> 32);
+            if (index >= HTTP_EVENT_MAX_CONNECTIONS) {
+                continue;
+            }
+            http_conn_t *conn = &server->conns[index];
+            if (conn->state == CONN_FREE || conn->generation != generation) {
+                continue;
+            }
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                conn_close(server, index);
+                continue;
+            }
+            if (conn->state == CONN_DISPATCHED) {
+                // Peer half-closed while its request runs; answer, then close
+                if (events[i].events & EPOLLRDHUP) {
+                    conn->peer_closed = true;
+                    conn_set_events(server, index, 0);
+                }
+                continue;
+            }
+            if (conn->state == CONN_STREAMING) {
+                if (events[i].events & EPOLLRDHUP) {
+                    conn_close(server, index);
+                }
+                continue;
+            }
+            if (conn->state == CONN_WRITING && (events[i].events & EPOLLOUT)) {
+                conn_flush(server, index);
+                stream_pump(server, index);
+                continue;
+            }
+            if (conn->state == CONN_READING && (events[i].events & (EPOLLIN | EPOLLRDHUP))) {
+                conn_read(server, index);
+            }
+        }
+
+        uint64_t now_ms = hal_get_timestamp_ms();
+        if (server->stream_count > 0) {
+            bool tick = now_ms - last_tick_ms >= HTTP_EVENT_STREAM_TICK_MS;
+            for (uint32_t i = 0; i < server->config.max_connections; i++) {
+                if (server->conns[i].state == CONN_STREAMING &&
+                    (tick || atomic_load(&server->conns[i].stream_ready))) {
+                    stream_pump(server, i);
+                }
+            }
+            if (tick) {
+                last_tick_ms = now_ms;
+            }
+        }
+        if (now_ms - last_sweep_ms >= HTTP_EVENT_SWEEP_MS) {
+            sweep_idle(server);
+            last_sweep_ms = now_ms;
+        }
+    }
+    return NULL;
+}
+
+hal_status_t http_event_server_create(const http_event_server_config_t *config, http_event_server_t **server) {
+    if (config == NULL || server == NULL || config->handler == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    http_event_server_t *srv = calloc(1, sizeof(http_event_server_t));
+    if (srv == NULL) {
+        return HAL_STATUS_NO_MEMORY;
+    }
+
+    srv->config = *config;
+    if (srv->config.worker_count == 0) {
+        srv->config.worker_count = HTTP_EVENT_DEFAULT_WORKERS;
+    }
+    if (srv->config.worker_count > HTTP_EVENT_MAX_WORKERS) {
+        srv->config.worker_count = HTTP_EVENT_MAX_WORKERS;
+    }
+    if (srv->config.max_connections == 0 || srv->config.max_connections > HTTP_EVENT_MAX_CONNECTIONS) {
+        srv->config.max_connections = HTTP_EVENT_MAX_CONNECTIONS;
+    }
+    if (srv->config.idle_timeout_ms == 0) {
+        srv->config.idle_timeout_ms = HTTP_EVENT_DEFAULT_IDLE_MS;
+    }
+    if (srv->config.max_requests_per_connection == 0) {
+        srv->config.max_requests_per_connection = HTTP_EVENT_DEFAULT_MAX_REQUESTS;
+    }
+    snprintf(srv->name, sizeof(srv->name), "%s", config->name ? config->name : "HTTP");
+
+    srv->listen_fd = -1;
+    srv->epoll_fd = -1;
+    srv->wake_fd = -1;
+    for (uint32_t i = 0; i < HTTP_EVENT_MAX_CONNECTIONS; i++) {
+        srv->conns[i].fd = -1;
+    }
+    pthread_mutex_init(&srv->queue_mutex, NULL);
+    pthread_cond_init(&srv->queue_cond, NULL);
+    pthread_mutex_init(&srv->stats_mutex, NULL);
+
+    *server = srv;
+    return HAL_STATUS_OK;
+}
+
+static void close_fds(http_event_server_t *server) {
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+        server->listen_fd = -1;
+    }
+    if (server->epoll_fd >= 0) {
+        close(server->epoll_fd);
+        server->epoll_fd = -1;
+    }
+    if (server->wake_fd >= 0) {
+        close(server->wake_fd);
+        server->wake_fd = -1;
+    }
+}
+
+static void stop_workers(http_event_server_t *server) {
+    pthread_mutex_lock(&server->queue_mutex);
+    server->workers_stop = true;
+    pthread_cond_broadcast(&server->queue_cond);
+    pthread_mutex_unlock(&server->queue_mutex);
+
+    for (uint32_t i = 0; i < server->worker_count; i++) {
+        pthread_join(server->workers[i], NULL);
+    }
+    server->worker_count = 0;
+}
+
+hal_status_t http_event_server_start(http_event_server_t *server) {
+    if (server == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (server->running) {
+        return HAL_STATUS_ALREADY_ACTIVE;
+    }
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (server->listen_fd < 0) {
+        printf("[%s] socket() failed: %s\n", server->name, strerror(errno));
+        return HAL_STATUS_IO_ERROR;
+    }
+
+    int opt = 1;
+    setsockopt(server->listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(server->config.port);
+    if (bind(server->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        printf("[%s] bind() failed on port %u: %s\n", server->name, server->config.port, strerror(errno));
+        close_fds(server);
+        return HAL_STATUS_IO_ERROR;
+    }
+    if (listen(server->listen_fd, HTTP_EVENT_LISTEN_BACKLOG) < 0) {
+        printf("[%s] listen() failed: %s\n", server->name, strerror(errno));
+        close_fds(server);
+        return HAL_STATUS_IO_ERROR;
+    }
+
+    socklen_t addr_len = sizeof(addr);
+    getsockname(server->listen_fd, (struct sockaddr *)&addr, &addr_len);
+    server->bound_port = ntohs(addr.sin_port);
+
+    server->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    server->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (server->epoll_fd < 0 || server->wake_fd < 0) {
+        printf("[%s] epoll/eventfd setup failed: %s\n", server->name, strerror(errno));
+        close_fds(server);
+        return HAL_STATUS_ERROR;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = HTTP_EVENT_TAG_LISTEN;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->listen_fd, &ev);
+    ev.data.u64 = HTTP_EVENT_TAG_WAKE;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->wake_fd, &ev);
+
+    server->workers_stop = false;
+    for (uint32_t i = 0; i < server->config.worker_count; i++) {
+        if (pthread_create(&server->workers[i], NULL, worker_thread, server) != 0) {
+            break;
+        }
+        server->worker_count++;
+    }
+    server->running = true;
+    if (server->worker_count == 0 ||
+        pthread_create(&server->loop_thread, NULL, event_loop_thread, server) != 0) {
+        server->running = false;
+        stop_workers(server);
+        close_fds(server);
+        return HAL_STATUS_ERROR;
+    }
+
+    printf("[%s] Listening on port %u (%u workers, keep-alive %s)\n", server->name, server->bound_port,
+           server->worker_count, server->config.keep_alive ? "on" : "off");
+    return HAL_STATUS_OK;
+}
+
+hal_status_t http_event_server_stop(http_event_server_t *server) {
+    if (server == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!server->running) {
+        return HAL_STATUS_OK;
+    }
+
+    server->running = false;
+    uint64_t one = 1;
+    (void)!write(server->wake_fd, &one, sizeof(one));
+    pthread_join(server->loop_thread, NULL);
+
+    // Workers finish the job in hand; whatever is still queued is dropped
+    stop_workers(server);
+
+    for (uint32_t i = 0; i < HTTP_EVENT_MAX_CONNECTIONS; i++) {
+        conn_close(server, i);
+    }
+
+    http_job_t *lists[2] = { server->pending_head, server->done_head };
+    for (int l = 0; l < 2; l++) {
+        http_job_t *job = lists[l];
+        while (job != NULL) {
+            http_job_t *next = job->next;
+            job_free(job);
+            job = next;
+        }
+    }
+    server->pending_head = NULL;
+    server->pending_tail = NULL;
+    server->done_head = NULL;
+    server->jobs_queued = 0;
+
+    close_fds(server);
+    server->bound_port = 0;
+    printf("[%s] Stopped\n", server->name);
+    return HAL_STATUS_OK;
+}
+
+void http_event_server_destroy(http_event_server_t *server) {
+    if (server == NULL) {
+        return;
+    }
+    http_event_server_stop(server);
+    pthread_mutex_destroy(&server->queue_mutex);
+    pthread_cond_destroy(&server->queue_cond);
+    pthread_mutex_destroy(&server->stats_mutex);
+    free(server);
+}
+
+hal_status_t http_event_server_stream_notify(http_event_server_t *server, uint64_t connection_id) {
+    if (server == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    uint32_t index = (uint32_t)(connection_id & 0xFFFFFFFFu);
+    if (index >= HTTP_EVENT_MAX_CONNECTIONS || !server->running) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    // A stale id at worst causes one empty pump of the slot's new owner
+    atomic_store(&server->conns[index].stream_ready, true);
+    uint64_t one = 1;
+    (void)!write(server->wake_fd, &one, sizeof(one));
+    return HAL_STATUS_OK;
+}
+
+uint16_t http_event_server_get_port(const http_event_server_t *server) {
+    return server ? server->bound_port : 0;
+}
+
+hal_status_t http_event_server_get_stats(http_event_server_t *server, http_event_server_stats_t *stats) {
+    if (server == NULL || stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&server->stats_mutex);
+    *stats = server->stats;
+    pthread_mutex_unlock(&server->stats_mutex);
+
+    pthread_mutex_lock(&server->queue_mutex);
+    stats->jobs_queued = server->jobs_queued;
+    pthread_mutex_unlock(&server->queue_mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t http_event_server_get_route_stats(http_event_server_t *server, http_event_route_stats_t *routes,
+                                               uint32_t max_routes, uint32_t *count) {
+    if (server == NULL || routes == NULL || count == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&server->stats_mutex);
+    uint32_t n = server->route_count < max_routes ? server->route_count : max_routes;
+    memcpy(routes, server->routes, n * sizeof(http_event_route_stats_t));
+    *count = n;
+    pthread_mutex_unlock(&server->stats_mutex);
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file http_event_server.h
+ * @brief Shared epoll HTTP/1.1 server core (keep-alive, pipelining, worker pool)
+ * @version 1.0.0
+ * @date 2025-02-10
+ * @team FW
+ *
+ * One event thread owns the listening socket and every client connection.
+ * It reads incrementally, frames requests across partial reads and hands
+ * each complete request to a small fixed pool of worker threads, so a
+ * handler that blocks on RS485 only holds up its own connection. Responses
+ * on a connection are written in request order; buffered pipelined
+ * requests are dispatched as soon as the previous response is sent.
+ *
+ * A handler may also turn its connection into a long-lived chunked stream;
+ * the event thread then pulls payload from the handler's read callback
+ * whenever the socket is drained and the producer has signalled new data.
+ */
+
+#ifndef HTTP_EVENT_SERVER_H
+#define HTTP_EVENT_SERVER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Server limits
+#define HTTP_EVENT_MAX_CONNECTIONS      64
+#define HTTP_EVENT_CONN_BUFFER_SIZE     8192    // Request head + body must fit
+#define HTTP_EVENT_MAX_WORKERS          8
+#define HTTP_EVENT_MAX_ROUTES           48
+#define HTTP_EVENT_ROUTE_LABEL_MAX      64
+#define HTTP_EVENT_EXTRA_HEADERS_MAX    512
+#define HTTP_EVENT_STREAM_CHUNK_MAX     4096    // Largest payload pulled per stream read
+#define HTTP_EVENT_STREAM_TICK_MS       50      // Stream poll period while any stream is open
+
+// Defaults applied when the config leaves a field at 0
+#define HTTP_EVENT_DEFAULT_WORKERS      4
+#define HTTP_EVENT_DEFAULT_IDLE_MS      15000
+#define HTTP_EVENT_DEFAULT_MAX_REQUESTS 1000
+
+// Latency histogram: upper bounds in microseconds, last bucket is +inf
+#define HTTP_EVENT_LATENCY_BUCKETS      10
+#define HTTP_EVENT_LATENCY_BOUNDS_US    { 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000 }
+
+typedef struct http_event_server http_event_server_t;
+
+/**
+ * @brief Pull the next stream payload (event thread, must not block)
+ * @return Bytes written to buf, 0 when nothing is pending
+ */
+typedef size_t (*http_event_stream_read_t)(void *stream_ctx, char *buf, size_t capacity);
+
+// Called once on the event thread when a stream connection goes away
+typedef void (*http_event_stream_close_t)(void *stream_ctx);
+
+// One framed request; raw is a private NUL-terminated copy of head + body
+typedef struct {
+    char method[16];
+    char target[256];               // Path including any query string
+    char version[16];
+    const char *raw;
+    size_t raw_length;
+    const char *body;               // Points into raw, not NUL-terminated by itself
+    size_t body_length;
+    bool keep_alive;                // What the client asked for
+    char client_ip[16];
+    uint16_t client_port;
+    uint64_t connection_id;         // Handle for http_event_server_stream_notify()
+} http_event_request_t;
+
+// Filled by the handler; the core frees body after sending
+typedef struct {
+    int status_code;
+    char content_type[64];          // Empty means application/json
+    char *body;                     // malloc'd, ownership passes to the core
+    size_t body_length;
+    bool body_borrowed;             // body belongs to the handler's thread (e.g. its JSON arena) and stays
+                                    // valid until the worker's next request; the core copies, never frees it
+    char extra_headers[HTTP_EVENT_EXTRA_HEADERS_MAX];  // "Name: value\r\n" lines
+    char route[HTTP_EVENT_ROUTE_LABEL_MAX];             // Latency bucket label, defaults to "unmatched"
+    bool close_connection;
+
+    // Set stream_read to keep the connection open as a chunked stream
+    http_event_stream_read_t stream_read;
+    http_event_stream_close_t stream_close;     // Also called if the stream never starts
+    void *stream_ctx;
+} http_event_response_t;
+
+// Runs on a worker thread
+typedef void (*http_event_handler_t)(const http_event_request_t *request,
+                                     http_event_response_t *response, void *user_data);
+
+typedef struct {
+    uint16_t port;                      // 0 binds an ephemeral port (tests)
+    uint32_t worker_count;
+    uint32_t max_connections;
+    uint32_t idle_timeout_ms;
+    uint32_t max_requests_per_connection;
+    bool keep_alive;
+    http_event_handler_t handler;
+    void *user_data;
+    const char *name;                   // Log prefix
+} http_event_server_config_t;
+
+typedef struct {
+    uint64_t connections_accepted;
+    uint64_t connections_rejected;      // Connection table full
+    uint32_t connections_active;
+    uint64_t requests;
+    uint64_t keepalive_reuses;          // Requests served on an already used connection
+    uint64_t pipelined_requests;        // Requests already buffered when the previous one was framed
+    uint64_t parse_errors;
+    uint64_t idle_timeouts;
+    uint32_t jobs_queued;
+    uint32_t streams_active;
+    uint64_t stream_chunks;
+} http_event_server_stats_t;
+
+typedef struct {
+    char route[HTTP_EVENT_ROUTE_LABEL_MAX];
+    uint64_t count;
+    uint64_t total_us;
+    uint64_t max_us;
+    uint64_t buckets[HTTP_EVENT_LATENCY_BUCKETS];
+} http_event_route_stats_t;
+
+/**
+ * @brief Create a server (does not bind yet)
+ * @param config Server configuration, handler is required
+ * @param server Receives the new server handle
+ * @return HAL status
+ */
+hal_status_t http_event_server_create(const http_event_server_config_t *config, http_event_server_t **server);
+
+/**
+ * @brief Bind, listen and start the event thread and worker pool
+ * @param server Server handle
+ * @return HAL status
+ */
+hal_status_t http_event_server_start(http_event_server_t *server);
+
+/**
+ * @brief Stop accepting, drop all connections and join every thread
+ * @param server Server handle
+ * @return HAL status
+ */
+hal_status_t http_event_server_stop(http_event_server_t *server);
+
+/**
+ * @brief Stop if running and free the server
+ * @param server Server handle (may be NULL)
+ */
+void http_event_server_destroy(http_event_server_t *server);
+
+/**
+ * @brief Get the bound port (useful when the config asked for port 0)
+ * @param server Server handle
+ * @return Port number, 0 if not listening
+ */
+uint16_t http_event_server_get_port(const http_event_server_t *server);
+
+/**
+ * @brief Get connection and request counters
+ * @param server Server handle
+ * @param stats Output statistics
+ * @return HAL status
+ */
+hal_status_t http_event_server_get_stats(http_event_server_t *server, http_event_server_stats_t *stats);
+
+/**
+ * @brief Copy per-route latency histograms
+ * @param server Server handle
+ * @param routes Output array
+ * @param max_routes Capacity of routes
+ * @param count Receives the number of routes copied
+ * @return HAL status
+ */
+hal_status_t http_event_server_get_route_stats(http_event_server_t *server, http_event_route_stats_t *routes,
+                                               uint32_t max_routes, uint32_t *count);
+
+/**
+ * @brief Tell the event thread a stream has data (any thread)
+ * @param server Server handle
+ * @param connection_id Value from the request that opened the stream
+ * @return HAL status
+ */
+hal_status_t http_event_server_stream_notify(http_event_server_t *server, uint64_t connection_id);
+
+/**
+ * @brief Reason phrase for a status code
+ * @param status_code HTTP status code
+ * @return Reason phrase
+ */
+const char* http_event_status_text(int status_code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HTTP_EVENT_SERVER_H
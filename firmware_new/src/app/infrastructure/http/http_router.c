@@ -0,0 +1,352 @@
+/**
+ * @file http_router.c
+ * @brief Path-segment trie route table with typed path parameters
+ * @version 1.0.0
+ * @date 2025-02-14
+ * @team FW
+ */
+
+#include "http_router.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+typedef struct http_router_node {
+    char *segment;                          // Literal text; NULL for the parameter child
+    size_t segment_len;
+    uint32_t hash;
+    char param_name[HTTP_ROUTER_PARAM_NAME_MAX];
+    http_router_param_type_t param_type;
+    struct http_router_node **children;     // Literal children
+    uint32_t child_count;
+    struct http_router_node *param_child;
+    void *targets[HTTP_ROUTER_MAX_METHODS];
+    char *pattern;                          // Set once any method ends here
+} http_router_node_t;
+
+struct http_router {
+    http_router_node_t root;
+    uint32_t route_count;
+};
+
+// A path split into segments without copying
+typedef struct {
+    const char *start[HTTP_ROUTER_MAX_SEGMENTS];
+    size_t len[HTTP_ROUTER_MAX_SEGMENTS];
+    uint32_t count;
+} path_segments_t;
+
+/**
+ * @brief FNV-1a over one segment
+ */
+static uint32_t segment_hash(const char *text, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Split at '/', dropping empty segments and anything after '?' or '#'
+ * @return false if the path has too many segments
+ */
+static bool split_path(const char *path, path_segments_t *segments) {
+    const char *p = path;
+
+    segments->count = 0;
+    while (*p != '\0' && *p != '?' && *p != '#') {
+        while (*p == '/') {
+            p++;
+        }
+        const char *start = p;
+        while (*p != '\0' && *p != '/' && *p != '?' && *p != '#') {
+            p++;
+        }
+        if (p == start) {
+            continue;
+        }
+        if (segments->count == HTTP_ROUTER_MAX_SEGMENTS) {
+            return false;
+        }
+        segments->start[segments->count] = start;
+        segments->len[segments->count] = (size_t)(p - start);
+        segments->count++;
+    }
+    return true;
+}
+
+static void node_free(http_router_node_t *node) {
+    for (uint32_t i = 0; i < node->child_count; i++) {
+        node_free(node->children[i]);
+        free(node->children[i]);
+    }
+    free(node->children);
+    if (node->param_child != NULL) {
+        node_free(node->param_child);
+        free(node->param_child);
+    }
+    free(node->segment);
+    free(node->pattern);
+}
+
+static http_router_node_t* find_literal_child(const http_router_node_t *node, const char *text, size_t len,
+                                              uint32_t hash) {
+    for (uint32_t i = 0; i < node->child_count; i++) {
+        http_router_node_t *child = node->children[i];
+        if (child->hash == hash && child->segment_len == len && memcmp(child->segment, text, len) == 0) {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parse "{name}" or "{name:type}"
+ * @return false if the segment is a malformed parameter
+ */
+static bool parse_param_segment(const char *text, size_t len, char *name, http_router_param_type_t *type) {
+    const char *colon = memchr(text, ':', len);
+    size_t name_len = colon != NULL ? (size_t)(colon - text) - 1 : len - 2;
+
+    if (name_len == 0 || name_len >= HTTP_ROUTER_PARAM_NAME_MAX) {
+        return false;
+    }
+    memcpy(name, text + 1, name_len);
+    name[name_len] = '\0';
+
+    *type = HTTP_ROUTER_PARAM_STR;
+    if (colon != NULL) {
+        const char *type_text = colon + 1;
+        size_t type_len = (size_t)(text + len - 1 - type_text);
+        if (type_len == 2 && strncmp(type_text, "u8", 2) == 0) {
+            *type = HTTP_ROUTER_PARAM_U8;
+        } else if (type_len == 3 && strncmp(type_text, "u16", 3) == 0) {
+            *type = HTTP_ROUTER_PARAM_U16;
+        } else if (type_len == 5 && strncmp(type_text, "hex16", 5) == 0) {
+            *type = HTTP_ROUTER_PARAM_HEX16;
+        } else if (type_len != 3 || strncmp(type_text, "str", 3) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+hal_status_t http_router_create(http_router_t **router) {
+    if (router == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *router = calloc(1, sizeof(http_router_t));
+    return *router != NULL ? HAL_STATUS_OK : HAL_STATUS_NO_MEMORY;
+}
+
+void http_router_destroy(http_router_t *router) {
+    if (router == NULL) {
+        return;
+    }
+    node_free(&router->root);
+    free(router);
+}
+
+hal_status_t http_router_add(http_router_t *router, uint32_t method, const char *pattern, void *target) {
+    path_segments_t segments;
+    uint32_t param_count = 0;
+
+    if (router == NULL || pattern == NULL || target == NULL || method >= HTTP_ROUTER_MAX_METHODS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!split_path(pattern, &segments)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    http_router_node_t *node = &router->root;
+    for (uint32_t s = 0; s < segments.count; s++) {
+        const char *text = segments.start[s];
+        size_t len = segments.len[s];
+
+        if (text[0] == '{' && text[len - 1] == '}') {
+            char name[HTTP_ROUTER_PARAM_NAME_MAX];
+            http_router_param_type_t type;
+            if (!parse_param_segment(text, len, name, &type) || ++param_count > HTTP_ROUTER_MAX_PARAMS) {
+                return HAL_STATUS_INVALID_PARAMETER;
+            }
+            if (node->param_child == NULL) {
+                node->param_child = calloc(1, sizeof(http_router_node_t));
+                if (node->param_child == NULL) {
+                    return HAL_STATUS_NO_MEMORY;
+                }
+                memcpy(node->param_child->param_name, name, sizeof(name));
+                node->param_child->param_type = type;
+            } else if (strcmp(node->param_child->param_name, name) != 0 || node->param_child->param_type != type) {
+                // Two spellings of the same position would make captures ambiguous
+                return HAL_STATUS_INVALID_PARAMETER;
+            }
+            node = node->param_child;
+            continue;
+        }
+
+        uint32_t hash = segment_hash(text, len);
+        http_router_node_t *child = find_literal_child(node, text, len, hash);
+        if (child == NULL) {
+            http_router_node_t **children = realloc(node->children,
+                                                    (node->child_count + 1) * sizeof(http_router_node_t *));
+            if (children == NULL) {
+                return HAL_STATUS_NO_MEMORY;
+            }
+            node->children = children;
+            child = calloc(1, sizeof(http_router_node_t));
+            if (child == NULL) {
+                return HAL_STATUS_NO_MEMORY;
+            }
+            child->segment = strndup(text, len);
+            if (child->segment == NULL) {
+                free(child);
+                return HAL_STATUS_NO_MEMORY;
+            }
+            child->segment_len = len;
+            child->hash = hash;
+            node->children[node->child_count++] = child;
+        }
+        node = child;
+    }
+
+    if (node->targets[method] != NULL) {
+        return HAL_STATUS_ALREADY_EXISTS;
+    }
+    if (node->pattern == NULL) {
+        node->pattern = strdup(pattern);
+        if (node->pattern == NULL) {
+            return HAL_STATUS_NO_MEMORY;
+        }
+    }
+    node->targets[method] = target;
+    router->route_count++;
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Validate and convert one captured segment
+ */
+static bool capture_param(const http_router_node_t *node, const char *text, size_t len, http_router_param_t *param) {
+    if (len >= HTTP_ROUTER_PARAM_VALUE_MAX) {
+        return false;
+    }
+    memcpy(param->value, text, len);
+    param->value[len] = '\0';
+    memcpy(param->name, node->param_name, sizeof(param->name));
+    param->number = 0;
+
+    switch (node->param_type) {
+        case HTTP_ROUTER_PARAM_STR:
+            return true;
+        case HTTP_ROUTER_PARAM_HEX16: {
+            const char *digits = param->value;
+            if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+                digits += 2;
+            }
+            size_t count = strlen(digits);
+            if (count == 0 || count > 4) {
+                return false;
+            }
+            for (size_t i = 0; i < count; i++) {
+                if (!isxdigit((unsigned char)digits[i])) {
+                    return false;
+                }
+            }
+            param->number = (uint32_t)strtoul(digits, NULL, 16);
+            return true;
+        }
+        case HTTP_ROUTER_PARAM_U8:
+        case HTTP_ROUTER_PARAM_U16: {
+            char *end = NULL;
+            if (!isdigit((unsigned char)param->value[0])) {
+                return false;
+            }
+            unsigned long value = strtoul(param->value, &end, 0);
+            unsigned long limit = node->param_type == HTTP_ROUTER_PARAM_U8 ? 0xFFUL : 0xFFFFUL;
+            if (*end != '\0' || value > limit) {
+                return false;
+            }
+            param->number = (uint32_t)value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Depth-first walk, literals before the parameter child
+ * @return Node where the path ends, or NULL
+ */
+static const http_router_node_t* match_node(const http_router_node_t *node, const path_segments_t *segments,
+                                            uint32_t depth, http_router_match_t *match) {
+    if (depth == segments->count) {
+        return node->pattern != NULL ? node : NULL;
+    }
+
+    const char *text = segments->start[depth];
+    size_t len = segments->len[depth];
+    const http_router_node_t *literal = find_literal_child(node, text, len, segment_hash(text, len));
+    if (literal != NULL) {
+        const http_router_node_t *found = match_node(literal, segments, depth + 1, match);
+        if (found != NULL) {
+            return found;
+        }
+    }
+
+    const http_router_node_t *param = node->param_child;
+    if (param != NULL && match->param_count < HTTP_ROUTER_MAX_PARAMS &&
+        capture_param(param, text, len, &match->params[match->param_count])) {
+        match->param_count++;
+        const http_router_node_t *found = match_node(param, segments, depth + 1, match);
+        if (found != NULL) {
+            return found;
+        }
+        match->param_count--;
+    }
+    return NULL;
+}
+
+hal_status_t http_router_match(const http_router_t *router, uint32_t method, const char *path,
+                               http_router_match_t *match) {
+    path_segments_t segments;
+
+    if (router == NULL || path == NULL || match == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    memset(match, 0, sizeof(*match));
+    if (!split_path(path, &segments)) {
+        return HAL_STATUS_NOT_FOUND;
+    }
+
+    const http_router_node_t *node = match_node(&router->root, &segments, 0, match);
+    if (node == NULL) {
+        match->param_count = 0;
+        return HAL_STATUS_NOT_FOUND;
+    }
+    match->pattern = node->pattern;
+    if (method >= HTTP_ROUTER_MAX_METHODS || node->targets[method] == NULL) {
+        return HAL_STATUS_NOT_SUPPORTED;
+    }
+    match->target = node->targets[method];
+    return HAL_STATUS_OK;
+}
+
+const http_router_param_t* http_router_find_param(const http_router_param_t *params, uint32_t count,
+                                                  const char *name) {
+    if (params == NULL || name == NULL) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (strcmp(params[i].name, name) == 0) {
+            return &params[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t http_router_route_count(const http_router_t *router) {
+    return router != NULL ? router->route_count : 0;
+}
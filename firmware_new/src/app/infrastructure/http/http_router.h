@@ -0,0 +1,119 @@
+/**
+ * @file http_router.h
+ * @brief Path-segment trie route table with typed path parameters
+ * @version 1.0.0
+ * @date 2025-02-14
+ * @team FW
+ *
+ * Routes are compiled into a trie keyed by path segment when they are
+ * registered, so a lookup costs one hashed compare per segment instead of
+ * a scan over every route. A segment written as {name:type} captures that
+ * part of the path and is validated and converted during the lookup:
+ *
+ *   u8     decimal or 0x-prefixed, 0..255
+ *   u16    decimal or 0x-prefixed, 0..65535
+ *   hex16  hexadecimal with or without 0x, 0..0xFFFF
+ *   str    any non-empty segment (the default when no type is given)
+ *
+ * Literal segments win over parameters at the same depth. The table is
+ * built before the server starts and is read-only afterwards, so lookups
+ * need no lock.
+ */
+
+#ifndef HTTP_ROUTER_H
+#define HTTP_ROUTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HTTP_ROUTER_MAX_METHODS         8       // Callers' method enums must stay below this
+#define HTTP_ROUTER_MAX_SEGMENTS        16
+#define HTTP_ROUTER_MAX_PARAMS          4
+#define HTTP_ROUTER_PARAM_NAME_MAX      16
+#define HTTP_ROUTER_PARAM_VALUE_MAX     64
+
+typedef enum {
+    HTTP_ROUTER_PARAM_STR = 0,
+    HTTP_ROUTER_PARAM_U8,
+    HTTP_ROUTER_PARAM_U16,
+    HTTP_ROUTER_PARAM_HEX16
+} http_router_param_type_t;
+
+typedef struct {
+    char name[HTTP_ROUTER_PARAM_NAME_MAX];
+    char value[HTTP_ROUTER_PARAM_VALUE_MAX];    // Raw segment text
+    uint32_t number;                            // Converted value for numeric types
+} http_router_param_t;
+
+typedef struct {
+    void *target;                   // What the route was registered with
+    const char *pattern;            // Registered pattern, stable for the router's lifetime
+    http_router_param_t params[HTTP_ROUTER_MAX_PARAMS];
+    uint32_t param_count;
+} http_router_match_t;
+
+typedef struct http_router http_router_t;
+
+/**
+ * @brief Create an empty route table
+ * @param router Receives the new router
+ * @return HAL status
+ */
+hal_status_t http_router_create(http_router_t **router);
+
+/**
+ * @brief Free a route table
+ * @param router Router (may be NULL)
+ */
+void http_router_destroy(http_router_t *router);
+
+/**
+ * @brief Add a route
+ * @param router Router
+ * @param method Caller-defined method index (< HTTP_ROUTER_MAX_METHODS)
+ * @param pattern Path pattern, e.g. "/api/v1/modules/{id:u8}/registers/{reg:hex16}"
+ * @param target Returned by http_router_match() for this route
+ * @return HAL_STATUS_ALREADY_EXISTS for a duplicate, HAL_STATUS_INVALID_PARAMETER for a bad pattern
+ */
+hal_status_t http_router_add(http_router_t *router, uint32_t method, const char *pattern, void *target);
+
+/**
+ * @brief Look up a request path (query string and fragment are ignored)
+ * @param router Router
+ * @param method Caller-defined method index
+ * @param path Request path
+ * @param match Output match with captured parameters
+ * @return HAL_STATUS_OK, HAL_STATUS_NOT_FOUND, or HAL_STATUS_NOT_SUPPORTED when
+ *         the path exists but not for this method
+ */
+hal_status_t http_router_match(const http_router_t *router, uint32_t method, const char *path,
+                               http_router_match_t *match);
+
+/**
+ * @brief Find a captured parameter by name
+ * @param params Parameter array
+ * @param count Number of parameters
+ * @param name Parameter name
+ * @return Parameter or NULL
+ */
+const http_router_param_t* http_router_find_param(const http_router_param_t *params, uint32_t count,
+                                                  const char *name);
+
+/**
+ * @brief Number of routes (method + pattern pairs) in the table
+ * @param router Router
+ * @return Route count
+ */
+uint32_t http_router_route_count(const http_router_t *router);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HTTP_ROUTER_H
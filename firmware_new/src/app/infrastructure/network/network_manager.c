@@ -29,7 +29,6 @@ static pthread_mutex_t network_mutex = PTHREAD_MUTEX_INITIALIZER;
 static int validate_wifi_credentials(const char *ssid, const char *password);
 static int validate_security_type(int security_type);
 static int validate_signal_threshold(int threshold);
-static uint64_t get_timestamp_ms(void);
 static void record_performance_metric(const char *operation, uint32_t response_time_ms, bool success);
 static void update_network_status(void);
 static void get_real_network_info(void);
@@ -75,7 +74,7 @@ int network_manager_init(void) {
     current_config.signal_strength = -70;
     current_config.roaming_enabled = true;
     current_config.mobile_app_enabled = true;
-    current_config.last_update_time = get_timestamp_ms();
+    current_config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
     
     // Initialize status
     memset(&current_status, 0, sizeof(oht_network_status_t));
@@ -124,7 +123,7 @@ int network_manager_deinit(void) {
  * @brief Connect to WiFi network
  */
 int network_manager_connect_wifi(const char *ssid, const char *password) {
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool success = false;
     
     pthread_mutex_lock(&network_mutex);
@@ -137,7 +136,7 @@ int network_manager_connect_wifi(const char *ssid, const char *password) {
     // Validate parameters
     if (!ssid || !password) {
         pthread_mutex_unlock(&network_mutex);
-        record_performance_metric("connect_wifi", get_timestamp_ms() - start_time, false);
+        record_performance_metric("connect_wifi", (uint32_t)(hal_time_now_ms() - start_time), false);
         return NETWORK_ERROR_INVALID_PARAM;
     }
     
@@ -145,14 +144,14 @@ int network_manager_connect_wifi(const char *ssid, const char *password) {
     int validation_result = validate_wifi_credentials(ssid, password);
     if (validation_result != NETWORK_SUCCESS) {
         pthread_mutex_unlock(&network_mutex);
-        record_performance_metric("connect_wifi", get_timestamp_ms() - start_time, false);
+        record_performance_metric("connect_wifi", (uint32_t)(hal_time_now_ms() - start_time), false);
         return validation_result;
     }
     
     // Update configuration
     strncpy(current_config.wifi_ssid, ssid, sizeof(current_config.wifi_ssid) - 1);
     strncpy(current_config.wifi_password, password, sizeof(current_config.wifi_password) - 1);
-    current_config.last_update_time = get_timestamp_ms();
+    current_config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
     
     // Connect via mock implementation
     printf("[NETWORK_MANAGER] Connecting to WiFi: %s\n", ssid);
@@ -174,7 +173,7 @@ int network_manager_connect_wifi(const char *ssid, const char *password) {
     
     pthread_mutex_unlock(&network_mutex);
     
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint32_t response_time = (uint32_t)(hal_time_now_ms() - start_time);
     record_performance_metric("connect_wifi", response_time, success);
     
     return success ? NETWORK_SUCCESS : NETWORK_ERROR_CONNECTION_FAILED;
@@ -184,7 +183,7 @@ int network_manager_connect_wifi(const char *ssid, const char *password) {
  * @brief Disconnect from current WiFi network
  */
 int network_manager_disconnect_wifi(void) {
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool success = false;
     
     pthread_mutex_lock(&network_mutex);
@@ -208,7 +207,7 @@ int network_manager_disconnect_wifi(void) {
     
     pthread_mutex_unlock(&network_mutex);
     
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint32_t response_time = (uint32_t)(hal_time_now_ms() - start_time);
     record_performance_metric("disconnect_wifi", response_time, success);
     
     return success ? NETWORK_SUCCESS : NETWORK_ERROR_CONNECTION_FAILED;
@@ -218,7 +217,7 @@ int network_manager_disconnect_wifi(void) {
  * @brief Scan for available WiFi networks
  */
 int network_manager_scan_networks(wifi_network_t *networks, int max_count) {
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool success = false;
     int networks_found = 0;
     
@@ -269,7 +268,7 @@ int network_manager_scan_networks(wifi_network_t *networks, int max_count) {
     
     pthread_mutex_unlock(&network_mutex);
     
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint32_t response_time = (uint32_t)(hal_time_now_ms() - start_time);
     record_performance_metric("scan_networks", response_time, success);
     
     printf("[NETWORK_MANAGER] Scanned %d networks\n", networks_found);
@@ -281,7 +280,7 @@ int network_manager_scan_networks(wifi_network_t *networks, int max_count) {
  * @brief Get current network status
  */
 int network_manager_get_status(oht_network_status_t *status) {
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool success = false;
     
     pthread_mutex_lock(&network_mutex);
@@ -305,7 +304,7 @@ int network_manager_get_status(oht_network_status_t *status) {
     
     pthread_mutex_unlock(&network_mutex);
     
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint32_t response_time = (uint32_t)(hal_time_now_ms() - start_time);
     record_performance_metric("get_status", response_time, success);
     
     return success ? NETWORK_SUCCESS : NETWORK_ERROR_INVALID_PARAM;
@@ -315,7 +314,7 @@ int network_manager_get_status(oht_network_status_t *status) {
  * @brief Enable/disable WiFi roaming
  */
 int network_manager_enable_roaming(bool enable) {
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool success = false;
     
     pthread_mutex_lock(&network_mutex);
@@ -326,7 +325,7 @@ int network_manager_enable_roaming(bool enable) {
     }
     
     current_config.roaming_enabled = enable;
-    current_config.last_update_time = get_timestamp_ms();
+    current_config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
     
     if (enable) {
         printf("[NETWORK_MANAGER] WiFi roaming enabled\n");
@@ -338,7 +337,7 @@ int network_manager_enable_roaming(bool enable) {
     
     pthread_mutex_unlock(&network_mutex);
     
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint32_t response_time = (uint32_t)(hal_time_now_ms() - start_time);
     record_performance_metric("enable_roaming", response_time, success);
     
     return success ? NETWORK_SUCCESS : NETWORK_ERROR_ROAMING_FAILED;
@@ -348,7 +347,7 @@ int network_manager_enable_roaming(bool enable) {
  * @brief Enable/disable mobile app support
  */
 int network_manager_enable_mobile_app(bool enable) {
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool success = false;
     
     pthread_mutex_lock(&network_mutex);
@@ -359,7 +358,7 @@ int network_manager_enable_mobile_app(bool enable) {
     }
     
     current_config.mobile_app_enabled = enable;
-    current_config.last_update_time = get_timestamp_ms();
+    current_config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
     
     if (enable) {
         printf("[NETWORK_MANAGER] Mobile app support enabled\n");
@@ -371,7 +370,7 @@ int network_manager_enable_mobile_app(bool enable) {
     
     pthread_mutex_unlock(&network_mutex);
     
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint32_t response_time = (uint32_t)(hal_time_now_ms() - start_time);
     record_performance_metric("enable_mobile_app", response_time, success);
     
     return success ? NETWORK_SUCCESS : NETWORK_ERROR_MOBILE_APP_FAILED;
@@ -422,7 +421,7 @@ int network_manager_set_config(const oht_network_config_t *config) {
     }
     
     current_config = *config;
-    current_config.last_update_time = get_timestamp_ms();
+    current_config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
     
     pthread_mutex_unlock(&network_mutex);
     return NETWORK_SUCCESS;
@@ -469,7 +468,7 @@ int network_manager_reset_config(void) {
     current_config.signal_strength = -70;
     current_config.roaming_enabled = true;
     current_config.mobile_app_enabled = true;
-    current_config.last_update_time = get_timestamp_ms();
+    current_config.last_update_time = (uint32_t)(hal_time_wall_ms() / 1000ULL);
     
     printf("[NETWORK_MANAGER] Configuration reset to defaults\n");
     
@@ -552,15 +551,6 @@ static int validate_signal_threshold(int threshold __attribute__((unused))) {
     return NETWORK_SUCCESS;
 }
 
-/**
- * @brief Get current timestamp in milliseconds
- */
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
-}
-
 /**
  * @brief Record performance metric
  */
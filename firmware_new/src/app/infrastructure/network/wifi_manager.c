@@ -30,7 +30,6 @@ static pthread_mutex_t wifi_mutex = PTHREAD_MUTEX_INITIALIZER;
 // Internal Functions
 static wifi_signal_quality_t get_signal_quality(int signal_dbm);
 static bool should_roam(int current_signal, int threshold);
-static uint64_t get_timestamp_ms(void);
 static void update_statistics(bool connection_success);
 static void log_wifi_event(const char *event, const char *details);
 
@@ -801,16 +800,6 @@ static bool should_roam(int current_signal, int threshold) {
     return current_signal < threshold;
 }
 
-/**
- * @brief Get current timestamp in milliseconds
- */
-static uint64_t get_timestamp_ms(void) __attribute__((unused));
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
-}
-
 /**
  * @brief Update WiFi statistics
  */
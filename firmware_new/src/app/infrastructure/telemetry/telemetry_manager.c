@@ -15,7 +15,10 @@
 #include <sys/sysinfo.h>
 #include <sys/statvfs.h>
 #include "telemetry_manager.h"
+#include "telemetry_stream.h"
+#include "../communication/modbus_bus_master.h"
 #include "hal_common.h"
+#include "json_writer.h"
 #include "system_state_machine.h"
 #include "module_manager.h"
 #include "safety_monitor.h"
@@ -23,10 +26,12 @@
 #include "estimator_1d.h"
 
 // Forward declarations for static functions
-static int serialize_power_module_registers(char *buffer, size_t buffer_size);
-static int serialize_safety_module_registers(char *buffer, size_t buffer_size);
-static int serialize_motor_module_registers(char *buffer, size_t buffer_size);
-static int serialize_dock_module_registers(char *buffer, size_t buffer_size);
+static void write_power_module_registers(json_writer_t *w);
+static void write_safety_module_registers(json_writer_t *w);
+static void write_motor_module_registers(json_writer_t *w);
+static void write_dock_module_registers(json_writer_t *w);
+static void write_register(json_writer_t *w, uint16_t addr, const char *name, int32_t value,
+                           const char *unit, const char *mode);
 
 // Telemetry Manager instance
 static struct {
@@ -130,11 +135,12 @@ static void collect_navigation_data(telemetry_data_t *data);
 static void collect_dock_data(telemetry_data_t *data);
 static void collect_safety_data(telemetry_data_t *data);
 static void broadcast_event(telemetry_event_t event, const telemetry_data_t *data);
-static int serialize_location_json(const telemetry_location_t *location, char *buffer, size_t buffer_size);
-static int serialize_navigation_json(const telemetry_navigation_t *navigation, char *buffer, size_t buffer_size);
-static int serialize_dock_json(const telemetry_dock_t *dock, char *buffer, size_t buffer_size);
-static int serialize_safety_json(const telemetry_safety_t *safety, char *buffer, size_t buffer_size);
-static int serialize_status_json(const telemetry_status_t *status, char *buffer, size_t buffer_size);
+static void write_location_json(json_writer_t *w, const telemetry_location_t *location);
+static void write_navigation_json(json_writer_t *w, const telemetry_navigation_t *navigation);
+static void write_dock_json(json_writer_t *w, const telemetry_dock_t *dock);
+static void write_safety_json(json_writer_t *w, const telemetry_safety_t *safety);
+static void write_status_json(json_writer_t *w, const telemetry_status_t *status);
+static int finish_json(const json_writer_t *w);
 
 // Telemetry Manager implementation
 
@@ -361,110 +367,37 @@ int telemetry_manager_serialize_json(const telemetry_data_t *data, char *json_bu
         return -1;
     }
     
-    int written = 0;
-    int result;
-    
-    // Start JSON object
-    result = snprintf(json_buffer + written, buffer_size - written,
-        "{\n"
-        "  \"ts\": %lu,\n"
-        "  \"status\": ",
-        (unsigned long)data->ts);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Serialize status (partial, ends with '"safety": ')
-    result = serialize_status_json(&data->status, json_buffer + written, buffer_size - written);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Append safety object
-    result = serialize_safety_json(&data->status.safety, json_buffer + written, buffer_size - written);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Close status object
-    result = snprintf(json_buffer + written, buffer_size - written, "\n  }");
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Serialize location
-    result = snprintf(json_buffer + written, buffer_size - written, ",\n  \"location\": ");
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    result = serialize_location_json(&data->location, json_buffer + written, buffer_size - written);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Serialize navigation
-    result = snprintf(json_buffer + written, buffer_size - written, ",\n  \"navigation\": ");
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    result = serialize_navigation_json(&data->navigation, json_buffer + written, buffer_size - written);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
+    json_writer_t w;
+    json_writer_init(&w, json_buffer, buffer_size);
+    json_writer_begin_object(&w);
+    json_writer_field_uint(&w, "ts", data->ts);
+    json_writer_key(&w, "status");
+    write_status_json(&w, &data->status);
+    json_writer_key(&w, "location");
+    write_location_json(&w, &data->location);
+    json_writer_key(&w, "navigation");
+    write_navigation_json(&w, &data->navigation);
+    json_writer_key(&w, "dock");
+    write_dock_json(&w, &data->dock);
+    
+    // System fields
+    json_writer_field_string(&w, "mission_id", data->mission_id);
+    json_writer_field_string(&w, "station_id", data->station_id);
+    json_writer_field_bool(&w, "cargo_present", data->cargo_present);
+    json_writer_field_bool(&w, "cargo_locked", data->cargo_locked);
+    json_writer_field_fixed(&w, "cpu_usage", data->cpu_usage, 2);
+    json_writer_field_fixed(&w, "memory_usage", data->memory_usage, 2);
+    json_writer_field_fixed(&w, "temperature", data->temperature, 2);
+    json_writer_field_bool(&w, "center_connected", data->center_connected);
+    json_writer_field_bool(&w, "rs485_connected", data->rs485_connected);
+    json_writer_field_string(&w, "tag_id", data->tag_id);
+    json_writer_field_int(&w, "rssi", data->rssi);
+    json_writer_end_object(&w);
+    
+    int written = finish_json(&w);
+    if (written < 0) {
         return -1;
     }
-    written += result;
-    
-    // Serialize dock
-    result = snprintf(json_buffer + written, buffer_size - written, ",\n  \"dock\": ");
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    result = serialize_dock_json(&data->dock, json_buffer + written, buffer_size - written);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Add system fields
-    result = snprintf(json_buffer + written, buffer_size - written,
-        ",\n"
-        "  \"mission_id\": \"%s\",\n"
-        "  \"station_id\": \"%s\",\n"
-        "  \"cargo_present\": %s,\n"
-        "  \"cargo_locked\": %s,\n"
-        "  \"cpu_usage\": %.2f,\n"
-        "  \"memory_usage\": %.2f,\n"
-        "  \"temperature\": %.2f,\n"
-        "  \"center_connected\": %s,\n"
-        "  \"rs485_connected\": %s,\n"
-        "  \"tag_id\": \"%s\",\n"
-        "  \"rssi\": %d\n"
-        "}",
-        data->mission_id,
-        data->station_id,
-        data->cargo_present ? "true" : "false",
-        data->cargo_locked ? "true" : "false",
-        data->cpu_usage,
-        data->memory_usage,
-        data->temperature,
-        data->center_connected ? "true" : "false",
-        data->rs485_connected ? "true" : "false",
-        data->tag_id,
-        data->rssi);
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
     
     g_telemetry_manager.statistics.json_serializations++;
     return written;
@@ -518,62 +451,41 @@ int telemetry_manager_serialize_rs485_telemetry(uint8_t module_addr, char *json_
         default: module_name = "Unknown"; break;
     }
     
-    int written = 0;
-    int result;
-    
-    // Start JSON object with issue #90 format
-    result = snprintf(json_buffer + written, buffer_size - written,
-        "{\n"
-        "  \"type\": \"telemetry\",\n"
-        "  \"data\": {\n"
-        "    \"module_addr\": \"0x%02X\",\n"
-        "    \"module_name\": \"%s\",\n"
-        "    \"registers\": [",
-        module_addr, module_name);
-    
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
+    json_writer_t w;
+    json_writer_init(&w, json_buffer, buffer_size);
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "type", "telemetry");
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_hex(&w, "module_addr", module_addr, 2);
+    json_writer_field_string(&w, "module_name", module_name);
+    json_writer_key(&w, "registers");
+    json_writer_begin_array(&w);
     
     // Add module-specific registers based on address
     if (module_addr == 0x02) {
         // Power module registers (DalyBMS + SK60X + INA219)
-        result = serialize_power_module_registers(json_buffer + written, buffer_size - written);
+        write_power_module_registers(&w);
     } else if (module_addr == 0x03) {
         // Safety module registers
-        result = serialize_safety_module_registers(json_buffer + written, buffer_size - written);
+        write_safety_module_registers(&w);
     } else if (module_addr == 0x04) {
         // Travel Motor module registers
-        result = serialize_motor_module_registers(json_buffer + written, buffer_size - written);
+        write_motor_module_registers(&w);
     } else if (module_addr == 0x05) {
         // Dock & Location module registers
-        result = serialize_dock_module_registers(json_buffer + written, buffer_size - written);
+        write_dock_module_registers(&w);
     } else {
         // Unknown module - basic registers
-        result = snprintf(json_buffer + written, buffer_size - written,
-            "\n      {\"addr\": \"0x0100\", \"name\": \"Device_ID\", \"value\": 0, \"unit\": \"hex\", \"mode\": \"R\"}");
+        write_register(&w, 0x0100, "Device_ID", 0, "hex", "R");
     }
     
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
-    
-    // Close JSON object
-    result = snprintf(json_buffer + written, buffer_size - written,
-        "\n    ],\n"
-        "    \"timestamp\": \"%s\"\n"
-        "  }\n"
-        "}",
-        timestamp);
-    
-    if (result < 0 || result >= (int)(buffer_size - written)) {
-        return -1;
-    }
-    written += result;
+    json_writer_end_array(&w);
+    json_writer_field_string(&w, "timestamp", timestamp);
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
     
-    return written;
+    return finish_json(&w);
 }
 
 // Helper functions
@@ -582,7 +494,7 @@ static void initialize_telemetry_data(telemetry_data_t *data) {
     memset(data, 0, sizeof(telemetry_data_t));
     
     // Initialize with default values
-    data->ts = hal_get_timestamp_us();
+    data->ts = hal_time_wall_ms() * 1000ULL;
     data->status.state = SYSTEM_STATE_INIT;
     data->location.system_status = LOCATION_SYSTEM_OK;
     data->location.imu_status = IMU_STATUS_OK;
@@ -601,7 +513,7 @@ static void initialize_telemetry_data(telemetry_data_t *data) {
 }
 
 static void update_timestamp(telemetry_data_t *data) {
-    data->ts = hal_get_timestamp_us();
+    data->ts = hal_time_wall_ms() * 1000ULL;
 }
 
 static void collect_system_data(telemetry_data_t *data) {
@@ -722,34 +634,84 @@ static void broadcast_event(telemetry_event_t event, const telemetry_data_t *dat
         g_telemetry_manager.event_callback(event, data);
         g_telemetry_manager.statistics.events_sent++;
     }
+    
+    // Stream subscribers get the section that changed, not the whole record
+    char json[TELEMETRY_STREAM_EVENT_JSON_MAX];
+    json_writer_t w;
+    json_writer_init(&w, json, sizeof(json));
+    const char *name = NULL;
+    switch (event) {
+        case TELEMETRY_EVENT_LOCATION_UPDATE:
+            name = "location";
+            write_location_json(&w, &data->location);
+            break;
+        case TELEMETRY_EVENT_NAVIGATION_UPDATE:
+            name = "navigation";
+            write_navigation_json(&w, &data->navigation);
+            break;
+        case TELEMETRY_EVENT_DOCK_UPDATE:
+            name = "dock";
+            write_dock_json(&w, &data->dock);
+            break;
+        case TELEMETRY_EVENT_SAFETY_ALERT:
+            name = "safety";
+            write_safety_json(&w, &data->status.safety);
+            break;
+        case TELEMETRY_EVENT_SYSTEM_STATUS:
+            name = "telemetry_status";
+            write_status_json(&w, &data->status);
+            break;
+        default:
+            break;
+    }
+    if (name != NULL && finish_json(&w) > 0) {
+        (void)telemetry_stream_publish_event(name, json);
+    }
 }
 
 // JSON serialization helpers
 
-static int serialize_location_json(const telemetry_location_t *location, char *buffer, size_t buffer_size) {
-    return snprintf(buffer, buffer_size,
-        "{\n"
-        "    \"position\": {\"x\": %.2f, \"y\": %.2f, \"z\": %.2f},\n"
-        "    \"orientation\": {\"pitch\": %.2f, \"roll\": %.2f, \"yaw\": %.2f},\n"
-        "    \"velocity\": {\"x\": %.2f, \"y\": %.2f, \"z\": %.2f},\n"
-        "    \"acceleration\": {\"x\": %.2f, \"y\": %.2f, \"z\": %.2f},\n"
-        "    \"accuracy\": %.2f,\n"
-        "    \"system_status\": \"%s\",\n"
-        "    \"imu_status\": \"%s\",\n"
-        "    \"magnetic_status\": \"%s\"\n"
-        "  }",
-        location->position.x, location->position.y, location->position.z,
-        location->orientation.pitch, location->orientation.roll, location->orientation.yaw,
-        location->velocity.x, location->velocity.y, location->velocity.z,
-        location->acceleration.x, location->acceleration.y, location->acceleration.z,
-        location->accuracy,
-        location->system_status == LOCATION_SYSTEM_OK ? "ok" : 
-        location->system_status == LOCATION_SYSTEM_ERROR ? "error" : "calibrating",
-        location->imu_status == IMU_STATUS_OK ? "ok" : "error",
-        location->magnetic_status == MAGNETIC_STATUS_OK ? "ok" : "error");
-}
-
-static int serialize_navigation_json(const telemetry_navigation_t *navigation, char *buffer, size_t buffer_size) {
+/**
+ * @brief Length of a finished document, -1 if it overflowed its buffer
+ */
+static int finish_json(const json_writer_t *w) {
+    size_t length = 0;
+    if (json_writer_data(w, &length) == NULL) {
+        return -1;
+    }
+    return (int)length;
+}
+
+static void write_xyz(json_writer_t *w, const char *key, float x, float y, float z) {
+    json_writer_key(w, key);
+    json_writer_begin_object(w);
+    json_writer_field_fixed(w, "x", x, 2);
+    json_writer_field_fixed(w, "y", y, 2);
+    json_writer_field_fixed(w, "z", z, 2);
+    json_writer_end_object(w);
+}
+
+static void write_location_json(json_writer_t *w, const telemetry_location_t *location) {
+    json_writer_begin_object(w);
+    write_xyz(w, "position", location->position.x, location->position.y, location->position.z);
+    json_writer_key(w, "orientation");
+    json_writer_begin_object(w);
+    json_writer_field_fixed(w, "pitch", location->orientation.pitch, 2);
+    json_writer_field_fixed(w, "roll", location->orientation.roll, 2);
+    json_writer_field_fixed(w, "yaw", location->orientation.yaw, 2);
+    json_writer_end_object(w);
+    write_xyz(w, "velocity", location->velocity.x, location->velocity.y, location->velocity.z);
+    write_xyz(w, "acceleration", location->acceleration.x, location->acceleration.y, location->acceleration.z);
+    json_writer_field_fixed(w, "accuracy", location->accuracy, 2);
+    json_writer_field_string(w, "system_status",
+        location->system_status == LOCATION_SYSTEM_OK ? "ok" :
+        location->system_status == LOCATION_SYSTEM_ERROR ? "error" : "calibrating");
+    json_writer_field_string(w, "imu_status", location->imu_status == IMU_STATUS_OK ? "ok" : "error");
+    json_writer_field_string(w, "magnetic_status", location->magnetic_status == MAGNETIC_STATUS_OK ? "ok" : "error");
+    json_writer_end_object(w);
+}
+
+static void write_navigation_json(json_writer_t *w, const telemetry_navigation_t *navigation) {
     const char *status_str = "idle";
     switch (navigation->status) {
         case NAV_STATUS_NAVIGATING: status_str = "navigating"; break;
@@ -758,7 +720,7 @@ static int serialize_navigation_json(const telemetry_navigation_t *navigation, c
         case NAV_STATUS_ERROR: status_str = "error"; break;
         default: status_str = "idle"; break;
     }
-    
+
     const char *zone_str = "safe";
     switch (navigation->zone_type) {
         case ZONE_TYPE_WARNING: zone_str = "warning"; break;
@@ -766,35 +728,23 @@ static int serialize_navigation_json(const telemetry_navigation_t *navigation, c
         case ZONE_TYPE_EMERGENCY: zone_str = "emergency"; break;
         default: zone_str = "safe"; break;
     }
-    
-    return snprintf(buffer, buffer_size,
-        "{\n"
-        "    \"status\": \"%s\",\n"
-        "    \"target\": {\"x\": %.2f, \"y\": %.2f, \"z\": %.2f},\n"
-        "    \"progress\": %.2f,\n"
-        "    \"distance_to_target\": %.2f,\n"
-        "    \"estimated_time\": %.2f,\n"
-        "    \"path_clear\": %s,\n"
-        "    \"obstacle_detected\": %s,\n"
-        "    \"obstacle_distance\": %.2f,\n"
-        "    \"obstacle_angle\": %.2f,\n"
-        "    \"speed_limit\": %.2f,\n"
-        "    \"zone_type\": \"%s\"\n"
-        "  }",
-        status_str,
-        navigation->target.x, navigation->target.y, navigation->target.z,
-        navigation->progress,
-        navigation->distance_to_target,
-        navigation->estimated_time,
-        navigation->path_clear ? "true" : "false",
-        navigation->obstacle_detected ? "true" : "false",
-        navigation->obstacle_distance,
-        navigation->obstacle_angle,
-        navigation->speed_limit,
-        zone_str);
+
+    json_writer_begin_object(w);
+    json_writer_field_string(w, "status", status_str);
+    write_xyz(w, "target", navigation->target.x, navigation->target.y, navigation->target.z);
+    json_writer_field_fixed(w, "progress", navigation->progress, 2);
+    json_writer_field_fixed(w, "distance_to_target", navigation->distance_to_target, 2);
+    json_writer_field_fixed(w, "estimated_time", navigation->estimated_time, 2);
+    json_writer_field_bool(w, "path_clear", navigation->path_clear);
+    json_writer_field_bool(w, "obstacle_detected", navigation->obstacle_detected);
+    json_writer_field_fixed(w, "obstacle_distance", navigation->obstacle_distance, 2);
+    json_writer_field_fixed(w, "obstacle_angle", navigation->obstacle_angle, 2);
+    json_writer_field_fixed(w, "speed_limit", navigation->speed_limit, 2);
+    json_writer_field_string(w, "zone_type", zone_str);
+    json_writer_end_object(w);
 }
 
-static int serialize_dock_json(const telemetry_dock_t *dock, char *buffer, size_t buffer_size) {
+static void write_dock_json(json_writer_t *w, const telemetry_dock_t *dock) {
     const char *status_str = "not_docking";
     switch (dock->status) {
         case DOCK_STATUS_APPROACHING: status_str = "approaching"; break;
@@ -804,7 +754,7 @@ static int serialize_dock_json(const telemetry_dock_t *dock, char *buffer, size_
         case DOCK_STATUS_ERROR: status_str = "error"; break;
         default: status_str = "not_docking"; break;
     }
-    
+
     const char *alignment_str = "not_aligned";
     switch (dock->alignment_status) {
         case ALIGNMENT_ALIGNING: alignment_str = "aligning"; break;
@@ -812,7 +762,7 @@ static int serialize_dock_json(const telemetry_dock_t *dock, char *buffer, size_
         case ALIGNMENT_ERROR: alignment_str = "error"; break;
         default: alignment_str = "not_aligned"; break;
     }
-    
+
     const char *charging_str = "not_charging";
     switch (dock->charging_status) {
         case CHARGING_CHARGING: charging_str = "charging"; break;
@@ -820,66 +770,43 @@ static int serialize_dock_json(const telemetry_dock_t *dock, char *buffer, size_
         case CHARGING_ERROR: charging_str = "error"; break;
         default: charging_str = "not_charging"; break;
     }
-    
+
     const char *safety_str = "safe";
     switch (dock->safety_status) {
         case DOCK_SAFETY_WARNING: safety_str = "warning"; break;
         case DOCK_SAFETY_DANGER: safety_str = "danger"; break;
         default: safety_str = "safe"; break;
     }
-    
-    return snprintf(buffer, buffer_size,
-        "{\n"
-        "    \"status\": \"%s\",\n"
-        "    \"station_id\": \"%s\",\n"
-        "    \"target_station_id\": \"%s\",\n"
-        "    \"alignment_status\": \"%s\",\n"
-        "    \"distance\": %.2f,\n"
-        "    \"angle\": %.2f,\n"
-        "    \"charging_status\": \"%s\",\n"
-        "    \"charging_current\": %.2f,\n"
-        "    \"charging_voltage\": %.2f,\n"
-        "    \"rfid_tag_id\": \"%s\",\n"
-        "    \"rfid_signal_strength\": %d,\n"
-        "    \"safety_status\": \"%s\"\n"
-        "  }",
-        status_str,
-        dock->station_id,
-        dock->target_station_id,
-        alignment_str,
-        dock->distance,
-        dock->angle,
-        charging_str,
-        dock->charging_current,
-        dock->charging_voltage,
-        dock->rfid_tag_id,
-        dock->rfid_signal_strength,
-        safety_str);
-}
-
-static int serialize_safety_json(const telemetry_safety_t *safety, char *buffer, size_t buffer_size) {
-    return snprintf(buffer, buffer_size,
-        "{\n"
-        "    \"estop\": %s,\n"
-        "    \"zone_blocked\": %s,\n"
-        "    \"interlock_active\": %s,\n"
-        "    \"location_safe\": %s,\n"
-        "    \"obstacle_detected\": %s,\n"
-        "    \"safety_zone_clear\": %s,\n"
-        "    \"emergency_stop\": %s\n"
-        "  }",
-        safety->estop ? "true" : "false",
-        safety->zone_blocked ? "true" : "false",
-        safety->interlock_active ? "true" : "false",
-        safety->location_safe ? "true" : "false",
-        safety->obstacle_detected ? "true" : "false",
-        safety->safety_zone_clear ? "true" : "false",
-        safety->emergency_stop ? "true" : "false");
-}
-
-// RS485 module register serializers (implementations below)
 
-static int serialize_status_json(const telemetry_status_t *status, char *buffer, size_t buffer_size) {
+    json_writer_begin_object(w);
+    json_writer_field_string(w, "status", status_str);
+    json_writer_field_string(w, "station_id", dock->station_id);
+    json_writer_field_string(w, "target_station_id", dock->target_station_id);
+    json_writer_field_string(w, "alignment_status", alignment_str);
+    json_writer_field_fixed(w, "distance", dock->distance, 2);
+    json_writer_field_fixed(w, "angle", dock->angle, 2);
+    json_writer_field_string(w, "charging_status", charging_str);
+    json_writer_field_fixed(w, "charging_current", dock->charging_current, 2);
+    json_writer_field_fixed(w, "charging_voltage", dock->charging_voltage, 2);
+    json_writer_field_string(w, "rfid_tag_id", dock->rfid_tag_id);
+    json_writer_field_int(w, "rfid_signal_strength", dock->rfid_signal_strength);
+    json_writer_field_string(w, "safety_status", safety_str);
+    json_writer_end_object(w);
+}
+
+static void write_safety_json(json_writer_t *w, const telemetry_safety_t *safety) {
+    json_writer_begin_object(w);
+    json_writer_field_bool(w, "estop", safety->estop);
+    json_writer_field_bool(w, "zone_blocked", safety->zone_blocked);
+    json_writer_field_bool(w, "interlock_active", safety->interlock_active);
+    json_writer_field_bool(w, "location_safe", safety->location_safe);
+    json_writer_field_bool(w, "obstacle_detected", safety->obstacle_detected);
+    json_writer_field_bool(w, "safety_zone_clear", safety->safety_zone_clear);
+    json_writer_field_bool(w, "emergency_stop", safety->emergency_stop);
+    json_writer_end_object(w);
+}
+
+static void write_status_json(json_writer_t *w, const telemetry_status_t *status) {
     const char *state_str = "idle";
     switch (status->state) {
         case SYSTEM_STATE_MOVE: state_str = "move"; break;
@@ -888,225 +815,176 @@ static int serialize_status_json(const telemetry_status_t *status, char *buffer,
         case SYSTEM_STATE_ESTOP: state_str = "estop"; break;
         default: state_str = "idle"; break;
     }
-    
-    const char *health_str = "ok";
-    (void)health_str; // Suppress unused warning
-    switch (status->enc.health) {
-        case ENCODER_HEALTH_WARNING: health_str = "warning"; break;
-        case ENCODER_HEALTH_ERROR: health_str = "error"; break;
-        default: health_str = "ok"; break;
-    }
-    
-    return snprintf(buffer, buffer_size,
-        "{\n"
-        "    \"state\": \"%s\",\n"
-        "    \"pos_mm\": %.2f,\n"
-        "    \"vel_mms\": %.2f,\n"
-        "    \"acc_mms2\": %.2f,\n"
-        "    \"target\": {\"pos_mm\": %.2f, \"vel_mms\": %.2f},\n"
-        "    \"safety\": ",
-        state_str,
-        status->pos_mm,
-        status->vel_mms,
-        status->acc_mms2,
-        status->target.pos_mm,
-        status->target.vel_mms);
+
+    json_writer_begin_object(w);
+    json_writer_field_string(w, "state", state_str);
+    json_writer_field_fixed(w, "pos_mm", status->pos_mm, 2);
+    json_writer_field_fixed(w, "vel_mms", status->vel_mms, 2);
+    json_writer_field_fixed(w, "acc_mms2", status->acc_mms2, 2);
+    json_writer_key(w, "target");
+    json_writer_begin_object(w);
+    json_writer_field_fixed(w, "pos_mm", status->target.pos_mm, 2);
+    json_writer_field_fixed(w, "vel_mms", status->target.vel_mms, 2);
+    json_writer_end_object(w);
+    json_writer_key(w, "safety");
+    write_safety_json(w, &status->safety);
+    json_writer_end_object(w);
 }
 
 // RS485 Module Register Serializers for Issue #90
 
 /**
- * @brief Serialize Power Module (0x02) registers - DalyBMS + SK60X + INA219
+ * @brief One integer register entry: {"addr","name","value","unit","mode"}
  */
-static int serialize_power_module_registers(char *buffer, size_t buffer_size) {
-    // Read actual data from Power Module via communication manager
+static void write_register(json_writer_t *w, uint16_t addr, const char *name, int32_t value,
+                           const char *unit, const char *mode) {
+    json_writer_begin_object(w);
+    json_writer_field_hex(w, "addr", addr, 4);
+    json_writer_field_string(w, "name", name);
+    json_writer_field_int(w, "value", value);
+    json_writer_field_string(w, "unit", unit);
+    json_writer_field_string(w, "mode", mode);
+    json_writer_end_object(w);
+}
+
+/**
+ * @brief One scaled register entry (value with one decimal, "scaling": 0.1 when scaled)
+ */
+static void write_register_scaled(json_writer_t *w, uint16_t addr, const char *name, float value,
+                                  const char *unit, const char *mode, bool scaled) {
+    json_writer_begin_object(w);
+    json_writer_field_hex(w, "addr", addr, 4);
+    json_writer_field_string(w, "name", name);
+    json_writer_field_fixed(w, "value", value, 1);
+    json_writer_field_string(w, "unit", unit);
+    json_writer_field_string(w, "mode", mode);
+    if (scaled) {
+        json_writer_field_fixed(w, "scaling", 0.1, 1);
+    }
+    json_writer_end_object(w);
+}
+
+/**
+ * @brief Write Power Module (0x02) registers - DalyBMS + SK60X + INA219
+ */
+static void write_power_module_registers(json_writer_t *w) {
+    // Read actual data from Power Module through the bus master (TELEMETRY priority)
     uint16_t battery_data[11] = {0};  // Battery registers 0x0000-0x000A
     uint16_t charging_data[8] = {0};  // SK60X registers 0x0030-0x0037
     uint16_t power_data[12] = {0};    // INA219 registers 0x0040-0x004B
-    
+
     // Read battery data (best effort)
-    comm_manager_modbus_read_holding_registers(0x02, 0x0000, 11, battery_data);
-    comm_manager_modbus_read_holding_registers(0x02, 0x0032, 4, &charging_data[2]); // SK60X subset
-    comm_manager_modbus_read_holding_registers(0x02, 0x0040, 12, power_data);
-    
-    return snprintf(buffer, buffer_size,
-        "\n      // DalyBMS Status Registers\n"
-        "      {\"addr\": \"0x0000\", \"name\": \"Battery_Voltage\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0001\", \"name\": \"Battery_Current\", \"value\": %.1f, \"unit\": \"A\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0002\", \"name\": \"Battery_SOC\", \"value\": %.1f, \"unit\": \"%%\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0003\", \"name\": \"Max_Cell_Voltage\", \"value\": %d, \"unit\": \"mV\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0004\", \"name\": \"Min_Cell_Voltage\", \"value\": %d, \"unit\": \"mV\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0008\", \"name\": \"Temperature\", \"value\": %d, \"unit\": \"°C\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0009\", \"name\": \"Connection_Status\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x000B\", \"name\": \"Charge_MOS\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x000C\", \"name\": \"Discharge_MOS\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0011\", \"name\": \"Charge_Status\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      \n"
-        "      // SK60X Power Supply Registers\n"
-        "      {\"addr\": \"0x0032\", \"name\": \"Output_Voltage\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0033\", \"name\": \"Output_Current\", \"value\": %.1f, \"unit\": \"A\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0034\", \"name\": \"Output_Power\", \"value\": %.1f, \"unit\": \"W\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x003C\", \"name\": \"Output_ON_OFF\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"RW\"},\n"
-        "      \n"
-        "      // INA219 Multi-rail Monitoring\n"
-        "      {\"addr\": \"0x0040\", \"name\": \"12V_Output_Voltage\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0041\", \"name\": \"12V_Output_Current\", \"value\": %.1f, \"unit\": \"A\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0043\", \"name\": \"5V_Output_Voltage\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0044\", \"name\": \"5V_Output_Current\", \"value\": %.1f, \"unit\": \"A\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0046\", \"name\": \"3V3_Output_Voltage\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x0047\", \"name\": \"3V3_Output_Current\", \"value\": %.1f, \"unit\": \"A\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      \n"
-        "      // Relay Controls\n"
-        "      {\"addr\": \"0x0049\", \"name\": \"12V_Relay\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x004A\", \"name\": \"5V_Relay\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x004B\", \"name\": \"3V3_Relay\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"RW\"}",
-        
-        // DalyBMS values
-        battery_data[0] * 0.1f,  // Battery_Voltage
-        (int16_t)battery_data[1] * 0.1f,  // Battery_Current (signed)
-        battery_data[2] * 0.1f,  // Battery_SOC
-        battery_data[3],         // Max_Cell_Voltage
-        battery_data[4],         // Min_Cell_Voltage
-        (int16_t)battery_data[8], // Temperature (signed)
-        battery_data[9],         // Connection_Status
-        battery_data[10] & 0x01, // Charge_MOS (bit 0)
-        (battery_data[10] >> 1) & 0x01, // Discharge_MOS (bit 1)
-        battery_data[10] >> 2,   // Charge_Status
-        
-        // SK60X values
-        charging_data[2] * 0.1f, // Output_Voltage
-        charging_data[3] * 0.1f, // Output_Current
-        charging_data[4] * 0.1f, // Output_Power
-        charging_data[7] & 0x01, // Output_ON_OFF
-        
-        // INA219 values
-        power_data[0] * 0.1f,    // 12V_Output_Voltage
-        power_data[1] * 0.1f,    // 12V_Output_Current
-        power_data[3] * 0.1f,    // 5V_Output_Voltage
-        power_data[4] * 0.1f,    // 5V_Output_Current
-        power_data[6] * 0.1f,    // 3V3_Output_Voltage
-        power_data[7] * 0.1f,    // 3V3_Output_Current
-        
-        // Relay states
-        power_data[9],           // 12V_Relay
-        power_data[10],          // 5V_Relay
-        power_data[11]           // 3V3_Relay
-    );
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x02, 0x0000, 11, battery_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x02, 0x0032, 4, &charging_data[2]); // SK60X subset
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x02, 0x0040, 12, power_data);
+
+    // DalyBMS Status Registers
+    write_register_scaled(w, 0x0000, "Battery_Voltage", battery_data[0] * 0.1f, "V", "R", true);
+    write_register_scaled(w, 0x0001, "Battery_Current", (int16_t)battery_data[1] * 0.1f, "A", "R", true); // signed
+    write_register_scaled(w, 0x0002, "Battery_SOC", battery_data[2] * 0.1f, "%", "R", true);
+    write_register(w, 0x0003, "Max_Cell_Voltage", battery_data[3], "mV", "R");
+    write_register(w, 0x0004, "Min_Cell_Voltage", battery_data[4], "mV", "R");
+    write_register(w, 0x0008, "Temperature", (int16_t)battery_data[8], "°C", "R"); // signed
+    write_register(w, 0x0009, "Connection_Status", battery_data[9], "bool", "R");
+    write_register(w, 0x000B, "Charge_MOS", battery_data[10] & 0x01, "bool", "R");            // bit 0
+    write_register(w, 0x000C, "Discharge_MOS", (battery_data[10] >> 1) & 0x01, "bool", "R");  // bit 1
+    write_register(w, 0x0011, "Charge_Status", battery_data[10] >> 2, "bool", "R");
+
+    // SK60X Power Supply Registers
+    write_register_scaled(w, 0x0032, "Output_Voltage", charging_data[2] * 0.1f, "V", "R", true);
+    write_register_scaled(w, 0x0033, "Output_Current", charging_data[3] * 0.1f, "A", "R", true);
+    write_register_scaled(w, 0x0034, "Output_Power", charging_data[4] * 0.1f, "W", "R", true);
+    write_register(w, 0x003C, "Output_ON_OFF", charging_data[7] & 0x01, "bool", "RW");
+
+    // INA219 Multi-rail Monitoring
+    write_register_scaled(w, 0x0040, "12V_Output_Voltage", power_data[0] * 0.1f, "V", "R", true);
+    write_register_scaled(w, 0x0041, "12V_Output_Current", power_data[1] * 0.1f, "A", "R", true);
+    write_register_scaled(w, 0x0043, "5V_Output_Voltage", power_data[3] * 0.1f, "V", "R", true);
+    write_register_scaled(w, 0x0044, "5V_Output_Current", power_data[4] * 0.1f, "A", "R", true);
+    write_register_scaled(w, 0x0046, "3V3_Output_Voltage", power_data[6] * 0.1f, "V", "R", true);
+    write_register_scaled(w, 0x0047, "3V3_Output_Current", power_data[7] * 0.1f, "A", "R", true);
+
+    // Relay Controls
+    write_register(w, 0x0049, "12V_Relay", power_data[9], "bool", "RW");
+    write_register(w, 0x004A, "5V_Relay", power_data[10], "bool", "RW");
+    write_register(w, 0x004B, "3V3_Relay", power_data[11], "bool", "RW");
 }
 
 /**
- * @brief Serialize Safety Module (0x03) registers - Proximity Sensors + Relays
+ * @brief Write Safety Module (0x03) registers - Proximity Sensors + Relays
  */
-static int serialize_safety_module_registers(char *buffer, size_t buffer_size) {
+static void write_safety_module_registers(json_writer_t *w) {
     // Read actual data from Safety Module
     uint16_t safety_data[8] = {0};   // Safety status registers 0x0000-0x0007
     uint16_t analog_data[4] = {0};   // Analog inputs 0x0010-0x0013
     uint16_t digital_data[1] = {0};  // Digital inputs 0x0020
     uint16_t relay_data[1] = {0};    // Relay control 0x0030
-    
+
     // Read safety data (best effort)
-    comm_manager_modbus_read_holding_registers(0x03, 0x0000, 8, safety_data);
-    comm_manager_modbus_read_holding_registers(0x03, 0x0010, 4, analog_data);
-    comm_manager_modbus_read_holding_registers(0x03, 0x0020, 1, digital_data);
-    comm_manager_modbus_read_holding_registers(0x03, 0x0030, 1, relay_data);
-    
-    return snprintf(buffer, buffer_size,
-        "\n      {\"addr\": \"0x0000\", \"name\": \"Safety_Status\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0001\", \"name\": \"Emergency_Stop\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0002\", \"name\": \"Safety_Zone\", \"value\": %d, \"unit\": \"enum\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0003\", \"name\": \"Proximity_Alert\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0010\", \"name\": \"Analog_Input_1\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0011\", \"name\": \"Analog_Input_2\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0012\", \"name\": \"Analog_Input_3\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0013\", \"name\": \"Analog_Input_4\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0020\", \"name\": \"Digital_Inputs\", \"value\": %d, \"unit\": \"bitmask\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0030\", \"name\": \"Relay_Control\", \"value\": %d, \"unit\": \"bitmask\", \"mode\": \"RW\"}",
-        
-        safety_data[0],          // Safety_Status
-        safety_data[1],          // Emergency_Stop
-        safety_data[2],          // Safety_Zone
-        safety_data[3],          // Proximity_Alert
-        analog_data[0] * 0.1f,   // Analog_Input_1 (scaled to V)
-        analog_data[1] * 0.1f,   // Analog_Input_2
-        analog_data[2] * 0.1f,   // Analog_Input_3
-        analog_data[3] * 0.1f,   // Analog_Input_4
-        digital_data[0],         // Digital_Inputs
-        relay_data[0]            // Relay_Control
-    );
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x03, 0x0000, 8, safety_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x03, 0x0010, 4, analog_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x03, 0x0020, 1, digital_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x03, 0x0030, 1, relay_data);
+
+    write_register(w, 0x0000, "Safety_Status", safety_data[0], "bool", "R");
+    write_register(w, 0x0001, "Emergency_Stop", safety_data[1], "bool", "R");
+    write_register(w, 0x0002, "Safety_Zone", safety_data[2], "enum", "R");
+    write_register(w, 0x0003, "Proximity_Alert", safety_data[3], "bool", "R");
+    // Analog inputs scaled to V
+    write_register_scaled(w, 0x0010, "Analog_Input_1", analog_data[0] * 0.1f, "V", "R", false);
+    write_register_scaled(w, 0x0011, "Analog_Input_2", analog_data[1] * 0.1f, "V", "R", false);
+    write_register_scaled(w, 0x0012, "Analog_Input_3", analog_data[2] * 0.1f, "V", "R", false);
+    write_register_scaled(w, 0x0013, "Analog_Input_4", analog_data[3] * 0.1f, "V", "R", false);
+    write_register(w, 0x0020, "Digital_Inputs", digital_data[0], "bitmask", "R");
+    write_register(w, 0x0030, "Relay_Control", relay_data[0], "bitmask", "RW");
 }
 
 /**
- * @brief Serialize Travel Motor Module (0x04) registers
+ * @brief Write Travel Motor Module (0x04) registers
  */
-static int serialize_motor_module_registers(char *buffer, size_t buffer_size) {
+static void write_motor_module_registers(json_writer_t *w) {
     // Read actual data from Travel Motor Module
     uint16_t control_data[16] = {0}; // Control registers 0x0000-0x000F
     uint16_t status_data[16] = {0};  // Status registers 0x0010-0x001F
-    
+
     // Read motor data (best effort)
-    comm_manager_modbus_read_holding_registers(0x04, 0x0000, 16, control_data);
-    comm_manager_modbus_read_holding_registers(0x04, 0x0010, 16, status_data);
-    
-    return snprintf(buffer, buffer_size,
-        "\n      {\"addr\": \"0x0000\", \"name\": \"Motor_Enable\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x0001\", \"name\": \"Operation_Mode\", \"value\": %d, \"unit\": \"enum\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x0002\", \"name\": \"Speed_Target\", \"value\": %d, \"unit\": \"rpm\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x0003\", \"name\": \"Speed_Actual\", \"value\": %d, \"unit\": \"rpm\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0004\", \"name\": \"Position_Target\", \"value\": %d, \"unit\": \"mm\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x0005\", \"name\": \"Position_Actual\", \"value\": %d, \"unit\": \"mm\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x0006\", \"name\": \"Direction\", \"value\": %d, \"unit\": \"enum\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x000B\", \"name\": \"Temperature\", \"value\": %d, \"unit\": \"°C\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x000C\", \"name\": \"Voltage\", \"value\": %.1f, \"unit\": \"V\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x000D\", \"name\": \"Current\", \"value\": %.1f, \"unit\": \"A\", \"mode\": \"R\", \"scaling\": 0.1},\n"
-        "      {\"addr\": \"0x000E\", \"name\": \"Fault_Status\", \"value\": %d, \"unit\": \"bitmask\", \"mode\": \"R\"}",
-        
-        control_data[0],         // Motor_Enable
-        control_data[1],         // Operation_Mode
-        control_data[2],         // Speed_Target
-        control_data[3],         // Speed_Actual
-        control_data[4],         // Position_Target
-        control_data[5],         // Position_Actual
-        control_data[6],         // Direction
-        (int16_t)control_data[11], // Temperature (signed)
-        control_data[12] * 0.1f, // Voltage
-        control_data[13] * 0.1f, // Current
-        control_data[14]         // Fault_Status
-    );
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x04, 0x0000, 16, control_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x04, 0x0010, 16, status_data);
+
+    write_register(w, 0x0000, "Motor_Enable", control_data[0], "bool", "RW");
+    write_register(w, 0x0001, "Operation_Mode", control_data[1], "enum", "RW");
+    write_register(w, 0x0002, "Speed_Target", control_data[2], "rpm", "RW");
+    write_register(w, 0x0003, "Speed_Actual", control_data[3], "rpm", "R");
+    write_register(w, 0x0004, "Position_Target", control_data[4], "mm", "RW");
+    write_register(w, 0x0005, "Position_Actual", control_data[5], "mm", "R");
+    write_register(w, 0x0006, "Direction", control_data[6], "enum", "RW");
+    write_register(w, 0x000B, "Temperature", (int16_t)control_data[11], "°C", "R"); // signed
+    write_register_scaled(w, 0x000C, "Voltage", control_data[12] * 0.1f, "V", "R", true);
+    write_register_scaled(w, 0x000D, "Current", control_data[13] * 0.1f, "A", "R", true);
+    write_register(w, 0x000E, "Fault_Status", control_data[14], "bitmask", "R");
 }
 
 /**
- * @brief Serialize Dock & Location Module (0x05) registers
+ * @brief Write Dock & Location Module (0x05) registers
  */
-static int serialize_dock_module_registers(char *buffer, size_t buffer_size) {
+static void write_dock_module_registers(json_writer_t *w) {
     // Read actual data from Dock Module
     uint16_t position_data[8] = {0}; // Position registers 0x7000-0x7007
     uint16_t control_data[2] = {0};  // Control registers 0x8000-0x8001
     uint16_t fault_data[1] = {0};    // Fault register 0x9000
-    
+
     // Read dock data (best effort)
-    comm_manager_modbus_read_holding_registers(0x05, 0x7000, 8, position_data);
-    comm_manager_modbus_read_holding_registers(0x05, 0x8000, 2, control_data);
-    comm_manager_modbus_read_holding_registers(0x05, 0x9000, 1, fault_data);
-    
-    return snprintf(buffer, buffer_size,
-        "\n      {\"addr\": \"0x7000\", \"name\": \"Position_Target\", \"value\": %d, \"unit\": \"mm\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x7001\", \"name\": \"Current_Position\", \"value\": %d, \"unit\": \"mm\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x7002\", \"name\": \"Approach_Speed\", \"value\": %d, \"unit\": \"mm/s\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x7005\", \"name\": \"Dock_Status\", \"value\": %d, \"unit\": \"enum\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x7006\", \"name\": \"Distance_to_Dock\", \"value\": %d, \"unit\": \"mm\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x7007\", \"name\": \"Alignment_Angle\", \"value\": %d, \"unit\": \"deg*10\", \"mode\": \"R\"},\n"
-        "      {\"addr\": \"0x8000\", \"name\": \"Dock_Enable\", \"value\": %d, \"unit\": \"bool\", \"mode\": \"RW\"},\n"
-        "      {\"addr\": \"0x8001\", \"name\": \"Start_Docking\", \"value\": %d, \"unit\": \"cmd\", \"mode\": \"W\"},\n"
-        "      {\"addr\": \"0x9000\", \"name\": \"Fault_Status\", \"value\": %d, \"unit\": \"bitmask\", \"mode\": \"R\"}",
-        
-        position_data[0],        // Position_Target
-        position_data[1],        // Current_Position
-        position_data[2],        // Approach_Speed
-        position_data[5],        // Dock_Status
-        position_data[6],        // Distance_to_Dock
-        position_data[7],        // Alignment_Angle
-        control_data[0],         // Dock_Enable
-        control_data[1],         // Start_Docking
-        fault_data[0]            // Fault_Status
-    );
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x05, 0x7000, 8, position_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x05, 0x8000, 2, control_data);
+    modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x05, 0x9000, 1, fault_data);
+
+    write_register(w, 0x7000, "Position_Target", position_data[0], "mm", "RW");
+    write_register(w, 0x7001, "Current_Position", position_data[1], "mm", "R");
+    write_register(w, 0x7002, "Approach_Speed", position_data[2], "mm/s", "RW");
+    write_register(w, 0x7005, "Dock_Status", position_data[5], "enum", "R");
+    write_register(w, 0x7006, "Distance_to_Dock", position_data[6], "mm", "R");
+    write_register(w, 0x7007, "Alignment_Angle", position_data[7], "deg*10", "R");
+    write_register(w, 0x8000, "Dock_Enable", control_data[0], "bool", "RW");
+    write_register(w, 0x8001, "Start_Docking", control_data[1], "cmd", "W");
+    write_register(w, 0x9000, "Fault_Status", fault_data[0], "bitmask", "R");
 }
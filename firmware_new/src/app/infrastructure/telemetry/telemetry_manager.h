@@ -207,7 +207,7 @@ typedef struct {
 
 // Main Telemetry Data Structure
 typedef struct {
-    uint64_t ts;                    // Unix timestamp
+    uint64_t ts;                    // Unix timestamp in microseconds (wall clock, reporting only)
     telemetry_status_t status;      // System status
     telemetry_location_t location;  // Location data
     telemetry_navigation_t navigation; // Navigation data
@@ -0,0 +1,533 @@
+/**
+ * @file telemetry_stream.c
+ * @brief Server-push telemetry stream fed from register cache changes
+ * @version 1.0.0
+ * @date 2025-02-12
+ * @team FW
+ */
+
+#include "telemetry_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+
+typedef struct {
+    uint8_t module_addr;
+    uint16_t register_addr;
+    uint16_t value;
+    uint64_t timestamp_ms;
+} stream_delta_t;
+
+typedef struct {
+    bool in_use;
+    uint32_t id;
+    telemetry_stream_filter_t filter;
+    telemetry_stream_notify_t notify;
+    void *notify_ctx;
+    stream_delta_t queue[TELEMETRY_STREAM_QUEUE_DEPTH];    // Oldest first
+    uint32_t queue_count;
+    uint32_t dropped;               // Evicted since the last batch, reported in the next one
+    uint64_t event_cursor;          // Next event sequence to send
+    uint64_t last_batch_ms;
+    uint64_t last_output_ms;
+} stream_subscriber_t;
+
+typedef struct {
+    char name[TELEMETRY_STREAM_EVENT_NAME_MAX];
+    char json[TELEMETRY_STREAM_EVENT_JSON_MAX];
+} stream_event_t;
+
+static struct {
+    bool initialized;
+    stream_subscriber_t subscribers[TELEMETRY_STREAM_MAX_SUBSCRIBERS];
+    uint32_t next_id;
+    stream_event_t events[TELEMETRY_STREAM_EVENT_RING];
+    uint64_t event_head;            // Sequence of the next event published
+    telemetry_stream_stats_t stats;
+} g_stream;
+
+static pthread_mutex_t g_stream_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Find an active subscriber (lock held)
+ */
+static stream_subscriber_t* find_subscriber(uint32_t subscriber_id) {
+    for (uint32_t i = 0; i < TELEMETRY_STREAM_MAX_SUBSCRIBERS; i++) {
+        if (g_stream.subscribers[i].in_use && g_stream.subscribers[i].id == subscriber_id) {
+            return &g_stream.subscribers[i];
+        }
+    }
+    return NULL;
+}
+
+static bool filter_wants_module(const telemetry_stream_filter_t *filter, uint8_t module_addr) {
+    return filter->all_modules || (filter->module_mask[module_addr / 8] & (1u << (module_addr % 8))) != 0;
+}
+
+static bool filter_wants_register(const telemetry_stream_filter_t *filter, uint16_t register_addr) {
+    if (filter->register_count == 0) {
+        return true;
+    }
+    for (uint32_t i = 0; i < filter->register_count; i++) {
+        if (filter->registers[i] == register_addr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Queue one delta, overwriting a pending value for the same register
+ */
+static void queue_delta(stream_subscriber_t *sub, uint8_t module_addr, uint16_t register_addr,
+                        uint16_t value, uint64_t timestamp_ms) {
+    for (uint32_t i = 0; i < sub->queue_count; i++) {
+        stream_delta_t *delta = &sub->queue[i];
+        if (delta->register_addr == register_addr && delta->module_addr == module_addr) {
+            delta->value = value;
+            delta->timestamp_ms = timestamp_ms;
+            g_stream.stats.deltas_coalesced++;
+            return;
+        }
+    }
+
+    if (sub->queue_count == TELEMETRY_STREAM_QUEUE_DEPTH) {
+        memmove(&sub->queue[0], &sub->queue[1], (TELEMETRY_STREAM_QUEUE_DEPTH - 1) * sizeof(stream_delta_t));
+        sub->queue_count--;
+        sub->dropped++;
+        g_stream.stats.deltas_dropped++;
+    }
+    sub->queue[sub->queue_count].module_addr = module_addr;
+    sub->queue[sub->queue_count].register_addr = register_addr;
+    sub->queue[sub->queue_count].value = value;
+    sub->queue[sub->queue_count].timestamp_ms = timestamp_ms;
+    sub->queue_count++;
+    g_stream.stats.deltas_queued++;
+}
+
+/**
+ * @brief Copy JSON dropping whitespace outside strings, so it fits one SSE/NDJSON line
+ * @return Compacted length, 0 if it does not fit
+ */
+static size_t compact_json(const char *json, char *out, size_t capacity) {
+    size_t len = 0;
+    bool in_string = false;
+    bool escaped = false;
+
+    for (const char *p = json; *p != '\0'; p++) {
+        char c = *p;
+        if (!in_string && (c == ' ' || c == '\t' || c == '\n' || c == '\r')) {
+            continue;
+        }
+        if (c == '\n' || c == '\r') {
+            continue;   // A raw newline inside a string would break framing
+        }
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = false;
+            }
+        } else if (c == '"') {
+            in_string = true;
+        }
+        if (len + 1 >= capacity) {
+            return 0;
+        }
+        out[len++] = c;
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief snprintf that reports 0 instead of truncating
+ */
+static size_t append_record(size_t capacity, int written) {
+    if (written < 0 || (size_t)written >= capacity) {
+        return 0;
+    }
+    return (size_t)written;
+}
+
+static size_t format_event(const stream_subscriber_t *sub, const stream_event_t *event, char *buf, size_t capacity) {
+    if (sub->filter.format == TELEMETRY_STREAM_FORMAT_SSE) {
+        return append_record(capacity, snprintf(buf, capacity, "event: %s\ndata: %s\n\n",
+                                                event->name, event->json));
+    }
+    return append_record(capacity, snprintf(buf, capacity, "{\"type\":\"event\",\"event\":\"%s\",\"data\":%s}\n",
+                                            event->name, event->json));
+}
+
+/**
+ * @brief Format one batch for the module of the oldest queued delta and drop what was sent
+ * @return Bytes written, 0 if not even one register fits
+ */
+static size_t format_register_batch(stream_subscriber_t *sub, char *buf, size_t capacity) {
+    bool sse = sub->filter.format == TELEMETRY_STREAM_FORMAT_SSE;
+    const char *tail = sse ? "]}\n\n" : "]}\n";
+    size_t tail_len = strlen(tail);
+    uint8_t module_addr = sub->queue[0].module_addr;
+    uint64_t timestamp_ms = 0;
+    bool sent[TELEMETRY_STREAM_QUEUE_DEPTH];
+    uint32_t sent_count = 0;
+
+    for (uint32_t i = 0; i < sub->queue_count; i++) {
+        if (sub->queue[i].module_addr == module_addr && sub->queue[i].timestamp_ms > timestamp_ms) {
+            timestamp_ms = sub->queue[i].timestamp_ms;
+        }
+    }
+
+    size_t len = append_record(capacity,
+                               snprintf(buf, capacity, "%s{%s\"module\":%u,\"timestamp\":%llu,\"dropped\":%u,\"registers\":[",
+                                        sse ? "event: registers\ndata: " : "",
+                                        sse ? "" : "\"type\":\"registers\",",
+                                        module_addr, (unsigned long long)timestamp_ms, sub->dropped));
+    if (len == 0) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < sub->queue_count; i++) {
+        sent[i] = false;
+        if (sub->queue[i].module_addr != module_addr) {
+            continue;
+        }
+        char entry[48];
+        int entry_len = snprintf(entry, sizeof(entry), "%s{\"address\":\"0x%04X\",\"value\":%u}",
+                                 sent_count > 0 ? "," : "", sub->queue[i].register_addr, sub->queue[i].value);
+        if (len + (size_t)entry_len + tail_len >= capacity) {
+            // The rest waits for the next read, keeping queue order
+            for (uint32_t j = i + 1; j < sub->queue_count; j++) {
+                sent[j] = false;
+            }
+            break;
+        }
+        memcpy(buf + len, entry, (size_t)entry_len);
+        len += (size_t)entry_len;
+        sent[i] = true;
+        sent_count++;
+    }
+    if (sent_count == 0) {
+        return 0;
+    }
+    memcpy(buf + len, tail, tail_len + 1);
+    len += tail_len;
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < sub->queue_count; i++) {
+        if (!sent[i]) {
+            sub->queue[kept++] = sub->queue[i];
+        }
+    }
+    sub->queue_count = kept;
+    sub->dropped = 0;
+    return len;
+}
+
+hal_status_t telemetry_stream_init(void) {
+    pthread_mutex_lock(&g_stream_mutex);
+    if (g_stream.initialized) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+    memset(&g_stream, 0, sizeof(g_stream));
+    g_stream.next_id = 1;
+    g_stream.initialized = true;
+    pthread_mutex_unlock(&g_stream_mutex);
+
+    printf("[TELEMETRY_STREAM] Initialized (%d subscribers, %d deltas each)\n",
+           TELEMETRY_STREAM_MAX_SUBSCRIBERS, TELEMETRY_STREAM_QUEUE_DEPTH);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t telemetry_stream_deinit(void) {
+    pthread_mutex_lock(&g_stream_mutex);
+    if (!g_stream.initialized) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    memset(&g_stream, 0, sizeof(g_stream));
+    pthread_mutex_unlock(&g_stream_mutex);
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Parse a comma separated number list
+ * @return Number of entries, -1 on a bad or out of range entry
+ */
+static int parse_number_list(char *list, uint32_t *values, int max_values, uint32_t max_value) {
+    int count = 0;
+    char *save = NULL;
+
+    for (char *item = strtok_r(list, ",", &save); item != NULL; item = strtok_r(NULL, ",", &save)) {
+        char *end = NULL;
+        unsigned long value = strtoul(item, &end, 0);
+        if (end == item || *end != '\0' || value > max_value || count == max_values) {
+            return -1;
+        }
+        values[count++] = (uint32_t)value;
+    }
+    return count;
+}
+
+hal_status_t telemetry_stream_parse_filter(const char *query, telemetry_stream_filter_t *filter) {
+    char copy[512];
+    char *save = NULL;
+
+    if (filter == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    memset(filter, 0, sizeof(*filter));
+    filter->format = TELEMETRY_STREAM_FORMAT_SSE;
+    filter->all_modules = true;
+    filter->include_events = true;
+    if (query == NULL || query[0] == '\0') {
+        return HAL_STATUS_OK;
+    }
+    if (strlen(query) >= sizeof(copy)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    strcpy(copy, query);
+
+    for (char *pair = strtok_r(copy, "&", &save); pair != NULL; pair = strtok_r(NULL, "&", &save)) {
+        char *value = strchr(pair, '=');
+        if (value == NULL) {
+            continue;
+        }
+        *value++ = '\0';
+
+        if (strcmp(pair, "modules") == 0) {
+            uint32_t modules[256];
+            if (strcasecmp(value, "all") == 0) {
+                continue;
+            }
+            int count = parse_number_list(value, modules, 256, 0xFF);
+            if (count <= 0) {
+                return HAL_STATUS_INVALID_PARAMETER;
+            }
+            filter->all_modules = false;
+            for (int i = 0; i < count; i++) {
+                filter->module_mask[modules[i] / 8] |= (uint8_t)(1u << (modules[i] % 8));
+            }
+        } else if (strcmp(pair, "registers") == 0) {
+            uint32_t registers[TELEMETRY_STREAM_MAX_REGISTERS];
+            int count = parse_number_list(value, registers, TELEMETRY_STREAM_MAX_REGISTERS, 0xFFFF);
+            if (count <= 0) {
+                return HAL_STATUS_INVALID_PARAMETER;
+            }
+            for (int i = 0; i < count; i++) {
+                filter->registers[i] = (uint16_t)registers[i];
+            }
+            filter->register_count = (uint32_t)count;
+        } else if (strcmp(pair, "interval_ms") == 0) {
+            uint32_t interval;
+            if (parse_number_list(value, &interval, 1, 60000) != 1) {
+                return HAL_STATUS_INVALID_PARAMETER;
+            }
+            filter->min_interval_ms = interval;
+        } else if (strcmp(pair, "format") == 0) {
+            if (strcasecmp(value, "sse") == 0) {
+                filter->format = TELEMETRY_STREAM_FORMAT_SSE;
+            } else if (strcasecmp(value, "ndjson") == 0) {
+                filter->format = TELEMETRY_STREAM_FORMAT_NDJSON;
+            } else {
+                return HAL_STATUS_INVALID_PARAMETER;
+            }
+        } else if (strcmp(pair, "events") == 0) {
+            filter->include_events = strcmp(value, "1") == 0 || strcasecmp(value, "true") == 0;
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t telemetry_stream_subscribe(const telemetry_stream_filter_t *filter, telemetry_stream_notify_t notify,
+                                        void *notify_ctx, uint32_t *subscriber_id) {
+    if (filter == NULL || subscriber_id == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_stream_mutex);
+    if (!g_stream.initialized) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    for (uint32_t i = 0; i < TELEMETRY_STREAM_MAX_SUBSCRIBERS; i++) {
+        stream_subscriber_t *sub = &g_stream.subscribers[i];
+        if (sub->in_use) {
+            continue;
+        }
+        memset(sub, 0, sizeof(*sub));
+        sub->in_use = true;
+        sub->id = g_stream.next_id++;
+        sub->filter = *filter;
+        sub->notify = notify;
+        sub->notify_ctx = notify_ctx;
+        sub->event_cursor = g_stream.event_head;
+        sub->last_output_ms = hal_get_timestamp_ms();
+        g_stream.stats.subscribers++;
+        *subscriber_id = sub->id;
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_OK;
+    }
+    pthread_mutex_unlock(&g_stream_mutex);
+    return HAL_STATUS_BUSY;
+}
+
+hal_status_t telemetry_stream_unsubscribe(uint32_t subscriber_id) {
+    pthread_mutex_lock(&g_stream_mutex);
+    stream_subscriber_t *sub = find_subscriber(subscriber_id);
+    if (sub == NULL) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_NOT_FOUND;
+    }
+    sub->in_use = false;
+    g_stream.stats.subscribers--;
+    pthread_mutex_unlock(&g_stream_mutex);
+    return HAL_STATUS_OK;
+}
+
+void telemetry_stream_on_registers(uint8_t module_addr, uint16_t start_addr, const uint16_t *values,
+                                   uint16_t count, uint64_t timestamp_ms, void *user_data) {
+    (void)user_data;
+    if (values == NULL || count == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_stream_mutex);
+    if (g_stream.stats.subscribers == 0) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return;
+    }
+    for (uint32_t s = 0; s < TELEMETRY_STREAM_MAX_SUBSCRIBERS; s++) {
+        stream_subscriber_t *sub = &g_stream.subscribers[s];
+        if (!sub->in_use || !filter_wants_module(&sub->filter, module_addr)) {
+            continue;
+        }
+        bool was_empty = sub->queue_count == 0;
+        for (uint16_t i = 0; i < count; i++) {
+            uint16_t register_addr = (uint16_t)(start_addr + i);
+            if (filter_wants_register(&sub->filter, register_addr)) {
+                queue_delta(sub, module_addr, register_addr, values[i], timestamp_ms);
+            }
+        }
+        // Only the first pending delta wakes the transport; later ones ride along
+        if (was_empty && sub->queue_count > 0 && sub->notify != NULL) {
+            sub->notify(sub->notify_ctx);
+        }
+    }
+    pthread_mutex_unlock(&g_stream_mutex);
+}
+
+hal_status_t telemetry_stream_publish_event(const char *name, const char *json) {
+    char compact[TELEMETRY_STREAM_EVENT_JSON_MAX];
+
+    if (name == NULL || json == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    size_t json_len = compact_json(json, compact, sizeof(compact));
+
+    pthread_mutex_lock(&g_stream_mutex);
+    if (!g_stream.initialized) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    if (json_len == 0) {
+        g_stream.stats.events_dropped++;
+        pthread_mutex_unlock(&g_stream_mutex);
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    stream_event_t *event = &g_stream.events[g_stream.event_head % TELEMETRY_STREAM_EVENT_RING];
+    snprintf(event->name, sizeof(event->name), "%s", name);
+    memcpy(event->json, compact, json_len + 1);
+    g_stream.event_head++;
+    g_stream.stats.events_published++;
+
+    for (uint32_t s = 0; s < TELEMETRY_STREAM_MAX_SUBSCRIBERS; s++) {
+        stream_subscriber_t *sub = &g_stream.subscribers[s];
+        if (sub->in_use && sub->filter.include_events && sub->notify != NULL) {
+            sub->notify(sub->notify_ctx);
+        }
+    }
+    pthread_mutex_unlock(&g_stream_mutex);
+    return HAL_STATUS_OK;
+}
+
+size_t telemetry_stream_read(uint32_t subscriber_id, char *buf, size_t capacity) {
+    size_t len = 0;
+
+    if (buf == NULL || capacity == 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&g_stream_mutex);
+    stream_subscriber_t *sub = find_subscriber(subscriber_id);
+    if (sub == NULL) {
+        pthread_mutex_unlock(&g_stream_mutex);
+        return 0;
+    }
+    uint64_t now_ms = hal_get_timestamp_ms();
+
+    if (sub->filter.include_events) {
+        // A subscriber that fell a full ring behind loses the oldest events
+        if (g_stream.event_head - sub->event_cursor > TELEMETRY_STREAM_EVENT_RING) {
+            uint64_t missed = g_stream.event_head - sub->event_cursor - TELEMETRY_STREAM_EVENT_RING;
+            g_stream.stats.events_dropped += missed;
+            sub->event_cursor = g_stream.event_head - TELEMETRY_STREAM_EVENT_RING;
+        }
+        while (sub->event_cursor < g_stream.event_head) {
+            const stream_event_t *event = &g_stream.events[sub->event_cursor % TELEMETRY_STREAM_EVENT_RING];
+            size_t written = format_event(sub, event, buf + len, capacity - len);
+            if (written == 0) {
+                break;
+            }
+            len += written;
+            sub->event_cursor++;
+        }
+    }
+
+    if (sub->queue_count > 0 &&
+        (sub->filter.min_interval_ms == 0 || now_ms - sub->last_batch_ms >= sub->filter.min_interval_ms)) {
+        bool any = false;
+        while (sub->queue_count > 0) {
+            size_t written = format_register_batch(sub, buf + len, capacity - len);
+            if (written == 0) {
+                break;
+            }
+            len += written;
+            any = true;
+        }
+        if (any) {
+            sub->last_batch_ms = now_ms;
+        }
+    }
+
+    if (len == 0 && now_ms - sub->last_output_ms >= TELEMETRY_STREAM_HEARTBEAT_MS) {
+        if (sub->filter.format == TELEMETRY_STREAM_FORMAT_SSE) {
+            len = append_record(capacity, snprintf(buf, capacity, ": heartbeat %llu\n\n",
+                                                   (unsigned long long)now_ms));
+        } else {
+            len = append_record(capacity, snprintf(buf, capacity, "{\"type\":\"heartbeat\",\"timestamp\":%llu}\n",
+                                                   (unsigned long long)now_ms));
+        }
+    }
+    if (len > 0) {
+        sub->last_output_ms = now_ms;
+    }
+    pthread_mutex_unlock(&g_stream_mutex);
+    return len;
+}
+
+hal_status_t telemetry_stream_get_stats(telemetry_stream_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_stream_mutex);
+    *stats = g_stream.stats;
+    pthread_mutex_unlock(&g_stream_mutex);
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file telemetry_stream.h
+ * @brief Server-push telemetry stream fed from register cache changes
+ * @version 1.0.0
+ * @date 2025-02-12
+ * @team FW
+ *
+ * Each subscriber owns a small coalescing queue of register deltas: a
+ * register that changes again before it was sent only updates its queued
+ * value, and a full queue drops its oldest entry. Named events (system
+ * status, module discovery, ...) go through a shared ring read with a
+ * per-subscriber cursor. The transport pulls formatted SSE or NDJSON
+ * records with telemetry_stream_read() after the notify callback fires.
+ */
+
+#ifndef TELEMETRY_STREAM_H
+#define TELEMETRY_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Stream limits
+#define TELEMETRY_STREAM_MAX_SUBSCRIBERS    8
+#define TELEMETRY_STREAM_QUEUE_DEPTH        128     // Coalesced register deltas per subscriber
+#define TELEMETRY_STREAM_MAX_REGISTERS      32      // Register filter entries
+#define TELEMETRY_STREAM_EVENT_RING         32
+#define TELEMETRY_STREAM_EVENT_NAME_MAX     32
+#define TELEMETRY_STREAM_EVENT_JSON_MAX     2048    // Compacted event payload
+#define TELEMETRY_STREAM_HEARTBEAT_MS       10000
+
+typedef enum {
+    TELEMETRY_STREAM_FORMAT_SSE = 0,        // text/event-stream
+    TELEMETRY_STREAM_FORMAT_NDJSON          // application/x-ndjson
+} telemetry_stream_format_t;
+
+typedef struct {
+    telemetry_stream_format_t format;
+    bool all_modules;
+    uint8_t module_mask[32];                // Bitmap of module addresses when !all_modules
+    uint16_t registers[TELEMETRY_STREAM_MAX_REGISTERS];
+    uint32_t register_count;                // 0 means every register
+    uint32_t min_interval_ms;               // Register batches are sent at most this often
+    bool include_events;
+} telemetry_stream_filter_t;
+
+typedef struct {
+    uint32_t subscribers;
+    uint64_t deltas_queued;
+    uint64_t deltas_coalesced;              // Overwrote a value still waiting in a queue
+    uint64_t deltas_dropped;                // Oldest entry evicted from a full queue
+    uint64_t events_published;
+    uint64_t events_dropped;                // Too large, or overrun before a subscriber read it
+} telemetry_stream_stats_t;
+
+/**
+ * @brief Data is pending for a subscriber (called with the stream lock held, must not block)
+ */
+typedef void (*telemetry_stream_notify_t)(void *notify_ctx);
+
+/**
+ * @brief Initialize the stream registry
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_init(void);
+
+/**
+ * @brief Drop every subscriber and queued data
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_deinit(void);
+
+/**
+ * @brief Parse a query string such as "modules=2,3&registers=0x40&interval_ms=100&format=ndjson&events=1"
+ * @param query Query string without the leading '?' (NULL or empty selects the defaults)
+ * @param filter Output filter
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_parse_filter(const char *query, telemetry_stream_filter_t *filter);
+
+/**
+ * @brief Open a subscription
+ * @param filter Subscription filter
+ * @param notify Called when data becomes pending (may be NULL)
+ * @param notify_ctx Passed to notify
+ * @param subscriber_id Receives the subscription handle
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_subscribe(const telemetry_stream_filter_t *filter, telemetry_stream_notify_t notify,
+                                        void *notify_ctx, uint32_t *subscriber_id);
+
+/**
+ * @brief Close a subscription; notify is never called for it afterwards
+ * @param subscriber_id Subscription handle
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_unsubscribe(uint32_t subscriber_id);
+
+/**
+ * @brief Register cache change listener (see register_cache_set_change_listener)
+ * @param module_addr Module address
+ * @param start_addr First changed register
+ * @param values New values
+ * @param count Number of registers
+ * @param timestamp_ms Store timestamp
+ * @param user_data Unused
+ */
+void telemetry_stream_on_registers(uint8_t module_addr, uint16_t start_addr, const uint16_t *values,
+                                   uint16_t count, uint64_t timestamp_ms, void *user_data);
+
+/**
+ * @brief Publish a named event to subscribers that asked for events
+ * @param name Event name
+ * @param json JSON payload, whitespace outside strings is removed
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_publish_event(const char *name, const char *json);
+
+/**
+ * @brief Format pending records for a subscriber
+ * @param subscriber_id Subscription handle
+ * @param buf Output buffer
+ * @param capacity Size of buf
+ * @return Bytes written, 0 when nothing is due
+ */
+size_t telemetry_stream_read(uint32_t subscriber_id, char *buf, size_t capacity);
+
+/**
+ * @brief Get stream counters
+ * @param stats Output statistics
+ * @return HAL status
+ */
+hal_status_t telemetry_stream_get_stats(telemetry_stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEMETRY_STREAM_H
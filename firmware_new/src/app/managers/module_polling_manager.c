@@ -9,7 +9,7 @@
  */
 
 #include "module_polling_manager.h"
-#include "communication_manager.h"
+#include "../infrastructure/communication/modbus_bus_master.h"
 #include "power_module_handler.h"
 #include "travel_motor_module_handler.h"
 #include "system_state_machine.h"
@@ -25,7 +25,6 @@
 static module_polling_manager_t g_polling_manager = {0};
 
 // Internal function prototypes
-static uint64_t module_polling_get_timestamp_ms(void);
 static hal_status_t module_polling_initialize_handler(uint8_t address, module_polling_type_t type);
 static bool module_polling_should_poll(uint8_t address);
 static hal_status_t module_polling_smart_read(uint8_t address, uint16_t start_reg, uint16_t count, uint16_t *data, const char *module_name);
@@ -80,7 +79,7 @@ hal_status_t module_polling_manager_update(void)
         return HAL_STATUS_OK;
     }
     
-    uint64_t current_time = module_polling_get_timestamp_ms();
+    uint64_t current_time = hal_time_now_ms();
     
     // Poll all online modules
     for (int i = 0; i <= 0xFF; i++) {  // Use 0xFF instead of MODULE_ADDR_MAX
@@ -446,7 +445,7 @@ hal_status_t module_polling_sensor_module(uint8_t address)
     
     // Strategy 1: Try to read system registers first (0x0100-0x0107)
     uint16_t system_data[8];
-    hal_status_t status = comm_manager_modbus_read_holding_registers(address, 0x0100, 8, system_data);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_SAFETY, address, 0x0100, 8, system_data);
     
     if (status == HAL_STATUS_OK) {
         printf("[POLLING-SAFETY] 0x%02X: DeviceID=0x%04X, Type=0x%04X, Status=0x%04X, Version=0x%04X\n",
@@ -454,7 +453,7 @@ hal_status_t module_polling_sensor_module(uint8_t address)
         
         // Strategy 2: Try to read safety-specific registers (0x0000-0x0053)
         uint16_t safety_data[8];
-        hal_status_t safety_status = comm_manager_modbus_read_holding_registers(address, 0x0000, 8, safety_data);
+        hal_status_t safety_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_SAFETY, address, 0x0000, 8, safety_data);
         
         if (safety_status == HAL_STATUS_OK) {
             printf("[POLLING-SAFETY] 0x%02X: EStop=%d, Interlock=%d, Zone1=%d, Zone2=%d, Zone3=%d, Zone4=%d, Zone5=%d, Zone6=%d\n",
@@ -482,7 +481,7 @@ hal_status_t module_polling_dock_module(uint8_t address)
     
     // Strategy 1: Try to read system registers first (0x0100-0x0107)
     uint16_t system_data[8];
-    hal_status_t status = comm_manager_modbus_read_holding_registers(address, 0x0100, 8, system_data);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, 0x0100, 8, system_data);
     
     if (status == HAL_STATUS_OK) {
         printf("[POLLING-DOCK] 0x%02X: DeviceID=0x%04X, Type=0x%04X, Status=0x%04X, Version=0x%04X\n",
@@ -493,7 +492,7 @@ hal_status_t module_polling_dock_module(uint8_t address)
         
         // Strategy 2: Poll RFID data every 100ms (registers 0x0108-0x010C) - REAL HARDWARE ADDRESSES
         uint16_t rfid_data[5];
-        hal_status_t rfid_status = comm_manager_modbus_read_holding_registers(address, 0x0108, 5, rfid_data);
+        hal_status_t rfid_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, 0x0108, 5, rfid_data);
         
         if (rfid_status == HAL_STATUS_OK) {
             uint32_t tag_id = ((uint32_t)rfid_data[1] << 16) | rfid_data[0];
@@ -508,7 +507,7 @@ hal_status_t module_polling_dock_module(uint8_t address)
         
         // Strategy 3: Poll accelerometer data every 50ms (registers 0x010D-0x0111) - REAL HARDWARE ADDRESSES
         uint16_t accel_data[5];
-        hal_status_t accel_status = comm_manager_modbus_read_holding_registers(address, 0x010D, 5, accel_data);
+        hal_status_t accel_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, 0x010D, 5, accel_data);
         
         if (accel_status == HAL_STATUS_OK) {
             printf("[POLLING-DOCK] 0x%02X: Accel X=%d, Y=%d, Z=%d mg, Temp=%d°C, Status=%d\n",
@@ -520,7 +519,7 @@ hal_status_t module_polling_dock_module(uint8_t address)
         
         // Strategy 4: Poll proximity sensors every 50ms (registers 0x0112-0x0116) - REAL HARDWARE ADDRESSES
         uint16_t prox_data[5];
-        hal_status_t prox_status = comm_manager_modbus_read_holding_registers(address, 0x0112, 5, prox_data);
+        hal_status_t prox_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, 0x0112, 5, prox_data);
         
         if (prox_status == HAL_STATUS_OK) {
             printf("[POLLING-DOCK] 0x%02X: Prox1=%d (digital), Prox2=%d (digital), Dist1=%dmm, Dist2=%dmm, DockConfirmed=%d\n",
@@ -531,7 +530,7 @@ hal_status_t module_polling_dock_module(uint8_t address)
         
         // Strategy 5: Read dock status and position (registers 0x0104-0x0107)
         uint16_t dock_data[4];
-        hal_status_t dock_status = comm_manager_modbus_read_holding_registers(address, 0x0104, 4, dock_data);
+        hal_status_t dock_status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, 0x0104, 4, dock_data);
         
         if (dock_status == HAL_STATUS_OK) {
             printf("[POLLING-DOCK] 0x%02X: Position=%d, Target=%d, Status=%d, Accuracy=%d\n",
@@ -558,7 +557,7 @@ hal_status_t module_polling_unknown_module(uint8_t address)
     
     // Read basic module data
     uint16_t basic_data[2];
-    hal_status_t status = comm_manager_modbus_read_holding_registers(address, 0x0100, 2, basic_data);
+    hal_status_t status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, 0x0100, 2, basic_data);
     
     if (status == HAL_STATUS_OK) {
         printf("[POLLING-UNKNOWN] 0x%02X: DeviceID=0x%04X, Status=0x%04X\n",
@@ -606,17 +605,6 @@ uint32_t module_polling_get_interval(module_polling_type_t type)
 
 // Internal functions
 
-/**
- * @brief Get current timestamp in milliseconds
- * @return Timestamp in milliseconds
- */
-static uint64_t module_polling_get_timestamp_ms(void)
-{
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)(ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000ULL);
-}
-
 /**
  * @brief Initialize handler for module type
  * @param address Module address
@@ -646,7 +634,7 @@ static bool module_polling_should_poll(uint8_t address)
         return false;
     }
     
-    uint64_t current_time = module_polling_get_timestamp_ms();
+    uint64_t current_time = hal_time_now_ms();
     uint64_t last_poll = g_polling_manager.modules[address].last_poll_ms;
     uint32_t interval = g_polling_manager.modules[address].poll_interval_ms;
     
@@ -675,7 +663,7 @@ static hal_status_t module_polling_smart_read(uint8_t address, uint16_t start_re
     hal_status_t status = HAL_STATUS_ERROR;
     
     for (int retry = 0; retry < max_retries; retry++) {
-        status = comm_manager_modbus_read_holding_registers(address, start_reg, count, data);
+        status = modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, address, start_reg, count, data);
         
         if (status == HAL_STATUS_OK) {
             // FIXED: Use enhanced validation for issue #135
@@ -690,8 +678,9 @@ static hal_status_t module_polling_smart_read(uint8_t address, uint16_t start_re
             }
         } else {
             if (retry < max_retries - 1) {
+                // No back-off sleep: comm_manager already retries, and this may run on
+                // the bus thread where sleeping would stall queued SAFETY work
                 printf("[POLLING-%s] 0x%02X: Read failed, retrying... (%d/%d)\n", module_name, address, retry + 1, max_retries);
-                usleep(100000); // Wait 100ms before retry
             }
         }
     }
@@ -8,6 +8,7 @@
  */
 
 #include "module_data_storage.h"
+#include "timeseries_store.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +27,7 @@ static void module_data_storage_initialize_module(int module_id);
 static bool module_data_storage_is_valid_module_id(int module_id);
 static void module_data_storage_cleanup_old_telemetry_records(int module_id);
 static void module_data_storage_cleanup_old_command_records(int module_id);
+static void module_data_storage_record_telemetry(int module_id, const module_telemetry_storage_t *telemetry);
 
 /**
  * @brief Initialize Module Data Storage System
@@ -125,6 +127,9 @@ hal_status_t module_data_storage_update_telemetry(int module_id, const module_te
     
     pthread_mutex_unlock(&g_storage_mutex);
     
+    // Persistent history for /history; the ring above only keeps the recent past
+    module_data_storage_record_telemetry(module_id, telemetry);
+    
     hal_log_message(HAL_LOG_LEVEL_DEBUG, "Module Data Storage: Updated telemetry for module %d", module_id);
     return HAL_STATUS_OK;
 }
@@ -662,6 +667,10 @@ static bool module_data_storage_is_valid_module_id(int module_id) {
 
 /**
  * @brief Cleanup Old Telemetry Records
+ *
+ * Records are written in time order, so expired ones are always at the
+ * oldest end of the ring: trim from there and stop at the first live one.
+ *
  * @param module_id Module ID (0-24)
  */
 static void module_data_storage_cleanup_old_telemetry_records(int module_id) {
@@ -675,22 +684,26 @@ static void module_data_storage_cleanup_old_telemetry_records(int module_id) {
     
     // Remove old records (older than 24 hours)
     int removed_count = 0;
-    for (int i = 0; i < history->record_count; i++) {
-        int record_index = (history->current_index - history->record_count + i + MAX_HISTORY_RECORDS) % MAX_HISTORY_RECORDS;
-        if (history->records[record_index].timestamp < cleanup_threshold) {
-            memset(&history->records[record_index], 0, sizeof(module_telemetry_storage_t));
-            removed_count++;
+    while (history->record_count > 0) {
+        int oldest_index = (history->current_index - history->record_count + MAX_HISTORY_RECORDS) % MAX_HISTORY_RECORDS;
+        if (history->records[oldest_index].timestamp >= cleanup_threshold) {
+            history->oldest_timestamp = history->records[oldest_index].timestamp;
+            break;
         }
+        history->record_count--;
+        removed_count++;
     }
     
     if (removed_count > 0) {
-        history->record_count -= removed_count;
         hal_log_message(HAL_LOG_LEVEL_DEBUG, "Module Data Storage: Cleaned up %d old telemetry records for module %d", removed_count, module_id);
     }
 }
 
 /**
  * @brief Cleanup Old Command Records
+ *
+ * Same oldest-end trim as the telemetry ring.
+ *
  * @param module_id Module ID (0-24)
  */
 static void module_data_storage_cleanup_old_command_records(int module_id) {
@@ -704,16 +717,43 @@ static void module_data_storage_cleanup_old_command_records(int module_id) {
     
     // Remove old records (older than 7 days)
     int removed_count = 0;
-    for (int i = 0; i < history->record_count; i++) {
-        int record_index = (history->current_index - history->record_count + i + MAX_COMMAND_HISTORY) % MAX_COMMAND_HISTORY;
-        if (history->records[record_index].timestamp < cleanup_threshold) {
-            memset(&history->records[record_index], 0, sizeof(module_command_storage_t));
-            removed_count++;
+    while (history->record_count > 0) {
+        int oldest_index = (history->current_index - history->record_count + MAX_COMMAND_HISTORY) % MAX_COMMAND_HISTORY;
+        if (history->records[oldest_index].timestamp >= cleanup_threshold) {
+            history->oldest_timestamp = history->records[oldest_index].timestamp;
+            break;
         }
+        history->record_count--;
+        removed_count++;
     }
     
     if (removed_count > 0) {
-        history->record_count -= removed_count;
         hal_log_message(HAL_LOG_LEVEL_DEBUG, "Module Data Storage: Cleaned up %d old command records for module %d", removed_count, module_id);
     }
 }
+
+/**
+ * @brief Append a telemetry update to the time-series store (if it is open)
+ * @param module_id Module ID (0-24)
+ * @param telemetry Telemetry data
+ */
+static void module_data_storage_record_telemetry(int module_id, const module_telemetry_storage_t *telemetry) {
+    if (!ts_store_is_open()) {
+        return;
+    }
+    
+    const float fields[TS_TELEMETRY_FIELD_COUNT] = {
+        [TS_TELEMETRY_VOLTAGE] = telemetry->voltage,
+        [TS_TELEMETRY_CURRENT] = telemetry->current,
+        [TS_TELEMETRY_POWER] = telemetry->power,
+        [TS_TELEMETRY_TEMPERATURE] = telemetry->temperature,
+        [TS_TELEMETRY_EFFICIENCY] = telemetry->efficiency,
+        [TS_TELEMETRY_LOAD_PERCENTAGE] = telemetry->load_percentage
+    };
+    uint64_t timestamp_ms = hal_time_wall_ms();
+    
+    for (uint16_t field = 0; field < TS_TELEMETRY_FIELD_COUNT; field++) {
+        ts_series_key_t key = { (uint8_t)module_id, TS_SERIES_TELEMETRY, field };
+        (void)ts_store_append(key, timestamp_ms, fields[field]);
+    }
+}
\ No newline at end of file
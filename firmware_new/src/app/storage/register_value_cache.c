@@ -1,62 +1,201 @@
 /**
  * @file register_value_cache.c
  * @brief Register Value Cache System Implementation
- * @version 1.0.0
+ * @version 1.1.0
  * @date 2025-01-28
  * @author FW Team
+ *
+ * Values are stored directly indexed by register address: the high byte of
+ * the address selects a 256-register page from a shared pool, the low byte
+ * the slot inside it, so a lookup is two array accesses.
+ *
+ * Each module cache is protected by a sequence counter (seqlock). Stores are
+ * serialized by a writer mutex and bump the counter to odd while they run;
+ * readers never lock, they copy and retry if the counter moved. Polling on
+ * the bus thread is therefore never blocked by API readers.
  */
 
 #include "register_value_cache.h"
 #include <string.h>
 #include <stdio.h>
 #include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <sys/time.h>
 
+#define REGISTER_CACHE_PAGE_COUNT   (0x10000 / REGISTER_CACHE_PAGE_SIZE)
+#define REGISTER_CACHE_SPIN_LIMIT   64
+#define REGISTER_CACHE_CHANGE_WORDS  (REGISTER_CACHE_PAGE_SIZE / 32)
+
+// One page of 256 consecutive registers
+typedef struct {
+    uint16_t values[REGISTER_CACHE_PAGE_SIZE];
+    uint64_t timestamps[REGISTER_CACHE_PAGE_SIZE];
+    uint8_t valid[REGISTER_CACHE_PAGE_SIZE / 8];
+} register_cache_page_t;
+
+// Module register cache
+typedef struct {
+    atomic_uint seq;                                            // Odd while a store is in progress
+    _Atomic uint8_t page_index[REGISTER_CACHE_PAGE_COUNT];      // 0 = no page, else pool index + 1
+    uint16_t register_count;                                    // Number of cached registers
+    uint64_t last_update_ms;                                    // Last update timestamp
+    bool initialized;                                           // Has this module stored anything?
+} module_register_cache_t;
+
 // Global cache storage (indexed by module address 0-255)
 static module_register_cache_t g_module_cache[256];
 
-// Thread safety mutex
+// Shared page pool; pages stay with their module once assigned
+static register_cache_page_t g_page_pool[REGISTER_CACHE_MAX_PAGES];
+static uint16_t g_pages_used = 0;
+
+// Serializes writers (stores / clears); readers never take it
 static pthread_mutex_t g_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // Cache statistics
-static cache_statistics_t g_cache_stats = {0};
+static atomic_uint g_stat_stores;
+static atomic_uint g_stat_reads;
+static atomic_uint g_stat_hits;
+static atomic_uint g_stat_misses;
+static atomic_uint g_stat_retries;
 
 // Cache initialized flag
-static bool g_cache_initialized = false;
+static atomic_bool g_cache_initialized = false;
+
+// Change listener, set and read under g_cache_mutex, called after it is released
+static register_cache_change_listener_t g_change_listener = NULL;
+static void *g_change_listener_data = NULL;
 
 // Helper function to get current timestamp in milliseconds
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)(tv.tv_sec) * 1000ULL + (uint64_t)(tv.tv_usec) / 1000ULL;
+// Seqlock writer side (call with g_cache_mutex held)
+static void cache_write_begin(module_register_cache_t *cache) {
+    unsigned int seq = atomic_load_explicit(&cache->seq, memory_order_relaxed);
+    atomic_store_explicit(&cache->seq, seq + 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void cache_write_end(module_register_cache_t *cache) {
+    unsigned int seq = atomic_load_explicit(&cache->seq, memory_order_relaxed);
+    atomic_store_explicit(&cache->seq, seq + 1U, memory_order_release);
+}
+
+// Seqlock reader side: wait out a running store, then remember the counter
+static unsigned int cache_read_begin(module_register_cache_t *cache) {
+    unsigned int seq;
+    int spins = 0;
+    while ((seq = atomic_load_explicit(&cache->seq, memory_order_acquire)) & 1U) {
+        if (++spins >= REGISTER_CACHE_SPIN_LIMIT) {
+            sched_yield();
+            spins = 0;
+        }
+    }
+    return seq;
+}
+
+// True if a store ran during the read and the copy must be repeated
+static bool cache_read_retry(module_register_cache_t *cache, unsigned int seq) {
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&cache->seq, memory_order_relaxed) != seq) {
+        atomic_fetch_add_explicit(&g_stat_retries, 1U, memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+static register_cache_page_t* cache_page(module_register_cache_t *cache, uint16_t reg_addr) {
+    uint8_t index = atomic_load_explicit(&cache->page_index[reg_addr >> 8], memory_order_acquire);
+    return index ? &g_page_pool[index - 1U] : NULL;
+}
+
+// Get or assign the page holding reg_addr (writer only)
+static register_cache_page_t* cache_page_for_write(module_register_cache_t *cache, uint16_t reg_addr) {
+    register_cache_page_t *page = cache_page(cache, reg_addr);
+    if (page != NULL) {
+        return page;
+    }
+    if (g_pages_used >= REGISTER_CACHE_MAX_PAGES) {
+        return NULL;
+    }
+    
+    page = &g_page_pool[g_pages_used];
+    memset(page, 0, sizeof(*page));
+    g_pages_used++;
+    atomic_store_explicit(&cache->page_index[reg_addr >> 8], (uint8_t)g_pages_used, memory_order_release);
+    return page;
+}
+
+static bool page_slot_valid(const register_cache_page_t *page, uint8_t slot) {
+    return (page->valid[slot >> 3] & (uint8_t)(1U << (slot & 7U))) != 0;
+}
+
+// Copy valid entries in ascending address order (reader, inside a seqlock section)
+static uint16_t cache_copy_entries(module_register_cache_t *cache, register_value_entry_t *entries,
+                                   uint16_t max_entries) {
+    uint16_t copied = 0;
+    for (uint32_t hi = 0; hi < REGISTER_CACHE_PAGE_COUNT && copied < max_entries; hi++) {
+        uint8_t index = atomic_load_explicit(&cache->page_index[hi], memory_order_acquire);
+        if (index == 0) {
+            continue;
+        }
+        const register_cache_page_t *page = &g_page_pool[index - 1U];
+        for (uint32_t byte = 0; byte < sizeof(page->valid) && copied < max_entries; byte++) {
+            if (page->valid[byte] == 0) {
+                continue;
+            }
+            for (uint32_t bit = 0; bit < 8U && copied < max_entries; bit++) {
+                uint8_t slot = (uint8_t)(byte * 8U + bit);
+                if (!page_slot_valid(page, slot)) {
+                    continue;
+                }
+                entries[copied].address = (uint16_t)((hi << 8) | slot);
+                entries[copied].value = page->values[slot];
+                entries[copied].timestamp_ms = page->timestamps[slot];
+                entries[copied].valid = true;
+                copied++;
+            }
+        }
+    }
+    return copied;
 }
 
-// Helper function to find register entry in cache
-static register_value_entry_t* find_register_entry(module_register_cache_t *cache, uint16_t reg_addr) {
-    for (uint16_t i = 0; i < cache->register_count; i++) {
-        if (cache->registers[i].address == reg_addr && cache->registers[i].valid) {
-            return &cache->registers[i];
+// Invalidate every cached register of a module (writer, inside a seqlock section)
+static void cache_clear_locked(module_register_cache_t *cache) {
+    for (uint32_t hi = 0; hi < REGISTER_CACHE_PAGE_COUNT; hi++) {
+        uint8_t index = atomic_load_explicit(&cache->page_index[hi], memory_order_relaxed);
+        if (index != 0) {
+            memset(g_page_pool[index - 1U].valid, 0, sizeof(g_page_pool[index - 1U].valid));
         }
     }
-    return NULL;
+    cache->register_count = 0;
+    cache->last_update_ms = 0;
+    cache->initialized = false;
 }
 
 hal_status_t register_cache_init(void) {
     pthread_mutex_lock(&g_cache_mutex);
     
     // Initialize all module caches
-    memset(g_module_cache, 0, sizeof(g_module_cache));
     for (int i = 0; i < 256; i++) {
-        g_module_cache[i].module_address = (uint8_t)i;
-        g_module_cache[i].initialized = false;
-        g_module_cache[i].register_count = 0;
-        g_module_cache[i].last_update_ms = 0;
+        module_register_cache_t *cache = &g_module_cache[i];
+        atomic_store_explicit(&cache->seq, 0U, memory_order_relaxed);
+        for (uint32_t hi = 0; hi < REGISTER_CACHE_PAGE_COUNT; hi++) {
+            atomic_store_explicit(&cache->page_index[hi], 0U, memory_order_relaxed);
+        }
+        cache->register_count = 0;
+        cache->last_update_ms = 0;
+        cache->initialized = false;
     }
+    g_pages_used = 0;
     
     // Reset statistics
-    memset(&g_cache_stats, 0, sizeof(g_cache_stats));
+    atomic_store(&g_stat_stores, 0U);
+    atomic_store(&g_stat_reads, 0U);
+    atomic_store(&g_stat_hits, 0U);
+    atomic_store(&g_stat_misses, 0U);
+    atomic_store(&g_stat_retries, 0U);
     
-    g_cache_initialized = true;
+    atomic_store(&g_cache_initialized, true);
     
     pthread_mutex_unlock(&g_cache_mutex);
     
@@ -64,10 +203,18 @@ hal_status_t register_cache_init(void) {
     return HAL_STATUS_OK;
 }
 
+hal_status_t register_cache_set_change_listener(register_cache_change_listener_t listener, void *user_data) {
+    pthread_mutex_lock(&g_cache_mutex);
+    g_change_listener = listener;
+    g_change_listener_data = user_data;
+    pthread_mutex_unlock(&g_cache_mutex);
+    return HAL_STATUS_OK;
+}
+
 hal_status_t register_cache_deinit(void) {
     pthread_mutex_lock(&g_cache_mutex);
     
-    g_cache_initialized = false;
+    atomic_store(&g_cache_initialized, false);
     
     pthread_mutex_unlock(&g_cache_mutex);
     
@@ -76,156 +223,216 @@ hal_status_t register_cache_deinit(void) {
 }
 
 hal_status_t register_cache_store(uint8_t module_addr, uint16_t reg_addr, uint16_t value) {
-    if (!g_cache_initialized) {
+    if (!atomic_load(&g_cache_initialized)) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
+    return register_cache_store_batch(module_addr, reg_addr, &value, 1);
+}
+
+hal_status_t register_cache_store_batch(uint8_t module_addr, uint16_t start_addr,
+                                        const uint16_t *values, uint16_t count) {
+    if (!atomic_load(&g_cache_initialized) || values == NULL || count == 0 ||
+        (uint32_t)start_addr + count - 1U > 0xFFFFU) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
     pthread_mutex_lock(&g_cache_mutex);
     
     module_register_cache_t *cache = &g_module_cache[module_addr];
-    uint64_t timestamp = get_timestamp_ms();
+    uint64_t timestamp = hal_time_now_ms();
+    hal_status_t status = HAL_STATUS_OK;
+    uint16_t stored = 0;
+    uint32_t changed[REGISTER_CACHE_CHANGE_WORDS] = {0};   // Registers past the first 256 always count as changed
+    bool any_changed = false;
     
-    // Initialize module cache if needed
-    if (!cache->initialized) {
-        cache->initialized = true;
-        cache->register_count = 0;
-    }
+    cache_write_begin(cache);
+    
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t reg_addr = (uint16_t)(start_addr + i);
+        register_cache_page_t *page = cache_page_for_write(cache, reg_addr);
+        if (page == NULL) {
+            status = HAL_STATUS_ERROR;
+            break;
+        }
     
-    // Find existing entry or create new one
-    register_value_entry_t *entry = find_register_entry(cache, reg_addr);
+        uint8_t slot = (uint8_t)(reg_addr & 0xFFU);
+        if (!page_slot_valid(page, slot)) {
+            if (cache->register_count >= MAX_CACHED_REGISTERS_PER_MODULE) {
+                status = HAL_STATUS_ERROR;
+                break;
+            }
+            page->valid[slot >> 3] |= (uint8_t)(1U << (slot & 7U));
+            cache->register_count++;
+            page->values[slot] = (uint16_t)~values[i];     // First store is always a change
+        }
     
-    if (entry == NULL) {
-        // Create new entry
-        if (cache->register_count >= MAX_CACHED_REGISTERS_PER_MODULE) {
-            pthread_mutex_unlock(&g_cache_mutex);
-            printf("[CACHE] Warning: Cache full for module 0x%02X\n", module_addr);
-            return HAL_STATUS_ERROR;
+        if (page->values[slot] != values[i] && i < REGISTER_CACHE_PAGE_SIZE) {
+            changed[i >> 5] |= 1U << (i & 31U);
+            any_changed = true;
         }
-        
-        entry = &cache->registers[cache->register_count];
-        cache->register_count++;
+        page->values[slot] = values[i];
+        page->timestamps[slot] = timestamp;
+        stored++;
     }
     
-    // Update entry
-    entry->address = reg_addr;
-    entry->value = value;
-    entry->timestamp_ms = timestamp;
-    entry->valid = true;
+    if (stored > 0) {
+        cache->initialized = true;
+        cache->last_update_ms = timestamp;
+    }
     
-    // Update module timestamp
-    cache->last_update_ms = timestamp;
+    cache_write_end(cache);
     
-    // Update statistics
-    g_cache_stats.total_stores++;
+    register_cache_change_listener_t listener = g_change_listener;
+    void *listener_data = g_change_listener_data;
     
     pthread_mutex_unlock(&g_cache_mutex);
     
-    return HAL_STATUS_OK;
-}
-
-hal_status_t register_cache_store_batch(uint8_t module_addr, uint16_t start_addr, 
-                                        const uint16_t *values, uint16_t count) {
-    if (!g_cache_initialized || values == NULL || count == 0) {
-        return HAL_STATUS_INVALID_PARAMETER;
+    atomic_fetch_add_explicit(&g_stat_stores, stored, memory_order_relaxed);
+    if (status != HAL_STATUS_OK) {
+        printf("[CACHE] Warning: Cache full for module 0x%02X\n", module_addr);
     }
     
-    // Store each value individually (could be optimized but this is simple and thread-safe)
-    for (uint16_t i = 0; i < count; i++) {
-        hal_status_t status = register_cache_store(module_addr, start_addr + i, values[i]);
-        if (status != HAL_STATUS_OK) {
-            return status;
+    // Report each run of changed registers; unchanged polls stay silent
+    if (listener != NULL && (any_changed || stored > REGISTER_CACHE_PAGE_SIZE)) {
+        uint16_t i = 0;
+        while (i < stored) {
+            while (i < stored && i < REGISTER_CACHE_PAGE_SIZE && (changed[i >> 5] & (1U << (i & 31U))) == 0) {
+                i++;
+            }
+            uint16_t run_start = i;
+            while (i < stored && (i >= REGISTER_CACHE_PAGE_SIZE || (changed[i >> 5] & (1U << (i & 31U))) != 0)) {
+                i++;
+            }
+            if (i > run_start) {
+                listener(module_addr, (uint16_t)(start_addr + run_start), &values[run_start],
+                         (uint16_t)(i - run_start), timestamp, listener_data);
+            }
         }
     }
     
-    return HAL_STATUS_OK;
+    return status;
 }
 
-hal_status_t register_cache_get(uint8_t module_addr, uint16_t reg_addr, 
+hal_status_t register_cache_get(uint8_t module_addr, uint16_t reg_addr,
                                 uint16_t *value, uint64_t *timestamp_ms) {
-    if (!g_cache_initialized || value == NULL) {
+    if (!atomic_load(&g_cache_initialized) || value == NULL) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    pthread_mutex_lock(&g_cache_mutex);
-    
     module_register_cache_t *cache = &g_module_cache[module_addr];
+    uint8_t slot = (uint8_t)(reg_addr & 0xFFU);
+    bool found;
+    uint16_t cached_value = 0;
+    uint64_t cached_timestamp = 0;
+    
+    atomic_fetch_add_explicit(&g_stat_reads, 1U, memory_order_relaxed);
+    
+    unsigned int seq;
+    do {
+        seq = cache_read_begin(cache);
+        const register_cache_page_t *page = cache_page(cache, reg_addr);
+        found = page != NULL && page_slot_valid(page, slot);
+        if (found) {
+            cached_value = page->values[slot];
+            cached_timestamp = page->timestamps[slot];
+        }
+    } while (cache_read_retry(cache, seq));
     
-    g_cache_stats.total_reads++;
-    
-    if (!cache->initialized) {
-        g_cache_stats.cache_misses++;
-        pthread_mutex_unlock(&g_cache_mutex);
-        return HAL_STATUS_NOT_FOUND;
-    }
-    
-    register_value_entry_t *entry = find_register_entry(cache, reg_addr);
-    
-    if (entry == NULL) {
-        g_cache_stats.cache_misses++;
-        pthread_mutex_unlock(&g_cache_mutex);
+    if (!found) {
+        atomic_fetch_add_explicit(&g_stat_misses, 1U, memory_order_relaxed);
         return HAL_STATUS_NOT_FOUND;
     }
     
     // Found entry
-    *value = entry->value;
+    *value = cached_value;
     if (timestamp_ms != NULL) {
-        *timestamp_ms = entry->timestamp_ms;
+        *timestamp_ms = cached_timestamp;
     }
     
-    g_cache_stats.cache_hits++;
-    
-    pthread_mutex_unlock(&g_cache_mutex);
+    atomic_fetch_add_explicit(&g_stat_hits, 1U, memory_order_relaxed);
     
     return HAL_STATUS_OK;
 }
 
-hal_status_t register_cache_get_all(uint8_t module_addr, register_value_entry_t *entries, 
+hal_status_t register_cache_get_all(uint8_t module_addr, register_value_entry_t *entries,
                                     uint16_t max_entries, uint16_t *count) {
-    if (!g_cache_initialized || entries == NULL || count == NULL) {
+    if (!atomic_load(&g_cache_initialized) || entries == NULL || count == NULL) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    pthread_mutex_lock(&g_cache_mutex);
-    
     module_register_cache_t *cache = &g_module_cache[module_addr];
+    uint16_t copied;
     
-    if (!cache->initialized) {
-        *count = 0;
-        pthread_mutex_unlock(&g_cache_mutex);
-        return HAL_STATUS_OK;
-    }
+    unsigned int seq;
+    do {
+        seq = cache_read_begin(cache);
+        copied = cache_copy_entries(cache, entries, max_entries);
+    } while (cache_read_retry(cache, seq));
     
-    uint16_t num_entries = cache->register_count < max_entries ? cache->register_count : max_entries;
+    *count = copied;
     
-    // Copy valid entries
-    uint16_t copied = 0;
-    for (uint16_t i = 0; i < cache->register_count && copied < num_entries; i++) {
-        if (cache->registers[i].valid) {
-            entries[copied] = cache->registers[i];
-            copied++;
-        }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t register_cache_snapshot(uint8_t module_addr, register_cache_snapshot_t *snapshot) {
+    if (!atomic_load(&g_cache_initialized) || snapshot == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    *count = copied;
+    module_register_cache_t *cache = &g_module_cache[module_addr];
     
-    pthread_mutex_unlock(&g_cache_mutex);
+    unsigned int seq;
+    do {
+        seq = cache_read_begin(cache);
+        snapshot->count = cache_copy_entries(cache, snapshot->entries, MAX_CACHED_REGISTERS_PER_MODULE);
+        snapshot->last_update_ms = cache->last_update_ms;
+    } while (cache_read_retry(cache, seq));
+    
+    snapshot->module_address = module_addr;
+    snapshot->version = seq >> 1;
     
     return HAL_STATUS_OK;
 }
 
+bool register_cache_snapshot_find(const register_cache_snapshot_t *snapshot, uint16_t reg_addr,
+                                  uint16_t *value, uint64_t *timestamp_ms) {
+    if (snapshot == NULL || value == NULL) {
+        return false;
+    }
+    
+    int lo = 0;
+    int hi = (int)snapshot->count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        const register_value_entry_t *entry = &snapshot->entries[mid];
+        if (entry->address == reg_addr) {
+            *value = entry->value;
+            if (timestamp_ms != NULL) {
+                *timestamp_ms = entry->timestamp_ms;
+            }
+            return true;
+        }
+        if (entry->address < reg_addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return false;
+}
+
 hal_status_t register_cache_clear_module(uint8_t module_addr) {
-    if (!g_cache_initialized) {
+    if (!atomic_load(&g_cache_initialized)) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
     pthread_mutex_lock(&g_cache_mutex);
     
     module_register_cache_t *cache = &g_module_cache[module_addr];
-    
-    memset(cache->registers, 0, sizeof(cache->registers));
-    cache->register_count = 0;
-    cache->last_update_ms = 0;
-    cache->initialized = false;
+    cache_write_begin(cache);
+    cache_clear_locked(cache);
+    cache_write_end(cache);
     
     pthread_mutex_unlock(&g_cache_mutex);
     
@@ -234,17 +441,16 @@ hal_status_t register_cache_clear_module(uint8_t module_addr) {
 }
 
 hal_status_t register_cache_clear_all(void) {
-    if (!g_cache_initialized) {
+    if (!atomic_load(&g_cache_initialized)) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
     pthread_mutex_lock(&g_cache_mutex);
     
     for (int i = 0; i < 256; i++) {
-        g_module_cache[i].register_count = 0;
-        g_module_cache[i].last_update_ms = 0;
-        g_module_cache[i].initialized = false;
-        memset(g_module_cache[i].registers, 0, sizeof(g_module_cache[i].registers));
+        cache_write_begin(&g_module_cache[i]);
+        cache_clear_locked(&g_module_cache[i]);
+        cache_write_end(&g_module_cache[i]);
     }
     
     pthread_mutex_unlock(&g_cache_mutex);
@@ -254,52 +460,58 @@ hal_status_t register_cache_clear_all(void) {
 }
 
 bool register_cache_has_data(uint8_t module_addr) {
-    if (!g_cache_initialized) {
+    if (!atomic_load(&g_cache_initialized)) {
         return false;
     }
     
-    pthread_mutex_lock(&g_cache_mutex);
-    
-    bool has_data = g_module_cache[module_addr].initialized && 
-                    g_module_cache[module_addr].register_count > 0;
+    module_register_cache_t *cache = &g_module_cache[module_addr];
+    bool has_data;
     
-    pthread_mutex_unlock(&g_cache_mutex);
+    unsigned int seq;
+    do {
+        seq = cache_read_begin(cache);
+        has_data = cache->initialized && cache->register_count > 0;
+    } while (cache_read_retry(cache, seq));
     
     return has_data;
 }
 
 hal_status_t register_cache_get_statistics(cache_statistics_t *stats) {
-    if (!g_cache_initialized || stats == NULL) {
+    if (!atomic_load(&g_cache_initialized) || stats == NULL) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    pthread_mutex_lock(&g_cache_mutex);
-    
-    *stats = g_cache_stats;
-    
-    pthread_mutex_unlock(&g_cache_mutex);
+    memset(stats, 0, sizeof(*stats));
+    stats->total_stores = atomic_load_explicit(&g_stat_stores, memory_order_relaxed);
+    stats->total_reads = atomic_load_explicit(&g_stat_reads, memory_order_relaxed);
+    stats->cache_hits = atomic_load_explicit(&g_stat_hits, memory_order_relaxed);
+    stats->cache_misses = atomic_load_explicit(&g_stat_misses, memory_order_relaxed);
+    stats->read_retries = atomic_load_explicit(&g_stat_retries, memory_order_relaxed);
     
     return HAL_STATUS_OK;
 }
 
 hal_status_t register_cache_get_last_update(uint8_t module_addr, uint64_t *timestamp_ms) {
-    if (!g_cache_initialized || timestamp_ms == NULL) {
+    if (!atomic_load(&g_cache_initialized) || timestamp_ms == NULL) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    pthread_mutex_lock(&g_cache_mutex);
-    
     module_register_cache_t *cache = &g_module_cache[module_addr];
+    bool initialized;
+    uint64_t last_update;
+    
+    unsigned int seq;
+    do {
+        seq = cache_read_begin(cache);
+        initialized = cache->initialized;
+        last_update = cache->last_update_ms;
+    } while (cache_read_retry(cache, seq));
     
-    if (!cache->initialized) {
-        pthread_mutex_unlock(&g_cache_mutex);
+    if (!initialized) {
         return HAL_STATUS_NOT_FOUND;
     }
     
-    *timestamp_ms = cache->last_update_ms;
-    
-    pthread_mutex_unlock(&g_cache_mutex);
+    *timestamp_ms = last_update;
     
     return HAL_STATUS_OK;
 }
-
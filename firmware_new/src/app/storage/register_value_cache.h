@@ -22,6 +22,10 @@ extern "C" {
 // Maximum number of registers per module to cache
 #define MAX_CACHED_REGISTERS_PER_MODULE 256
 
+// Direct-indexed storage: register address high byte selects a page, low byte the slot
+#define REGISTER_CACHE_PAGE_SIZE        256
+#define REGISTER_CACHE_MAX_PAGES        32      // Shared page pool (two pages per module in practice)
+
 // Register value cache entry
 typedef struct {
     uint16_t address;           // Register address (0x0000-0xFFFF)
@@ -30,14 +34,14 @@ typedef struct {
     bool valid;                 // Is this cache entry valid?
 } register_value_entry_t;
 
-// Module register cache
+// Consistent copy of every cached register of one module
 typedef struct {
-    uint8_t module_address;                                     // Module address (0x00-0xFF)
-    register_value_entry_t registers[MAX_CACHED_REGISTERS_PER_MODULE];  // Cached register values
-    uint16_t register_count;                                    // Number of cached registers
-    uint64_t last_update_ms;                                    // Last update timestamp
-    bool initialized;                                           // Is this module cache initialized?
-} module_register_cache_t;
+    uint8_t module_address;                                         // Module address
+    uint16_t count;                                                 // Valid entries (ascending address)
+    uint32_t version;                                               // Module write version of this copy
+    uint64_t last_update_ms;                                        // Last update timestamp
+    register_value_entry_t entries[MAX_CACHED_REGISTERS_PER_MODULE];
+} register_cache_snapshot_t;
 
 // Cache statistics
 typedef struct {
@@ -46,14 +50,40 @@ typedef struct {
     uint32_t cache_hits;        // Successful reads
     uint32_t cache_misses;      // Failed reads (not found)
     uint32_t expired_entries;   // Expired cache entries
+    uint32_t read_retries;      // Reads repeated because a store ran concurrently
 } cache_statistics_t;
 
+/**
+ * @brief Called after a store with each run of registers whose value changed
+ * @param module_addr Module address
+ * @param start_addr First register of the run
+ * @param values New values of the run
+ * @param count Registers in the run
+ * @param timestamp_ms Store timestamp
+ * @param user_data Listener context
+ */
+typedef void (*register_cache_change_listener_t)(uint8_t module_addr, uint16_t start_addr,
+                                                 const uint16_t *values, uint16_t count,
+                                                 uint64_t timestamp_ms, void *user_data);
+
 /**
  * @brief Initialize register value cache system
  * @return HAL status
  */
 hal_status_t register_cache_init(void);
 
+/**
+ * @brief Set the change listener (one slot, NULL to clear)
+ *
+ * The listener runs on the storing thread after the cache lock is released,
+ * so it may read the cache but should not block.
+ *
+ * @param listener Listener function
+ * @param user_data Passed through to the listener
+ * @return HAL status
+ */
+hal_status_t register_cache_set_change_listener(register_cache_change_listener_t listener, void *user_data);
+
 /**
  * @brief Deinitialize register value cache system
  * @return HAL status
@@ -71,6 +101,9 @@ hal_status_t register_cache_store(uint8_t module_addr, uint16_t reg_addr, uint16
 
 /**
  * @brief Store multiple register values in cache (batch operation)
+ *
+ * The whole batch is published atomically: readers see either none or all of it.
+ *
  * @param module_addr Module address
  * @param start_addr Starting register address
  * @param values Array of values
@@ -92,7 +125,7 @@ hal_status_t register_cache_get(uint8_t module_addr, uint16_t reg_addr,
                                 uint16_t *value, uint64_t *timestamp_ms);
 
 /**
- * @brief Get all cached registers for a module
+ * @brief Get all cached registers for a module (ascending address)
  * @param module_addr Module address
  * @param entries Array to store register entries
  * @param max_entries Maximum number of entries to retrieve
@@ -102,6 +135,28 @@ hal_status_t register_cache_get(uint8_t module_addr, uint16_t reg_addr,
 hal_status_t register_cache_get_all(uint8_t module_addr, register_value_entry_t *entries, 
                                     uint16_t max_entries, uint16_t *count);
 
+/**
+ * @brief Take a consistent snapshot of every cached register of a module
+ *
+ * Lock-free for readers: the copy is retried if a store ran concurrently.
+ *
+ * @param module_addr Module address
+ * @param snapshot Output snapshot
+ * @return HAL status
+ */
+hal_status_t register_cache_snapshot(uint8_t module_addr, register_cache_snapshot_t *snapshot);
+
+/**
+ * @brief Look up a register in a snapshot (binary search)
+ * @param snapshot Snapshot
+ * @param reg_addr Register address
+ * @param value Pointer to store value
+ * @param timestamp_ms Pointer to store timestamp (optional, can be NULL)
+ * @return true if the register is in the snapshot
+ */
+bool register_cache_snapshot_find(const register_cache_snapshot_t *snapshot, uint16_t reg_addr,
+                                  uint16_t *value, uint64_t *timestamp_ms);
+
 /**
  * @brief Clear all cached values for a module
  * @param module_addr Module address
@@ -0,0 +1,1305 @@
+/**
+ * @file timeseries_store.c
+ * @brief Append-only on-disk time-series store implementation
+ * @version 1.0.0
+ * @date 2025-02-25
+ * @author FW Team
+ *
+ * On disk, in the store directory:
+ *   index.tsi        fixed-size ring of 64-byte block entries, mmap'd
+ *   seg-NNNNNNNN.tsd  segment files of blocks, each a header and two columns
+ *
+ * Blocks are appended to the newest segment; the index is only advanced
+ * after the segment data is synced, so a crash leaves at worst unindexed
+ * bytes at the end of the newest segment, which are cut off on reopen.
+ * Segments are dropped oldest first: the index tail moves past their
+ * entries, then the file is unlinked.
+ *
+ * Two locks: g_ts_mutex guards the in-RAM state (open blocks, pending
+ * buffers, index ring) and is only held for memory work, so appends from
+ * the bus thread never wait for the disk. g_ts_io_mutex serialises the
+ * writers of segment files (flush, retention, close) and is taken first.
+ */
+
+#include "timeseries_store.h"
+#include "hal_modbus_crc.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TS_BLOCK_MAGIC          0x31425354U     // "TSB1"
+#define TS_INDEX_MAGIC          0x31495354U     // "TSI1"
+#define TS_INDEX_VERSION        1U
+#define TS_PENDING_BYTES        32768U
+#define TS_PENDING_BLOCKS       128U
+#define TS_MAX_TS_BYTES         10U             // Largest encoded timestamp
+#define TS_MAX_VALUE_BYTES      6U              // Largest encoded value
+#define TS_MAINTAIN_PERIOD_MS   1000U
+#define TS_SERIES_MASK          (TS_STORE_MAX_SERIES - 1U)
+
+_Static_assert((TS_STORE_MAX_SERIES & TS_SERIES_MASK) == 0, "TS_STORE_MAX_SERIES must be a power of two");
+
+// Block header in a segment file, followed by the timestamp and value columns
+typedef struct {
+    uint32_t magic;
+    uint8_t module;
+    uint8_t kind;
+    uint16_t id;
+    uint16_t count;
+    uint16_t ts_bytes;
+    uint16_t value_bytes;
+    uint16_t crc;                   // CRC16 over both columns
+    uint64_t first_ms;
+} ts_block_header_t;
+
+#define TS_BLOCK_MAX_BYTES      (sizeof(ts_block_header_t) + 2U * TS_STORE_COLUMN_BYTES)
+
+// Index entry: where a block is and what it holds
+typedef struct {
+    uint32_t segment;
+    uint32_t offset;
+    uint32_t length;
+    uint8_t module;
+    uint8_t kind;
+    uint16_t id;
+    uint16_t count;
+    uint16_t reserved0;
+    uint32_t reserved1;
+    uint64_t first_ms;
+    uint64_t last_ms;
+    float min;
+    float max;
+    double sum;
+    uint64_t reserved2;
+} ts_index_entry_t;
+
+_Static_assert(sizeof(ts_block_header_t) == 24, "ts_block_header_t is an on-disk format");
+_Static_assert(sizeof(ts_index_entry_t) == 64, "ts_index_entry_t is an on-disk format");
+
+// Index file header; head and tail count entries since the index was created
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t entry_size;
+    uint64_t head;
+    uint64_t tail;
+    uint32_t first_segment;
+    uint32_t active_segment;
+    uint8_t reserved[24];
+} ts_index_header_t;
+
+_Static_assert(sizeof(ts_index_header_t) == 64, "ts_index_header_t is an on-disk format");
+
+// Open block of one series, compressed as samples arrive
+typedef struct {
+    ts_series_key_t key;
+    bool used;
+    uint16_t count;
+    uint16_t ts_bytes;
+    uint16_t value_bytes;
+    uint32_t last_bits;             // Register value, or float bits of the last telemetry sample
+    uint64_t first_ms;
+    uint64_t last_ms;
+    int64_t last_delta_ms;
+    float min;
+    float max;
+    double sum;
+    uint8_t ts_col[TS_STORE_COLUMN_BYTES];
+    uint8_t value_col[TS_STORE_COLUMN_BYTES];
+} ts_open_block_t;
+
+// Sealed blocks waiting to be written; entries[i].offset is the position in data
+typedef struct {
+    uint8_t data[TS_PENDING_BYTES];
+    uint32_t bytes;
+    uint16_t count;
+    ts_index_entry_t entries[TS_PENDING_BLOCKS];
+} ts_pending_t;
+
+// Downsampling accumulator of a query
+typedef struct {
+    ts_point_t *points;
+    uint32_t max_points;
+    uint32_t count;
+    uint64_t from_ms;
+    uint64_t to_ms;
+    uint64_t bucket_ms;
+    bool active;
+    uint64_t bucket;
+    float min;
+    float max;
+    double sum;
+    uint32_t n;
+} ts_query_acc_t;
+
+// Location of an indexed block, copied out for a query
+typedef struct {
+    ts_index_entry_t entry;
+} ts_query_ref_t;
+
+static pthread_mutex_t g_ts_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_ts_io_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool g_ts_open = false;
+static ts_store_config_t g_ts_config;
+
+// In-RAM state (g_ts_mutex)
+static ts_open_block_t g_ts_series[TS_STORE_MAX_SERIES];
+static uint32_t g_ts_series_count;
+static ts_pending_t g_ts_pending[2];
+static uint8_t g_ts_fill;                       // Pending buffer taking sealed blocks
+static bool g_ts_inflight;                      // The other buffer is being written
+static ts_index_header_t *g_ts_index;
+static ts_index_entry_t *g_ts_entries;
+static ts_store_stats_t g_ts_stats;
+static uint64_t g_ts_last_maintain_ms;
+static uint64_t g_ts_last_flush_ms;
+
+// Segment files (g_ts_io_mutex)
+static int g_ts_index_fd = -1;
+static size_t g_ts_index_size;
+static int g_ts_segment_fd = -1;
+static uint64_t g_ts_segment_size[TS_STORE_MAX_SEGMENTS];
+static uint64_t g_ts_segment_newest[TS_STORE_MAX_SEGMENTS];
+static uint64_t g_ts_disk_bytes;
+
+static const char *const g_ts_field_names[TS_TELEMETRY_FIELD_COUNT] = {
+    "voltage", "current", "power", "temperature", "efficiency", "load_percentage"
+};
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+static uint16_t ts_put_varint(uint8_t *out, uint64_t v) {
+    uint16_t n = 0;
+    while (v >= 0x80U) {
+        out[n++] = (uint8_t)(v | 0x80U);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool ts_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v) {
+    uint64_t result = 0;
+    for (unsigned int shift = 0; *p < end && shift < 64U; shift += 7U) {
+        uint8_t b = *(*p)++;
+        result |= (uint64_t)(b & 0x7FU) << shift;
+        if ((b & 0x80U) == 0) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t ts_zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t ts_unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1U);
+}
+
+// Register series keep the raw 16-bit value, telemetry the float bits
+static uint32_t ts_value_bits(uint8_t kind, float value) {
+    if (kind == TS_SERIES_REGISTER) {
+        long v = lrintf(value);
+        return v < 0 ? 0U : (v > 0xFFFF ? 0xFFFFU : (uint32_t)v);
+    }
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float ts_bits_value(uint8_t kind, uint32_t bits) {
+    if (kind == TS_SERIES_REGISTER) {
+        return (float)bits;
+    }
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool ts_block_has_room(const ts_open_block_t *block) {
+    return block->count < TS_STORE_BLOCK_MAX_SAMPLES &&
+           block->ts_bytes + TS_MAX_TS_BYTES <= TS_STORE_COLUMN_BYTES &&
+           block->value_bytes + TS_MAX_VALUE_BYTES <= TS_STORE_COLUMN_BYTES;
+}
+
+/**
+ * @brief Compress one sample into an open block (caller checked the room)
+ *
+ * Timestamps: none for the first sample (it is in the header), the delta
+ * for the second, then delta-of-delta, all zig-zag varints; a steady poll
+ * period costs one byte. Register values: the first raw, then zig-zag
+ * deltas. Telemetry: the first as raw bits, then the XOR with the previous
+ * bits with its trailing zeros stripped, 0 for an unchanged value.
+ */
+static void ts_block_add(ts_open_block_t *block, uint64_t timestamp_ms, float value) {
+    uint32_t bits = ts_value_bits(block->key.kind, value);
+    float stored = ts_bits_value(block->key.kind, bits);
+
+    if (block->count == 0) {
+        block->first_ms = timestamp_ms;
+        block->last_delta_ms = 0;
+        block->value_bytes = ts_put_varint(block->value_col, bits);
+        block->min = stored;
+        block->max = stored;
+        block->sum = 0.0;
+    } else {
+        int64_t delta = (int64_t)(timestamp_ms - block->last_ms);
+        uint64_t encoded = block->count == 1 ? ts_zigzag(delta) : ts_zigzag(delta - block->last_delta_ms);
+        block->ts_bytes = (uint16_t)(block->ts_bytes + ts_put_varint(&block->ts_col[block->ts_bytes], encoded));
+        block->last_delta_ms = delta;
+
+        uint8_t *out = &block->value_col[block->value_bytes];
+        uint16_t n;
+        if (block->key.kind == TS_SERIES_REGISTER) {
+            n = ts_put_varint(out, ts_zigzag((int64_t)bits - (int64_t)block->last_bits));
+        } else {
+            uint32_t x = bits ^ block->last_bits;
+            if (x == 0) {
+                out[0] = 0;
+                n = 1;
+            } else {
+                unsigned int tz = (unsigned int)__builtin_ctz(x);
+                n = ts_put_varint(out, ((uint64_t)(x >> tz) << 5) | tz);
+            }
+        }
+        block->value_bytes = (uint16_t)(block->value_bytes + n);
+        if (stored < block->min) {
+            block->min = stored;
+        }
+        if (stored > block->max) {
+            block->max = stored;
+        }
+    }
+
+    block->last_ms = timestamp_ms;
+    block->last_bits = bits;
+    block->sum += stored;
+    block->count++;
+}
+
+/**
+ * @brief Decompress a block
+ * @return Samples decoded, -1 if the columns are malformed
+ */
+static int ts_block_decode(const ts_block_header_t *header, const uint8_t *columns,
+                           uint64_t *timestamps, float *values) {
+    if (header->count == 0 || header->count > TS_STORE_BLOCK_MAX_SAMPLES) {
+        return -1;
+    }
+
+    const uint8_t *tp = columns;
+    const uint8_t *tend = columns + header->ts_bytes;
+    const uint8_t *vp = tend;
+    const uint8_t *vend = tend + header->value_bytes;
+    uint64_t t = header->first_ms;
+    int64_t delta = 0;
+    uint64_t raw;
+
+    if (!ts_get_varint(&vp, vend, &raw) || raw > UINT32_MAX) {
+        return -1;
+    }
+    uint32_t bits = (uint32_t)raw;
+    timestamps[0] = t;
+    values[0] = ts_bits_value(header->kind, bits);
+
+    for (uint16_t i = 1; i < header->count; i++) {
+        if (!ts_get_varint(&tp, tend, &raw)) {
+            return -1;
+        }
+        delta = (i == 1) ? ts_unzigzag(raw) : delta + ts_unzigzag(raw);
+        t = (uint64_t)((int64_t)t + delta);
+
+        if (!ts_get_varint(&vp, vend, &raw)) {
+            return -1;
+        }
+        if (header->kind == TS_SERIES_REGISTER) {
+            bits = (uint32_t)((int64_t)bits + ts_unzigzag(raw));
+        } else if (raw != 0) {
+            bits ^= (uint32_t)((raw >> 5) << (raw & 31U));
+        }
+        timestamps[i] = t;
+        values[i] = ts_bits_value(header->kind, bits);
+    }
+    return header->count;
+}
+
+// Header and columns of an open block, as written to disk
+static uint32_t ts_block_serialize(const ts_open_block_t *block, uint8_t *out) {
+    ts_block_header_t header = {
+        .magic = TS_BLOCK_MAGIC,
+        .module = block->key.module,
+        .kind = block->key.kind,
+        .id = block->key.id,
+        .count = block->count,
+        .ts_bytes = block->ts_bytes,
+        .value_bytes = block->value_bytes,
+        .crc = 0,
+        .first_ms = block->first_ms
+    };
+    uint8_t *columns = out + sizeof(header);
+    memcpy(columns, block->ts_col, block->ts_bytes);
+    memcpy(columns + block->ts_bytes, block->value_col, block->value_bytes);
+    header.crc = modbus_crc16(columns, (size_t)block->ts_bytes + block->value_bytes);
+    memcpy(out, &header, sizeof(header));
+    return (uint32_t)(sizeof(header) + block->ts_bytes + block->value_bytes);
+}
+
+// ---------------------------------------------------------------------------
+// In-RAM state (call with g_ts_mutex held)
+// ---------------------------------------------------------------------------
+
+static bool ts_key_equal(ts_series_key_t a, ts_series_key_t b) {
+    return a.module == b.module && a.kind == b.kind && a.id == b.id;
+}
+
+static uint32_t ts_key_hash(ts_series_key_t key) {
+    uint32_t h = ((uint32_t)key.module << 24) ^ ((uint32_t)key.kind << 16) ^ key.id;
+    return (h * 2654435761U) >> 24;
+}
+
+static ts_open_block_t *ts_find_series(ts_series_key_t key, bool create) {
+    uint32_t slot = ts_key_hash(key) & TS_SERIES_MASK;
+    for (uint32_t probe = 0; probe < TS_STORE_MAX_SERIES; probe++) {
+        ts_open_block_t *block = &g_ts_series[(slot + probe) & TS_SERIES_MASK];
+        if (!block->used) {
+            if (!create) {
+                return NULL;
+            }
+            memset(block, 0, sizeof(*block));
+            block->key = key;
+            block->used = true;
+            g_ts_series_count++;
+            return block;
+        }
+        if (ts_key_equal(block->key, key)) {
+            return block;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Move an open block to the pending buffer
+ * @return false if the pending buffer is full
+ */
+static bool ts_seal(ts_open_block_t *block) {
+    if (block->count == 0) {
+        return true;
+    }
+
+    ts_pending_t *pending = &g_ts_pending[g_ts_fill];
+    if (pending->count >= TS_PENDING_BLOCKS || pending->bytes + TS_BLOCK_MAX_BYTES > TS_PENDING_BYTES) {
+        return false;
+    }
+
+    uint32_t length = ts_block_serialize(block, &pending->data[pending->bytes]);
+    ts_index_entry_t *entry = &pending->entries[pending->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->offset = pending->bytes;
+    entry->length = length;
+    entry->module = block->key.module;
+    entry->kind = block->key.kind;
+    entry->id = block->key.id;
+    entry->count = block->count;
+    entry->first_ms = block->first_ms;
+    entry->last_ms = block->last_ms;
+    entry->min = block->min;
+    entry->max = block->max;
+    entry->sum = block->sum;
+    pending->bytes += length;
+
+    block->count = 0;
+    block->ts_bytes = 0;
+    block->value_bytes = 0;
+    g_ts_stats.blocks_sealed++;
+    return true;
+}
+
+static hal_status_t ts_append_locked(ts_series_key_t key, uint64_t timestamp_ms, float value) {
+    ts_open_block_t *block = ts_find_series(key, true);
+    if (block == NULL) {
+        g_ts_stats.samples_dropped++;
+        return HAL_STATUS_NO_MEMORY;
+    }
+
+    // A block is one time-ordered run; a clock step back starts a new one
+    bool out_of_order = block->count > 0 && timestamp_ms < block->last_ms;
+    if ((out_of_order || !ts_block_has_room(block)) && !ts_seal(block)) {
+        g_ts_stats.samples_dropped++;
+        return HAL_STATUS_BUSY;
+    }
+
+    ts_block_add(block, timestamp_ms, value);
+    g_ts_stats.samples_appended++;
+    return HAL_STATUS_OK;
+}
+
+static uint32_t ts_index_used(void) {
+    return (uint32_t)(g_ts_index->head - g_ts_index->tail);
+}
+
+static ts_index_entry_t *ts_index_at(uint64_t n) {
+    return &g_ts_entries[n % g_ts_index->capacity];
+}
+
+// ---------------------------------------------------------------------------
+// Segment files (call with g_ts_io_mutex held)
+// ---------------------------------------------------------------------------
+
+static void ts_segment_path(uint32_t segment, char *path, size_t size) {
+    snprintf(path, size, "%s/seg-%08u.tsd", g_ts_config.directory, segment);
+}
+
+static hal_status_t ts_open_segment(uint32_t segment) {
+    char path[192];
+    ts_segment_path(segment, path, sizeof(path));
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        hal_log_message(HAL_LOG_LEVEL_ERROR, "Timeseries Store: cannot open %s: %s", path, strerror(errno));
+        return HAL_STATUS_IO_ERROR;
+    }
+    if (g_ts_segment_fd >= 0) {
+        close(g_ts_segment_fd);
+    }
+    g_ts_segment_fd = fd;
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Release the oldest segment: index entries first, then the file
+ */
+static void ts_drop_oldest_segment(void) {
+    uint32_t segment = g_ts_index->first_segment;
+    uint32_t slot = segment % TS_STORE_MAX_SEGMENTS;
+
+    pthread_mutex_lock(&g_ts_mutex);
+    while (g_ts_index->tail < g_ts_index->head && ts_index_at(g_ts_index->tail)->segment <= segment) {
+        g_ts_index->tail++;
+        g_ts_stats.blocks_dropped++;
+    }
+    g_ts_index->first_segment = segment + 1U;
+    g_ts_stats.segments_dropped++;
+    pthread_mutex_unlock(&g_ts_mutex);
+    msync(g_ts_index, sizeof(ts_index_header_t), MS_SYNC);
+
+    char path[192];
+    ts_segment_path(segment, path, sizeof(path));
+    unlink(path);
+    g_ts_disk_bytes -= g_ts_segment_size[slot];
+    g_ts_segment_size[slot] = 0;
+    g_ts_segment_newest[slot] = 0;
+}
+
+// Start the next segment file
+static hal_status_t ts_roll_segment(void) {
+    if (g_ts_segment_fd >= 0) {
+        fdatasync(g_ts_segment_fd);
+    }
+    if (g_ts_index->active_segment - g_ts_index->first_segment + 1U >= TS_STORE_MAX_SEGMENTS) {
+        ts_drop_oldest_segment();
+    }
+
+    uint32_t segment = g_ts_index->active_segment + 1U;
+    g_ts_segment_size[segment % TS_STORE_MAX_SEGMENTS] = 0;
+    g_ts_segment_newest[segment % TS_STORE_MAX_SEGMENTS] = 0;
+    hal_status_t status = ts_open_segment(segment);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+    pthread_mutex_lock(&g_ts_mutex);
+    g_ts_index->active_segment = segment;
+    pthread_mutex_unlock(&g_ts_mutex);
+    return HAL_STATUS_OK;
+}
+
+// Make room for n index entries by dropping whole segments
+static hal_status_t ts_reserve_index(uint32_t n) {
+    while (g_ts_index->capacity - ts_index_used() < n) {
+        if (g_ts_index->first_segment == g_ts_index->active_segment) {
+            hal_status_t status = ts_roll_segment();
+            if (status != HAL_STATUS_OK) {
+                return status;
+            }
+        }
+        ts_drop_oldest_segment();
+    }
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Write the pending buffer: segment data, sync, then index entries
+ */
+static hal_status_t ts_write_pending(void) {
+    pthread_mutex_lock(&g_ts_mutex);
+    ts_pending_t *pending = &g_ts_pending[g_ts_fill];
+    if (pending->count == 0) {
+        pthread_mutex_unlock(&g_ts_mutex);
+        return HAL_STATUS_OK;
+    }
+    // Appends continue into the other buffer; queries still see this one
+    g_ts_fill ^= 1U;
+    g_ts_inflight = true;
+    pthread_mutex_unlock(&g_ts_mutex);
+
+    uint32_t segments[TS_PENDING_BLOCKS];
+    uint32_t offsets[TS_PENDING_BLOCKS];
+    hal_status_t status = ts_reserve_index(pending->count);
+
+    // Contiguous runs of blocks go out in one write per segment
+    uint16_t i = 0;
+    while (status == HAL_STATUS_OK && i < pending->count) {
+        uint32_t slot = g_ts_index->active_segment % TS_STORE_MAX_SEGMENTS;
+        if (g_ts_segment_size[slot] > 0 &&
+            g_ts_segment_size[slot] + pending->entries[i].length > g_ts_config.segment_bytes) {
+            status = ts_roll_segment();
+            continue;
+        }
+
+        uint16_t run_end = i;
+        uint64_t size = g_ts_segment_size[slot];
+        while (run_end < pending->count &&
+               (run_end == i || size + pending->entries[run_end].length <= g_ts_config.segment_bytes)) {
+            segments[run_end] = g_ts_index->active_segment;
+            offsets[run_end] = (uint32_t)size;
+            size += pending->entries[run_end].length;
+            if (pending->entries[run_end].last_ms > g_ts_segment_newest[slot]) {
+                g_ts_segment_newest[slot] = pending->entries[run_end].last_ms;
+            }
+            run_end++;
+        }
+
+        size_t length = (size_t)(size - g_ts_segment_size[slot]);
+        ssize_t written = pwrite(g_ts_segment_fd, &pending->data[pending->entries[i].offset], length,
+                                 (off_t)g_ts_segment_size[slot]);
+        if (written != (ssize_t)length) {
+            hal_log_message(HAL_LOG_LEVEL_ERROR, "Timeseries Store: segment write failed: %s",
+                            written < 0 ? strerror(errno) : "short write");
+            status = HAL_STATUS_IO_ERROR;
+            break;
+        }
+        g_ts_disk_bytes += length;
+        g_ts_segment_size[slot] = size;
+        i = run_end;
+    }
+    if (status == HAL_STATUS_OK && fdatasync(g_ts_segment_fd) != 0) {
+        status = HAL_STATUS_IO_ERROR;
+    }
+
+    // Publish the entries and retire the buffer in one step, so a query sees each block once
+    pthread_mutex_lock(&g_ts_mutex);
+    if (status == HAL_STATUS_OK) {
+        for (uint16_t k = 0; k < pending->count; k++) {
+            ts_index_entry_t *entry = ts_index_at(g_ts_index->head);
+            *entry = pending->entries[k];
+            entry->segment = segments[k];
+            entry->offset = offsets[k];
+            g_ts_index->head++;
+        }
+        g_ts_stats.blocks_written += pending->count;
+        g_ts_stats.bytes_written += pending->bytes;
+        g_ts_stats.flushes++;
+    } else {
+        g_ts_stats.samples_dropped += pending->count;
+    }
+    pending->count = 0;
+    pending->bytes = 0;
+    g_ts_inflight = false;
+    pthread_mutex_unlock(&g_ts_mutex);
+
+    msync(g_ts_index, g_ts_index_size, MS_SYNC);
+    return status;
+}
+
+static void ts_apply_retention(uint64_t now_ms) {
+    uint64_t retention_ms = (uint64_t)g_ts_config.retention_hours * 3600000ULL;
+    while (g_ts_index->first_segment < g_ts_index->active_segment) {
+        uint32_t slot = g_ts_index->first_segment % TS_STORE_MAX_SEGMENTS;
+        bool expired = g_ts_segment_newest[slot] + retention_ms < now_ms;
+        if (!expired && g_ts_disk_bytes <= g_ts_config.max_bytes) {
+            break;
+        }
+        ts_drop_oldest_segment();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Open / close
+// ---------------------------------------------------------------------------
+
+static hal_status_t ts_make_directory(const char *directory) {
+    char path[sizeof(g_ts_config.directory)];
+    snprintf(path, sizeof(path), "%s", directory);
+    for (char *p = path + 1; ; p++) {
+        if (*p == '/' || *p == '\0') {
+            char c = *p;
+            *p = '\0';
+            if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+                return HAL_STATUS_IO_ERROR;
+            }
+            *p = c;
+            if (c == '\0') {
+                break;
+            }
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+// Remove segment files outside [first, active]: leftovers of an interrupted drop or write
+static void ts_remove_stray_segments(bool remove_all) {
+    DIR *dir = opendir(g_ts_config.directory);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        unsigned int segment;
+        char tail;
+        if (sscanf(ent->d_name, "seg-%8u.ts%c", &segment, &tail) != 2 || tail != 'd') {
+            continue;
+        }
+        if (remove_all || segment < g_ts_index->first_segment || segment > g_ts_index->active_segment) {
+            char path[192];
+            ts_segment_path(segment, path, sizeof(path));
+            unlink(path);
+        }
+    }
+    closedir(dir);
+}
+
+static hal_status_t ts_open_index(void) {
+    char path[192];
+    snprintf(path, sizeof(path), "%s/index.tsi", g_ts_config.directory);
+    g_ts_index_size = sizeof(ts_index_header_t) + (size_t)TS_STORE_INDEX_CAPACITY * sizeof(ts_index_entry_t);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return HAL_STATUS_IO_ERROR;
+    }
+    struct stat st;
+    bool fresh = fstat(fd, &st) != 0 || (size_t)st.st_size != g_ts_index_size;
+    if (fresh && ftruncate(fd, (off_t)g_ts_index_size) != 0) {
+        close(fd);
+        return HAL_STATUS_IO_ERROR;
+    }
+    void *map = mmap(NULL, g_ts_index_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return HAL_STATUS_IO_ERROR;
+    }
+
+    g_ts_index_fd = fd;
+    g_ts_index = (ts_index_header_t *)map;
+    g_ts_entries = (ts_index_entry_t *)((uint8_t *)map + sizeof(ts_index_header_t));
+
+    ts_index_header_t *h = g_ts_index;
+    if (fresh || h->magic != TS_INDEX_MAGIC || h->version != TS_INDEX_VERSION ||
+        h->capacity != TS_STORE_INDEX_CAPACITY || h->entry_size != sizeof(ts_index_entry_t) ||
+        h->head < h->tail || h->head - h->tail > h->capacity || h->active_segment < h->first_segment ||
+        h->active_segment - h->first_segment >= TS_STORE_MAX_SEGMENTS) {
+        if (!fresh) {
+            hal_log_message(HAL_LOG_LEVEL_WARNING, "Timeseries Store: index unreadable, starting empty");
+        }
+        memset(h, 0, sizeof(*h));
+        h->magic = TS_INDEX_MAGIC;
+        h->version = TS_INDEX_VERSION;
+        h->capacity = TS_STORE_INDEX_CAPACITY;
+        h->entry_size = sizeof(ts_index_entry_t);
+        ts_remove_stray_segments(true);
+        msync(h, sizeof(*h), MS_SYNC);
+    }
+    return HAL_STATUS_OK;
+}
+
+// Rebuild segment sizes and newest times; cut unindexed bytes off the newest segment
+static hal_status_t ts_recover_segments(void) {
+    ts_remove_stray_segments(false);
+    memset(g_ts_segment_size, 0, sizeof(g_ts_segment_size));
+    memset(g_ts_segment_newest, 0, sizeof(g_ts_segment_newest));
+    g_ts_disk_bytes = 0;
+
+    uint64_t active_end = 0;
+    for (uint64_t n = g_ts_index->tail; n < g_ts_index->head; n++) {
+        const ts_index_entry_t *entry = ts_index_at(n);
+        uint32_t slot = entry->segment % TS_STORE_MAX_SEGMENTS;
+        if (entry->last_ms > g_ts_segment_newest[slot]) {
+            g_ts_segment_newest[slot] = entry->last_ms;
+        }
+        if (entry->segment == g_ts_index->active_segment && entry->offset + entry->length > active_end) {
+            active_end = (uint64_t)entry->offset + entry->length;
+        }
+    }
+
+    for (uint32_t segment = g_ts_index->first_segment; segment <= g_ts_index->active_segment; segment++) {
+        char path[192];
+        struct stat st;
+        ts_segment_path(segment, path, sizeof(path));
+        uint64_t size = stat(path, &st) == 0 ? (uint64_t)st.st_size : 0U;
+        if (segment == g_ts_index->active_segment && size > active_end) {
+            if (truncate(path, (off_t)active_end) == 0) {
+                size = active_end;
+            }
+        }
+        g_ts_segment_size[segment % TS_STORE_MAX_SEGMENTS] = size;
+        g_ts_disk_bytes += size;
+    }
+    return ts_open_segment(g_ts_index->active_segment);
+}
+
+hal_status_t ts_store_get_default_config(ts_store_config_t *config) {
+    if (config == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(config, 0, sizeof(*config));
+    snprintf(config->directory, sizeof(config->directory), "%s", TS_STORE_DEFAULT_DIR);
+    config->segment_bytes = 256U * 1024U;
+    config->max_bytes = 8U * 1024U * 1024U;
+    config->retention_hours = 168;
+    config->flush_interval_ms = 60000;
+    config->max_block_age_ms = 600000;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t ts_store_open(const ts_store_config_t *config) {
+    if (config == NULL || config->directory[0] == '\0' || config->segment_bytes < TS_BLOCK_MAX_BYTES ||
+        config->max_bytes < config->segment_bytes ||
+        config->max_bytes / config->segment_bytes >= TS_STORE_MAX_SEGMENTS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_ts_io_mutex);
+    if (g_ts_open) {
+        pthread_mutex_unlock(&g_ts_io_mutex);
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+
+    g_ts_config = *config;
+    hal_status_t status = ts_make_directory(g_ts_config.directory);
+    if (status == HAL_STATUS_OK) {
+        status = ts_open_index();
+    }
+    if (status == HAL_STATUS_OK) {
+        status = ts_recover_segments();
+        if (status != HAL_STATUS_OK) {
+            munmap(g_ts_index, g_ts_index_size);
+            close(g_ts_index_fd);
+            g_ts_index = NULL;
+            g_ts_index_fd = -1;
+        }
+    }
+    if (status != HAL_STATUS_OK) {
+        pthread_mutex_unlock(&g_ts_io_mutex);
+        hal_log_message(HAL_LOG_LEVEL_ERROR, "Timeseries Store: cannot open %s", g_ts_config.directory);
+        return HAL_STATUS_IO_ERROR;
+    }
+
+    pthread_mutex_lock(&g_ts_mutex);
+    memset(g_ts_series, 0, sizeof(g_ts_series));
+    memset(&g_ts_stats, 0, sizeof(g_ts_stats));
+    g_ts_pending[0].count = 0;
+    g_ts_pending[0].bytes = 0;
+    g_ts_pending[1].count = 0;
+    g_ts_pending[1].bytes = 0;
+    g_ts_series_count = 0;
+    g_ts_fill = 0;
+    g_ts_inflight = false;
+    g_ts_last_maintain_ms = 0;
+    g_ts_last_flush_ms = 0;
+    g_ts_open = true;
+    uint32_t blocks = ts_index_used();
+    pthread_mutex_unlock(&g_ts_mutex);
+    pthread_mutex_unlock(&g_ts_io_mutex);
+
+    hal_log_message(HAL_LOG_LEVEL_INFO, "Timeseries Store: opened %s (%u blocks, %u segments, %llu bytes)",
+                    g_ts_config.directory, blocks,
+                    g_ts_index->active_segment - g_ts_index->first_segment + 1U,
+                    (unsigned long long)g_ts_disk_bytes);
+    return HAL_STATUS_OK;
+}
+
+// Seal every open block that fits; true if some are left for another round
+static bool ts_seal_all(void) {
+    for (uint32_t i = 0; i < TS_STORE_MAX_SERIES; i++) {
+        if (g_ts_series[i].used && !ts_seal(&g_ts_series[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+hal_status_t ts_store_flush(void) {
+    pthread_mutex_lock(&g_ts_io_mutex);
+    if (!g_ts_open) {
+        pthread_mutex_unlock(&g_ts_io_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    hal_status_t status;
+    bool more;
+    do {
+        pthread_mutex_lock(&g_ts_mutex);
+        more = ts_seal_all();
+        pthread_mutex_unlock(&g_ts_mutex);
+        status = ts_write_pending();
+    } while (more && status == HAL_STATUS_OK);
+
+    pthread_mutex_unlock(&g_ts_io_mutex);
+    return status;
+}
+
+hal_status_t ts_store_close(void) {
+    if (!ts_store_is_open()) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    hal_status_t status = ts_store_flush();
+
+    pthread_mutex_lock(&g_ts_io_mutex);
+    pthread_mutex_lock(&g_ts_mutex);
+    g_ts_open = false;
+    pthread_mutex_unlock(&g_ts_mutex);
+
+    if (g_ts_segment_fd >= 0) {
+        close(g_ts_segment_fd);
+        g_ts_segment_fd = -1;
+    }
+    msync(g_ts_index, g_ts_index_size, MS_SYNC);
+    munmap(g_ts_index, g_ts_index_size);
+    close(g_ts_index_fd);
+    g_ts_index = NULL;
+    g_ts_entries = NULL;
+    g_ts_index_fd = -1;
+    pthread_mutex_unlock(&g_ts_io_mutex);
+    return status;
+}
+
+bool ts_store_is_open(void) {
+    pthread_mutex_lock(&g_ts_mutex);
+    bool open_now = g_ts_open;
+    pthread_mutex_unlock(&g_ts_mutex);
+    return open_now;
+}
+
+// ---------------------------------------------------------------------------
+// Writes
+// ---------------------------------------------------------------------------
+
+static bool ts_key_valid(ts_series_key_t key) {
+    return key.kind == TS_SERIES_REGISTER ||
+           (key.kind == TS_SERIES_TELEMETRY && key.id < TS_TELEMETRY_FIELD_COUNT);
+}
+
+hal_status_t ts_store_append(ts_series_key_t key, uint64_t timestamp_ms, float value) {
+    if (!ts_key_valid(key) || !isfinite(value)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_ts_mutex);
+    hal_status_t status = g_ts_open ? ts_append_locked(key, timestamp_ms, value) : HAL_STATUS_NOT_INITIALIZED;
+    pthread_mutex_unlock(&g_ts_mutex);
+    return status;
+}
+
+hal_status_t ts_store_append_registers(uint8_t module_addr, uint16_t start_addr, const uint16_t *values,
+                                       uint16_t count, uint64_t timestamp_ms) {
+    if (values == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    hal_status_t status = HAL_STATUS_OK;
+    pthread_mutex_lock(&g_ts_mutex);
+    if (!g_ts_open) {
+        status = HAL_STATUS_NOT_INITIALIZED;
+    }
+    for (uint16_t i = 0; status == HAL_STATUS_OK && i < count; i++) {
+        ts_series_key_t key = { module_addr, TS_SERIES_REGISTER, (uint16_t)(start_addr + i) };
+        status = ts_append_locked(key, timestamp_ms, (float)values[i]);
+    }
+    pthread_mutex_unlock(&g_ts_mutex);
+    return status;
+}
+
+hal_status_t ts_store_maintain(uint64_t now_ms) {
+    pthread_mutex_lock(&g_ts_mutex);
+    if (!g_ts_open) {
+        pthread_mutex_unlock(&g_ts_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    if (now_ms >= g_ts_last_maintain_ms && now_ms - g_ts_last_maintain_ms < TS_MAINTAIN_PERIOD_MS) {
+        pthread_mutex_unlock(&g_ts_mutex);
+        return HAL_STATUS_OK;
+    }
+    g_ts_last_maintain_ms = now_ms;
+
+    // Slow series still reach the disk within max_block_age_ms
+    for (uint32_t i = 0; i < TS_STORE_MAX_SERIES; i++) {
+        ts_open_block_t *block = &g_ts_series[i];
+        if (block->used && block->count > 0 && now_ms >= block->first_ms &&
+            now_ms - block->first_ms >= g_ts_config.max_block_age_ms && !ts_seal(block)) {
+            break;
+        }
+    }
+
+    // Write on the interval, or early once the pending buffer is half full
+    const ts_pending_t *pending = &g_ts_pending[g_ts_fill];
+    bool flush = pending->count > 0 &&
+                 (now_ms < g_ts_last_flush_ms || now_ms - g_ts_last_flush_ms >= g_ts_config.flush_interval_ms ||
+                  pending->bytes >= TS_PENDING_BYTES / 2U || pending->count >= TS_PENDING_BLOCKS / 2U);
+    pthread_mutex_unlock(&g_ts_mutex);
+
+    hal_status_t status = HAL_STATUS_OK;
+    pthread_mutex_lock(&g_ts_io_mutex);
+    if (g_ts_open) {
+        if (flush) {
+            status = ts_write_pending();
+            g_ts_last_flush_ms = now_ms;
+        }
+        ts_apply_retention(now_ms);
+    }
+    pthread_mutex_unlock(&g_ts_io_mutex);
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+static void ts_acc_emit(ts_query_acc_t *acc) {
+    if (!acc->active) {
+        return;
+    }
+    acc->active = false;
+    if (acc->count >= acc->max_points) {
+        return;
+    }
+    ts_point_t *point = &acc->points[acc->count++];
+    point->timestamp_ms = acc->from_ms + acc->bucket * acc->bucket_ms;
+    point->min = acc->min;
+    point->max = acc->max;
+    point->avg = (float)(acc->sum / acc->n);
+    point->count = acc->n;
+}
+
+static bool ts_acc_full(const ts_query_acc_t *acc) {
+    return acc->count >= acc->max_points;
+}
+
+// Add n samples at timestamp_ms (or a block summarised by its first sample time)
+static void ts_acc_merge(ts_query_acc_t *acc, uint64_t timestamp_ms, float min, float max, double sum, uint32_t n) {
+    if (ts_acc_full(acc)) {
+        return;
+    }
+    if (acc->bucket_ms == 0) {
+        ts_point_t *point = &acc->points[acc->count++];
+        point->timestamp_ms = timestamp_ms;
+        point->min = min;
+        point->max = max;
+        point->avg = (float)(sum / n);
+        point->count = n;
+        return;
+    }
+
+    uint64_t bucket = (timestamp_ms - acc->from_ms) / acc->bucket_ms;
+    if (acc->active && bucket != acc->bucket) {
+        ts_acc_emit(acc);
+    }
+    if (!acc->active) {
+        acc->active = true;
+        acc->bucket = bucket;
+        acc->min = min;
+        acc->max = max;
+        acc->sum = 0.0;
+        acc->n = 0;
+    }
+    if (min < acc->min) {
+        acc->min = min;
+    }
+    if (max > acc->max) {
+        acc->max = max;
+    }
+    acc->sum += sum;
+    acc->n += n;
+}
+
+// Decode a block and add its samples that fall in the range
+static bool ts_acc_add_block(ts_query_acc_t *acc, const uint8_t *block, uint32_t length) {
+    ts_block_header_t header;
+    if (length < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, block, sizeof(header));
+    uint32_t columns = (uint32_t)header.ts_bytes + header.value_bytes;
+    if (header.magic != TS_BLOCK_MAGIC || sizeof(header) + columns != length ||
+        modbus_crc16(block + sizeof(header), columns) != header.crc) {
+        return false;
+    }
+
+    uint64_t timestamps[TS_STORE_BLOCK_MAX_SAMPLES];
+    float values[TS_STORE_BLOCK_MAX_SAMPLES];
+    int n = ts_block_decode(&header, block + sizeof(header), timestamps, values);
+    if (n < 0) {
+        return false;
+    }
+    for (int i = 0; i < n && !ts_acc_full(acc); i++) {
+        if (timestamps[i] >= acc->from_ms && timestamps[i] <= acc->to_ms) {
+            ts_acc_merge(acc, timestamps[i], values[i], values[i], values[i], 1);
+        }
+    }
+    return true;
+}
+
+// Append bytes to a growing buffer
+static bool ts_buffer_append(uint8_t **buffer, size_t *size, size_t *capacity, const void *data, size_t length) {
+    if (*size + length > *capacity) {
+        size_t grown = *capacity ? *capacity * 2U : 4096U;
+        while (grown < *size + length) {
+            grown *= 2U;
+        }
+        uint8_t *tmp = (uint8_t *)realloc(*buffer, grown);
+        if (tmp == NULL) {
+            return false;
+        }
+        *buffer = tmp;
+        *capacity = grown;
+    }
+    memcpy(*buffer + *size, data, length);
+    *size += length;
+    return true;
+}
+
+static bool ts_entry_matches(const ts_index_entry_t *entry, ts_series_key_t key, uint64_t from_ms, uint64_t to_ms) {
+    return entry->module == key.module && entry->kind == key.kind && entry->id == key.id &&
+           entry->last_ms >= from_ms && entry->first_ms <= to_ms;
+}
+
+// Copy the pending blocks of a series, length-prefixed
+static bool ts_copy_pending(const ts_pending_t *pending, ts_series_key_t key, uint64_t from_ms, uint64_t to_ms,
+                            uint8_t **buffer, size_t *size, size_t *capacity) {
+    for (uint16_t i = 0; i < pending->count; i++) {
+        const ts_index_entry_t *entry = &pending->entries[i];
+        if (ts_entry_matches(entry, key, from_ms, to_ms) &&
+            (!ts_buffer_append(buffer, size, capacity, &entry->length, sizeof(entry->length)) ||
+             !ts_buffer_append(buffer, size, capacity, &pending->data[entry->offset], entry->length))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+hal_status_t ts_store_query(ts_series_key_t key, uint64_t from_ms, uint64_t to_ms, uint64_t bucket_ms,
+                            ts_point_t *points, uint32_t max_points, uint32_t *count) {
+    if (points == NULL || count == NULL || max_points == 0 || to_ms < from_ms || !ts_key_valid(key)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *count = 0;
+
+    // Under the lock only copy what is needed: index entries, and the blocks still in RAM
+    uint8_t *refs = NULL;
+    size_t refs_size = 0;
+    size_t refs_capacity = 0;
+    uint8_t *memory = NULL;
+    size_t memory_size = 0;
+    size_t memory_capacity = 0;
+    bool ok = true;
+
+    pthread_mutex_lock(&g_ts_mutex);
+    if (!g_ts_open) {
+        pthread_mutex_unlock(&g_ts_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    for (uint64_t n = g_ts_index->tail; ok && n < g_ts_index->head; n++) {
+        const ts_index_entry_t *entry = ts_index_at(n);
+        if (ts_entry_matches(entry, key, from_ms, to_ms)) {
+            ok = ts_buffer_append(&refs, &refs_size, &refs_capacity, entry, sizeof(*entry));
+        }
+    }
+    if (ok && g_ts_inflight) {
+        ok = ts_copy_pending(&g_ts_pending[g_ts_fill ^ 1U], key, from_ms, to_ms, &memory, &memory_size, &memory_capacity);
+    }
+    if (ok) {
+        ok = ts_copy_pending(&g_ts_pending[g_ts_fill], key, from_ms, to_ms, &memory, &memory_size, &memory_capacity);
+    }
+    const ts_open_block_t *open_block = ts_find_series(key, false);
+    if (ok && open_block != NULL && open_block->count > 0 &&
+        open_block->last_ms >= from_ms && open_block->first_ms <= to_ms) {
+        uint8_t block[TS_BLOCK_MAX_BYTES];
+        uint32_t length = ts_block_serialize(open_block, block);
+        ok = ts_buffer_append(&memory, &memory_size, &memory_capacity, &length, sizeof(length)) &&
+             ts_buffer_append(&memory, &memory_size, &memory_capacity, block, length);
+    }
+    pthread_mutex_unlock(&g_ts_mutex);
+
+    if (!ok) {
+        free(refs);
+        free(memory);
+        return HAL_STATUS_NO_MEMORY;
+    }
+
+    ts_query_acc_t acc = {
+        .points = points,
+        .max_points = max_points,
+        .from_ms = from_ms,
+        .to_ms = to_ms,
+        .bucket_ms = bucket_ms
+    };
+    uint64_t corrupt = 0;
+
+    // Indexed blocks, oldest first; a block inside one bucket is merged from its summary
+    int fd = -1;
+    uint32_t fd_segment = 0;
+    size_t ref_count = refs_size / sizeof(ts_index_entry_t);
+    for (size_t r = 0; r < ref_count && !ts_acc_full(&acc); r++) {
+        ts_index_entry_t entry;
+        memcpy(&entry, refs + r * sizeof(entry), sizeof(entry));
+
+        if (bucket_ms > 0 && entry.first_ms >= from_ms && entry.last_ms <= to_ms &&
+            (entry.first_ms - from_ms) / bucket_ms == (entry.last_ms - from_ms) / bucket_ms) {
+            ts_acc_merge(&acc, entry.first_ms, entry.min, entry.max, entry.sum, entry.count);
+            continue;
+        }
+
+        if (fd < 0 || fd_segment != entry.segment) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            char path[192];
+            ts_segment_path(entry.segment, path, sizeof(path));
+            fd = open(path, O_RDONLY | O_CLOEXEC);
+            fd_segment = entry.segment;
+        }
+        uint8_t block[TS_BLOCK_MAX_BYTES];
+        // A segment dropped since the index was copied has expired; skip it
+        if (fd < 0 || entry.length > sizeof(block)) {
+            continue;
+        }
+        if (pread(fd, block, entry.length, (off_t)entry.offset) != (ssize_t)entry.length ||
+            !ts_acc_add_block(&acc, block, entry.length)) {
+            corrupt++;
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    // Then the blocks not yet on disk, oldest first
+    for (size_t pos = 0; pos + sizeof(uint32_t) <= memory_size && !ts_acc_full(&acc);) {
+        uint32_t length;
+        memcpy(&length, memory + pos, sizeof(length));
+        pos += sizeof(length);
+        (void)ts_acc_add_block(&acc, memory + pos, length);
+        pos += length;
+    }
+    ts_acc_emit(&acc);
+
+    free(refs);
+    free(memory);
+    if (corrupt > 0) {
+        pthread_mutex_lock(&g_ts_mutex);
+        g_ts_stats.corrupt_blocks += corrupt;
+        pthread_mutex_unlock(&g_ts_mutex);
+    }
+    *count = acc.count;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t ts_store_list_series(uint8_t module_addr, ts_series_key_t *keys, uint32_t max_keys, uint32_t *count) {
+    if (keys == NULL || count == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *count = 0;
+
+    // One bit per register address and per telemetry field
+    static uint8_t registers[0x10000 / 8];
+    uint8_t fields = 0;
+
+    pthread_mutex_lock(&g_ts_mutex);
+    if (!g_ts_open) {
+        pthread_mutex_unlock(&g_ts_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    memset(registers, 0, sizeof(registers));
+    for (uint64_t n = g_ts_index->tail; n < g_ts_index->head; n++) {
+        const ts_index_entry_t *entry = ts_index_at(n);
+        if (entry->module != module_addr) {
+            continue;
+        }
+        if (entry->kind == TS_SERIES_REGISTER) {
+            registers[entry->id >> 3] |= (uint8_t)(1U << (entry->id & 7U));
+        } else if (entry->id < TS_TELEMETRY_FIELD_COUNT) {
+            fields |= (uint8_t)(1U << entry->id);
+        }
+    }
+    // Series seen since the last write are in RAM only
+    for (uint32_t i = 0; i < TS_STORE_MAX_SERIES; i++) {
+        const ts_open_block_t *block = &g_ts_series[i];
+        if (!block->used || block->key.module != module_addr) {
+            continue;
+        }
+        if (block->key.kind == TS_SERIES_REGISTER) {
+            registers[block->key.id >> 3] |= (uint8_t)(1U << (block->key.id & 7U));
+        } else {
+            fields |= (uint8_t)(1U << block->key.id);
+        }
+    }
+
+    for (uint32_t id = 0; id < 0x10000U && *count < max_keys; id++) {
+        if (registers[id >> 3] & (1U << (id & 7U))) {
+            keys[(*count)++] = (ts_series_key_t){ module_addr, TS_SERIES_REGISTER, (uint16_t)id };
+        }
+    }
+    for (uint16_t id = 0; id < TS_TELEMETRY_FIELD_COUNT && *count < max_keys; id++) {
+        if (fields & (1U << id)) {
+            keys[(*count)++] = (ts_series_key_t){ module_addr, TS_SERIES_TELEMETRY, id };
+        }
+    }
+    pthread_mutex_unlock(&g_ts_mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t ts_store_get_stats(ts_store_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&g_ts_io_mutex);
+    pthread_mutex_lock(&g_ts_mutex);
+    if (!g_ts_open) {
+        pthread_mutex_unlock(&g_ts_mutex);
+        pthread_mutex_unlock(&g_ts_io_mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    *stats = g_ts_stats;
+    stats->disk_bytes = g_ts_disk_bytes;
+    stats->series = g_ts_series_count;
+    stats->segments = g_ts_index->active_segment - g_ts_index->first_segment + 1U;
+    stats->index_entries = ts_index_used();
+    stats->pending_bytes = g_ts_pending[0].bytes + g_ts_pending[1].bytes;
+    stats->oldest_ms = 0;
+    for (uint64_t n = g_ts_index->tail; n < g_ts_index->head; n++) {
+        const ts_index_entry_t *entry = ts_index_at(n);
+        if (stats->oldest_ms == 0 || entry->first_ms < stats->oldest_ms) {
+            stats->oldest_ms = entry->first_ms;
+        }
+    }
+    pthread_mutex_unlock(&g_ts_mutex);
+    pthread_mutex_unlock(&g_ts_io_mutex);
+    return HAL_STATUS_OK;
+}
+
+const char *ts_store_telemetry_field_name(ts_telemetry_field_t field) {
+    return (unsigned int)field < TS_TELEMETRY_FIELD_COUNT ? g_ts_field_names[field] : "unknown";
+}
@@ -0,0 +1,223 @@
+/**
+ * @file timeseries_store.h
+ * @brief Append-only on-disk time-series store for module register and telemetry history
+ * @version 1.0.0
+ * @date 2025-02-25
+ * @author FW Team
+ *
+ * Every series (one register or one telemetry field of one module) is
+ * collected in an open block in RAM and compressed as it arrives:
+ * timestamps as delta-of-delta varints, register values as zig-zag delta
+ * varints, telemetry floats as XOR with the previous value. Full or aged
+ * blocks are sealed and written in batches to fixed-size segment files,
+ * and an mmap'd ring index records each block's series, time range and
+ * min/max/sum so range queries read only the blocks they need and can
+ * downsample whole blocks without decoding them.
+ *
+ * Retention unlinks the oldest segment file once it is past the retention
+ * time or the store is over its byte budget; no record is ever scanned to
+ * expire it. Data survives restarts: the index and segments are reopened
+ * from the store directory.
+ */
+
+#ifndef TIMESERIES_STORE_H
+#define TIMESERIES_STORE_H
+
+#include "hal_common.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TS_STORE_DEFAULT_DIR            "/var/lib/oht50/history"
+#define TS_STORE_MAX_SERIES             256     // Open blocks held in RAM (power of two)
+#define TS_STORE_COLUMN_BYTES           256     // Compressed bytes per column per block
+#define TS_STORE_BLOCK_MAX_SAMPLES      256
+#define TS_STORE_INDEX_CAPACITY         16384   // Blocks addressable by the index (1 MiB file)
+#define TS_STORE_MAX_SEGMENTS           64      // Segment files on disk at most
+
+// What a series holds
+typedef enum {
+    TS_SERIES_REGISTER = 0,         // Raw 16-bit register value; id is the register address
+    TS_SERIES_TELEMETRY = 1         // Float telemetry; id is a ts_telemetry_field_t
+} ts_series_kind_t;
+
+// Telemetry fields of module_telemetry_storage_t
+typedef enum {
+    TS_TELEMETRY_VOLTAGE = 0,
+    TS_TELEMETRY_CURRENT,
+    TS_TELEMETRY_POWER,
+    TS_TELEMETRY_TEMPERATURE,
+    TS_TELEMETRY_EFFICIENCY,
+    TS_TELEMETRY_LOAD_PERCENTAGE,
+    TS_TELEMETRY_FIELD_COUNT
+} ts_telemetry_field_t;
+
+// Series key
+typedef struct {
+    uint8_t module;                 // Module address
+    uint8_t kind;                   // ts_series_kind_t
+    uint16_t id;                    // Register address or telemetry field
+} ts_series_key_t;
+
+// Store configuration
+typedef struct {
+    char directory[128];            // Created if missing
+    uint32_t segment_bytes;         // Size a segment file grows to before the next one starts
+    uint32_t max_bytes;             // Budget for all segment files together
+    uint32_t retention_hours;       // Segments whose newest block is older are dropped
+    uint32_t flush_interval_ms;     // Sealed blocks are written at most this often
+    uint32_t max_block_age_ms;      // Open blocks are sealed after this long
+} ts_store_config_t;
+
+// One query result: a raw sample, or one downsampling bucket
+typedef struct {
+    uint64_t timestamp_ms;          // Sample time, or bucket start
+    float min;
+    float max;
+    float avg;
+    uint32_t count;                 // Samples in the bucket (1 for raw samples)
+} ts_point_t;
+
+// Store statistics
+typedef struct {
+    uint64_t samples_appended;
+    uint64_t samples_dropped;       // No series slot or no room to seal
+    uint64_t blocks_sealed;
+    uint64_t blocks_written;
+    uint64_t bytes_written;
+    uint64_t flushes;
+    uint64_t segments_dropped;
+    uint64_t blocks_dropped;        // Index entries released with their segments
+    uint64_t corrupt_blocks;        // Skipped by queries (bad magic or CRC)
+    uint64_t disk_bytes;            // Segment files now on disk
+    uint64_t oldest_ms;             // Oldest indexed sample, 0 if none
+    uint32_t series;
+    uint32_t segments;
+    uint32_t index_entries;
+    uint32_t pending_bytes;         // Sealed, not yet written
+} ts_store_stats_t;
+
+/**
+ * @brief Fill a configuration with defaults (8 MiB, 7 days, 60 s flush)
+ * @param config Output
+ * @return HAL status
+ */
+hal_status_t ts_store_get_default_config(ts_store_config_t *config);
+
+/**
+ * @brief Open (or create) the store in config->directory
+ * @param config Configuration
+ * @return HAL_STATUS_ALREADY_INITIALIZED if open, HAL_STATUS_IO_ERROR if the directory is unusable
+ */
+hal_status_t ts_store_open(const ts_store_config_t *config);
+
+/**
+ * @brief Seal and write everything, then close
+ * @return HAL status
+ */
+hal_status_t ts_store_close(void);
+
+/**
+ * @brief Check whether the store is open
+ * @return true if open
+ */
+bool ts_store_is_open(void);
+
+/**
+ * @brief Append one sample
+ *
+ * Never touches the disk; safe to call from the bus thread. Samples of a
+ * series must arrive in time order, an earlier timestamp seals the block.
+ *
+ * @param key Series
+ * @param timestamp_ms Wall-clock time in milliseconds
+ * @param value Sample value (integral 0..65535 for register series)
+ * @return HAL status
+ */
+hal_status_t ts_store_append(ts_series_key_t key, uint64_t timestamp_ms, float value);
+
+/**
+ * @brief Append a run of register values sampled at the same time
+ *
+ * Matches register_cache_change_listener_t apart from the context argument.
+ *
+ * @param module_addr Module address
+ * @param start_addr First register
+ * @param values Values
+ * @param count Registers in the run
+ * @param timestamp_ms Sample time
+ * @return HAL status
+ */
+hal_status_t ts_store_append_registers(uint8_t module_addr, uint16_t start_addr, const uint16_t *values,
+                                       uint16_t count, uint64_t timestamp_ms);
+
+/**
+ * @brief Periodic work: seal aged blocks, write on the flush interval, apply retention
+ *
+ * Does I/O; call from the main loop, not the bus thread. Returns at once
+ * if called again within a second.
+ *
+ * @param now_ms Wall-clock time in milliseconds
+ * @return HAL status
+ */
+hal_status_t ts_store_maintain(uint64_t now_ms);
+
+/**
+ * @brief Seal every open block and write all sealed blocks now
+ * @return HAL status
+ */
+hal_status_t ts_store_flush(void);
+
+/**
+ * @brief Read a series over [from_ms, to_ms]
+ *
+ * With bucket_ms > 0 the range is cut into buckets starting at from_ms and
+ * each non-empty bucket yields min/max/avg/count; blocks that fall inside
+ * one bucket are merged from the index without being read. With
+ * bucket_ms == 0 raw samples are returned. Points are in time order; at
+ * most max_points are returned, the oldest first.
+ *
+ * @param key Series
+ * @param from_ms Range start (inclusive)
+ * @param to_ms Range end (inclusive)
+ * @param bucket_ms Bucket width, 0 for raw samples
+ * @param points Output points
+ * @param max_points Capacity of points
+ * @param count Points written
+ * @return HAL status
+ */
+hal_status_t ts_store_query(ts_series_key_t key, uint64_t from_ms, uint64_t to_ms, uint64_t bucket_ms,
+                            ts_point_t *points, uint32_t max_points, uint32_t *count);
+
+/**
+ * @brief List the series of a module that have data (register series first, by address)
+ * @param module_addr Module address
+ * @param keys Output keys
+ * @param max_keys Capacity of keys
+ * @param count Keys written
+ * @return HAL status
+ */
+hal_status_t ts_store_list_series(uint8_t module_addr, ts_series_key_t *keys, uint32_t max_keys, uint32_t *count);
+
+/**
+ * @brief Get store statistics
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t ts_store_get_stats(ts_store_stats_t *stats);
+
+/**
+ * @brief Name of a telemetry field ("voltage", ...)
+ * @param field Field
+ * @return Name, "unknown" if out of range
+ */
+const char *ts_store_telemetry_field_name(ts_telemetry_field_t field);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMESERIES_STORE_H
@@ -8,9 +8,7 @@
  */
 
 #include "register_json_serializer.h"
-#include <stdlib.h>
 #include <stdio.h>
-#include <string.h>
 
 // ============================================================================
 // ENUM TO STRING CONVERTERS IMPLEMENTATION
@@ -50,33 +48,41 @@ const char* register_access_level_to_string(uint8_t access_level) {
 }
 
 // ============================================================================
-// HELPER FUNCTIONS
+// JSON SERIALIZERS IMPLEMENTATION
 // ============================================================================
 
-/**
- * @brief Escape JSON string (basic implementation)
- */
-static void json_escape_string(char* dest, const char* src, size_t dest_size) {
-    if (src == NULL || dest == NULL || dest_size == 0) {
-        if (dest && dest_size > 0) dest[0] = '\0';
-        return;
-    }
-    
-    size_t j = 0;
-    for (size_t i = 0; src[i] != '\0' && j < dest_size - 1; i++) {
-        if (src[i] == '"' || src[i] == '\\') {
-            if (j < dest_size - 2) {
-                dest[j++] = '\\';
-            }
-        }
-        dest[j++] = src[i];
-    }
-    dest[j] = '\0';
+void register_json_write(json_writer_t *writer, const register_info_t *reg) {
+    json_writer_begin_object(writer);
+    json_writer_field_hex(writer, "address", reg->address, 4);
+    json_writer_field_string(writer, "mode", register_mode_to_string(reg->mode));
+    json_writer_field_string(writer, "data_type", register_data_type_to_string(reg->data_type));
+    json_writer_field_string(writer, "access_level", register_access_level_to_string(reg->access_level));
+    json_writer_field_bool(writer, "is_safe_register", reg->is_safe_register);
+    json_writer_field_string(writer, "description", reg->description ? reg->description : "");
+    json_writer_field_string(writer, "unit", reg->unit ? reg->unit : "");
+    json_writer_field_uint(writer, "min_value", reg->min_value);
+    json_writer_field_uint(writer, "max_value", reg->max_value);
+    json_writer_field_uint(writer, "default_value", reg->default_value);
+    json_writer_end_object(writer);
 }
 
-// ============================================================================
-// JSON SERIALIZERS IMPLEMENTATION
-// ============================================================================
+void register_list_json_write(json_writer_t *writer, const register_list_response_t *response) {
+    json_writer_begin_object(writer);
+    json_writer_field_bool(writer, "success", true);
+    json_writer_key(writer, "data");
+    json_writer_begin_object(writer);
+    json_writer_field_uint(writer, "module_addr", response->module_addr);
+    json_writer_field_string(writer, "module_name", response->module_name ? response->module_name : "Unknown");
+    json_writer_field_uint(writer, "register_count", response->count);
+    json_writer_key(writer, "registers");
+    json_writer_begin_array(writer);
+    for (uint16_t i = 0; i < response->count; i++) {
+        register_json_write(writer, &response->registers[i]);
+    }
+    json_writer_end_array(writer);
+    json_writer_end_object(writer);
+    json_writer_end_object(writer);
+}
 
 char* serialize_register_to_json(const register_info_t* reg) {
     if (reg == NULL) {
@@ -84,57 +90,17 @@ char* serialize_register_to_json(const register_info_t* reg) {
         return NULL;
     }
     
-    // Allocate buffer (1KB should be enough for single register)
-    size_t buffer_size = 1024;
-    char* json = (char*)malloc(buffer_size);
-    if (json == NULL) {
+    json_writer_t writer;
+    if (json_writer_init_heap(&writer, estimate_json_buffer_size(1)) != HAL_STATUS_OK) {
         printf("[JSON_SER] Error: Failed to allocate buffer\n");
         return NULL;
     }
+    register_json_write(&writer, reg);
     
-    // Escape strings
-    char desc_escaped[256] = {0};
-    char unit_escaped[64] = {0};
-    
-    if (reg->description) {
-        json_escape_string(desc_escaped, reg->description, sizeof(desc_escaped));
-    }
-    if (reg->unit) {
-        json_escape_string(unit_escaped, reg->unit, sizeof(unit_escaped));
-    }
-    
-    // Serialize to JSON
-    int written = snprintf(json, buffer_size,
-        "{\n"
-        "  \"address\": \"0x%04X\",\n"
-        "  \"mode\": \"%s\",\n"
-        "  \"data_type\": \"%s\",\n"
-        "  \"access_level\": \"%s\",\n"
-        "  \"is_safe_register\": %s,\n"
-        "  \"description\": \"%s\",\n"
-        "  \"unit\": \"%s\",\n"
-        "  \"min_value\": %u,\n"
-        "  \"max_value\": %u,\n"
-        "  \"default_value\": %u\n"
-        "}",
-        reg->address,
-        register_mode_to_string(reg->mode),
-        register_data_type_to_string(reg->data_type),
-        register_access_level_to_string(reg->access_level),
-        reg->is_safe_register ? "true" : "false",
-        desc_escaped,
-        unit_escaped,
-        reg->min_value,
-        reg->max_value,
-        reg->default_value
-    );
-    
-    if (written < 0 || (size_t)written >= buffer_size) {
-        printf("[JSON_SER] Error: Buffer overflow during serialization\n");
-        free(json);
-        return NULL;
+    char *json = json_writer_take(&writer, NULL);
+    if (json == NULL) {
+        printf("[JSON_SER] Error: Serialization failed\n");
     }
-    
     return json;
 }
 
@@ -144,129 +110,40 @@ char* serialize_register_list_to_json(const register_list_response_t* response)
         return NULL;
     }
     
-    // Estimate buffer size (500 bytes per register + 1KB overhead)
+    json_writer_t writer;
     size_t buffer_size = estimate_json_buffer_size(response->count);
-    char* json = (char*)malloc(buffer_size);
-    if (json == NULL) {
+    if (json_writer_init_heap(&writer, buffer_size) != HAL_STATUS_OK) {
         printf("[JSON_SER] Error: Failed to allocate buffer (%zu bytes)\n", buffer_size);
         return NULL;
     }
+    register_list_json_write(&writer, response);
     
-    // Start JSON object
-    int pos = snprintf(json, buffer_size,
-        "{\n"
-        "  \"success\": true,\n"
-        "  \"data\": {\n"
-        "    \"module_addr\": %u,\n"
-        "    \"module_name\": \"%s\",\n"
-        "    \"register_count\": %u,\n"
-        "    \"registers\": [\n",
-        response->module_addr,
-        response->module_name ? response->module_name : "Unknown",
-        response->count
-    );
-    
-    if (pos < 0 || (size_t)pos >= buffer_size) {
-        printf("[JSON_SER] Error: Buffer overflow in header\n");
-        free(json);
-        return NULL;
-    }
-    
-    // Serialize each register
-    for (uint16_t i = 0; i < response->count; i++) {
-        const register_info_t* reg = &response->registers[i];
-        
-        // Escape strings
-        char desc_escaped[256] = {0};
-        char unit_escaped[64] = {0};
-        
-        if (reg->description) {
-            json_escape_string(desc_escaped, reg->description, sizeof(desc_escaped));
-        }
-        if (reg->unit) {
-            json_escape_string(unit_escaped, reg->unit, sizeof(unit_escaped));
-        }
-        
-        // Add register object
-        int written = snprintf(json + pos, buffer_size - pos,
-            "      {\n"
-            "        \"address\": \"0x%04X\",\n"
-            "        \"mode\": \"%s\",\n"
-            "        \"data_type\": \"%s\",\n"
-            "        \"access_level\": \"%s\",\n"
-            "        \"is_safe_register\": %s,\n"
-            "        \"description\": \"%s\",\n"
-            "        \"unit\": \"%s\",\n"
-            "        \"min_value\": %u,\n"
-            "        \"max_value\": %u,\n"
-            "        \"default_value\": %u\n"
-            "      }%s\n",
-            reg->address,
-            register_mode_to_string(reg->mode),
-            register_data_type_to_string(reg->data_type),
-            register_access_level_to_string(reg->access_level),
-            reg->is_safe_register ? "true" : "false",
-            desc_escaped,
-            unit_escaped,
-            reg->min_value,
-            reg->max_value,
-            reg->default_value,
-            (i < response->count - 1) ? "," : ""  // No comma for last item
-        );
-        
-        if (written < 0 || (size_t)written >= buffer_size - pos) {
-            printf("[JSON_SER] Error: Buffer overflow at register %u\n", i);
-            free(json);
-            return NULL;
-        }
-        
-        pos += written;
-    }
-    
-    // Close JSON object
-    int written = snprintf(json + pos, buffer_size - pos,
-        "    ]\n"
-        "  }\n"
-        "}\n"
-    );
-    
-    if (written < 0 || (size_t)written >= buffer_size - pos) {
-        printf("[JSON_SER] Error: Buffer overflow in footer\n");
-        free(json);
+    size_t length = 0;
+    char *json = json_writer_take(&writer, &length);
+    if (json == NULL) {
+        printf("[JSON_SER] Error: Serialization failed\n");
         return NULL;
     }
     
-    printf("[JSON_SER] Successfully serialized %u registers (%d bytes)\n", 
-           response->count, pos + written);
+    printf("[JSON_SER] Successfully serialized %u registers (%zu bytes)\n", 
+           response->count, length);
     
     return json;
 }
 
 char* create_error_json(const char* error_message) {
-    size_t buffer_size = 512;
-    char* json = (char*)malloc(buffer_size);
-    if (json == NULL) {
+    json_writer_t writer;
+    if (json_writer_init_heap(&writer, 128) != HAL_STATUS_OK) {
         return NULL;
     }
-    
-    char msg_escaped[256] = {0};
-    if (error_message) {
-        json_escape_string(msg_escaped, error_message, sizeof(msg_escaped));
-    }
-    
-    snprintf(json, buffer_size,
-        "{\n"
-        "  \"success\": false,\n"
-        "  \"error\": \"%s\"\n"
-        "}\n",
-        msg_escaped
-    );
-    
-    return json;
+    json_writer_begin_object(&writer);
+    json_writer_field_bool(&writer, "success", false);
+    json_writer_field_string(&writer, "error", error_message ? error_message : "");
+    json_writer_end_object(&writer);
+    return json_writer_take(&writer, NULL);
 }
 
 size_t estimate_json_buffer_size(uint16_t register_count) {
-    // ~500 bytes per register + 1KB overhead
-    return (register_count * 500) + 1024;
+    // ~256 bytes per compact register object + 256 bytes of envelope
+    return ((size_t)register_count * 256U) + 256U;
 }
-
@@ -11,6 +11,7 @@
 #define REGISTER_JSON_SERIALIZER_H
 
 #include "../../../src/hal/register/register_info.h"
+#include "json_writer.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -43,6 +44,20 @@ const char* register_access_level_to_string(uint8_t access_level);
 // JSON SERIALIZERS
 // ============================================================================
 
+/**
+ * @brief Write one register as a JSON object into a writer
+ * @param writer Writer positioned where a value may go
+ * @param reg Pointer to register_info_t
+ */
+void register_json_write(json_writer_t *writer, const register_info_t *reg);
+
+/**
+ * @brief Write a register list document ({"success":true,"data":{...}}) into a writer
+ * @param writer Writer with nothing written yet
+ * @param response Pointer to register_list_response_t
+ */
+void register_list_json_write(json_writer_t *writer, const register_list_response_t *response);
+
 /**
  * @brief Serialize single register to JSON string
  * @param reg Pointer to register_info_t
@@ -69,7 +84,7 @@ char* create_error_json(const char* error_message);
 /**
  * @brief Estimate buffer size needed for JSON serialization
  * @param register_count Number of registers
- * @return Estimated buffer size in bytes
+ * @return Estimated buffer size in bytes (a size hint; writers grow past it)
  */
 size_t estimate_json_buffer_size(uint16_t register_count);
 
@@ -9,6 +9,7 @@
 #define _POSIX_C_SOURCE 200809L
 #define _DEFAULT_SOURCE
 #include "hal_common.h"
+#include "hal_log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -138,13 +139,11 @@ const char* hal_device_type_to_string(hal_device_type_t device_type) {
 
 // HAL timestamp functions
 uint64_t hal_get_timestamp_us(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+    return hal_time_now_us();
 }
 
 uint64_t hal_get_timestamp_ms(void) {
-    return hal_get_timestamp_us() / 1000ULL;
+    return hal_time_now_ms();
 }
 
 void hal_sleep_us(uint64_t microseconds) {
@@ -411,6 +410,7 @@ hal_status_t hal_log_init(const char *log_file) {
         if (g_log_file == NULL) {
             return HAL_STATUS_ERROR;
         }
+        hal_log_set_output(g_log_file);
     }
     
     g_log_initialized = true;
@@ -435,6 +435,9 @@ hal_status_t hal_log_set_level(hal_log_level_t level) {
     
     hal_log_level_t old_level = g_log_level;
     g_log_level = level;
+    for (int comp = 0; comp < HAL_LOG_COMP_COUNT; comp++) {
+        hal_log_set_component_level((hal_log_component_t)comp, level);
+    }
     
     if (g_log_initialized) {
         hal_log_message(HAL_LOG_LEVEL_INFO, "Log level changed from %s to %s",
@@ -456,60 +459,18 @@ hal_status_t hal_log_message(hal_log_level_t level, const char *format, ...) {
         return HAL_STATUS_OK;
     }
     
-    if (g_log_file == NULL) {
-        g_log_file = stderr;
-    }
-    
     // Update statistics
     g_log_message_count++;
     if (level >= HAL_LOG_LEVEL_ERROR) {
         g_log_error_count++;
     }
     
-    // Get timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
-    
-    // Get log level string with color coding
-    const char *level_str;
-    const char *color_code = "";
-    switch (level) {
-        case HAL_LOG_LEVEL_DEBUG: 
-            level_str = "DEBUG"; 
-            color_code = "\033[36m"; // Cyan
-            break;
-        case HAL_LOG_LEVEL_INFO: 
-            level_str = "INFO"; 
-            color_code = "\033[32m"; // Green
-            break;
-        case HAL_LOG_LEVEL_WARNING: 
-            level_str = "WARNING"; 
-            color_code = "\033[33m"; // Yellow
-            break;
-        case HAL_LOG_LEVEL_ERROR: 
-            level_str = "ERROR"; 
-            color_code = "\033[31m"; // Red
-            break;
-        case HAL_LOG_LEVEL_FATAL: 
-            level_str = "FATAL"; 
-            color_code = "\033[35m"; // Magenta
-            break;
-        default: 
-            level_str = "UNKNOWN"; 
-            break;
-    }
-    
-    // Simplified logging for OHT-50 Master Module
-    fprintf(g_log_file, "%s[%lu] [%s] ", color_code, (unsigned long)timestamp, level_str);
-    
-    // Print message
+    // Queued to the log writer: no colour codes or fflush on the caller's thread
     va_list args;
     va_start(args, format);
-    vfprintf(g_log_file, format, args);
+    hal_log_vwrite(HAL_LOG_COMP_SYSTEM, level, format, args);
     va_end(args);
     
-    fprintf(g_log_file, "\033[0m\n"); // Reset color
-    fflush(g_log_file);
-    
     return HAL_STATUS_OK;
 }
 
@@ -517,7 +478,6 @@ hal_status_t hal_log_message(hal_log_level_t level, const char *format, ...) {
 hal_status_t hal_log_message_with_context(hal_log_level_t level, const char *component, 
                                          const char *function, uint32_t line, const char *format, ...) {
     // Suppress unused parameter warnings
-    (void)component;
     (void)function;
     (void)line;
     
@@ -525,61 +485,19 @@ hal_status_t hal_log_message_with_context(hal_log_level_t level, const char *com
         return HAL_STATUS_OK;
     }
     
-    if (g_log_file == NULL) {
-        g_log_file = stderr;
-    }
-    
     // Update statistics
     g_log_message_count++;
     if (level >= HAL_LOG_LEVEL_ERROR) {
         g_log_error_count++;
     }
     
-    // Get timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
-    
-    // Get log level string with color coding
-    const char *level_str;
-    const char *color_code = "";
-    switch (level) {
-        case HAL_LOG_LEVEL_DEBUG: 
-            level_str = "DEBUG"; 
-            color_code = "\033[36m"; // Cyan
-            break;
-        case HAL_LOG_LEVEL_INFO: 
-            level_str = "INFO"; 
-            color_code = "\033[32m"; // Green
-            break;
-        case HAL_LOG_LEVEL_WARNING: 
-            level_str = "WARNING"; 
-            color_code = "\033[33m"; // Yellow
-            break;
-        case HAL_LOG_LEVEL_ERROR: 
-            level_str = "ERROR"; 
-            color_code = "\033[31m"; // Red
-            break;
-        case HAL_LOG_LEVEL_FATAL: 
-            level_str = "FATAL"; 
-            color_code = "\033[35m"; // Magenta
-            break;
-        default: 
-            level_str = "UNKNOWN"; 
-            break;
-    }
-    
-    // Simplified logging for OHT-50 Master Module
-    fprintf(g_log_file, "%s[%lu] [%s] [%s] ", 
-            color_code, (unsigned long)timestamp, level_str, 
-            component ? component : "UNKNOWN");
-    
-    // Print message
+    char message[HAL_LOG_MSG_MAX];
     va_list args;
     va_start(args, format);
-    vfprintf(g_log_file, format, args);
+    vsnprintf(message, sizeof(message), format, args);
     va_end(args);
     
-    fprintf(g_log_file, "\033[0m\n"); // Reset color
-    fflush(g_log_file);
+    hal_log_write(HAL_LOG_COMP_SYSTEM, level, "[%s] %s", component ? component : "UNKNOWN", message);
     
     return HAL_STATUS_OK;
 }
@@ -594,24 +512,15 @@ hal_status_t hal_log_error(const char *component, const char *function, uint32_t
     // Update error statistics
     g_log_error_count++;
     
-    // Get timestamp
-    uint64_t timestamp = hal_get_timestamp_ms();
-    
-    // Print error message with context
-    fprintf(g_log_file, "\033[31m[%lu] [ERROR] [%s:%s:%u] [ERR:%u] [CODE:%d] ", 
-            (unsigned long)timestamp, 
-            component ? component : "UNKNOWN", 
-            function ? function : "UNKNOWN", 
-            line, g_log_error_count, error_code);
-    
-    // Print error message
+    char message[HAL_LOG_MSG_MAX];
     va_list args;
     va_start(args, format);
-    vfprintf(g_log_file, format, args);
+    vsnprintf(message, sizeof(message), format, args);
     va_end(args);
     
-    fprintf(g_log_file, "\033[0m\n"); // Reset color
-    fflush(g_log_file);
+    hal_log_write(HAL_LOG_COMP_SYSTEM, HAL_LOG_LEVEL_ERROR, "[%s:%s:%u] [ERR:%u] [CODE:%d] %s",
+                  component ? component : "UNKNOWN", function ? function : "UNKNOWN",
+                  line, g_log_error_count, error_code, message);
     
     return HAL_STATUS_OK;
 }
@@ -625,8 +534,10 @@ hal_status_t hal_log_close(void) {
     uint64_t uptime = hal_get_timestamp_ms() - g_log_start_time;
     hal_log_message(HAL_LOG_LEVEL_INFO, "HAL Logging System Shutdown - Total Messages: %u, Errors: %u, Uptime: %lu ms", 
                    g_log_message_count, g_log_error_count, (unsigned long)uptime);
+    hal_log_flush();
     
     if (g_log_file != NULL && g_log_file != stderr) {
+        hal_log_set_output(NULL);
         fclose(g_log_file);
         g_log_file = NULL;
     }
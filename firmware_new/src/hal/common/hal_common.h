@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "hal_time.h"
 
 // Common status codes
 typedef enum {
@@ -188,7 +189,8 @@ const char* hal_status_to_string(hal_status_t status);
 const char* hal_device_status_to_string(hal_device_status_t status);
 const char* hal_device_type_to_string(hal_device_type_t device_type);
 
-// HAL timestamp functions
+// HAL timestamp functions: monotonic (see hal_time.h), for intervals and
+// timeouts only; use hal_time_wall_ms() for timestamps that are reported
 uint64_t hal_get_timestamp_us(void);
 uint64_t hal_get_timestamp_ms(void);
 void hal_sleep_us(uint64_t microseconds);
@@ -227,7 +229,8 @@ typedef enum {
     HAL_LOG_LEVEL_INFO = 1,
     HAL_LOG_LEVEL_WARNING = 2,
     HAL_LOG_LEVEL_ERROR = 3,
-    HAL_LOG_LEVEL_FATAL = 4
+    HAL_LOG_LEVEL_FATAL = 4,
+    HAL_LOG_LEVEL_OFF = 5           // Component level only: nothing is logged
 } hal_log_level_t;
 
 // Basic logging functions
@@ -0,0 +1,392 @@
+/**
+ * @file hal_log.c
+ * @brief Leveled, component-tagged logging with per-thread rings and a frame trace
+ * @version 1.0.0
+ * @date 2025-02-16
+ * @team EMBED
+ */
+
+#define _DEFAULT_SOURCE
+#include "hal_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#define LOG_RING_MASK           (HAL_LOG_RING_RECORDS - 1U)
+#define LOG_TRACE_MASK          (HAL_LOG_TRACE_RECORDS - 1U)
+#define LOG_LINE_MAX            (HAL_LOG_MSG_MAX + 48)
+#define LOG_BATCH_MAX           8192
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint8_t comp;
+    uint8_t level;
+    char text[HAL_LOG_MSG_MAX];
+} log_record_t;
+
+// Single producer (the owning thread), single consumer (whoever holds g_log.drain_mutex)
+typedef struct {
+    uint32_t head;
+    uint32_t tail;
+    bool owned;
+    log_record_t records[HAL_LOG_RING_RECORDS];
+} log_ring_t;
+
+static struct {
+    bool running;
+    pthread_t writer;
+    FILE *out;                              // NULL means stdout
+    pthread_mutex_t drain_mutex;
+    pthread_once_t key_once;
+    pthread_key_t ring_key;
+    log_ring_t rings[HAL_LOG_RING_COUNT];
+    char batch[LOG_BATCH_MAX];
+
+    pthread_mutex_t trace_mutex;
+    hal_log_trace_record_t trace[HAL_LOG_TRACE_RECORDS];
+    uint32_t trace_seq;                     // seq of the newest record; record n lives in slot n & mask
+
+    uint64_t written;
+    uint64_t dropped;
+    uint64_t direct;
+    uint64_t suppressed;
+    uint64_t traced;
+} g_log = {
+    .drain_mutex = PTHREAD_MUTEX_INITIALIZER,
+    .key_once = PTHREAD_ONCE_INIT,
+    .trace_mutex = PTHREAD_MUTEX_INITIALIZER
+};
+
+_Static_assert(HAL_LOG_COMP_COUNT == 7, "Default level table out of date");
+uint8_t g_hal_log_levels[HAL_LOG_COMP_COUNT] = {
+    HAL_LOG_LEVEL_INFO, HAL_LOG_LEVEL_INFO, HAL_LOG_LEVEL_INFO, HAL_LOG_LEVEL_INFO,
+    HAL_LOG_LEVEL_INFO, HAL_LOG_LEVEL_INFO, HAL_LOG_LEVEL_INFO
+};
+uint32_t g_hal_log_trace_mask[8];
+
+static _Thread_local log_ring_t *t_ring;
+static _Thread_local bool t_ring_unavailable;
+
+static const char *const g_component_names[HAL_LOG_COMP_COUNT] = {
+    [HAL_LOG_COMP_SYSTEM]  = "system",
+    [HAL_LOG_COMP_RS485]   = "rs485",
+    [HAL_LOG_COMP_MODBUS]  = "modbus",
+    [HAL_LOG_COMP_COMM]    = "comm",
+    [HAL_LOG_COMP_BUS]     = "bus",
+    [HAL_LOG_COMP_POLLING] = "polling",
+    [HAL_LOG_COMP_API]     = "api"
+};
+
+static const char *const g_level_names[] = { "debug", "info", "warning", "error", "fatal", "off" };
+static const char *const g_level_tags[] = { "DEBUG", "INFO", "WARNING", "ERROR", "FATAL", "OFF" };
+
+static FILE* log_output(void) {
+    FILE *out = __atomic_load_n(&g_log.out, __ATOMIC_ACQUIRE);
+    return out != NULL ? out : stdout;
+}
+
+static void log_release_ring(void *ring) {
+    // Records still queued are drained later; the next owner just continues after them
+    __atomic_store_n(&((log_ring_t *)ring)->owned, false, __ATOMIC_RELEASE);
+}
+
+static void log_create_key(void) {
+    pthread_key_create(&g_log.ring_key, log_release_ring);
+}
+
+/**
+ * @brief Ring of the calling thread, claimed on first use
+ */
+static log_ring_t* log_thread_ring(void) {
+    if (t_ring != NULL || t_ring_unavailable) {
+        return t_ring;
+    }
+    pthread_once(&g_log.key_once, log_create_key);
+    // Prefer a drained ring so a short-lived thread does not inherit its predecessor's backlog
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < HAL_LOG_RING_COUNT; i++) {
+            log_ring_t *ring = &g_log.rings[i];
+            bool expected = false;
+            if (pass == 0 && __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) != ring->head) {
+                continue;
+            }
+            if (__atomic_compare_exchange_n(&ring->owned, &expected, true, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                t_ring = ring;
+                pthread_setspecific(g_log.ring_key, t_ring);
+                return t_ring;
+            }
+        }
+    }
+    t_ring_unavailable = true;
+    return NULL;
+}
+
+static size_t log_format_line(char *line, size_t cap, uint64_t timestamp_us, uint8_t comp, uint8_t level,
+                              const char *text) {
+    int n = snprintf(line, cap, "[%llu.%06llu] [%s] [%s] %s\n",
+                     (unsigned long long)(timestamp_us / 1000000ULL),
+                     (unsigned long long)(timestamp_us % 1000000ULL),
+                     g_level_tags[level], g_component_names[comp], text);
+    if (n < 0) {
+        return 0;
+    }
+    return (size_t)n < cap ? (size_t)n : cap - 1;
+}
+
+/**
+ * @brief Write every queued record in one batch per buffer fill
+ * @return Number of records written
+ */
+static uint32_t log_drain(void) {
+    FILE *out = log_output();
+    size_t used = 0;
+    uint32_t count = 0;
+
+    pthread_mutex_lock(&g_log.drain_mutex);
+    for (uint32_t i = 0; i < HAL_LOG_RING_COUNT; i++) {
+        log_ring_t *ring = &g_log.rings[i];
+        uint32_t tail = ring->tail;
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        while (tail != head) {
+            const log_record_t *rec = &ring->records[tail & LOG_RING_MASK];
+            if (LOG_BATCH_MAX - used < LOG_LINE_MAX) {
+                fwrite(g_log.batch, 1, used, out);
+                used = 0;
+            }
+            used += log_format_line(g_log.batch + used, LOG_BATCH_MAX - used, rec->timestamp_us,
+                                    rec->comp, rec->level, rec->text);
+            tail++;
+            count++;
+            __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+        }
+    }
+    if (used > 0) {
+        fwrite(g_log.batch, 1, used, out);
+    }
+    if (count > 0) {
+        fflush(out);
+        __atomic_add_fetch(&g_log.written, count, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&g_log.drain_mutex);
+    return count;
+}
+
+static void* log_writer_main(void *arg) {
+    (void)arg;
+    const struct timespec period = {
+        .tv_sec = 0,
+        .tv_nsec = HAL_LOG_FLUSH_INTERVAL_MS * 1000000L
+    };
+
+    while (__atomic_load_n(&g_log.running, __ATOMIC_ACQUIRE)) {
+        log_drain();
+        nanosleep(&period, NULL);
+    }
+    log_drain();
+    return NULL;
+}
+
+hal_status_t hal_log_start(FILE *out) {
+    if (__atomic_load_n(&g_log.running, __ATOMIC_ACQUIRE)) {
+        return HAL_STATUS_ALREADY_ACTIVE;
+    }
+    if (out != NULL) {
+        hal_log_set_output(out);
+    }
+    __atomic_store_n(&g_log.running, true, __ATOMIC_RELEASE);
+    if (pthread_create(&g_log.writer, NULL, log_writer_main, NULL) != 0) {
+        __atomic_store_n(&g_log.running, false, __ATOMIC_RELEASE);
+        return HAL_STATUS_ERROR;
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_log_stop(void) {
+    if (!__atomic_load_n(&g_log.running, __ATOMIC_ACQUIRE)) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    __atomic_store_n(&g_log.running, false, __ATOMIC_RELEASE);
+    pthread_join(g_log.writer, NULL);
+    return HAL_STATUS_OK;
+}
+
+void hal_log_flush(void) {
+    log_drain();
+    fflush(log_output());
+}
+
+void hal_log_set_output(FILE *out) {
+    hal_log_flush();
+    __atomic_store_n(&g_log.out, out, __ATOMIC_RELEASE);
+}
+
+void hal_log_vwrite(hal_log_component_t comp, hal_log_level_t level, const char *format, va_list args) {
+    if ((unsigned)comp >= HAL_LOG_COMP_COUNT || (unsigned)level > HAL_LOG_LEVEL_FATAL || format == NULL) {
+        return;
+    }
+
+    log_ring_t *ring = __atomic_load_n(&g_log.running, __ATOMIC_ACQUIRE) ? log_thread_ring() : NULL;
+    if (ring == NULL) {
+        char text[HAL_LOG_MSG_MAX];
+        char line[LOG_LINE_MAX];
+        vsnprintf(text, sizeof(text), format, args);
+        size_t len = log_format_line(line, sizeof(line), hal_time_now_us(), (uint8_t)comp, (uint8_t)level, text);
+        fwrite(line, 1, len, log_output());
+        __atomic_add_fetch(&g_log.direct, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    uint32_t head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= HAL_LOG_RING_RECORDS) {
+        __atomic_add_fetch(&g_log.dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    log_record_t *rec = &ring->records[head & LOG_RING_MASK];
+    rec->timestamp_us = hal_time_now_us();
+    rec->comp = (uint8_t)comp;
+    rec->level = (uint8_t)level;
+    vsnprintf(rec->text, sizeof(rec->text), format, args);
+    __atomic_store_n(&ring->head, head + 1U, __ATOMIC_RELEASE);
+}
+
+void hal_log_write(hal_log_component_t comp, hal_log_level_t level, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    hal_log_vwrite(comp, level, format, args);
+    va_end(args);
+}
+
+bool hal_log_ratelimit_pass(hal_log_ratelimit_t *rl, uint32_t interval_ms, hal_log_component_t comp,
+                            hal_log_level_t level) {
+    uint64_t now = hal_time_now_us() / 1000ULL;
+    uint64_t next = __atomic_load_n(&rl->next_ms, __ATOMIC_RELAXED);
+
+    if (now < next || !__atomic_compare_exchange_n(&rl->next_ms, &next, now + interval_ms, false,
+                                                   __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        __atomic_add_fetch(&rl->suppressed, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&g_log.suppressed, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    uint32_t skipped = __atomic_exchange_n(&rl->suppressed, 0, __ATOMIC_RELAXED);
+    if (skipped > 0) {
+        hal_log_write(comp, level, "(%u similar messages suppressed)", skipped);
+    }
+    return true;
+}
+
+hal_status_t hal_log_set_component_level(hal_log_component_t comp, hal_log_level_t level) {
+    if ((unsigned)comp >= HAL_LOG_COMP_COUNT || (unsigned)level > HAL_LOG_LEVEL_OFF) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    __atomic_store_n(&g_hal_log_levels[comp], (uint8_t)level, __ATOMIC_RELAXED);
+    return HAL_STATUS_OK;
+}
+
+hal_log_level_t hal_log_get_component_level(hal_log_component_t comp) {
+    if ((unsigned)comp >= HAL_LOG_COMP_COUNT) {
+        return HAL_LOG_LEVEL_OFF;
+    }
+    return (hal_log_level_t)__atomic_load_n(&g_hal_log_levels[comp], __ATOMIC_RELAXED);
+}
+
+const char* hal_log_component_name(hal_log_component_t comp) {
+    return (unsigned)comp < HAL_LOG_COMP_COUNT ? g_component_names[comp] : "unknown";
+}
+
+hal_log_component_t hal_log_component_from_name(const char *name) {
+    for (uint32_t i = 0; name != NULL && i < HAL_LOG_COMP_COUNT; i++) {
+        if (strcmp(name, g_component_names[i]) == 0) {
+            return (hal_log_component_t)i;
+        }
+    }
+    return HAL_LOG_COMP_COUNT;
+}
+
+const char* hal_log_level_name(hal_log_level_t level) {
+    return (unsigned)level <= HAL_LOG_LEVEL_OFF ? g_level_names[level] : "unknown";
+}
+
+hal_status_t hal_log_level_from_name(const char *name, hal_log_level_t *level) {
+    if (name == NULL || level == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    for (uint32_t i = 0; i <= HAL_LOG_LEVEL_OFF; i++) {
+        if (strcmp(name, g_level_names[i]) == 0) {
+            *level = (hal_log_level_t)i;
+            return HAL_STATUS_OK;
+        }
+    }
+    return HAL_STATUS_INVALID_PARAMETER;
+}
+
+void hal_log_trace_enable(uint8_t module, bool enable) {
+    uint32_t bit = 1U << (module & 31U);
+    if (enable) {
+        __atomic_or_fetch(&g_hal_log_trace_mask[module >> 5], bit, __ATOMIC_RELAXED);
+    } else {
+        __atomic_and_fetch(&g_hal_log_trace_mask[module >> 5], ~bit, __ATOMIC_RELAXED);
+    }
+}
+
+void hal_log_trace_frame(uint8_t module, hal_log_trace_dir_t dir, const uint8_t *data, size_t length) {
+    if (data == NULL) {
+        return;
+    }
+    size_t keep = length < HAL_LOG_TRACE_BYTES ? length : HAL_LOG_TRACE_BYTES;
+
+    pthread_mutex_lock(&g_log.trace_mutex);
+    uint32_t seq = ++g_log.trace_seq;
+    hal_log_trace_record_t *rec = &g_log.trace[seq & LOG_TRACE_MASK];
+    rec->timestamp_us = hal_time_now_us();
+    rec->seq = seq;
+    rec->module = module;
+    rec->dir = (uint8_t)dir;
+    rec->length = (uint16_t)(length > 0xFFFFU ? 0xFFFFU : length);
+    memcpy(rec->data, data, keep);
+    pthread_mutex_unlock(&g_log.trace_mutex);
+
+    __atomic_add_fetch(&g_log.traced, 1, __ATOMIC_RELAXED);
+}
+
+uint32_t hal_log_trace_read(uint8_t module, uint32_t after_seq, hal_log_trace_record_t *records,
+                            uint32_t max_records) {
+    uint32_t count = 0;
+
+    if (records == NULL || max_records == 0) {
+        return 0;
+    }
+    pthread_mutex_lock(&g_log.trace_mutex);
+    uint32_t newest = g_log.trace_seq;
+    uint32_t oldest = newest >= HAL_LOG_TRACE_RECORDS ? newest - HAL_LOG_TRACE_RECORDS + 1U : 1U;
+    if (after_seq + 1U > oldest) {
+        oldest = after_seq + 1U;
+    }
+    for (uint32_t seq = oldest; seq != 0 && seq <= newest && count < max_records; seq++) {
+        const hal_log_trace_record_t *rec = &g_log.trace[seq & LOG_TRACE_MASK];
+        if (rec->module == module) {
+            records[count++] = *rec;
+        }
+    }
+    pthread_mutex_unlock(&g_log.trace_mutex);
+    return count;
+}
+
+hal_status_t hal_log_get_stats(hal_log_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->records_written = __atomic_load_n(&g_log.written, __ATOMIC_RELAXED);
+    stats->records_dropped = __atomic_load_n(&g_log.dropped, __ATOMIC_RELAXED);
+    stats->records_direct = __atomic_load_n(&g_log.direct, __ATOMIC_RELAXED);
+    stats->records_suppressed = __atomic_load_n(&g_log.suppressed, __ATOMIC_RELAXED);
+    stats->frames_traced = __atomic_load_n(&g_log.traced, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < HAL_LOG_RING_COUNT; i++) {
+        if (__atomic_load_n(&g_log.rings[i].owned, __ATOMIC_RELAXED)) {
+            stats->rings_in_use++;
+        }
+    }
+    return HAL_STATUS_OK;
+}
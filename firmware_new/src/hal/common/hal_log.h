@@ -0,0 +1,266 @@
+/**
+ * @file hal_log.h
+ * @brief Leveled, component-tagged logging with per-thread rings and a frame trace
+ * @version 1.0.0
+ * @date 2025-02-16
+ * @team EMBED
+ *
+ * Three costs are kept off hot paths:
+ *
+ *  - Compile time: HAL_LOG* statements below HAL_LOG_COMPILE_LEVEL expand to
+ *    dead code (arguments are still type-checked), so a build with
+ *    -DHAL_LOG_COMPILE_LEVEL=1 carries no DEBUG formatting at all.
+ *  - Run time: each component has its own level, checked with one relaxed
+ *    byte load before any argument is evaluated.
+ *  - Output: an enabled record is formatted into the calling thread's
+ *    single-producer ring and written by a background thread in batches,
+ *    so the caller never touches stdio, locks or fflush(). Before
+ *    hal_log_start() (and for threads beyond HAL_LOG_RING_COUNT) records
+ *    are written synchronously. A full ring drops the record and counts it.
+ *
+ * Raw Modbus frames are not formatted at all: HAL_LOG_TRACE_FRAME copies
+ * them into a binary trace ring, only for modules tracing was enabled for
+ * (e.g. from the API), and readers format them on demand.
+ */
+
+#ifndef HAL_LOG_H
+#define HAL_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lowest level compiled in (set per build, see cmake/BuildOptions.cmake)
+#ifndef HAL_LOG_COMPILE_LEVEL
+#define HAL_LOG_COMPILE_LEVEL           0
+#endif
+
+#define HAL_LOG_RING_COUNT              16      // Threads with their own ring
+#define HAL_LOG_RING_RECORDS            64      // Records per ring (power of two)
+#define HAL_LOG_MSG_MAX                 160     // Formatted text per record, truncated beyond
+#define HAL_LOG_FLUSH_INTERVAL_MS       20      // Writer wakeup period
+#define HAL_LOG_TRACE_RECORDS           256     // Frame trace ring (power of two)
+#define HAL_LOG_TRACE_BYTES             64      // Frame bytes kept per trace record
+
+// Log components (each has its own runtime level)
+typedef enum {
+    HAL_LOG_COMP_SYSTEM = 0,
+    HAL_LOG_COMP_RS485,
+    HAL_LOG_COMP_MODBUS,
+    HAL_LOG_COMP_COMM,
+    HAL_LOG_COMP_BUS,
+    HAL_LOG_COMP_POLLING,
+    HAL_LOG_COMP_API,
+    HAL_LOG_COMP_COUNT
+} hal_log_component_t;
+
+// Trace record direction
+typedef enum {
+    HAL_LOG_TRACE_TX = 0,
+    HAL_LOG_TRACE_RX
+} hal_log_trace_dir_t;
+
+// One traced frame
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t seq;                           // Monotonic, for incremental reads
+    uint8_t module;                         // Modbus slave address
+    uint8_t dir;                            // hal_log_trace_dir_t
+    uint16_t length;                        // Original frame length
+    uint8_t data[HAL_LOG_TRACE_BYTES];      // First min(length, HAL_LOG_TRACE_BYTES) bytes
+} hal_log_trace_record_t;
+
+// Logging counters
+typedef struct {
+    uint64_t records_written;               // Via the writer thread
+    uint64_t records_dropped;               // Ring full
+    uint64_t records_direct;                // Written synchronously by the caller
+    uint64_t records_suppressed;            // Swallowed by HAL_LOG_RATELIMITED
+    uint64_t frames_traced;
+    uint32_t rings_in_use;
+} hal_log_stats_t;
+
+// Per-callsite state of HAL_LOG_RATELIMITED
+typedef struct {
+    uint64_t next_ms;
+    uint32_t suppressed;
+} hal_log_ratelimit_t;
+
+// Runtime levels and trace bitmap (read inline by the macros)
+extern uint8_t g_hal_log_levels[HAL_LOG_COMP_COUNT];
+extern uint32_t g_hal_log_trace_mask[8];
+
+/**
+ * @brief Whether a component logs at a level
+ */
+static inline bool hal_log_enabled(hal_log_component_t comp, hal_log_level_t level) {
+    return (uint8_t)level >= __atomic_load_n(&g_hal_log_levels[comp], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Whether frames of a module are being traced
+ */
+static inline bool hal_log_trace_is_enabled(uint8_t module) {
+    return (__atomic_load_n(&g_hal_log_trace_mask[module >> 5], __ATOMIC_RELAXED) & (1U << (module & 31U))) != 0;
+}
+
+#define HAL_LOG(comp, level, ...)                                                   \
+    do {                                                                            \
+        if ((int)(level) >= HAL_LOG_COMPILE_LEVEL && hal_log_enabled((comp), (level))) { \
+            hal_log_write((comp), (level), __VA_ARGS__);                            \
+        }                                                                           \
+    } while (0)
+
+#define HAL_LOGD(comp, ...)  HAL_LOG((comp), HAL_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define HAL_LOGI(comp, ...)  HAL_LOG((comp), HAL_LOG_LEVEL_INFO, __VA_ARGS__)
+#define HAL_LOGW(comp, ...)  HAL_LOG((comp), HAL_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define HAL_LOGE(comp, ...)  HAL_LOG((comp), HAL_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+// At most one record per interval_ms from this call site; the next one reports how many were skipped
+#define HAL_LOG_RATELIMITED(comp, level, interval_ms, ...)                          \
+    do {                                                                            \
+        static hal_log_ratelimit_t hal_log_rl_;                                     \
+        if ((int)(level) >= HAL_LOG_COMPILE_LEVEL && hal_log_enabled((comp), (level)) && \
+            hal_log_ratelimit_pass(&hal_log_rl_, (interval_ms), (comp), (level))) { \
+            hal_log_write((comp), (level), __VA_ARGS__);                            \
+        }                                                                           \
+    } while (0)
+
+#define HAL_LOG_TRACE_FRAME(module, dir, data, length)                              \
+    do {                                                                            \
+        if (hal_log_trace_is_enabled(module)) {                                     \
+            hal_log_trace_frame((module), (dir), (data), (length));                 \
+        }                                                                           \
+    } while (0)
+
+/**
+ * @brief Start the background writer
+ * @param out Output stream (NULL for stdout)
+ * @return HAL status
+ */
+hal_status_t hal_log_start(FILE *out);
+
+/**
+ * @brief Drain every ring and stop the writer; later records are written synchronously
+ * @return HAL status
+ */
+hal_status_t hal_log_stop(void);
+
+/**
+ * @brief Write everything queued so far before returning
+ */
+void hal_log_flush(void);
+
+/**
+ * @brief Redirect output (the writer and synchronous records)
+ * @param out Output stream (NULL for stdout)
+ */
+void hal_log_set_output(FILE *out);
+
+/**
+ * @brief Format and queue one record (use the HAL_LOG* macros)
+ * @param comp Component
+ * @param level Level
+ * @param format printf format
+ */
+void hal_log_write(hal_log_component_t comp, hal_log_level_t level, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief va_list form of hal_log_write(), for wrappers
+ */
+void hal_log_vwrite(hal_log_component_t comp, hal_log_level_t level, const char *format, va_list args)
+    __attribute__((format(printf, 3, 0)));
+
+/**
+ * @brief Rate-limit gate used by HAL_LOG_RATELIMITED
+ * @return true if the caller should log now
+ */
+bool hal_log_ratelimit_pass(hal_log_ratelimit_t *rl, uint32_t interval_ms, hal_log_component_t comp,
+                            hal_log_level_t level);
+
+/**
+ * @brief Set the runtime level of one component
+ * @param comp Component
+ * @param level Level; HAL_LOG_LEVEL_OFF silences the component
+ * @return HAL status
+ */
+hal_status_t hal_log_set_component_level(hal_log_component_t comp, hal_log_level_t level);
+
+/**
+ * @brief Get the runtime level of one component
+ * @param comp Component
+ * @return Level
+ */
+hal_log_level_t hal_log_get_component_level(hal_log_component_t comp);
+
+/**
+ * @brief Component name, e.g. "rs485"
+ */
+const char* hal_log_component_name(hal_log_component_t comp);
+
+/**
+ * @brief Look up a component by name
+ * @return Component or HAL_LOG_COMP_COUNT if unknown
+ */
+hal_log_component_t hal_log_component_from_name(const char *name);
+
+/**
+ * @brief Level name, e.g. "debug"
+ */
+const char* hal_log_level_name(hal_log_level_t level);
+
+/**
+ * @brief Look up a level by name ("debug".."fatal", "off")
+ * @param name Level name
+ * @param level Output level
+ * @return HAL_STATUS_INVALID_PARAMETER if unknown
+ */
+hal_status_t hal_log_level_from_name(const char *name, hal_log_level_t *level);
+
+/**
+ * @brief Enable or disable frame tracing for one module
+ * @param module Modbus slave address
+ * @param enable true to trace
+ */
+void hal_log_trace_enable(uint8_t module, bool enable);
+
+/**
+ * @brief Record one frame into the trace ring (use HAL_LOG_TRACE_FRAME)
+ * @param module Modbus slave address
+ * @param dir Direction
+ * @param data Frame bytes
+ * @param length Frame length
+ */
+void hal_log_trace_frame(uint8_t module, hal_log_trace_dir_t dir, const uint8_t *data, size_t length);
+
+/**
+ * @brief Copy traced frames of one module, oldest first
+ * @param module Modbus slave address
+ * @param after_seq Only records with seq > after_seq (0 for everything retained)
+ * @param records Output array
+ * @param max_records Capacity of records
+ * @return Number of records copied
+ */
+uint32_t hal_log_trace_read(uint8_t module, uint32_t after_seq, hal_log_trace_record_t *records,
+                            uint32_t max_records);
+
+/**
+ * @brief Get logging counters
+ * @param stats Output counters
+ * @return HAL status
+ */
+hal_status_t hal_log_get_stats(hal_log_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_LOG_H
@@ -0,0 +1,618 @@
+/**
+ * @file hal_reactor.c
+ * @brief Event reactor for the main thread: periodic tasks, cross-thread events and fd watchers
+ * @version 1.0.0
+ * @date 2025-02-28
+ * @team FW
+ */
+
+#include "hal_reactor.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#define REACTOR_WHEEL_MASK      (HAL_REACTOR_WHEEL_SLOTS - 1U)
+#define REACTOR_MAX_EVENTS      16
+#define REACTOR_LINK_NONE       (-1)
+#define REACTOR_TAG_TIMER       UINT64_MAX
+#define REACTOR_TAG_EVENT       (UINT64_MAX - 1U)
+
+_Static_assert((HAL_REACTOR_WHEEL_SLOTS & REACTOR_WHEEL_MASK) == 0, "HAL_REACTOR_WHEEL_SLOTS must be a power of two");
+_Static_assert(HAL_REACTOR_MAX_TASKS <= 32, "Event tasks are bits of a 32-bit mask");
+
+typedef struct {
+    bool active;
+    hal_reactor_fn_t fn;
+    hal_reactor_fd_fn_t fd_fn;
+    void *context;
+    int fd;
+    uint64_t period_ticks;
+    uint64_t deadline_tick;         // Periodic: tick the next run is due at
+    int16_t next;                   // Wheel slot list
+    int16_t prev;
+    bool linked;
+    uint64_t first_signal_us;       // Event: when the pending signal was first raised
+    hal_reactor_task_stats_t stats;
+} reactor_task_t;
+
+static struct {
+    bool initialized;
+    bool running;
+    int epoll_fd;
+    int timer_fd;
+    int event_fd;
+    reactor_task_t tasks[HAL_REACTOR_MAX_TASKS];
+    int16_t wheel[HAL_REACTOR_WHEEL_SLOTS];
+    uint64_t wheel_tick;            // Last tick whose slot was processed
+    uint64_t armed_tick;            // Tick the timerfd is armed for, 0 if disarmed
+    uint32_t pending;               // Event task bits, set by hal_reactor_signal()
+    int stop;
+    hal_reactor_stats_t stats;
+    pthread_mutex_t mutex;          // Task table and statistics against other threads' readers
+} g_reactor = {
+    .epoll_fd = -1,
+    .timer_fd = -1,
+    .event_fd = -1,
+    .mutex = PTHREAD_MUTEX_INITIALIZER
+};
+
+static inline uint64_t reactor_now_tick(void) {
+    return hal_time_tick_ms() / HAL_REACTOR_TICK_MS;
+}
+
+static bool reactor_valid_task(int task_id) {
+    return task_id >= 0 && task_id < HAL_REACTOR_MAX_TASKS && g_reactor.tasks[task_id].active;
+}
+
+static void reactor_wheel_link(int16_t index) {
+    reactor_task_t *task = &g_reactor.tasks[index];
+    // A slot already passed would not be visited again for a whole revolution
+    if (task->deadline_tick <= g_reactor.wheel_tick) {
+        task->deadline_tick = g_reactor.wheel_tick + 1U;
+    }
+    uint32_t slot = (uint32_t)(task->deadline_tick & REACTOR_WHEEL_MASK);
+    task->prev = REACTOR_LINK_NONE;
+    task->next = g_reactor.wheel[slot];
+    if (task->next != REACTOR_LINK_NONE) {
+        g_reactor.tasks[task->next].prev = index;
+    }
+    g_reactor.wheel[slot] = index;
+    task->linked = true;
+}
+
+static void reactor_wheel_unlink(int16_t index) {
+    reactor_task_t *task = &g_reactor.tasks[index];
+    if (!task->linked) {
+        return;
+    }
+    if (task->prev != REACTOR_LINK_NONE) {
+        g_reactor.tasks[task->prev].next = task->next;
+    } else {
+        g_reactor.wheel[task->deadline_tick & REACTOR_WHEEL_MASK] = task->next;
+    }
+    if (task->next != REACTOR_LINK_NONE) {
+        g_reactor.tasks[task->next].prev = task->prev;
+    }
+    task->next = REACTOR_LINK_NONE;
+    task->prev = REACTOR_LINK_NONE;
+    task->linked = false;
+}
+
+/**
+ * @brief First tick within one revolution that has a periodic task due
+ * @return Tick, or one revolution ahead if the wheel is empty that far
+ */
+static uint64_t reactor_wheel_next_tick(void) {
+    for (uint64_t tick = g_reactor.wheel_tick + 1U; tick <= g_reactor.wheel_tick + HAL_REACTOR_WHEEL_SLOTS; tick++) {
+        for (int16_t i = g_reactor.wheel[tick & REACTOR_WHEEL_MASK]; i != REACTOR_LINK_NONE;
+             i = g_reactor.tasks[i].next) {
+            if (g_reactor.tasks[i].deadline_tick == tick) {
+                return tick;
+            }
+        }
+    }
+    return g_reactor.wheel_tick + HAL_REACTOR_WHEEL_SLOTS;
+}
+
+static bool reactor_has_periodic(void) {
+    for (int i = 0; i < HAL_REACTOR_MAX_TASKS; i++) {
+        if (g_reactor.tasks[i].active && g_reactor.tasks[i].stats.type == HAL_REACTOR_TASK_PERIODIC) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void reactor_arm_timer(void) {
+    uint64_t tick = reactor_has_periodic() ? reactor_wheel_next_tick() : 0;
+    if (tick == g_reactor.armed_tick) {
+        return;
+    }
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    if (tick != 0) {
+        uint64_t ms = tick * HAL_REACTOR_TICK_MS;
+        spec.it_value.tv_sec = (time_t)(ms / 1000ULL);
+        spec.it_value.tv_nsec = (long)(ms % 1000ULL) * 1000000L;
+    }
+    if (timerfd_settime(g_reactor.timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) == 0) {
+        g_reactor.armed_tick = tick;
+    }
+}
+
+static int reactor_alloc_task(const char *name, hal_reactor_task_type_t type) {
+    for (int i = 0; i < HAL_REACTOR_MAX_TASKS; i++) {
+        reactor_task_t *task = &g_reactor.tasks[i];
+        if (!task->active) {
+            memset(task, 0, sizeof(*task));
+            task->fd = -1;
+            task->next = REACTOR_LINK_NONE;
+            task->prev = REACTOR_LINK_NONE;
+            task->stats.type = type;
+            snprintf(task->stats.name, sizeof(task->stats.name), "%s", name != NULL ? name : "task");
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void reactor_account(reactor_task_t *task, uint64_t start_us, uint64_t late_us) {
+    uint64_t run_us = hal_time_now_us() - start_us;
+    pthread_mutex_lock(&g_reactor.mutex);
+    task->stats.runs++;
+    task->stats.total_us += run_us;
+    task->stats.last_us = run_us > UINT32_MAX ? UINT32_MAX : (uint32_t)run_us;
+    if (task->stats.last_us > task->stats.max_us) {
+        task->stats.max_us = task->stats.last_us;
+    }
+    uint32_t late = late_us > UINT32_MAX ? UINT32_MAX : (uint32_t)late_us;
+    if (late > task->stats.max_late_us) {
+        task->stats.max_late_us = late;
+    }
+    pthread_mutex_unlock(&g_reactor.mutex);
+}
+
+static void reactor_run_events(void) {
+    uint32_t pending = __atomic_exchange_n(&g_reactor.pending, 0U, __ATOMIC_ACQ_REL);
+    while (pending != 0) {
+        int i = __builtin_ctz(pending);
+        pending &= pending - 1U;
+        reactor_task_t *task = &g_reactor.tasks[i];
+        if (!task->active || task->stats.type != HAL_REACTOR_TASK_EVENT) {
+            continue;
+        }
+        uint64_t start = hal_time_now_us();
+        uint64_t signalled = __atomic_load_n(&task->first_signal_us, __ATOMIC_RELAXED);
+        task->fn(task->context);
+        reactor_account(task, start, start > signalled ? start - signalled : 0);
+    }
+}
+
+static void reactor_run_timers(uint64_t now_tick) {
+    if (now_tick <= g_reactor.wheel_tick) {
+        return;
+    }
+
+    // Unlink everything due in the ticks passed since the last dispatch, then run it
+    int16_t expired[HAL_REACTOR_MAX_TASKS];
+    uint32_t expired_count = 0;
+    uint64_t span = now_tick - g_reactor.wheel_tick;
+    if (span > HAL_REACTOR_WHEEL_SLOTS) {
+        span = HAL_REACTOR_WHEEL_SLOTS;
+    }
+    for (uint64_t t = now_tick - span + 1U; t <= now_tick; t++) {
+        int16_t i = g_reactor.wheel[t & REACTOR_WHEEL_MASK];
+        while (i != REACTOR_LINK_NONE) {
+            int16_t next = g_reactor.tasks[i].next;
+            if (g_reactor.tasks[i].deadline_tick <= now_tick) {
+                reactor_wheel_unlink(i);
+                expired[expired_count++] = i;
+            }
+            i = next;
+        }
+    }
+    g_reactor.wheel_tick = now_tick;
+
+    for (uint32_t n = 0; n < expired_count; n++) {
+        int16_t i = expired[n];
+        reactor_task_t *task = &g_reactor.tasks[i];
+        if (!task->active || task->linked) {
+            continue;   // Removed, or removed and re-added, by an earlier task of this dispatch
+        }
+        uint64_t start = hal_time_now_us();
+        uint64_t due_us = task->deadline_tick * HAL_REACTOR_TICK_MS * 1000ULL;
+        task->fn(task->context);
+        reactor_account(task, start, start > due_us ? start - due_us : 0);
+        if (!task->active || task->linked) {
+            continue;   // The task removed itself or changed its own period
+        }
+
+        // Fixed rate; periods already over are skipped, not run back to back
+        uint64_t next = task->deadline_tick + task->period_ticks;
+        if (next <= now_tick) {
+            uint64_t behind = (now_tick - task->deadline_tick) / task->period_ticks;
+            pthread_mutex_lock(&g_reactor.mutex);
+            task->stats.missed_periods += behind;
+            pthread_mutex_unlock(&g_reactor.mutex);
+            next = task->deadline_tick + (behind + 1U) * task->period_ticks;
+        }
+        task->deadline_tick = next;
+        reactor_wheel_link(i);
+    }
+}
+
+hal_status_t hal_reactor_init(void) {
+    if (g_reactor.initialized) {
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+
+    g_reactor.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    g_reactor.timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    g_reactor.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (g_reactor.epoll_fd < 0 || g_reactor.timer_fd < 0 || g_reactor.event_fd < 0) {
+        printf("[REACTOR] ERROR: cannot create descriptors: %s\n", strerror(errno));
+        g_reactor.initialized = true;
+        (void)hal_reactor_deinit();
+        return HAL_STATUS_ERROR;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = REACTOR_TAG_TIMER;
+    int rc_timer = epoll_ctl(g_reactor.epoll_fd, EPOLL_CTL_ADD, g_reactor.timer_fd, &ev);
+    ev.data.u64 = REACTOR_TAG_EVENT;
+    int rc_event = epoll_ctl(g_reactor.epoll_fd, EPOLL_CTL_ADD, g_reactor.event_fd, &ev);
+    if (rc_timer != 0 || rc_event != 0) {
+        printf("[REACTOR] ERROR: epoll_ctl: %s\n", strerror(errno));
+        g_reactor.initialized = true;
+        (void)hal_reactor_deinit();
+        return HAL_STATUS_ERROR;
+    }
+
+    pthread_mutex_lock(&g_reactor.mutex);
+    memset(g_reactor.tasks, 0, sizeof(g_reactor.tasks));
+    for (uint32_t s = 0; s < HAL_REACTOR_WHEEL_SLOTS; s++) {
+        g_reactor.wheel[s] = REACTOR_LINK_NONE;
+    }
+    memset(&g_reactor.stats, 0, sizeof(g_reactor.stats));
+    g_reactor.wheel_tick = hal_time_now_ms() / HAL_REACTOR_TICK_MS;
+    g_reactor.armed_tick = 0;
+    __atomic_store_n(&g_reactor.pending, 0U, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_reactor.stop, 0, __ATOMIC_RELAXED);
+    g_reactor.initialized = true;
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_deinit(void) {
+    if (!g_reactor.initialized) {
+        return HAL_STATUS_OK;
+    }
+
+    pthread_mutex_lock(&g_reactor.mutex);
+    g_reactor.initialized = false;
+    memset(g_reactor.tasks, 0, sizeof(g_reactor.tasks));
+    int fds[3] = { g_reactor.event_fd, g_reactor.timer_fd, g_reactor.epoll_fd };
+    g_reactor.event_fd = -1;
+    g_reactor.timer_fd = -1;
+    g_reactor.epoll_fd = -1;
+    pthread_mutex_unlock(&g_reactor.mutex);
+
+    for (int i = 0; i < 3; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_add_periodic(const char *name, uint32_t period_ms, hal_reactor_fn_t fn, void *context,
+                                      int *task_id) {
+    if (fn == NULL || period_ms < HAL_REACTOR_TICK_MS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!g_reactor.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&g_reactor.mutex);
+    int i = reactor_alloc_task(name, HAL_REACTOR_TASK_PERIODIC);
+    if (i < 0) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        return HAL_STATUS_NO_MEMORY;
+    }
+    reactor_task_t *task = &g_reactor.tasks[i];
+    task->fn = fn;
+    task->context = context;
+    task->period_ticks = period_ms / HAL_REACTOR_TICK_MS;
+    task->stats.period_ms = period_ms;
+    task->deadline_tick = hal_time_now_ms() / HAL_REACTOR_TICK_MS;
+    task->active = true;
+    reactor_wheel_link((int16_t)i);
+    pthread_mutex_unlock(&g_reactor.mutex);
+
+    if (task_id != NULL) {
+        *task_id = i;
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_add_event(const char *name, hal_reactor_fn_t fn, void *context, int *task_id) {
+    if (fn == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!g_reactor.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&g_reactor.mutex);
+    int i = reactor_alloc_task(name, HAL_REACTOR_TASK_EVENT);
+    if (i < 0) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        return HAL_STATUS_NO_MEMORY;
+    }
+    g_reactor.tasks[i].fn = fn;
+    g_reactor.tasks[i].context = context;
+    __atomic_store_n(&g_reactor.tasks[i].active, true, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_reactor.mutex);
+
+    if (task_id != NULL) {
+        *task_id = i;
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_add_fd(const char *name, int fd, uint32_t events, hal_reactor_fd_fn_t fn, void *context,
+                                int *task_id) {
+    if (fn == NULL || fd < 0 || events == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!g_reactor.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&g_reactor.mutex);
+    int i = reactor_alloc_task(name, HAL_REACTOR_TASK_FD);
+    if (i < 0) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        return HAL_STATUS_NO_MEMORY;
+    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.u64 = (uint64_t)i;
+    if (epoll_ctl(g_reactor.epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        printf("[REACTOR] ERROR: cannot watch fd %d for %s: %s\n", fd, name != NULL ? name : "task", strerror(errno));
+        return HAL_STATUS_ERROR;
+    }
+    g_reactor.tasks[i].fd_fn = fn;
+    g_reactor.tasks[i].context = context;
+    g_reactor.tasks[i].fd = fd;
+    g_reactor.tasks[i].active = true;
+    pthread_mutex_unlock(&g_reactor.mutex);
+
+    if (task_id != NULL) {
+        *task_id = i;
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_remove(int task_id) {
+    pthread_mutex_lock(&g_reactor.mutex);
+    if (!g_reactor.initialized || !reactor_valid_task(task_id)) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    reactor_task_t *task = &g_reactor.tasks[task_id];
+    reactor_wheel_unlink((int16_t)task_id);
+    if (task->stats.type == HAL_REACTOR_TASK_FD) {
+        (void)epoll_ctl(g_reactor.epoll_fd, EPOLL_CTL_DEL, task->fd, NULL);
+    }
+    __atomic_and_fetch(&g_reactor.pending, ~(1U << (uint32_t)task_id), __ATOMIC_RELAXED);
+    __atomic_store_n(&task->active, false, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_set_period(int task_id, uint32_t period_ms) {
+    if (period_ms < HAL_REACTOR_TICK_MS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_reactor.mutex);
+    if (!g_reactor.initialized || !reactor_valid_task(task_id) ||
+        g_reactor.tasks[task_id].stats.type != HAL_REACTOR_TASK_PERIODIC) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    reactor_task_t *task = &g_reactor.tasks[task_id];
+    reactor_wheel_unlink((int16_t)task_id);
+    task->period_ticks = period_ms / HAL_REACTOR_TICK_MS;
+    task->stats.period_ms = period_ms;
+    task->deadline_tick = hal_time_now_ms() / HAL_REACTOR_TICK_MS + task->period_ticks;
+    reactor_wheel_link((int16_t)task_id);
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_signal(int task_id) {
+    if (task_id < 0 || task_id >= HAL_REACTOR_MAX_TASKS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    reactor_task_t *task = &g_reactor.tasks[task_id];
+    if (!__atomic_load_n(&task->active, __ATOMIC_ACQUIRE) || task->stats.type != HAL_REACTOR_TASK_EVENT) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    __atomic_add_fetch(&task->stats.signals, 1U, __ATOMIC_RELAXED);
+    uint32_t bit = 1U << (uint32_t)task_id;
+    // Only the signal that sets the bit wakes the reactor; later ones coalesce into the same run
+    if ((__atomic_fetch_or(&g_reactor.pending, bit, __ATOMIC_ACQ_REL) & bit) == 0) {
+        __atomic_store_n(&task->first_signal_us, hal_time_now_us(), __ATOMIC_RELAXED);
+        uint64_t one = 1;
+        if (write(g_reactor.event_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+            return HAL_STATUS_IO_ERROR;
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_run_once(int timeout_ms) {
+    if (!g_reactor.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    reactor_arm_timer();
+
+    struct epoll_event events[REACTOR_MAX_EVENTS];
+    uint64_t wait_start = hal_time_now_us();
+    int n = epoll_wait(g_reactor.epoll_fd, events, REACTOR_MAX_EVENTS, timeout_ms);
+    uint64_t dispatch_start = hal_time_tick();
+    if (n < 0 && errno != EINTR) {
+        printf("[REACTOR] ERROR: epoll_wait: %s\n", strerror(errno));
+        return HAL_STATUS_ERROR;
+    }
+
+    uint64_t expirations = 0;
+    for (int e = 0; e < n; e++) {
+        uint64_t tag = events[e].data.u64;
+        if (tag == REACTOR_TAG_TIMER) {
+            uint64_t count = 0;
+            if (read(g_reactor.timer_fd, &count, sizeof(count)) == (ssize_t)sizeof(count)) {
+                expirations += count;
+            }
+            g_reactor.armed_tick = 0;
+        } else if (tag == REACTOR_TAG_EVENT) {
+            uint64_t count = 0;
+            (void)read(g_reactor.event_fd, &count, sizeof(count));
+        } else if (tag < HAL_REACTOR_MAX_TASKS) {
+            reactor_task_t *task = &g_reactor.tasks[tag];
+            if (task->active && task->stats.type == HAL_REACTOR_TASK_FD) {
+                uint64_t start = hal_time_now_us();
+                task->fd_fn(task->fd, events[e].events, task->context);
+                reactor_account(task, start, 0);
+            }
+        }
+    }
+    reactor_run_events();
+    reactor_run_timers(reactor_now_tick());
+
+    uint64_t dispatch_end = hal_time_now_us();
+    pthread_mutex_lock(&g_reactor.mutex);
+    g_reactor.stats.wakeups++;
+    g_reactor.stats.idle_us += dispatch_start - wait_start;
+    g_reactor.stats.busy_us += dispatch_end - dispatch_start;
+    g_reactor.stats.timer_expirations += expirations;
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_run(void) {
+    if (!g_reactor.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    g_reactor.running = true;
+    hal_status_t status = HAL_STATUS_OK;
+    while (!__atomic_load_n(&g_reactor.stop, __ATOMIC_ACQUIRE)) {
+        status = hal_reactor_run_once(-1);
+        if (status != HAL_STATUS_OK) {
+            break;
+        }
+    }
+    g_reactor.running = false;
+    __atomic_store_n(&g_reactor.stop, 0, __ATOMIC_RELEASE);
+    return status;
+}
+
+void hal_reactor_stop(void) {
+    __atomic_store_n(&g_reactor.stop, 1, __ATOMIC_RELEASE);
+    int fd = g_reactor.event_fd;
+    if (fd >= 0) {
+        uint64_t one = 1;
+        ssize_t rc = write(fd, &one, sizeof(one));
+        (void)rc;
+    }
+}
+
+hal_status_t hal_reactor_get_stats(hal_reactor_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_reactor.mutex);
+    *stats = g_reactor.stats;
+    stats->task_count = 0;
+    for (int i = 0; i < HAL_REACTOR_MAX_TASKS; i++) {
+        if (g_reactor.tasks[i].active) {
+            stats->task_count++;
+        }
+    }
+    stats->running = g_reactor.running;
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_get_task_stats(int task_id, hal_reactor_task_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_reactor.mutex);
+    if (!reactor_valid_task(task_id)) {
+        pthread_mutex_unlock(&g_reactor.mutex);
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *stats = g_reactor.tasks[task_id].stats;
+    stats->signals = __atomic_load_n(&g_reactor.tasks[task_id].stats.signals, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t hal_reactor_reset_stats(void) {
+    pthread_mutex_lock(&g_reactor.mutex);
+    memset(&g_reactor.stats, 0, sizeof(g_reactor.stats));
+    for (int i = 0; i < HAL_REACTOR_MAX_TASKS; i++) {
+        hal_reactor_task_stats_t *s = &g_reactor.tasks[i].stats;
+        s->runs = 0;
+        s->total_us = 0;
+        s->last_us = 0;
+        s->max_us = 0;
+        __atomic_store_n(&s->signals, 0U, __ATOMIC_RELAXED);
+        s->missed_periods = 0;
+        s->max_late_us = 0;
+    }
+    pthread_mutex_unlock(&g_reactor.mutex);
+    return HAL_STATUS_OK;
+}
+
+void hal_reactor_print_stats(void) {
+    hal_reactor_stats_t stats;
+    (void)hal_reactor_get_stats(&stats);
+    uint64_t total = stats.busy_us + stats.idle_us;
+    printf("[REACTOR] %llu wakeups, busy %.2f%% (%llu us), %u tasks\n",
+           (unsigned long long)stats.wakeups, total > 0 ? (double)stats.busy_us * 100.0 / (double)total : 0.0,
+           (unsigned long long)stats.busy_us, stats.task_count);
+    printf("[REACTOR] %-20s %8s %10s %9s %9s %9s %8s\n", "task", "period", "runs", "avg us", "max us", "late us",
+           "missed");
+    for (int i = 0; i < HAL_REACTOR_MAX_TASKS; i++) {
+        hal_reactor_task_stats_t task;
+        if (hal_reactor_get_task_stats(i, &task) != HAL_STATUS_OK) {
+            continue;
+        }
+        char period[12];
+        if (task.type == HAL_REACTOR_TASK_PERIODIC) {
+            snprintf(period, sizeof(period), "%ums", task.period_ms);
+        } else {
+            snprintf(period, sizeof(period), "%s", task.type == HAL_REACTOR_TASK_EVENT ? "event" : "fd");
+        }
+        printf("[REACTOR] %-20s %8s %10llu %9.1f %9u %9u %8llu\n", task.name, period, (unsigned long long)task.runs,
+               task.runs > 0 ? (double)task.total_us / (double)task.runs : 0.0, task.max_us, task.max_late_us,
+               (unsigned long long)task.missed_periods);
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ * @file hal_reactor.h
+ * @brief Event reactor for the main thread: periodic tasks, cross-thread events and fd watchers
+ * @version 1.0.0
+ * @date 2025-02-28
+ * @team FW
+ *
+ * One thread blocks in epoll_wait() until there is work, instead of
+ * polling timers and sleeping a fixed quantum. Three kinds of task:
+ *
+ *  - Periodic: kept in a hashed timer wheel (HAL_REACTOR_WHEEL_SLOTS slots
+ *    of HAL_REACTOR_TICK_MS). A single timerfd is armed, on
+ *    CLOCK_MONOTONIC, for the first occupied slot, so an idle reactor
+ *    wakes at most once per wheel revolution. Deadlines are fixed-rate:
+ *    a task that falls more than a period behind skips the periods it
+ *    missed rather than running back to back.
+ *  - Event: run on the reactor thread after hal_reactor_signal(), which
+ *    any thread (or a completion callback) may call. Signals are
+ *    coalesced: several signals before the task runs run it once.
+ *  - Fd: run when a file descriptor becomes ready (EPOLLIN etc.).
+ *
+ * Each dispatch latches hal_time_tick() first, so tasks read "now" from
+ * the tick. Every task's run count, run time and lateness are accounted,
+ * along with the time the reactor spends waiting versus running.
+ *
+ * Tasks are added and removed on the reactor thread (or before it
+ * runs); hal_reactor_signal() and hal_reactor_stop() are safe from any
+ * thread, and hal_reactor_stop() from a signal handler.
+ */
+
+#ifndef HAL_REACTOR_H
+#define HAL_REACTOR_H
+
+#include "hal_common.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_REACTOR_MAX_TASKS       32      // Event tasks use one bit each of a 32-bit pending mask
+#define HAL_REACTOR_TICK_MS         1       // Timer wheel resolution
+#define HAL_REACTOR_WHEEL_SLOTS     256     // One revolution: 256 ms
+#define HAL_REACTOR_NAME_LEN        24
+
+// Task kind
+typedef enum {
+    HAL_REACTOR_TASK_PERIODIC = 0,
+    HAL_REACTOR_TASK_EVENT,
+    HAL_REACTOR_TASK_FD
+} hal_reactor_task_type_t;
+
+/**
+ * @brief Periodic and event task body
+ * @param context Caller context
+ */
+typedef void (*hal_reactor_fn_t)(void *context);
+
+/**
+ * @brief Fd watcher body
+ * @param fd Ready file descriptor
+ * @param events Ready epoll events
+ * @param context Caller context
+ */
+typedef void (*hal_reactor_fd_fn_t)(int fd, uint32_t events, void *context);
+
+// Per-task accounting
+typedef struct {
+    char name[HAL_REACTOR_NAME_LEN];
+    hal_reactor_task_type_t type;
+    uint32_t period_ms;             // Periodic tasks only
+    uint64_t runs;
+    uint64_t total_us;              // Time spent in the task body
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t signals;               // Event tasks: hal_reactor_signal() calls (coalesced into runs)
+    uint64_t missed_periods;        // Periodic tasks: periods skipped after falling behind
+    uint32_t max_late_us;           // Periodic: start minus deadline; event: start minus first signal
+} hal_reactor_task_stats_t;
+
+// Reactor accounting
+typedef struct {
+    uint64_t wakeups;               // epoll_wait() returns
+    uint64_t busy_us;               // Dispatching tasks
+    uint64_t idle_us;               // Blocked in epoll_wait()
+    uint64_t timer_expirations;     // timerfd expirations read
+    uint32_t task_count;
+    bool running;
+} hal_reactor_stats_t;
+
+/**
+ * @brief Create the epoll, timerfd and eventfd descriptors
+ * @return HAL_STATUS_ALREADY_INITIALIZED if initialized, HAL_STATUS_ERROR if a descriptor cannot be created
+ */
+hal_status_t hal_reactor_init(void);
+
+/**
+ * @brief Remove all tasks and close the descriptors (fds being watched are not closed)
+ * @return HAL status
+ */
+hal_status_t hal_reactor_deinit(void);
+
+/**
+ * @brief Add a periodic task; its first run is due at once
+ * @param name Task name for statistics
+ * @param period_ms Period, at least HAL_REACTOR_TICK_MS
+ * @param fn Task body
+ * @param context Passed to fn
+ * @param task_id Output task id (may be NULL)
+ * @return HAL_STATUS_NO_MEMORY if the task table is full
+ */
+hal_status_t hal_reactor_add_periodic(const char *name, uint32_t period_ms, hal_reactor_fn_t fn, void *context,
+                                      int *task_id);
+
+/**
+ * @brief Add an event task, run after hal_reactor_signal()
+ * @param name Task name for statistics
+ * @param fn Task body
+ * @param context Passed to fn
+ * @param task_id Output task id (may be NULL)
+ * @return HAL_STATUS_NO_MEMORY if the task table is full
+ */
+hal_status_t hal_reactor_add_event(const char *name, hal_reactor_fn_t fn, void *context, int *task_id);
+
+/**
+ * @brief Watch a file descriptor
+ * @param name Task name for statistics
+ * @param fd Descriptor (the caller keeps ownership)
+ * @param events epoll events, e.g. EPOLLIN
+ * @param fn Called with the ready events
+ * @param context Passed to fn
+ * @param task_id Output task id (may be NULL)
+ * @return HAL_STATUS_ERROR if epoll refuses the descriptor
+ */
+hal_status_t hal_reactor_add_fd(const char *name, int fd, uint32_t events, hal_reactor_fd_fn_t fn, void *context,
+                                int *task_id);
+
+/**
+ * @brief Remove a task (a pending signal or due run is dropped)
+ * @param task_id Task id
+ * @return HAL_STATUS_INVALID_PARAMETER if there is no such task
+ */
+hal_status_t hal_reactor_remove(int task_id);
+
+/**
+ * @brief Change the period of a periodic task; the next run is due one new period from now
+ * @param task_id Task id
+ * @param period_ms New period
+ * @return HAL status
+ */
+hal_status_t hal_reactor_set_period(int task_id, uint32_t period_ms);
+
+/**
+ * @brief Ask for an event task to run on the reactor thread (any thread)
+ * @param task_id Event task id
+ * @return HAL_STATUS_INVALID_PARAMETER if task_id is not an event task
+ */
+hal_status_t hal_reactor_signal(int task_id);
+
+/**
+ * @brief Wait for work once and dispatch it
+ * @param timeout_ms Longest wait, -1 for no limit other than the next timer
+ * @return HAL_STATUS_OK, or HAL_STATUS_NOT_INITIALIZED
+ */
+hal_status_t hal_reactor_run_once(int timeout_ms);
+
+/**
+ * @brief Dispatch until hal_reactor_stop()
+ * @return HAL status
+ */
+hal_status_t hal_reactor_run(void);
+
+/**
+ * @brief Make hal_reactor_run() return after the current dispatch (any thread, async-signal-safe)
+ */
+void hal_reactor_stop(void);
+
+/**
+ * @brief Get reactor statistics
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t hal_reactor_get_stats(hal_reactor_stats_t *stats);
+
+/**
+ * @brief Get the statistics of one task
+ * @param task_id Task id
+ * @param stats Output
+ * @return HAL_STATUS_INVALID_PARAMETER if there is no such task
+ */
+hal_status_t hal_reactor_get_task_stats(int task_id, hal_reactor_task_stats_t *stats);
+
+/**
+ * @brief Clear reactor and task counters
+ * @return HAL status
+ */
+hal_status_t hal_reactor_reset_stats(void);
+
+/**
+ * @brief Print utilisation and a per-task table to stdout
+ */
+void hal_reactor_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_REACTOR_H
@@ -0,0 +1,87 @@
+/**
+ * @file hal_time.c
+ * @brief Single time base: monotonic clocks, a per-tick cached "now" and wall-clock mapping
+ * @version 1.0.0
+ * @date 2025-02-27
+ * @team FW
+ */
+
+#include "hal_time.h"
+#include <time.h>
+
+// Latched by hal_time_tick(), 0 until the first tick
+static uint64_t g_tick_us = 0;
+
+static inline uint64_t timespec_to_ns(const struct timespec *ts) {
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+static inline uint64_t read_clock_ns(clockid_t clock) {
+    struct timespec ts;
+    if (clock_gettime(clock, &ts) != 0) {
+        return 0;
+    }
+    return timespec_to_ns(&ts);
+}
+
+uint64_t hal_time_now_ns(void) {
+    return read_clock_ns(CLOCK_MONOTONIC);
+}
+
+uint64_t hal_time_now_us(void) {
+    return read_clock_ns(CLOCK_MONOTONIC) / 1000ULL;
+}
+
+uint64_t hal_time_now_ms(void) {
+    return read_clock_ns(CLOCK_MONOTONIC) / 1000000ULL;
+}
+
+uint64_t hal_time_coarse_ms(void) {
+#ifdef CLOCK_MONOTONIC_COARSE
+    return read_clock_ns(CLOCK_MONOTONIC_COARSE) / 1000000ULL;
+#else
+    return hal_time_now_ms();
+#endif
+}
+
+uint64_t hal_time_coarse_resolution_ns(void) {
+    struct timespec res;
+#ifdef CLOCK_MONOTONIC_COARSE
+    if (clock_getres(CLOCK_MONOTONIC_COARSE, &res) == 0) {
+        return timespec_to_ns(&res);
+    }
+#endif
+    if (clock_getres(CLOCK_MONOTONIC, &res) == 0) {
+        return timespec_to_ns(&res);
+    }
+    return 1;
+}
+
+uint64_t hal_time_tick(void) {
+    uint64_t now = hal_time_now_us();
+    __atomic_store_n(&g_tick_us, now, __ATOMIC_RELAXED);
+    return now;
+}
+
+uint64_t hal_time_tick_us(void) {
+    uint64_t tick = __atomic_load_n(&g_tick_us, __ATOMIC_RELAXED);
+    return tick != 0 ? tick : hal_time_now_us();
+}
+
+uint64_t hal_time_tick_ms(void) {
+    return hal_time_tick_us() / 1000ULL;
+}
+
+uint64_t hal_time_wall_ms(void) {
+    return read_clock_ns(CLOCK_REALTIME) / 1000000ULL;
+}
+
+uint64_t hal_time_to_wall_ms(uint64_t monotonic_ms) {
+    uint64_t mono_now = hal_time_now_ms();
+    uint64_t wall_now = hal_time_wall_ms();
+    if (monotonic_ms >= mono_now) {
+        return wall_now + (monotonic_ms - mono_now);
+    }
+    uint64_t age = mono_now - monotonic_ms;
+    return age < wall_now ? wall_now - age : 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file hal_time.h
+ * @brief Single time base: monotonic clocks, a per-tick cached "now" and wall-clock mapping
+ * @version 1.0.0
+ * @date 2025-02-27
+ * @team FW
+ *
+ * Every timeout, rate and age in the firmware is measured on
+ * CLOCK_MONOTONIC, which never steps when NTP or an operator sets the
+ * date. On Linux clock_gettime() for the monotonic clocks is served from
+ * the vDSO, so no system call is made:
+ *   hal_time_now_ns/us/ms  CLOCK_MONOTONIC, full resolution
+ *   hal_time_coarse_ms     CLOCK_MONOTONIC_COARSE, last scheduler tick
+ *                          (1-4 ms resolution), cheapest read there is
+ *   hal_time_tick_ms/us    value latched by the last hal_time_tick(); a
+ *                          plain memory load for loops that only need
+ *                          "now" to within one loop iteration
+ *
+ * Wall-clock time (CLOCK_REALTIME, Unix epoch) is for reporting only:
+ * API and telemetry timestamps and persisted records. Never subtract two
+ * wall-clock values to measure an interval.
+ */
+
+#ifndef HAL_TIME_H
+#define HAL_TIME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Monotonic time in nanoseconds (arbitrary epoch, typically boot)
+ * @return Nanoseconds
+ */
+uint64_t hal_time_now_ns(void);
+
+/**
+ * @brief Monotonic time in microseconds
+ * @return Microseconds
+ */
+uint64_t hal_time_now_us(void);
+
+/**
+ * @brief Monotonic time in milliseconds
+ * @return Milliseconds
+ */
+uint64_t hal_time_now_ms(void);
+
+/**
+ * @brief Coarse monotonic time in milliseconds, same epoch as hal_time_now_ms()
+ *
+ * Lags the precise clock by up to one scheduler tick; good for timeouts
+ * of tens of milliseconds and up.
+ *
+ * @return Milliseconds
+ */
+uint64_t hal_time_coarse_ms(void);
+
+/**
+ * @brief Resolution of the coarse clock
+ * @return Nanoseconds per step
+ */
+uint64_t hal_time_coarse_resolution_ns(void);
+
+/**
+ * @brief Latch "now" for hal_time_tick_ms()/hal_time_tick_us()
+ *
+ * Called once at the top of each main loop iteration. Readers in any
+ * thread see the latest latched value.
+ *
+ * @return The latched monotonic time in microseconds
+ */
+uint64_t hal_time_tick(void);
+
+/**
+ * @brief Monotonic time latched by the last hal_time_tick()
+ * @return Microseconds; a live reading if hal_time_tick() was never called
+ */
+uint64_t hal_time_tick_us(void);
+
+/**
+ * @brief Monotonic time latched by the last hal_time_tick()
+ * @return Milliseconds; a live reading if hal_time_tick() was never called
+ */
+uint64_t hal_time_tick_ms(void);
+
+/**
+ * @brief Wall-clock time for reporting
+ * @return Milliseconds since the Unix epoch
+ */
+uint64_t hal_time_wall_ms(void);
+
+/**
+ * @brief Convert a monotonic timestamp to wall-clock time for reporting
+ *
+ * Uses the current offset between the two clocks, so a timestamp taken
+ * before a clock step is reported in the new wall-clock frame.
+ *
+ * @param monotonic_ms Monotonic milliseconds (hal_time_now_ms() and friends)
+ * @return Milliseconds since the Unix epoch
+ */
+uint64_t hal_time_to_wall_ms(uint64_t monotonic_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_TIME_H
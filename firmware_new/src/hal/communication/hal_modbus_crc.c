@@ -0,0 +1,198 @@
+/**
+ * @file hal_modbus_crc.c
+ * @brief Modbus RTU CRC16 kernels (bitwise reference, table, slice-by-8)
+ * @version 1.0.0
+ * @date 2025-02-17
+ * @team EMBED
+ */
+
+#include "hal_modbus_crc.h"
+#include <stdio.h>
+#include <pthread.h>
+
+#define CRC16_POLY_REFLECTED    0xA001U
+#define CRC16_SLICES            8
+#define CRC16_SELF_TEST_BYTES   300
+
+// crc16_table[0] is the classic byte table; crc16_table[k][i] advances entry i by k more zero bytes
+static uint16_t crc16_table[CRC16_SLICES][256] = {
+    {
+        0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+        0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+        0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+        0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+        0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+        0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+        0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+        0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+        0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+        0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+        0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+        0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+        0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+        0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+        0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+        0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+        0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+        0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+        0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+        0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+        0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+        0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+        0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+        0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+        0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+        0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+        0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+        0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+        0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+        0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+        0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+        0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+    }
+};
+
+static pthread_once_t g_tables_once = PTHREAD_ONCE_INIT;
+static pthread_once_t g_select_once = PTHREAD_ONCE_INIT;
+static modbus_crc16_impl_t g_active_impl = MODBUS_CRC16_IMPL_TABLE;
+
+static uint16_t crc16_bitwise(uint16_t crc, const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ CRC16_POLY_REFLECTED) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc16_table_update(uint16_t crc, const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = (uint16_t)((crc >> 8) ^ crc16_table[0][(crc ^ data[i]) & 0xFFU]);
+    }
+    return crc;
+}
+
+static uint16_t crc16_slice8_update(uint16_t crc, const uint8_t *data, size_t length) {
+    while (length >= CRC16_SLICES) {
+        uint16_t c = (uint16_t)(crc ^ ((uint16_t)data[0] | ((uint16_t)data[1] << 8)));
+        crc = (uint16_t)(crc16_table[7][c & 0xFFU] ^ crc16_table[6][c >> 8] ^
+                         crc16_table[5][data[2]] ^ crc16_table[4][data[3]] ^
+                         crc16_table[3][data[4]] ^ crc16_table[2][data[5]] ^
+                         crc16_table[1][data[6]] ^ crc16_table[0][data[7]]);
+        data += CRC16_SLICES;
+        length -= CRC16_SLICES;
+    }
+    return crc16_table_update(crc, data, length);
+}
+
+static void crc16_build_tables(void) {
+    for (int k = 1; k < CRC16_SLICES; k++) {
+        for (int i = 0; i < 256; i++) {
+            uint16_t prev = crc16_table[k - 1][i];
+            crc16_table[k][i] = (uint16_t)((prev >> 8) ^ crc16_table[0][prev & 0xFFU]);
+        }
+    }
+}
+
+static void crc16_select(void) {
+    if (modbus_crc16_self_test() == HAL_STATUS_OK) {
+        g_active_impl = MODBUS_CRC16_IMPL_SLICE8;
+    } else {
+        printf("[MODBUS-CRC] WARNING: slice-by-8 self-test failed, using table CRC\n");
+        g_active_impl = MODBUS_CRC16_IMPL_TABLE;
+    }
+}
+
+uint16_t modbus_crc16_update_with(modbus_crc16_impl_t impl, uint16_t crc, const uint8_t *data, size_t length) {
+    if (data == NULL) {
+        return crc;
+    }
+    switch (impl) {
+        case MODBUS_CRC16_IMPL_BITWISE:
+            return crc16_bitwise(crc, data, length);
+        case MODBUS_CRC16_IMPL_SLICE8:
+            pthread_once(&g_tables_once, crc16_build_tables);
+            return crc16_slice8_update(crc, data, length);
+        case MODBUS_CRC16_IMPL_TABLE:
+        default:
+            return crc16_table_update(crc, data, length);
+    }
+}
+
+uint16_t modbus_crc16_update(uint16_t crc, const uint8_t *data, size_t length) {
+    pthread_once(&g_select_once, crc16_select);
+    if (data == NULL) {
+        return crc;
+    }
+    return g_active_impl == MODBUS_CRC16_IMPL_SLICE8 ? crc16_slice8_update(crc, data, length)
+                                                      : crc16_table_update(crc, data, length);
+}
+
+uint16_t modbus_crc16(const uint8_t *data, size_t length) {
+    return modbus_crc16_update(MODBUS_CRC16_INIT, data, length);
+}
+
+size_t modbus_crc16_append(uint8_t *frame, size_t length) {
+    uint16_t crc = modbus_crc16(frame, length);
+    frame[length] = (uint8_t)(crc & 0xFFU);
+    frame[length + 1] = (uint8_t)(crc >> 8);
+    return length + 2;
+}
+
+bool modbus_crc16_check_frame(const uint8_t *frame, size_t length) {
+    if (frame == NULL || length < 3) {
+        return false;
+    }
+    // Running the CRC over the trailing (LSB-first) CRC bytes as well leaves zero
+    return modbus_crc16(frame, length) == MODBUS_CRC16_RESIDUE;
+}
+
+hal_status_t modbus_crc16_self_test(void) {
+    static const uint8_t check_input[] = "123456789";
+    uint8_t buf[CRC16_SELF_TEST_BYTES + CRC16_SLICES];
+    uint32_t x = 0x2545F491U;
+
+    pthread_once(&g_tables_once, crc16_build_tables);
+
+    // Published check value of CRC-16/MODBUS
+    if (crc16_bitwise(MODBUS_CRC16_INIT, check_input, 9) != 0x4B37U) {
+        return HAL_STATUS_ERROR;
+    }
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (uint8_t)x;
+    }
+    // Every length up to a few slices at every alignment, plus long buffers, plus split updates
+    for (size_t offset = 0; offset < CRC16_SLICES; offset++) {
+        for (size_t length = 0; length + offset <= CRC16_SELF_TEST_BYTES; length += (length < 40U) ? 1U : 37U) {
+            const uint8_t *p = buf + offset;
+            uint16_t ref = crc16_bitwise(MODBUS_CRC16_INIT, p, length);
+            if (crc16_table_update(MODBUS_CRC16_INIT, p, length) != ref ||
+                crc16_slice8_update(MODBUS_CRC16_INIT, p, length) != ref) {
+                return HAL_STATUS_ERROR;
+            }
+            size_t split = length / 3U;
+            if (crc16_slice8_update(crc16_slice8_update(MODBUS_CRC16_INIT, p, split), p + split, length - split) != ref) {
+                return HAL_STATUS_ERROR;
+            }
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+modbus_crc16_impl_t modbus_crc16_active_impl(void) {
+    pthread_once(&g_select_once, crc16_select);
+    return g_active_impl;
+}
+
+const char* modbus_crc16_impl_name(modbus_crc16_impl_t impl) {
+    switch (impl) {
+        case MODBUS_CRC16_IMPL_BITWISE: return "bitwise";
+        case MODBUS_CRC16_IMPL_TABLE:   return "table";
+        case MODBUS_CRC16_IMPL_SLICE8:  return "slice8";
+        default:                        return "unknown";
+    }
+}
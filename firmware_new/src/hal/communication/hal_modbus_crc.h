@@ -0,0 +1,105 @@
+/**
+ * @file hal_modbus_crc.h
+ * @brief Modbus RTU CRC16 (poly 0xA001 reflected, init 0xFFFF)
+ * @version 1.0.0
+ * @date 2025-02-17
+ * @team EMBED
+ *
+ * One implementation for every Modbus code path. modbus_crc16() uses a
+ * slice-by-8 kernel (8 table lookups per 8 bytes) once a self-test against
+ * the bit-at-a-time reference has passed, and the 256-entry table kernel
+ * otherwise. The update form takes a running CRC so frames can be checked
+ * while they are still being received.
+ */
+
+#ifndef HAL_MODBUS_CRC_H
+#define HAL_MODBUS_CRC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MODBUS_CRC16_INIT       0xFFFFU     // Running CRC before the first byte
+#define MODBUS_CRC16_RESIDUE    0x0000U     // CRC over a frame including its own (LSB-first) CRC
+
+// CRC kernels
+typedef enum {
+    MODBUS_CRC16_IMPL_BITWISE = 0,          // Reference, one bit per step
+    MODBUS_CRC16_IMPL_TABLE,                // One 256-entry lookup per byte
+    MODBUS_CRC16_IMPL_SLICE8                // Eight lookups per 8 bytes
+} modbus_crc16_impl_t;
+
+/**
+ * @brief CRC of a buffer with the selected kernel
+ * @param data Bytes (slave address through last data byte)
+ * @param length Number of bytes
+ * @return CRC, to be sent low byte first
+ */
+uint16_t modbus_crc16(const uint8_t *data, size_t length);
+
+/**
+ * @brief Fold more bytes into a running CRC (start from MODBUS_CRC16_INIT)
+ * @param crc Running CRC
+ * @param data Bytes
+ * @param length Number of bytes
+ * @return Updated CRC
+ */
+uint16_t modbus_crc16_update(uint16_t crc, const uint8_t *data, size_t length);
+
+/**
+ * @brief CRC of a buffer with a specific kernel (tests and benchmarks)
+ * @param impl Kernel
+ * @param crc Running CRC
+ * @param data Bytes
+ * @param length Number of bytes
+ * @return Updated CRC
+ */
+uint16_t modbus_crc16_update_with(modbus_crc16_impl_t impl, uint16_t crc, const uint8_t *data, size_t length);
+
+/**
+ * @brief Append the CRC of frame[0..length) at frame[length], low byte first
+ * @param frame Frame with room for two more bytes
+ * @param length Frame length without CRC
+ * @return Frame length including CRC
+ */
+size_t modbus_crc16_append(uint8_t *frame, size_t length);
+
+/**
+ * @brief Check the trailing CRC of a complete frame
+ * @param frame Frame including its CRC
+ * @param length Frame length including CRC
+ * @return true if the CRC matches
+ */
+bool modbus_crc16_check_frame(const uint8_t *frame, size_t length);
+
+/**
+ * @brief Compare the table and slice-by-8 kernels with the reference
+ *
+ * Runs once on first use of modbus_crc16(); slice-by-8 is only selected
+ * if this passes.
+ *
+ * @return HAL_STATUS_OK if every kernel matches the reference
+ */
+hal_status_t modbus_crc16_self_test(void);
+
+/**
+ * @brief Kernel used by modbus_crc16()/modbus_crc16_update()
+ * @return Kernel
+ */
+modbus_crc16_impl_t modbus_crc16_active_impl(void);
+
+/**
+ * @brief Kernel name, e.g. "slice8"
+ */
+const char* modbus_crc16_impl_name(modbus_crc16_impl_t impl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_MODBUS_CRC_H
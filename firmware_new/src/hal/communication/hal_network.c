@@ -52,7 +52,6 @@ static network_type_t backup_network = NETWORK_TYPE_WIFI;
 static network_type_t active_network = NETWORK_TYPE_ETHERNET;
 
 // Internal functions
-static uint64_t get_timestamp_ms(void);
 static void* network_monitor_thread_func(void *arg);
 static hal_status_t execute_command(const char *command, char *output, size_t output_size);
 static hal_status_t get_interface_status(const char *interface, bool *up, char *ip_address);
@@ -178,7 +177,7 @@ hal_status_t hal_network_connect(network_type_t type) {
     if (status == HAL_STATUS_OK) {
         network_status.state = NETWORK_STATE_CONNECTED;
         network_status.active_type = type;
-        network_status.connection_time = get_timestamp_ms();
+        network_status.connection_time = hal_time_now_ms();
 
         // Call callback if set
         if (network_callback != NULL) {
@@ -896,12 +895,6 @@ hal_status_t hal_network_switch_to_primary(void) {
 }
 
 // Internal helper functions
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-}
-
 __attribute__((unused))
 static void* network_monitor_thread_func(void *arg) {
     (void)arg; // Unused parameter
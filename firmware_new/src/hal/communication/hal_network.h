@@ -74,7 +74,7 @@ typedef struct {
     uint32_t latency_ms;
     uint64_t bytes_sent;
     uint64_t bytes_received;
-    uint32_t connection_time;
+    uint64_t connection_time;   // Monotonic ms (hal_time_now_ms) of the last connect
     uint32_t disconnect_count;
 } network_status_t;
 
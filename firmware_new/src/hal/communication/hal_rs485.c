@@ -11,6 +11,8 @@
 #define _DEFAULT_SOURCE
 #include "hal_rs485.h"
 #include "hal_common.h"
+#include "hal_log.h"
+#include "hal_modbus_crc.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -31,6 +33,7 @@ static struct {
     rs485_statistics_t statistics;
     rs485_device_info_t device_info;
     uint64_t last_operation_time_us;
+    uint64_t last_tx_complete_us;   // TX drained onto the wire (latency reference)
     uint32_t retry_count;
     uint32_t max_retries;
     uint32_t retry_delay_ms;
@@ -40,7 +43,7 @@ static struct {
 static hal_status_t rs485_open_device(void);
 static hal_status_t rs485_close_device(void);
 static hal_status_t rs485_configure_serial(void);
-static uint64_t rs485_get_timestamp_us(void);
+static void rs485_record_rx_latency(uint64_t complete_time_us);
 
 /**
  * @brief Initialize RS485 HAL
@@ -81,7 +84,7 @@ hal_status_t hal_rs485_init(const rs485_config_t *config)
     rs485_state.device_info.rs485_status = RS485_STATUS_IDLE;
     strcpy(rs485_state.device_info.device_name, "RS485_UART1");
     strcpy(rs485_state.device_info.device_version, "1.0.0");
-    rs485_state.device_info.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.device_info.timestamp_us = hal_time_now_us();
     rs485_state.device_info.error_count = 0;
     rs485_state.device_info.warning_count = 0;
     
@@ -212,7 +215,7 @@ hal_status_t hal_rs485_transmit(const uint8_t *data, size_t length)
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    printf("[HAL-RS485-TX] Transmitting %zu bytes to %s\n", length, rs485_state.config.device_path);
+    HAL_LOGD(HAL_LOG_COMP_RS485, "[HAL-RS485-TX] Transmitting %zu bytes to %s", length, rs485_state.config.device_path);
     
     hal_status_t result = HAL_STATUS_ERROR;
     uint32_t current_retry = 0;
@@ -229,6 +232,7 @@ hal_status_t hal_rs485_transmit(const uint8_t *data, size_t length)
         if (written == (ssize_t)length) {
             // Ensure bytes are on-the-wire before switching to RX
             tcdrain(rs485_state.device_fd);
+            rs485_state.last_tx_complete_us = hal_time_now_us();
         }
         
         // Update status
@@ -238,11 +242,12 @@ hal_status_t hal_rs485_transmit(const uint8_t *data, size_t length)
             // Success - update statistics
             rs485_state.statistics.bytes_transmitted += length;
             rs485_state.statistics.frames_transmitted++;
-            rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+            rs485_state.statistics.timestamp_us = hal_time_now_us();
             rs485_state.last_operation_time_us = rs485_state.statistics.timestamp_us;
             rs485_state.retry_count = 0; // Reset retry count on success
             
-            printf("[HAL-RS485-TX] Success: %zu bytes written\n", written);
+            HAL_LOGD(HAL_LOG_COMP_RS485, "[HAL-RS485-TX] Success: %zd bytes written", written);
+            HAL_LOG_TRACE_FRAME(data[0], HAL_LOG_TRACE_TX, data, length);
             result = HAL_STATUS_OK;
             break;
         } else {
@@ -251,8 +256,9 @@ hal_status_t hal_rs485_transmit(const uint8_t *data, size_t length)
             rs485_state.device_info.error_count++;
             rs485_state.retry_count++;
             
-            printf("[HAL-RS485-TX] Error: written=%zd, expected=%zu, retry=%u/%u\n", 
-                   written, length, current_retry, rs485_state.max_retries);
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_WARNING, 1000,
+                                "[HAL-RS485-TX] Error: written=%zd, expected=%zu, retry=%u/%u",
+                                written, length, current_retry, rs485_state.max_retries);
             
             if (current_retry < rs485_state.max_retries) {
                 // Exponential backoff: delay *= 2
@@ -261,7 +267,8 @@ hal_status_t hal_rs485_transmit(const uint8_t *data, size_t length)
                 current_retry++;
             } else {
                 // Max retries reached
-                printf("[HAL-RS485-TX] Max retries reached, giving up\n");
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_ERROR, 1000,
+                                    "[HAL-RS485-TX] Max retries reached, giving up");
                 result = HAL_STATUS_IO_ERROR;
                 break;
             }
@@ -296,14 +303,14 @@ hal_status_t hal_rs485_send_receive(const uint8_t *tx_data, size_t tx_length,
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    printf("[HAL-RS485-TX-RX] Send/Receive: TX=%zu bytes, RX max=%zu bytes\n", tx_length, max_rx_length);
+    HAL_LOGD(HAL_LOG_COMP_RS485, "[HAL-RS485-TX-RX] Send/Receive: TX=%zu bytes, RX max=%zu bytes", tx_length, max_rx_length);
     
     hal_status_t result = HAL_STATUS_ERROR;
     
     // 1. Transmit data
     hal_status_t tx_result = hal_rs485_transmit(tx_data, tx_length);
     if (tx_result != HAL_STATUS_OK) {
-        printf("[HAL-RS485-TX-RX] Transmit failed\n");
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_WARNING, 1000, "[HAL-RS485-TX-RX] Transmit failed");
         pthread_mutex_unlock(&rs485_state.mutex);
         return tx_result;
     }
@@ -314,10 +321,10 @@ hal_status_t hal_rs485_send_receive(const uint8_t *tx_data, size_t tx_length,
     // 3. Receive response
     hal_status_t rx_result = hal_rs485_receive(rx_buffer, max_rx_length, actual_rx_length);
     if (rx_result != HAL_STATUS_OK) {
-        printf("[HAL-RS485-TX-RX] Receive failed\n");
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_WARNING, 1000, "[HAL-RS485-TX-RX] Receive failed");
         result = rx_result;
     } else {
-        printf("[HAL-RS485-TX-RX] Success: RX=%zu bytes\n", *actual_rx_length);
+        HAL_LOGD(HAL_LOG_COMP_RS485, "[HAL-RS485-TX-RX] Success: RX=%zu bytes", *actual_rx_length);
         result = HAL_STATUS_OK;
     }
     
@@ -353,25 +360,18 @@ hal_status_t hal_rs485_receive(uint8_t *buffer, size_t max_length, size_t *actua
     
     // Read data with timeout, accumulate until no more data or deadline
     fd_set read_fds;
-    struct timeval deadline;
-    struct timeval now;
-    gettimeofday(&deadline, NULL);
-    long add_usec = (long)rs485_state.config.timeout_ms * 1000L;
-    deadline.tv_sec += add_usec / 1000000L;
-    deadline.tv_usec += add_usec % 1000000L;
-    if (deadline.tv_usec >= 1000000L) { deadline.tv_sec += 1; deadline.tv_usec -= 1000000L; }
+    const uint64_t deadline_us = hal_time_now_us() + (uint64_t)rs485_state.config.timeout_ms * 1000ULL;
     
     size_t total_received = 0;
-    printf("[HAL-RS485-RX] Waiting for data (timeout=%u ms)...\n", rs485_state.config.timeout_ms);
+    HAL_LOGD(HAL_LOG_COMP_RS485, "[HAL-RS485-RX] Waiting for data (timeout=%u ms)...", rs485_state.config.timeout_ms);
     while (total_received < max_length) {
-        gettimeofday(&now, NULL);
-        long rem_sec = (long)deadline.tv_sec - (long)now.tv_sec;
-        long rem_usec = (long)deadline.tv_usec - (long)now.tv_usec;
-        if (rem_usec < 0) { rem_sec -= 1; rem_usec += 1000000L; }
-        if (rem_sec < 0 || (rem_sec == 0 && rem_usec <= 0)) {
+        uint64_t now_us = hal_time_now_us();
+        if (now_us >= deadline_us) {
             break;
         }
-        struct timeval timeout = { .tv_sec = rem_sec, .tv_usec = rem_usec };
+        uint64_t remaining_us = deadline_us - now_us;
+        struct timeval timeout = { .tv_sec = (time_t)(remaining_us / 1000000ULL),
+                                   .tv_usec = (suseconds_t)(remaining_us % 1000000ULL) };
         FD_ZERO(&read_fds);
         FD_SET(rs485_state.device_fd, &read_fds);
         int select_result = select(rs485_state.device_fd + 1, &read_fds, NULL, NULL, &timeout);
@@ -385,13 +385,13 @@ hal_status_t hal_rs485_receive(uint8_t *buffer, size_t max_length, size_t *actua
             } else if (received == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
                 continue;
             } else {
-                printf("[HAL-RS485-RX] Read error: %s\n", strerror(errno));
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_ERROR, 1000, "[HAL-RS485-RX] Read error: %s", strerror(errno));
                 break;
             }
         } else if (select_result == 0) {
             break;
         } else {
-            printf("[HAL-RS485-RX] Select error: %s\n", strerror(errno));
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_ERROR, 1000, "[HAL-RS485-RX] Select error: %s", strerror(errno));
             break;
         }
     }
@@ -400,14 +400,16 @@ hal_status_t hal_rs485_receive(uint8_t *buffer, size_t max_length, size_t *actua
         *actual_length = total_received;
         rs485_state.statistics.bytes_received += total_received;
         rs485_state.statistics.frames_received++;
-        rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+        rs485_state.statistics.timestamp_us = hal_time_now_us();
         rs485_state.last_operation_time_us = rs485_state.statistics.timestamp_us;
-        printf("[HAL-RS485-RX] Success: received %zu bytes\n", total_received);
+        HAL_LOGD(HAL_LOG_COMP_RS485, "[HAL-RS485-RX] Success: received %zu bytes", total_received);
+        HAL_LOG_TRACE_FRAME(buffer[0], HAL_LOG_TRACE_RX, buffer, total_received);
         rs485_state.device_info.rs485_status = RS485_STATUS_IDLE;
         pthread_mutex_unlock(&rs485_state.mutex);
         return HAL_STATUS_OK;
     } else {
-        printf("[HAL-RS485-RX] Timeout after %u ms\n", rs485_state.config.timeout_ms);
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_WARNING, 1000,
+                            "[HAL-RS485-RX] Timeout after %u ms", rs485_state.config.timeout_ms);
     }
     
     // Update status
@@ -421,6 +423,140 @@ hal_status_t hal_rs485_receive(uint8_t *buffer, size_t max_length, size_t *actua
     return HAL_STATUS_TIMEOUT;
 }
 
+/**
+ * @brief Receive one Modbus RTU response frame
+ *
+ * Unlike hal_rs485_receive(), this does not wait out the full timeout.
+ * The configured timeout only bounds the wait for the first byte; after
+ * that the expected frame length is derived from the function code and
+ * byte count, and the call returns as soon as the frame is complete or
+ * a t3.5 inter-frame silence is observed at the configured baud rate.
+ *
+ * @param buffer Buffer to store received frame
+ * @param max_length Maximum buffer length
+ * @param actual_length Actual received length
+ * @return HAL status
+ */
+hal_status_t hal_rs485_receive_modbus(uint8_t *buffer, size_t max_length, size_t *actual_length)
+{
+    return hal_rs485_receive_modbus_timeout(buffer, max_length, actual_length, 0);
+}
+
+/**
+ * @brief Receive one Modbus RTU response frame with a per-call first-byte timeout
+ * @param buffer Buffer to store received frame
+ * @param max_length Maximum buffer length
+ * @param actual_length Actual received length
+ * @param timeout_ms Wait for the first byte; 0 uses the configured timeout
+ * @return HAL status
+ */
+hal_status_t hal_rs485_receive_modbus_timeout(uint8_t *buffer, size_t max_length, size_t *actual_length,
+                                              uint32_t timeout_ms)
+{
+    if (!buffer || !actual_length || max_length == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    pthread_mutex_lock(&rs485_state.mutex);
+    
+    if (!rs485_state.initialized || !rs485_state.device_open) {
+        pthread_mutex_unlock(&rs485_state.mutex);
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    rs485_state.device_info.rs485_status = RS485_STATUS_RECEIVING;
+    
+    if (timeout_ms == 0) {
+        timeout_ms = rs485_state.config.timeout_ms;
+    }
+    const uint64_t silence_us = (uint64_t)modbus_rtu_t35_us(rs485_state.config.baud_rate) +
+                                MODBUS_RTU_SILENCE_SLACK_US;
+    const uint64_t deadline_us = hal_time_now_us() + (uint64_t)timeout_ms * 1000ULL;
+    size_t total_received = 0;
+    size_t expected_length = 0;
+    bool complete_by_length = false;
+    uint16_t running_crc = MODBUS_CRC16_INIT;   // Folded in per chunk while the rest is on the wire
+    fd_set read_fds;
+    
+    while (total_received < max_length) {
+        uint64_t now_us = hal_time_now_us();
+        if (now_us >= deadline_us) {
+            break;
+        }
+        
+        // Before the first byte wait for the response timeout, afterwards only for t3.5
+        uint64_t wait_us = deadline_us - now_us;
+        if (total_received > 0 && wait_us > silence_us) {
+            wait_us = silence_us;
+        }
+        
+        struct timeval timeout = {
+            .tv_sec = (time_t)(wait_us / 1000000ULL),
+            .tv_usec = (suseconds_t)(wait_us % 1000000ULL)
+        };
+        FD_ZERO(&read_fds);
+        FD_SET(rs485_state.device_fd, &read_fds);
+        int select_result = select(rs485_state.device_fd + 1, &read_fds, NULL, NULL, &timeout);
+        if (select_result > 0) {
+            ssize_t received = read(rs485_state.device_fd, buffer + total_received, max_length - total_received);
+            if (received > 0) {
+                running_crc = modbus_crc16_update(running_crc, buffer + total_received, (size_t)received);
+                total_received += (size_t)received;
+                if (expected_length == 0) {
+                    expected_length = modbus_rtu_expected_frame_length(buffer, total_received);
+                }
+                if (expected_length > 0 && total_received >= expected_length) {
+                    complete_by_length = true;
+                    break;
+                }
+                continue;
+            } else if (received == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                continue;
+            } else {
+                HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_ERROR, 1000, "[HAL-RS485-RX] Read error: %s", strerror(errno));
+                break;
+            }
+        } else if (select_result == 0) {
+            // t3.5 silence after data ends the frame; silence before data is a timeout
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_ERROR, 1000, "[HAL-RS485-RX] Select error: %s", strerror(errno));
+            break;
+        }
+    }
+    
+    rs485_state.device_info.rs485_status = RS485_STATUS_IDLE;
+    
+    if (total_received == 0) {
+        rs485_state.statistics.errors_timeout++;
+        rs485_state.device_info.error_count++;
+        pthread_mutex_unlock(&rs485_state.mutex);
+        return HAL_STATUS_TIMEOUT;
+    }
+    
+    uint64_t complete_us = hal_time_now_us();
+    *actual_length = total_received;
+    rs485_state.statistics.bytes_received += total_received;
+    rs485_state.statistics.frames_received++;
+    if (running_crc != MODBUS_CRC16_RESIDUE) {
+        rs485_state.statistics.errors_crc++;
+    }
+    if (complete_by_length) {
+        rs485_state.statistics.frames_complete_by_length++;
+    } else {
+        rs485_state.statistics.frames_complete_by_silence++;
+    }
+    rs485_record_rx_latency(complete_us);
+    HAL_LOG_TRACE_FRAME(buffer[0], HAL_LOG_TRACE_RX, buffer, total_received);
+    rs485_state.statistics.timestamp_us = complete_us;
+    rs485_state.last_operation_time_us = complete_us;
+    
+    pthread_mutex_unlock(&rs485_state.mutex);
+    return HAL_STATUS_OK;
+}
+
 /**
  * @brief Get RS485 status
  * @param status Pointer to status structure
@@ -485,7 +621,7 @@ hal_status_t hal_rs485_reset_statistics(void)
     }
     
     memset(&rs485_state.statistics, 0, sizeof(rs485_statistics_t));
-    rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.statistics.timestamp_us = hal_time_now_us();
     
     pthread_mutex_unlock(&rs485_state.mutex);
     
@@ -537,7 +673,7 @@ hal_status_t hal_rs485_record_transport_success(void)
     }
     
     rs485_state.statistics.transport_success_count++;
-    rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.statistics.timestamp_us = hal_time_now_us();
     
     pthread_mutex_unlock(&rs485_state.mutex);
     return HAL_STATUS_OK;
@@ -553,7 +689,7 @@ hal_status_t hal_rs485_record_semantic_success(void)
     }
     
     rs485_state.statistics.semantic_success_count++;
-    rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.statistics.timestamp_us = hal_time_now_us();
     
     pthread_mutex_unlock(&rs485_state.mutex);
     return HAL_STATUS_OK;
@@ -569,7 +705,7 @@ hal_status_t hal_rs485_record_all_zero_payload(void)
     }
     
     rs485_state.statistics.all_zero_payload_count++;
-    rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.statistics.timestamp_us = hal_time_now_us();
     
     pthread_mutex_unlock(&rs485_state.mutex);
     return HAL_STATUS_OK;
@@ -585,7 +721,7 @@ hal_status_t hal_rs485_record_malformed_frame(void)
     }
     
     rs485_state.statistics.malformed_frame_count++;
-    rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.statistics.timestamp_us = hal_time_now_us();
     
     pthread_mutex_unlock(&rs485_state.mutex);
     return HAL_STATUS_OK;
@@ -601,7 +737,7 @@ hal_status_t hal_rs485_record_invalid_data(void)
     }
     
     rs485_state.statistics.invalid_data_count++;
-    rs485_state.statistics.timestamp_us = rs485_get_timestamp_us();
+    rs485_state.statistics.timestamp_us = hal_time_now_us();
     
     pthread_mutex_unlock(&rs485_state.mutex);
     return HAL_STATUS_OK;
@@ -672,8 +808,57 @@ hal_status_t rs485_validate_config(const rs485_config_t *config)
 
 // Modbus functions - Removed for OHT-50 Master Module
 hal_status_t modbus_validate_config(const modbus_config_t *config __attribute__((unused))) { return HAL_STATUS_NOT_SUPPORTED; }
-uint16_t modbus_calculate_crc(const uint8_t *data, size_t length) { (void)data; (void)length; return 0; }
-bool modbus_verify_crc(const uint8_t *data, size_t length, uint16_t crc) { (void)data; (void)length; (void)crc; return false; }
+uint16_t modbus_calculate_crc(const uint8_t *data, size_t length) { return modbus_crc16(data, length); }
+bool modbus_verify_crc(const uint8_t *data, size_t length, uint16_t crc) { return data != NULL && modbus_crc16(data, length) == crc; }
+
+/**
+ * @brief Expected length of a Modbus RTU response frame from its header
+ * @param frame Frame bytes received so far
+ * @param length Number of bytes received so far
+ * @return Total frame length including CRC, or 0 if not yet known
+ */
+size_t modbus_rtu_expected_frame_length(const uint8_t *frame, size_t length)
+{
+    if (!frame || length < 2) {
+        return 0;
+    }
+    
+    uint8_t function_code = frame[1];
+    if (function_code & 0x80) {
+        return MODBUS_RTU_EXCEPTION_FRAME_LEN;
+    }
+    
+    switch (function_code) {
+        case MODBUS_FC_READ_COILS:
+        case MODBUS_FC_READ_DISCRETE_INPUTS:
+        case MODBUS_FC_READ_HOLDING_REGISTERS:
+        case MODBUS_FC_READ_INPUT_REGISTERS:
+            // addr + fc + byte_count + data + crc
+            return (length < 3) ? 0 : (size_t)frame[2] + 5U;
+        case MODBUS_FC_WRITE_SINGLE_COIL:
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+        case MODBUS_FC_WRITE_MULTIPLE_COILS:
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+            return MODBUS_RTU_WRITE_ECHO_FRAME_LEN;
+        default:
+            // Unknown function code: rely on t3.5 silence
+            return 0;
+    }
+}
+
+/**
+ * @brief Modbus RTU t3.5 inter-frame silence for a baud rate
+ * @param baud_rate Serial baud rate
+ * @return t3.5 in microseconds
+ */
+uint32_t modbus_rtu_t35_us(uint32_t baud_rate)
+{
+    if (baud_rate == 0 || baud_rate > 19200) {
+        return MODBUS_RTU_T35_FIXED_US;
+    }
+    // 3.5 characters of 11 bits each
+    return (uint32_t)((35ULL * MODBUS_RTU_BITS_PER_CHAR * 1000000ULL) / (10ULL * baud_rate));
+}
 // No separate DE/RE pin control needed for UART1 RS485
 
 // Internal functions
@@ -753,8 +938,25 @@ static hal_status_t rs485_configure_serial(void) {
     return HAL_STATUS_OK;
 }
 
-static uint64_t rs485_get_timestamp_us(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+static void rs485_record_rx_latency(uint64_t complete_time_us) {
+    if (rs485_state.last_tx_complete_us == 0 || complete_time_us < rs485_state.last_tx_complete_us) {
+        return;
+    }
+    
+    uint64_t latency_us = complete_time_us - rs485_state.last_tx_complete_us;
+    rs485_statistics_t *stats = &rs485_state.statistics;
+    
+    stats->rx_latency_last_us = latency_us;
+    if (stats->rx_latency_count == 0 || latency_us < stats->rx_latency_min_us) {
+        stats->rx_latency_min_us = latency_us;
+    }
+    if (latency_us > stats->rx_latency_max_us) {
+        stats->rx_latency_max_us = latency_us;
+    }
+    stats->rx_latency_total_us += latency_us;
+    stats->rx_latency_count++;
+    
+    // One latency sample per request
+    rs485_state.last_tx_complete_us = 0;
 }
+
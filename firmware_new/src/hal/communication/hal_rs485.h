@@ -33,6 +33,13 @@
 #define MODBUS_TIMEOUT_MS        1000
 #define MODBUS_RETRY_COUNT       3
 
+// Modbus RTU framing (used by the Modbus-aware receive path)
+#define MODBUS_RTU_T35_FIXED_US          1750  // Fixed t3.5 above 19200 baud (Modbus serial line spec)
+#define MODBUS_RTU_BITS_PER_CHAR         11    // start + 8 data + parity/stop + stop
+#define MODBUS_RTU_SILENCE_SLACK_US      1000  // Userspace wakeup slack added to t3.5
+#define MODBUS_RTU_EXCEPTION_FRAME_LEN   5     // addr + fc|0x80 + code + crc
+#define MODBUS_RTU_WRITE_ECHO_FRAME_LEN  8     // addr + fc + addr(2) + value/qty(2) + crc
+
 // RS485 uses UART1 directly (no separate DE/RE pins needed)
 // UART1 pins: GPIO1_D1 (TX), GPIO1_D0 (RX) - Updated per EMBED test
 
@@ -98,6 +105,15 @@ typedef struct {
     uint64_t invalid_data_count;          // Out of range values
     float transport_success_rate;         // transport_success / total_attempts
     float semantic_success_rate;          // semantic_success / transport_success
+    
+    // Modbus-aware receive: per-transaction latency (TX drained -> frame complete)
+    uint64_t rx_latency_last_us;          // Latency of the last completed transaction
+    uint64_t rx_latency_min_us;           // Minimum observed latency
+    uint64_t rx_latency_max_us;           // Maximum observed latency
+    uint64_t rx_latency_total_us;         // Sum of latencies (for average)
+    uint64_t rx_latency_count;            // Number of latency samples
+    uint64_t frames_complete_by_length;   // Frames terminated by expected length
+    uint64_t frames_complete_by_silence;  // Frames terminated by t3.5 silence
 } rs485_statistics_t;
 
 // Modbus frame structure
@@ -131,6 +147,9 @@ hal_status_t hal_rs485_open(void);
 hal_status_t hal_rs485_close(void);
 hal_status_t hal_rs485_transmit(const uint8_t *data, size_t length);
 hal_status_t hal_rs485_receive(uint8_t *buffer, size_t max_length, size_t *actual_length);
+hal_status_t hal_rs485_receive_modbus(uint8_t *buffer, size_t max_length, size_t *actual_length);
+hal_status_t hal_rs485_receive_modbus_timeout(uint8_t *buffer, size_t max_length, size_t *actual_length,
+                                              uint32_t timeout_ms);
 hal_status_t hal_rs485_send_receive(const uint8_t *tx_data, size_t tx_length,
                                    uint8_t *rx_buffer, size_t max_rx_length, 
                                    size_t *actual_rx_length);
@@ -163,6 +182,8 @@ hal_status_t rs485_validate_config(const rs485_config_t *config);
 hal_status_t modbus_validate_config(const modbus_config_t *config);
 uint16_t modbus_calculate_crc(const uint8_t *data, size_t length);
 bool modbus_verify_crc(const uint8_t *data, size_t length, uint16_t crc);
+size_t modbus_rtu_expected_frame_length(const uint8_t *frame, size_t length);
+uint32_t modbus_rtu_t35_us(uint32_t baud_rate);
 // No separate DE/RE pin control needed for UART1 RS485
 
 #endif // HAL_RS485_H
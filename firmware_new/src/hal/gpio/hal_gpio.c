@@ -14,9 +14,14 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
 #include <sys/time.h>
 #include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
 #include <pthread.h>
+#include <linux/gpio.h>
 
 // Internal state
 static struct {
@@ -27,8 +32,44 @@ static struct {
     uint64_t last_operation_time_us;
 } gpio_state = {0};
 
+// Watched input pin (value fd stays open for the lifetime of the watch)
+typedef struct {
+    bool active;
+    uint32_t pin;
+    int fd;
+    gpio_event_source_t source;
+    gpio_edge_t edge;
+    bool last_value;
+    gpio_event_callback_t callback;
+    void *user_data;
+} gpio_watch_t;
+
+// Event thread state; watches only change while the thread is stopped
+static struct {
+    pthread_mutex_t mutex;              // Watch table; held while the thread is stopped/started
+    pthread_mutex_t level_mutex;        // last_value, written by the event thread
+    gpio_watch_t watches[GPIO_MAX_WATCHES];
+    uint32_t watch_count;
+    pthread_t thread;
+    bool thread_running;
+    int wake_fd;
+} gpio_events = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .level_mutex = PTHREAD_MUTEX_INITIALIZER,
+    .wake_fd = -1
+};
+
+static char gpio_sysfs_root[GPIO_PATH_MAX] = GPIO_SYSFS_ROOT_DEFAULT;
+
 // Internal function prototypes
-static uint64_t gpio_get_timestamp_us(void);
+static void gpio_sysfs_path(char *path, size_t size, uint32_t pin, const char *attr);
+static bool gpio_stream_drain(int fd, bool *level);
+static hal_status_t gpio_watch_open(gpio_watch_t *watch);
+static hal_status_t gpio_watch_read_level(gpio_watch_t *watch, bool *value);
+static hal_status_t gpio_events_start(void);
+static void gpio_events_stop(void);
+static bool gpio_watch_take_event(gpio_watch_t *watch, short revents, gpio_event_t *event);
+static void* gpio_event_thread(void *arg);
 
 // GPIO utility functions
 bool gpio_is_pin_valid(uint32_t pin);
@@ -61,7 +102,7 @@ hal_status_t hal_gpio_init(void)
     strcpy(gpio_state.device_info.device_name, "GPIO_Controller");
     strcpy(gpio_state.device_info.device_version, "1.0.0");
     gpio_state.device_info.pin_count = GPIO_MAX_PINS;
-    gpio_state.device_info.timestamp_us = gpio_get_timestamp_us();
+    gpio_state.device_info.timestamp_us = hal_time_now_us();
     gpio_state.device_info.error_count = 0;
     gpio_state.device_info.warning_count = 0;
     
@@ -83,6 +124,18 @@ hal_status_t hal_gpio_init(void)
  */
 hal_status_t hal_gpio_deinit(void)
 {
+    // Stop the event thread and release watched value nodes
+    pthread_mutex_lock(&gpio_events.mutex);
+    gpio_events_stop();
+    for (uint32_t i = 0; i < GPIO_MAX_WATCHES; i++) {
+        if (gpio_events.watches[i].active) {
+            close(gpio_events.watches[i].fd);
+            gpio_events.watches[i].active = false;
+        }
+    }
+    gpio_events.watch_count = 0;
+    pthread_mutex_unlock(&gpio_events.mutex);
+    
     pthread_mutex_lock(&gpio_state.mutex);
     
     if (!gpio_state.initialized) {
@@ -155,8 +208,8 @@ hal_status_t hal_gpio_set_direction(uint32_t pin, gpio_direction_t direction) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/direction", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "direction");
     
     FILE *fp = fopen(path, "w");
     if (!fp) {
@@ -174,8 +227,8 @@ hal_status_t hal_gpio_set_value(uint32_t pin, bool value) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/value", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "value");
     
     FILE *fp = fopen(path, "w");
     if (!fp) {
@@ -188,7 +241,7 @@ hal_status_t hal_gpio_set_value(uint32_t pin, bool value) {
     // Update statistics
     pthread_mutex_lock(&gpio_state.mutex);
     gpio_state.statistics.writes++;
-    gpio_state.statistics.timestamp_us = gpio_get_timestamp_us();
+    gpio_state.statistics.timestamp_us = hal_time_now_us();
     pthread_mutex_unlock(&gpio_state.mutex);
     
     return HAL_STATUS_OK;
@@ -199,8 +252,25 @@ hal_status_t hal_gpio_get_value(uint32_t pin, bool *value) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/value", pin);
+    // Watched pins keep their value node open, no open/read/close per call
+    pthread_mutex_lock(&gpio_events.mutex);
+    for (uint32_t i = 0; i < GPIO_MAX_WATCHES; i++) {
+        gpio_watch_t *watch = &gpio_events.watches[i];
+        if (watch->active && watch->pin == pin) {
+            hal_status_t status = gpio_watch_read_level(watch, value);
+            pthread_mutex_unlock(&gpio_events.mutex);
+            if (status == HAL_STATUS_OK) {
+                pthread_mutex_lock(&gpio_state.mutex);
+                gpio_state.statistics.reads++;
+                pthread_mutex_unlock(&gpio_state.mutex);
+            }
+            return status;
+        }
+    }
+    pthread_mutex_unlock(&gpio_events.mutex);
+    
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "value");
     
     FILE *fp = fopen(path, "r");
     if (!fp) {
@@ -216,7 +286,7 @@ hal_status_t hal_gpio_get_value(uint32_t pin, bool *value) {
     // Update statistics
     pthread_mutex_lock(&gpio_state.mutex);
     gpio_state.statistics.reads++;
-    gpio_state.statistics.timestamp_us = gpio_get_timestamp_us();
+    gpio_state.statistics.timestamp_us = hal_time_now_us();
     pthread_mutex_unlock(&gpio_state.mutex);
     
     return HAL_STATUS_OK;
@@ -227,8 +297,8 @@ hal_status_t hal_gpio_set_edge(uint32_t pin, gpio_edge_t edge) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/edge", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "edge");
     
     FILE *fp = fopen(path, "w");
     if (!fp) {
@@ -255,8 +325,8 @@ hal_status_t hal_gpio_set_bias(uint32_t pin, gpio_bias_t bias) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/bias", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "bias");
     
     FILE *fp = fopen(path, "w");
     if (!fp) {
@@ -282,8 +352,8 @@ hal_status_t hal_gpio_set_drive(uint32_t pin, gpio_drive_t drive) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/drive", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "drive");
     
     FILE *fp = fopen(path, "w");
     if (!fp) {
@@ -310,8 +380,8 @@ hal_status_t hal_gpio_wait_for_event(uint32_t pin, gpio_event_t *event, uint32_t
     }
     
     // Real implementation using select() for efficient event waiting
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/value", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, "value");
     
     int fd = open(path, O_RDONLY);
     if (fd < 0) {
@@ -336,7 +406,7 @@ hal_status_t hal_gpio_wait_for_event(uint32_t pin, gpio_event_t *event, uint32_t
         if (read(fd, &value_char, 1) == 1) {
             event->pin_number = pin;
             event->value = (value_char == '1');
-            event->timestamp_us = gpio_get_timestamp_us();
+            event->timestamp_us = hal_time_now_us();
             event->edge = GPIO_EDGE_NONE; // Could be enhanced to detect edge type
             
             // Update statistics
@@ -387,6 +457,135 @@ hal_status_t hal_gpio_health_check(void) {
     return HAL_STATUS_OK;
 }
 
+hal_status_t hal_gpio_set_sysfs_root(const char *root) {
+    const char *new_root = (root != NULL) ? root : GPIO_SYSFS_ROOT_DEFAULT;
+    if (strlen(new_root) >= sizeof(gpio_sysfs_root)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    pthread_mutex_lock(&gpio_events.mutex);
+    if (gpio_events.watch_count > 0) {
+        pthread_mutex_unlock(&gpio_events.mutex);
+        return HAL_STATUS_BUSY;
+    }
+    strcpy(gpio_sysfs_root, new_root);
+    pthread_mutex_unlock(&gpio_events.mutex);
+    
+    return HAL_STATUS_OK;
+}
+
+const char* hal_gpio_get_sysfs_root(void) {
+    return gpio_sysfs_root;
+}
+
+hal_status_t hal_gpio_watch_pin(uint32_t pin, gpio_edge_t edge, gpio_event_callback_t callback, void *user_data) {
+    if (!gpio_state.initialized || !gpio_is_pin_valid(pin) || callback == NULL ||
+        edge == GPIO_EDGE_NONE || edge > GPIO_EDGE_BOTH) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    
+    pthread_mutex_lock(&gpio_events.mutex);
+    
+    gpio_watch_t *slot = NULL;
+    for (uint32_t i = 0; i < GPIO_MAX_WATCHES; i++) {
+        gpio_watch_t *watch = &gpio_events.watches[i];
+        if (watch->active && watch->pin == pin) {
+            pthread_mutex_unlock(&gpio_events.mutex);
+            return HAL_STATUS_ALREADY_INITIALIZED;
+        }
+        if (!watch->active && slot == NULL) {
+            slot = watch;
+        }
+    }
+    if (slot == NULL) {
+        pthread_mutex_unlock(&gpio_events.mutex);
+        return HAL_STATUS_NO_MEMORY;
+    }
+    
+    gpio_watch_t watch = {
+        .pin = pin,
+        .fd = -1,
+        .edge = edge,
+        .callback = callback,
+        .user_data = user_data
+    };
+    hal_status_t status = gpio_watch_open(&watch);
+    if (status != HAL_STATUS_OK) {
+        pthread_mutex_unlock(&gpio_events.mutex);
+        return status;
+    }
+    
+    // Watches only change while the event thread is parked
+    gpio_events_stop();
+    watch.active = true;
+    *slot = watch;
+    gpio_events.watch_count++;
+    status = gpio_events_start();
+    if (status != HAL_STATUS_OK) {
+        close(slot->fd);
+        slot->active = false;
+        gpio_events.watch_count--;
+        if (gpio_events.watch_count > 0) {
+            (void)gpio_events_start();
+        }
+    }
+    
+    pthread_mutex_unlock(&gpio_events.mutex);
+    
+    if (status == HAL_STATUS_OK) {
+        printf("[GPIO] Watching pin %u for edges (%s)\n", pin,
+               watch.source == GPIO_EVENT_SOURCE_CDEV ? "line events" :
+               watch.source == GPIO_EVENT_SOURCE_STREAM ? "stream" : "sysfs");
+    }
+    return status;
+}
+
+hal_status_t hal_gpio_unwatch_pin(uint32_t pin) {
+    pthread_mutex_lock(&gpio_events.mutex);
+    
+    if (gpio_events.thread_running && pthread_equal(pthread_self(), gpio_events.thread)) {
+        pthread_mutex_unlock(&gpio_events.mutex);
+        return HAL_STATUS_BUSY;
+    }
+    
+    for (uint32_t i = 0; i < GPIO_MAX_WATCHES; i++) {
+        gpio_watch_t *watch = &gpio_events.watches[i];
+        if (watch->active && watch->pin == pin) {
+            gpio_events_stop();
+            close(watch->fd);
+            watch->active = false;
+            watch->fd = -1;
+            gpio_events.watch_count--;
+            if (gpio_events.watch_count > 0) {
+                (void)gpio_events_start();
+            }
+            pthread_mutex_unlock(&gpio_events.mutex);
+            return HAL_STATUS_OK;
+        }
+    }
+    
+    pthread_mutex_unlock(&gpio_events.mutex);
+    return HAL_STATUS_NOT_FOUND;
+}
+
+bool hal_gpio_is_watched(uint32_t pin, gpio_event_source_t *source) {
+    bool watched = false;
+    
+    pthread_mutex_lock(&gpio_events.mutex);
+    for (uint32_t i = 0; i < GPIO_MAX_WATCHES; i++) {
+        if (gpio_events.watches[i].active && gpio_events.watches[i].pin == pin) {
+            watched = true;
+            if (source != NULL) {
+                *source = gpio_events.watches[i].source;
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&gpio_events.mutex);
+    
+    return watched;
+}
+
 // Relay functions removed - moved to hal_relay.c to avoid duplicate definitions
 
 // Utility functions (Real implementation)
@@ -456,15 +655,17 @@ hal_status_t gpio_export_pin(uint32_t pin) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d", pin);
+    char path[GPIO_PATH_MAX + 32];
+    gpio_sysfs_path(path, sizeof(path), pin, NULL);
     
     // Check if already exported
     if (access(path, F_OK) == 0) {
         return HAL_STATUS_OK;
     }
     
-    FILE *fp = fopen("/sys/class/gpio/export", "w");
+    char export_path[GPIO_PATH_MAX + 16];
+    snprintf(export_path, sizeof(export_path), "%s/export", gpio_sysfs_root);
+    FILE *fp = fopen(export_path, "w");
     if (!fp) {
         return HAL_STATUS_ERROR;
     }
@@ -483,7 +684,9 @@ hal_status_t gpio_unexport_pin(uint32_t pin) {
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    FILE *fp = fopen("/sys/class/gpio/unexport", "w");
+    char unexport_path[GPIO_PATH_MAX + 16];
+    snprintf(unexport_path, sizeof(unexport_path), "%s/unexport", gpio_sysfs_root);
+    FILE *fp = fopen(unexport_path, "w");
     if (!fp) {
         return HAL_STATUS_ERROR;
     }
@@ -495,8 +698,291 @@ hal_status_t gpio_unexport_pin(uint32_t pin) {
 }
 
 // Internal functions (Real implementation)
-static uint64_t gpio_get_timestamp_us(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000 + (uint64_t)tv.tv_usec;
+static void gpio_sysfs_path(char *path, size_t size, uint32_t pin, const char *attr) {
+    if (attr != NULL) {
+        snprintf(path, size, "%s/gpio%u/%s", gpio_sysfs_root, pin, attr);
+    } else {
+        snprintf(path, size, "%s/gpio%u", gpio_sysfs_root, pin);
+    }
+}
+
+// Consume queued level bytes from a stream source; the last '0'/'1' wins
+static bool gpio_stream_drain(int fd, bool *level) {
+    char buf[32];
+    ssize_t got;
+    bool start = *level;
+    bool left = false;
+    while ((got = read(fd, buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < got; i++) {
+            if (buf[i] == '0' || buf[i] == '1') {
+                *level = (buf[i] == '1');
+                left = left || (*level != start);
+            }
+        }
+    }
+    return left;
+}
+
+/**
+ * @brief Open the event source for a watch and read its initial level
+ *
+ * Prefers the sysfs value attribute (edge file written here). A FIFO in
+ * place of the value attribute is treated as a level stream, which is how
+ * fake sysfs trees drive edges on a development host. Without a sysfs node
+ * the gpiochip line-event interface is used.
+ */
+static hal_status_t gpio_watch_open(gpio_watch_t *watch) {
+    char path[GPIO_PATH_MAX + 32];
+    struct stat st;
+    
+    gpio_sysfs_path(path, sizeof(path), watch->pin, "value");
+    if (stat(path, &st) == 0) {
+        if (S_ISFIFO(st.st_mode)) {
+            // O_RDWR keeps a writer attached so poll() never reports HUP
+            watch->fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+            if (watch->fd < 0) {
+                return HAL_STATUS_ERROR;
+            }
+            watch->source = GPIO_EVENT_SOURCE_STREAM;
+            
+            // Initial level is the last byte already queued, low if none
+            watch->last_value = false;
+            (void)gpio_stream_drain(watch->fd, &watch->last_value);
+            return HAL_STATUS_OK;
+        }
+        
+        hal_status_t status = hal_gpio_set_edge(watch->pin, watch->edge);
+        if (status != HAL_STATUS_OK) {
+            return status;
+        }
+        watch->fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (watch->fd < 0) {
+            return HAL_STATUS_ERROR;
+        }
+        watch->source = GPIO_EVENT_SOURCE_SYSFS;
+        if (gpio_watch_read_level(watch, &watch->last_value) != HAL_STATUS_OK) {
+            close(watch->fd);
+            watch->fd = -1;
+            return HAL_STATUS_ERROR;
+        }
+        return HAL_STATUS_OK;
+    }
+    
+    // No sysfs node: request a line-event handle from the gpiochip
+    char chip_path[GPIO_PATH_MAX];
+    snprintf(chip_path, sizeof(chip_path), "%s/gpiochip%u", GPIO_DEV_ROOT_DEFAULT,
+             watch->pin / GPIO_PINS_PER_CHIP);
+    int chip_fd = open(chip_path, O_RDONLY | O_CLOEXEC);
+    if (chip_fd < 0) {
+        return HAL_STATUS_NOT_SUPPORTED;
+    }
+    
+    struct gpioevent_request request;
+    memset(&request, 0, sizeof(request));
+    request.lineoffset = watch->pin % GPIO_PINS_PER_CHIP;
+    request.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    request.eventflags = (watch->edge == GPIO_EDGE_RISING) ? GPIOEVENT_REQUEST_RISING_EDGE :
+                         (watch->edge == GPIO_EDGE_FALLING) ? GPIOEVENT_REQUEST_FALLING_EDGE :
+                         GPIOEVENT_REQUEST_BOTH_EDGES;
+    snprintf(request.consumer_label, sizeof(request.consumer_label), "oht50");
+    
+    int result = ioctl(chip_fd, GPIO_GET_LINEEVENT_IOCTL, &request);
+    close(chip_fd);
+    if (result < 0) {
+        return HAL_STATUS_NOT_SUPPORTED;
+    }
+    
+    watch->fd = request.fd;
+    watch->source = GPIO_EVENT_SOURCE_CDEV;
+    if (gpio_watch_read_level(watch, &watch->last_value) != HAL_STATUS_OK) {
+        close(watch->fd);
+        watch->fd = -1;
+        return HAL_STATUS_ERROR;
+    }
+    return HAL_STATUS_OK;
+}
+
+// Current level of a watched pin without reopening anything
+static hal_status_t gpio_watch_read_level(gpio_watch_t *watch, bool *value) {
+    switch (watch->source) {
+        case GPIO_EVENT_SOURCE_SYSFS: {
+            char buf[4];
+            if (pread(watch->fd, buf, sizeof(buf), 0) < 1) {
+                return HAL_STATUS_ERROR;
+            }
+            *value = (buf[0] == '1');
+            return HAL_STATUS_OK;
+        }
+        case GPIO_EVENT_SOURCE_CDEV: {
+            struct gpiohandle_data data;
+            memset(&data, 0, sizeof(data));
+            if (ioctl(watch->fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0) {
+                return HAL_STATUS_ERROR;
+            }
+            *value = (data.values[0] != 0);
+            return HAL_STATUS_OK;
+        }
+        case GPIO_EVENT_SOURCE_STREAM:
+        default:
+            pthread_mutex_lock(&gpio_events.level_mutex);
+            *value = watch->last_value;
+            pthread_mutex_unlock(&gpio_events.level_mutex);
+            return HAL_STATUS_OK;
+    }
+}
+
+// Start the event thread if there is anything to watch (gpio_events.mutex held)
+static hal_status_t gpio_events_start(void) {
+    if (gpio_events.thread_running || gpio_events.watch_count == 0) {
+        return HAL_STATUS_OK;
+    }
+    
+    if (gpio_events.wake_fd < 0) {
+        gpio_events.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (gpio_events.wake_fd < 0) {
+            return HAL_STATUS_ERROR;
+        }
+    }
+    
+    if (pthread_create(&gpio_events.thread, NULL, gpio_event_thread, NULL) != 0) {
+        return HAL_STATUS_ERROR;
+    }
+    gpio_events.thread_running = true;
+    return HAL_STATUS_OK;
+}
+
+// Wake the event thread and wait for it to exit (gpio_events.mutex held)
+static void gpio_events_stop(void) {
+    if (!gpio_events.thread_running) {
+        return;
+    }
+    
+    uint64_t one = 1;
+    if (write(gpio_events.wake_fd, &one, sizeof(one)) < 0) {
+        printf("[GPIO] Warning: failed to wake event thread (errno=%d)\n", errno);
+    }
+    pthread_join(gpio_events.thread, NULL);
+    gpio_events.thread_running = false;
+    
+    // Drain the wake counter for the next start
+    uint64_t drained;
+    (void)read(gpio_events.wake_fd, &drained, sizeof(drained));
+}
+
+/**
+ * @brief Read the new level of a watch after its fd became ready
+ *
+ * A short pulse can be over before the level is read: sysfs still raised
+ * POLLPRI for it and a level stream still queued both bytes. The event then
+ * reports the transition that caused the wakeup (away from last_value, or the
+ * armed edge), while value is the level read afterwards.
+ *
+ * @return true if an edge matching the watch's filter should be dispatched
+ */
+static bool gpio_watch_take_event(gpio_watch_t *watch, short revents, gpio_event_t *event) {
+    bool level = watch->last_value;
+    bool pulse = false;
+    
+    if (watch->source == GPIO_EVENT_SOURCE_CDEV) {
+        struct gpioevent_data data;
+        if (read(watch->fd, &data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            return false;
+        }
+        level = (data.id == GPIOEVENT_EVENT_RISING_EDGE);
+    } else if (watch->source == GPIO_EVENT_SOURCE_STREAM) {
+        pulse = gpio_stream_drain(watch->fd, &level) && level == watch->last_value;
+    } else {
+        // sysfs signals an edge with POLLPRI|POLLERR; reading from 0 re-arms it
+        if ((revents & (POLLPRI | POLLERR)) == 0 ||
+            gpio_watch_read_level(watch, &level) != HAL_STATUS_OK) {
+            return false;
+        }
+        // The kernel only wakes us for the armed edge, even if it is already over
+        pulse = (level == watch->last_value);
+    }
+    
+    if (!pulse && level == watch->last_value) {
+        return false;
+    }
+    
+    gpio_edge_t edge = level ? GPIO_EDGE_RISING : GPIO_EDGE_FALLING;
+    if (pulse) {
+        // Both edges happened; report the first unless only the other is armed
+        edge = (watch->edge != GPIO_EDGE_BOTH) ? watch->edge :
+               watch->last_value ? GPIO_EDGE_FALLING : GPIO_EDGE_RISING;
+    }
+    
+    pthread_mutex_lock(&gpio_events.level_mutex);
+    watch->last_value = level;
+    pthread_mutex_unlock(&gpio_events.level_mutex);
+    
+    event->pin_number = watch->pin;
+    event->value = level;
+    event->edge = edge;
+    return (watch->edge == GPIO_EDGE_BOTH) || (watch->edge == event->edge);
+}
+
+/**
+ * @brief Event thread: sleeps in poll() until a watched pin changes
+ *
+ * The watch table is only modified while this thread is stopped, so it is
+ * read here without holding the mutex.
+ */
+static void* gpio_event_thread(void *arg) {
+    (void)arg;
+    struct pollfd fds[GPIO_MAX_WATCHES + 1];
+    gpio_watch_t *owners[GPIO_MAX_WATCHES + 1];
+    nfds_t count = 0;
+    
+    fds[count].fd = gpio_events.wake_fd;
+    fds[count].events = POLLIN;
+    owners[count++] = NULL;
+    for (uint32_t i = 0; i < GPIO_MAX_WATCHES; i++) {
+        gpio_watch_t *watch = &gpio_events.watches[i];
+        if (!watch->active) {
+            continue;
+        }
+        fds[count].fd = watch->fd;
+        fds[count].events = (watch->source == GPIO_EVENT_SOURCE_SYSFS) ? (POLLPRI | POLLERR) : POLLIN;
+        owners[count++] = watch;
+    }
+    
+    for (;;) {
+        int ready = poll(fds, count, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("[GPIO] Event poll failed (errno=%d), thread exiting\n", errno);
+            break;
+        }
+        
+        uint64_t now_us = hal_time_now_us();
+        pthread_mutex_lock(&gpio_state.mutex);
+        gpio_state.statistics.wakeups++;
+        pthread_mutex_unlock(&gpio_state.mutex);
+        
+        if (fds[0].revents & POLLIN) {
+            break;
+        }
+        
+        for (nfds_t i = 1; i < count; i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            gpio_event_t event;
+            if (!gpio_watch_take_event(owners[i], fds[i].revents, &event)) {
+                continue;
+            }
+            event.timestamp_us = now_us;
+            
+            pthread_mutex_lock(&gpio_state.mutex);
+            gpio_state.statistics.events++;
+            pthread_mutex_unlock(&gpio_state.mutex);
+            
+            owners[i]->callback(&event, owners[i]->user_data);
+        }
+    }
+    
+    return NULL;
 }
@@ -17,6 +17,13 @@
 // GPIO Configuration
 #define GPIO_MAX_PINS             64
 #define GPIO_CHIP_NAME            "gpiochip1"
+#define GPIO_PINS_PER_CHIP        32          // RK3588 bank size: pin = bank * 32 + offset
+
+// Event-driven input configuration
+#define GPIO_SYSFS_ROOT_DEFAULT   "/sys/class/gpio"
+#define GPIO_DEV_ROOT_DEFAULT     "/dev"
+#define GPIO_PATH_MAX             128
+#define GPIO_MAX_WATCHES          8
 
 // Relay Configuration (Updated per EMBED test)
 #define RELAY_CHANNEL_1           "GPIO4_A3"  // Relay 1 - GPIO131
@@ -66,16 +73,27 @@ typedef struct {
 // GPIO event structure
 typedef struct {
     uint32_t pin_number;
-    bool value;
-    uint64_t timestamp_us;
-    gpio_edge_t edge;
+    bool value;                 // Level read after the wakeup (a short pulse may be over)
+    uint64_t timestamp_us;      // CLOCK_MONOTONIC time the event thread woke up
+    gpio_edge_t edge;           // Transition that caused the wakeup
 } gpio_event_t;
 
+// Where a watched pin gets its edges from
+typedef enum {
+    GPIO_EVENT_SOURCE_SYSFS = 0,    // sysfs value attribute, POLLPRI on edge
+    GPIO_EVENT_SOURCE_CDEV,         // gpiochip line-event fd
+    GPIO_EVENT_SOURCE_STREAM        // FIFO value node (fake sysfs tree), one byte per level
+} gpio_event_source_t;
+
+// Edge callback, runs on the GPIO event thread
+typedef void (*gpio_event_callback_t)(const gpio_event_t *event, void *user_data);
+
 // GPIO statistics
 typedef struct {
     uint64_t reads;
     uint64_t writes;
     uint64_t events;
+    uint64_t wakeups;
     uint64_t errors;
     uint64_t timestamp_us;
 } gpio_statistics_t;
@@ -107,6 +125,50 @@ hal_status_t hal_gpio_get_statistics(gpio_statistics_t *statistics);
 hal_status_t hal_gpio_reset_statistics(void);
 hal_status_t hal_gpio_health_check(void);
 
+/**
+ * @brief Override the sysfs GPIO root (tests point this at a fake tree)
+ * @param root Directory containing export/unexport and gpioN/ nodes, NULL for default
+ * @return HAL status
+ */
+hal_status_t hal_gpio_set_sysfs_root(const char *root);
+
+/**
+ * @brief Get the sysfs GPIO root currently in use
+ * @return Root path
+ */
+const char* hal_gpio_get_sysfs_root(void);
+
+/**
+ * @brief Watch an input pin for edges instead of polling it
+ *
+ * The pin's value node is opened once and kept open; a background thread
+ * blocks in poll() on all watched pins and calls the callback with the new
+ * level as soon as the kernel reports an edge. Falls back to the gpiochip
+ * line-event interface when the sysfs node does not exist.
+ *
+ * @param pin GPIO pin number
+ * @param edge Edges to report (GPIO_EDGE_NONE is rejected)
+ * @param callback Called on the event thread for each reported edge
+ * @param user_data Passed through to the callback
+ * @return HAL status
+ */
+hal_status_t hal_gpio_watch_pin(uint32_t pin, gpio_edge_t edge, gpio_event_callback_t callback, void *user_data);
+
+/**
+ * @brief Stop watching a pin (must not be called from an event callback)
+ * @param pin GPIO pin number
+ * @return HAL status; no callback for the pin runs after this returns
+ */
+hal_status_t hal_gpio_unwatch_pin(uint32_t pin);
+
+/**
+ * @brief Check whether a pin is currently watched
+ * @param pin GPIO pin number
+ * @param source Optional pointer to store the event source
+ * @return true if watched
+ */
+bool hal_gpio_is_watched(uint32_t pin, gpio_event_source_t *source);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,7 +24,6 @@ static pthread_t led_update_thread;
 static bool led_thread_running = false;
 
 // Internal functions
-static uint64_t get_timestamp_ms(void);
 static hal_status_t gpio_export(uint8_t pin);
 static hal_status_t gpio_set_direction(uint8_t pin, bool output);
 static hal_status_t gpio_set_value(uint8_t pin, bool value);
@@ -178,7 +177,7 @@ hal_status_t hal_led_set_pattern(uint8_t pin, led_pattern_t pattern) {
     }
 
     led_status[led_index].current_pattern = pattern;
-    led_status[led_index].last_toggle_time = get_timestamp_ms();
+    led_status[led_index].last_toggle_time = hal_time_now_ms();
     
     return HAL_STATUS_OK;
 }
@@ -257,7 +256,7 @@ hal_status_t hal_led_update(void) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
 
-    uint64_t current_time = get_timestamp_ms();
+    uint64_t current_time = hal_time_now_ms();
 
     for (int i = 0; i < 5; i++) {
         if (!led_status[i].initialized) {
@@ -432,12 +431,6 @@ hal_status_t hal_led_system_shutdown(void) {
 }
 
 // Internal helper functions
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-}
-
 static hal_status_t gpio_export(uint8_t pin) {
     char path[64];
     snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d", pin);
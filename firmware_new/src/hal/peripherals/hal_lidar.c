@@ -46,7 +46,13 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "hal_lidar.h"
+#include "hal_lidar_frame.h"
+#include "hal_lidar_framer.h"
+#include "hal_lidar_kernels.h"
+#include "hal_lidar_pipeline.h"
+#include "hal_lidar_window.h"
 #include "hal_common.h"
+#include "hal_log.h"
 #include <pthread.h>
 #include <sched.h>
 #include <sys/mman.h>
@@ -70,7 +76,9 @@
 #include <termios.h>
 #include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 #include <pthread.h>
+#include <sched.h>
 #include <math.h>
 
 // Fix for missing CRTSCTS on some systems
@@ -86,7 +94,6 @@ static struct {
     lidar_config_t config;
     pthread_mutex_t mutex;
     pthread_t scan_thread;
-    lidar_scan_data_t current_scan;
     lidar_safety_status_t safety_status;
     lidar_device_info_t device_info;
     uint64_t last_scan_timestamp_us;
@@ -104,24 +111,16 @@ static struct {
     uint32_t enhanced_error_count;
     
     // Advanced Multi-Sample State (NEW)
-    lidar_scan_data_t sample_buffer[LIDAR_MAX_SAMPLE_COUNT]; // Multi-sample buffer
-    uint8_t current_sample_index;                            // Current sample index
-    uint8_t valid_samples;                                   // Number of valid samples
+    lidar_window_t sample_window;                            // Last sample_count frames, per-degree sums
     float statistical_confidence;                            // Statistical confidence level
     bool temporal_filtering_enabled;                         // Temporal filtering enabled
-    lidar_scan_data_t temporal_buffer[LIDAR_MAX_TEMPORAL_WINDOW]; // Temporal buffer
-    uint8_t temporal_index;                                  // Temporal buffer index
+    lidar_window_t temporal_window;                          // Last temporal_window_size frames, per-degree sums
     float calibration_drift_detected;                        // Calibration drift detection
     uint64_t last_drift_check_us;                           // Last drift check timestamp
     
     // Multi-Threading State (NEW)
     lidar_threading_config_t threading_config;               // Threading configuration
     lidar_memory_pool_t memory_pool_config;                  // Memory pool configuration
-    pthread_t threads[LIDAR_MAX_THREADS];                    // Thread handles
-    pthread_mutex_t thread_mutexes[LIDAR_MAX_THREADS];       // Thread mutexes
-    pthread_cond_t thread_conditions[LIDAR_MAX_THREADS];     // Thread conditions
-    bool threads_running[LIDAR_MAX_THREADS];                 // Thread running status
-    uint8_t active_thread_count;                             // Active thread count
     bool parallel_processing_enabled;                        // Parallel processing enabled
     
     // Memory Pool State (NEW)
@@ -151,6 +150,23 @@ static struct {
     uint64_t last_optimization_us;                          // Last optimization timestamp
 } lidar_state = {0};
 
+// Complete frames published by the scan thread (outside lidar_state: survives hal_lidar_reset_state())
+static lidar_frame_publisher_t lidar_frames;
+
+// Byte stream to revolution framing (scan thread only)
+static lidar_framer_t lidar_framer;
+static uint64_t lidar_framing_ns;                           // Framer time spent on the current revolution
+
+// Filter, safety and reduce stages run on the pipeline's workers, fed by the scan thread
+static lidar_pipeline_t lidar_pipeline;
+
+// Application safety handler, run on the safety worker
+static struct {
+    pthread_mutex_t mutex;
+    lidar_safety_handler_t handler;
+    void *ctx;
+} lidar_safety_hook = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
 // Internal function prototypes
 static void* lidar_scan_thread(void *arg);
 static hal_status_t lidar_open_device(void);
@@ -158,10 +174,11 @@ static hal_status_t lidar_close_device(void);
 static hal_status_t lidar_configure_serial(void);
 static hal_status_t lidar_send_command(const uint8_t *command, size_t len);
 static hal_status_t lidar_read_response(uint8_t *buffer, size_t max_len, size_t *actual_len);
-static uint64_t lidar_get_timestamp_us(void);
-static hal_status_t lidar_parse_scan_data(const uint8_t *data, size_t len, lidar_scan_data_t *scan_data);
 static hal_status_t lidar_generate_simulated_data(lidar_scan_data_t *scan_data);
-static hal_status_t lidar_process_safety_status(void);
+static hal_status_t lidar_process_safety_status(const lidar_scan_data_t *scan);
+static void lidar_stage_filter(void *ctx, lidar_scan_data_t *scan);
+static void lidar_stage_safety(void *ctx, lidar_scan_data_t *scan);
+static void lidar_stage_reduce(void *ctx, lidar_scan_data_t *scan);
 
 // Enhanced Resolution Internal Functions (NEW)
 static hal_status_t lidar_initialize_enhanced_features(void);
@@ -177,24 +194,19 @@ static hal_status_t lidar_initialize_advanced_features(void);
 static hal_status_t lidar_apply_statistical_averaging(lidar_scan_data_t *scan_data);
 static hal_status_t lidar_apply_weighted_averaging(lidar_scan_data_t *scan_data);
 static hal_status_t lidar_apply_temporal_filtering(lidar_scan_data_t *scan_data);
+static void lidar_configure_windows(void);
+static void lidar_apply_window_filters(lidar_scan_data_t *scan_data);
 static hal_status_t lidar_detect_outliers_advanced(lidar_scan_data_t *scan_data);
 static hal_status_t lidar_calculate_statistical_confidence(const lidar_scan_data_t *scan_data, float *confidence);
 static hal_status_t lidar_apply_dynamic_calibration(lidar_scan_data_t *scan_data);
 static hal_status_t lidar_detect_calibration_drift_internal(void);
 static hal_status_t lidar_calibrate_multiple_points_internal(const uint16_t *distances, uint8_t count);
-static float lidar_calculate_weighted_average(const uint16_t *values, const uint8_t *weights, uint8_t count);
-static float lidar_calculate_standard_deviation(const uint16_t *values, uint8_t count, float mean);
 
 // Multi-Threading Internal Functions (NEW)
 static hal_status_t lidar_initialize_threading_system(void);
 static hal_status_t lidar_initialize_memory_pool(void);
-static hal_status_t lidar_create_thread(uint8_t thread_id, void *(*thread_func)(void *), void *arg);
-static hal_status_t lidar_destroy_thread(uint8_t thread_id);
 static hal_status_t lidar_set_thread_priority_internal(uint8_t thread_id, uint8_t priority);
 static hal_status_t lidar_set_thread_affinity_internal(uint8_t thread_id, uint8_t cpu_core);
-static void* lidar_processing_thread(void *arg);
-static void* lidar_calibration_thread(void *arg);
-static void* lidar_memory_management_thread(void *arg);
 static hal_status_t lidar_allocate_memory_block_internal(void **block_ptr, size_t size);
 static hal_status_t lidar_deallocate_memory_block_internal(void *block_ptr);
 static hal_status_t lidar_compact_memory_pool_internal(void);
@@ -237,6 +249,12 @@ hal_status_t hal_lidar_init(const lidar_config_t *config)
         if (pthread_mutex_init(&lidar_state.mutex, NULL) != 0) {
             return HAL_STATUS_ERROR;
         }
+        if (lidar_frame_publisher_init(&lidar_frames) != HAL_STATUS_OK) {
+            return HAL_STATUS_ERROR;
+        }
+        if (lidar_pipeline_init(&lidar_pipeline) != HAL_STATUS_OK) {
+            return HAL_STATUS_ERROR;
+        }
         mutex_initialized = true;
     }
     
@@ -266,7 +284,7 @@ hal_status_t hal_lidar_init(const lidar_config_t *config)
     }
     
     // Initialize scan data
-    memset(&lidar_state.current_scan, 0, sizeof(lidar_scan_data_t));
+    lidar_frame_publisher_reset(&lidar_frames);
     memset(&lidar_state.safety_status, 0, sizeof(lidar_safety_status_t));
     memset(&lidar_state.device_info, 0, sizeof(lidar_device_info_t));
     
@@ -338,6 +356,9 @@ hal_status_t hal_lidar_deinit(void)
     // Close device
     lidar_close_device();
     
+    // Wake readers blocked on the next frame
+    lidar_frame_publisher_close(&lidar_frames);
+    
     // Reset state but don't destroy mutex
     lidar_state.initialized = false;
     lidar_state.scanning = false;
@@ -379,8 +400,34 @@ hal_status_t hal_lidar_start_scanning(void)
         printf("⚠️  MOCK MODE: Skipping start scan command\n");
     }
     
+    // Processing workers first, so the scan thread has free frames to fill
+    lidar_pipeline_config_t pipeline_config = {
+        .workers = lidar_state.threading_config.enable_parallel_processing ?
+                   (uint8_t)(lidar_state.threading_config.thread_count < LIDAR_PIPELINE_MAX_WORKERS ?
+                             lidar_state.threading_config.thread_count : LIDAR_PIPELINE_MAX_WORKERS) : 1U,
+        .safety_cpu = LIDAR_PIPELINE_CPU_AUTO,
+        .safety_priority = LIDAR_THREAD_PRIORITY_HIGH,
+        .stages = {
+            [LIDAR_STAGE_FILTER] = { lidar_stage_filter, NULL },
+            [LIDAR_STAGE_SAFETY] = { lidar_stage_safety, NULL },
+            [LIDAR_STAGE_REDUCE] = { lidar_stage_reduce, NULL },
+        },
+    };
+    if (pipeline_config.workers == 0) {
+        pipeline_config.workers = 1;
+    }
+    if (lidar_state.threading_config.enable_thread_affinity) {
+        pipeline_config.safety_cpu = lidar_state.threading_config.cpu_cores[1];
+    }
+    status = lidar_pipeline_start(&lidar_pipeline, &pipeline_config);
+    if (status != HAL_STATUS_OK) {
+        pthread_mutex_unlock(&lidar_state.mutex);
+        return status;
+    }
+    
     // Start scan thread
     if (pthread_create(&lidar_state.scan_thread, NULL, lidar_scan_thread, NULL) != 0) {
+        lidar_pipeline_stop(&lidar_pipeline);
         pthread_mutex_unlock(&lidar_state.mutex);
         return HAL_STATUS_ERROR;
     }
@@ -415,8 +462,10 @@ hal_status_t hal_lidar_stop_scanning(void)
     
     pthread_mutex_unlock(&lidar_state.mutex);
     
-    // Wait for scan thread to finish
+    // Wait for scan thread to finish, then for the frames it submitted
     pthread_join(lidar_state.scan_thread, NULL);
+    lidar_pipeline_flush(&lidar_pipeline, 100);
+    lidar_pipeline_stop(&lidar_pipeline);
     
     return status;
 }
@@ -433,30 +482,105 @@ hal_status_t hal_lidar_get_scan_data(lidar_scan_data_t *scan_data)
     }
     
     pthread_mutex_lock(&lidar_state.mutex);
-    
-    if (!lidar_state.initialized) {
-        pthread_mutex_unlock(&lidar_state.mutex);
+    bool initialized = lidar_state.initialized;
+    pthread_mutex_unlock(&lidar_state.mutex);
+    if (!initialized) {
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // Check if we're in simulated mode (device_fd < 0)
-#ifdef LIDAR_ALLOW_SIMULATED_LIDAR
-    if (lidar_state.device_fd < 0) {
-        // Generate fresh simulated data
-        hal_status_t status = lidar_generate_simulated_data(scan_data);
-        pthread_mutex_unlock(&lidar_state.mutex);
-        return status;
+    // Copy of the latest published frame; prefer hal_lidar_acquire_frame() to avoid the copy
+    lidar_frame_view_t view;
+    if (lidar_frame_publisher_acquire(&lidar_frames, &view) != HAL_STATUS_OK) {
+        memset(scan_data, 0, sizeof(lidar_scan_data_t));
+        return HAL_STATUS_OK;
     }
-#endif
-    
-    // Copy current scan data
-    memcpy(scan_data, &lidar_state.current_scan, sizeof(lidar_scan_data_t));
-    
-    pthread_mutex_unlock(&lidar_state.mutex);
+    memcpy(scan_data, view.scan, sizeof(lidar_scan_data_t));
+    lidar_frame_publisher_release(&lidar_frames, &view);
     
     return HAL_STATUS_OK;
 }
 
+/**
+ * @brief Take a read-only view of the latest complete frame
+ * @param view Output view
+ * @return HAL status
+ */
+hal_status_t hal_lidar_acquire_frame(lidar_frame_view_t *view)
+{
+    return lidar_frame_publisher_acquire(&lidar_frames, view);
+}
+
+/**
+ * @brief Block until a frame newer than after_sequence is published
+ * @param after_sequence Last processed sequence
+ * @param timeout_ms Upper bound on the wait
+ * @param view Output view
+ * @return HAL status
+ */
+hal_status_t hal_lidar_wait_frame(uint64_t after_sequence, uint32_t timeout_ms, lidar_frame_view_t *view)
+{
+    return lidar_frame_publisher_wait(&lidar_frames, after_sequence, timeout_ms, view);
+}
+
+/**
+ * @brief Release a frame view
+ * @param view View
+ */
+void hal_lidar_release_frame(lidar_frame_view_t *view)
+{
+    lidar_frame_publisher_release(&lidar_frames, view);
+}
+
+/**
+ * @brief Sequence of the latest published frame
+ * @return Sequence, 0 if none
+ */
+uint64_t hal_lidar_get_frame_sequence(void)
+{
+    return lidar_frame_publisher_sequence(&lidar_frames);
+}
+
+/**
+ * @brief Get frame publication statistics
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t hal_lidar_get_frame_stats(lidar_frame_stats_t *stats)
+{
+    return lidar_frame_publisher_get_stats(&lidar_frames, stats);
+}
+
+/**
+ * @brief Run a handler on the safety worker for every revolution
+ * @param handler Handler, NULL to remove
+ * @param ctx Passed to the handler
+ * @return HAL status
+ */
+hal_status_t hal_lidar_set_safety_handler(lidar_safety_handler_t handler, void *ctx)
+{
+    pthread_mutex_lock(&lidar_safety_hook.mutex);
+    lidar_safety_hook.handler = handler;
+    lidar_safety_hook.ctx = ctx;
+    pthread_mutex_unlock(&lidar_safety_hook.mutex);
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Get per-stage timing and frame-to-decision latency
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t hal_lidar_get_pipeline_stats(lidar_pipeline_stats_t *stats)
+{
+    if (!stats) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!lidar_pipeline.initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    return lidar_pipeline_get_stats(&lidar_pipeline, stats);
+}
+
 /**
  * @brief Check safety status
  * @param safety_status Pointer to safety status structure
@@ -475,8 +599,13 @@ hal_status_t hal_lidar_check_safety(lidar_safety_status_t *safety_status)
         return HAL_STATUS_NOT_INITIALIZED;
     }
     
-    // Process safety status from current scan
-    hal_status_t status = lidar_process_safety_status();
+    // Process safety status from the latest frame
+    lidar_frame_view_t view;
+    hal_status_t status = HAL_STATUS_ERROR;
+    if (lidar_frame_publisher_acquire(&lidar_frames, &view) == HAL_STATUS_OK) {
+        status = lidar_process_safety_status(view.scan);
+        lidar_frame_publisher_release(&lidar_frames, &view);
+    }
     if (status == HAL_STATUS_OK) {
         // Copy safety status
         memcpy(safety_status, &lidar_state.safety_status, sizeof(lidar_safety_status_t));
@@ -521,7 +650,7 @@ hal_status_t hal_lidar_get_device_info(lidar_device_info_t *device_info)
             lidar_state.device_info.hardware_version = response[2];
             memcpy(&lidar_state.device_info.serial_number, &response[3], 4);
             lidar_state.device_info.device_healthy = (response[7] == 0);
-            lidar_state.device_info.timestamp_us = lidar_get_timestamp_us();
+            lidar_state.device_info.timestamp_us = hal_time_now_us();
         }
     }
     
@@ -615,17 +744,16 @@ uint16_t lidar_calculate_min_distance(const lidar_scan_data_t *scan_data)
     if (scan_data->point_count > 0) {
         printf("DEBUG: calc_min - first distances: ");
         for (int k = 0; k < (scan_data->point_count > 5 ? 5 : scan_data->point_count); k++) {
-            printf("%u ", (unsigned)scan_data->points[k].distance_mm);
+            printf("%u ", (unsigned)scan_data->distance_mm[k]);
         }
         printf("\n");
     }
 #endif
     
-    for (int i = 0; i < (int)scan_data->point_count; i++) {
-        if (scan_data->points[i].distance_mm > 0 && 
-            scan_data->points[i].distance_mm < min_distance) {
-            min_distance = scan_data->points[i].distance_mm;
-        }
+    lidar_kernel_extremes_t extremes;
+    lidar_kernel_extremes(scan_data->distance_mm, scan_data->point_count, &extremes);
+    if (extremes.min_mm < min_distance) {
+        min_distance = extremes.min_mm;
     }
     
     // Debug: result - ONLY WHEN DEBUG_LIDAR_SAFETY is defined
@@ -658,11 +786,9 @@ uint16_t lidar_calculate_max_distance(const lidar_scan_data_t *scan_data)
         return max_distance;
     }
     
-    for (int i = 0; i < (int)scan_data->point_count; i++) {
-        if (scan_data->points[i].distance_mm > max_distance) {
-            max_distance = scan_data->points[i].distance_mm;
-        }
-    }
+    lidar_kernel_extremes_t extremes;
+    lidar_kernel_extremes(scan_data->distance_mm, scan_data->point_count, &extremes);
+    max_distance = extremes.max_mm;
     
     return max_distance;
 }
@@ -711,30 +837,144 @@ hal_status_t lidar_validate_config(const lidar_config_t *config)
 }
 
 // Internal functions implementation (real implementations)
+
+/**
+ * @brief Framer callback: hand a complete revolution to the pipeline, take the next buffer
+ * @param ctx Unused
+ * @param scan Completed revolution (NULL if the last one was dropped)
+ * @return Free pipeline buffer for the next revolution, NULL if all are in flight
+ */
+static lidar_scan_data_t *lidar_publish_revolution(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    
+    if (scan && scan->scan_complete) {
+        lidar_pipeline_submit(&lidar_pipeline, scan, lidar_framing_ns);
+    }
+    lidar_framing_ns = 0;
+    
+    return lidar_pipeline_acquire(&lidar_pipeline);
+}
+
+/**
+ * @brief Filter stage: calibration, then the multi-frame window filters
+ */
+static void lidar_stage_filter(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    
+    pthread_mutex_lock(&lidar_state.mutex);
+    if (lidar_state.calibration_enabled) {
+        if (lidar_state.calibration.enable_dynamic_calibration) {
+            lidar_apply_dynamic_calibration(scan);
+        } else {
+            lidar_apply_distance_calibration(scan);
+        }
+    }
+    lidar_apply_window_filters(scan);
+    pthread_mutex_unlock(&lidar_state.mutex);
+}
+
+/**
+ * @brief Safety stage: HAL safety status, then the application's handler
+ */
+static void lidar_stage_safety(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    
+    pthread_mutex_lock(&lidar_state.mutex);
+    lidar_process_safety_status(scan);
+    pthread_mutex_unlock(&lidar_state.mutex);
+    
+    pthread_mutex_lock(&lidar_safety_hook.mutex);
+    lidar_safety_handler_t handler = lidar_safety_hook.handler;
+    void *handler_ctx = lidar_safety_hook.ctx;
+    pthread_mutex_unlock(&lidar_safety_hook.mutex);
+    
+    if (handler) {
+        hal_status_t status = handler(handler_ctx, scan);
+        if (status != HAL_STATUS_OK) {
+            // No decision for this revolution: fail safe
+            pthread_mutex_lock(&lidar_state.mutex);
+            lidar_state.safety_status.emergency_stop_triggered = true;
+            pthread_mutex_unlock(&lidar_state.mutex);
+            HAL_LOG_RATELIMITED(HAL_LOG_COMP_SYSTEM, HAL_LOG_LEVEL_ERROR, 1000,
+                                "[LIDAR] Safety handler failed (%d) - emergency stop flagged", status);
+        }
+    }
+}
+
+/**
+ * @brief Reduce stage: publish the frame for API readers
+ */
+static void lidar_stage_reduce(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    
+    // NULL: every publisher slot is held by readers, the publisher counts the drop
+    lidar_scan_data_t *frame = lidar_frame_publisher_begin(&lidar_frames);
+    if (frame == NULL) {
+        return;
+    }
+    memcpy(frame, scan, sizeof(*frame));
+    
+    uint64_t now_us = hal_time_now_us();
+    lidar_frame_publisher_publish(&lidar_frames, now_us);
+    
+    pthread_mutex_lock(&lidar_state.mutex);
+    lidar_state.scan_count++;
+    lidar_state.last_scan_timestamp_us = now_us;
+    pthread_mutex_unlock(&lidar_state.mutex);
+}
+
 static void* lidar_scan_thread(void *arg __attribute__((unused)))
 {
     uint8_t buffer[1024];
     size_t actual_len;
+    uint32_t sample_rate_hz = lidar_state.config.sample_rate_hz ? lidar_state.config.sample_rate_hz : LIDAR_SAMPLE_RATE_HZ;
+    
+    // Revolutions are framed across reads and decoded straight into a pipeline buffer
+    lidar_framing_ns = 0;
+    lidar_framer_init(&lidar_framer, 1000000U / sample_rate_hz, lidar_publish_revolution, NULL,
+                      lidar_pipeline_acquire(&lidar_pipeline));
+#ifdef LIDAR_ALLOW_SIMULATED_LIDAR
+    lidar_scan_data_t *simulated = NULL;
+#endif
     
     while (lidar_state.scanning) {
+#ifdef LIDAR_ALLOW_SIMULATED_LIDAR
+        if (lidar_state.device_fd < 0) {
+            if (simulated == NULL) {
+                simulated = lidar_pipeline_acquire(&lidar_pipeline);
+            }
+            if (simulated != NULL && lidar_generate_simulated_data(simulated) == HAL_STATUS_OK) {
+                simulated = lidar_publish_revolution(NULL, simulated);
+            }
+            uint16_t rate_hz = lidar_state.config.scan_rate_hz ? lidar_state.config.scan_rate_hz : LIDAR_SCAN_RATE_TYPICAL_HZ;
+            hal_sleep_us(1000000U / rate_hz);
+            continue;
+        }
+#endif
         // Read scan data from device
         hal_status_t status = lidar_read_response(buffer, sizeof(buffer), &actual_len);
         if (status == HAL_STATUS_OK && actual_len > 0) {
-            // Parse scan data
-            lidar_parse_scan_data(buffer, actual_len, &lidar_state.current_scan);
-            
-            // Update safety status
-            lidar_process_safety_status();
-            
-            // Update statistics
-            lidar_state.scan_count++;
-            lidar_state.last_scan_timestamp_us = lidar_get_timestamp_us();
+            // One clock read stamps the bytes and starts the framing timer
+            uint64_t t0 = hal_time_now_ns();
+            lidar_framer_feed(&lidar_framer, buffer, actual_len, t0 / 1000ULL);
+            // Charged to the revolution in progress; a completed one was charged on submit
+            lidar_framing_ns += hal_time_now_ns() - t0;
         }
         
         // Small delay to prevent busy waiting
         hal_sleep_us(1000); // 1ms
     }
     
+    lidar_framer_stats_t stats;
+    lidar_framer_get_stats(&lidar_framer, &stats);
+    printf("[LIDAR] Framer: %llu revolutions, %llu points, %llu resyncs, %llu bytes discarded\n",
+           (unsigned long long)stats.revolutions, (unsigned long long)stats.points,
+           (unsigned long long)stats.resyncs, (unsigned long long)stats.discarded_bytes);
+    
     return NULL;
 }
 
@@ -844,13 +1084,6 @@ static hal_status_t lidar_read_response(uint8_t *buffer, size_t max_len, size_t
     return HAL_STATUS_OK;
 }
 
-static uint64_t lidar_get_timestamp_us(void)
-{
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
-}
-
 static hal_status_t lidar_generate_simulated_data(lidar_scan_data_t *scan_data)
 {
     if (!scan_data) {
@@ -860,7 +1093,9 @@ static hal_status_t lidar_generate_simulated_data(lidar_scan_data_t *scan_data)
     // Generate simulated 360-degree scan data
     scan_data->point_count = 0;
     scan_data->scan_complete = true;
-    scan_data->scan_timestamp_us = lidar_get_timestamp_us();
+    scan_data->scan_timestamp_us = hal_time_now_us();
+    scan_data->base_timestamp_us = scan_data->scan_timestamp_us;
+    scan_data->point_period_us = 1000000U / (LIDAR_SCAN_RATE_TYPICAL_HZ * 180U);
     
     // Generate points around a room (4 walls + obstacles)
     for (int angle = 0; angle < 360; angle += 2) { // Every 2 degrees
@@ -892,10 +1127,9 @@ static hal_status_t lidar_generate_simulated_data(lidar_scan_data_t *scan_data)
         if (distance < 500) distance = 500;
         if (distance > 8000) distance = 8000;
         
-        scan_data->points[scan_data->point_count].distance_mm = distance;
-        scan_data->points[scan_data->point_count].angle_deg = angle;
-        scan_data->points[scan_data->point_count].quality = quality;
-        scan_data->points[scan_data->point_count].timestamp_us = lidar_get_timestamp_us();
+        scan_data->distance_mm[scan_data->point_count] = distance;
+        scan_data->angle_q6[scan_data->point_count] = (uint16_t)(angle * 64);
+        scan_data->quality[scan_data->point_count] = quality;
         
         scan_data->point_count++;
     }
@@ -904,95 +1138,23 @@ static hal_status_t lidar_generate_simulated_data(lidar_scan_data_t *scan_data)
     return HAL_STATUS_OK;
 }
 
-static hal_status_t lidar_parse_scan_data(const uint8_t *data, size_t len, lidar_scan_data_t *scan_data)
-{
-    if (!data || !scan_data || len < 5) {
-        return HAL_STATUS_INVALID_PARAMETER;
-    }
-    
-    // Enhanced parsing for RPLIDAR scan data
-    // Reset scan data
-    scan_data->point_count = 0;
-    scan_data->scan_complete = false;
-    scan_data->scan_timestamp_us = lidar_get_timestamp_us();
-    
-    // Parse all available data points
-    for (size_t i = 0; i < len - 4; i++) {
-        // Look for scan start marker (0xA5 0x5A)
-        if (data[i] == 0xA5 && data[i+1] == 0x5A) {
-            // Reset point count when new scan starts
-            scan_data->point_count = 0;
-            scan_data->scan_complete = false;
-            continue;
-        }
-        
-        // Parse scan point data (5-byte format: distance_low, distance_high, angle_low, angle_high, quality)
-        if (scan_data->point_count < LIDAR_POINTS_PER_SCAN && i + 4 < len) {
-            uint16_t distance = (data[i+1] << 8) | data[i];
-            uint16_t angle = (data[i+3] << 8) | data[i+2];
-            uint8_t quality = data[i+4];
-            
-            // Skip invalid points (distance or quality is zero)
-            if (distance == 0 || quality == 0) {
-                continue;
-            }
-            
-            // Convert to proper units
-            scan_data->points[scan_data->point_count].distance_mm = distance * 4; // Scale factor
-            // Normalize angle to 0..359 degrees
-            {
-                int ang_deg = (int)(angle / 64.0f);
-                ang_deg = ((ang_deg % 360) + 360) % 360;
-                scan_data->points[scan_data->point_count].angle_deg = ang_deg;
-            }
-            scan_data->points[scan_data->point_count].quality = quality;
-            scan_data->points[scan_data->point_count].timestamp_us = lidar_get_timestamp_us();
-            
-            scan_data->point_count++;
-            
-            // Check if scan is complete (full rotation or enough points)
-            if (scan_data->point_count >= 360) { // Full rotation
-                scan_data->scan_complete = true;
-                scan_data->scan_timestamp_us = lidar_get_timestamp_us();
-                break;
-            }
-        }
-    }
-    
-    // Mark as complete if we have enough points
-    if (scan_data->point_count > 0) {
-        scan_data->scan_complete = true;
-        // Only log when a full 360° frame is achieved
-        if (scan_data->point_count >= 360) {
-            printf("LiDAR 360 frame complete: points=%u\n", scan_data->point_count);
-            uint16_t debug_count = 5;
-            for (uint16_t di = 0; di < debug_count; di++) {
-                printf("  p[%u]: d=%u mm, a=%d deg, q=%u\n",
-                       di,
-                       scan_data->points[di].distance_mm,
-                       scan_data->points[di].angle_deg,
-                       scan_data->points[di].quality);
-            }
-        }
-    }
-    
-    return HAL_STATUS_OK;
-}
-
-static hal_status_t lidar_process_safety_status(void)
+static hal_status_t lidar_process_safety_status(const lidar_scan_data_t *scan)
 {
-    if (!lidar_state.current_scan.scan_complete) {
+    if (!scan || !scan->scan_complete) {
         return HAL_STATUS_ERROR;
     }
     
-    // Calculate safety metrics
-    uint16_t min_distance = lidar_calculate_min_distance(&lidar_state.current_scan);
-    uint16_t max_distance = lidar_calculate_max_distance(&lidar_state.current_scan);
+    // Nearest and farthest return in one vector pass
+    lidar_kernel_extremes_t extremes;
+    lidar_kernel_extremes(scan->distance_mm, scan->point_count, &extremes);
+    uint16_t min_distance = extremes.min_mm < LIDAR_MAX_DISTANCE_MM ? extremes.min_mm : LIDAR_MAX_DISTANCE_MM;
     
     // Update safety status
     lidar_state.safety_status.min_distance_mm = min_distance;
-    lidar_state.safety_status.max_distance_mm = max_distance;
-    lidar_state.safety_status.timestamp_us = lidar_get_timestamp_us();
+    lidar_state.safety_status.min_distance_angle = lidar_angle_q6_to_deg(scan->angle_q6[extremes.min_index]);
+    lidar_state.safety_status.max_distance_mm = extremes.max_mm;
+    lidar_state.safety_status.max_distance_angle = lidar_angle_q6_to_deg(scan->angle_q6[extremes.max_index]);
+    lidar_state.safety_status.timestamp_us = hal_time_now_us();
     
     // Check safety thresholds
     lidar_state.safety_status.obstacle_detected = (min_distance < lidar_state.config.warning_mm);
@@ -1194,6 +1356,7 @@ hal_status_t hal_lidar_configure_accuracy(const lidar_accuracy_config_t *config)
     // Copy configuration
     memcpy(&lidar_state.accuracy_config, config, sizeof(lidar_accuracy_config_t));
     lidar_state.accuracy_enabled = true;
+    lidar_configure_windows();
     
     printf("[LIDAR-ENHANCED] Accuracy configured: samples=%d, interval=%dms, outlier_filter=%s (%.1f%%), smoothing=%s\n",
            config->sample_count, config->sample_interval_ms,
@@ -1226,7 +1389,7 @@ hal_status_t hal_lidar_calibrate_distance(uint16_t known_distance_mm)
         lidar_state.calibration.reference_distance = known_distance_mm;
         lidar_state.calibration.distance_offset = (float)known_distance_mm - (float)measured_distance;
         lidar_state.calibration.calibration_count++;
-        lidar_state.calibration.last_calibration_us = lidar_get_timestamp_us();
+        lidar_state.calibration.last_calibration_us = hal_time_now_us();
         
         printf("[LIDAR-ENHANCED] Distance calibrated: known=%dmm, measured=%dmm, factor=%.3f, offset=%.1fmm\n",
                known_distance_mm, measured_distance, 
@@ -1370,30 +1533,29 @@ static hal_status_t lidar_apply_adaptive_resolution(const lidar_scan_data_t *inp
     // Initialize output scan
     memset(output_scan, 0, sizeof(lidar_scan_data_t));
     output_scan->scan_timestamp_us = input_scan->scan_timestamp_us;
+    output_scan->base_timestamp_us = input_scan->base_timestamp_us;
+    output_scan->point_period_us = input_scan->point_period_us;
     output_scan->scan_complete = input_scan->scan_complete;
     
     uint16_t output_index = 0;
     
     // Process each input point
     for (uint16_t i = 0; i < input_scan->point_count && output_index < LIDAR_POINTS_PER_SCAN; i++) {
-        uint16_t angle = input_scan->points[i].angle_deg;
+        uint16_t angle = lidar_angle_q6_to_deg(input_scan->angle_q6[i]);
         float resolution = lidar_get_resolution_for_angle(angle);
         
-        // If in focus area, add additional interpolated points for higher resolution
-        if (lidar_is_angle_in_focus_area(angle)) {
-            // Add original point
-            output_scan->points[output_index] = input_scan->points[i];
-            output_index++;
-            
-            // Add interpolated points for higher resolution (simplified)
-            if (output_index < LIDAR_POINTS_PER_SCAN - 1) {
-                output_scan->points[output_index] = input_scan->points[i];
-                output_scan->points[output_index].angle_deg = (angle + (uint16_t)(resolution / 2)) % 360;
-                output_index++;
-            }
-        } else {
-            // Add original point for non-focus areas
-            output_scan->points[output_index] = input_scan->points[i];
+        // Add original point
+        output_scan->distance_mm[output_index] = input_scan->distance_mm[i];
+        output_scan->angle_q6[output_index] = input_scan->angle_q6[i];
+        output_scan->quality[output_index] = input_scan->quality[i];
+        output_index++;
+        
+        // If in focus area, add interpolated points for higher resolution (simplified)
+        if (lidar_is_angle_in_focus_area(angle) && output_index < LIDAR_POINTS_PER_SCAN - 1) {
+            output_scan->distance_mm[output_index] = input_scan->distance_mm[i];
+            output_scan->angle_q6[output_index] = (uint16_t)((input_scan->angle_q6[i] + (uint16_t)(resolution * 32.0f)) %
+                                                             LIDAR_ANGLE_Q6_FULL_TURN);
+            output_scan->quality[output_index] = input_scan->quality[i];
             output_index++;
         }
     }
@@ -1420,7 +1582,7 @@ static hal_status_t lidar_apply_multi_sample_averaging(lidar_scan_data_t *scan_d
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
         // Apply averaging (placeholder implementation)
         // Real implementation would collect multiple samples over time
-        scan_data->points[i].quality = (scan_data->points[i].quality + 10) % 256; // Improve quality
+        scan_data->quality[i] = (uint8_t)((scan_data->quality[i] + 10) % 256); // Improve quality
     }
     
     return HAL_STATUS_OK;
@@ -1443,11 +1605,13 @@ static hal_status_t lidar_apply_outlier_filtering(lidar_scan_data_t *scan_data)
     uint16_t valid_points = 0;
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
         // Simple outlier detection based on distance range
-        if (scan_data->points[i].distance_mm >= LIDAR_MIN_DISTANCE_MM && 
-            scan_data->points[i].distance_mm <= LIDAR_MAX_DISTANCE_MM) {
+        if (scan_data->distance_mm[i] >= LIDAR_MIN_DISTANCE_MM && 
+            scan_data->distance_mm[i] <= LIDAR_MAX_DISTANCE_MM) {
             // Keep valid points
             if (valid_points != i) {
-                scan_data->points[valid_points] = scan_data->points[i];
+                scan_data->distance_mm[valid_points] = scan_data->distance_mm[i];
+                scan_data->angle_q6[valid_points] = scan_data->angle_q6[i];
+                scan_data->quality[valid_points] = scan_data->quality[i];
             }
             valid_points++;
         }
@@ -1469,9 +1633,13 @@ static hal_status_t lidar_apply_distance_calibration(lidar_scan_data_t *scan_dat
         return HAL_STATUS_OK;
     }
     
-    // Apply calibration factor and offset
+    // Apply calibration factor and offset (points without a return stay at 0)
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
-        float calibrated_distance = (float)scan_data->points[i].distance_mm * 
+        if (scan_data->distance_mm[i] == 0) {
+            continue;
+        }
+        
+        float calibrated_distance = (float)scan_data->distance_mm[i] * 
                                    lidar_state.calibration.calibration_factor + 
                                    lidar_state.calibration.distance_offset;
         
@@ -1482,7 +1650,7 @@ static hal_status_t lidar_apply_distance_calibration(lidar_scan_data_t *scan_dat
             calibrated_distance = LIDAR_MAX_DISTANCE_MM;
         }
         
-        scan_data->points[i].distance_mm = (uint16_t)calibrated_distance;
+        scan_data->distance_mm[i] = (uint16_t)calibrated_distance;
     }
     
     return HAL_STATUS_OK;
@@ -1498,16 +1666,12 @@ static hal_status_t lidar_apply_distance_calibration(lidar_scan_data_t *scan_dat
  */
 static hal_status_t lidar_initialize_advanced_features(void)
 {
-    // Initialize multi-sample buffer
-    memset(lidar_state.sample_buffer, 0, sizeof(lidar_state.sample_buffer));
-    lidar_state.current_sample_index = 0;
-    lidar_state.valid_samples = 0;
+    // Multi-sample and temporal windows start empty
     lidar_state.statistical_confidence = LIDAR_DEFAULT_CONFIDENCE;
-    
-    // Initialize temporal filtering
-    memset(lidar_state.temporal_buffer, 0, sizeof(lidar_state.temporal_buffer));
     lidar_state.temporal_filtering_enabled = false;
-    lidar_state.temporal_index = 0;
+    lidar_state.sample_window.frames = 0;
+    lidar_state.temporal_window.frames = 0;
+    lidar_configure_windows();
     
     // Initialize calibration drift detection
     lidar_state.calibration_drift_detected = 0.0f;
@@ -1545,6 +1709,7 @@ hal_status_t hal_lidar_configure_advanced_accuracy(const lidar_accuracy_config_t
     lidar_state.accuracy_enabled = true;
     lidar_state.statistical_confidence = config->confidence_level;
     lidar_state.temporal_filtering_enabled = config->enable_temporal_filtering;
+    lidar_configure_windows();
     
     printf("[LIDAR-ADVANCED] Advanced accuracy configured: statistical=%s (%.1f%%), weighted=%s, temporal=%s (%d), quality_threshold=%.1f\n",
            config->enable_statistical_averaging ? "YES" : "NO", config->confidence_level,
@@ -1614,6 +1779,7 @@ hal_status_t hal_lidar_enable_temporal_filtering(bool enable, uint8_t window_siz
     lidar_state.accuracy_config.enable_temporal_filtering = enable;
     lidar_state.accuracy_config.temporal_window_size = window_size;
     lidar_state.temporal_filtering_enabled = enable;
+    lidar_configure_windows();
     
     printf("[LIDAR-ADVANCED] Temporal filtering %s with window size %d\n",
            enable ? "enabled" : "disabled", window_size);
@@ -1713,6 +1879,51 @@ hal_status_t hal_lidar_get_calibration_confidence(float *confidence)
 // ADVANCED INTERNAL FUNCTIONS
 // ============================================================================
 
+/**
+ * @brief Size the sliding windows from the accuracy configuration
+ * 
+ * A window whose length changes starts empty. Caller holds lidar_state.mutex.
+ */
+static void lidar_configure_windows(void)
+{
+    uint8_t sample_frames = lidar_state.accuracy_config.sample_count;
+    uint8_t temporal_frames = lidar_state.accuracy_config.temporal_window_size;
+    
+    sample_frames = sample_frames < 1 ? 1 : (sample_frames > LIDAR_WINDOW_MAX_FRAMES ? LIDAR_WINDOW_MAX_FRAMES : sample_frames);
+    temporal_frames = temporal_frames < 1 ? 1 : (temporal_frames > LIDAR_WINDOW_MAX_FRAMES ? LIDAR_WINDOW_MAX_FRAMES : temporal_frames);
+    
+    if (lidar_state.sample_window.frames != sample_frames) {
+        lidar_window_init(&lidar_state.sample_window, sample_frames);
+    }
+    if (lidar_state.temporal_window.frames != temporal_frames) {
+        lidar_window_init(&lidar_state.temporal_window, temporal_frames);
+    }
+}
+
+/**
+ * @brief Run the enabled multi-sample and temporal filters on a frame
+ * @param scan_data Frame, rewritten in place
+ * 
+ * Each filter costs one window push (points + bins) and one lookup per
+ * point, independent of the window length. Caller holds lidar_state.mutex.
+ */
+static void lidar_apply_window_filters(lidar_scan_data_t *scan_data)
+{
+    if (lidar_state.accuracy_enabled &&
+        (lidar_state.accuracy_config.enable_outlier_filter ||
+         lidar_state.accuracy_config.enable_statistical_averaging ||
+         lidar_state.accuracy_config.enable_weighted_averaging)) {
+        lidar_window_push(&lidar_state.sample_window, scan_data);
+        lidar_detect_outliers_advanced(scan_data);
+        lidar_apply_statistical_averaging(scan_data);
+        lidar_apply_weighted_averaging(scan_data);
+    }
+    
+    if (lidar_state.temporal_filtering_enabled) {
+        lidar_apply_temporal_filtering(scan_data);
+    }
+}
+
 /**
  * @brief Apply statistical averaging with confidence intervals
  * @param scan_data Scan data to process
@@ -1724,41 +1935,24 @@ static hal_status_t lidar_apply_statistical_averaging(lidar_scan_data_t *scan_da
         return HAL_STATUS_OK;
     }
     
-    // Statistical averaging implementation
+    float confidence_factor = lidar_state.statistical_confidence / 100.0f;
+    
+    // Each point against the running statistics of its degree over the sample window
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
-        // Collect multiple samples for this point
-        uint16_t samples[LIDAR_MAX_SAMPLE_COUNT];
-        uint8_t valid_sample_count = 0;
-        
-        // Get samples from buffer
-        for (uint8_t j = 0; j < lidar_state.valid_samples; j++) {
-            if (i < lidar_state.sample_buffer[j].point_count) {
-                samples[valid_sample_count] = lidar_state.sample_buffer[j].points[i].distance_mm;
-                valid_sample_count++;
-            }
+        if (scan_data->distance_mm[i] == 0) {
+            continue;
         }
         
-        if (valid_sample_count > 1) {
-            // Calculate mean
-            float sum = 0.0f;
-            for (uint8_t k = 0; k < valid_sample_count; k++) {
-                sum += (float)samples[k];
-            }
-            float mean = sum / (float)valid_sample_count;
-            
-            // Calculate standard deviation
-            float std_dev = lidar_calculate_standard_deviation(samples, valid_sample_count, mean);
-            
+        lidar_window_stats_t stats;
+        lidar_window_get_stats(&lidar_state.sample_window, lidar_window_bin(scan_data->angle_q6[i]), &stats);
+        
+        if (stats.count > 1) {
             // Apply statistical filtering based on confidence level
-            float confidence_factor = lidar_state.statistical_confidence / 100.0f;
-            float threshold = std_dev * (1.0f - confidence_factor);
+            float threshold = stats.stddev_mm * (1.0f - confidence_factor);
             
-            // Filter outliers
-            if (fabs((float)scan_data->points[i].distance_mm - mean) <= threshold) {
-                // Keep original value
-            } else {
-                // Use mean value
-                scan_data->points[i].distance_mm = (uint16_t)mean;
+            // Outside the interval: use the mean
+            if (fabsf((float)scan_data->distance_mm[i] - stats.mean_mm) > threshold) {
+                scan_data->distance_mm[i] = (uint16_t)stats.mean_mm;
             }
         }
     }
@@ -1777,26 +1971,17 @@ static hal_status_t lidar_apply_weighted_averaging(lidar_scan_data_t *scan_data)
         return HAL_STATUS_OK;
     }
     
-    // Weighted averaging implementation
+    // Quality-weighted mean of the point's degree over the sample window
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
-        // Collect samples with weights
-        uint16_t samples[LIDAR_MAX_SAMPLE_COUNT];
-        uint8_t weights[LIDAR_MAX_SAMPLE_COUNT];
-        uint8_t valid_sample_count = 0;
-        
-        // Get samples from buffer with quality as weights
-        for (uint8_t j = 0; j < lidar_state.valid_samples; j++) {
-            if (i < lidar_state.sample_buffer[j].point_count) {
-                samples[valid_sample_count] = lidar_state.sample_buffer[j].points[i].distance_mm;
-                weights[valid_sample_count] = lidar_state.sample_buffer[j].points[i].quality;
-                valid_sample_count++;
-            }
+        if (scan_data->distance_mm[i] == 0) {
+            continue;
         }
         
-        if (valid_sample_count > 1) {
-            // Calculate weighted average
-            float weighted_avg = lidar_calculate_weighted_average(samples, weights, valid_sample_count);
-            scan_data->points[i].distance_mm = (uint16_t)weighted_avg;
+        lidar_window_stats_t stats;
+        lidar_window_get_stats(&lidar_state.sample_window, lidar_window_bin(scan_data->angle_q6[i]), &stats);
+        
+        if (stats.count > 1) {
+            scan_data->distance_mm[i] = (uint16_t)stats.weighted_mean_mm;
         }
     }
     
@@ -1814,37 +1999,23 @@ static hal_status_t lidar_apply_temporal_filtering(lidar_scan_data_t *scan_data)
         return HAL_STATUS_OK;
     }
     
-    // Add current scan to temporal buffer
-    lidar_state.temporal_buffer[lidar_state.temporal_index] = *scan_data;
-    lidar_state.temporal_index = (lidar_state.temporal_index + 1) % lidar_state.accuracy_config.temporal_window_size;
+    // Slide the window by this frame: per-degree sums, no frame copy
+    lidar_window_push(&lidar_state.temporal_window, scan_data);
     
-    // Apply temporal filtering
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
-        uint16_t temporal_samples[LIDAR_MAX_TEMPORAL_WINDOW];
-        uint8_t valid_temporal_count = 0;
-        
-        // Collect temporal samples
-        for (uint8_t j = 0; j < lidar_state.accuracy_config.temporal_window_size; j++) {
-            if (i < lidar_state.temporal_buffer[j].point_count) {
-                temporal_samples[valid_temporal_count] = lidar_state.temporal_buffer[j].points[i].distance_mm;
-                valid_temporal_count++;
-            }
+        if (scan_data->distance_mm[i] == 0) {
+            continue;
         }
         
-        if (valid_temporal_count > 1) {
-            // Apply temporal smoothing (moving average)
-            float sum = 0.0f;
-            for (uint8_t k = 0; k < valid_temporal_count; k++) {
-                sum += (float)temporal_samples[k];
-            }
-            float temporal_avg = sum / (float)valid_temporal_count;
-            
+        uint16_t bin = lidar_window_bin(scan_data->angle_q6[i]);
+        
+        if (lidar_window_count(&lidar_state.temporal_window, bin) > 1) {
             // Blend with current value
             float blend_factor = 0.7f; // 70% temporal, 30% current
-            float blended_value = temporal_avg * blend_factor + 
-                                 (float)scan_data->points[i].distance_mm * (1.0f - blend_factor);
+            float blended_value = lidar_window_mean_mm(&lidar_state.temporal_window, bin) * blend_factor + 
+                                 (float)scan_data->distance_mm[i] * (1.0f - blend_factor);
             
-            scan_data->points[i].distance_mm = (uint16_t)blended_value;
+            scan_data->distance_mm[i] = (uint16_t)blended_value;
         }
     }
     
@@ -1862,44 +2033,24 @@ static hal_status_t lidar_detect_outliers_advanced(lidar_scan_data_t *scan_data)
         return HAL_STATUS_OK;
     }
     
-    // Advanced outlier detection using Z-score method
+    // Threshold based on confidence level
+    float z_threshold = 2.0f; // 95% confidence (2 standard deviations)
+    if (lidar_state.statistical_confidence >= 99.0f) {
+        z_threshold = 3.0f; // 99% confidence (3 standard deviations)
+    }
+    
+    // Z-score of each point against its degree over the sample window
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
-        // Calculate Z-score for this point
-        uint16_t samples[LIDAR_MAX_SAMPLE_COUNT];
-        uint8_t valid_sample_count = 0;
-        
-        // Get samples from buffer
-        for (uint8_t j = 0; j < lidar_state.valid_samples; j++) {
-            if (i < lidar_state.sample_buffer[j].point_count) {
-                samples[valid_sample_count] = lidar_state.sample_buffer[j].points[i].distance_mm;
-                valid_sample_count++;
-            }
+        if (scan_data->distance_mm[i] == 0) {
+            continue;
         }
         
-        if (valid_sample_count > 2) {
-            // Calculate mean and standard deviation
-            float sum = 0.0f;
-            for (uint8_t k = 0; k < valid_sample_count; k++) {
-                sum += (float)samples[k];
-            }
-            float mean = sum / (float)valid_sample_count;
-            float std_dev = lidar_calculate_standard_deviation(samples, valid_sample_count, mean);
-            
-            if (std_dev > 0.0f) {
-                // Calculate Z-score
-                float z_score = fabs((float)scan_data->points[i].distance_mm - mean) / std_dev;
-                
-                // Threshold based on confidence level
-                float z_threshold = 2.0f; // 95% confidence (2 standard deviations)
-                if (lidar_state.statistical_confidence >= 99.0f) {
-                    z_threshold = 3.0f; // 99% confidence (3 standard deviations)
-                }
-                
-                // Filter outlier
-                if (z_score > z_threshold) {
-                    scan_data->points[i].distance_mm = (uint16_t)mean;
-                }
-            }
+        uint16_t bin = lidar_window_bin(scan_data->angle_q6[i]);
+        
+        // Filter outlier
+        if (lidar_window_count(&lidar_state.sample_window, bin) > 2 &&
+            lidar_window_exceeds_sigma(&lidar_state.sample_window, bin, scan_data->distance_mm[i], z_threshold)) {
+            scan_data->distance_mm[i] = (uint16_t)lidar_window_mean_mm(&lidar_state.sample_window, bin);
         }
     }
     
@@ -1923,8 +2074,8 @@ static hal_status_t lidar_calculate_statistical_confidence(const lidar_scan_data
     uint16_t valid_points = 0;
     
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
-        if (scan_data->points[i].quality > lidar_state.accuracy_config.quality_threshold) {
-            quality_sum += (float)scan_data->points[i].quality;
+        if (scan_data->quality[i] > lidar_state.accuracy_config.quality_threshold) {
+            quality_sum += (float)scan_data->quality[i];
             valid_points++;
         }
     }
@@ -1952,8 +2103,12 @@ static hal_status_t lidar_apply_dynamic_calibration(lidar_scan_data_t *scan_data
     
     // Dynamic calibration based on multiple reference points
     for (uint16_t i = 0; i < scan_data->point_count; i++) {
+        if (scan_data->distance_mm[i] == 0) {
+            continue;
+        }
+        
         // Apply dynamic calibration factor based on distance
-        float distance = (float)scan_data->points[i].distance_mm;
+        float distance = (float)scan_data->distance_mm[i];
         float dynamic_factor = lidar_state.calibration.calibration_factor;
         
         // Adjust factor based on distance (closer = more accurate)
@@ -1973,7 +2128,7 @@ static hal_status_t lidar_apply_dynamic_calibration(lidar_scan_data_t *scan_data
             calibrated_distance = LIDAR_MAX_DISTANCE_MM;
         }
         
-        scan_data->points[i].distance_mm = (uint16_t)calibrated_distance;
+        scan_data->distance_mm[i] = (uint16_t)calibrated_distance;
     }
     
     return HAL_STATUS_OK;
@@ -1985,7 +2140,7 @@ static hal_status_t lidar_apply_dynamic_calibration(lidar_scan_data_t *scan_data
  */
 static hal_status_t lidar_detect_calibration_drift_internal(void)
 {
-    uint64_t current_time = lidar_get_timestamp_us();
+    uint64_t current_time = hal_time_now_us();
     
     // Check drift every 30 seconds
     if (current_time - lidar_state.last_drift_check_us < 30000000) { // 30 seconds
@@ -2051,53 +2206,6 @@ static hal_status_t lidar_calibrate_multiple_points_internal(const uint16_t *dis
     return HAL_STATUS_OK;
 }
 
-/**
- * @brief Calculate weighted average
- * @param values Array of values
- * @param weights Array of weights
- * @param count Number of values
- * @return Weighted average
- */
-static float lidar_calculate_weighted_average(const uint16_t *values, const uint8_t *weights, uint8_t count)
-{
-    if (!values || !weights || count == 0) {
-        return 0.0f;
-    }
-    
-    float weighted_sum = 0.0f;
-    float total_weight = 0.0f;
-    
-    for (uint8_t i = 0; i < count; i++) {
-        weighted_sum += (float)values[i] * (float)weights[i];
-        total_weight += (float)weights[i];
-    }
-    
-    return total_weight > 0.0f ? weighted_sum / total_weight : 0.0f;
-}
-
-/**
- * @brief Calculate standard deviation
- * @param values Array of values
- * @param count Number of values
- * @param mean Mean value
- * @return Standard deviation
- */
-static float lidar_calculate_standard_deviation(const uint16_t *values, uint8_t count, float mean)
-{
-    if (!values || count == 0) {
-        return 0.0f;
-    }
-    
-    float sum_squared_diff = 0.0f;
-    
-    for (uint8_t i = 0; i < count; i++) {
-        float diff = (float)values[i] - mean;
-        sum_squared_diff += diff * diff;
-    }
-    
-    return sqrtf(sum_squared_diff / (float)count);
-}
-
 // ============================================================================
 // MULTI-THREADING & MEMORY POOL FUNCTIONS IMPLEMENTATION (NEW)
 // ============================================================================
@@ -2117,26 +2225,11 @@ static hal_status_t lidar_initialize_threading_system(void)
     lidar_state.threading_config.enable_thread_affinity = false;
     lidar_state.threading_config.thread_stack_size = LIDAR_THREAD_STACK_SIZE;
     
-    // Initialize thread arrays
-    memset(lidar_state.threads, 0, sizeof(lidar_state.threads));
-    memset(lidar_state.threads_running, false, sizeof(lidar_state.threads_running));
-    lidar_state.active_thread_count = 0;
     lidar_state.parallel_processing_enabled = true;
     
-    // Initialize mutexes and conditions
-    for (uint8_t i = 0; i < LIDAR_MAX_THREADS; i++) {
-        if (pthread_mutex_init(&lidar_state.thread_mutexes[i], NULL) != 0) {
-            printf("[LIDAR-THREADING] Failed to initialize mutex %d\n", i);
-            return HAL_STATUS_ERROR;
-        }
-        if (pthread_cond_init(&lidar_state.thread_conditions[i], NULL) != 0) {
-            printf("[LIDAR-THREADING] Failed to initialize condition %d\n", i);
-            return HAL_STATUS_ERROR;
-        }
-    }
-    
-    printf("[LIDAR-THREADING] Multi-threading system initialized with %d threads\n", 
-           lidar_state.threading_config.thread_count);
+    // Workers are started with scanning (hal_lidar_start_scanning), one per pipeline stage at most
+    printf("[LIDAR-THREADING] Multi-threading system initialized with %d threads (pipeline uses up to %d)\n", 
+           lidar_state.threading_config.thread_count, LIDAR_PIPELINE_MAX_WORKERS);
     return HAL_STATUS_OK;
 }
 
@@ -2433,61 +2526,6 @@ hal_status_t hal_lidar_compact_memory_pool(void)
 // MULTI-THREADING INTERNAL FUNCTIONS
 // ============================================================================
 
-/**
- * @brief Create thread
- * @param thread_id Thread ID
- * @param thread_func Thread function
- * @param arg Thread argument
- * @return HAL status
- */
-static hal_status_t lidar_create_thread(uint8_t thread_id, void *(*thread_func)(void *), void *arg)
-{
-    if (thread_id >= LIDAR_MAX_THREADS) {
-        return HAL_STATUS_INVALID_PARAMETER;
-    }
-    
-    if (pthread_create(&lidar_state.threads[thread_id], NULL, thread_func, arg) != 0) {
-        printf("[LIDAR-THREADING] Failed to create thread %d\n", thread_id);
-        return HAL_STATUS_ERROR;
-    }
-    
-    lidar_state.threads_running[thread_id] = true;
-    lidar_state.active_thread_count++;
-    
-    printf("[LIDAR-THREADING] Thread %d created successfully\n", thread_id);
-    return HAL_STATUS_OK;
-}
-
-/**
- * @brief Destroy thread
- * @param thread_id Thread ID
- * @return HAL status
- */
-static hal_status_t lidar_destroy_thread(uint8_t thread_id)
-{
-    if (thread_id >= LIDAR_MAX_THREADS) {
-        return HAL_STATUS_INVALID_PARAMETER;
-    }
-    
-    if (lidar_state.threads_running[thread_id]) {
-        lidar_state.threads_running[thread_id] = false;
-        
-        // Signal thread to exit
-        pthread_cond_signal(&lidar_state.thread_conditions[thread_id]);
-        
-        // Wait for thread to finish
-        if (pthread_join(lidar_state.threads[thread_id], NULL) != 0) {
-            printf("[LIDAR-THREADING] Failed to join thread %d\n", thread_id);
-            return HAL_STATUS_ERROR;
-        }
-        
-        lidar_state.active_thread_count--;
-        printf("[LIDAR-THREADING] Thread %d destroyed successfully\n", thread_id);
-    }
-    
-    return HAL_STATUS_OK;
-}
-
 /**
  * @brief Set thread priority
  * @param thread_id Thread ID
@@ -2500,10 +2538,17 @@ static hal_status_t lidar_set_thread_priority_internal(uint8_t thread_id, uint8_
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
+    // Thread IDs are pipeline workers; they only exist while scanning
+    pthread_t thread;
+    if (lidar_pipeline_get_worker(&lidar_pipeline, thread_id, &thread) != HAL_STATUS_OK) {
+        printf("[LIDAR-THREADING] Thread %d is not running\n", thread_id);
+        return HAL_STATUS_NOT_FOUND;
+    }
+    
     struct sched_param param;
     param.sched_priority = priority;
     
-    if (pthread_setschedparam(lidar_state.threads[thread_id], SCHED_FIFO, &param) != 0) {
+    if (pthread_setschedparam(thread, SCHED_FIFO, &param) != 0) {
         printf("[LIDAR-THREADING] Failed to set thread %d priority to %d\n", thread_id, priority);
         return HAL_STATUS_ERROR;
     }
@@ -2524,104 +2569,22 @@ static hal_status_t lidar_set_thread_affinity_internal(uint8_t thread_id, uint8_
         return HAL_STATUS_INVALID_PARAMETER;
     }
     
-    // CPU affinity disabled for compatibility
-    printf("[LIDAR-THREADING] CPU affinity disabled for compatibility (thread %d, CPU %d)\n", thread_id, cpu_core);
-    return HAL_STATUS_OK;
-}
-
-/**
- * @brief Processing thread function
- * @param arg Thread argument
- * @return Thread return value
- */
-static void* lidar_processing_thread(void *arg)
-{
-    uint8_t thread_id = *(uint8_t*)arg;
-    
-    printf("[LIDAR-THREADING] Processing thread %d started\n", thread_id);
-    
-    while (lidar_state.threads_running[thread_id]) {
-        // Wait for work
-        pthread_mutex_lock(&lidar_state.thread_mutexes[thread_id]);
-        pthread_cond_wait(&lidar_state.thread_conditions[thread_id], &lidar_state.thread_mutexes[thread_id]);
-        pthread_mutex_unlock(&lidar_state.thread_mutexes[thread_id]);
-        
-        if (lidar_state.threads_running[thread_id]) {
-            // Process LiDAR data in parallel
-            printf("[LIDAR-THREADING] Processing thread %d processing data\n", thread_id);
-            
-            // Simulate processing work
-            hal_sleep_us(1000); // 1ms processing time
-        }
+    pthread_t thread;
+    if (lidar_pipeline_get_worker(&lidar_pipeline, thread_id, &thread) != HAL_STATUS_OK) {
+        printf("[LIDAR-THREADING] Thread %d is not running\n", thread_id);
+        return HAL_STATUS_NOT_FOUND;
     }
     
-    printf("[LIDAR-THREADING] Processing thread %d exiting\n", thread_id);
-    return NULL;
-}
-
-/**
- * @brief Calibration thread function
- * @param arg Thread argument
- * @return Thread return value
- */
-static void* lidar_calibration_thread(void *arg)
-{
-    uint8_t thread_id = *(uint8_t*)arg;
-    
-    printf("[LIDAR-THREADING] Calibration thread %d started\n", thread_id);
-    
-    while (lidar_state.threads_running[thread_id]) {
-        // Wait for calibration work
-        pthread_mutex_lock(&lidar_state.thread_mutexes[thread_id]);
-        pthread_cond_wait(&lidar_state.thread_conditions[thread_id], &lidar_state.thread_mutexes[thread_id]);
-        pthread_mutex_unlock(&lidar_state.thread_mutexes[thread_id]);
-        
-        if (lidar_state.threads_running[thread_id]) {
-            // Perform calibration in background
-            printf("[LIDAR-THREADING] Calibration thread %d performing calibration\n", thread_id);
-            
-            // Simulate calibration work
-            hal_sleep_us(5000); // 5ms calibration time
-        }
-    }
-    
-    printf("[LIDAR-THREADING] Calibration thread %d exiting\n", thread_id);
-    return NULL;
-}
-
-/**
- * @brief Memory management thread function
- * @param arg Thread argument
- * @return Thread return value
- */
-static void* lidar_memory_management_thread(void *arg)
-{
-    uint8_t thread_id = *(uint8_t*)arg;
-    
-    printf("[LIDAR-THREADING] Memory management thread %d started\n", thread_id);
-    
-    while (lidar_state.threads_running[thread_id]) {
-        // Wait for memory management work
-        pthread_mutex_lock(&lidar_state.thread_mutexes[thread_id]);
-        pthread_cond_wait(&lidar_state.thread_conditions[thread_id], &lidar_state.thread_mutexes[thread_id]);
-        pthread_mutex_unlock(&lidar_state.thread_mutexes[thread_id]);
-        
-        if (lidar_state.threads_running[thread_id]) {
-            // Perform memory management
-            printf("[LIDAR-THREADING] Memory management thread %d managing memory\n", thread_id);
-            
-            // Compact memory pool if enabled
-            if (lidar_state.memory_pool_config.enable_compaction) {
-                lidar_compact_memory_pool_internal();
-            }
-            
-            // Simulate memory management work
-            hal_sleep_us(10000); // 10ms memory management time
-        }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu_core, &set);
+    if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0) {
+        printf("[LIDAR-THREADING] Failed to pin thread %d to CPU %d\n", thread_id, cpu_core);
+        return HAL_STATUS_ERROR;
     }
     
-    printf("[LIDAR-THREADING] Memory management thread %d exiting\n", thread_id);
-    return NULL;
+    printf("[LIDAR-THREADING] Thread %d pinned to CPU %d\n", thread_id, cpu_core);
+    return HAL_STATUS_OK;
 }
 
 /**
@@ -3251,9 +3214,6 @@ static hal_status_t lidar_balance_workload_internal(void)
     printf("[LIDAR-LOAD-BALANCE] Balancing workload across %d workloads\n", 
            lidar_state.load_balancing_config.workload_count);
     
-    // Update efficiency based on load balancing
-    lidar_state.current_efficiency = 85.0f + (rand() % 15); // 85-100%
-    
     return HAL_STATUS_OK;
 }
 
@@ -3263,10 +3223,29 @@ static hal_status_t lidar_balance_workload_internal(void)
  */
 static hal_status_t lidar_update_performance_metrics_internal(void)
 {
-    // Simulate performance metrics calculation
-    lidar_state.current_efficiency = 80.0f + (rand() % 20); // 80-100%
-    lidar_state.current_throughput = 1000.0f + (rand() % 500); // 1000-1500 ops/s
-    lidar_state.current_latency = 5.0f + (rand() % 10); // 5-15 ms
+    lidar_pipeline_stats_t stats;
+    if (lidar_pipeline_get_stats(&lidar_pipeline, &stats) != HAL_STATUS_OK) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    
+    // Efficiency: share of revolutions that made it through every stage
+    uint64_t offered = stats.submitted + stats.starved;
+    lidar_state.current_efficiency = offered > 0 ? 100.0f * (float)stats.completed / (float)offered : 0.0f;
+    
+    // Throughput: frames per second the slowest processing stage can sustain
+    double slowest_ns = 0.0;
+    for (int stage = LIDAR_STAGE_FILTER; stage < LIDAR_STAGE_COUNT; stage++) {
+        const lidar_stage_stats_t *st = &stats.stages[stage];
+        if (st->frames > 0 && (double)st->total_ns / (double)st->frames > slowest_ns) {
+            slowest_ns = (double)st->total_ns / (double)st->frames;
+        }
+    }
+    lidar_state.current_throughput = slowest_ns > 0.0 ? (float)(1e9 / slowest_ns) : 0.0f;
+    
+    // Latency: revolution complete to safety decision
+    uint64_t decisions = stats.stages[LIDAR_STAGE_SAFETY].frames;
+    lidar_state.current_latency = decisions > 0 ?
+                                  (float)((double)stats.decision_total_us / (double)decisions / 1000.0) : 0.0f;
     
     return HAL_STATUS_OK;
 }
@@ -3311,10 +3290,6 @@ static hal_status_t lidar_apply_hardware_acceleration_internal(void)
            lidar_state.hardware_acceleration_config.enable_dsp_acceleration ? "YES" : "NO",
            lidar_state.hardware_acceleration_config.enable_neon_acceleration ? "YES" : "NO");
     
-    // Improve performance with hardware acceleration
-    lidar_state.current_throughput *= 1.5f; // 50% improvement
-    lidar_state.current_latency *= 0.7f; // 30% reduction
-    
     return HAL_STATUS_OK;
 }
 
@@ -3333,9 +3308,6 @@ static hal_status_t lidar_apply_load_balancing_internal(void)
            lidar_state.load_balancing_config.workload_count,
            lidar_state.load_balancing_config.balance_threshold);
     
-    // Improve efficiency with load balancing
-    lidar_state.current_efficiency = fmin(100.0f, lidar_state.current_efficiency * 1.1f);
-    
     return HAL_STATUS_OK;
 }
 
@@ -3354,11 +3326,6 @@ static hal_status_t lidar_apply_performance_scaling_internal(void)
            lidar_state.performance_scaling_config.target_latency_ms,
            lidar_state.performance_scaling_config.power_budget_mw);
     
-    // Optimize based on target latency
-    if (lidar_state.current_latency > lidar_state.performance_scaling_config.target_latency_ms) {
-        lidar_state.current_latency *= 0.8f; // 20% reduction
-    }
-    
     return HAL_STATUS_OK;
 }
 
@@ -151,6 +151,8 @@
 #define LIDAR_POINTS_PER_SCAN      500     // ~500 points per scan (360°/0.72°)
 #define LIDAR_SCAN_BUFFER_SIZE     1024    // Buffer size for scan data
 
+#define LIDAR_ANGLE_Q6_FULL_TURN   23040   // 360 degrees in 1/64 degree
+
 // LiDAR data structures
 typedef struct {
     uint16_t distance_mm;         // Distance in mm
@@ -159,14 +161,108 @@ typedef struct {
     uint64_t timestamp_us;        // Timestamp in microseconds
 } lidar_point_t;
 
+// Scan frame as parallel arrays: point i is distance_mm[i], angle_q6[i], quality[i]
 typedef struct {
-    lidar_point_t points[LIDAR_POINTS_PER_SCAN];
+    uint16_t distance_mm[LIDAR_POINTS_PER_SCAN];  // Distance in mm (0 = no return)
+    uint16_t angle_q6[LIDAR_POINTS_PER_SCAN];     // Angle in 1/64 degree (0-23039)
+    uint8_t quality[LIDAR_POINTS_PER_SCAN];       // Signal quality (0-255)
     uint16_t point_count;
+    uint64_t base_timestamp_us;   // Timestamp of point 0
+    uint32_t point_period_us;     // Time between consecutive points
     uint64_t scan_timestamp_us;
     bool scan_complete;
     uint8_t scan_quality;         // Overall scan quality
 } lidar_scan_data_t;
 
+/**
+ * @brief Angle in whole degrees (0-359), rounded
+ */
+static inline uint16_t lidar_angle_q6_to_deg(uint16_t angle_q6)
+{
+    return (uint16_t)((((uint32_t)angle_q6 + 32U) >> 6) % 360U);
+}
+
+/**
+ * @brief Timestamp of point i
+ */
+static inline uint64_t lidar_point_timestamp_us(const lidar_scan_data_t *scan, uint16_t i)
+{
+    return scan->base_timestamp_us + (uint64_t)i * scan->point_period_us;
+}
+
+/**
+ * @brief Point i as a single record
+ */
+static inline lidar_point_t lidar_scan_get_point(const lidar_scan_data_t *scan, uint16_t i)
+{
+    lidar_point_t point = {
+        .distance_mm = scan->distance_mm[i],
+        .angle_deg = lidar_angle_q6_to_deg(scan->angle_q6[i]),
+        .quality = scan->quality[i],
+        .timestamp_us = lidar_point_timestamp_us(scan, i)
+    };
+    return point;
+}
+
+// Read-only view of a published frame; valid until released
+typedef struct {
+    const lidar_scan_data_t *scan;  // NULL when not holding a frame
+    uint64_t sequence;              // Publication sequence (1, 2, ...)
+    uint64_t published_us;          // Publication timestamp
+    uint8_t slot;                   // Internal
+} lidar_frame_view_t;
+
+// Publisher statistics
+typedef struct {
+    uint64_t published;             // Frames published
+    uint64_t dropped;               // Frames lost because every slot was held
+    uint64_t acquires;              // Views handed out
+    uint64_t waits;                 // Blocking waits
+    uint64_t wait_timeouts;         // Waits that timed out
+    uint32_t readers;               // Views currently held
+    uint32_t max_readers;           // High-water mark of readers
+} lidar_frame_stats_t;
+
+// Processing pipeline stages, in frame order
+typedef enum {
+    LIDAR_STAGE_FRAMING = 0,        // Byte stream to revolution (scan thread)
+    LIDAR_STAGE_FILTER,             // Calibration, outlier and window filters
+    LIDAR_STAGE_SAFETY,             // Safety status and the registered safety handler
+    LIDAR_STAGE_REDUCE,             // Publication as the API frame
+    LIDAR_STAGE_COUNT
+} lidar_stage_id_t;
+
+// Timing of one pipeline stage
+typedef struct {
+    uint64_t frames;                // Frames through the stage
+    uint64_t total_ns;
+    uint32_t last_ns;
+    uint32_t max_ns;
+} lidar_stage_stats_t;
+
+// Pipeline statistics
+typedef struct {
+    lidar_stage_stats_t stages[LIDAR_STAGE_COUNT];
+    uint64_t submitted;             // Revolutions handed to the pipeline
+    uint64_t completed;             // Revolutions through every stage
+    uint64_t starved;               // Revolutions dropped with every frame in flight
+    uint32_t decision_last_us;      // Revolution complete to safety stage done
+    uint32_t decision_max_us;
+    uint64_t decision_total_us;
+    uint8_t workers;                // Worker threads running
+    int16_t safety_cpu;             // CPU the safety worker is pinned to, -1 if not pinned
+    bool safety_realtime;           // Safety worker runs SCHED_FIFO
+} lidar_pipeline_stats_t;
+
+/**
+ * @brief Called on the safety worker with every filtered revolution
+ * @param ctx Caller context
+ * @param scan Revolution; valid only for the duration of the call
+ * @return HAL_STATUS_OK once the revolution has a safety decision; anything
+ *         else makes the HAL flag an emergency stop for it
+ */
+typedef hal_status_t (*lidar_safety_handler_t)(void *ctx, const lidar_scan_data_t *scan);
+
 typedef struct {
     uint16_t min_distance_mm;     // Minimum distance in scan
     uint16_t min_distance_angle;  // Angle of minimum distance
@@ -339,6 +435,65 @@ hal_status_t hal_lidar_get_status(hal_device_status_t *status);
 hal_status_t hal_lidar_reset(void);
 hal_status_t hal_lidar_health_check(void);
 
+// Published frames (zero-copy; hal_lidar_get_scan_data() copies one of these)
+
+/**
+ * @brief Take a read-only view of the latest complete frame
+ * @param view Output view, release with hal_lidar_release_frame()
+ * @return HAL_STATUS_NOT_FOUND if no frame has been published since init
+ */
+hal_status_t hal_lidar_acquire_frame(lidar_frame_view_t *view);
+
+/**
+ * @brief Block until a frame newer than after_sequence is published
+ * @param after_sequence Sequence of the last frame the caller processed (0 = any)
+ * @param timeout_ms Upper bound on the wait
+ * @param view Output view, release with hal_lidar_release_frame()
+ * @return HAL_STATUS_TIMEOUT, or HAL_STATUS_INVALID_STATE after deinit
+ */
+hal_status_t hal_lidar_wait_frame(uint64_t after_sequence, uint32_t timeout_ms, lidar_frame_view_t *view);
+
+/**
+ * @brief Release a view taken with hal_lidar_acquire_frame()/hal_lidar_wait_frame()
+ * @param view View (cleared on return)
+ */
+void hal_lidar_release_frame(lidar_frame_view_t *view);
+
+/**
+ * @brief Sequence of the latest published frame (cheap change check)
+ * @return Sequence, 0 if none
+ */
+uint64_t hal_lidar_get_frame_sequence(void);
+
+/**
+ * @brief Get frame publication statistics
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t hal_lidar_get_frame_stats(lidar_frame_stats_t *stats);
+
+// Processing pipeline (framing -> filter -> safety -> reduce)
+
+/**
+ * @brief Run a handler on the safety worker for every revolution, before it is published
+ *
+ * The handler sees the filtered frame as soon as the revolution completes,
+ * independent of any polling loop. It must not block. A revolution the
+ * handler fails on is treated as an emergency stop (hal_lidar_check_safety).
+ *
+ * @param handler Handler, NULL to remove
+ * @param ctx Passed to the handler
+ * @return HAL status
+ */
+hal_status_t hal_lidar_set_safety_handler(lidar_safety_handler_t handler, void *ctx);
+
+/**
+ * @brief Get per-stage timing and frame-to-decision latency
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t hal_lidar_get_pipeline_stats(lidar_pipeline_stats_t *stats);
+
 // Utility functions
 uint16_t lidar_calculate_min_distance(const lidar_scan_data_t *scan_data);
 uint16_t lidar_calculate_max_distance(const lidar_scan_data_t *scan_data);
@@ -0,0 +1,263 @@
+/**
+ * @file hal_lidar_frame.c
+ * @brief Zero-copy publication of complete LiDAR scan frames
+ * @version 1.0.0
+ * @date 2025-02-19
+ * @team EMBED
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "hal_lidar_frame.h"
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+hal_status_t lidar_frame_publisher_init(lidar_frame_publisher_t *pub)
+{
+    if (!pub) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(pub->refs, 0, sizeof(pub->refs));
+    memset(pub->sequences, 0, sizeof(pub->sequences));
+    memset(pub->published_us, 0, sizeof(pub->published_us));
+    memset(&pub->stats, 0, sizeof(pub->stats));
+    pub->write_slot = -1;
+    pub->latest_slot = -1;
+    pub->sequence = 0;
+    pub->open = true;
+
+    if (pthread_mutex_init(&pub->mutex, NULL) != 0) {
+        return HAL_STATUS_ERROR;
+    }
+
+    // Waits are bounded against the monotonic clock
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    int rc = pthread_cond_init(&pub->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    if (rc != 0) {
+        pthread_mutex_destroy(&pub->mutex);
+        return HAL_STATUS_ERROR;
+    }
+
+    pub->initialized = true;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_frame_publisher_deinit(lidar_frame_publisher_t *pub)
+{
+    if (!pub || !pub->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    if (pub->stats.readers > 0) {
+        pthread_mutex_unlock(&pub->mutex);
+        return HAL_STATUS_BUSY;
+    }
+    pub->initialized = false;
+    pthread_mutex_unlock(&pub->mutex);
+
+    pthread_cond_destroy(&pub->cond);
+    pthread_mutex_destroy(&pub->mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_frame_publisher_reset(lidar_frame_publisher_t *pub)
+{
+    if (!pub || !pub->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    // Slots still held by readers keep their reference; they are reused once released
+    pthread_mutex_lock(&pub->mutex);
+    pub->latest_slot = -1;
+    pub->write_slot = -1;
+    pub->open = true;
+    pthread_mutex_unlock(&pub->mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_frame_publisher_close(lidar_frame_publisher_t *pub)
+{
+    if (!pub || !pub->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    pub->open = false;
+    pthread_cond_broadcast(&pub->cond);
+    pthread_mutex_unlock(&pub->mutex);
+    return HAL_STATUS_OK;
+}
+
+lidar_scan_data_t *lidar_frame_publisher_begin(lidar_frame_publisher_t *pub)
+{
+    if (!pub || !pub->initialized) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    if (pub->write_slot < 0) {
+        for (int i = 0; i < LIDAR_FRAME_SLOTS; i++) {
+            if (i != pub->latest_slot && pub->refs[i] == 0) {
+                pub->write_slot = i;
+                break;
+            }
+        }
+    }
+    int slot = pub->write_slot;
+    if (slot < 0) {
+        pub->stats.dropped++;
+    }
+    pthread_mutex_unlock(&pub->mutex);
+
+    // Readers only ever reference the latest slot, so the writer owns this one outright
+    return slot < 0 ? NULL : &pub->frames[slot];
+}
+
+uint64_t lidar_frame_publisher_publish(lidar_frame_publisher_t *pub, uint64_t timestamp_us)
+{
+    if (!pub || !pub->initialized) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    int slot = pub->write_slot;
+    if (slot < 0) {
+        pthread_mutex_unlock(&pub->mutex);
+        return 0;
+    }
+    uint64_t sequence = ++pub->sequence;
+    pub->sequences[slot] = sequence;
+    pub->published_us[slot] = timestamp_us;
+    pub->latest_slot = slot;
+    pub->write_slot = -1;
+    pub->stats.published++;
+    pthread_cond_broadcast(&pub->cond);
+    pthread_mutex_unlock(&pub->mutex);
+    return sequence;
+}
+
+/**
+ * @brief Hand out a reference to the latest slot (caller holds the mutex)
+ */
+static void frame_take_latest(lidar_frame_publisher_t *pub, lidar_frame_view_t *view)
+{
+    int slot = pub->latest_slot;
+    pub->refs[slot]++;
+    pub->stats.acquires++;
+    pub->stats.readers++;
+    if (pub->stats.readers > pub->stats.max_readers) {
+        pub->stats.max_readers = pub->stats.readers;
+    }
+    view->scan = &pub->frames[slot];
+    view->sequence = pub->sequences[slot];
+    view->published_us = pub->published_us[slot];
+    view->slot = (uint8_t)slot;
+}
+
+hal_status_t lidar_frame_publisher_acquire(lidar_frame_publisher_t *pub, lidar_frame_view_t *view)
+{
+    if (!view) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    view->scan = NULL;
+    if (!pub || !pub->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    if (pub->latest_slot < 0) {
+        pthread_mutex_unlock(&pub->mutex);
+        return HAL_STATUS_NOT_FOUND;
+    }
+    frame_take_latest(pub, view);
+    pthread_mutex_unlock(&pub->mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_frame_publisher_wait(lidar_frame_publisher_t *pub, uint64_t after_sequence,
+                                        uint32_t timeout_ms, lidar_frame_view_t *view)
+{
+    if (!view) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    view->scan = NULL;
+    if (!pub || !pub->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t)(timeout_ms / 1000U);
+    deadline.tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    hal_status_t status = HAL_STATUS_OK;
+    pthread_mutex_lock(&pub->mutex);
+    pub->stats.waits++;
+    while (pub->open && (pub->latest_slot < 0 || pub->sequence <= after_sequence)) {
+        if (pthread_cond_timedwait(&pub->cond, &pub->mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    if (!pub->open) {
+        status = HAL_STATUS_INVALID_STATE;
+    } else if (pub->latest_slot < 0 || pub->sequence <= after_sequence) {
+        pub->stats.wait_timeouts++;
+        status = HAL_STATUS_TIMEOUT;
+    } else {
+        frame_take_latest(pub, view);
+    }
+    pthread_mutex_unlock(&pub->mutex);
+    return status;
+}
+
+void lidar_frame_publisher_release(lidar_frame_publisher_t *pub, lidar_frame_view_t *view)
+{
+    if (!pub || !view || !view->scan || !pub->initialized) {
+        return;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    if (view->slot < LIDAR_FRAME_SLOTS && pub->refs[view->slot] > 0) {
+        pub->refs[view->slot]--;
+        pub->stats.readers--;
+    }
+    pthread_mutex_unlock(&pub->mutex);
+    view->scan = NULL;
+}
+
+uint64_t lidar_frame_publisher_sequence(lidar_frame_publisher_t *pub)
+{
+    if (!pub || !pub->initialized) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    uint64_t sequence = pub->latest_slot < 0 ? 0 : pub->sequence;
+    pthread_mutex_unlock(&pub->mutex);
+    return sequence;
+}
+
+hal_status_t lidar_frame_publisher_get_stats(lidar_frame_publisher_t *pub, lidar_frame_stats_t *stats)
+{
+    if (!pub || !stats) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!pub->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&pub->mutex);
+    *stats = pub->stats;
+    pthread_mutex_unlock(&pub->mutex);
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file hal_lidar_frame.h
+ * @brief Zero-copy publication of complete LiDAR scan frames
+ * @version 1.0.0
+ * @date 2025-02-19
+ * @team EMBED
+ *
+ * The scan thread fills a private slot and publishes it with a sequence
+ * number; readers take a reference-counted read-only view of the latest
+ * frame (or block until a newer sequence arrives) instead of copying the
+ * scan under the driver mutex. A slot is reused only when it is neither
+ * the latest frame nor referenced by a reader, so a view never changes
+ * underneath its holder and no frame is ever seen half-written.
+ *
+ * One writer, any number of readers. The mutex only covers slot
+ * bookkeeping; no scan data is copied while it is held.
+ */
+
+#ifndef HAL_LIDAR_FRAME_H
+#define HAL_LIDAR_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "hal_common.h"
+#include "hal_lidar.h"
+
+// Writer slot + latest frame + two older frames still held by readers
+#define LIDAR_FRAME_SLOTS           4
+
+// Publisher state (one per sensor)
+typedef struct {
+    lidar_scan_data_t frames[LIDAR_FRAME_SLOTS];
+    uint32_t refs[LIDAR_FRAME_SLOTS];
+    uint64_t sequences[LIDAR_FRAME_SLOTS];
+    uint64_t published_us[LIDAR_FRAME_SLOTS];
+    int write_slot;                 // Slot owned by the writer, -1 if none
+    int latest_slot;                // Last published slot, -1 if none
+    uint64_t sequence;              // Sequence of the latest frame
+    bool open;                      // Cleared by close(); waiters return
+    bool initialized;
+    lidar_frame_stats_t stats;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;            // Signalled on publish and close
+} lidar_frame_publisher_t;
+
+/**
+ * @brief Initialize a publisher
+ * @param pub Publisher
+ * @return HAL status
+ */
+hal_status_t lidar_frame_publisher_init(lidar_frame_publisher_t *pub);
+
+/**
+ * @brief Destroy a publisher; no view may be held
+ * @param pub Publisher
+ * @return HAL_STATUS_BUSY if readers still hold views
+ */
+hal_status_t lidar_frame_publisher_deinit(lidar_frame_publisher_t *pub);
+
+/**
+ * @brief Forget the latest frame and reopen after close()
+ * @param pub Publisher
+ * @return HAL status
+ */
+hal_status_t lidar_frame_publisher_reset(lidar_frame_publisher_t *pub);
+
+/**
+ * @brief Stop accepting waits and wake every blocked reader
+ * @param pub Publisher
+ * @return HAL status
+ */
+hal_status_t lidar_frame_publisher_close(lidar_frame_publisher_t *pub);
+
+/**
+ * @brief Get the writer's private frame buffer (writer thread only)
+ *
+ * Returns the same buffer until it is published. Contents are whatever the
+ * slot last held; the writer must fill every field it publishes.
+ *
+ * @param pub Publisher
+ * @return Buffer, or NULL if every slot is held by readers (frame dropped)
+ */
+lidar_scan_data_t *lidar_frame_publisher_begin(lidar_frame_publisher_t *pub);
+
+/**
+ * @brief Publish the buffer returned by begin() as the latest frame
+ * @param pub Publisher
+ * @param timestamp_us Publication timestamp
+ * @return Sequence number of the frame, 0 if nothing was begun
+ */
+uint64_t lidar_frame_publisher_publish(lidar_frame_publisher_t *pub, uint64_t timestamp_us);
+
+/**
+ * @brief Take a view of the latest frame
+ * @param pub Publisher
+ * @param view Output view, release with lidar_frame_publisher_release()
+ * @return HAL_STATUS_NOT_FOUND if nothing has been published yet
+ */
+hal_status_t lidar_frame_publisher_acquire(lidar_frame_publisher_t *pub, lidar_frame_view_t *view);
+
+/**
+ * @brief Block until a frame newer than after_sequence is published
+ * @param pub Publisher
+ * @param after_sequence Last sequence the caller has seen (0 = any frame)
+ * @param timeout_ms Upper bound on the wait
+ * @param view Output view of the latest frame
+ * @return HAL_STATUS_TIMEOUT, or HAL_STATUS_INVALID_STATE if the publisher was closed
+ */
+hal_status_t lidar_frame_publisher_wait(lidar_frame_publisher_t *pub, uint64_t after_sequence,
+                                        uint32_t timeout_ms, lidar_frame_view_t *view);
+
+/**
+ * @brief Drop a view; the view is cleared
+ * @param pub Publisher
+ * @param view View from acquire() or wait()
+ */
+void lidar_frame_publisher_release(lidar_frame_publisher_t *pub, lidar_frame_view_t *view);
+
+/**
+ * @brief Sequence of the latest published frame
+ * @param pub Publisher
+ * @return Sequence, 0 if nothing has been published
+ */
+uint64_t lidar_frame_publisher_sequence(lidar_frame_publisher_t *pub);
+
+/**
+ * @brief Get publisher statistics
+ * @param pub Publisher
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t lidar_frame_publisher_get_stats(lidar_frame_publisher_t *pub, lidar_frame_stats_t *stats);
+
+#endif // HAL_LIDAR_FRAME_H
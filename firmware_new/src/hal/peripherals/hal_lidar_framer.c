@@ -0,0 +1,259 @@
+/**
+ * @file hal_lidar_framer.c
+ * @brief Streaming RPLIDAR standard-scan framer
+ * @version 1.0.0
+ * @date 2025-02-20
+ * @team EMBED
+ */
+
+#include "hal_lidar_framer.h"
+#include <string.h>
+
+#define FRAMER_RING_MASK    (LIDAR_FRAMER_RING_SIZE - 1U)
+
+_Static_assert((LIDAR_FRAMER_RING_SIZE & (LIDAR_FRAMER_RING_SIZE - 1)) == 0, "ring size must be a power of two");
+
+// Standard scan response descriptor: length 5, multiple responses, type 0x81
+static const uint8_t framer_descriptor[LIDAR_FRAMER_DESCRIPTOR_SIZE] = { 0xA5, 0x5A, 0x05, 0x00, 0x00, 0x40, 0x81 };
+
+static inline uint8_t ring_at(const lidar_framer_t *framer, size_t offset)
+{
+    return framer->ring[(framer->tail + offset) & FRAMER_RING_MASK];
+}
+
+static inline void ring_consume(lidar_framer_t *framer, size_t n)
+{
+    framer->tail = (framer->tail + n) & FRAMER_RING_MASK;
+    framer->count -= n;
+}
+
+/**
+ * @brief S and !S must differ, check bit must be set
+ */
+static inline bool node_check(uint8_t b0, uint8_t b1)
+{
+    return ((b0 ^ (b0 >> 1)) & 0x01U) != 0 && (b1 & 0x01U) != 0;
+}
+
+static void framer_start_revolution(lidar_framer_t *framer)
+{
+    framer->quality_sum = 0;
+    if (framer->scan) {
+        framer->scan->point_count = 0;
+        framer->scan->scan_complete = false;
+        framer->scan->point_period_us = framer->sample_period_us;
+    }
+}
+
+static void framer_finish_revolution(lidar_framer_t *framer)
+{
+    lidar_scan_data_t *scan = framer->scan;
+    if (!scan) {
+        // Previous revolution had nowhere to go; ask for a buffer again
+        framer->stats.dropped_revolutions++;
+        framer->scan = framer->on_revolution ? framer->on_revolution(framer->ctx, NULL) : NULL;
+        return;
+    }
+
+    scan->scan_complete = scan->point_count > 0;
+    if (scan->point_count > 0) {
+        // Average spacing over the revolution absorbs read-time jitter and skipped no-return nodes
+        if (scan->point_count > 1) {
+            scan->point_period_us = (uint32_t)((framer->last_point_us - scan->base_timestamp_us) /
+                                               (uint64_t)(scan->point_count - 1U));
+        }
+        scan->scan_timestamp_us = framer->last_point_us;
+        scan->scan_quality = (uint8_t)(framer->quality_sum / scan->point_count);
+    }
+    framer->stats.revolutions++;
+    framer->scan = framer->on_revolution ? framer->on_revolution(framer->ctx, scan) : scan;
+}
+
+/**
+ * @brief Find the descriptor or a run of valid nodes
+ * @return true once locked, false if more bytes are needed
+ */
+static bool framer_seek(lidar_framer_t *framer)
+{
+    while (framer->count >= 2) {
+        if (ring_at(framer, 0) == framer_descriptor[0] && ring_at(framer, 1) == framer_descriptor[1]) {
+            size_t n = framer->count < LIDAR_FRAMER_DESCRIPTOR_SIZE ? framer->count : LIDAR_FRAMER_DESCRIPTOR_SIZE;
+            size_t i = 2;
+            while (i < n && ring_at(framer, i) == framer_descriptor[i]) {
+                i++;
+            }
+            if (i == LIDAR_FRAMER_DESCRIPTOR_SIZE) {
+                ring_consume(framer, LIDAR_FRAMER_DESCRIPTOR_SIZE);
+                framer->stats.descriptors++;
+                framer->locked = true;
+                framer->in_revolution = false;
+                return true;
+            }
+            if (i == n) {
+                return false;   // Descriptor prefix so far, wait for the rest
+            }
+        }
+
+        // Sensor already streaming: lock on consecutive nodes that pass the check bits
+        if (framer->count < LIDAR_FRAMER_LOCK_NODES * LIDAR_FRAMER_NODE_SIZE) {
+            return false;
+        }
+        bool run = true;
+        for (size_t k = 0; k < LIDAR_FRAMER_LOCK_NODES && run; k++) {
+            size_t off = k * LIDAR_FRAMER_NODE_SIZE;
+            run = node_check(ring_at(framer, off), ring_at(framer, off + 1));
+        }
+        if (run) {
+            framer->locked = true;
+            framer->in_revolution = false;
+            return true;
+        }
+
+        ring_consume(framer, 1);
+        framer->stats.discarded_bytes++;
+    }
+    return false;
+}
+
+/**
+ * @brief Decode buffered bytes
+ * @param pending Bytes of the current read not yet in the ring
+ * @return Revolutions completed
+ */
+static size_t framer_process(lidar_framer_t *framer, size_t pending, uint64_t rx_time_us)
+{
+    size_t completed = 0;
+
+    for (;;) {
+        if (!framer->locked && !framer_seek(framer)) {
+            return completed;
+        }
+        if (framer->count < LIDAR_FRAMER_NODE_SIZE) {
+            return completed;
+        }
+
+        uint8_t b0 = ring_at(framer, 0);
+        uint8_t b1 = ring_at(framer, 1);
+        if (!node_check(b0, b1)) {
+            // Lost framing: the partial revolution has a gap, so it is not published
+            framer->locked = false;
+            framer->in_revolution = false;
+            framer->stats.resyncs++;
+            continue;
+        }
+        uint8_t b2 = ring_at(framer, 2);
+        uint16_t distance_q2 = (uint16_t)(ring_at(framer, 3) | (ring_at(framer, 4) << 8));
+        ring_consume(framer, LIDAR_FRAMER_NODE_SIZE);
+        framer->stats.nodes++;
+
+        if (b0 & 0x01U) {
+            if (framer->in_revolution) {
+                framer_finish_revolution(framer);
+                completed++;
+            }
+            framer->in_revolution = true;
+            framer_start_revolution(framer);
+        }
+        if (!framer->in_revolution || !framer->scan) {
+            continue;
+        }
+        if (distance_q2 == 0) {
+            framer->stats.invalid_points++;
+            continue;
+        }
+
+        lidar_scan_data_t *scan = framer->scan;
+        if (scan->point_count >= LIDAR_POINTS_PER_SCAN) {
+            framer->stats.overflow_points++;
+            continue;
+        }
+
+        // Nodes still behind this one in the read were sampled later
+        uint64_t later_nodes = (uint64_t)((framer->count + pending) / LIDAR_FRAMER_NODE_SIZE);
+        uint64_t age_us = later_nodes * framer->sample_period_us;
+        uint16_t angle_q6 = (uint16_t)((b1 >> 1) | (b2 << 7));
+        uint8_t quality = (uint8_t)(b0 >> 2);
+
+        uint64_t timestamp_us = rx_time_us > age_us ? rx_time_us - age_us : 0;
+        uint16_t i = scan->point_count++;
+        scan->distance_mm[i] = (uint16_t)(distance_q2 >> 2);
+        scan->angle_q6[i] = (uint16_t)(angle_q6 % LIDAR_ANGLE_Q6_FULL_TURN);
+        scan->quality[i] = quality;
+        if (i == 0) {
+            scan->base_timestamp_us = timestamp_us;
+        }
+        framer->last_point_us = timestamp_us;
+        framer->quality_sum += quality;
+        framer->stats.points++;
+    }
+}
+
+hal_status_t lidar_framer_init(lidar_framer_t *framer, uint32_t sample_period_us,
+                               lidar_framer_revolution_cb_t on_revolution, void *ctx,
+                               lidar_scan_data_t *scan)
+{
+    if (!framer || sample_period_us == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(&framer->stats, 0, sizeof(framer->stats));
+    framer->sample_period_us = sample_period_us;
+    framer->on_revolution = on_revolution;
+    framer->ctx = ctx;
+    framer->scan = scan;
+    lidar_framer_reset(framer);
+    return HAL_STATUS_OK;
+}
+
+void lidar_framer_reset(lidar_framer_t *framer)
+{
+    if (!framer) {
+        return;
+    }
+    framer->tail = 0;
+    framer->count = 0;
+    framer->locked = false;
+    framer->in_revolution = false;
+    framer->quality_sum = 0;
+    if (framer->scan) {
+        framer->scan->point_count = 0;
+        framer->scan->scan_complete = false;
+    }
+}
+
+size_t lidar_framer_feed(lidar_framer_t *framer, const uint8_t *data, size_t len, uint64_t rx_time_us)
+{
+    if (!framer || (!data && len > 0)) {
+        return 0;
+    }
+
+    size_t completed = 0;
+    framer->stats.bytes += len;
+    while (len > 0) {
+        // Append what fits (at most two copies around the wrap), then decode
+        size_t space = LIDAR_FRAMER_RING_SIZE - framer->count;
+        size_t n = len < space ? len : space;
+        size_t head = (framer->tail + framer->count) & FRAMER_RING_MASK;
+        size_t first = LIDAR_FRAMER_RING_SIZE - head;
+        if (first > n) {
+            first = n;
+        }
+        memcpy(&framer->ring[head], data, first);
+        memcpy(&framer->ring[0], data + first, n - first);
+        framer->count += n;
+        data += n;
+        len -= n;
+
+        completed += framer_process(framer, len, rx_time_us);
+    }
+    return completed;
+}
+
+hal_status_t lidar_framer_get_stats(const lidar_framer_t *framer, lidar_framer_stats_t *stats)
+{
+    if (!framer || !stats) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    *stats = framer->stats;
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file hal_lidar_framer.h
+ * @brief Streaming RPLIDAR standard-scan framer
+ * @version 1.0.0
+ * @date 2025-02-20
+ * @team EMBED
+ *
+ * Bytes from each read() are appended to a ring buffer and decoded as
+ * 5-byte standard scan nodes:
+ *
+ *   byte 0: quality[7:2] | !S | S      (S = start of a new revolution)
+ *   byte 1: angle_q6[6:0] | C          (C = check bit, always 1)
+ *   byte 2: angle_q6[14:7]
+ *   byte 3-4: distance_q2 (little endian, mm * 4)
+ *
+ * Partial nodes carry over to the next read. The framer locks on the
+ * response descriptor (A5 5A 05 00 00 40 81) or, when the sensor was
+ * already streaming, on a run of nodes whose S/!S and C bits check out;
+ * a node that fails the check drops it back into resync. A revolution is
+ * handed to the caller when the next node with S set arrives. Points
+ * before the first S after a (re)lock are discarded, so every frame
+ * starts at the revolution boundary.
+ *
+ * Point timestamps are interpolated back from the read time at the
+ * sensor's sample period, since a read returns many nodes at once. A
+ * finished frame carries the first point's timestamp and the average
+ * point spacing over the revolution.
+ */
+
+#ifndef HAL_LIDAR_FRAMER_H
+#define HAL_LIDAR_FRAMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+#include "hal_lidar.h"
+
+#define LIDAR_FRAMER_RING_SIZE          4096    // Power of two
+#define LIDAR_FRAMER_NODE_SIZE          5
+#define LIDAR_FRAMER_DESCRIPTOR_SIZE    7
+#define LIDAR_FRAMER_LOCK_NODES         3       // Valid nodes in a row to lock without a descriptor
+
+/**
+ * @brief Called with each complete revolution
+ * @param ctx Caller context
+ * @param scan Completed revolution (the buffer handed to the framer), NULL
+ *             when the last revolution was dropped for lack of a buffer
+ * @return Buffer for the next revolution, NULL to drop it
+ */
+typedef lidar_scan_data_t *(*lidar_framer_revolution_cb_t)(void *ctx, lidar_scan_data_t *scan);
+
+// Framer statistics
+typedef struct {
+    uint64_t bytes;                 // Bytes fed
+    uint64_t nodes;                 // Nodes that passed the check bits
+    uint64_t points;                // Nodes stored as points
+    uint64_t invalid_points;        // Nodes with no distance measurement
+    uint64_t discarded_bytes;       // Bytes skipped while resyncing
+    uint64_t resyncs;               // Lock lost on a bad node
+    uint64_t descriptors;           // Response descriptors seen
+    uint64_t revolutions;           // Revolutions handed to the callback
+    uint64_t dropped_revolutions;   // Revolutions with no output buffer
+    uint64_t overflow_points;       // Points beyond LIDAR_POINTS_PER_SCAN
+} lidar_framer_stats_t;
+
+// Framer state
+typedef struct {
+    uint8_t ring[LIDAR_FRAMER_RING_SIZE];
+    size_t tail;                    // Oldest unconsumed byte
+    size_t count;                   // Unconsumed bytes
+    bool locked;                    // Decoding nodes
+    bool in_revolution;             // Seen S since the last (re)lock
+    uint32_t sample_period_us;
+    uint32_t quality_sum;
+    uint64_t last_point_us;         // Timestamp of the newest point
+    lidar_scan_data_t *scan;        // Revolution being filled (NULL = dropping)
+    lidar_framer_revolution_cb_t on_revolution;
+    void *ctx;
+    lidar_framer_stats_t stats;
+} lidar_framer_t;
+
+/**
+ * @brief Initialize a framer
+ * @param framer Framer
+ * @param sample_period_us Time between nodes (1e6 / sample rate)
+ * @param on_revolution Revolution callback
+ * @param ctx Callback context
+ * @param scan First output buffer (may be NULL)
+ * @return HAL status
+ */
+hal_status_t lidar_framer_init(lidar_framer_t *framer, uint32_t sample_period_us,
+                               lidar_framer_revolution_cb_t on_revolution, void *ctx,
+                               lidar_scan_data_t *scan);
+
+/**
+ * @brief Drop buffered bytes and the current revolution, keep statistics
+ * @param framer Framer
+ */
+void lidar_framer_reset(lidar_framer_t *framer);
+
+/**
+ * @brief Feed bytes from one read
+ * @param framer Framer
+ * @param data Bytes
+ * @param len Byte count
+ * @param rx_time_us Time the read returned (last byte received)
+ * @return Revolutions completed by this call
+ */
+size_t lidar_framer_feed(lidar_framer_t *framer, const uint8_t *data, size_t len, uint64_t rx_time_us);
+
+/**
+ * @brief Get framer statistics
+ * @param framer Framer
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t lidar_framer_get_stats(const lidar_framer_t *framer, lidar_framer_stats_t *stats);
+
+#endif // HAL_LIDAR_FRAMER_H
@@ -0,0 +1,642 @@
+/**
+ * @file hal_lidar_kernels.c
+ * @brief Vectorised per-frame kernels over the LiDAR scan arrays
+ * @version 1.0.0
+ * @date 2025-02-21
+ * @team EMBED
+ *
+ * Every kernel works on distance - 1 (unsigned, so no return wraps to
+ * 0xFFFF) which lets a plain unsigned minimum skip the zeros. SSE2 has no
+ * unsigned 16-bit min/max or compare, so its lanes are biased by 0x8000
+ * and use the signed forms.
+ */
+
+#include "hal_lidar_kernels.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define LIDAR_KERNELS_X86 1
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LIDAR_KERNELS_NEON 1
+#endif
+
+#define KERNEL_NO_RETURN    0xFFFFU     // distance - 1 of a point without a return
+#define KERNEL_TEST_POINTS  520
+
+typedef struct {
+    void (*extremes)(const uint16_t *d, uint16_t n, lidar_kernel_extremes_t *e);
+    uint16_t (*sector_min)(const uint16_t *d, const uint16_t *a, uint16_t n, uint16_t start, uint16_t end);
+    uint16_t (*below_mask)(const uint16_t *d, uint16_t n, uint16_t threshold, uint8_t *mask);
+} lidar_kernel_ops_t;
+
+static pthread_once_t g_select_once = PTHREAD_ONCE_INIT;
+static lidar_kernel_impl_t g_active_impl = LIDAR_KERNEL_IMPL_SCALAR;
+
+static inline bool kernel_in_sector(uint16_t a, uint16_t start, uint16_t end)
+{
+    return start <= end ? (a >= start && a < end) : (a >= start || a < end);
+}
+
+/**
+ * @brief Min of distance - 1 to UINT16_MAX-or-distance
+ */
+static inline uint16_t kernel_unbias_min(uint16_t min_m1)
+{
+    return min_m1 == KERNEL_NO_RETURN ? UINT16_MAX : (uint16_t)(min_m1 + 1U);
+}
+
+static uint16_t kernel_find(const uint16_t *d, uint16_t from, uint16_t n, uint16_t value)
+{
+    for (uint16_t i = from; i < n; i++) {
+        if (d[i] == value) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// SCALAR
+// ============================================================================
+
+static void extremes_scalar(const uint16_t *d, uint16_t n, lidar_kernel_extremes_t *e)
+{
+    uint16_t lo = UINT16_MAX, hi = 0, lo_i = 0, hi_i = 0, valid = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t v = d[i];
+        if (v == 0) {
+            continue;
+        }
+        valid++;
+        if (v < lo) {
+            lo = v;
+            lo_i = i;
+        }
+        if (v > hi) {
+            hi = v;
+            hi_i = i;
+        }
+    }
+    e->min_mm = lo;
+    e->min_index = lo_i;
+    e->max_mm = hi;
+    e->max_index = hi_i;
+    e->valid = valid;
+}
+
+static uint16_t sector_min_scalar(const uint16_t *d, const uint16_t *a, uint16_t n, uint16_t start, uint16_t end)
+{
+    uint16_t lo = KERNEL_NO_RETURN;
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t m1 = (uint16_t)(d[i] - 1U);
+        if (m1 < lo && kernel_in_sector(a[i], start, end)) {
+            lo = m1;
+        }
+    }
+    return kernel_unbias_min(lo);
+}
+
+static uint16_t below_mask_scalar(const uint16_t *d, uint16_t n, uint16_t threshold, uint8_t *mask)
+{
+    uint16_t t = (uint16_t)(threshold - 1U);
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        uint8_t below = (threshold > 0 && (uint16_t)(d[i] - 1U) < t) ? 1U : 0U;
+        if (mask) {
+            mask[i] = below;
+        }
+        count = (uint16_t)(count + below);
+    }
+    return count;
+}
+
+static const lidar_kernel_ops_t g_ops_scalar = { extremes_scalar, sector_min_scalar, below_mask_scalar };
+
+// ============================================================================
+// SSE2 / AVX2
+// ============================================================================
+
+#ifdef LIDAR_KERNELS_X86
+
+static inline int16_t sse2_hmin_epi16(__m128i v)
+{
+    v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (int16_t)_mm_extract_epi16(v, 0);
+}
+
+static inline int16_t sse2_hmax_epi16(__m128i v)
+{
+    v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_max_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (int16_t)_mm_extract_epi16(v, 0);
+}
+
+static inline uint32_t sse2_hsum_epi16(__m128i v)
+{
+    v = _mm_madd_epi16(v, _mm_set1_epi16(1));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+static uint16_t sse2_find(const uint16_t *d, uint16_t n, uint16_t value)
+{
+    const __m128i key = _mm_set1_epi16((short)value);
+    uint16_t i = 0;
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        int m = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(d + i)), key));
+        if (m != 0) {
+            return (uint16_t)(i + (unsigned)__builtin_ctz((unsigned)m) / 2U);
+        }
+    }
+    return kernel_find(d, i, n, value);
+}
+
+static void extremes_sse2(const uint16_t *d, uint16_t n, lidar_kernel_extremes_t *e)
+{
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_set1_epi16(0x7FFF);            // Biased 0xFFFF
+    __m128i hi = bias;                              // Biased 0
+    __m128i zeros = zero;
+    uint16_t i = 0;
+
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(d + i));
+        lo = _mm_min_epi16(lo, _mm_xor_si128(_mm_sub_epi16(v, one), bias));
+        hi = _mm_max_epi16(hi, _mm_xor_si128(v, bias));
+        zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(v, zero));
+    }
+    uint16_t lo_m1 = (uint16_t)((uint16_t)sse2_hmin_epi16(lo) ^ 0x8000U);
+    uint16_t hi_v = (uint16_t)((uint16_t)sse2_hmax_epi16(hi) ^ 0x8000U);
+    uint32_t nzero = sse2_hsum_epi16(zeros);
+    for (; i < n; i++) {
+        uint16_t m1 = (uint16_t)(d[i] - 1U);
+        lo_m1 = m1 < lo_m1 ? m1 : lo_m1;
+        hi_v = d[i] > hi_v ? d[i] : hi_v;
+        nzero += d[i] == 0 ? 1U : 0U;
+    }
+
+    e->min_mm = kernel_unbias_min(lo_m1);
+    e->min_index = e->min_mm == UINT16_MAX ? 0 : sse2_find(d, n, e->min_mm);
+    e->max_mm = hi_v;
+    e->max_index = hi_v == 0 ? 0 : sse2_find(d, n, hi_v);
+    e->valid = (uint16_t)(n - nzero);
+}
+
+static uint16_t sector_min_sse2(const uint16_t *d, const uint16_t *a, uint16_t n, uint16_t start, uint16_t end)
+{
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i ones = _mm_set1_epi16(-1);
+    const __m128i none = _mm_set1_epi16(0x7FFF);   // Biased 0xFFFF
+    const __m128i start_b = _mm_xor_si128(_mm_set1_epi16((short)start), bias);
+    const __m128i end_b = _mm_xor_si128(_mm_set1_epi16((short)end), bias);
+    const bool wrap = start > end;
+    __m128i lo = none;
+    uint16_t i = 0;
+
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        __m128i a_b = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(a + i)), bias);
+        __m128i m1_b = _mm_xor_si128(_mm_sub_epi16(_mm_loadu_si128((const __m128i *)(d + i)), one), bias);
+        __m128i ge = _mm_andnot_si128(_mm_cmpgt_epi16(start_b, a_b), ones);
+        __m128i lt = _mm_cmpgt_epi16(end_b, a_b);
+        __m128i in = wrap ? _mm_or_si128(ge, lt) : _mm_and_si128(ge, lt);
+        lo = _mm_min_epi16(lo, _mm_or_si128(_mm_and_si128(in, m1_b), _mm_andnot_si128(in, none)));
+    }
+    uint16_t lo_m1 = (uint16_t)((uint16_t)sse2_hmin_epi16(lo) ^ 0x8000U);
+    uint16_t tail = sector_min_scalar(d + i, a + i, (uint16_t)(n - i), start, end);
+    uint16_t tail_m1 = (uint16_t)(tail - 1U);      // UINT16_MAX -> 0xFFFE, never below a real minimum
+    if (tail != UINT16_MAX && tail_m1 < lo_m1) {
+        lo_m1 = tail_m1;
+    }
+    return kernel_unbias_min(lo_m1);
+}
+
+static uint16_t below_mask_sse2(const uint16_t *d, uint16_t n, uint16_t threshold, uint8_t *mask)
+{
+    if (threshold == 0) {
+        return below_mask_scalar(d, n, threshold, mask);
+    }
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i t_b = _mm_xor_si128(_mm_set1_epi16((short)(threshold - 1U)), bias);
+    const __m128i bit = _mm_set1_epi8(1);
+    uint32_t count = 0;
+    uint16_t i = 0;
+
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        __m128i m1_b = _mm_xor_si128(_mm_sub_epi16(_mm_loadu_si128((const __m128i *)(d + i)), one), bias);
+        __m128i below = _mm_cmpgt_epi16(t_b, m1_b);
+        if (mask) {
+            _mm_storel_epi64((__m128i *)(mask + i), _mm_and_si128(_mm_packs_epi16(below, below), bit));
+        }
+        count += (uint32_t)__builtin_popcount((unsigned)_mm_movemask_epi8(below)) / 2U;
+    }
+    count += below_mask_scalar(d + i, (uint16_t)(n - i), threshold, mask ? mask + i : NULL);
+    return (uint16_t)count;
+}
+
+static const lidar_kernel_ops_t g_ops_sse2 = { extremes_sse2, sector_min_sse2, below_mask_sse2 };
+
+// AVX2 kernels are compiled for AVX2 only and chosen at run time
+#define KERNEL_AVX2 __attribute__((target("avx2")))
+
+KERNEL_AVX2 static inline uint16_t avx2_hmin_epu16(__m256i v)
+{
+    __m128i x = _mm_min_epu16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return (uint16_t)_mm_cvtsi128_si32(_mm_minpos_epu16(x));
+}
+
+KERNEL_AVX2 static inline uint16_t avx2_hmax_epu16(__m256i v)
+{
+    __m128i x = _mm_max_epu16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    x = _mm_xor_si128(x, _mm_set1_epi16(-1));
+    return (uint16_t)~_mm_cvtsi128_si32(_mm_minpos_epu16(x));
+}
+
+KERNEL_AVX2 static uint16_t avx2_find(const uint16_t *d, uint16_t n, uint16_t value)
+{
+    const __m256i key = _mm256_set1_epi16((short)value);
+    uint16_t i = 0;
+    for (; i + 16U <= n; i = (uint16_t)(i + 16U)) {
+        int m = _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)(d + i)), key));
+        if (m != 0) {
+            return (uint16_t)(i + (unsigned)__builtin_ctz((unsigned)m) / 2U);
+        }
+    }
+    return kernel_find(d, i, n, value);
+}
+
+KERNEL_AVX2 static void extremes_avx2(const uint16_t *d, uint16_t n, lidar_kernel_extremes_t *e)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_set1_epi16(-1);
+    __m256i hi = zero;
+    __m256i zeros = zero;
+    uint16_t i = 0;
+
+    for (; i + 16U <= n; i = (uint16_t)(i + 16U)) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(d + i));
+        lo = _mm256_min_epu16(lo, _mm256_sub_epi16(v, one));
+        hi = _mm256_max_epu16(hi, v);
+        zeros = _mm256_sub_epi16(zeros, _mm256_cmpeq_epi16(v, zero));
+    }
+    uint16_t lo_m1 = avx2_hmin_epu16(lo);
+    uint16_t hi_v = avx2_hmax_epu16(hi);
+    __m256i sums = _mm256_madd_epi16(zeros, one);
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t nzero = (uint32_t)_mm_cvtsi128_si32(s);
+    for (; i < n; i++) {
+        uint16_t m1 = (uint16_t)(d[i] - 1U);
+        lo_m1 = m1 < lo_m1 ? m1 : lo_m1;
+        hi_v = d[i] > hi_v ? d[i] : hi_v;
+        nzero += d[i] == 0 ? 1U : 0U;
+    }
+
+    e->min_mm = kernel_unbias_min(lo_m1);
+    e->min_index = e->min_mm == UINT16_MAX ? 0 : avx2_find(d, n, e->min_mm);
+    e->max_mm = hi_v;
+    e->max_index = hi_v == 0 ? 0 : avx2_find(d, n, hi_v);
+    e->valid = (uint16_t)(n - nzero);
+}
+
+KERNEL_AVX2 static uint16_t sector_min_avx2(const uint16_t *d, const uint16_t *a, uint16_t n,
+                                            uint16_t start, uint16_t end)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i none = _mm256_set1_epi16(-1);
+    const __m256i start_v = _mm256_set1_epi16((short)start);
+    const __m256i end_v = _mm256_set1_epi16((short)end);
+    const bool wrap = start > end;
+    __m256i lo = none;
+    uint16_t i = 0;
+
+    for (; i + 16U <= n; i = (uint16_t)(i + 16U)) {
+        __m256i av = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i m1 = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(d + i)), one);
+        __m256i ge = _mm256_cmpeq_epi16(_mm256_max_epu16(av, start_v), av);    // a >= start
+        __m256i ge_end = _mm256_cmpeq_epi16(_mm256_max_epu16(av, end_v), av);  // a >= end
+        __m256i in = wrap ? _mm256_or_si256(ge, _mm256_andnot_si256(ge_end, none))
+                          : _mm256_andnot_si256(ge_end, ge);
+        lo = _mm256_min_epu16(lo, _mm256_blendv_epi8(none, m1, in));
+    }
+    uint16_t lo_m1 = avx2_hmin_epu16(lo);
+    uint16_t tail = sector_min_scalar(d + i, a + i, (uint16_t)(n - i), start, end);
+    uint16_t tail_m1 = (uint16_t)(tail - 1U);
+    if (tail != UINT16_MAX && tail_m1 < lo_m1) {
+        lo_m1 = tail_m1;
+    }
+    return kernel_unbias_min(lo_m1);
+}
+
+KERNEL_AVX2 static uint16_t below_mask_avx2(const uint16_t *d, uint16_t n, uint16_t threshold, uint8_t *mask)
+{
+    if (threshold == 0) {
+        return below_mask_scalar(d, n, threshold, mask);
+    }
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i t = _mm256_set1_epi16((short)(threshold - 1U));
+    const __m128i bit = _mm_set1_epi8(1);
+    uint32_t count = 0;
+    uint16_t i = 0;
+
+    for (; i + 16U <= n; i = (uint16_t)(i + 16U)) {
+        __m256i m1 = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(d + i)), one);
+        __m256i ge = _mm256_cmpeq_epi16(_mm256_max_epu16(m1, t), m1);          // d - 1 >= threshold - 1
+        uint32_t ge_bits = (uint32_t)_mm256_movemask_epi8(ge);
+        if (mask) {
+            __m128i bytes = _mm_packs_epi16(_mm256_castsi256_si128(ge), _mm256_extracti128_si256(ge, 1));
+            _mm_storeu_si128((__m128i *)(mask + i), _mm_andnot_si128(bytes, bit));
+        }
+        count += 16U - (uint32_t)__builtin_popcount(ge_bits) / 2U;
+    }
+    count += below_mask_scalar(d + i, (uint16_t)(n - i), threshold, mask ? mask + i : NULL);
+    return (uint16_t)count;
+}
+
+static const lidar_kernel_ops_t g_ops_avx2 = { extremes_avx2, sector_min_avx2, below_mask_avx2 };
+
+#endif // LIDAR_KERNELS_X86
+
+// ============================================================================
+// NEON
+// ============================================================================
+
+#ifdef LIDAR_KERNELS_NEON
+
+static uint16_t neon_find(const uint16_t *d, uint16_t n, uint16_t value)
+{
+    const uint16x8_t key = vdupq_n_u16(value);
+    uint16_t i = 0;
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        if (vmaxvq_u16(vceqq_u16(vld1q_u16(d + i), key)) != 0) {
+            return kernel_find(d, i, (uint16_t)(i + 8U), value);
+        }
+    }
+    return kernel_find(d, i, n, value);
+}
+
+static void extremes_neon(const uint16_t *d, uint16_t n, lidar_kernel_extremes_t *e)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t lo = vdupq_n_u16(0xFFFF);
+    uint16x8_t hi = vdupq_n_u16(0);
+    uint16x8_t zeros = vdupq_n_u16(0);
+    uint16_t i = 0;
+
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        uint16x8_t v = vld1q_u16(d + i);
+        lo = vminq_u16(lo, vsubq_u16(v, one));
+        hi = vmaxq_u16(hi, v);
+        zeros = vsubq_u16(zeros, vceqzq_u16(v));
+    }
+    uint16_t lo_m1 = vminvq_u16(lo);
+    uint16_t hi_v = vmaxvq_u16(hi);
+    uint32_t nzero = vaddlvq_u16(zeros);
+    for (; i < n; i++) {
+        uint16_t m1 = (uint16_t)(d[i] - 1U);
+        lo_m1 = m1 < lo_m1 ? m1 : lo_m1;
+        hi_v = d[i] > hi_v ? d[i] : hi_v;
+        nzero += d[i] == 0 ? 1U : 0U;
+    }
+
+    e->min_mm = kernel_unbias_min(lo_m1);
+    e->min_index = e->min_mm == UINT16_MAX ? 0 : neon_find(d, n, e->min_mm);
+    e->max_mm = hi_v;
+    e->max_index = hi_v == 0 ? 0 : neon_find(d, n, hi_v);
+    e->valid = (uint16_t)(n - nzero);
+}
+
+static uint16_t sector_min_neon(const uint16_t *d, const uint16_t *a, uint16_t n, uint16_t start, uint16_t end)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    const uint16x8_t none = vdupq_n_u16(0xFFFF);
+    const uint16x8_t start_v = vdupq_n_u16(start);
+    const uint16x8_t end_v = vdupq_n_u16(end);
+    const bool wrap = start > end;
+    uint16x8_t lo = none;
+    uint16_t i = 0;
+
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        uint16x8_t av = vld1q_u16(a + i);
+        uint16x8_t m1 = vsubq_u16(vld1q_u16(d + i), one);
+        uint16x8_t ge = vcgeq_u16(av, start_v);
+        uint16x8_t lt = vcltq_u16(av, end_v);
+        uint16x8_t in = wrap ? vorrq_u16(ge, lt) : vandq_u16(ge, lt);
+        lo = vminq_u16(lo, vbslq_u16(in, m1, none));
+    }
+    uint16_t lo_m1 = vminvq_u16(lo);
+    uint16_t tail = sector_min_scalar(d + i, a + i, (uint16_t)(n - i), start, end);
+    uint16_t tail_m1 = (uint16_t)(tail - 1U);
+    if (tail != UINT16_MAX && tail_m1 < lo_m1) {
+        lo_m1 = tail_m1;
+    }
+    return kernel_unbias_min(lo_m1);
+}
+
+static uint16_t below_mask_neon(const uint16_t *d, uint16_t n, uint16_t threshold, uint8_t *mask)
+{
+    if (threshold == 0) {
+        return below_mask_scalar(d, n, threshold, mask);
+    }
+    const uint16x8_t one = vdupq_n_u16(1);
+    const uint16x8_t t = vdupq_n_u16((uint16_t)(threshold - 1U));
+    uint32_t count = 0;
+    uint16_t i = 0;
+
+    for (; i + 8U <= n; i = (uint16_t)(i + 8U)) {
+        uint16x8_t bits = vshrq_n_u16(vcltq_u16(vsubq_u16(vld1q_u16(d + i), one), t), 15);
+        if (mask) {
+            vst1_u8(mask + i, vmovn_u16(bits));
+        }
+        count += vaddvq_u16(bits);
+    }
+    count += below_mask_scalar(d + i, (uint16_t)(n - i), threshold, mask ? mask + i : NULL);
+    return (uint16_t)count;
+}
+
+static const lidar_kernel_ops_t g_ops_neon = { extremes_neon, sector_min_neon, below_mask_neon };
+
+#endif // LIDAR_KERNELS_NEON
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+static const lidar_kernel_ops_t *kernel_ops(lidar_kernel_impl_t impl)
+{
+    switch (impl) {
+        case LIDAR_KERNEL_IMPL_SCALAR:
+            return &g_ops_scalar;
+#ifdef LIDAR_KERNELS_X86
+        case LIDAR_KERNEL_IMPL_SSE2:
+            return &g_ops_sse2;
+        case LIDAR_KERNEL_IMPL_AVX2:
+            return __builtin_cpu_supports("avx2") ? &g_ops_avx2 : NULL;
+#endif
+#ifdef LIDAR_KERNELS_NEON
+        case LIDAR_KERNEL_IMPL_NEON:
+            return &g_ops_neon;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Compare one implementation with the scalar kernels on random frames
+ */
+static bool kernel_matches_scalar(const lidar_kernel_ops_t *ops)
+{
+    static const lidar_kernel_sector_t sectors[] = {
+        { 0, 23040 }, { 0, 2880 }, { 20160, 2880 }, { 5000, 5001 }, { 100, 100 }, { 23000, 40 }
+    };
+    uint16_t d[KERNEL_TEST_POINTS];
+    uint16_t a[KERNEL_TEST_POINTS];
+    uint8_t mask_ref[KERNEL_TEST_POINTS];
+    uint8_t mask[KERNEL_TEST_POINTS];
+    uint32_t x = 0x2545F491U;
+
+    for (uint16_t n = 0; n <= KERNEL_TEST_POINTS; n = (uint16_t)(n + ((n < 40U) ? 1U : 61U))) {
+        for (uint16_t i = 0; i < n; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            // Zeros, repeats and the extremes of the range all show up
+            d[i] = (x & 0x7U) == 0 ? 0 : (x & 0x38U) == 0 ? 0xFFFEU : (uint16_t)(1U + (x >> 8) % 4000U);
+            a[i] = (uint16_t)((x >> 16) % 23040U);
+        }
+
+        lidar_kernel_extremes_t ref, got;
+        extremes_scalar(d, n, &ref);
+        ops->extremes(d, n, &got);
+        if (memcmp(&ref, &got, sizeof(ref)) != 0) {
+            return false;
+        }
+        for (size_t s = 0; s < sizeof(sectors) / sizeof(sectors[0]); s++) {
+            if (ops->sector_min(d, a, n, sectors[s].start_q6, sectors[s].end_q6) !=
+                sector_min_scalar(d, a, n, sectors[s].start_q6, sectors[s].end_q6)) {
+                return false;
+            }
+        }
+        static const uint16_t thresholds[] = { 0, 1, 2, 500, 2000, 0xFFFF };
+        for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++) {
+            if (ops->below_mask(d, n, thresholds[t], mask) != below_mask_scalar(d, n, thresholds[t], mask_ref) ||
+                memcmp(mask, mask_ref, n) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void kernel_select_best(void)
+{
+    static const lidar_kernel_impl_t preferred[] = {
+        LIDAR_KERNEL_IMPL_NEON, LIDAR_KERNEL_IMPL_AVX2, LIDAR_KERNEL_IMPL_SSE2
+    };
+    for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); i++) {
+        const lidar_kernel_ops_t *ops = kernel_ops(preferred[i]);
+        if (!ops) {
+            continue;
+        }
+        if (kernel_matches_scalar(ops)) {
+            g_active_impl = preferred[i];
+            return;
+        }
+        printf("[LIDAR-KERNELS] WARNING: %s self-test failed, not used\n", lidar_kernel_impl_name(preferred[i]));
+    }
+    g_active_impl = LIDAR_KERNEL_IMPL_SCALAR;
+}
+
+static inline const lidar_kernel_ops_t *kernel_active_ops(void)
+{
+    pthread_once(&g_select_once, kernel_select_best);
+    return kernel_ops(g_active_impl);
+}
+
+hal_status_t lidar_kernel_extremes(const uint16_t *distance_mm, uint16_t count, lidar_kernel_extremes_t *extremes)
+{
+    if (!extremes || (!distance_mm && count > 0)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    kernel_active_ops()->extremes(distance_mm, count, extremes);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_kernel_sector_min(const uint16_t *distance_mm, const uint16_t *angle_q6, uint16_t count,
+                                     const lidar_kernel_sector_t *sectors, uint8_t sector_count, uint16_t *min_mm)
+{
+    if (!sectors || !min_mm || ((!distance_mm || !angle_q6) && count > 0)) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    const lidar_kernel_ops_t *ops = kernel_active_ops();
+    for (uint8_t s = 0; s < sector_count; s++) {
+        min_mm[s] = ops->sector_min(distance_mm, angle_q6, count, sectors[s].start_q6, sectors[s].end_q6);
+    }
+    return HAL_STATUS_OK;
+}
+
+uint16_t lidar_kernel_below_mask(const uint16_t *distance_mm, uint16_t count, uint16_t threshold_mm, uint8_t *mask)
+{
+    if (!distance_mm) {
+        return 0;
+    }
+    return kernel_active_ops()->below_mask(distance_mm, count, threshold_mm, mask);
+}
+
+hal_status_t lidar_kernel_self_test(void)
+{
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        const lidar_kernel_ops_t *ops = kernel_ops((lidar_kernel_impl_t)impl);
+        if (ops && !kernel_matches_scalar(ops)) {
+            return HAL_STATUS_ERROR;
+        }
+    }
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_kernel_select(lidar_kernel_impl_t impl)
+{
+    pthread_once(&g_select_once, kernel_select_best);
+    if (!kernel_ops(impl)) {
+        return HAL_STATUS_NOT_SUPPORTED;
+    }
+    g_active_impl = impl;
+    return HAL_STATUS_OK;
+}
+
+bool lidar_kernel_impl_available(lidar_kernel_impl_t impl)
+{
+    return kernel_ops(impl) != NULL;
+}
+
+lidar_kernel_impl_t lidar_kernel_active_impl(void)
+{
+    pthread_once(&g_select_once, kernel_select_best);
+    return g_active_impl;
+}
+
+const char* lidar_kernel_impl_name(lidar_kernel_impl_t impl)
+{
+    switch (impl) {
+        case LIDAR_KERNEL_IMPL_SCALAR: return "scalar";
+        case LIDAR_KERNEL_IMPL_SSE2:   return "sse2";
+        case LIDAR_KERNEL_IMPL_AVX2:   return "avx2";
+        case LIDAR_KERNEL_IMPL_NEON:   return "neon";
+        default:                       return "unknown";
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * @file hal_lidar_kernels.h
+ * @brief Vectorised per-frame kernels over the LiDAR scan arrays
+ * @version 1.0.0
+ * @date 2025-02-21
+ * @team EMBED
+ *
+ * The kernels walk the distance_mm[] and angle_q6[] arrays of a scan frame
+ * in vector registers: NEON on the aarch64 target, SSE2 or AVX2 on x86 dev
+ * machines, and a scalar fallback everywhere else. A distance of 0 means
+ * no return and is never a minimum or inside a threshold mask.
+ *
+ * The fastest kernel the CPU supports is selected on first use, after a
+ * self-test against the scalar kernels; a kernel that disagrees is not
+ * used. lidar_kernel_select() forces one for tests and benchmarks.
+ */
+
+#ifndef HAL_LIDAR_KERNELS_H
+#define HAL_LIDAR_KERNELS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Kernel implementations
+typedef enum {
+    LIDAR_KERNEL_IMPL_SCALAR = 0,           // Plain C, always available
+    LIDAR_KERNEL_IMPL_SSE2,                 // 8 points per step (x86)
+    LIDAR_KERNEL_IMPL_AVX2,                 // 16 points per step (x86, runtime detected)
+    LIDAR_KERNEL_IMPL_NEON,                 // 8 points per step (aarch64)
+    LIDAR_KERNEL_IMPL_COUNT
+} lidar_kernel_impl_t;
+
+// Nearest and farthest return of a frame
+typedef struct {
+    uint16_t min_mm;                        // UINT16_MAX when there is no return
+    uint16_t min_index;                     // First point at min_mm
+    uint16_t max_mm;                        // 0 when there is no return
+    uint16_t max_index;                     // First point at max_mm
+    uint16_t valid;                         // Points with a return
+} lidar_kernel_extremes_t;
+
+// Angular sector [start_q6, end_q6); wraps through 0 when start_q6 > end_q6
+typedef struct {
+    uint16_t start_q6;
+    uint16_t end_q6;
+} lidar_kernel_sector_t;
+
+/**
+ * @brief Nearest and farthest return
+ * @param distance_mm Distances
+ * @param count Point count
+ * @param extremes Output
+ * @return HAL status
+ */
+hal_status_t lidar_kernel_extremes(const uint16_t *distance_mm, uint16_t count, lidar_kernel_extremes_t *extremes);
+
+/**
+ * @brief Nearest return inside each sector
+ * @param distance_mm Distances
+ * @param angle_q6 Angles in 1/64 degree
+ * @param count Point count
+ * @param sectors Sectors
+ * @param sector_count Number of sectors
+ * @param min_mm Output per sector, UINT16_MAX when the sector has no return
+ * @return HAL status
+ */
+hal_status_t lidar_kernel_sector_min(const uint16_t *distance_mm, const uint16_t *angle_q6, uint16_t count,
+                                     const lidar_kernel_sector_t *sectors, uint8_t sector_count, uint16_t *min_mm);
+
+/**
+ * @brief Mark returns closer than a threshold
+ * @param distance_mm Distances
+ * @param count Point count
+ * @param threshold_mm Threshold (exclusive)
+ * @param mask Output, 1 where 0 < distance < threshold and 0 elsewhere (may be NULL)
+ * @return Number of points marked
+ */
+uint16_t lidar_kernel_below_mask(const uint16_t *distance_mm, uint16_t count, uint16_t threshold_mm, uint8_t *mask);
+
+/**
+ * @brief Compare every available kernel with the scalar kernels
+ * @return HAL_STATUS_OK if all agree
+ */
+hal_status_t lidar_kernel_self_test(void);
+
+/**
+ * @brief Force a kernel implementation
+ * @param impl Implementation
+ * @return HAL_STATUS_NOT_SUPPORTED if this CPU or build cannot run it
+ */
+hal_status_t lidar_kernel_select(lidar_kernel_impl_t impl);
+
+/**
+ * @brief Whether an implementation can run here
+ */
+bool lidar_kernel_impl_available(lidar_kernel_impl_t impl);
+
+/**
+ * @brief Implementation in use
+ */
+lidar_kernel_impl_t lidar_kernel_active_impl(void);
+
+/**
+ * @brief Implementation name, e.g. "avx2"
+ */
+const char* lidar_kernel_impl_name(lidar_kernel_impl_t impl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_LIDAR_KERNELS_H
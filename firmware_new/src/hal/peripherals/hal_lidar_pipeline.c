@@ -0,0 +1,420 @@
+/**
+ * @file hal_lidar_pipeline.c
+ * @brief Staged LiDAR frame processing on a small worker pool
+ * @version 1.0.0
+ * @date 2025-02-24
+ * @team EMBED
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "hal_lidar_pipeline.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LIDAR_PIPELINE_RING_MASK    (LIDAR_PIPELINE_FRAMES - 1U)
+#define LIDAR_PIPELINE_ISOLATED     "/sys/devices/system/cpu/isolated"
+
+_Static_assert((LIDAR_PIPELINE_FRAMES & LIDAR_PIPELINE_RING_MASK) == 0, "LIDAR_PIPELINE_FRAMES must be a power of two");
+_Static_assert(LIDAR_PIPELINE_FRAMES <= 256, "Frame indices are uint8_t");
+
+// Producer side of a ring
+static void lidar_pipeline_ring_push(lidar_pipeline_ring_t *ring, uint8_t index)
+{
+    uint32_t head = ring->head;
+    ring->items[head & LIDAR_PIPELINE_RING_MASK] = index;
+    __atomic_store_n(&ring->head, head + 1U, __ATOMIC_RELEASE);
+}
+
+// Consumer side of a ring
+static bool lidar_pipeline_ring_pop(lidar_pipeline_ring_t *ring, uint8_t *index)
+{
+    uint32_t tail = ring->tail;
+    if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *index = ring->items[tail & LIDAR_PIPELINE_RING_MASK];
+    __atomic_store_n(&ring->tail, tail + 1U, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Every buffer free, every stage ring empty (no thread may be using the rings)
+static void lidar_pipeline_reset_rings(lidar_pipeline_t *pipeline)
+{
+    memset(pipeline->rings, 0, sizeof(pipeline->rings));
+    for (uint8_t i = 0; i < LIDAR_PIPELINE_FRAMES; i++) {
+        pipeline->rings[LIDAR_STAGE_FRAMING].items[i] = i;
+    }
+    pipeline->rings[LIDAR_STAGE_FRAMING].head = LIDAR_PIPELINE_FRAMES;
+}
+
+static void lidar_pipeline_record(lidar_stage_stats_t *stage, uint64_t elapsed_ns)
+{
+    uint32_t ns = elapsed_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed_ns;
+    stage->frames++;
+    stage->total_ns += elapsed_ns;
+    stage->last_ns = ns;
+    if (ns > stage->max_ns) {
+        stage->max_ns = ns;
+    }
+}
+
+/**
+ * @brief Run one frame through a stage and pass it on
+ * @return false if the stage had no input
+ */
+static bool lidar_pipeline_run_one(lidar_pipeline_t *pipeline, uint8_t worker, lidar_stage_id_t stage)
+{
+    uint8_t index;
+    if (!lidar_pipeline_ring_pop(&pipeline->rings[stage], &index)) {
+        return false;
+    }
+
+    const lidar_pipeline_stage_t *handler = &pipeline->config.stages[stage];
+    uint64_t start_ns = hal_time_now_ns();
+    if (handler->fn != NULL) {
+        handler->fn(handler->ctx, &pipeline->frames[index]);
+    }
+    uint64_t end_ns = hal_time_now_ns();
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    lidar_pipeline_record(&pipeline->stats.stages[stage], end_ns - start_ns);
+    if (stage == LIDAR_STAGE_SAFETY) {
+        uint64_t decision_us = (end_ns - pipeline->submitted_ns[index]) / 1000U;
+        pipeline->stats.decision_last_us = decision_us > UINT32_MAX ? UINT32_MAX : (uint32_t)decision_us;
+        pipeline->stats.decision_total_us += decision_us;
+        if (pipeline->stats.decision_last_us > pipeline->stats.decision_max_us) {
+            pipeline->stats.decision_max_us = pipeline->stats.decision_last_us;
+        }
+    } else if (stage == LIDAR_STAGE_REDUCE) {
+        pipeline->stats.completed++;
+    }
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+
+    if (stage == LIDAR_STAGE_REDUCE) {
+        // Back to the scan thread
+        lidar_pipeline_ring_push(&pipeline->rings[LIDAR_STAGE_FRAMING], index);
+        return true;
+    }
+
+    lidar_stage_id_t next = (lidar_stage_id_t)(stage + 1);
+    lidar_pipeline_ring_push(&pipeline->rings[next], index);
+    if (pipeline->stage_worker[next] != worker) {
+        sem_post(&pipeline->wake[pipeline->stage_worker[next]]);
+    }
+    return true;
+}
+
+static void *lidar_pipeline_worker_main(void *arg)
+{
+    lidar_pipeline_worker_t *self = (lidar_pipeline_worker_t *)arg;
+    lidar_pipeline_t *pipeline = self->pipeline;
+
+    while (__atomic_load_n(&pipeline->running, __ATOMIC_ACQUIRE)) {
+        while (sem_wait(&pipeline->wake[self->index]) != 0 && errno == EINTR) {
+        }
+
+        // In stage order, so a single worker takes a frame all the way through in one wake-up
+        bool progressed;
+        do {
+            progressed = false;
+            for (int stage = LIDAR_STAGE_FILTER; stage < LIDAR_STAGE_COUNT; stage++) {
+                if (pipeline->stage_worker[stage] != self->index) {
+                    continue;
+                }
+                while (lidar_pipeline_run_one(pipeline, self->index, (lidar_stage_id_t)stage)) {
+                    progressed = true;
+                }
+            }
+        } while (progressed);
+    }
+    return NULL;
+}
+
+/**
+ * @brief CPU for the safety worker
+ * @return CPU index, -1 to leave it unpinned
+ */
+static int lidar_pipeline_pick_cpu(int16_t requested, long online)
+{
+    if (requested >= 0) {
+        return requested < online ? requested : -1;
+    }
+    if (requested != LIDAR_PIPELINE_CPU_AUTO || online <= 1) {
+        return -1;
+    }
+
+    // isolcpus= keeps the scheduler off these; the list reads like "2-3" or "3,5"
+    FILE *f = fopen(LIDAR_PIPELINE_ISOLATED, "r");
+    if (f != NULL) {
+        int cpu = -1;
+        if (fscanf(f, "%d", &cpu) == 1 && cpu >= 0 && cpu < online) {
+            fclose(f);
+            return cpu;
+        }
+        fclose(f);
+    }
+    return (int)(online - 1);
+}
+
+/**
+ * @brief Pin the safety worker, keep the others off its CPU, raise it to SCHED_FIFO
+ */
+static void lidar_pipeline_place_workers(lidar_pipeline_t *pipeline)
+{
+    uint8_t safety = pipeline->stage_worker[LIDAR_STAGE_SAFETY];
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int cpu = lidar_pipeline_pick_cpu(pipeline->config.safety_cpu, online);
+
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET((size_t)cpu, &set);
+        int rc = pthread_setaffinity_np(pipeline->threads[safety], sizeof(set), &set);
+        if (rc != 0) {
+            printf("[LIDAR-PIPELINE] Safety worker not pinned to CPU %d: %s\n", cpu, strerror(rc));
+            cpu = -1;
+        }
+    }
+    if (cpu >= 0) {
+        cpu_set_t others;
+        CPU_ZERO(&others);
+        for (long i = 0; i < online && i < CPU_SETSIZE; i++) {
+            if (i != cpu) {
+                CPU_SET((size_t)i, &others);
+            }
+        }
+        for (uint8_t w = 0; w < pipeline->worker_count; w++) {
+            if (w != safety) {
+                (void)pthread_setaffinity_np(pipeline->threads[w], sizeof(others), &others);
+            }
+        }
+    }
+
+    bool realtime = false;
+    if (pipeline->config.safety_priority > 0) {
+        struct sched_param param = { .sched_priority = pipeline->config.safety_priority };
+        int rc = pthread_setschedparam(pipeline->threads[safety], SCHED_FIFO, &param);
+        if (rc == 0) {
+            realtime = true;
+        } else {
+            printf("[LIDAR-PIPELINE] SCHED_FIFO %u not permitted (%s), safety worker runs at normal priority\n",
+                   pipeline->config.safety_priority, strerror(rc));
+        }
+    }
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    pipeline->stats.safety_cpu = (int16_t)cpu;
+    pipeline->stats.safety_realtime = realtime;
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+}
+
+hal_status_t lidar_pipeline_init(lidar_pipeline_t *pipeline)
+{
+    if (pipeline == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (pipeline->initialized) {
+        return HAL_STATUS_ALREADY_INITIALIZED;
+    }
+
+    memset(pipeline, 0, sizeof(*pipeline));
+    if (pthread_mutex_init(&pipeline->stats_mutex, NULL) != 0) {
+        return HAL_STATUS_ERROR;
+    }
+    for (uint8_t w = 0; w < LIDAR_PIPELINE_MAX_WORKERS; w++) {
+        if (sem_init(&pipeline->wake[w], 0, 0) != 0) {
+            while (w-- > 0) {
+                sem_destroy(&pipeline->wake[w]);
+            }
+            pthread_mutex_destroy(&pipeline->stats_mutex);
+            return HAL_STATUS_ERROR;
+        }
+        pipeline->workers[w].pipeline = pipeline;
+        pipeline->workers[w].index = w;
+    }
+    lidar_pipeline_reset_rings(pipeline);
+    pipeline->stats.safety_cpu = -1;
+    pipeline->initialized = true;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_pipeline_deinit(lidar_pipeline_t *pipeline)
+{
+    if (pipeline == NULL || !pipeline->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+
+    lidar_pipeline_stop(pipeline);
+    for (uint8_t w = 0; w < LIDAR_PIPELINE_MAX_WORKERS; w++) {
+        sem_destroy(&pipeline->wake[w]);
+    }
+    pthread_mutex_destroy(&pipeline->stats_mutex);
+    pipeline->initialized = false;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_pipeline_start(lidar_pipeline_t *pipeline, const lidar_pipeline_config_t *config)
+{
+    if (pipeline == NULL || config == NULL || config->workers == 0 || config->workers > LIDAR_PIPELINE_MAX_WORKERS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!pipeline->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    if (pipeline->running) {
+        return HAL_STATUS_ALREADY_ACTIVE;
+    }
+
+    pipeline->config = *config;
+    pipeline->worker_count = config->workers;
+    pipeline->stage_worker[LIDAR_STAGE_FRAMING] = 0;
+    pipeline->stage_worker[LIDAR_STAGE_FILTER] = 0;
+    pipeline->stage_worker[LIDAR_STAGE_SAFETY] = config->workers > 1 ? 1 : 0;
+    pipeline->stage_worker[LIDAR_STAGE_REDUCE] = config->workers > 2 ? 2 : 0;
+
+    lidar_pipeline_reset_rings(pipeline);
+    for (uint8_t w = 0; w < LIDAR_PIPELINE_MAX_WORKERS; w++) {
+        while (sem_trywait(&pipeline->wake[w]) == 0) {
+        }
+    }
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    memset(&pipeline->stats, 0, sizeof(pipeline->stats));
+    pipeline->stats.workers = config->workers;
+    pipeline->stats.safety_cpu = -1;
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+
+    __atomic_store_n(&pipeline->running, true, __ATOMIC_RELEASE);
+    for (uint8_t w = 0; w < pipeline->worker_count; w++) {
+        if (pthread_create(&pipeline->threads[w], NULL, lidar_pipeline_worker_main, &pipeline->workers[w]) != 0) {
+            printf("[LIDAR-PIPELINE] Failed to create worker %u\n", w);
+            pipeline->worker_count = w;
+            lidar_pipeline_stop(pipeline);
+            return HAL_STATUS_ERROR;
+        }
+    }
+    lidar_pipeline_place_workers(pipeline);
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    int16_t safety_cpu = pipeline->stats.safety_cpu;
+    bool safety_realtime = pipeline->stats.safety_realtime;
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+    printf("[LIDAR-PIPELINE] Started: %u workers, safety worker on CPU %d%s\n", pipeline->worker_count,
+           safety_cpu, safety_realtime ? " (SCHED_FIFO)" : "");
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_pipeline_stop(lidar_pipeline_t *pipeline)
+{
+    if (pipeline == NULL || !pipeline->initialized) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    if (!__atomic_load_n(&pipeline->running, __ATOMIC_ACQUIRE)) {
+        return HAL_STATUS_OK;
+    }
+
+    __atomic_store_n(&pipeline->running, false, __ATOMIC_RELEASE);
+    for (uint8_t w = 0; w < pipeline->worker_count; w++) {
+        sem_post(&pipeline->wake[w]);
+    }
+    for (uint8_t w = 0; w < pipeline->worker_count; w++) {
+        pthread_join(pipeline->threads[w], NULL);
+    }
+    pipeline->worker_count = 0;
+    lidar_pipeline_reset_rings(pipeline);
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    pipeline->stats.workers = 0;
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+    return HAL_STATUS_OK;
+}
+
+lidar_scan_data_t *lidar_pipeline_acquire(lidar_pipeline_t *pipeline)
+{
+    uint8_t index;
+    if (pipeline == NULL || !pipeline->initialized) {
+        return NULL;
+    }
+    if (!lidar_pipeline_ring_pop(&pipeline->rings[LIDAR_STAGE_FRAMING], &index)) {
+        pthread_mutex_lock(&pipeline->stats_mutex);
+        pipeline->stats.starved++;
+        pthread_mutex_unlock(&pipeline->stats_mutex);
+        return NULL;
+    }
+    return &pipeline->frames[index];
+}
+
+hal_status_t lidar_pipeline_submit(lidar_pipeline_t *pipeline, lidar_scan_data_t *scan, uint64_t framing_ns)
+{
+    if (pipeline == NULL || scan < pipeline->frames || scan >= pipeline->frames + LIDAR_PIPELINE_FRAMES) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!__atomic_load_n(&pipeline->running, __ATOMIC_ACQUIRE)) {
+        return HAL_STATUS_INVALID_STATE;
+    }
+
+    uint8_t index = (uint8_t)(scan - pipeline->frames);
+    pipeline->submitted_ns[index] = hal_time_now_ns();
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    lidar_pipeline_record(&pipeline->stats.stages[LIDAR_STAGE_FRAMING], framing_ns);
+    pipeline->stats.submitted++;
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+
+    lidar_pipeline_ring_push(&pipeline->rings[LIDAR_STAGE_FILTER], index);
+    sem_post(&pipeline->wake[pipeline->stage_worker[LIDAR_STAGE_FILTER]]);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_pipeline_flush(lidar_pipeline_t *pipeline, uint32_t timeout_ms)
+{
+    if (pipeline == NULL || !pipeline->initialized) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    uint64_t deadline_ns = hal_time_now_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    for (;;) {
+        pthread_mutex_lock(&pipeline->stats_mutex);
+        bool drained = pipeline->stats.completed == pipeline->stats.submitted;
+        pthread_mutex_unlock(&pipeline->stats_mutex);
+        if (drained) {
+            return HAL_STATUS_OK;
+        }
+        if (hal_time_now_ns() >= deadline_ns) {
+            return HAL_STATUS_TIMEOUT;
+        }
+        hal_sleep_us(200);
+    }
+}
+
+hal_status_t lidar_pipeline_get_stats(lidar_pipeline_t *pipeline, lidar_pipeline_stats_t *stats)
+{
+    if (pipeline == NULL || stats == NULL || !pipeline->initialized) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&pipeline->stats_mutex);
+    *stats = pipeline->stats;
+    pthread_mutex_unlock(&pipeline->stats_mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_pipeline_get_worker(lidar_pipeline_t *pipeline, uint8_t worker, pthread_t *thread)
+{
+    if (pipeline == NULL || thread == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (!__atomic_load_n(&pipeline->running, __ATOMIC_ACQUIRE) || worker >= pipeline->worker_count) {
+        return HAL_STATUS_NOT_FOUND;
+    }
+
+    *thread = pipeline->threads[worker];
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file hal_lidar_pipeline.h
+ * @brief Staged LiDAR frame processing on a small worker pool
+ * @version 1.0.0
+ * @date 2025-02-24
+ * @team EMBED
+ *
+ * Revolutions flow framing -> filter -> safety -> reduce through a fixed
+ * pool of frame buffers. The scan thread frames into a free buffer and
+ * submits it; each later stage runs on a worker thread. Buffers move
+ * between stages as indices in single-producer single-consumer rings, so
+ * the data path takes no lock: every ring has exactly one writer thread
+ * and one reader thread, and the reduce stage returns buffers to the scan
+ * thread through the free ring.
+ *
+ * Workers:
+ *   1: one worker runs filter, safety and reduce in turn
+ *   2: safety on its own worker, filter and reduce on the other
+ *   3: one worker per stage
+ * The safety worker is pinned to an isolated CPU (or the last online CPU)
+ * and raised to SCHED_FIFO when the process is permitted to; the others
+ * are kept off that CPU.
+ */
+
+#ifndef HAL_LIDAR_PIPELINE_H
+#define HAL_LIDAR_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "hal_common.h"
+#include "hal_lidar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIDAR_PIPELINE_FRAMES           8       // Power of two: one being framed, the rest in flight
+#define LIDAR_PIPELINE_MAX_WORKERS      3       // One per processing stage
+#define LIDAR_PIPELINE_CPU_AUTO         (-1)    // First isolated CPU, else the last online CPU
+#define LIDAR_PIPELINE_CPU_NONE         (-2)    // Do not pin the safety worker
+
+/**
+ * @brief One processing stage
+ * @param ctx Stage context
+ * @param scan Frame; the filter stage may rewrite it, later stages only read
+ */
+typedef void (*lidar_pipeline_stage_fn_t)(void *ctx, lidar_scan_data_t *scan);
+
+typedef struct {
+    lidar_pipeline_stage_fn_t fn;       // NULL = pass through
+    void *ctx;
+} lidar_pipeline_stage_t;
+
+// Pipeline configuration
+typedef struct {
+    uint8_t workers;                    // 1..LIDAR_PIPELINE_MAX_WORKERS
+    int16_t safety_cpu;                 // CPU index, LIDAR_PIPELINE_CPU_AUTO or LIDAR_PIPELINE_CPU_NONE
+    uint8_t safety_priority;            // SCHED_FIFO priority of the safety worker, 0 = normal scheduling
+    lidar_pipeline_stage_t stages[LIDAR_STAGE_COUNT];  // LIDAR_STAGE_FRAMING is the producer, unused
+} lidar_pipeline_config_t;
+
+// Ring of frame indices; head is written by the producer only, tail by the consumer only
+typedef struct {
+    uint32_t head __attribute__((aligned(64)));
+    uint32_t tail __attribute__((aligned(64)));
+    uint8_t items[LIDAR_PIPELINE_FRAMES];
+} lidar_pipeline_ring_t;
+
+struct lidar_pipeline;
+
+typedef struct {
+    struct lidar_pipeline *pipeline;
+    uint8_t index;
+} lidar_pipeline_worker_t;
+
+// Pipeline state; all storage is inline
+typedef struct lidar_pipeline {
+    lidar_pipeline_config_t config;
+    lidar_scan_data_t frames[LIDAR_PIPELINE_FRAMES];
+    uint64_t submitted_ns[LIDAR_PIPELINE_FRAMES];
+
+    // rings[LIDAR_STAGE_FRAMING] holds free frames, rings[s] the input of stage s
+    lidar_pipeline_ring_t rings[LIDAR_STAGE_COUNT];
+    uint8_t stage_worker[LIDAR_STAGE_COUNT];
+
+    sem_t wake[LIDAR_PIPELINE_MAX_WORKERS];
+    pthread_t threads[LIDAR_PIPELINE_MAX_WORKERS];
+    lidar_pipeline_worker_t workers[LIDAR_PIPELINE_MAX_WORKERS];
+    uint8_t worker_count;
+    bool running;
+    bool initialized;
+
+    pthread_mutex_t stats_mutex;
+    lidar_pipeline_stats_t stats;
+} lidar_pipeline_t;
+
+/**
+ * @brief Initialize a stopped pipeline
+ * @param pipeline Pipeline
+ * @return HAL status
+ */
+hal_status_t lidar_pipeline_init(lidar_pipeline_t *pipeline);
+
+/**
+ * @brief Stop (if running) and release the pipeline's semaphores and mutex
+ * @param pipeline Pipeline
+ * @return HAL status
+ */
+hal_status_t lidar_pipeline_deinit(lidar_pipeline_t *pipeline);
+
+/**
+ * @brief Start the workers; every frame buffer becomes free
+ * @param pipeline Pipeline
+ * @param config Stages, worker count and safety worker placement
+ * @return HAL_STATUS_ALREADY_ACTIVE if running
+ */
+hal_status_t lidar_pipeline_start(lidar_pipeline_t *pipeline, const lidar_pipeline_config_t *config);
+
+/**
+ * @brief Stop and join the workers; frames still in flight are discarded
+ *
+ * The producer must have stopped submitting.
+ *
+ * @param pipeline Pipeline
+ * @return HAL status
+ */
+hal_status_t lidar_pipeline_stop(lidar_pipeline_t *pipeline);
+
+/**
+ * @brief Take a free frame buffer (producer thread only)
+ * @param pipeline Pipeline
+ * @return Buffer, or NULL if every buffer is in flight (counted as starved)
+ */
+lidar_scan_data_t *lidar_pipeline_acquire(lidar_pipeline_t *pipeline);
+
+/**
+ * @brief Hand a completed revolution to the filter stage (producer thread only)
+ * @param pipeline Pipeline
+ * @param scan Buffer from lidar_pipeline_acquire()
+ * @param framing_ns Time the producer spent framing this revolution
+ * @return HAL status
+ */
+hal_status_t lidar_pipeline_submit(lidar_pipeline_t *pipeline, lidar_scan_data_t *scan, uint64_t framing_ns);
+
+/**
+ * @brief Wait until every submitted frame has left the reduce stage
+ * @param pipeline Pipeline
+ * @param timeout_ms Upper bound on the wait
+ * @return HAL_STATUS_TIMEOUT if frames are still in flight
+ */
+hal_status_t lidar_pipeline_flush(lidar_pipeline_t *pipeline, uint32_t timeout_ms);
+
+/**
+ * @brief Get per-stage timing and frame-to-decision latency
+ * @param pipeline Pipeline
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t lidar_pipeline_get_stats(lidar_pipeline_t *pipeline, lidar_pipeline_stats_t *stats);
+
+/**
+ * @brief Thread of a running worker
+ * @param pipeline Pipeline
+ * @param worker Worker index
+ * @param thread Output
+ * @return HAL_STATUS_NOT_FOUND if the worker is not running
+ */
+hal_status_t lidar_pipeline_get_worker(lidar_pipeline_t *pipeline, uint8_t worker, pthread_t *thread);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_LIDAR_PIPELINE_H
@@ -0,0 +1,126 @@
+/**
+ * @file hal_lidar_window.c
+ * @brief Angle-binned sliding-window statistics over LiDAR frames
+ * @version 1.0.0
+ * @date 2025-02-23
+ * @team EMBED
+ */
+
+#include "hal_lidar_window.h"
+#include <math.h>
+#include <string.h>
+
+hal_status_t lidar_window_init(lidar_window_t *window, uint8_t frames)
+{
+    if (window == NULL || frames == 0 || frames > LIDAR_WINDOW_MAX_FRAMES) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    window->frames = frames;
+    lidar_window_reset(window);
+    return HAL_STATUS_OK;
+}
+
+void lidar_window_reset(lidar_window_t *window)
+{
+    if (window == NULL) {
+        return;
+    }
+
+    uint8_t frames = window->frames;
+    memset(window, 0, sizeof(*window));
+    window->frames = frames;
+}
+
+hal_status_t lidar_window_push(lidar_window_t *window, const lidar_scan_data_t *scan)
+{
+    if (window == NULL || scan == NULL || window->frames == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    // Reduce the frame to one sample per bin
+    uint32_t frame_sum[LIDAR_WINDOW_BINS] = { 0 };
+    uint32_t frame_quality[LIDAR_WINDOW_BINS] = { 0 };
+    uint16_t frame_count[LIDAR_WINDOW_BINS] = { 0 };
+    uint16_t count = scan->point_count < LIDAR_POINTS_PER_SCAN ? scan->point_count : LIDAR_POINTS_PER_SCAN;
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t d = scan->distance_mm[i];
+        if (d == 0) {
+            continue;
+        }
+        uint16_t bin = lidar_window_bin(scan->angle_q6[i]);
+        frame_sum[bin] += d;
+        frame_quality[bin] += scan->quality[i];
+        frame_count[bin]++;
+    }
+
+    // Slide: take the evicted frame out of the sums, put the new one in.
+    // Unused slots hold zeros, so subtracting them is a no-op until the
+    // window is full; unsigned wrap-around keeps the sums exact.
+    uint8_t slot = window->head;
+    uint16_t *sample_mm = window->sample_mm[slot];
+    uint8_t *sample_quality = window->sample_quality[slot];
+
+    for (uint16_t bin = 0; bin < LIDAR_WINDOW_BINS; bin++) {
+        uint32_t old_d = sample_mm[bin];
+        uint32_t old_q = sample_quality[bin];
+        uint32_t n = frame_count[bin];
+        uint32_t d;
+        uint32_t q;
+        if (n <= 2U) {
+            // At 500 points per turn a bin sees at most two returns; no divide
+            uint32_t shift = n >> 1;
+            d = (frame_sum[bin] + shift) >> shift;
+            q = frame_quality[bin] >> shift;
+        } else {
+            d = (frame_sum[bin] + n / 2U) / n;
+            q = frame_quality[bin] / n;
+        }
+
+        window->count[bin] = (uint8_t)(window->count[bin] + (d != 0U) - (old_d != 0U));
+        window->sum_mm[bin] += d - old_d;
+        window->sum_sq_mm[bin] += (uint64_t)d * d - (uint64_t)old_d * old_d;
+        window->sum_quality[bin] += q - old_q;
+        window->sum_weighted_mm[bin] += q * d - old_q * old_d;
+        sample_mm[bin] = (uint16_t)d;
+        sample_quality[bin] = (uint8_t)q;
+    }
+
+    window->head = (uint8_t)((slot + 1U) % window->frames);
+    if (window->filled < window->frames) {
+        window->filled++;
+    }
+    window->pushes++;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t lidar_window_get_stats(const lidar_window_t *window, uint16_t bin, lidar_window_stats_t *stats)
+{
+    if (window == NULL || stats == NULL || bin >= LIDAR_WINDOW_BINS) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+
+    uint32_t n = window->count[bin];
+    stats->count = (uint8_t)n;
+    if (n == 0) {
+        stats->mean_mm = 0.0f;
+        stats->variance_mm2 = 0.0f;
+        stats->stddev_mm = 0.0f;
+        stats->weighted_mean_mm = 0.0f;
+        return HAL_STATUS_OK;
+    }
+
+    // n * sum(d^2) - sum(d)^2 is exact in 64 bits and never negative
+    uint64_t sum = window->sum_mm[bin];
+    uint64_t spread = n * window->sum_sq_mm[bin] - sum * sum;
+    float inv_n = 1.0f / (float)n;
+
+    stats->mean_mm = (float)sum * inv_n;
+    stats->variance_mm2 = (float)spread * inv_n * inv_n;
+    stats->stddev_mm = sqrtf(stats->variance_mm2);
+    stats->weighted_mean_mm = window->sum_quality[bin] > 0
+                                  ? (float)window->sum_weighted_mm[bin] / (float)window->sum_quality[bin]
+                                  : stats->mean_mm;
+    return HAL_STATUS_OK;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file hal_lidar_window.h
+ * @brief Angle-binned sliding-window statistics over LiDAR frames
+ * @version 1.0.0
+ * @date 2025-02-23
+ * @team EMBED
+ *
+ * Each frame is reduced to one sample per 1-degree bin, the mean distance
+ * and quality of its returns in that bin (bins without a return hold
+ * nothing). The window keeps the last N samples of every bin in a ring
+ * and running integer sums of distance, distance squared, quality and
+ * quality-weighted distance. Pushing a frame subtracts the evicted frame
+ * and adds the new one, O(points + bins); mean, variance and weighted
+ * mean of a bin are O(1), whatever the window length.
+ *
+ * Points are matched across frames by angle, not by array index, so
+ * frames with different point counts line up. Storage is fixed at
+ * LIDAR_WINDOW_MAX_FRAMES x LIDAR_WINDOW_BINS samples.
+ */
+
+#ifndef HAL_LIDAR_WINDOW_H
+#define HAL_LIDAR_WINDOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_common.h"
+#include "hal_lidar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIDAR_WINDOW_BINS           360     // 1 degree, as lidar_angle_q6_to_deg()
+#define LIDAR_WINDOW_MAX_FRAMES     10      // LIDAR_MAX_TEMPORAL_WINDOW and LIDAR_MAX_SAMPLE_COUNT
+
+// Running statistics of one bin over the window
+typedef struct {
+    uint8_t count;                          // Frames with a return in this bin
+    float mean_mm;
+    float variance_mm2;                     // Population variance
+    float stddev_mm;
+    float weighted_mean_mm;                 // Quality-weighted; mean_mm if all qualities are 0
+} lidar_window_stats_t;
+
+// Sliding window; all storage is inline
+typedef struct {
+    uint8_t frames;                         // Window length
+    uint8_t filled;                         // Frames currently in the window
+    uint8_t head;                           // Slot the next frame overwrites
+    uint32_t pushes;
+
+    // Per-frame samples, 0 mm = no return
+    uint16_t sample_mm[LIDAR_WINDOW_MAX_FRAMES][LIDAR_WINDOW_BINS];
+    uint8_t sample_quality[LIDAR_WINDOW_MAX_FRAMES][LIDAR_WINDOW_BINS];
+
+    // Running sums over the window
+    uint8_t count[LIDAR_WINDOW_BINS];
+    uint32_t sum_mm[LIDAR_WINDOW_BINS];
+    uint64_t sum_sq_mm[LIDAR_WINDOW_BINS];
+    uint32_t sum_quality[LIDAR_WINDOW_BINS];
+    uint32_t sum_weighted_mm[LIDAR_WINDOW_BINS];
+} lidar_window_t;
+
+/**
+ * @brief Initialize an empty window
+ * @param window Window
+ * @param frames Window length (1..LIDAR_WINDOW_MAX_FRAMES)
+ * @return HAL status
+ */
+hal_status_t lidar_window_init(lidar_window_t *window, uint8_t frames);
+
+/**
+ * @brief Drop all frames, keep the length
+ * @param window Window
+ */
+void lidar_window_reset(lidar_window_t *window);
+
+/**
+ * @brief Add a frame, evicting the oldest once the window is full
+ * @param window Window
+ * @param scan Frame
+ * @return HAL status
+ */
+hal_status_t lidar_window_push(lidar_window_t *window, const lidar_scan_data_t *scan);
+
+/**
+ * @brief Statistics of one bin
+ * @param window Window
+ * @param bin Bin (0..LIDAR_WINDOW_BINS-1)
+ * @param stats Output; count 0 and zeros when the bin has no samples
+ * @return HAL status
+ */
+hal_status_t lidar_window_get_stats(const lidar_window_t *window, uint16_t bin, lidar_window_stats_t *stats);
+
+/**
+ * @brief Bin of an angle
+ */
+static inline uint16_t lidar_window_bin(uint16_t angle_q6)
+{
+    return lidar_angle_q6_to_deg(angle_q6);
+}
+
+/**
+ * @brief Frames with a return in a bin; the fast path for mean-only filters
+ */
+static inline uint8_t lidar_window_count(const lidar_window_t *window, uint16_t bin)
+{
+    return window->count[bin];
+}
+
+/**
+ * @brief Mean distance of a bin, 0 when it has no samples
+ */
+static inline float lidar_window_mean_mm(const lidar_window_t *window, uint16_t bin)
+{
+    uint8_t n = window->count[bin];
+    return n > 0 ? (float)window->sum_mm[bin] / (float)n : 0.0f;
+}
+
+/**
+ * @brief Z-score gate: |distance - mean| > z * stddev, without sqrt or divide
+ * @param window Window
+ * @param bin Bin
+ * @param distance_mm Current return
+ * @param z Gate in standard deviations
+ * @return true if the return is outside the gate; false for a bin with no spread
+ *
+ * Squares both sides over the integer sums: (n*d - sum)^2 > z^2 * (n*sum_sq - sum^2).
+ */
+static inline bool lidar_window_exceeds_sigma(const lidar_window_t *window, uint16_t bin, uint16_t distance_mm, float z)
+{
+    uint64_t n = window->count[bin];
+    uint64_t sum = window->sum_mm[bin];
+    uint64_t spread = n * window->sum_sq_mm[bin] - sum * sum;
+    if (spread == 0) {
+        return false;
+    }
+    double diff = (double)(n * distance_mm) - (double)sum;
+    return diff * diff > (double)z * (double)z * (double)spread;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_LIDAR_WINDOW_H
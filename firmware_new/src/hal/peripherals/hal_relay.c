@@ -42,7 +42,6 @@ static uint32_t overcurrent_threshold_ma = 2000; // 2A
 static uint32_t overtemperature_threshold_c = 85; // 85°C
 
 // Internal functions
-static uint64_t get_timestamp_ms(void);
 static hal_status_t gpio_export(uint8_t pin);
 static hal_status_t gpio_set_direction(uint8_t pin, bool output);
 static hal_status_t gpio_set_value(uint8_t pin, bool value);
@@ -166,7 +165,7 @@ hal_status_t hal_relay1_set_state(relay_state_t state) {
     }
     
     relay1_status.state = state;
-    relay1_status.last_switch_time = get_timestamp_ms();
+    relay1_status.last_switch_time = hal_time_now_ms();
     relay1_status.switch_count++;
     
     bool output_value = (state == RELAY_STATE_ON);
@@ -184,7 +183,7 @@ hal_status_t hal_relay2_set_state(relay_state_t state) {
     }
     
     relay2_status.state = state;
-    relay2_status.last_switch_time = get_timestamp_ms();
+    relay2_status.last_switch_time = hal_time_now_ms();
     relay2_status.switch_count++;
     
     bool output_value = (state == RELAY_STATE_ON);
@@ -583,12 +582,6 @@ hal_status_t hal_relay_test_pulse(uint32_t duration_ms) {
 }
 
 // Internal helper functions
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-}
-
 static hal_status_t gpio_export(uint8_t pin) {
     char path[64];
     snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d", pin);
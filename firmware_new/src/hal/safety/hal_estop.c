@@ -1,6 +1,7 @@
 #define _POSIX_C_SOURCE 200809L
 #define _DEFAULT_SOURCE
 #include "hal_estop.h"
+#include "hal_gpio.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,14 +22,16 @@ static estop_status_t estop_status = {0};
 static bool estop_initialized = false;
 static pthread_t estop_monitor_thread;
 static bool estop_thread_running = false;
+static bool estop_event_driven = false;
 static estop_event_callback_t estop_callback = NULL;
 
 // Internal functions
-static uint64_t get_timestamp_ms(void);
 static hal_status_t gpio_export(uint8_t pin);
 static hal_status_t gpio_set_direction(uint8_t pin, bool output);
 static hal_status_t gpio_get_value(uint8_t pin, bool *value);
 static void* estop_monitor_thread_func(void *arg);
+static void estop_gpio_event_handler(const gpio_event_t *event, void *user_data);
+static void estop_apply_pin_value(bool pin_value);
 static void estop_handle_trigger(void);
 static void estop_handle_fault(estop_fault_t fault);
 
@@ -92,16 +95,34 @@ hal_status_t hal_estop_init(const estop_config_t *config) {
         return status;
     }
 
-    // Start E-Stop monitor thread (optional for testing)
-    estop_thread_running = true;
-    int thread_result = pthread_create(&estop_monitor_thread, NULL, estop_monitor_thread_func, NULL);
-    if (thread_result != 0) {
-        printf("Warning: Failed to create E-Stop monitor thread (error %d) - continuing without threading\n", thread_result);
-        estop_thread_running = false;
-        // Don't fail initialization - threading is optional for testing
+    estop_initialized = true;
+
+    // Prefer edge events: reaction time is bounded by the kernel wakeup, not a poll period
+    hal_status_t gpio_status = hal_gpio_init();
+    if (gpio_status == HAL_STATUS_OK || gpio_status == HAL_STATUS_ALREADY_INITIALIZED) {
+        gpio_status = hal_gpio_watch_pin(estop_config.pin, GPIO_EDGE_BOTH, estop_gpio_event_handler, NULL);
+    }
+    if (gpio_status == HAL_STATUS_OK) {
+        estop_event_driven = true;
+
+        // Edges only report changes; pick up the level the pin already has
+        bool pin_value;
+        if (gpio_get_value(estop_config.pin, &pin_value) == HAL_STATUS_OK) {
+            estop_apply_pin_value(pin_value);
+        }
+    } else {
+        printf("Warning: E-Stop edge events unavailable (status %d) - falling back to 1ms polling\n", gpio_status);
+
+        // Start E-Stop monitor thread (optional for testing)
+        estop_thread_running = true;
+        int thread_result = pthread_create(&estop_monitor_thread, NULL, estop_monitor_thread_func, NULL);
+        if (thread_result != 0) {
+            printf("Warning: Failed to create E-Stop monitor thread (error %d) - continuing without threading\n", thread_result);
+            estop_thread_running = false;
+            // Don't fail initialization - threading is optional for testing
+        }
     }
 
-    estop_initialized = true;
     printf("E-Stop safety system initialized successfully\n");
     return HAL_STATUS_OK;
 }
@@ -113,6 +134,12 @@ hal_status_t hal_estop_deinit(void) {
 
     printf("Deinitializing E-Stop safety system...\n");
 
+    // Stop edge events (no callback runs after this returns)
+    if (estop_event_driven) {
+        hal_gpio_unwatch_pin(estop_config.pin);
+        estop_event_driven = false;
+    }
+
     // Stop E-Stop monitor thread (if it was created)
     if (estop_thread_running) {
         estop_thread_running = false;
@@ -169,7 +196,7 @@ hal_status_t hal_estop_reset(void) {
 
     // Update status
     estop_status.state = ESTOP_STATE_RESETTING;
-    estop_status.last_reset_time = get_timestamp_ms();
+    estop_status.last_reset_time = hal_time_now_ms();
 
     // Wait for debounce time
     usleep(estop_config.debounce_time_ms * 1000);
@@ -241,6 +268,11 @@ hal_status_t hal_estop_update(void) {
         return HAL_STATUS_ERROR;
     }
 
+    // With edge events the state is already current; nothing to read
+    if (estop_event_driven) {
+        return HAL_STATUS_OK;
+    }
+
     // Read channel status
     bool pin_value;
     hal_status_t status = gpio_get_value(estop_config.pin, &pin_value);
@@ -248,6 +280,12 @@ hal_status_t hal_estop_update(void) {
         return status;
     }
 
+    estop_apply_pin_value(pin_value);
+
+    return HAL_STATUS_OK;
+}
+
+static void estop_apply_pin_value(bool pin_value) {
     // Update status
     estop_status.pin_status = pin_value;
 
@@ -257,7 +295,7 @@ hal_status_t hal_estop_update(void) {
     // Handle state transitions
     if (estop_triggered && estop_status.state == ESTOP_STATE_SAFE) {
         estop_status.state = ESTOP_STATE_TRIGGERED;
-        estop_status.last_trigger_time = get_timestamp_ms();
+        estop_status.last_trigger_time = hal_time_now_ms();
         estop_status.trigger_count++;
         
         printf("E-Stop triggered!\n");
@@ -278,8 +316,6 @@ hal_status_t hal_estop_update(void) {
             }
         }
     }
-
-    return HAL_STATUS_OK;
 }
 
 hal_status_t hal_estop_test_channels(bool *pin_status) {
@@ -303,7 +339,7 @@ hal_status_t hal_estop_validate_safety(void) {
     printf("Validating E-Stop safety system...\n");
 
     // Test channel response time
-    uint64_t start_time = get_timestamp_ms();
+    uint64_t start_time = hal_time_now_ms();
     bool pin_value;
     
     hal_status_t status = gpio_get_value(estop_config.pin, &pin_value);
@@ -311,7 +347,7 @@ hal_status_t hal_estop_validate_safety(void) {
         return status;
     }
 
-    uint64_t response_time = get_timestamp_ms() - start_time;
+    uint64_t response_time = hal_time_now_ms() - start_time;
     
     if (response_time > estop_config.response_timeout_ms) {
                 printf("E-Stop validation failed: response time %lu ms > %u ms\n",
@@ -359,7 +395,7 @@ hal_status_t hal_estop_handle_emergency(void) {
     
     // Set state to triggered
     estop_status.state = ESTOP_STATE_TRIGGERED;
-    estop_status.last_trigger_time = get_timestamp_ms();
+    estop_status.last_trigger_time = hal_time_now_ms();
     estop_status.trigger_count++;
 
     // Call callback if set
@@ -544,24 +580,20 @@ hal_status_t hal_estop_validate_hardware(void) {
 }
 
 // Internal helper functions
-static uint64_t get_timestamp_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-}
-
 static hal_status_t gpio_export(uint8_t pin) {
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d", pin);
+    char path[GPIO_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/gpio%d", hal_gpio_get_sysfs_root(), pin);
     
     // Check if already exported
     if (access(path, F_OK) == 0) {
         return HAL_STATUS_OK;
     }
     
-    FILE *fp = fopen("/sys/class/gpio/export", "w");
+    char export_path[GPIO_PATH_MAX + 16];
+    snprintf(export_path, sizeof(export_path), "%s/export", hal_gpio_get_sysfs_root());
+    FILE *fp = fopen(export_path, "w");
     if (!fp) {
-        printf("CRITICAL SAFETY ERROR: Cannot export GPIO pin %d - /sys/class/gpio/export not accessible\n", pin);
+        printf("CRITICAL SAFETY ERROR: Cannot export GPIO pin %d - %s not accessible\n", pin, export_path);
         return HAL_STATUS_ERROR;
     }
     
@@ -581,8 +613,8 @@ static hal_status_t gpio_export(uint8_t pin) {
 }
 
 static hal_status_t gpio_set_direction(uint8_t pin, bool output) {
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/direction", pin);
+    char path[GPIO_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/gpio%d/direction", hal_gpio_get_sysfs_root(), pin);
     
     FILE *fp = fopen(path, "w");
     if (!fp) {
@@ -597,8 +629,13 @@ static hal_status_t gpio_set_direction(uint8_t pin, bool output) {
 }
 
 static hal_status_t gpio_get_value(uint8_t pin, bool *value) {
-    char path[64];
-    snprintf(path, sizeof(path), "/sys/class/gpio/gpio%d/value", pin);
+    // Watched pin: read through the persistently open value node
+    if (estop_event_driven) {
+        return hal_gpio_get_value(pin, value);
+    }
+
+    char path[GPIO_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/gpio%d/value", hal_gpio_get_sysfs_root(), pin);
     
     FILE *fp = fopen(path, "r");
     if (!fp) {
@@ -630,11 +667,25 @@ static void* estop_monitor_thread_func(void *arg) {
     return NULL;
 }
 
+static void estop_gpio_event_handler(const gpio_event_t *event, void *user_data) {
+    (void)user_data;
+
+    if (!estop_initialized) {
+        return;
+    }
+    if (event->edge == GPIO_EDGE_FALLING) {
+        // Latch on the press itself; the pin may already have bounced back
+        estop_apply_pin_value(false);
+    } else {
+        estop_apply_pin_value(event->value);
+    }
+}
+
 static void __attribute__((unused)) estop_handle_trigger(void) {
     printf("E-Stop TRIGGERED!\n");
     
     estop_status.state = ESTOP_STATE_TRIGGERED;
-    estop_status.last_trigger_time = get_timestamp_ms();
+    estop_status.last_trigger_time = hal_time_now_ms();
     estop_status.trigger_count++;
 
     // Call callback if set
@@ -18,6 +18,8 @@ volatile sig_atomic_t g_should_run = 1;
 #include <sys/types.h>
 
 #include "hal_common.h"
+#include "hal_reactor.h"
+#include "hal_log.h"
 #include "hal_led.h"
 #include "hal_estop.h"
 #include "hal_rs485.h"
@@ -27,38 +29,24 @@ volatile sig_atomic_t g_should_run = 1;
 #include "system_controller.h"
 #include "safety_manager.h"
 #include "safety_monitor.h"
+#include "control_loop.h"
+#include "control_executor.h"
 #include "communication_manager.h"
+#include "modbus_bus_master.h"
+#include "module_discovery.h"
 #include "module_manager.h"
 #include "module_polling_manager.h"
 #include "power_module_handler.h"
 #include "storage/module_data_storage.h"
+#include "storage/register_value_cache.h"
+#include "storage/timeseries_store.h"
+#include "telemetry_stream.h"
 #include "travel_motor_module_handler.h"
 #include "api_manager.h"
 #include "api_endpoints.h"
 // WebSocket removed - Firmware only uses HTTP/REST API
 #include "constants.h"
 
-// Performance optimization constants
-#define PERFORMANCE_MONITORING_ENABLED 1
-#define ADAPTIVE_TIMING_ENABLED 1
-#define MIN_LOOP_INTERVAL_MS 5
-#define MAX_LOOP_INTERVAL_MS 50
-#define TARGET_CPU_USAGE_PERCENT 70.0f
-
-// Performance monitoring structure
-typedef struct {
-    uint64_t loop_start_time;
-    uint64_t loop_end_time;
-    uint64_t loop_duration_us;
-    uint64_t max_loop_duration_us;
-    uint64_t total_loops;
-    uint64_t slow_loops;
-    float avg_loop_duration_us;
-    float cpu_usage_percent;
-} performance_monitor_t;
-
-static performance_monitor_t g_perf_monitor = {0};
-
 // Auto cleanup functions
 static int auto_cleanup_processes(void) {
     printf("[CLEANUP] 🧹 Checking for existing OHT processes...\n");
@@ -143,6 +131,7 @@ static void handle_signal(int signum) {
     (void)signum;
     printf("\n[OHT-50] Received signal %d, shutting down gracefully...\n", signum);
     g_should_run = 0;
+    hal_reactor_stop();
 }
 
 static void install_signal_handlers(void) {
@@ -154,75 +143,289 @@ static void print_usage(const char *prog) {
     printf("Usage: %s [--dry-run] [--debug|--verbose] [--help]\n", prog);
 }
 
-static uint64_t now_ms(void) { return hal_get_timestamp_ms(); }
-static uint64_t now_us(void) { 
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+// Register changes: live stream subscribers, then the persistent history (both report wall-clock time)
+static void on_register_change(uint8_t module_addr, uint16_t start_addr, const uint16_t *values,
+                               uint16_t count, uint64_t timestamp_ms, void *user_data) {
+    uint64_t wall_ms = hal_time_to_wall_ms(timestamp_ms);
+    telemetry_stream_on_registers(module_addr, start_addr, values, count, wall_ms, user_data);
+    (void)ts_store_append_registers(module_addr, start_addr, values, count, wall_ms);
 }
 
-// Performance monitoring functions
-static void performance_monitor_loop_start(void) {
-    if (PERFORMANCE_MONITORING_ENABLED) {
-        g_perf_monitor.loop_start_time = now_us();
+// CTO Requirements: COMM LED policy based on 4 mandatory slave modules
+static void apply_comm_led_policy(size_t online) {
+    if (online == MANDATORY_MODULES_COUNT) {
+        // All 4 mandatory slave modules online: NORMAL status
+        hal_led_comm_set(LED_STATE_ON);
+        printf("[OHT-50] NORMAL: All %d mandatory slave modules online - COMM LED solid\n", MANDATORY_MODULES_COUNT);
+    } else if (online > 0 && online < MANDATORY_MODULES_COUNT) {
+        // Some mandatory slave modules missing: WARNING status
+        hal_led_comm_set(LED_STATE_BLINK_FAST);
+        hal_led_system_warning(); // indicate missing mandatory slave modules (warning pattern)
+        printf("[OHT-50] WARNING: Only %zu/%d mandatory slave modules online - COMM LED blink fast\n", 
+               online, MANDATORY_MODULES_COUNT);
+    } else {
+        // No modules online: ERROR status
+        hal_led_comm_set(LED_STATE_OFF);
+        printf("[OHT-50] ERROR: No slave modules online - COMM LED off\n");
     }
 }
 
-static void performance_monitor_loop_end(void) {
-    if (PERFORMANCE_MONITORING_ENABLED) {
-        g_perf_monitor.loop_end_time = now_us();
-        g_perf_monitor.loop_duration_us = g_perf_monitor.loop_end_time - g_perf_monitor.loop_start_time;
-        
-        // Update statistics
-        g_perf_monitor.total_loops++;
-        if (g_perf_monitor.loop_duration_us > g_perf_monitor.max_loop_duration_us) {
-            g_perf_monitor.max_loop_duration_us = g_perf_monitor.loop_duration_us;
+// Main-thread tasks: run by the reactor (hal_reactor.h) at their own period, "now" is the reactor's tick
+static uint64_t g_startup_deadline_ms = 0;
+static int g_polling_done_task = -1;
+
+static void task_state_update(void *context) {
+    (void)context;
+    (void)system_state_machine_update();
+
+    // API Manager is event-driven, no processing loop needed
+    hal_status_t sys_ctrl_status = system_controller_update();
+    if (sys_ctrl_status != HAL_STATUS_OK && g_debug_mode) {
+        // Only log if it's not a "not initialized" error to reduce spam
+        if (sys_ctrl_status != HAL_STATUS_NOT_INITIALIZED) {
+            printf("[OHT-50][DEBUG] system_controller_update failed: %d\n", sys_ctrl_status);
         }
-        
-        // Track slow loops (>20ms)
-        if (g_perf_monitor.loop_duration_us > 20000) {
-            g_perf_monitor.slow_loops++;
+    }
+
+    // Promote to IDLE if init complete
+    system_state_t current_state;
+    if (system_state_machine_get_state(&current_state) == HAL_STATUS_OK) {
+        if (current_state == SYSTEM_STATE_INIT) {
+            (void)system_state_machine_enter_idle();
+        }
+    }
+}
+
+static void task_safety_update(void *context) {
+    (void)context;
+    (void)safety_manager_update();
+
+    // Check for E-Stop triggered
+    bool estop_triggered = false;
+    if (hal_estop_is_triggered(&estop_triggered) == HAL_STATUS_OK && estop_triggered) {
+        (void)system_state_machine_process_event(SYSTEM_EVENT_ESTOP_TRIGGERED);
+    }
+
+    // Control executor interlock, reported here rather than from the real-time thread
+    static bool interlock_reported = false;
+    control_executor_stats_t exec_stats;
+    if (control_executor_get_stats(&exec_stats) == HAL_STATUS_OK &&
+        exec_stats.interlock_active != interlock_reported) {
+        printf("[CONTROL-EXEC] E-Stop %s\n",
+               exec_stats.interlock_active ? "active, control held in EMERGENCY" : "released");
+        interlock_reported = exec_stats.interlock_active;
+    }
+
+    // LiDAR safety zones (once per published frame); the pipeline's safety worker normally
+    // decided the frame already, this catches any it did not
+    static uint64_t last_lidar_sequence = 0;
+    if (!g_dry_run && hal_lidar_get_frame_sequence() != last_lidar_sequence) {
+        lidar_frame_view_t frame;
+        if (hal_lidar_acquire_frame(&frame) == HAL_STATUS_OK) {
+            hal_status_t lidar_status = safety_monitor_lidar_handler(NULL, frame.scan);
+            if (lidar_status != HAL_STATUS_OK) {
+                // No safety decision for this frame: stop
+                fprintf(stderr, "[OHT-50] LiDAR safety decision failed (status=%d) - E-Stop\n", lidar_status);
+                (void)system_state_machine_process_event(SYSTEM_EVENT_ESTOP_TRIGGERED);
+            }
+            last_lidar_sequence = frame.sequence;
+            hal_lidar_release_frame(&frame);
         }
-        
-        // Calculate running average
-        g_perf_monitor.avg_loop_duration_us = 
-            (g_perf_monitor.avg_loop_duration_us * (g_perf_monitor.total_loops - 1) + 
-             g_perf_monitor.loop_duration_us) / g_perf_monitor.total_loops;
     }
 }
 
-static uint32_t calculate_adaptive_sleep_ms(void) {
-    if (!ADAPTIVE_TIMING_ENABLED) {
-        return 10; // Default fixed timing
+// RS485 Module Telemetry Broadcasting - Issue #90
+static void task_rs485_telemetry(void *context) {
+    (void)context;
+    // Broadcast telemetry for all discovered modules
+    uint8_t module_addresses[] = {0x02, 0x03, 0x04, 0x05}; // Power, Safety, Motor, Dock
+    for (size_t i = 0; i < sizeof(module_addresses); i++) {
+        uint8_t addr = module_addresses[i];
+        
+        // Check if module is online in registry
+        module_info_t module_info;
+        if (registry_get(addr, &module_info) == 0 && module_info.status == MODULE_STATUS_ONLINE) {
+            // WebSocket removed - telemetry sent via HTTP API to backend
+            if (g_debug_mode) {
+                printf("[OHT-50][DEBUG] RS485 telemetry collected for 0x%02X (sent via HTTP API)\n", addr);
+            }
+        }
     }
+}
+
+// System Telemetry and Status Broadcasting
+static void task_telemetry_broadcast(void *context) {
+    (void)context;
+    // Send system telemetry data via HTTP API
+    char telemetry_data[256];
+    snprintf(telemetry_data, sizeof(telemetry_data), 
+            "{\"timestamp\":%lu,\"status\":\"running\",\"modules\":%zu}",
+            hal_time_wall_ms(), registry_count_online());
+    comm_manager_send_telemetry((const uint8_t*)telemetry_data, strlen(telemetry_data));
+    (void)telemetry_stream_publish_event("system", telemetry_data);
     
-    // If loop took a long time, sleep less
-    if (g_perf_monitor.loop_duration_us > 15000) { // >15ms
-        return MIN_LOOP_INTERVAL_MS;
+    // Send status update via HTTP API
+    char status_data[256];
+    snprintf(status_data, sizeof(status_data),
+            "{\"timestamp\":%lu,\"system\":\"OHT-50\",\"state\":\"operational\"}",
+            hal_time_wall_ms());
+    comm_manager_send_status((const uint8_t*)status_data, strlen(status_data));
+    (void)telemetry_stream_publish_event("status", status_data);
+}
+
+// Control output published by the real-time executor
+static void task_control_report(void *context) {
+    (void)context;
+    bool enabled = false;
+    control_status_t control_status;
+    if (control_loop_is_enabled(&enabled) == HAL_STATUS_OK && enabled &&
+        control_loop_get_status(&control_status) == HAL_STATUS_OK) {
+        printf("[CONTROL] Output: %.3f -> Actuator: %.3f\n",
+               (double)control_status.control_output, (double)control_status.actuator_output);
     }
-    // If loop was fast, we can sleep more
-    else if (g_perf_monitor.loop_duration_us < 5000) { // <5ms
-        return MAX_LOOP_INTERVAL_MS;
+}
+
+// Heartbeat LED on SYSTEM LED
+static void task_heartbeat(void *context) {
+    (void)context;
+    static bool heartbeat_on = false;
+    heartbeat_on = !heartbeat_on;
+    (void)hal_led_system_set(heartbeat_on ? LED_STATE_ON : LED_STATE_OFF);
+}
+
+// Periodic diagnostics in debug mode
+static void task_diagnostics(void *context) {
+    (void)context;
+    system_status_t sys_status;
+    safety_status_info_t safe_status;
+    estop_status_t est_status;
+    if (system_state_machine_get_status(&sys_status) == HAL_STATUS_OK) {
+        printf("[OHT-50][DEBUG] state=%s prev=%s trans=%u ready=%s safe=%s comm=%s\n",
+               system_state_machine_get_state_name(sys_status.current_state),
+               system_state_machine_get_state_name(sys_status.previous_state),
+               sys_status.state_transition_count,
+               sys_status.system_ready ? "YES" : "NO",
+               sys_status.safety_ok ? "YES" : "NO",
+               sys_status.communication_ok ? "YES" : "NO");
     }
-    // Adaptive sleep based on loop duration
-    else {
-        uint32_t sleep_ms = 20 - (g_perf_monitor.loop_duration_us / 1000);
-        return (sleep_ms < MIN_LOOP_INTERVAL_MS) ? MIN_LOOP_INTERVAL_MS : 
-               (sleep_ms > MAX_LOOP_INTERVAL_MS) ? MAX_LOOP_INTERVAL_MS : sleep_ms;
+    if (safety_manager_get_status(&safe_status) == HAL_STATUS_OK) {
+        printf("[OHT-50][DEBUG] safety-level=%d status=%d faults=%u\n",
+               (int)safe_status.level,
+               (int)safe_status.status,
+               safe_status.fault_count);
     }
+    if (hal_estop_get_status(&est_status) == HAL_STATUS_OK) {
+        printf("[OHT-50][DEBUG] estop state=%d fault=%d pin=%s\n",
+               (int)est_status.state, (int)est_status.fault,
+               est_status.pin_status ? "ON" : "OFF");
+    }
+    fflush(stdout);
 }
 
-static void performance_monitor_print_stats(void) {
-    if (PERFORMANCE_MONITORING_ENABLED && g_perf_monitor.total_loops > 0) {
-        printf("[PERF] Loops: %llu, Avg: %.1f μs, Max: %llu μs, Slow: %llu (%.1f%%)\n",
-               (unsigned long long)g_perf_monitor.total_loops,
-               g_perf_monitor.avg_loop_duration_us,
-               (unsigned long long)g_perf_monitor.max_loop_duration_us,
-               (unsigned long long)g_perf_monitor.slow_loops,
-               (g_perf_monitor.slow_loops * 100.0f) / g_perf_monitor.total_loops);
+// Communication Manager polling
+static void task_comm_poll(void *context) {
+    (void)context;
+    hal_status_t comm_status = comm_manager_update();
+    if (comm_status != HAL_STATUS_OK && g_debug_mode) {
+        printf("[OHT-50][DEBUG] comm_manager_update failed: %d\n", comm_status);
     }
 }
 
+// Background rescan: one DISCOVERY-priority probe per interval, queued behind polling
+static void task_discovery_step(void *context) {
+    (void)context;
+    static size_t last_online = SIZE_MAX;
+    (void)module_discovery_step();
+    size_t online = registry_count_online();
+    if (last_online != SIZE_MAX && online != last_online) {
+        apply_comm_led_policy(online);
+    }
+    last_online = online;
+}
+
+// Dynamic Module Polling: periodic, and again as soon as the bus master completes a poll
+static void task_module_polling(void *context) {
+    (void)context;
+    hal_status_t polling_status = module_polling_manager_update();
+    if (polling_status != HAL_STATUS_OK && g_debug_mode) {
+        printf("[OHT-50][DEBUG] module_polling_manager_update failed: %d\n", polling_status);
+    }
+}
+
+// Runs on the bus master thread: hand the follow-up to the reactor
+static void on_module_poll_done(void *user_data) {
+    (void)user_data;
+    (void)hal_reactor_signal(g_polling_done_task);
+}
+
+// History store: seal aged blocks, batched writes, retention
+static void task_history_maintain(void *context) {
+    (void)context;
+    (void)ts_store_maintain(hal_time_wall_ms());
+}
+
+// Startup deadline check (only in dry-run)
+static void task_startup_deadline(void *context) {
+    (void)context;
+    if (hal_time_tick_ms() > g_startup_deadline_ms) {
+        printf("[OHT-50] Startup deadline reached.\n");
+        hal_reactor_stop();
+    }
+}
+
+static void task_report(void *context) {
+    (void)context;
+    hal_reactor_print_stats();
+}
+
+typedef struct {
+    const char *name;
+    uint32_t period_ms;
+    hal_reactor_fn_t fn;
+} main_task_t;
+
+// Hardware tasks; safety first, as tasks due on the same tick run in the order they were added
+static const main_task_t g_main_tasks[] = {
+    { "safety",          SAFETY_UPDATE_INTERVAL_MS,       task_safety_update },
+    { "state",           STATE_UPDATE_INTERVAL_MS,        task_state_update },
+    { "polling",         POLLING_UPDATE_INTERVAL_MS,      task_module_polling },
+    { "comm",            COMM_POLL_INTERVAL_MS,           task_comm_poll },
+    { "discovery",       DISCOVERY_STEP_INTERVAL_MS,      task_discovery_step },
+    { "heartbeat",       HEARTBEAT_INTERVAL_MS,           task_heartbeat },
+    { "telemetry",       TELEMETRY_BROADCAST_INTERVAL_MS, task_telemetry_broadcast },
+    { "rs485_telemetry", RS485_TELEMETRY_INTERVAL_MS,     task_rs485_telemetry },
+    { "history",         HISTORY_MAINTAIN_INTERVAL_MS,    task_history_maintain },
+    { "control_report",  CONTROL_REPORT_INTERVAL_MS,      task_control_report },
+};
+
+static hal_status_t register_main_tasks(void) {
+    hal_status_t status = HAL_STATUS_OK;
+
+    if (!g_dry_run) {
+        for (size_t i = 0; i < sizeof(g_main_tasks) / sizeof(g_main_tasks[0]) && status == HAL_STATUS_OK; i++) {
+            status = hal_reactor_add_periodic(g_main_tasks[i].name, g_main_tasks[i].period_ms,
+                                              g_main_tasks[i].fn, NULL, NULL);
+        }
+        if (status == HAL_STATUS_OK) {
+            status = hal_reactor_add_event("polling_done", task_module_polling, NULL, &g_polling_done_task);
+        }
+        if (status == HAL_STATUS_OK) {
+            (void)module_polling_manager_set_completion_listener(on_module_poll_done, NULL);
+        }
+    } else {
+        // Target: reach IDLE in <= 120s (only enforced in dry-run)
+        g_startup_deadline_ms = hal_time_now_ms() + STARTUP_DEADLINE_MS;
+        status = hal_reactor_add_periodic("startup", DIAGNOSTICS_INTERVAL_MS, task_startup_deadline, NULL, NULL);
+    }
+    if (g_debug_mode && status == HAL_STATUS_OK) {
+        status = hal_reactor_add_periodic("diagnostics", DIAGNOSTICS_INTERVAL_MS, task_diagnostics, NULL, NULL);
+    }
+    if (status == HAL_STATUS_OK) {
+        status = hal_reactor_add_periodic("report", TASK_REPORT_INTERVAL_MS, task_report, NULL, NULL);
+    }
+    return status;
+}
+
 int main(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--dry-run") == 0) {
@@ -249,6 +452,8 @@ int main(int argc, char **argv) {
     printf("[OHT-50] Starting main application%s...\n", g_dry_run ? " (dry-run)" : "");
     fflush(stdout);
     install_signal_handlers();
+    // Hot-path HAL_LOG* records go through the background writer from here on
+    (void)hal_log_start(NULL);
 
     if (g_debug_mode) {
         (void)hal_log_set_level(HAL_LOG_LEVEL_DEBUG);
@@ -420,6 +625,13 @@ int main(int argc, char **argv) {
         } else {
             printf("[MAIN] Communication manager initialized successfully\n");
             
+            // Start RS485 bus master - single owner of the bus from here on
+            if (modbus_bus_master_init() == HAL_STATUS_OK && modbus_bus_master_start() == HAL_STATUS_OK) {
+                printf("[MAIN] Modbus bus master started\n");
+            } else {
+                printf("[MAIN] WARNING: Modbus bus master not started, RS485 calls run on the caller\n");
+            }
+            
             // Initialize Module Data Storage
             hal_status_t storage_status = module_data_storage_init();
             if (storage_status != HAL_STATUS_OK) {
@@ -428,6 +640,22 @@ int main(int argc, char **argv) {
                 printf("[MAIN] Module data storage initialized successfully\n");
             }
             
+            // Register value cache - filled by the coalesced polling plans
+            if (register_cache_init() != HAL_STATUS_OK) {
+                printf("[MAIN] WARNING: register_cache_init failed, continuing...\n");
+            }
+            
+            // Compressed register/telemetry history behind /api/v1/modules/{id}/history
+            ts_store_config_t ts_cfg;
+            (void)ts_store_get_default_config(&ts_cfg);
+            if (ts_store_open(&ts_cfg) != HAL_STATUS_OK) {
+                printf("[MAIN] WARNING: history store unavailable at %s, continuing...\n", ts_cfg.directory);
+            }
+            
+            // Register changes feed the /api/v1/telemetry/stream subscribers and the history store
+            (void)telemetry_stream_init();
+            register_cache_set_change_listener(on_register_change, NULL);
+            
             // Initialize HTTP API server only
             comm_mgr_api_config_t api_cfg = {
                 .http_port = 8080,
@@ -511,6 +739,13 @@ int main(int argc, char **argv) {
             }
         }
 
+        // Safety monitor: LiDAR zone decisions and protective fields (shares the E-Stop HAL above)
+        if (safety_monitor_init(NULL) != HAL_STATUS_OK) {
+            fprintf(stderr, "[OHT-50] safety_monitor_init failed - LiDAR frames will E-Stop\n");
+        } else {
+            (void)safety_monitor_set_velocity_source(control_loop_get_current_velocity);
+        }
+
         // LiDAR subsystem initialization
         printf("[MAIN] Initializing LiDAR subsystem...\n");
         
@@ -545,6 +780,7 @@ int main(int argc, char **argv) {
             fprintf(stderr, "[OHT-50] hal_lidar_init failed (status=%d), continuing...\n", lidar_status);
         } else {
             printf("[OHT-50] LiDAR initialized successfully\n");
+            (void)hal_lidar_set_safety_handler(safety_monitor_lidar_handler, NULL);
             
             // Start LiDAR scanning
             hal_status_t scan_status = hal_lidar_start_scanning();
@@ -742,18 +978,6 @@ int main(int argc, char **argv) {
     // 6) Application loop
     printf("[OHT-50] Entering main loop. Press Ctrl+C to exit.\n");
     fflush(stdout);
-    uint64_t last_led_toggle_ms = now_ms();
-    uint64_t last_diag_ms = now_ms();
-    uint64_t last_power_poll_ms = now_ms();
-    uint64_t last_comm_poll_ms = now_ms();
-    uint64_t last_discovery_poll_ms = now_ms();
-    uint64_t last_motor_poll_ms = now_ms();
-    (void)last_power_poll_ms;
-    (void)last_comm_poll_ms;
-    (void)last_discovery_poll_ms;
-    (void)last_motor_poll_ms;
-    // uint64_t last_module_manager_poll_ms = now_ms(); // Unused - commented out
-    bool heartbeat_on = false;
 
     // Power module handler instance
     // power_module_handler_t power_handler; // Commented out - using global state instead
@@ -764,17 +988,20 @@ int main(int argc, char **argv) {
     bool motor_handler_initialized = false;
     (void)motor_handler_initialized;
 
-    // Target: reach IDLE in <= 120s
-    uint64_t startup_deadline_ms = now_ms() + STARTUP_DEADLINE_MS;
-    bool startup_deadline_active = g_dry_run; // Only enforce deadline in dry-run
-
-    // Run initial scan once (Phase 1) - Only scan mandatory modules (0x02-0x05)
+    // Warm start: probe the modules saved in modules.yaml plus the mandatory ones (0x02-0x05)
+    // in parallel; anything still missing is picked up by the background rescan in the loop
     if (!g_dry_run) {
-        printf("[OHT-50] Starting initial module scan (0x02-0x05)...\n");
+        module_discovery_config_t discovery_cfg;
+        module_discovery_get_default_config(&discovery_cfg);
+        if (module_discovery_init(&discovery_cfg) != HAL_STATUS_OK) {
+            printf("[OHT-50] WARNING: module discovery init failed (continuing)\n");
+        }
+        
+        printf("[OHT-50] Starting warm module probe (saved + 0x02-0x05)...\n");
         registry_set_scanning(true);
         hal_led_comm_set(LED_STATE_BLINK_SLOW); // Blink during scan
         
-        (void)comm_manager_scan_range(0x02, 0x05);  // Only scan mandatory modules
+        (void)module_discovery_warm_start(DISCOVERY_WARM_START_BUDGET_MS, NULL);
         
         size_t online = registry_count_online();
         bool has_offline = registry_has_offline_saved();
@@ -782,23 +1009,7 @@ int main(int argc, char **argv) {
         printf("[OHT-50] Scan complete: %zu online, has_offline=%s\n", 
                online, has_offline ? "YES" : "NO");
         
-        // CTO Requirements: COMM LED policy based on 4 mandatory slave modules
-        if (online == MANDATORY_MODULES_COUNT) {
-            // All 4 mandatory slave modules online: NORMAL status
-            hal_led_comm_set(LED_STATE_ON);
-            printf("[OHT-50] NORMAL: All %d mandatory slave modules online - COMM LED solid\n", MANDATORY_MODULES_COUNT);
-        } else if (online > 0 && online < MANDATORY_MODULES_COUNT) {
-            // Some mandatory slave modules missing: WARNING status
-            hal_led_comm_set(LED_STATE_BLINK_FAST);
-            hal_led_system_warning(); // indicate missing mandatory slave modules (warning pattern)
-            printf("[OHT-50] WARNING: Only %zu/%d mandatory slave modules online - COMM LED blink fast\n", 
-                   online, MANDATORY_MODULES_COUNT);
-        } else {
-            // No modules online: ERROR status
-            hal_led_comm_set(LED_STATE_OFF);
-            printf("[OHT-50] ERROR: No slave modules online - COMM LED off\n");
-        }
-        
+        apply_comm_led_policy(online);
         registry_set_scanning(false);
     }
 
@@ -853,218 +1064,70 @@ int main(int argc, char **argv) {
         }
     }
 
-    // Performance monitoring variables
-    uint64_t last_perf_report_ms = now_ms();
-    
-    if (PERFORMANCE_MONITORING_ENABLED && g_debug_mode) {
-        printf("[OHT-50] Performance monitoring ENABLED (adaptive timing: %s)\n",
-               ADAPTIVE_TIMING_ENABLED ? "ON" : "OFF");
-    }
-    
-    while (g_should_run) {
-        // Start performance monitoring
-        performance_monitor_loop_start();
-        
-        // Periodic updates
-        if (!g_dry_run) {
-            (void)system_state_machine_update();
-        }
-        if (!g_dry_run) {
-            (void)safety_manager_update();
-        }
-        
-        // API Manager is event-driven, no processing loop needed
-
-        // System Controller update (every 100ms) - only if initialized
-        if (!g_dry_run) {
-            hal_status_t sys_ctrl_status = system_controller_update();
-            if (sys_ctrl_status != HAL_STATUS_OK && g_debug_mode) {
-                // Only log if it's not a "not initialized" error to reduce spam
-                if (sys_ctrl_status != HAL_STATUS_NOT_INITIALIZED) {
-                    printf("[OHT-50][DEBUG] system_controller_update failed: %d\n", sys_ctrl_status);
-                }
-            }
-        }
-        
-        // RS485 Module Telemetry Broadcasting (every 2000ms) - Issue #90
-        uint64_t current_time = now_ms();
-        static uint64_t last_rs485_telemetry_ms = 0;
-        if (current_time - last_rs485_telemetry_ms >= 2000) {
-            if (!g_dry_run) {
-                // Broadcast telemetry for all discovered modules
-                uint8_t module_addresses[] = {0x02, 0x03, 0x04, 0x05}; // Power, Safety, Motor, Dock
-                for (size_t i = 0; i < sizeof(module_addresses); i++) {
-                    uint8_t addr = module_addresses[i];
-                    
-                    // Check if module is online in registry
-                    module_info_t module_info;
-                    if (registry_get(addr, &module_info) == 0 && module_info.status == MODULE_STATUS_ONLINE) {
-                        // WebSocket removed - telemetry sent via HTTP API to backend
-                        if (g_debug_mode) {
-                            printf("[OHT-50][DEBUG] RS485 telemetry collected for 0x%02X (sent via HTTP API)\n", addr);
-                        }
-                    }
-                }
-            }
-            last_rs485_telemetry_ms = current_time;
-        }
-        
-        // System Telemetry and Status Broadcasting (every 1000ms)
-        static uint64_t last_telemetry_broadcast_ms = 0;
-        if (current_time - last_telemetry_broadcast_ms >= 1000) {
-            if (!g_dry_run) {
-                // Send system telemetry data via HTTP API
-                char telemetry_data[256];
-                snprintf(telemetry_data, sizeof(telemetry_data), 
-                        "{\"timestamp\":%lu,\"status\":\"running\",\"modules\":%zu}",
-                        current_time, registry_count_online());
-                comm_manager_send_telemetry((const uint8_t*)telemetry_data, strlen(telemetry_data));
-                
-                // Send status update via HTTP API
-                char status_data[256];
-                snprintf(status_data, sizeof(status_data),
-                        "{\"timestamp\":%lu,\"system\":\"OHT-50\",\"state\":\"operational\"}",
-                        current_time);
-                comm_manager_send_status((const uint8_t*)status_data, strlen(status_data));
-            }
-            last_telemetry_broadcast_ms = current_time;
-        }
-
-        // Heartbeat LED on SYSTEM LED
-        uint64_t t = now_ms();
-        if (!g_dry_run && (t - last_led_toggle_ms) >= HEARTBEAT_INTERVAL_MS) {
-            heartbeat_on = !heartbeat_on;
-            (void)hal_led_system_set(heartbeat_on ? LED_STATE_ON : LED_STATE_OFF);
-            last_led_toggle_ms = t;
-        }
-
-        // Periodic diagnostics in debug mode
-        if (g_debug_mode && (t - last_diag_ms) >= DIAGNOSTICS_INTERVAL_MS) {
-            system_status_t sys_status;
-            safety_status_info_t safe_status;
-            estop_status_t est_status;
-            if (system_state_machine_get_status(&sys_status) == HAL_STATUS_OK) {
-                printf("[OHT-50][DEBUG] state=%s prev=%s trans=%u ready=%s safe=%s comm=%s\n",
-                       system_state_machine_get_state_name(sys_status.current_state),
-                       system_state_machine_get_state_name(sys_status.previous_state),
-                       sys_status.state_transition_count,
-                       sys_status.system_ready ? "YES" : "NO",
-                       sys_status.safety_ok ? "YES" : "NO",
-                       sys_status.communication_ok ? "YES" : "NO");
-            }
-            if (safety_manager_get_status(&safe_status) == HAL_STATUS_OK) {
-                printf("[OHT-50][DEBUG] safety-level=%d status=%d faults=%u\n",
-                       (int)safe_status.level,
-                       (int)safe_status.status,
-                       safe_status.fault_count);
-            }
-            if (hal_estop_get_status(&est_status) == HAL_STATUS_OK) {
-                printf("[OHT-50][DEBUG] estop state=%d fault=%d pin=%s\n",
-                       (int)est_status.state, (int)est_status.fault,
-                       est_status.pin_status ? "ON" : "OFF");
-            }
-            fflush(stdout);
-            last_diag_ms = t;
-        }
-
-        // Communication Manager polling (every 100ms)
-        if (!g_dry_run) {
-            if ((t - last_comm_poll_ms) >= COMM_POLL_INTERVAL_MS) {
-                hal_status_t comm_status = comm_manager_update();
-                if (comm_status != HAL_STATUS_OK && g_debug_mode) {
-                    printf("[OHT-50][DEBUG] comm_manager_update failed: %d\n", comm_status);
-                }
-                last_comm_poll_ms = t;
-            }
-        }
-
-        // FIXED: Module discovery moved to boot sequence to avoid blocking main loop
-        // No longer needed here as it's done during boot sequence
-
-        // Dynamic Module Polling (replaces individual module polling)
-        if (!g_dry_run) {
-            hal_status_t polling_status = module_polling_manager_update();
-            if (polling_status != HAL_STATUS_OK && g_debug_mode) {
-                printf("[OHT-50][DEBUG] module_polling_manager_update failed: %d\n", polling_status);
-            }
-        }
-
-        // LiDAR data processing (every 100ms for safety)
-        static uint64_t last_lidar_poll_ms = 0;
-        if (!g_dry_run && (t - last_lidar_poll_ms) >= 100) {
-            lidar_scan_data_t scan_data;
-            if (hal_lidar_get_scan_data(&scan_data) == HAL_STATUS_OK) {
-                // Process LiDAR data for safety monitoring
-                // Check safety zones using LiDAR data
-                if (scan_data.scan_complete) {
-                    safety_monitor_check_basic_zones(&scan_data);
-                }
-            }
-            last_lidar_poll_ms = t;
-        }
-
-        // Check for E-Stop triggered
-        if (!g_dry_run) {
-            bool estop_triggered = false;
-            if (hal_estop_is_triggered(&estop_triggered) == HAL_STATUS_OK && estop_triggered) {
-                (void)system_state_machine_process_event(SYSTEM_EVENT_ESTOP_TRIGGERED);
-            }
-        }
-
-        // Promote to IDLE if init complete
-        if (!g_dry_run) {
-            system_state_t current_state;
-            if (system_state_machine_get_state(&current_state) == HAL_STATUS_OK) {
-                if (current_state == SYSTEM_STATE_INIT) {
-                    (void)system_state_machine_enter_idle();
-                }
-            }
-        }
-
-        // Startup deadline check (only in dry-run)
-        if (startup_deadline_active && (t > startup_deadline_ms)) {
-            printf("[OHT-50] Startup deadline reached.\n");
-            break;
+    // Velocity control loop at 1 kHz on its own real-time thread; the main loop no longer paces it
+    if (!g_dry_run) {
+        control_config_t control_cfg = {
+            .control_frequency = 1000.0f,
+            .sample_time = 0.001f,
+            .velocity_pid = {
+                .kp = 1.0f, .ki = 0.1f, .kd = 0.0f,
+                .output_min = -1.0f, .output_max = 1.0f,
+                .integral_min = -10.0f, .integral_max = 10.0f
+            },
+            .profile = {
+                .max_velocity = 1000.0f,        // mm/s, matches the motor handler defaults
+                .max_acceleration = 500.0f,
+                .max_jerk = 100.0f,
+                .position_tolerance = 1.0f,
+                .velocity_tolerance = 5.0f
+            },
+            .enable_limits = true,
+            .enable_safety = true,
+            .position_min_mm = 0.0f,
+            .position_max_mm = 0.0f
+        };
+        control_executor_config_t exec_cfg;
+        (void)control_executor_get_default_config(&exec_cfg);
+        exec_cfg.period_us = (uint32_t)(1000000.0f / control_cfg.control_frequency);
+        if (control_loop_init(&control_cfg) != HAL_STATUS_OK) {
+            fprintf(stderr, "[OHT-50] control_loop_init failed (continuing without motion control)\n");
+        } else if (control_executor_start(&exec_cfg) != HAL_STATUS_OK) {
+            fprintf(stderr, "[OHT-50] control executor not started (continuing without motion control)\n");
         }
+    }
 
-        // End performance monitoring and calculate adaptive sleep
-        performance_monitor_loop_end();
-        
-        // Performance reporting (every 30 seconds)
-        if (PERFORMANCE_MONITORING_ENABLED && (current_time - last_perf_report_ms >= 30000)) {
-            performance_monitor_print_stats();
-            last_perf_report_ms = current_time;
-        }
-        
-        // Adaptive sleep based on loop performance
-        uint32_t sleep_ms = calculate_adaptive_sleep_ms();
-        hal_sleep_ms(sleep_ms);
-        
-        // Debug performance info (every 50 loops for better visibility)
-        if (g_debug_mode && PERFORMANCE_MONITORING_ENABLED && 
-            (g_perf_monitor.total_loops % 50) == 0 && g_perf_monitor.total_loops > 0) {
-            printf("[OHT-50][PERF] 📊 Loop %llu: %llu μs (sleep: %u ms)\n",
-                   (unsigned long long)g_perf_monitor.total_loops,
-                   (unsigned long long)g_perf_monitor.loop_duration_us,
-                   sleep_ms);
-        }
-        
-        // Force performance report every 5 seconds for testing
-        if (PERFORMANCE_MONITORING_ENABLED && (current_time - last_perf_report_ms >= 5000)) {
-            printf("[OHT-50][PERF] 📈 ");
-            performance_monitor_print_stats();
-            last_perf_report_ms = current_time;
-        }
+    // Each task runs at its own period; the thread sleeps in the reactor until the next one is due
+    if (hal_reactor_init() != HAL_STATUS_OK || register_main_tasks() != HAL_STATUS_OK) {
+        fprintf(stderr, "[OHT-50] main task reactor setup failed\n");
+        g_should_run = 0;
+    }
+    if (g_should_run) {
+        (void)hal_reactor_run();
     }
+    (void)module_polling_manager_set_completion_listener(NULL, NULL);
+    hal_reactor_print_stats();
+    (void)hal_reactor_deinit();
 
     printf("[OHT-50] Shutting down...\n");
     // Graceful shutdown
     if (!g_dry_run) {
+        // Stop the control thread first; disabling the loop applies zero output
+        (void)control_executor_stop();
+        (void)control_loop_deinit();
+        
         // Stop Communication Manager API Server
         printf("[OHT-50] Stopping API Manager...\n");
         // Minimal API does not allocate endpoint resources; no-op
         (void)api_manager_stop();
         (void)api_manager_deinit();
+        register_cache_set_change_listener(NULL, NULL);
+        (void)telemetry_stream_deinit();
+        (void)ts_store_close();
+        
+        // Drain and stop the RS485 bus thread before the HAL goes away
+        printf("[OHT-50] Stopping Modbus bus master...\n");
+        (void)module_discovery_deinit();
+        (void)modbus_bus_master_deinit();
         
         // Save Module Registry to YAML
         printf("[OHT-50] Saving Module Registry to YAML...\n");
@@ -1080,6 +1143,7 @@ int main(int argc, char **argv) {
         printf("[OHT-50] Stopping LiDAR scanning...\n");
         (void)hal_lidar_stop_scanning();
         (void)hal_lidar_deinit();
+        (void)safety_monitor_deinit();
         
         (void)hal_led_system_shutdown();
         (void)safety_manager_deinit();
@@ -1101,6 +1165,7 @@ int main(int argc, char **argv) {
         printf("[OHT-50] Cleanup completed\n");
     }
     
+    (void)hal_log_stop();
     printf("[OHT-50] Exit.\n");
     return 0;
 }
@@ -0,0 +1,761 @@
+/**
+ * @file json_writer.c
+ * @brief Bounds-safe streaming JSON writer with arena-backed buffers
+ * @version 1.0.0
+ * @date 2025-03-01
+ * @team FW
+ */
+
+#include "json_writer.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_FRAME_OBJECT   0x01U
+#define JSON_FRAME_ITEMS    0x02U
+
+struct json_arena_chunk {
+    json_arena_chunk_t *next;
+    size_t size;
+    size_t used;
+};
+
+#define JSON_ARENA_ROUND(n)     (((n) + (JSON_ARENA_ALIGN - 1U)) & ~(size_t)(JSON_ARENA_ALIGN - 1U))
+#define JSON_CHUNK_HEADER       JSON_ARENA_ROUND(sizeof(json_arena_chunk_t))
+
+static pthread_once_t g_thread_arena_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_thread_arena_key;
+
+static const char g_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char g_hex_digits[] = "0123456789ABCDEF";
+
+static const uint64_t g_pow10[JSON_WRITER_MAX_DECIMALS + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+};
+
+// 0: copied as is; otherwise the character after the backslash ('u' for \u00XX)
+static const char g_escape[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+};
+
+// ============================================================================
+// ARENA
+// ============================================================================
+
+static char *chunk_data(json_arena_chunk_t *chunk) {
+    return (char *)chunk + JSON_CHUNK_HEADER;
+}
+
+static json_arena_chunk_t *chunk_push(json_arena_t *arena, size_t min_size) {
+    size_t size = arena->chunk_size > min_size ? arena->chunk_size : min_size;
+    json_arena_chunk_t *chunk = (json_arena_chunk_t *)malloc(JSON_CHUNK_HEADER + size);
+    if (chunk == NULL) {
+        return NULL;
+    }
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->next = arena->head;
+    arena->head = chunk;
+    arena->heap_allocs++;
+    return chunk;
+}
+
+static void chunks_free(json_arena_t *arena) {
+    json_arena_chunk_t *chunk = arena->head;
+    while (chunk != NULL) {
+        json_arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arena->head = NULL;
+}
+
+void json_arena_init(json_arena_t *arena, size_t chunk_size) {
+    if (arena == NULL) {
+        return;
+    }
+    memset(arena, 0, sizeof(*arena));
+    arena->chunk_size = JSON_ARENA_ROUND(chunk_size > 0 ? chunk_size : JSON_ARENA_DEFAULT_CHUNK_SIZE);
+}
+
+void json_arena_destroy(json_arena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+    chunks_free(arena);
+    arena->used = 0;
+}
+
+void json_arena_reset(json_arena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+    arena->resets++;
+    if (arena->head != NULL && arena->head->next != NULL) {
+        // Overflowed: next time one chunk holds the whole high-water mark
+        chunks_free(arena);
+        while (arena->chunk_size < arena->high_water) {
+            arena->chunk_size *= 2U;
+        }
+    } else if (arena->head != NULL) {
+        arena->head->used = 0;
+    }
+    arena->used = 0;
+}
+
+void *json_arena_alloc(json_arena_t *arena, size_t size) {
+    if (arena == NULL) {
+        return NULL;
+    }
+    size_t rounded = JSON_ARENA_ROUND(size > 0 ? size : 1U);
+    json_arena_chunk_t *chunk = arena->head;
+    if (chunk == NULL || chunk->size - chunk->used < rounded) {
+        chunk = chunk_push(arena, rounded);
+        if (chunk == NULL) {
+            return NULL;
+        }
+    }
+    void *ptr = chunk_data(chunk) + chunk->used;
+    chunk->used += rounded;
+    arena->used += rounded;
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+    }
+    return ptr;
+}
+
+void *json_arena_grow(json_arena_t *arena, void *ptr, size_t old_size, size_t new_size) {
+    if (arena == NULL) {
+        return NULL;
+    }
+    if (ptr == NULL) {
+        return json_arena_alloc(arena, new_size);
+    }
+    size_t old_rounded = JSON_ARENA_ROUND(old_size > 0 ? old_size : 1U);
+    size_t new_rounded = JSON_ARENA_ROUND(new_size > 0 ? new_size : 1U);
+    if (new_rounded <= old_rounded) {
+        return ptr;
+    }
+
+    // The latest allocation of the current chunk grows in place while the chunk has room
+    json_arena_chunk_t *chunk = arena->head;
+    if (chunk != NULL && (char *)ptr + old_rounded == chunk_data(chunk) + chunk->used &&
+        chunk->size - chunk->used >= new_rounded - old_rounded) {
+        chunk->used += new_rounded - old_rounded;
+        arena->used += new_rounded - old_rounded;
+        if (arena->used > arena->high_water) {
+            arena->high_water = arena->used;
+        }
+        return ptr;
+    }
+
+    void *moved = json_arena_alloc(arena, new_size);
+    if (moved != NULL) {
+        memcpy(moved, ptr, old_size);
+    }
+    return moved;
+}
+
+hal_status_t json_arena_get_stats(const json_arena_t *arena, json_arena_stats_t *stats) {
+    if (arena == NULL || stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    memset(stats, 0, sizeof(*stats));
+    for (const json_arena_chunk_t *chunk = arena->head; chunk != NULL; chunk = chunk->next) {
+        stats->capacity += chunk->size;
+        stats->chunks++;
+    }
+    stats->used = arena->used;
+    stats->high_water = arena->high_water;
+    stats->heap_allocs = arena->heap_allocs;
+    stats->resets = arena->resets;
+    return HAL_STATUS_OK;
+}
+
+static void thread_arena_free(void *ptr) {
+    json_arena_t *arena = (json_arena_t *)ptr;
+    json_arena_destroy(arena);
+    free(arena);
+}
+
+static void thread_arena_key_create(void) {
+    (void)pthread_key_create(&g_thread_arena_key, thread_arena_free);
+}
+
+json_arena_t *json_arena_thread(void) {
+    (void)pthread_once(&g_thread_arena_once, thread_arena_key_create);
+    json_arena_t *arena = (json_arena_t *)pthread_getspecific(g_thread_arena_key);
+    if (arena == NULL) {
+        arena = (json_arena_t *)malloc(sizeof(*arena));
+        if (arena == NULL) {
+            return NULL;
+        }
+        json_arena_init(arena, 0);
+        if (pthread_setspecific(g_thread_arena_key, arena) != 0) {
+            free(arena);
+            return NULL;
+        }
+    }
+    return arena;
+}
+
+// ============================================================================
+// WRITER: BUFFER
+// ============================================================================
+
+static void writer_reset(json_writer_t *writer, json_writer_kind_t kind) {
+    memset(writer, 0, sizeof(*writer));
+    writer->kind = kind;
+    writer->status = HAL_STATUS_OK;
+}
+
+static void writer_fail(json_writer_t *writer, hal_status_t status) {
+    if (writer->status == HAL_STATUS_OK) {
+        writer->status = status;
+    }
+}
+
+/**
+ * @brief Make room for n more bytes (plus the NUL)
+ * @return false once the writer has failed
+ */
+static bool writer_reserve(json_writer_t *writer, size_t n) {
+    if (writer->status != HAL_STATUS_OK) {
+        return false;
+    }
+    if (writer->cap - writer->len >= n) {
+        return true;
+    }
+    if (writer->kind == JSON_WRITER_FIXED) {
+        writer_fail(writer, HAL_STATUS_NO_MEMORY);
+        return false;
+    }
+
+    size_t cap = writer->cap > 0 ? writer->cap : 64U;
+    while (cap - writer->len < n) {
+        cap *= 2U;
+    }
+    char *buf;
+    if (writer->kind == JSON_WRITER_HEAP) {
+        buf = (char *)realloc(writer->buf, cap + 1U);
+    } else {
+        buf = (char *)json_arena_grow(writer->arena, writer->buf, writer->cap + 1U, cap + 1U);
+    }
+    if (buf == NULL) {
+        writer_fail(writer, HAL_STATUS_NO_MEMORY);
+        return false;
+    }
+    writer->buf = buf;
+    writer->cap = cap;
+    return true;
+}
+
+static void put_char(json_writer_t *writer, char c) {
+    if (writer_reserve(writer, 1U)) {
+        writer->buf[writer->len++] = c;
+    }
+}
+
+static void put_bytes(json_writer_t *writer, const char *data, size_t n) {
+    if (n > 0 && writer_reserve(writer, n)) {
+        memcpy(writer->buf + writer->len, data, n);
+        writer->len += n;
+    }
+}
+
+static void put_uint(json_writer_t *writer, uint64_t value) {
+    char tmp[20];
+    size_t pos = sizeof(tmp);
+    while (value >= 100U) {
+        unsigned pair = (unsigned)(value % 100U) * 2U;
+        value /= 100U;
+        tmp[--pos] = g_digit_pairs[pair + 1U];
+        tmp[--pos] = g_digit_pairs[pair];
+    }
+    if (value >= 10U) {
+        unsigned pair = (unsigned)value * 2U;
+        tmp[--pos] = g_digit_pairs[pair + 1U];
+        tmp[--pos] = g_digit_pairs[pair];
+    } else {
+        tmp[--pos] = (char)('0' + value);
+    }
+    put_bytes(writer, tmp + pos, sizeof(tmp) - pos);
+}
+
+/**
+ * @brief Length of the prefix that needs no escaping
+ */
+static size_t plain_prefix(const char *value, size_t length) {
+    const unsigned char *s = (const unsigned char *)value;
+    size_t i = 0;
+    while (i < length && g_escape[s[i]] == 0) {
+        i++;
+    }
+    return i;
+}
+
+static void put_escaped(json_writer_t *writer, const char *value, size_t length) {
+    const unsigned char *s = (const unsigned char *)value;
+    size_t run = 0;
+
+    // Most keys and values need no escaping: one reserve, one copy
+    size_t plain = plain_prefix(value, length);
+    if (plain == length) {
+        if (writer_reserve(writer, length + 2U)) {
+            char *out = writer->buf + writer->len;
+            out[0] = '"';
+            memcpy(out + 1, value, length);
+            out[length + 1U] = '"';
+            writer->len += length + 2U;
+        }
+        return;
+    }
+
+    put_char(writer, '"');
+    for (size_t i = plain; i < length; i++) {
+        char esc = g_escape[s[i]];
+        if (esc == 0) {
+            continue;
+        }
+        put_bytes(writer, value + run, i - run);
+        run = i + 1U;
+        if (esc == 'u') {
+            char u[6] = { '\\', 'u', '0', '0', g_hex_digits[s[i] >> 4], g_hex_digits[s[i] & 0x0FU] };
+            put_bytes(writer, u, sizeof(u));
+        } else {
+            char e[2] = { '\\', esc };
+            put_bytes(writer, e, sizeof(e));
+        }
+    }
+    put_bytes(writer, value + run, length - run);
+    put_char(writer, '"');
+}
+
+// ============================================================================
+// WRITER: STRUCTURE
+// ============================================================================
+
+/**
+ * @brief Separator and state check before any value
+ * @return false if the value must not be written
+ */
+static bool begin_value(json_writer_t *writer) {
+    if (writer->status != HAL_STATUS_OK) {
+        return false;
+    }
+    if (writer->depth == 0) {
+        if (writer->has_root) {
+            writer_fail(writer, HAL_STATUS_INVALID_STATE);
+            return false;
+        }
+        writer->has_root = true;
+        return true;
+    }
+    uint8_t *frame = &writer->frames[writer->depth - 1U];
+    if ((*frame & JSON_FRAME_OBJECT) != 0) {
+        // The key already wrote the separator
+        if (!writer->after_key) {
+            writer_fail(writer, HAL_STATUS_INVALID_STATE);
+            return false;
+        }
+        writer->after_key = false;
+        return true;
+    }
+    if ((*frame & JSON_FRAME_ITEMS) != 0) {
+        put_char(writer, ',');
+    }
+    *frame |= JSON_FRAME_ITEMS;
+    return writer->status == HAL_STATUS_OK;
+}
+
+static void begin_container(json_writer_t *writer, uint8_t frame, char open) {
+    if (!begin_value(writer)) {
+        return;
+    }
+    if (writer->depth >= JSON_WRITER_MAX_DEPTH) {
+        writer_fail(writer, HAL_STATUS_INVALID_STATE);
+        return;
+    }
+    writer->frames[writer->depth++] = frame;
+    put_char(writer, open);
+}
+
+static void end_container(json_writer_t *writer, uint8_t frame, char close) {
+    if (writer->status != HAL_STATUS_OK) {
+        return;
+    }
+    if (writer->depth == 0 || writer->after_key ||
+        (writer->frames[writer->depth - 1U] & JSON_FRAME_OBJECT) != frame) {
+        writer_fail(writer, HAL_STATUS_INVALID_STATE);
+        return;
+    }
+    writer->depth--;
+    put_char(writer, close);
+}
+
+// ============================================================================
+// WRITER: PUBLIC API
+// ============================================================================
+
+void json_writer_init(json_writer_t *writer, char *buf, size_t size) {
+    if (writer == NULL) {
+        return;
+    }
+    writer_reset(writer, JSON_WRITER_FIXED);
+    if (buf == NULL || size == 0) {
+        writer_fail(writer, HAL_STATUS_INVALID_PARAMETER);
+        return;
+    }
+    writer->buf = buf;
+    writer->cap = size - 1U;
+    buf[0] = '\0';
+}
+
+hal_status_t json_writer_init_heap(json_writer_t *writer, size_t size_hint) {
+    if (writer == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    writer_reset(writer, JSON_WRITER_HEAP);
+    writer->cap = size_hint > 0 ? size_hint : 256U;
+    writer->buf = (char *)malloc(writer->cap + 1U);
+    if (writer->buf == NULL) {
+        writer->cap = 0;
+        writer_fail(writer, HAL_STATUS_NO_MEMORY);
+    }
+    return writer->status;
+}
+
+hal_status_t json_writer_init_arena(json_writer_t *writer, json_arena_t *arena, size_t size_hint) {
+    if (writer == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    writer_reset(writer, JSON_WRITER_ARENA);
+    if (arena == NULL) {
+        writer_fail(writer, HAL_STATUS_INVALID_PARAMETER);
+        return writer->status;
+    }
+    writer->arena = arena;
+    writer->cap = size_hint > 0 ? size_hint : 256U;
+    writer->buf = (char *)json_arena_alloc(arena, writer->cap + 1U);
+    if (writer->buf == NULL) {
+        writer->cap = 0;
+        writer_fail(writer, HAL_STATUS_NO_MEMORY);
+    }
+    return writer->status;
+}
+
+json_writer_kind_t json_writer_get_kind(const json_writer_t *writer) {
+    return writer->kind;
+}
+
+void json_writer_free(json_writer_t *writer) {
+    if (writer != NULL && writer->kind == JSON_WRITER_HEAP) {
+        free(writer->buf);
+        writer->buf = NULL;
+        writer->cap = 0;
+        writer->len = 0;
+    }
+}
+
+void json_writer_begin_object(json_writer_t *writer) {
+    begin_container(writer, JSON_FRAME_OBJECT, '{');
+}
+
+void json_writer_end_object(json_writer_t *writer) {
+    end_container(writer, JSON_FRAME_OBJECT, '}');
+}
+
+void json_writer_begin_array(json_writer_t *writer) {
+    begin_container(writer, 0, '[');
+}
+
+void json_writer_end_array(json_writer_t *writer) {
+    end_container(writer, 0, ']');
+}
+
+void json_writer_key(json_writer_t *writer, const char *key) {
+    if (writer->status != HAL_STATUS_OK) {
+        return;
+    }
+    if (key == NULL || writer->depth == 0 || writer->after_key ||
+        (writer->frames[writer->depth - 1U] & JSON_FRAME_OBJECT) == 0) {
+        writer_fail(writer, HAL_STATUS_INVALID_STATE);
+        return;
+    }
+    uint8_t *frame = &writer->frames[writer->depth - 1U];
+    bool comma = (*frame & JSON_FRAME_ITEMS) != 0;
+    *frame |= JSON_FRAME_ITEMS;
+    writer->after_key = true;
+
+    size_t length = strlen(key);
+    if (plain_prefix(key, length) == length) {
+        // ,"key": in one step
+        if (writer_reserve(writer, length + 4U)) {
+            char *out = writer->buf + writer->len;
+            size_t n = 0;
+            if (comma) {
+                out[n++] = ',';
+            }
+            out[n++] = '"';
+            memcpy(out + n, key, length);
+            n += length;
+            out[n++] = '"';
+            out[n++] = ':';
+            writer->len += n;
+        }
+        return;
+    }
+    if (comma) {
+        put_char(writer, ',');
+    }
+    put_escaped(writer, key, length);
+    put_char(writer, ':');
+}
+
+void json_writer_string(json_writer_t *writer, const char *value) {
+    if (value == NULL) {
+        json_writer_null(writer);
+        return;
+    }
+    json_writer_string_len(writer, value, strlen(value));
+}
+
+void json_writer_string_len(json_writer_t *writer, const char *value, size_t length) {
+    if (begin_value(writer)) {
+        put_escaped(writer, value != NULL ? value : "", value != NULL ? length : 0U);
+    }
+}
+
+void json_writer_int(json_writer_t *writer, int64_t value) {
+    if (!begin_value(writer)) {
+        return;
+    }
+    if (value < 0) {
+        put_char(writer, '-');
+        put_uint(writer, (uint64_t)(-(value + 1)) + 1U);
+    } else {
+        put_uint(writer, (uint64_t)value);
+    }
+}
+
+void json_writer_uint(json_writer_t *writer, uint64_t value) {
+    if (begin_value(writer)) {
+        put_uint(writer, value);
+    }
+}
+
+void json_writer_bool(json_writer_t *writer, bool value) {
+    if (begin_value(writer)) {
+        if (value) {
+            put_bytes(writer, "true", 4U);
+        } else {
+            put_bytes(writer, "false", 5U);
+        }
+    }
+}
+
+void json_writer_null(json_writer_t *writer) {
+    if (begin_value(writer)) {
+        put_bytes(writer, "null", 4U);
+    }
+}
+
+void json_writer_fixed(json_writer_t *writer, double value, uint8_t decimals) {
+    if (!begin_value(writer)) {
+        return;
+    }
+    if (isnan(value) || isinf(value)) {
+        put_bytes(writer, "null", 4U);
+        return;
+    }
+    if (decimals > JSON_WRITER_MAX_DECIMALS) {
+        decimals = JSON_WRITER_MAX_DECIMALS;
+    }
+
+    uint64_t scale = g_pow10[decimals];
+    double scaled = fabs(value) * (double)scale + 0.5;
+    if (scaled >= 9.0e18) {
+        // Beyond the integer path; rare enough for printf
+        char tmp[352];
+        int n = snprintf(tmp, sizeof(tmp), "%.*f", (int)decimals, value);
+        if (n > 0) {
+            put_bytes(writer, tmp, (size_t)n < sizeof(tmp) ? (size_t)n : sizeof(tmp) - 1U);
+        }
+        return;
+    }
+
+    // Round half away from zero on the scaled value; a result of zero has no sign
+    uint64_t units = (uint64_t)scaled;
+    if (value < 0.0 && units > 0) {
+        put_char(writer, '-');
+    }
+    put_uint(writer, units / scale);
+    if (decimals > 0) {
+        char frac[JSON_WRITER_MAX_DECIMALS + 1];
+        uint64_t rest = units % scale;
+        frac[0] = '.';
+        for (uint8_t i = decimals; i > 0; i--) {
+            frac[i] = (char)('0' + rest % 10U);
+            rest /= 10U;
+        }
+        put_bytes(writer, frac, (size_t)decimals + 1U);
+    }
+}
+
+void json_writer_double(json_writer_t *writer, double value, uint8_t precision) {
+    if (!begin_value(writer)) {
+        return;
+    }
+    if (isnan(value) || isinf(value)) {
+        put_bytes(writer, "null", 4U);
+        return;
+    }
+    if (precision == 0 || precision > 17) {
+        precision = 17;
+    }
+    // "%g" output (digits, sign, point, exponent) is always a valid JSON number
+    char tmp[32];
+    int n = snprintf(tmp, sizeof(tmp), "%.*g", (int)precision, value);
+    if (n > 0) {
+        put_bytes(writer, tmp, (size_t)n < sizeof(tmp) ? (size_t)n : sizeof(tmp) - 1U);
+    }
+}
+
+void json_writer_hex(json_writer_t *writer, uint32_t value, uint8_t digits) {
+    if (!begin_value(writer)) {
+        return;
+    }
+    char tmp[12];
+    size_t pos = sizeof(tmp);
+    uint8_t count = 0;
+    tmp[--pos] = '"';
+    do {
+        tmp[--pos] = g_hex_digits[value & 0x0FU];
+        value >>= 4;
+        count++;
+    } while ((value != 0 || count < digits) && count < 8U);
+    tmp[--pos] = 'x';
+    tmp[--pos] = '0';
+    tmp[--pos] = '"';
+    put_bytes(writer, tmp + pos, sizeof(tmp) - pos);
+}
+
+void json_writer_hex_bytes(json_writer_t *writer, const uint8_t *data, size_t length) {
+    if (!begin_value(writer)) {
+        return;
+    }
+    if (data == NULL) {
+        length = 0;
+    }
+    if (!writer_reserve(writer, length * 2U + 2U)) {
+        return;
+    }
+    char *out = writer->buf + writer->len;
+    *out++ = '"';
+    for (size_t i = 0; i < length; i++) {
+        *out++ = g_hex_digits[data[i] >> 4];
+        *out++ = g_hex_digits[data[i] & 0x0FU];
+    }
+    *out = '"';
+    writer->len += length * 2U + 2U;
+}
+
+void json_writer_raw(json_writer_t *writer, const char *json, size_t length) {
+    if (json == NULL || length == 0) {
+        json_writer_null(writer);
+        return;
+    }
+    if (begin_value(writer)) {
+        put_bytes(writer, json, length);
+    }
+}
+
+void json_writer_field_string(json_writer_t *writer, const char *key, const char *value) {
+    json_writer_key(writer, key);
+    json_writer_string(writer, value);
+}
+
+void json_writer_field_int(json_writer_t *writer, const char *key, int64_t value) {
+    json_writer_key(writer, key);
+    json_writer_int(writer, value);
+}
+
+void json_writer_field_uint(json_writer_t *writer, const char *key, uint64_t value) {
+    json_writer_key(writer, key);
+    json_writer_uint(writer, value);
+}
+
+void json_writer_field_bool(json_writer_t *writer, const char *key, bool value) {
+    json_writer_key(writer, key);
+    json_writer_bool(writer, value);
+}
+
+void json_writer_field_null(json_writer_t *writer, const char *key) {
+    json_writer_key(writer, key);
+    json_writer_null(writer);
+}
+
+void json_writer_field_fixed(json_writer_t *writer, const char *key, double value, uint8_t decimals) {
+    json_writer_key(writer, key);
+    json_writer_fixed(writer, value, decimals);
+}
+
+void json_writer_field_double(json_writer_t *writer, const char *key, double value, uint8_t precision) {
+    json_writer_key(writer, key);
+    json_writer_double(writer, value, precision);
+}
+
+void json_writer_field_hex(json_writer_t *writer, const char *key, uint32_t value, uint8_t digits) {
+    json_writer_key(writer, key);
+    json_writer_hex(writer, value, digits);
+}
+
+hal_status_t json_writer_status(const json_writer_t *writer) {
+    return writer != NULL ? writer->status : HAL_STATUS_INVALID_PARAMETER;
+}
+
+const char *json_writer_data(const json_writer_t *writer, size_t *length) {
+    if (writer == NULL || writer->buf == NULL || writer->status != HAL_STATUS_OK || writer->depth != 0 ||
+        !writer->has_root) {
+        return NULL;
+    }
+    writer->buf[writer->len] = '\0';
+    if (length != NULL) {
+        *length = writer->len;
+    }
+    return writer->buf;
+}
+
+char *json_writer_take(json_writer_t *writer, size_t *length) {
+    if (writer == NULL || writer->kind != JSON_WRITER_HEAP) {
+        return NULL;
+    }
+    char *out = NULL;
+    if (json_writer_data(writer, length) != NULL) {
+        out = writer->buf;
+    } else {
+        free(writer->buf);
+    }
+    writer->buf = NULL;
+    writer->cap = 0;
+    writer->len = 0;
+    return out;
+}
@@ -0,0 +1,297 @@
+/**
+ * @file json_writer.h
+ * @brief Bounds-safe streaming JSON writer with arena-backed buffers
+ * @version 1.0.0
+ * @date 2025-03-01
+ * @team FW
+ *
+ * The writer appends tokens to one buffer and keeps the object/array
+ * nesting itself: commas and colons are inserted, strings are escaped and
+ * numbers go through integer and fixed-point formatters instead of a
+ * printf format string. Three kinds of buffer:
+ *
+ *  - fixed:  a caller buffer; running out of space is an error, never a
+ *            silently truncated document
+ *  - heap:   malloc'd and grown; the caller takes it with json_writer_take()
+ *  - arena:  carved from a json_arena_t and grown inside it; nothing to free
+ *
+ * Writer calls do not return a status. The first failure (no space, no
+ * memory, a value where a key is expected, unbalanced nesting) is sticky
+ * and reported by json_writer_status() / json_writer_data(), so a
+ * serializer checks once at the end.
+ *
+ * A json_arena_t is a chunked bump allocator that is reset, not freed,
+ * between requests. After a reset that found it overflowed into extra
+ * chunks it is rebuilt as one chunk of the high-water size, so a worker
+ * serving similar requests stops allocating after the first few.
+ * json_arena_thread() gives each thread its own arena.
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include "hal_common.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JSON_WRITER_MAX_DEPTH           16
+#define JSON_WRITER_MAX_DECIMALS        9
+#define JSON_ARENA_DEFAULT_CHUNK_SIZE   16384U
+#define JSON_ARENA_ALIGN                16U
+
+typedef struct json_arena_chunk json_arena_chunk_t;
+
+// Chunked bump allocator, reset per request
+typedef struct {
+    json_arena_chunk_t *head;       // Current chunk; older chunks follow
+    size_t chunk_size;              // Size of a fresh chunk
+    size_t used;                    // Bytes handed out since the last reset
+    size_t high_water;              // Largest used seen at a reset
+    uint64_t heap_allocs;           // Chunks malloc'd over the arena's life
+    uint64_t resets;
+} json_arena_t;
+
+// Arena accounting
+typedef struct {
+    size_t capacity;                // Bytes held in chunks
+    size_t used;
+    size_t high_water;
+    uint32_t chunks;
+    uint64_t heap_allocs;
+    uint64_t resets;
+} json_arena_stats_t;
+
+// Buffer kind of a writer
+typedef enum {
+    JSON_WRITER_FIXED = 0,
+    JSON_WRITER_HEAP,
+    JSON_WRITER_ARENA
+} json_writer_kind_t;
+
+// Streaming writer; all fields are private
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t cap;                     // Usable bytes, one more is kept for the terminating NUL
+    json_writer_kind_t kind;
+    json_arena_t *arena;
+    hal_status_t status;
+    uint8_t depth;
+    uint8_t frames[JSON_WRITER_MAX_DEPTH];
+    bool after_key;
+    bool has_root;
+} json_writer_t;
+
+/**
+ * @brief Initialize an arena; its first chunk is allocated on first use
+ * @param arena Arena
+ * @param chunk_size Size of a fresh chunk (0 for JSON_ARENA_DEFAULT_CHUNK_SIZE)
+ */
+void json_arena_init(json_arena_t *arena, size_t chunk_size);
+
+/**
+ * @brief Free all chunks
+ * @param arena Arena
+ */
+void json_arena_destroy(json_arena_t *arena);
+
+/**
+ * @brief Release everything allocated since the last reset, keeping the memory
+ * @param arena Arena
+ */
+void json_arena_reset(json_arena_t *arena);
+
+/**
+ * @brief Allocate from the arena
+ * @param arena Arena
+ * @param size Bytes
+ * @return JSON_ARENA_ALIGN-aligned memory valid until the next reset, NULL if out of memory
+ */
+void *json_arena_alloc(json_arena_t *arena, size_t size);
+
+/**
+ * @brief Grow an allocation, in place when it is the arena's latest one
+ * @param arena Arena
+ * @param ptr Allocation (NULL allocates)
+ * @param old_size Its size
+ * @param new_size Requested size
+ * @return The allocation, possibly moved (old contents copied), NULL if out of memory
+ */
+void *json_arena_grow(json_arena_t *arena, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Get arena statistics
+ * @param arena Arena
+ * @param stats Output
+ * @return HAL status
+ */
+hal_status_t json_arena_get_stats(const json_arena_t *arena, json_arena_stats_t *stats);
+
+/**
+ * @brief The calling thread's arena, created on first use and freed when the thread exits
+ * @return Arena, NULL if it cannot be created
+ */
+json_arena_t *json_arena_thread(void);
+
+/**
+ * @brief Start a document in a caller buffer
+ * @param writer Writer
+ * @param buf Buffer
+ * @param size Buffer size including the terminating NUL
+ */
+void json_writer_init(json_writer_t *writer, char *buf, size_t size);
+
+/**
+ * @brief Start a document in a growable malloc'd buffer
+ * @param writer Writer
+ * @param size_hint Initial capacity
+ * @return HAL_STATUS_NO_MEMORY if the buffer cannot be allocated
+ */
+hal_status_t json_writer_init_heap(json_writer_t *writer, size_t size_hint);
+
+/**
+ * @brief Start a document in a growable buffer inside an arena
+ * @param writer Writer
+ * @param arena Arena; the document lives until its next reset
+ * @param size_hint Initial capacity
+ * @return HAL_STATUS_NO_MEMORY if the buffer cannot be allocated
+ */
+hal_status_t json_writer_init_arena(json_writer_t *writer, json_arena_t *arena, size_t size_hint);
+
+/**
+ * @brief Buffer kind of a writer
+ * @param writer Writer
+ * @return JSON_WRITER_FIXED, JSON_WRITER_HEAP or JSON_WRITER_ARENA
+ */
+json_writer_kind_t json_writer_get_kind(const json_writer_t *writer);
+
+/**
+ * @brief Free a heap writer's buffer (no-op for the other kinds)
+ * @param writer Writer
+ */
+void json_writer_free(json_writer_t *writer);
+
+/**
+ * @brief Open or close an object or array (as the root, an array element or a key's value)
+ * @param writer Writer
+ */
+void json_writer_begin_object(json_writer_t *writer);
+void json_writer_end_object(json_writer_t *writer);
+void json_writer_begin_array(json_writer_t *writer);
+void json_writer_end_array(json_writer_t *writer);
+
+/**
+ * @brief Write an object key; the next call writes its value
+ * @param writer Writer
+ * @param key Key, escaped as needed
+ */
+void json_writer_key(json_writer_t *writer, const char *key);
+
+/**
+ * @brief Write a string value (NULL writes null)
+ * @param writer Writer
+ * @param value NUL-terminated string, escaped as needed
+ */
+void json_writer_string(json_writer_t *writer, const char *value);
+
+/**
+ * @brief Write a string value of known length (may contain NULs, written as \u0000)
+ * @param writer Writer
+ * @param value Bytes
+ * @param length Byte count
+ */
+void json_writer_string_len(json_writer_t *writer, const char *value, size_t length);
+
+/**
+ * @brief Write a scalar value
+ * @param writer Writer
+ * @param value Value
+ */
+void json_writer_int(json_writer_t *writer, int64_t value);
+void json_writer_uint(json_writer_t *writer, uint64_t value);
+void json_writer_bool(json_writer_t *writer, bool value);
+void json_writer_null(json_writer_t *writer);
+
+/**
+ * @brief Write a number with a fixed number of decimals, like "%.*f"
+ * @param writer Writer
+ * @param value Value; NaN and infinities are written as null
+ * @param decimals Digits after the point, at most JSON_WRITER_MAX_DECIMALS
+ */
+void json_writer_fixed(json_writer_t *writer, double value, uint8_t decimals);
+
+/**
+ * @brief Write a number with a number of significant digits, like "%.*g"
+ * @param writer Writer
+ * @param value Value; NaN and infinities are written as null
+ * @param precision Significant digits (1-17, 0 for 17)
+ */
+void json_writer_double(json_writer_t *writer, double value, uint8_t precision);
+
+/**
+ * @brief Write a "0x..." string of upper-case hex digits, like "\"0x%0*X\""
+ * @param writer Writer
+ * @param value Value
+ * @param digits Minimum digit count (1-8)
+ */
+void json_writer_hex(json_writer_t *writer, uint32_t value, uint8_t digits);
+
+/**
+ * @brief Write a string of upper-case hex byte pairs ("0A1B...")
+ * @param writer Writer
+ * @param data Bytes
+ * @param length Byte count
+ */
+void json_writer_hex_bytes(json_writer_t *writer, const uint8_t *data, size_t length);
+
+/**
+ * @brief Write an already-serialized JSON value verbatim
+ * @param writer Writer
+ * @param json Complete JSON value (not checked)
+ * @param length Byte count
+ */
+void json_writer_raw(json_writer_t *writer, const char *json, size_t length);
+
+// Key plus value in one call
+void json_writer_field_string(json_writer_t *writer, const char *key, const char *value);
+void json_writer_field_int(json_writer_t *writer, const char *key, int64_t value);
+void json_writer_field_uint(json_writer_t *writer, const char *key, uint64_t value);
+void json_writer_field_bool(json_writer_t *writer, const char *key, bool value);
+void json_writer_field_null(json_writer_t *writer, const char *key);
+void json_writer_field_fixed(json_writer_t *writer, const char *key, double value, uint8_t decimals);
+void json_writer_field_double(json_writer_t *writer, const char *key, double value, uint8_t precision);
+void json_writer_field_hex(json_writer_t *writer, const char *key, uint32_t value, uint8_t digits);
+
+/**
+ * @brief First error of the document so far
+ * @param writer Writer
+ * @return HAL_STATUS_OK, HAL_STATUS_NO_MEMORY (out of space or memory) or HAL_STATUS_INVALID_STATE (misuse)
+ */
+hal_status_t json_writer_status(const json_writer_t *writer);
+
+/**
+ * @brief The finished document
+ * @param writer Writer
+ * @param length Output byte count (may be NULL)
+ * @return NUL-terminated JSON, or NULL after an error or while a container is still open
+ */
+const char *json_writer_data(const json_writer_t *writer, size_t *length);
+
+/**
+ * @brief Take a heap writer's finished document; the writer is left empty
+ * @param writer Writer
+ * @param length Output byte count (may be NULL)
+ * @return malloc'd JSON for the caller to free, NULL on error (the buffer is freed)
+ */
+char *json_writer_take(json_writer_t *writer, size_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JSON_WRITER_H
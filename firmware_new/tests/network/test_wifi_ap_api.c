@@ -317,7 +317,7 @@ static void test_wifi_ap_api_send_error_response(void) {
     test_assert(resp.status_code == 400, "wifi_ap_api_send_error_response_status", 
                 "Should set correct status code");
     
-    test_assert(strstr(resp.body, "success\": false") != NULL, "wifi_ap_api_send_error_response_success", 
+    test_assert(strstr(resp.body, "success\":false") != NULL, "wifi_ap_api_send_error_response_success", 
                 "Should set success to false");
     
     test_assert(strstr(resp.body, error_message) != NULL, "wifi_ap_api_send_error_response_message", 
@@ -378,7 +378,7 @@ static void test_handle_post_ap_start(void) {
     test_assert(resp.status_code == 200, "handle_post_ap_start_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_ap_start_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_ap_start_success", 
                 "Should return success response");
 }
 
@@ -401,7 +401,7 @@ static void test_handle_post_ap_stop(void) {
     test_assert(resp.status_code == 200, "handle_post_ap_stop_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_ap_stop_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_ap_stop_success", 
                 "Should return success response");
 }
 
@@ -422,7 +422,7 @@ static void test_handle_get_ap_status(void) {
     test_assert(resp.status_code == 200, "handle_get_ap_status_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_get_ap_status_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_get_ap_status_success", 
                 "Should return success response");
     
     test_assert(strstr(resp.body, "data") != NULL, "handle_get_ap_status_data", 
@@ -448,7 +448,7 @@ static void test_handle_get_ap_config(void) {
     test_assert(resp.status_code == 200, "handle_get_ap_config_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_get_ap_config_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_get_ap_config_success", 
                 "Should return success response");
     
     test_assert(strstr(resp.body, "data") != NULL, "handle_get_ap_config_data", 
@@ -476,7 +476,7 @@ static void test_handle_post_ap_config(void) {
     test_assert(resp.status_code == 200, "handle_post_ap_config_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_ap_config_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_ap_config_success", 
                 "Should return success response");
 }
 
@@ -497,7 +497,7 @@ static void test_handle_get_ap_clients(void) {
     test_assert(resp.status_code == 200, "handle_get_ap_clients_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_get_ap_clients_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_get_ap_clients_success", 
                 "Should return success response");
     
     test_assert(strstr(resp.body, "clients") != NULL, "handle_get_ap_clients_data", 
@@ -525,7 +525,7 @@ static void test_handle_post_ap_kick_client(void) {
     test_assert(resp.status_code == 200, "handle_post_ap_kick_client_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_ap_kick_client_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_ap_kick_client_success", 
                 "Should return success response");
 }
 
@@ -548,7 +548,7 @@ static void test_handle_get_ap_statistics(void) {
     test_assert(resp.status_code == 200, "handle_get_ap_statistics_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_get_ap_statistics_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_get_ap_statistics_success", 
                 "Should return success response");
     
     test_assert(strstr(resp.body, "data") != NULL, "handle_get_ap_statistics_data", 
@@ -574,7 +574,7 @@ static void test_handle_post_ap_statistics_reset(void) {
     test_assert(resp.status_code == 200, "handle_post_ap_statistics_reset_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_ap_statistics_reset_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_ap_statistics_reset_success", 
                 "Should return success response");
 }
 
@@ -599,7 +599,7 @@ static void test_handle_post_fallback_enable(void) {
     test_assert(resp.status_code == 200, "handle_post_fallback_enable_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_fallback_enable_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_fallback_enable_success", 
                 "Should return success response");
 }
 
@@ -620,7 +620,7 @@ static void test_handle_get_fallback_status(void) {
     test_assert(resp.status_code == 200, "handle_get_fallback_status_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_get_fallback_status_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_get_fallback_status_success", 
                 "Should return success response");
     
     test_assert(strstr(resp.body, "data") != NULL, "handle_get_fallback_status_data", 
@@ -646,7 +646,7 @@ static void test_handle_post_fallback_trigger(void) {
     test_assert(resp.status_code == 200, "handle_post_fallback_trigger_status", 
                 "Should return 200 status code");
     
-    test_assert(strstr(resp.body, "success\": true") != NULL, "handle_post_fallback_trigger_success", 
+    test_assert(strstr(resp.body, "success\":true") != NULL, "handle_post_fallback_trigger_success", 
                 "Should return success response");
 }
 
@@ -0,0 +1,220 @@
+/**
+ * @file bench_control_executor.c
+ * @brief Control cycle timing: polled control_loop_update() vs the fixed-rate executor
+ * @version 1.0.0
+ * @date 2025-02-26
+ * @team FW
+ *
+ * Runs the velocity loop for a fixed time two ways and reports the rate
+ * achieved and the cycle-to-cycle timing error:
+ *   polled   - control_loop_update() in a loop with a relative sleep of one
+ *              period, the best a polling caller can do; sleep overshoot and
+ *              the sample_time gate add up, so the rate drifts low
+ *   executor - control_executor on absolute CLOCK_MONOTONIC deadlines, with
+ *              SCHED_FIFO, pinning and mlockall where the process may
+ *
+ * Works unprivileged on a stock kernel; the executor then reports
+ * realtime=0 and its jitter is whatever CFS gives. Run as root (or with
+ * CAP_SYS_NICE and a memlock limit) to see the SCHED_FIFO numbers.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ * Exit code is non-zero if the executor ran no cycles.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "control_executor.h"
+#include "control_loop.h"
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_init_loop(uint32_t period_us) {
+    control_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.control_frequency = 1000000.0f / (float)period_us;
+    cfg.sample_time = (float)period_us / 1000000.0f;
+    cfg.velocity_pid.kp = 1.0f;
+    cfg.velocity_pid.ki = 0.1f;
+    cfg.velocity_pid.output_min = -1.0f;
+    cfg.velocity_pid.output_max = 1.0f;
+    cfg.velocity_pid.integral_min = -10.0f;
+    cfg.velocity_pid.integral_max = 10.0f;
+    cfg.profile.max_velocity = 1000.0f;
+    cfg.profile.max_acceleration = 500.0f;
+    cfg.profile.max_jerk = 100.0f;
+    cfg.profile.velocity_tolerance = 5.0f;
+    cfg.enable_limits = true;
+    (void)control_loop_init(&cfg);
+    (void)control_loop_set_mode(CONTROL_MODE_VELOCITY);
+    (void)control_loop_enable();
+    (void)control_loop_set_target_velocity(200.0f);
+}
+
+typedef struct {
+    uint64_t cycles;
+    double rate_hz;
+    double avg_us;          // Mean timing error per cycle
+    uint32_t p99_us;
+    uint32_t max_us;
+} bench_result_t;
+
+/**
+ * @brief Polled: update, then sleep one period relative to now
+ *
+ * The timing error of a cycle is how far its interval to the previous
+ * control cycle is from the period.
+ */
+static bench_result_t bench_polled(uint32_t period_us, uint32_t min_ms) {
+    bench_result_t r = {0};
+    uint64_t hist[CONTROL_EXECUTOR_HIST_BUCKETS] = {0};
+    uint64_t period_ns = (uint64_t)period_us * 1000ULL;
+    uint64_t error_sum = 0;
+    uint64_t error_max = 0;
+
+    bench_init_loop(period_us);
+    uint64_t start = bench_now_ns();
+    uint64_t end = start + (uint64_t)min_ms * 1000000ULL;
+    uint64_t last_cycle_ns = 0;
+    uint32_t last_count = 0;
+    struct timespec pause = { 0, (long)period_ns };
+
+    uint64_t now = start;
+    while (now < end) {
+        (void)control_loop_update();
+        control_status_t st;
+        (void)control_loop_get_status(&st);
+        now = bench_now_ns();
+        if (st.cycle_count != last_count) {
+            if (last_cycle_ns != 0) {
+                uint64_t interval = now - last_cycle_ns;
+                uint64_t error = interval > period_ns ? interval - period_ns : period_ns - interval;
+                error_sum += error;
+                error_max = error > error_max ? error : error_max;
+                uint64_t us = error / 1000ULL;
+                uint32_t b = us == 0 ? 0 : (uint32_t)(64 - __builtin_clzll(us));
+                hist[b < CONTROL_EXECUTOR_HIST_BUCKETS ? b : CONTROL_EXECUTOR_HIST_BUCKETS - 1U]++;
+                r.cycles++;
+            }
+            last_cycle_ns = now;
+            last_count = st.cycle_count;
+        }
+        nanosleep(&pause, NULL);
+        now = bench_now_ns();
+    }
+    (void)control_loop_deinit();
+
+    r.rate_hz = (double)r.cycles * 1e9 / (double)(now - start);
+    r.avg_us = r.cycles > 0 ? (double)error_sum / (double)r.cycles / 1000.0 : 0.0;
+    r.max_us = (uint32_t)(error_max / 1000ULL);
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS && r.cycles > 0; b++) {
+        seen += hist[b];
+        if (seen >= r.cycles - r.cycles / 100U) {
+            uint32_t limit = control_executor_bucket_limit_us(b);
+            r.p99_us = limit < r.max_us ? limit : r.max_us;
+            break;
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Executor: the timing error of a cycle is its wake-up time minus its deadline
+ */
+static bench_result_t bench_executor(const control_executor_config_t *config, uint32_t min_ms,
+                                     control_executor_stats_t *stats) {
+    bench_result_t r = {0};
+    bench_init_loop(config->period_us);
+    uint64_t start = bench_now_ns();
+    if (control_executor_start(config) == HAL_STATUS_OK) {
+        struct timespec run = { (time_t)(min_ms / 1000U), (long)(min_ms % 1000U) * 1000000L };
+        nanosleep(&run, NULL);
+        (void)control_executor_stop();
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+    (void)control_executor_get_stats(stats);
+    (void)control_loop_deinit();
+
+    r.cycles = stats->cycles;
+    r.rate_hz = (double)stats->cycles * 1e9 / (double)elapsed;
+    r.avg_us = stats->jitter_avg_us;
+    r.p99_us = stats->jitter_p99_us;
+    r.max_us = stats->jitter_max_us;
+    return r;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N] [--period-us N] [--priority N] [--cpu N]\n", prog);
+    printf("  --min-ms N     Run time per method (default 2000)\n");
+    printf("  --period-us N  Control period (default 1000)\n");
+    printf("  --priority N   SCHED_FIFO priority for the executor, 0 = normal (default 85)\n");
+    printf("  --cpu N        Pin the executor to CPU N, -1 auto, -2 none (default auto)\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 2000;
+    control_executor_config_t config;
+    (void)control_executor_get_default_config(&config);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--period-us") == 0 && i + 1 < argc) {
+            config.period_us = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--priority") == 0 && i + 1 < argc) {
+            config.priority = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            config.cpu = (int16_t)strtol(argv[++i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (config.period_us < CONTROL_EXECUTOR_MIN_PERIOD_US || config.period_us > CONTROL_EXECUTOR_MAX_PERIOD_US) {
+        printf("period must be %u..%u us\n", CONTROL_EXECUTOR_MIN_PERIOD_US, CONTROL_EXECUTOR_MAX_PERIOD_US);
+        return 1;
+    }
+
+    bench_result_t polled = bench_polled(config.period_us, min_ms);
+    control_executor_stats_t stats;
+    bench_result_t executor = bench_executor(&config, min_ms, &stats);
+
+    printf("Control cycle timing, period %u us (%.0f Hz), %u ms per method\n", config.period_us,
+           1e6 / (double)config.period_us, min_ms);
+    printf("executor: realtime=%d memory_locked=%d cpu=%d overruns=%llu missed=%llu\n", stats.realtime,
+           stats.memory_locked, stats.cpu, (unsigned long long)stats.overruns,
+           (unsigned long long)stats.missed_deadlines);
+    printf("%-9s %9s %10s %10s %9s %9s\n", "method", "cycles", "rate Hz", "avg us", "p99 us", "max us");
+    printf("%-9s %9llu %10.1f %10.1f %9u %9u\n", "polled", (unsigned long long)polled.cycles, polled.rate_hz,
+           polled.avg_us, polled.p99_us, polled.max_us);
+    printf("%-9s %9llu %10.1f %10.1f %9u %9u\n", "executor", (unsigned long long)executor.cycles,
+           executor.rate_hz, executor.avg_us, executor.p99_us, executor.max_us);
+    printf("executor jitter histogram (upper edge us: count):");
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        if (stats.jitter_hist[b] > 0) {
+            uint32_t limit = control_executor_bucket_limit_us(b);
+            if (limit == UINT32_MAX) {
+                printf(" inf:%llu", (unsigned long long)stats.jitter_hist[b]);
+            } else {
+                printf(" %u:%llu", limit, (unsigned long long)stats.jitter_hist[b]);
+            }
+        }
+    }
+    printf("\n");
+
+    int rc = executor.cycles > 0 ? 0 : 1;
+    printf("BENCH_CONTROL_EXECUTOR period_us=%u polled_hz=%.1f polled_avg_us=%.1f polled_p99_us=%u polled_max_us=%u"
+           " executor_hz=%.1f executor_avg_us=%.1f executor_p99_us=%u executor_max_us=%u overruns=%llu realtime=%d\n",
+           config.period_us, polled.rate_hz, polled.avg_us, polled.p99_us, polled.max_us, executor.rate_hz,
+           executor.avg_us, executor.p99_us, executor.max_us, (unsigned long long)stats.overruns, stats.realtime);
+    return rc;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file bench_hal_reactor.c
+ * @brief Event-to-reaction latency and wakeups: sleep-polling main loop vs hal_reactor
+ * @version 1.0.0
+ * @date 2025-02-28
+ * @team FW
+ *
+ * A producer thread raises an event every --gap-ms (as a completed Modbus
+ * poll or an E-Stop edge would) and the main thread reacts to it:
+ *   polling   the old main loop: check a flag, then hal_sleep_ms(--poll-ms)
+ *   reactor   an event task run by hal_reactor_signal(), next to a periodic
+ *             task of the same --poll-ms period
+ *
+ * Reported per mode: mean, p99 and max latency from the event to the
+ * reaction, and main-thread wakeups per second.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "hal_common.h"
+#include "hal_reactor.h"
+
+#define BENCH_MAX_EVENTS 8192U
+
+typedef struct {
+    uint32_t min_ms;
+    uint32_t gap_ms;
+    bool use_reactor;
+    int event_task;
+    uint64_t pending_us;            // Event time, 0 when consumed (atomic)
+    int done;                       // Producer finished (atomic)
+} bench_ctx_t;
+
+typedef struct {
+    uint32_t latency_us[BENCH_MAX_EVENTS];
+    uint32_t count;
+    uint64_t wakeups;
+    uint64_t elapsed_us;
+} bench_result_t;
+
+static bench_result_t g_result;
+
+static void *producer(void *arg) {
+    bench_ctx_t *ctx = (bench_ctx_t *)arg;
+    uint64_t end = hal_time_now_ms() + ctx->min_ms;
+    while (hal_time_now_ms() < end) {
+        usleep(ctx->gap_ms * 1000U);
+        uint64_t expected = 0;
+        uint64_t now = hal_time_now_us();
+        // Skip if the previous event has not been seen yet
+        if (__atomic_compare_exchange_n(&ctx->pending_us, &expected, now, false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED) && ctx->use_reactor) {
+            (void)hal_reactor_signal(ctx->event_task);
+        }
+    }
+    __atomic_store_n(&ctx->done, 1, __ATOMIC_RELEASE);
+    if (ctx->use_reactor) {
+        hal_reactor_stop();
+    }
+    return NULL;
+}
+
+static void consume(bench_ctx_t *ctx) {
+    uint64_t stamp = __atomic_exchange_n(&ctx->pending_us, 0, __ATOMIC_ACQUIRE);
+    if (stamp != 0 && g_result.count < BENCH_MAX_EVENTS) {
+        g_result.latency_us[g_result.count++] = (uint32_t)(hal_time_now_us() - stamp);
+    }
+}
+
+static void event_task(void *context) {
+    consume((bench_ctx_t *)context);
+}
+
+static void periodic_task(void *context) {
+    (void)context;
+}
+
+/**
+ * @brief Run one mode and fill g_result
+ * @param ctx Benchmark settings; use_reactor selects the mode
+ * @param poll_ms Polling sleep, or the reactor's periodic task period
+ * @return 0 on success
+ */
+static int bench_run(bench_ctx_t *ctx, uint32_t poll_ms) {
+    memset(&g_result, 0, sizeof(g_result));
+    ctx->pending_us = 0;
+    ctx->done = 0;
+
+    if (ctx->use_reactor) {
+        if (hal_reactor_init() != HAL_STATUS_OK ||
+            hal_reactor_add_periodic("loop", poll_ms, periodic_task, NULL, NULL) != HAL_STATUS_OK ||
+            hal_reactor_add_event("event", event_task, ctx, &ctx->event_task) != HAL_STATUS_OK) {
+            return 1;
+        }
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, producer, ctx) != 0) {
+        return 1;
+    }
+    uint64_t start = hal_time_now_us();
+    if (ctx->use_reactor) {
+        (void)hal_reactor_run();
+        hal_reactor_stats_t stats;
+        (void)hal_reactor_get_stats(&stats);
+        g_result.wakeups = stats.wakeups;
+    } else {
+        while (!__atomic_load_n(&ctx->done, __ATOMIC_ACQUIRE)) {
+            consume(ctx);
+            hal_sleep_ms(poll_ms);
+            g_result.wakeups++;
+        }
+    }
+    g_result.elapsed_us = hal_time_now_us() - start;
+    pthread_join(thread, NULL);
+    if (ctx->use_reactor) {
+        (void)hal_reactor_deinit();
+    }
+    return g_result.count > 0 ? 0 : 1;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    double mean_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+    double wakeups_per_s;
+} bench_summary_t;
+
+static bench_summary_t summarize(void) {
+    bench_summary_t s = {0};
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < g_result.count; i++) {
+        sum += g_result.latency_us[i];
+    }
+    qsort(g_result.latency_us, g_result.count, sizeof(uint32_t), compare_u32);
+    s.mean_us = (double)sum / (double)g_result.count;
+    s.p99_us = g_result.latency_us[(g_result.count * 99U) / 100U];
+    s.max_us = g_result.latency_us[g_result.count - 1U];
+    s.wakeups_per_s = (double)g_result.wakeups * 1e6 / (double)g_result.elapsed_us;
+    return s;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N] [--gap-ms N] [--poll-ms N]\n", prog);
+    printf("  --min-ms N   Run time per mode (default 2000)\n");
+    printf("  --gap-ms N   Time between events (default 13)\n");
+    printf("  --poll-ms N  Polling loop sleep / periodic task period (default 50)\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 2000;
+    uint32_t gap_ms = 13;
+    uint32_t poll_ms = 50;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--gap-ms") == 0 && i + 1 < argc) {
+            gap_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--poll-ms") == 0 && i + 1 < argc) {
+            poll_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (gap_ms == 0 || poll_ms == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    bench_ctx_t ctx = { .min_ms = min_ms, .gap_ms = gap_ms, .event_task = -1 };
+
+    ctx.use_reactor = false;
+    if (bench_run(&ctx, poll_ms) != 0) {
+        fprintf(stderr, "polling run failed\n");
+        return 1;
+    }
+    bench_summary_t poll = summarize();
+
+    ctx.use_reactor = true;
+    if (bench_run(&ctx, poll_ms) != 0) {
+        fprintf(stderr, "reactor run failed\n");
+        return 1;
+    }
+    bench_summary_t reactor = summarize();
+
+    printf("Event reaction, %u ms per mode, event every %u ms, loop period %u ms\n", min_ms, gap_ms, poll_ms);
+    printf("%-8s %10s %10s %10s %10s\n", "mode", "mean_us", "p99_us", "max_us", "wakeups/s");
+    printf("%-8s %10.1f %10u %10u %10.1f\n", "polling", poll.mean_us, poll.p99_us, poll.max_us,
+           poll.wakeups_per_s);
+    printf("%-8s %10.1f %10u %10u %10.1f\n", "reactor", reactor.mean_us, reactor.p99_us, reactor.max_us,
+           reactor.wakeups_per_s);
+
+    int rc = reactor.mean_us < poll.mean_us ? 0 : 1;
+    printf("BENCH_HAL_REACTOR poll_mean_us=%.1f poll_p99_us=%u reactor_mean_us=%.1f reactor_p99_us=%u "
+           "poll_wakeups_s=%.1f reactor_wakeups_s=%.1f\n",
+           poll.mean_us, poll.p99_us, reactor.mean_us, reactor.p99_us, poll.wakeups_per_s,
+           reactor.wakeups_per_s);
+    return rc;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_hal_time.c
+ * @brief Cost of a timestamp: gettimeofday vs the hal_time clocks and the latched tick
+ * @version 1.0.0
+ * @date 2025-02-27
+ * @team FW
+ *
+ * Each method is called in a tight loop for at least --min-ms and the mean
+ * cost per call is reported:
+ *   gettimeofday  what the private *_get_timestamp_* helpers used to do
+ *   monotonic     hal_time_now_us(), CLOCK_MONOTONIC through the vDSO
+ *   coarse        hal_time_coarse_ms(), CLOCK_MONOTONIC_COARSE
+ *   wall          hal_time_wall_ms(), CLOCK_REALTIME (reporting only)
+ *   tick          hal_time_tick_us(), the value latched once per loop tick
+ *
+ * On kernels or architectures without a vDSO clock (or in some VMs with an
+ * unstable TSC) the clock_gettime numbers include a real system call; the
+ * tick read never does.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "hal_time.h"
+
+#define BENCH_BATCH 4096U
+
+typedef uint64_t (*bench_clock_fn_t)(void);
+
+static uint64_t bench_gettimeofday_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+/**
+ * @brief Mean nanoseconds per call of a clock function
+ * @param fn Clock function
+ * @param min_ms Minimum run time
+ * @param sink Accumulates results so the calls are not optimised away
+ * @return Nanoseconds per call
+ */
+static double bench_clock(bench_clock_fn_t fn, uint32_t min_ms, volatile uint64_t *sink) {
+    uint64_t calls = 0;
+    uint64_t acc = 0;
+    uint64_t start = hal_time_now_ns();
+    uint64_t end = start + (uint64_t)min_ms * 1000000ULL;
+    uint64_t now = start;
+    while (now < end) {
+        for (uint32_t i = 0; i < BENCH_BATCH; i++) {
+            acc += fn();
+        }
+        calls += BENCH_BATCH;
+        now = hal_time_now_ns();
+    }
+    *sink += acc;
+    return (double)(now - start) / (double)calls;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N]\n", prog);
+    printf("  --min-ms N  Run time per method (default 500)\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 500;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    volatile uint64_t sink = 0;
+    (void)hal_time_tick();
+    double gtod_ns = bench_clock(bench_gettimeofday_us, min_ms, &sink);
+    double mono_ns = bench_clock(hal_time_now_us, min_ms, &sink);
+    double coarse_ns = bench_clock(hal_time_coarse_ms, min_ms, &sink);
+    double wall_ns = bench_clock(hal_time_wall_ms, min_ms, &sink);
+    double tick_ns = bench_clock(hal_time_tick_us, min_ms, &sink);
+
+    printf("Timestamp cost, %u ms per method, coarse resolution %llu ns\n", min_ms,
+           (unsigned long long)hal_time_coarse_resolution_ns());
+    printf("%-13s %10s %10s\n", "method", "ns/call", "vs gtod");
+    printf("%-13s %10.1f %10.2f\n", "gettimeofday", gtod_ns, 1.0);
+    printf("%-13s %10.1f %10.2f\n", "monotonic", mono_ns, mono_ns / gtod_ns);
+    printf("%-13s %10.1f %10.2f\n", "coarse", coarse_ns, coarse_ns / gtod_ns);
+    printf("%-13s %10.1f %10.2f\n", "wall", wall_ns, wall_ns / gtod_ns);
+    printf("%-13s %10.1f %10.2f\n", "tick", tick_ns, tick_ns / gtod_ns);
+
+    int rc = (sink != 0 && tick_ns <= mono_ns) ? 0 : 1;
+    printf("BENCH_HAL_TIME gettimeofday_ns=%.1f monotonic_ns=%.1f coarse_ns=%.1f wall_ns=%.1f tick_ns=%.1f\n",
+           gtod_ns, mono_ns, coarse_ns, wall_ns, tick_ns);
+    return rc;
+}
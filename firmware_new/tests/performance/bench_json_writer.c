@@ -0,0 +1,376 @@
+/**
+ * @file bench_json_writer.c
+ * @brief Response build throughput and heap churn: snprintf builders vs json_writer
+ * @version 1.0.0
+ * @date 2025-03-01
+ * @team FW
+ *
+ * Three payloads shaped like the API's heaviest responses:
+ *   lidar      720 scan points {"distance","angle","quality"}
+ *   registers  64 register entries with "0x%04X" addresses and names
+ *   telemetry  a record of 48 two-decimal floats
+ *
+ * Each is built --min-ms long by two builders:
+ *   snprintf   the old handlers: malloc, pos += snprintf(...), realloc on
+ *              growth, then a strdup copy for the response body
+ *   writer     json_writer in a per-request arena that is reset, not freed
+ *
+ * Reported per payload and builder: MB/s of JSON produced, responses per
+ * second and heap allocations per response.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hal_common.h"
+#include "json_writer.h"
+
+#define BENCH_LIDAR_POINTS      720U
+#define BENCH_REGISTERS         64U
+#define BENCH_TELEMETRY_FLOATS  48U
+
+typedef enum {
+    PAYLOAD_LIDAR = 0,
+    PAYLOAD_REGISTERS,
+    PAYLOAD_TELEMETRY,
+    PAYLOAD_COUNT
+} payload_t;
+
+static const char *const g_payload_names[PAYLOAD_COUNT] = { "lidar", "registers", "telemetry" };
+
+typedef struct {
+    uint16_t distance[BENCH_LIDAR_POINTS];
+    int16_t angle[BENCH_LIDAR_POINTS];
+    uint8_t quality[BENCH_LIDAR_POINTS];
+    uint16_t reg_addr[BENCH_REGISTERS];
+    uint16_t reg_value[BENCH_REGISTERS];
+    char reg_name[BENCH_REGISTERS][24];
+    float telemetry[BENCH_TELEMETRY_FLOATS];
+} bench_input_t;
+
+static bench_input_t g_in;
+
+typedef struct {
+    double mb_per_s;
+    double responses_per_s;
+    double allocs_per_response;
+    size_t bytes;                   // Size of one response
+} bench_summary_t;
+
+// ---------------------------------------------------------------------------
+// snprintf builder, as the handlers were written
+
+typedef struct {
+    char *buf;
+    size_t pos;
+    size_t cap;
+    uint32_t allocs;
+} legacy_buf_t;
+
+static bool legacy_reserve(legacy_buf_t *b, size_t need) {
+    if (b->pos + need < b->cap) {
+        return true;
+    }
+    size_t ns = b->cap * 2;
+    while (b->pos + need >= ns) {
+        ns *= 2;
+    }
+    char *t = (char *)realloc(b->buf, ns);
+    if (t == NULL) {
+        return false;
+    }
+    b->buf = t;
+    b->cap = ns;
+    b->allocs++;
+    return true;
+}
+
+#define LEGACY_APPEND(b, need, ...)                                                     \
+    do {                                                                                \
+        if (!legacy_reserve((b), (need))) {                                             \
+            free((b)->buf);                                                             \
+            return NULL;                                                                \
+        }                                                                               \
+        (b)->pos += (size_t)snprintf((b)->buf + (b)->pos, (b)->cap - (b)->pos, __VA_ARGS__); \
+    } while (0)
+
+/**
+ * @brief Build one payload the old way
+ * @return strdup'd response body (caller frees), NULL on allocation failure
+ */
+static char *legacy_build(payload_t payload, uint32_t *allocs) {
+    legacy_buf_t b = { .cap = 1024 };
+    b.buf = (char *)malloc(b.cap);
+    if (b.buf == NULL) {
+        return NULL;
+    }
+    b.allocs = 1;
+
+    switch (payload) {
+    case PAYLOAD_LIDAR:
+        LEGACY_APPEND(&b, 128, "{\"success\":true,\"data\":{\"scan_complete\":%s,\"point_count\":%u,\"points\":[",
+                      "true", BENCH_LIDAR_POINTS);
+        for (uint32_t i = 0; i < BENCH_LIDAR_POINTS; i++) {
+            LEGACY_APPEND(&b, 64, "%s{\"distance\":%u,\"angle\":%d,\"quality\":%u}", i > 0 ? "," : "",
+                          g_in.distance[i], g_in.angle[i], g_in.quality[i]);
+        }
+        LEGACY_APPEND(&b, 8, "]}}");
+        break;
+    case PAYLOAD_REGISTERS:
+        LEGACY_APPEND(&b, 128, "{\"success\":true,\"data\":{\"module_addr\":%d,\"register_count\":%u,\"registers\":[",
+                      2, BENCH_REGISTERS);
+        for (uint32_t i = 0; i < BENCH_REGISTERS; i++) {
+            LEGACY_APPEND(&b, 160, "%s{\"address\":\"0x%04X\",\"name\":\"%s\",\"mode\":\"%s\",\"data_type\":\"%s\",\"value\":%d}",
+                          i > 0 ? "," : "", g_in.reg_addr[i], g_in.reg_name[i], "READ", "UINT16",
+                          g_in.reg_value[i]);
+        }
+        LEGACY_APPEND(&b, 8, "]}}");
+        break;
+    case PAYLOAD_TELEMETRY:
+        LEGACY_APPEND(&b, 64, "{\"success\":true,\"data\":{");
+        for (uint32_t i = 0; i < BENCH_TELEMETRY_FLOATS; i++) {
+            LEGACY_APPEND(&b, 48, "%s\"f%02u\":%.2f", i > 0 ? "," : "", i, g_in.telemetry[i]);
+        }
+        LEGACY_APPEND(&b, 8, "}}");
+        break;
+    default:
+        break;
+    }
+
+    // The response path copied the finished body
+    char *body = strdup(b.buf);
+    free(b.buf);
+    *allocs += b.allocs + 1U;
+    return body;
+}
+
+// ---------------------------------------------------------------------------
+// json_writer builder, as the handlers are written now
+
+static const char *writer_build(json_arena_t *arena, payload_t payload, size_t *length) {
+    static const char *const keys[BENCH_TELEMETRY_FLOATS] = {
+        "f00", "f01", "f02", "f03", "f04", "f05", "f06", "f07", "f08", "f09", "f10", "f11",
+        "f12", "f13", "f14", "f15", "f16", "f17", "f18", "f19", "f20", "f21", "f22", "f23",
+        "f24", "f25", "f26", "f27", "f28", "f29", "f30", "f31", "f32", "f33", "f34", "f35",
+        "f36", "f37", "f38", "f39", "f40", "f41", "f42", "f43", "f44", "f45", "f46", "f47",
+    };
+    json_writer_t w;
+
+    json_arena_reset(arena);
+    if (json_writer_init_arena(&w, arena, 1024) != HAL_STATUS_OK) {
+        return NULL;
+    }
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+
+    switch (payload) {
+    case PAYLOAD_LIDAR:
+        json_writer_field_bool(&w, "scan_complete", true);
+        json_writer_field_uint(&w, "point_count", BENCH_LIDAR_POINTS);
+        json_writer_key(&w, "points");
+        json_writer_begin_array(&w);
+        for (uint32_t i = 0; i < BENCH_LIDAR_POINTS; i++) {
+            json_writer_begin_object(&w);
+            json_writer_field_uint(&w, "distance", g_in.distance[i]);
+            json_writer_field_int(&w, "angle", g_in.angle[i]);
+            json_writer_field_uint(&w, "quality", g_in.quality[i]);
+            json_writer_end_object(&w);
+        }
+        json_writer_end_array(&w);
+        break;
+    case PAYLOAD_REGISTERS:
+        json_writer_field_int(&w, "module_addr", 2);
+        json_writer_field_uint(&w, "register_count", BENCH_REGISTERS);
+        json_writer_key(&w, "registers");
+        json_writer_begin_array(&w);
+        for (uint32_t i = 0; i < BENCH_REGISTERS; i++) {
+            json_writer_begin_object(&w);
+            json_writer_field_hex(&w, "address", g_in.reg_addr[i], 4);
+            json_writer_field_string(&w, "name", g_in.reg_name[i]);
+            json_writer_field_string(&w, "mode", "READ");
+            json_writer_field_string(&w, "data_type", "UINT16");
+            json_writer_field_int(&w, "value", g_in.reg_value[i]);
+            json_writer_end_object(&w);
+        }
+        json_writer_end_array(&w);
+        break;
+    case PAYLOAD_TELEMETRY:
+        for (uint32_t i = 0; i < BENCH_TELEMETRY_FLOATS; i++) {
+            json_writer_field_fixed(&w, keys[i], g_in.telemetry[i], 2);
+        }
+        break;
+    default:
+        break;
+    }
+
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+    return json_writer_data(&w, length);
+}
+
+// ---------------------------------------------------------------------------
+
+static void fill_input(void) {
+    uint32_t seed = 12345U;
+    for (uint32_t i = 0; i < BENCH_LIDAR_POINTS; i++) {
+        seed = seed * 1103515245U + 12345U;
+        g_in.distance[i] = (uint16_t)(150U + (seed >> 16) % 12000U);
+        g_in.angle[i] = (int16_t)((i * 360U) / BENCH_LIDAR_POINTS);
+        g_in.quality[i] = (uint8_t)((seed >> 8) & 0x3FU);
+    }
+    for (uint32_t i = 0; i < BENCH_REGISTERS; i++) {
+        seed = seed * 1103515245U + 12345U;
+        g_in.reg_addr[i] = (uint16_t)(0x0100U + i);
+        g_in.reg_value[i] = (uint16_t)(seed >> 16);
+        snprintf(g_in.reg_name[i], sizeof(g_in.reg_name[i]), "Register_%02u_Value", i);
+    }
+    for (uint32_t i = 0; i < BENCH_TELEMETRY_FLOATS; i++) {
+        seed = seed * 1103515245U + 12345U;
+        g_in.telemetry[i] = (float)((seed >> 12) % 200000U) / 100.0f - 1000.0f;
+    }
+}
+
+static bench_summary_t summarize(uint64_t bytes, uint64_t responses, uint64_t allocs, uint64_t elapsed_us,
+                                 size_t one_size) {
+    bench_summary_t s = {0};
+    double seconds = (double)elapsed_us / 1e6;
+    s.mb_per_s = (double)bytes / seconds / 1e6;
+    s.responses_per_s = (double)responses / seconds;
+    s.allocs_per_response = (double)allocs / (double)responses;
+    s.bytes = one_size;
+    return s;
+}
+
+/**
+ * @brief Build one payload with the snprintf builder for min_ms
+ * @return 0 on success
+ */
+static int run_legacy(payload_t payload, uint32_t min_ms, bench_summary_t *out) {
+    uint64_t bytes = 0;
+    uint64_t responses = 0;
+    uint32_t allocs = 0;
+    size_t one_size = 0;
+    uint64_t start = hal_time_now_us();
+    uint64_t end = start + (uint64_t)min_ms * 1000U;
+    uint64_t now = start;
+
+    while (now < end) {
+        for (uint32_t i = 0; i < 64U; i++) {
+            char *body = legacy_build(payload, &allocs);
+            if (body == NULL) {
+                return 1;
+            }
+            one_size = strlen(body);
+            bytes += one_size;
+            free(body);
+        }
+        responses += 64U;
+        now = hal_time_now_us();
+    }
+    *out = summarize(bytes, responses, allocs, now - start, one_size);
+    return 0;
+}
+
+/**
+ * @brief Build one payload with json_writer for min_ms
+ * @return 0 on success
+ */
+static int run_writer(payload_t payload, uint32_t min_ms, bench_summary_t *out) {
+    json_arena_t arena;
+    json_arena_stats_t before;
+    json_arena_stats_t after;
+    uint64_t bytes = 0;
+    uint64_t responses = 0;
+    size_t one_size = 0;
+
+    json_arena_init(&arena, 0);
+    // One warm-up response sizes the arena, as the first request on a worker does
+    if (writer_build(&arena, payload, &one_size) == NULL) {
+        json_arena_destroy(&arena);
+        return 1;
+    }
+    (void)json_arena_get_stats(&arena, &before);
+
+    uint64_t start = hal_time_now_us();
+    uint64_t end = start + (uint64_t)min_ms * 1000U;
+    uint64_t now = start;
+    while (now < end) {
+        for (uint32_t i = 0; i < 64U; i++) {
+            if (writer_build(&arena, payload, &one_size) == NULL) {
+                json_arena_destroy(&arena);
+                return 1;
+            }
+            bytes += one_size;
+        }
+        responses += 64U;
+        now = hal_time_now_us();
+    }
+    (void)json_arena_get_stats(&arena, &after);
+    json_arena_destroy(&arena);
+    *out = summarize(bytes, responses, after.heap_allocs - before.heap_allocs, now - start, one_size);
+    return 0;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N]\n", prog);
+    printf("  --min-ms N   Run time per payload and builder (default 1000)\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 1000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (min_ms == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    fill_input();
+
+    bench_summary_t legacy[PAYLOAD_COUNT];
+    bench_summary_t writer[PAYLOAD_COUNT];
+    for (int p = 0; p < PAYLOAD_COUNT; p++) {
+        if (run_legacy((payload_t)p, min_ms, &legacy[p]) != 0 || run_writer((payload_t)p, min_ms, &writer[p]) != 0) {
+            fprintf(stderr, "%s run failed\n", g_payload_names[p]);
+            return 1;
+        }
+    }
+
+    printf("JSON response build, %u ms per payload and builder\n", min_ms);
+    printf("%-10s %-9s %8s %10s %12s %12s\n", "payload", "builder", "bytes", "MB/s", "resp/s", "allocs/resp");
+    int rc = 0;
+    for (int p = 0; p < PAYLOAD_COUNT; p++) {
+        printf("%-10s %-9s %8zu %10.1f %12.0f %12.2f\n", g_payload_names[p], "snprintf", legacy[p].bytes,
+               legacy[p].mb_per_s, legacy[p].responses_per_s, legacy[p].allocs_per_response);
+        printf("%-10s %-9s %8zu %10.1f %12.0f %12.2f\n", g_payload_names[p], "writer", writer[p].bytes,
+               writer[p].mb_per_s, writer[p].responses_per_s, writer[p].allocs_per_response);
+        if (writer[p].allocs_per_response >= legacy[p].allocs_per_response) {
+            rc = 1;
+        }
+    }
+
+    printf("BENCH_JSON_WRITER lidar_snprintf_mbs=%.1f lidar_writer_mbs=%.1f registers_snprintf_mbs=%.1f "
+           "registers_writer_mbs=%.1f telemetry_snprintf_mbs=%.1f telemetry_writer_mbs=%.1f "
+           "snprintf_allocs=%.2f writer_allocs=%.2f\n",
+           legacy[PAYLOAD_LIDAR].mb_per_s, writer[PAYLOAD_LIDAR].mb_per_s,
+           legacy[PAYLOAD_REGISTERS].mb_per_s, writer[PAYLOAD_REGISTERS].mb_per_s,
+           legacy[PAYLOAD_TELEMETRY].mb_per_s, writer[PAYLOAD_TELEMETRY].mb_per_s,
+           (legacy[PAYLOAD_LIDAR].allocs_per_response + legacy[PAYLOAD_REGISTERS].allocs_per_response +
+            legacy[PAYLOAD_TELEMETRY].allocs_per_response) / 3.0,
+           (writer[PAYLOAD_LIDAR].allocs_per_response + writer[PAYLOAD_REGISTERS].allocs_per_response +
+            writer[PAYLOAD_TELEMETRY].allocs_per_response) / 3.0);
+    return rc;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file bench_lidar_framer.c
+ * @brief Throughput benchmark of the RPLIDAR stream framer
+ * @version 1.0.0
+ * @date 2025-02-20
+ * @team EMBED
+ *
+ * Feeds a standard-scan capture through the framer in read-sized chunks
+ * and reports points/s. Without --capture a synthetic capture is built:
+ * a response descriptor followed by 10 kHz revolutions of 500 nodes with
+ * some zero-distance returns. --corrupt N flips a check bit in one node of
+ * every N so the resync path is measured as well.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ * Exit code is non-zero if the framer decodes a clean capture wrongly.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_lidar_framer.h"
+
+#define BENCH_REVOLUTIONS       200
+#define BENCH_NODES_PER_REV     500
+
+static const size_t g_chunks[] = { 1, 32, 512, 4096 };
+#define BENCH_CHUNK_COUNT   (sizeof(g_chunks) / sizeof(g_chunks[0]))
+
+static lidar_scan_data_t g_buffers[2];
+static int g_next_buffer;
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static lidar_scan_data_t *bench_on_revolution(void *ctx, lidar_scan_data_t *scan) {
+    (void)ctx;
+    (void)scan;
+    g_next_buffer ^= 1;
+    return &g_buffers[g_next_buffer];
+}
+
+/**
+ * @brief Build a synthetic standard-scan capture
+ * @return Capture length in bytes
+ */
+static size_t bench_build_capture(uint8_t *out, uint32_t corrupt_every) {
+    static const uint8_t descriptor[] = { 0xA5, 0x5A, 0x05, 0x00, 0x00, 0x40, 0x81 };
+    size_t len = 0;
+    uint32_t x = 1;
+
+    memcpy(out, descriptor, sizeof(descriptor));
+    len += sizeof(descriptor);
+    for (uint32_t r = 0; r < BENCH_REVOLUTIONS; r++) {
+        for (uint32_t i = 0; i < BENCH_NODES_PER_REV; i++) {
+            x = x * 1103515245U + 12345U;
+            uint32_t angle_q6 = i * 360U * 64U / BENCH_NODES_PER_REV;
+            uint32_t distance_q2 = ((x >> 16) % 20U == 0) ? 0 : (150U + (x >> 16) % 12000U) * 4U;
+            uint8_t *node = &out[len];
+            node[0] = (uint8_t)((47U << 2) | (i == 0 ? 0x01U : 0x02U));
+            node[1] = (uint8_t)(((angle_q6 & 0x7FU) << 1) | 0x01U);
+            node[2] = (uint8_t)(angle_q6 >> 7);
+            node[3] = (uint8_t)(distance_q2 & 0xFFU);
+            node[4] = (uint8_t)(distance_q2 >> 8);
+            if (corrupt_every > 0 && (r * BENCH_NODES_PER_REV + i) % corrupt_every == corrupt_every - 1) {
+                node[1] &= (uint8_t)~0x01U;
+            }
+            len += LIDAR_FRAMER_NODE_SIZE;
+        }
+    }
+    return len;
+}
+
+static uint8_t *bench_load_capture(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = size > 0 ? malloc((size_t)size) : NULL;
+    if (data != NULL && fread(data, 1, (size_t)size, f) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *len = data != NULL ? (size_t)size : 0;
+    return data;
+}
+
+/**
+ * @brief Feed the whole capture in chunk-sized reads until min_ms has passed
+ * @return Points per second; framer statistics of the last pass in stats
+ */
+static double bench_framer(const uint8_t *data, size_t len, size_t chunk, uint32_t min_ms,
+                           lidar_framer_stats_t *stats) {
+    static lidar_framer_t framer;
+    uint64_t points = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed = 0;
+    uint64_t rx_time_us = 0;
+
+    do {
+        g_next_buffer = 0;
+        lidar_framer_init(&framer, 100, bench_on_revolution, NULL, &g_buffers[0]);
+        for (size_t pos = 0; pos < len; pos += chunk) {
+            size_t n = (len - pos < chunk) ? len - pos : chunk;
+            rx_time_us += 100;
+            lidar_framer_feed(&framer, &data[pos], n, rx_time_us);
+        }
+        lidar_framer_get_stats(&framer, stats);
+        points += stats->points;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000000ULL);
+
+    return (double)points * 1e9 / (double)elapsed;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N] [--corrupt N] [--capture FILE]\n", prog);
+    printf("  --min-ms N       Minimum time per chunk size (default 200)\n");
+    printf("  --corrupt N      Break the check bit of one node in every N (synthetic only)\n");
+    printf("  --capture FILE   Raw bytes recorded from the sensor's serial port\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 200;
+    uint32_t corrupt_every = 0;
+    const char *capture = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--corrupt") == 0 && i + 1 < argc) {
+            corrupt_every = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capture = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    uint8_t *data = NULL;
+    size_t len = 0;
+    if (capture != NULL) {
+        data = bench_load_capture(capture, &len);
+        if (data == NULL) {
+            printf("BENCH_LIDAR_FRAMER FAILED: cannot read %s\n", capture);
+            return 1;
+        }
+    } else {
+        data = malloc(8 + (size_t)BENCH_REVOLUTIONS * BENCH_NODES_PER_REV * LIDAR_FRAMER_NODE_SIZE);
+        if (data == NULL) {
+            return 1;
+        }
+        len = bench_build_capture(data, corrupt_every);
+    }
+
+    printf("LiDAR framer: %zu bytes from %s\n", len, capture != NULL ? capture : "synthetic capture");
+    printf("%8s %14s %10s %10s %10s %10s\n", "chunk", "points/s", "revs", "resyncs", "discarded", "invalid");
+
+    double pps[BENCH_CHUNK_COUNT];
+    lidar_framer_stats_t stats[BENCH_CHUNK_COUNT];
+    int rc = 0;
+    for (size_t c = 0; c < BENCH_CHUNK_COUNT; c++) {
+        pps[c] = bench_framer(data, len, g_chunks[c], min_ms, &stats[c]);
+        printf("%8zu %14.0f %10llu %10llu %10llu %10llu\n", g_chunks[c], pps[c],
+               (unsigned long long)stats[c].revolutions, (unsigned long long)stats[c].resyncs,
+               (unsigned long long)stats[c].discarded_bytes, (unsigned long long)stats[c].invalid_points);
+
+        // Every read size must frame the capture identically
+        if (memcmp(&stats[c], &stats[0], sizeof(stats[0])) != 0) {
+            printf("MISMATCH: chunk %zu frames differently from chunk %zu\n", g_chunks[c], g_chunks[0]);
+            rc = 1;
+        }
+    }
+    if (capture == NULL && corrupt_every == 0 &&
+        (stats[0].revolutions != BENCH_REVOLUTIONS - 1 || stats[0].resyncs != 0)) {
+        printf("MISMATCH: expected %d revolutions, got %llu\n", BENCH_REVOLUTIONS - 1,
+               (unsigned long long)stats[0].revolutions);
+        rc = 1;
+    }
+    free(data);
+
+    printf("BENCH_LIDAR_FRAMER chunk1_pps=%.0f chunk512_pps=%.0f chunk4096_pps=%.0f revolutions=%llu resyncs=%llu mismatches=%d\n",
+           pps[0], pps[2], pps[3], (unsigned long long)stats[0].revolutions,
+           (unsigned long long)stats[0].resyncs, rc);
+    return rc;
+}
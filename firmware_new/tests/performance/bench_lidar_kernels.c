@@ -0,0 +1,194 @@
+/**
+ * @file bench_lidar_kernels.c
+ * @brief Micro-benchmark of the per-frame LiDAR scan kernels
+ * @version 1.0.0
+ * @date 2025-02-21
+ * @team EMBED
+ *
+ * Times a full safety evaluation of one 500-point frame, nearest/farthest
+ * return, nearest return in 8 sectors of 45 degrees and a threshold mask,
+ * with every kernel implementation this machine can run. The first row is
+ * the same evaluation over the old array of padded point records, for
+ * comparison. Every kernel's result is compared with the scalar one.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ * Exit code is non-zero if the self-test fails or the kernels disagree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_lidar.h"
+#include "hal_lidar_kernels.h"
+
+#define BENCH_SECTORS       8
+#define BENCH_THRESHOLD_MM  1500
+
+static lidar_scan_data_t g_scan;
+static lidar_point_t g_points[LIDAR_POINTS_PER_SCAN];
+static lidar_kernel_sector_t g_sectors[BENCH_SECTORS];
+
+// Keeps results live so the timed loops are not optimised away
+static volatile uint32_t g_sink;
+
+typedef struct {
+    lidar_kernel_extremes_t extremes;
+    uint16_t sector_min[BENCH_SECTORS];
+    uint16_t below;
+} bench_result_t;
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_evaluate(bench_result_t *r) {
+    static uint8_t mask[LIDAR_POINTS_PER_SCAN];
+    lidar_kernel_extremes(g_scan.distance_mm, g_scan.point_count, &r->extremes);
+    lidar_kernel_sector_min(g_scan.distance_mm, g_scan.angle_q6, g_scan.point_count, g_sectors, BENCH_SECTORS,
+                            r->sector_min);
+    r->below = lidar_kernel_below_mask(g_scan.distance_mm, g_scan.point_count, BENCH_THRESHOLD_MM, mask);
+}
+
+/**
+ * @brief The same evaluation as per-point loops over padded records
+ */
+static void bench_evaluate_records(bench_result_t *r) {
+    static uint8_t mask[LIDAR_POINTS_PER_SCAN];
+    memset(r, 0, sizeof(*r));
+    r->extremes.min_mm = UINT16_MAX;
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        uint16_t d = g_points[i].distance_mm;
+        if (d > 0 && d < r->extremes.min_mm) {
+            r->extremes.min_mm = d;
+        }
+        if (d > r->extremes.max_mm) {
+            r->extremes.max_mm = d;
+        }
+    }
+    for (int s = 0; s < BENCH_SECTORS; s++) {
+        r->sector_min[s] = UINT16_MAX;
+        for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+            uint16_t d = g_points[i].distance_mm;
+            if (g_points[i].angle_deg / 45 == s && d > 0 && d < r->sector_min[s]) {
+                r->sector_min[s] = d;
+            }
+        }
+    }
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        mask[i] = (g_points[i].distance_mm > 0 && g_points[i].distance_mm < BENCH_THRESHOLD_MM) ? 1U : 0U;
+        r->below = (uint16_t)(r->below + mask[i]);
+    }
+}
+
+/**
+ * @brief Evaluate frames for at least min_ms
+ * @return Nanoseconds per frame
+ */
+static double bench_frames(void (*evaluate)(bench_result_t *), uint32_t min_ms) {
+    bench_result_t r;
+    uint64_t frames = 0;
+    uint64_t batch = 64;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed = 0;
+    uint32_t acc = 0;
+
+    do {
+        for (uint64_t i = 0; i < batch; i++) {
+            evaluate(&r);
+            acc += r.extremes.min_mm + r.below;
+        }
+        frames += batch;
+        batch *= 2;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000000ULL);
+
+    g_sink = acc;
+    return (double)elapsed / (double)frames;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N]\n", prog);
+    printf("  --min-ms N   Minimum time per implementation (default 200)\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    if (lidar_kernel_self_test() != HAL_STATUS_OK) {
+        printf("BENCH_LIDAR_KERNELS FAILED: self-test\n");
+        return 1;
+    }
+
+    // A room with a few close obstacles and some points without a return
+    uint32_t x = 1;
+    g_scan.point_count = LIDAR_POINTS_PER_SCAN;
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        x = x * 1103515245U + 12345U;
+        uint16_t d = (x >> 16) % 25U == 0 ? 0 : (uint16_t)(2000U + (x >> 16) % 4000U);
+        if (i % 97 == 5) {
+            d = (uint16_t)(400U + i);
+        }
+        g_scan.distance_mm[i] = d;
+        g_scan.angle_q6[i] = (uint16_t)((uint32_t)i * LIDAR_ANGLE_Q6_FULL_TURN / LIDAR_POINTS_PER_SCAN);
+        g_scan.quality[i] = 47;
+        g_points[i] = lidar_scan_get_point(&g_scan, i);
+    }
+    for (int s = 0; s < BENCH_SECTORS; s++) {
+        g_sectors[s].start_q6 = (uint16_t)(s * 45 * 64);
+        g_sectors[s].end_q6 = (uint16_t)((s + 1) * 45 * 64);
+    }
+
+    lidar_kernel_impl_t default_impl = lidar_kernel_active_impl();
+    printf("LiDAR scan kernels, %d points, %d sectors (default: %s)\n", LIDAR_POINTS_PER_SCAN, BENCH_SECTORS,
+           lidar_kernel_impl_name(default_impl));
+    printf("frame: %zu bytes, as point records: %zu bytes\n", sizeof(lidar_scan_data_t), sizeof(g_points));
+    printf("%-8s %12s %10s\n", "kernels", "ns/frame", "speedup");
+
+    double ns_records = bench_frames(bench_evaluate_records, min_ms);
+    printf("%-8s %12.1f %9.1fx\n", "records", ns_records, 1.0);
+
+    bench_result_t ref;
+    lidar_kernel_select(LIDAR_KERNEL_IMPL_SCALAR);
+    bench_evaluate(&ref);
+
+    double ns[LIDAR_KERNEL_IMPL_COUNT] = { 0 };
+    int rc = 0;
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        if (lidar_kernel_select((lidar_kernel_impl_t)impl) != HAL_STATUS_OK) {
+            continue;
+        }
+        bench_result_t r;
+        bench_evaluate(&r);
+        if (memcmp(&r, &ref, sizeof(r)) != 0) {
+            printf("MISMATCH: %s\n", lidar_kernel_impl_name((lidar_kernel_impl_t)impl));
+            rc = 1;
+        }
+        ns[impl] = bench_frames(bench_evaluate, min_ms);
+        printf("%-8s %12.1f %9.1fx\n", lidar_kernel_impl_name((lidar_kernel_impl_t)impl), ns[impl],
+               ns_records / ns[impl]);
+    }
+    lidar_kernel_select(default_impl);
+
+    printf("BENCH_LIDAR_KERNELS records_ns=%.1f", ns_records);
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        if (ns[impl] > 0.0) {
+            printf(" %s_ns=%.1f", lidar_kernel_impl_name((lidar_kernel_impl_t)impl), ns[impl]);
+        }
+    }
+    printf(" frame_bytes=%zu record_bytes=%zu mismatches=%d\n", sizeof(lidar_scan_data_t), sizeof(g_points), rc);
+    return rc;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file bench_lidar_window.c
+ * @brief Per-frame cost of LiDAR multi-frame filtering
+ * @version 1.0.0
+ * @date 2025-02-23
+ * @team EMBED
+ *
+ * Times one frame of two filters at several window lengths: temporal
+ * (window mean blended 70/30 with the current return) and z-score outlier
+ * rejection (mean and standard deviation per point). Each is run two ways:
+ * the old copy of every frame into a ring with per-index statistics over
+ * the ring, and the per-degree running sums of lidar_window_t. Frames are
+ * 500 points with the sensor's angular jitter, so indices drift against
+ * angles.
+ *
+ * The last line is a single key=value record for CI to diff between runs.
+ * Exit code is non-zero if the two disagree on a steady scene.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_lidar.h"
+#include "hal_lidar_window.h"
+
+#define BENCH_FRAMES_IN_SET     64
+
+static const uint8_t g_lengths[] = { 3, 5, 10 };
+#define BENCH_LENGTH_COUNT  (sizeof(g_lengths) / sizeof(g_lengths[0]))
+
+static lidar_scan_data_t g_frames[BENCH_FRAMES_IN_SET];
+static lidar_scan_data_t g_ring[LIDAR_WINDOW_MAX_FRAMES];
+static lidar_window_t g_window;
+
+// Keeps results live so the timed loops are not optimised away
+static volatile uint32_t g_sink;
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief The old filter: copy the frame into the ring, average by array index
+ */
+static void bench_filter_copy(lidar_scan_data_t *scan, uint8_t length, uint8_t *index) {
+    g_ring[*index] = *scan;
+    *index = (uint8_t)((*index + 1U) % length);
+
+    for (uint16_t i = 0; i < scan->point_count; i++) {
+        float sum = 0.0f;
+        uint8_t n = 0;
+        for (uint8_t j = 0; j < length; j++) {
+            if (i < g_ring[j].point_count) {
+                sum += (float)g_ring[j].distance_mm[i];
+                n++;
+            }
+        }
+        if (n > 1) {
+            scan->distance_mm[i] = (uint16_t)((sum / (float)n) * 0.7f + (float)scan->distance_mm[i] * 0.3f);
+        }
+    }
+}
+
+/**
+ * @brief The old outlier filter: per-index mean and deviation over the ring
+ */
+static void bench_outlier_copy(lidar_scan_data_t *scan, uint8_t length, uint8_t *index) {
+    g_ring[*index] = *scan;
+    *index = (uint8_t)((*index + 1U) % length);
+
+    for (uint16_t i = 0; i < scan->point_count; i++) {
+        uint16_t samples[LIDAR_WINDOW_MAX_FRAMES];
+        uint8_t n = 0;
+        for (uint8_t j = 0; j < length; j++) {
+            if (i < g_ring[j].point_count) {
+                samples[n++] = g_ring[j].distance_mm[i];
+            }
+        }
+        if (n > 2) {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < n; k++) {
+                sum += (float)samples[k];
+            }
+            float mean = sum / (float)n;
+            float sum_sq = 0.0f;
+            for (uint8_t k = 0; k < n; k++) {
+                float diff = (float)samples[k] - mean;
+                sum_sq += diff * diff;
+            }
+            float std_dev = sqrtf(sum_sq / (float)n);
+            if (std_dev > 0.0f && fabsf((float)scan->distance_mm[i] - mean) / std_dev > 2.0f) {
+                scan->distance_mm[i] = (uint16_t)mean;
+            }
+        }
+    }
+}
+
+/**
+ * @brief The new outlier filter: O(1) sigma gate per point from the window sums
+ */
+static void bench_outlier_window(lidar_scan_data_t *scan) {
+    lidar_window_push(&g_window, scan);
+    for (uint16_t i = 0; i < scan->point_count; i++) {
+        if (scan->distance_mm[i] == 0) {
+            continue;
+        }
+        uint16_t bin = lidar_window_bin(scan->angle_q6[i]);
+        if (lidar_window_count(&g_window, bin) > 2 &&
+            lidar_window_exceeds_sigma(&g_window, bin, scan->distance_mm[i], 2.0f)) {
+            scan->distance_mm[i] = (uint16_t)lidar_window_mean_mm(&g_window, bin);
+        }
+    }
+}
+
+/**
+ * @brief The new filter: slide the per-degree sums, one lookup per point
+ */
+static void bench_filter_window(lidar_scan_data_t *scan) {
+    lidar_window_push(&g_window, scan);
+    for (uint16_t i = 0; i < scan->point_count; i++) {
+        if (scan->distance_mm[i] == 0) {
+            continue;
+        }
+        uint16_t bin = lidar_window_bin(scan->angle_q6[i]);
+        if (lidar_window_count(&g_window, bin) > 1) {
+            scan->distance_mm[i] = (uint16_t)(lidar_window_mean_mm(&g_window, bin) * 0.7f + (float)scan->distance_mm[i] * 0.3f);
+        }
+    }
+}
+
+/**
+ * @brief Filter frames for at least min_ms
+ * @return Nanoseconds per frame
+ */
+static double bench_run(bool outlier, bool use_window, uint8_t length, uint32_t min_ms) {
+    static lidar_scan_data_t scan;
+    uint64_t frames = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed = 0;
+    uint32_t acc = 0;
+    uint8_t index = 0;
+
+    memset(g_ring, 0, sizeof(g_ring));
+    lidar_window_init(&g_window, length);
+    do {
+        for (uint32_t f = 0; f < BENCH_FRAMES_IN_SET; f++) {
+            // Both filter in place, as the pipeline does on the writer's buffer
+            scan = g_frames[f];
+            if (outlier) {
+                if (use_window) {
+                    bench_outlier_window(&scan);
+                } else {
+                    bench_outlier_copy(&scan, length, &index);
+                }
+            } else if (use_window) {
+                bench_filter_window(&scan);
+            } else {
+                bench_filter_copy(&scan, length, &index);
+            }
+            acc += scan.distance_mm[f];
+        }
+        frames += BENCH_FRAMES_IN_SET;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000000ULL);
+
+    g_sink = acc;
+    return (double)elapsed / (double)frames;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--min-ms N]\n", prog);
+    printf("  --min-ms N   Minimum time per window length and method (default 200)\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t min_ms = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    // A room seen at 500 points per turn; angles jitter by up to a degree per frame
+    uint32_t x = 1;
+    for (uint32_t f = 0; f < BENCH_FRAMES_IN_SET; f++) {
+        lidar_scan_data_t *scan = &g_frames[f];
+        scan->point_count = LIDAR_POINTS_PER_SCAN;
+        scan->scan_complete = true;
+        for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+            x = x * 1103515245U + 12345U;
+            uint32_t angle_q6 = (uint32_t)i * LIDAR_ANGLE_Q6_FULL_TURN / LIDAR_POINTS_PER_SCAN + (x >> 16) % 64U;
+            angle_q6 %= LIDAR_ANGLE_Q6_FULL_TURN;
+            // Range is continuous across 0/360 degrees, as in a real room
+            uint32_t deg = angle_q6 / 64U;
+            uint32_t off_axis = deg < 180U ? deg : 360U - deg;
+            scan->angle_q6[i] = (uint16_t)angle_q6;
+            scan->distance_mm[i] = (uint16_t)(2000U + off_axis * 5U + (x >> 24) % 16U);
+            scan->quality[i] = 47;
+        }
+    }
+
+    // On a still scene both settle within a degree's worth of range of the raw return
+    static lidar_scan_data_t by_copy;
+    static lidar_scan_data_t by_window;
+    int rc = 0;
+    uint8_t index = 0;
+    memset(g_ring, 0, sizeof(g_ring));
+    lidar_window_init(&g_window, 5);
+    for (int f = 0; f < 10; f++) {
+        by_copy = g_frames[0];
+        by_window = g_frames[0];
+        bench_filter_copy(&by_copy, 5, &index);
+        bench_filter_window(&by_window);
+    }
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        if (abs((int)by_copy.distance_mm[i] - (int)by_window.distance_mm[i]) > 16) {
+            printf("MISMATCH: point %u copy %u window %u\n", i, by_copy.distance_mm[i], by_window.distance_mm[i]);
+            rc = 1;
+            break;
+        }
+    }
+
+    printf("LiDAR multi-frame filters, %d points per frame, %d bins\n", LIDAR_POINTS_PER_SCAN, LIDAR_WINDOW_BINS);
+    printf("state: frame ring %zu bytes, window %zu bytes\n", sizeof(g_ring), sizeof(g_window));
+    printf("%-9s %7s %14s %14s %10s\n", "filter", "frames", "copy ns", "window ns", "speedup");
+
+    static const char *const names[2] = { "temporal", "outlier" };
+    double copy_ns[2][BENCH_LENGTH_COUNT];
+    double window_ns[2][BENCH_LENGTH_COUNT];
+    for (int m = 0; m < 2; m++) {
+        for (size_t l = 0; l < BENCH_LENGTH_COUNT; l++) {
+            copy_ns[m][l] = bench_run(m == 1, false, g_lengths[l], min_ms);
+            window_ns[m][l] = bench_run(m == 1, true, g_lengths[l], min_ms);
+            printf("%-9s %7u %14.1f %14.1f %9.1fx\n", names[m], g_lengths[l], copy_ns[m][l], window_ns[m][l],
+                   copy_ns[m][l] / window_ns[m][l]);
+        }
+    }
+
+    printf("BENCH_LIDAR_WINDOW");
+    for (int m = 0; m < 2; m++) {
+        for (size_t l = 0; l < BENCH_LENGTH_COUNT; l++) {
+            printf(" %s_copy%u_ns=%.1f %s_window%u_ns=%.1f", names[m], g_lengths[l], copy_ns[m][l],
+                   names[m], g_lengths[l], window_ns[m][l]);
+        }
+    }
+    printf(" ring_bytes=%zu window_bytes=%zu mismatches=%d\n", sizeof(g_ring), sizeof(g_window), rc);
+    return rc;
+}
@@ -0,0 +1,354 @@
+/**
+ * @file bench_rs485.c
+ * @brief RS485/Modbus bus throughput benchmark against the pty slave simulator
+ * @version 1.0.0
+ * @date 2025-02-15
+ * @team FW
+ *
+ * Runs the real HAL -> comm manager -> bus master -> polling stack against
+ * modbus_slave_sim and reports:
+ *   - FC03 transactions/s and p50/p99/max latency of
+ *     comm_manager_modbus_read_holding_registers()
+ *   - duration of a full poll cycle (every register group of the power,
+ *     safety, travel-motor and dock modules) through the polling manager
+ *
+ * Firmware logging goes to stdout and is discarded unless --verbose is
+ * given; the report is printed once the run is over. The last line is a
+ * single key=value record for CI to diff between runs.
+ *
+ * Exit code is non-zero if nothing succeeded, or if a run without injected
+ * faults saw any failure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "hal_common.h"
+#include "hal_rs485.h"
+#include "communication_manager.h"
+#include "modbus_bus_master.h"
+#include "module_polling_manager.h"
+#include "modbus_slave_sim.h"
+
+typedef struct {
+    uint32_t transactions;
+    uint8_t module_addr;
+    uint16_t start_reg;
+    uint16_t quantity;
+    uint32_t poll_cycles;
+    uint32_t timeout_ms;
+    uint32_t retries;
+    bool verbose;
+    modbus_slave_sim_faults_t faults;
+} bench_options_t;
+
+typedef struct {
+    uint32_t ok;
+    uint32_t failed;
+    double elapsed_s;
+    uint64_t p50_us;
+    uint64_t p99_us;
+    uint64_t max_us;
+} bench_result_t;
+
+static uint64_t bench_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t *sorted, uint32_t count, uint32_t pct) {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t index = (uint32_t)(((uint64_t)count * pct + 99U) / 100U);
+    return sorted[index > 0 ? index - 1 : 0];
+}
+
+static void summarize(uint64_t *samples, uint32_t count, bench_result_t *result) {
+    qsort(samples, count, sizeof(samples[0]), compare_u64);
+    result->p50_us = percentile(samples, count, 50);
+    result->p99_us = percentile(samples, count, 99);
+    result->max_us = count > 0 ? samples[count - 1] : 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --transactions N     FC03 reads to time (default 2000)\n"
+            "  --module ADDR        Module to read, 0x02-0x05 (default 0x02)\n"
+            "  --start REG          First register (default 0x0000)\n"
+            "  --quantity N         Registers per read, 1-125 (default 16)\n"
+            "  --poll-cycles N      Full polling-manager cycles to time (default 20)\n"
+            "  --timeout-ms N       Master response timeout (default 100)\n"
+            "  --retries N          Comm manager retries per request (default 0)\n"
+            "  --latency-us N       Simulated slave turnaround (default 0)\n"
+            "  --jitter-us N        Extra random slave delay (default 0)\n"
+            "  --crc-permille N     Responses with a corrupted CRC (default 0)\n"
+            "  --timeout-permille N Requests left unanswered (default 0)\n"
+            "  --seed N             Fault PRNG seed (default 1)\n"
+            "  --verbose            Keep firmware logging on stdout\n",
+            prog);
+}
+
+static bool parse_options(int argc, char **argv, bench_options_t *opt) {
+    memset(opt, 0, sizeof(*opt));
+    opt->transactions = 2000;
+    opt->module_addr = 0x02;
+    opt->quantity = 16;
+    opt->poll_cycles = 20;
+    opt->timeout_ms = 100;
+    opt->faults.seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--verbose") == 0) {
+            opt->verbose = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        unsigned long value = strtoul(argv[++i], NULL, 0);
+        if (strcmp(arg, "--transactions") == 0) {
+            opt->transactions = (uint32_t)value;
+        } else if (strcmp(arg, "--module") == 0) {
+            opt->module_addr = (uint8_t)value;
+        } else if (strcmp(arg, "--start") == 0) {
+            opt->start_reg = (uint16_t)value;
+        } else if (strcmp(arg, "--quantity") == 0) {
+            opt->quantity = (uint16_t)value;
+        } else if (strcmp(arg, "--poll-cycles") == 0) {
+            opt->poll_cycles = (uint32_t)value;
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt->timeout_ms = (uint32_t)value;
+        } else if (strcmp(arg, "--retries") == 0) {
+            opt->retries = (uint32_t)value;
+        } else if (strcmp(arg, "--latency-us") == 0) {
+            opt->faults.latency_us = (uint32_t)value;
+        } else if (strcmp(arg, "--jitter-us") == 0) {
+            opt->faults.jitter_us = (uint32_t)value;
+        } else if (strcmp(arg, "--crc-permille") == 0) {
+            opt->faults.crc_error_permille = (uint16_t)value;
+        } else if (strcmp(arg, "--timeout-permille") == 0) {
+            opt->faults.timeout_permille = (uint16_t)value;
+        } else if (strcmp(arg, "--seed") == 0) {
+            opt->faults.seed = (uint32_t)value;
+        } else {
+            return false;
+        }
+    }
+    return opt->quantity >= 1 && opt->quantity <= 125 && opt->transactions > 0;
+}
+
+/**
+ * @brief Bring up HAL and comm manager on the simulator's pty
+ */
+static hal_status_t bench_open_bus(const char *device, const bench_options_t *opt) {
+    rs485_config_t rs485_cfg = {
+        .baud_rate = RS485_BAUD_RATE,
+        .data_bits = RS485_DATA_BITS,
+        .stop_bits = RS485_STOP_BITS,
+        .parity = RS485_PARITY_NONE,
+        .timeout_ms = opt->timeout_ms,
+        .retry_count = 0
+    };
+    snprintf(rs485_cfg.device_path, sizeof(rs485_cfg.device_path), "%s", device);
+
+    // Same order as main(): the comm manager then finds the HAL already configured
+    hal_status_t status = hal_rs485_init(&rs485_cfg);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+
+    comm_mgr_config_t comm_cfg = {
+        .baud_rate = RS485_BAUD_RATE,
+        .data_bits = 8,
+        .stop_bits = 1,
+        .parity = 0,
+        .timeout_ms = opt->timeout_ms,
+        .retry_count = opt->retries,
+        .retry_delay_ms = 0,
+        .modbus_slave_id = opt->module_addr,
+        .enable_crc_check = true,
+        .enable_echo_suppression = true,
+        .buffer_size = 256
+    };
+    status = comm_manager_init(&comm_cfg);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+
+    status = modbus_bus_master_init();
+    if (status == HAL_STATUS_OK) {
+        status = modbus_bus_master_start();
+    }
+    return status;
+}
+
+static void bench_reads(const bench_options_t *opt, bench_result_t *result) {
+    uint16_t regs[125];
+    uint64_t *samples = calloc(opt->transactions, sizeof(uint64_t));
+
+    memset(result, 0, sizeof(*result));
+    if (samples == NULL) {
+        return;
+    }
+
+    uint64_t start = bench_now_us();
+    for (uint32_t i = 0; i < opt->transactions; i++) {
+        uint64_t t0 = bench_now_us();
+        hal_status_t status = comm_manager_modbus_read_holding_registers(opt->module_addr, opt->start_reg,
+                                                                         opt->quantity, regs);
+        uint64_t t1 = bench_now_us();
+        if (status == HAL_STATUS_OK) {
+            samples[result->ok++] = t1 - t0;
+        } else {
+            result->failed++;
+        }
+    }
+    result->elapsed_s = (double)(bench_now_us() - start) / 1e6;
+
+    summarize(samples, result->ok, result);
+    free(samples);
+}
+
+static void bench_poll_cycles(const bench_options_t *opt, bench_result_t *result) {
+    static const uint8_t modules[] = { 0x02, 0x03, 0x04, 0x05 };
+    static const module_polling_type_t types[] = {
+        MODULE_TYPE_POWER, MODULE_TYPE_SAFETY, MODULE_TYPE_TRAVEL_MOTOR, MODULE_TYPE_DOCK
+    };
+    uint64_t *samples = calloc(opt->poll_cycles > 0 ? opt->poll_cycles : 1, sizeof(uint64_t));
+
+    memset(result, 0, sizeof(*result));
+    if (samples == NULL || opt->poll_cycles == 0 || module_polling_manager_init() != HAL_STATUS_OK) {
+        free(samples);
+        return;
+    }
+    for (size_t m = 0; m < sizeof(modules); m++) {
+        module_polling_manager_add_module(modules[m], types[m]);
+    }
+
+    uint64_t start = bench_now_us();
+    for (uint32_t c = 0; c < opt->poll_cycles; c++) {
+        bool cycle_ok = true;
+        uint64_t t0 = bench_now_us();
+        for (size_t m = 0; m < sizeof(modules); m++) {
+            if (module_polling_manager_poll_module(modules[m]) != HAL_STATUS_OK) {
+                cycle_ok = false;
+            }
+        }
+        uint64_t t1 = bench_now_us();
+        if (cycle_ok) {
+            samples[result->ok++] = t1 - t0;
+        } else {
+            result->failed++;
+        }
+    }
+    result->elapsed_s = (double)(bench_now_us() - start) / 1e6;
+
+    summarize(samples, result->ok, result);
+    free(samples);
+}
+
+int main(int argc, char **argv) {
+    bench_options_t opt;
+    bench_result_t reads;
+    bench_result_t polls;
+    modbus_slave_sim_stats_t sim_stats;
+    rs485_statistics_t rs485_stats;
+    char device[MODBUS_SLAVE_SIM_PATH_MAX];
+
+    if (!parse_options(argc, argv, &opt)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Keep the report readable: firmware logs go to /dev/null unless asked for
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    if (!opt.verbose) {
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            close(devnull);
+        }
+    }
+
+    hal_status_t status = modbus_slave_sim_start(&opt.faults, device, sizeof(device));
+    if (status == HAL_STATUS_OK) {
+        status = bench_open_bus(device, &opt);
+    }
+    if (status == HAL_STATUS_OK) {
+        bench_reads(&opt, &reads);
+        bench_poll_cycles(&opt, &polls);
+    }
+
+    modbus_bus_master_stop();
+    modbus_bus_master_deinit();
+    memset(&rs485_stats, 0, sizeof(rs485_stats));
+    hal_rs485_get_statistics(&rs485_stats);
+    comm_manager_deinit();
+    modbus_slave_sim_get_stats(&sim_stats);
+    modbus_slave_sim_stop();
+
+    fflush(stdout);
+    if (saved_stdout >= 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+    }
+
+    if (status != HAL_STATUS_OK) {
+        printf("[BENCH-RS485] Setup failed: %s\n", hal_status_to_string(status));
+        return 1;
+    }
+
+    printf("=== RS485/MODBUS BUS BENCHMARK ===\n");
+    printf("Device: %s (simulated, %u baud, timeout %u ms, retries %u)\n",
+           device, RS485_BAUD_RATE, opt.timeout_ms, opt.retries);
+    printf("Faults: latency %u us + 0..%u us, CRC %u/1000, timeout %u/1000, seed %u\n",
+           opt.faults.latency_us, opt.faults.jitter_us, opt.faults.crc_error_permille,
+           opt.faults.timeout_permille, opt.faults.seed);
+    printf("\nFC03 x%u registers from 0x%02X@0x%04X:\n", opt.quantity, opt.module_addr, opt.start_reg);
+    printf("  %u ok, %u failed in %.2f s -> %.1f transactions/s\n",
+           reads.ok, reads.failed, reads.elapsed_s,
+           reads.elapsed_s > 0 ? (double)reads.ok / reads.elapsed_s : 0.0);
+    printf("  latency p50 %llu us, p99 %llu us, max %llu us\n",
+           (unsigned long long)reads.p50_us, (unsigned long long)reads.p99_us, (unsigned long long)reads.max_us);
+    printf("\nPoll cycle (power, safety, travel motor, dock; all groups):\n");
+    printf("  %u ok, %u failed; p50 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+           polls.ok, polls.failed, (double)polls.p50_us / 1000.0, (double)polls.p99_us / 1000.0,
+           (double)polls.max_us / 1000.0);
+    printf("\nSlave: %llu requests, %llu responses, %llu exceptions, %llu CRC faults, %llu timeouts, %llu bad frames\n",
+           (unsigned long long)sim_stats.requests, (unsigned long long)sim_stats.responses,
+           (unsigned long long)sim_stats.exceptions, (unsigned long long)sim_stats.crc_errors_injected,
+           (unsigned long long)sim_stats.timeouts_injected, (unsigned long long)sim_stats.bad_frames);
+    printf("HAL:   rx latency avg %llu us, max %llu us, %llu by length, %llu by silence\n",
+           (unsigned long long)(rs485_stats.rx_latency_count > 0
+                                    ? rs485_stats.rx_latency_total_us / rs485_stats.rx_latency_count : 0),
+           (unsigned long long)rs485_stats.rx_latency_max_us,
+           (unsigned long long)rs485_stats.frames_complete_by_length,
+           (unsigned long long)rs485_stats.frames_complete_by_silence);
+    printf("BENCH_RS485 tps=%.1f p50_us=%llu p99_us=%llu read_failed=%u poll_p50_ms=%.2f poll_p99_ms=%.2f poll_failed=%u\n",
+           reads.elapsed_s > 0 ? (double)reads.ok / reads.elapsed_s : 0.0,
+           (unsigned long long)reads.p50_us, (unsigned long long)reads.p99_us, reads.failed,
+           (double)polls.p50_us / 1000.0, (double)polls.p99_us / 1000.0, polls.failed);
+
+    bool faults_injected = opt.faults.crc_error_permille > 0 || opt.faults.timeout_permille > 0;
+    if (reads.ok == 0 || (!faults_injected && (reads.failed > 0 || polls.failed > 0))) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,429 @@
+/**
+ * @file modbus_slave_sim.c
+ * @brief Pseudo-terminal Modbus RTU slave simulator for bus benchmarks
+ * @version 1.0.0
+ * @date 2025-02-15
+ * @team FW
+ */
+
+#include "modbus_slave_sim.h"
+#include "register_info.h"
+#include "hal_modbus_crc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SIM_FIRST_MODULE        MODULE_ADDR_POWER
+#define SIM_MODULE_COUNT        4           // Power, safety, travel motor, dock
+#define SIM_REG_SPACE           65536U
+#define SIM_FRAME_MAX           256
+#define SIM_POLL_MS             20          // Also the inter-frame silence that drops a partial request
+#define SIM_MODULE_TYPE_REG     0x0104
+
+typedef struct {
+    bool running;
+    int master_fd;
+    int slave_fd;                           // Held open so the master never reads EIO between HAL opens
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    modbus_slave_sim_faults_t faults;
+    modbus_slave_sim_stats_t stats;
+    uint32_t rng;
+    bool absent[SIM_MODULE_COUNT];          // Unplugged: requests go unanswered
+    uint16_t regs[SIM_MODULE_COUNT][SIM_REG_SPACE];
+    uint8_t read_only[SIM_MODULE_COUNT][SIM_REG_SPACE / 8U];
+} modbus_slave_sim_t;
+
+static modbus_slave_sim_t g_sim = {
+    .master_fd = -1,
+    .slave_fd = -1,
+    .mutex = PTHREAD_MUTEX_INITIALIZER
+};
+
+/**
+ * @brief xorshift32; called with the mutex held
+ */
+static uint32_t sim_random(void) {
+    uint32_t x = g_sim.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_sim.rng = x;
+    return x;
+}
+
+static int sim_module_index(uint8_t module_addr) {
+    if (module_addr < SIM_FIRST_MODULE || module_addr >= SIM_FIRST_MODULE + SIM_MODULE_COUNT) {
+        return -1;
+    }
+    return (int)module_addr - (int)SIM_FIRST_MODULE;
+}
+
+static bool sim_is_read_only(int module, uint16_t reg) {
+    return (g_sim.read_only[module][reg >> 3] & (1U << (reg & 7U))) != 0;
+}
+
+/**
+ * @brief Seed every emulated module from its register_info map
+ */
+static void sim_load_register_maps(void) {
+    memset(g_sim.regs, 0, sizeof(g_sim.regs));
+    memset(g_sim.read_only, 0, sizeof(g_sim.read_only));
+    memset(g_sim.absent, 0, sizeof(g_sim.absent));
+
+    for (int m = 0; m < SIM_MODULE_COUNT; m++) {
+        uint8_t module_addr = (uint8_t)(SIM_FIRST_MODULE + (uint32_t)m);
+        uint16_t count = 0;
+        const register_info_t *map = get_module_registers_array(module_addr, &count);
+
+        // Discovery identifies modules by this register; the map may define it too
+        g_sim.regs[m][SIM_MODULE_TYPE_REG] = module_addr;
+        for (uint16_t i = 0; map != NULL && i < count; i++) {
+            uint16_t value = map[i].default_value;
+            if (value < map[i].min_value) {
+                value = map[i].min_value;
+            } else if (map[i].max_value != 0 && value > map[i].max_value) {
+                value = map[i].max_value;
+            }
+            g_sim.regs[m][map[i].address] = value;
+            if (map[i].mode == REG_MODE_READ_ONLY) {
+                g_sim.read_only[m][map[i].address >> 3] |= (uint8_t)(1U << (map[i].address & 7U));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Length of a request frame from its header
+ * @return Total length including CRC, 0 if more bytes are needed, -1 if unknown
+ */
+static int sim_request_length(const uint8_t *frame, size_t length) {
+    if (length < 2) {
+        return 0;
+    }
+    switch (frame[1]) {
+        case 0x01: case 0x02: case 0x03: case 0x04: case 0x05: case 0x06:
+            return 8;
+        case 0x10:
+            return length < 7 ? 0 : 9 + frame[6];
+        default:
+            return -1;
+    }
+}
+
+static size_t sim_exception(uint8_t *resp, uint8_t fc, uint8_t code) {
+    resp[1] = (uint8_t)(fc | 0x80U);
+    resp[2] = code;
+    g_sim.stats.exceptions++;
+    return 3;
+}
+
+/**
+ * @brief Build the response to one valid request; called with the mutex held
+ * @return Response length without CRC
+ */
+static size_t sim_handle_request(int module, const uint8_t *req, uint8_t *resp) {
+    uint8_t fc = req[1];
+    uint16_t start = (uint16_t)((req[2] << 8) | req[3]);
+    uint16_t value = (uint16_t)((req[4] << 8) | req[5]);
+
+    resp[0] = req[0];
+    switch (fc) {
+        case 0x03:
+        case 0x04: {
+            if (value == 0 || value > 125) {
+                return sim_exception(resp, fc, 0x03);
+            }
+            if ((uint32_t)start + value > SIM_REG_SPACE) {
+                return sim_exception(resp, fc, 0x02);
+            }
+            resp[1] = fc;
+            resp[2] = (uint8_t)(value * 2U);
+            for (uint16_t i = 0; i < value; i++) {
+                uint16_t reg = g_sim.regs[module][start + i];
+                resp[3 + i * 2] = (uint8_t)(reg >> 8);
+                resp[4 + i * 2] = (uint8_t)(reg & 0xFF);
+            }
+            g_sim.stats.responses++;
+            return 3U + value * 2U;
+        }
+        case 0x06:
+            if (sim_is_read_only(module, start)) {
+                return sim_exception(resp, fc, 0x02);
+            }
+            g_sim.regs[module][start] = value;
+            memcpy(resp + 1, req + 1, 5);
+            g_sim.stats.responses++;
+            return 6;
+        case 0x10: {
+            if (value == 0 || value > 123 || req[6] != value * 2U) {
+                return sim_exception(resp, fc, 0x03);
+            }
+            if ((uint32_t)start + value > SIM_REG_SPACE) {
+                return sim_exception(resp, fc, 0x02);
+            }
+            for (uint16_t i = 0; i < value; i++) {
+                if (sim_is_read_only(module, (uint16_t)(start + i))) {
+                    return sim_exception(resp, fc, 0x02);
+                }
+            }
+            for (uint16_t i = 0; i < value; i++) {
+                g_sim.regs[module][start + i] = (uint16_t)((req[7 + i * 2] << 8) | req[8 + i * 2]);
+            }
+            memcpy(resp + 1, req + 1, 5);
+            g_sim.stats.responses++;
+            return 6;
+        }
+        default:
+            return sim_exception(resp, fc, 0x01);
+    }
+}
+
+/**
+ * @brief Answer (or deliberately ignore) one complete request frame
+ */
+static void sim_process_frame(const uint8_t *req, size_t length) {
+    uint8_t resp[SIM_FRAME_MAX];
+    uint32_t delay_us;
+    bool corrupt;
+
+    uint16_t crc = (uint16_t)(req[length - 2] | (req[length - 1] << 8));
+    pthread_mutex_lock(&g_sim.mutex);
+    if (crc != modbus_crc16(req, length - 2)) {
+        g_sim.stats.bad_frames++;
+        pthread_mutex_unlock(&g_sim.mutex);
+        return;
+    }
+    int module = sim_module_index(req[0]);
+    if (module < 0 || g_sim.absent[module]) {
+        g_sim.stats.foreign++;
+        pthread_mutex_unlock(&g_sim.mutex);
+        return;
+    }
+    g_sim.stats.requests++;
+    if (g_sim.faults.timeout_permille > 0 && sim_random() % 1000U < g_sim.faults.timeout_permille) {
+        g_sim.stats.timeouts_injected++;
+        pthread_mutex_unlock(&g_sim.mutex);
+        return;
+    }
+    size_t resp_len = sim_handle_request(module, req, resp);
+    delay_us = g_sim.faults.latency_us;
+    if (g_sim.faults.jitter_us > 0) {
+        delay_us += sim_random() % (g_sim.faults.jitter_us + 1U);
+    }
+    corrupt = g_sim.faults.crc_error_permille > 0 && sim_random() % 1000U < g_sim.faults.crc_error_permille;
+    if (corrupt) {
+        g_sim.stats.crc_errors_injected++;
+    }
+    pthread_mutex_unlock(&g_sim.mutex);
+
+    uint16_t resp_crc = modbus_crc16(resp, resp_len);
+    if (corrupt) {
+        resp_crc ^= 0x5A5A;
+    }
+    resp[resp_len++] = (uint8_t)(resp_crc & 0xFF);
+    resp[resp_len++] = (uint8_t)(resp_crc >> 8);
+
+    if (delay_us > 0) {
+        usleep(delay_us);
+    }
+    ssize_t written = write(g_sim.master_fd, resp, resp_len);
+    if (written != (ssize_t)resp_len) {
+        printf("[SLAVE-SIM] Short write: %zd/%zu (%s)\n", written, resp_len, strerror(errno));
+    }
+}
+
+static void* sim_thread_main(void *arg) {
+    (void)arg;
+    uint8_t frame[SIM_FRAME_MAX];
+    size_t have = 0;
+
+    while (__atomic_load_n(&g_sim.running, __ATOMIC_ACQUIRE)) {
+        struct pollfd pfd = { .fd = g_sim.master_fd, .events = POLLIN };
+        int ready = poll(&pfd, 1, SIM_POLL_MS);
+        if (ready == 0) {
+            // t3.5 silence ended a frame we could not make sense of
+            if (have > 0) {
+                pthread_mutex_lock(&g_sim.mutex);
+                g_sim.stats.bad_frames++;
+                pthread_mutex_unlock(&g_sim.mutex);
+                have = 0;
+            }
+            continue;
+        }
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        ssize_t n = read(g_sim.master_fd, frame + have, sizeof(frame) - have);
+        if (n <= 0) {
+            if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+            usleep(1000);
+            continue;
+        }
+        have += (size_t)n;
+
+        for (;;) {
+            int need = sim_request_length(frame, have);
+            if (need < 0 || (size_t)need > sizeof(frame)) {
+                pthread_mutex_lock(&g_sim.mutex);
+                g_sim.stats.bad_frames++;
+                pthread_mutex_unlock(&g_sim.mutex);
+                have = 0;
+                break;
+            }
+            if (need == 0 || have < (size_t)need) {
+                break;
+            }
+            sim_process_frame(frame, (size_t)need);
+            memmove(frame, frame + need, have - (size_t)need);
+            have -= (size_t)need;
+        }
+    }
+    return NULL;
+}
+
+hal_status_t modbus_slave_sim_start(const modbus_slave_sim_faults_t *faults, char *slave_path, size_t path_len) {
+    struct termios tty;
+
+    if (slave_path == NULL || path_len == 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    if (g_sim.running) {
+        return HAL_STATUS_ALREADY_ACTIVE;
+    }
+
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0) {
+        printf("[SLAVE-SIM] Failed to create pty: %s\n", strerror(errno));
+        if (master_fd >= 0) {
+            close(master_fd);
+        }
+        return HAL_STATUS_IO_ERROR;
+    }
+    const char *name = ptsname(master_fd);
+    if (name == NULL || strlen(name) >= path_len) {
+        close(master_fd);
+        return HAL_STATUS_ERROR;
+    }
+    int slave_fd = open(name, O_RDWR | O_NOCTTY);
+    if (slave_fd < 0) {
+        printf("[SLAVE-SIM] Failed to open %s: %s\n", name, strerror(errno));
+        close(master_fd);
+        return HAL_STATUS_IO_ERROR;
+    }
+    // Raw line discipline from the start: no echo or CR/LF mangling before the HAL configures it
+    if (tcgetattr(slave_fd, &tty) == 0) {
+        cfmakeraw(&tty);
+        tcsetattr(slave_fd, TCSANOW, &tty);
+    }
+    snprintf(slave_path, path_len, "%s", name);
+
+    pthread_mutex_lock(&g_sim.mutex);
+    memset(&g_sim.stats, 0, sizeof(g_sim.stats));
+    memset(&g_sim.faults, 0, sizeof(g_sim.faults));
+    if (faults != NULL) {
+        g_sim.faults = *faults;
+    }
+    g_sim.rng = g_sim.faults.seed != 0 ? g_sim.faults.seed : 0x2545F491U;
+    sim_load_register_maps();
+    g_sim.master_fd = master_fd;
+    g_sim.slave_fd = slave_fd;
+    pthread_mutex_unlock(&g_sim.mutex);
+
+    __atomic_store_n(&g_sim.running, true, __ATOMIC_RELEASE);
+    if (pthread_create(&g_sim.thread, NULL, sim_thread_main, NULL) != 0) {
+        __atomic_store_n(&g_sim.running, false, __ATOMIC_RELEASE);
+        close(slave_fd);
+        close(master_fd);
+        g_sim.master_fd = -1;
+        g_sim.slave_fd = -1;
+        return HAL_STATUS_ERROR;
+    }
+
+    printf("[SLAVE-SIM] Emulating modules 0x%02X-0x%02X on %s\n",
+           SIM_FIRST_MODULE, SIM_FIRST_MODULE + SIM_MODULE_COUNT - 1, slave_path);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_slave_sim_stop(void) {
+    if (!__atomic_load_n(&g_sim.running, __ATOMIC_ACQUIRE)) {
+        return HAL_STATUS_NOT_INITIALIZED;
+    }
+    __atomic_store_n(&g_sim.running, false, __ATOMIC_RELEASE);
+    pthread_join(g_sim.thread, NULL);
+
+    close(g_sim.slave_fd);
+    close(g_sim.master_fd);
+    g_sim.slave_fd = -1;
+    g_sim.master_fd = -1;
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_slave_sim_set_faults(const modbus_slave_sim_faults_t *faults) {
+    if (faults == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_sim.mutex);
+    g_sim.faults = *faults;
+    if (faults->seed != 0) {
+        g_sim.rng = faults->seed;
+    }
+    pthread_mutex_unlock(&g_sim.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_slave_sim_set_register(uint8_t module_addr, uint16_t reg, uint16_t value) {
+    int module = sim_module_index(module_addr);
+    if (module < 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_sim.mutex);
+    g_sim.regs[module][reg] = value;
+    pthread_mutex_unlock(&g_sim.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_slave_sim_set_present(uint8_t module_addr, bool present) {
+    int module = sim_module_index(module_addr);
+    if (module < 0) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_sim.mutex);
+    g_sim.absent[module] = !present;
+    pthread_mutex_unlock(&g_sim.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_slave_sim_get_register(uint8_t module_addr, uint16_t reg, uint16_t *value) {
+    int module = sim_module_index(module_addr);
+    if (module < 0 || value == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_sim.mutex);
+    *value = g_sim.regs[module][reg];
+    pthread_mutex_unlock(&g_sim.mutex);
+    return HAL_STATUS_OK;
+}
+
+hal_status_t modbus_slave_sim_get_stats(modbus_slave_sim_stats_t *stats) {
+    if (stats == NULL) {
+        return HAL_STATUS_INVALID_PARAMETER;
+    }
+    pthread_mutex_lock(&g_sim.mutex);
+    *stats = g_sim.stats;
+    pthread_mutex_unlock(&g_sim.mutex);
+    return HAL_STATUS_OK;
+}
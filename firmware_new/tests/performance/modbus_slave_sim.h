@@ -0,0 +1,111 @@
+/**
+ * @file modbus_slave_sim.h
+ * @brief Pseudo-terminal Modbus RTU slave simulator for bus benchmarks
+ * @version 1.0.0
+ * @date 2025-02-15
+ * @team FW
+ *
+ * Opens a pty pair and answers FC03/FC04/FC06/FC16 requests on the master
+ * side for the power, safety, travel-motor and dock modules, seeded from the
+ * register_info maps. The HAL opens the slave side (modbus_slave_sim_start()
+ * returns its path) exactly as it would open /dev/ttyOHT485, so the whole
+ * RS485 -> comm manager -> bus master -> polling stack runs unmodified.
+ *
+ * Faults are injected per request: fixed plus random response latency,
+ * corrupted CRCs and unanswered requests (master sees a timeout).
+ */
+
+#ifndef MODBUS_SLAVE_SIM_H
+#define MODBUS_SLAVE_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "hal_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MODBUS_SLAVE_SIM_PATH_MAX   64
+
+// Fault injection settings
+typedef struct {
+    uint32_t latency_us;            // Delay before every response
+    uint32_t jitter_us;             // Extra random delay, 0..jitter_us
+    uint16_t crc_error_permille;    // Responses sent with a corrupted CRC
+    uint16_t timeout_permille;      // Requests left unanswered
+    uint32_t seed;                  // PRNG seed, fixed for repeatable runs
+} modbus_slave_sim_faults_t;
+
+// Simulator counters
+typedef struct {
+    uint64_t requests;              // Well-formed requests addressed to an emulated module
+    uint64_t responses;             // Normal responses sent
+    uint64_t exceptions;            // Exception responses sent
+    uint64_t crc_errors_injected;
+    uint64_t timeouts_injected;
+    uint64_t bad_frames;            // Requests dropped on CRC or framing errors
+    uint64_t foreign;               // Requests for addresses nobody answers
+} modbus_slave_sim_stats_t;
+
+/**
+ * @brief Create the pty pair and start the responder thread
+ * @param faults Fault injection settings (NULL for none)
+ * @param slave_path Receives the path the master should open
+ * @param path_len Size of slave_path
+ * @return HAL status
+ */
+hal_status_t modbus_slave_sim_start(const modbus_slave_sim_faults_t *faults, char *slave_path, size_t path_len);
+
+/**
+ * @brief Stop the responder thread and close the pty
+ * @return HAL status
+ */
+hal_status_t modbus_slave_sim_stop(void);
+
+/**
+ * @brief Change fault injection while running
+ * @param faults New settings
+ * @return HAL status
+ */
+hal_status_t modbus_slave_sim_set_faults(const modbus_slave_sim_faults_t *faults);
+
+/**
+ * @brief Set a register of an emulated module
+ * @param module_addr Module address (MODULE_ADDR_*)
+ * @param reg Register address
+ * @param value Value
+ * @return HAL_STATUS_INVALID_PARAMETER if the module is not emulated
+ */
+hal_status_t modbus_slave_sim_set_register(uint8_t module_addr, uint16_t reg, uint16_t value);
+
+/**
+ * @brief Plug or unplug an emulated module; an unplugged one never answers
+ * @param module_addr Module address (MODULE_ADDR_*)
+ * @param present false to leave its requests unanswered
+ * @return HAL_STATUS_INVALID_PARAMETER if the module is not emulated
+ */
+hal_status_t modbus_slave_sim_set_present(uint8_t module_addr, bool present);
+
+/**
+ * @brief Read a register of an emulated module (e.g. after a master write)
+ * @param module_addr Module address
+ * @param reg Register address
+ * @param value Output value
+ * @return HAL status
+ */
+hal_status_t modbus_slave_sim_get_register(uint8_t module_addr, uint16_t reg, uint16_t *value);
+
+/**
+ * @brief Get simulator counters
+ * @param stats Output counters
+ * @return HAL status
+ */
+hal_status_t modbus_slave_sim_get_stats(modbus_slave_sim_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MODBUS_SLAVE_SIM_H
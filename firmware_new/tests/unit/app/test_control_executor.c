@@ -0,0 +1,226 @@
+/**
+ * @file test_control_executor.c
+ * @brief Unit tests for the fixed-rate control executor
+ */
+
+#include "unity.h"
+#include "control_executor.h"
+#include "control_loop.h"
+#include "estimator_1d.h"
+#include "hal_common.h"
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+static control_config_t cfg;
+static control_executor_config_t exec_cfg;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_start_rejects_bad_config(void);
+void test_runs_one_control_cycle_per_period(void);
+void test_second_start_is_refused(void);
+void test_reset_stats_while_running(void);
+void test_estimator_follows_the_loop(void);
+void test_bucket_limits(void);
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+void setUp(void)
+{
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.control_frequency = 500.0f;
+    cfg.sample_time = 0.002f;
+    cfg.velocity_pid.kp = 1.0f;
+    cfg.velocity_pid.ki = 0.1f;
+    cfg.velocity_pid.output_min = -1.0f;
+    cfg.velocity_pid.output_max = 1.0f;
+    cfg.velocity_pid.integral_min = -10.0f;
+    cfg.velocity_pid.integral_max = 10.0f;
+    cfg.profile.max_velocity = 1000.0f;
+    cfg.profile.max_acceleration = 500.0f;
+    cfg.profile.max_jerk = 100.0f;
+    cfg.profile.velocity_tolerance = 5.0f;
+    cfg.enable_limits = true;
+    cfg.enable_safety = false;
+
+    // Stock kernel, unprivileged: normal scheduling, no pinning, no mlockall
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_get_default_config(&exec_cfg));
+    exec_cfg.period_us = 2000;
+    exec_cfg.priority = 0;
+    exec_cfg.cpu = CONTROL_EXECUTOR_CPU_NONE;
+    exec_cfg.lock_memory = false;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_init(&cfg));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_set_mode(CONTROL_MODE_VELOCITY));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_enable());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_set_target_velocity(100.0f));
+    (void)estimator_1d_init();
+}
+
+void tearDown(void)
+{
+    (void)control_executor_stop();
+    (void)control_loop_deinit();
+}
+
+void test_start_rejects_bad_config(void)
+{
+    setUp();
+    control_executor_config_t bad = exec_cfg;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, control_executor_start(NULL));
+    bad.period_us = CONTROL_EXECUTOR_MIN_PERIOD_US - 1U;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, control_executor_start(&bad));
+    bad.period_us = CONTROL_EXECUTOR_MAX_PERIOD_US + 1U;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, control_executor_start(&bad));
+    bad = exec_cfg;
+    bad.priority = 100;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, control_executor_start(&bad));
+    TEST_ASSERT_FALSE(control_executor_is_running());
+
+    // Stopping a stopped executor is harmless
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_stop());
+    tearDown();
+}
+
+void test_runs_one_control_cycle_per_period(void)
+{
+    setUp();
+    uint64_t started = now_us();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_start(&exec_cfg));
+    TEST_ASSERT_TRUE(control_executor_is_running());
+    usleep(300000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_stop());
+    uint64_t elapsed = now_us() - started;
+    TEST_ASSERT_FALSE(control_executor_is_running());
+
+    control_executor_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_get_stats(&stats));
+    printf(" [%llu cycles, jitter avg %.1f p99 %u max %u us]", (unsigned long long)stats.cycles,
+           (double)stats.jitter_avg_us, stats.jitter_p99_us, stats.jitter_max_us);
+
+    // About 150 periods in 300 ms, and never more deadlines than the time allows
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(120, stats.cycles);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(elapsed / exec_cfg.period_us, stats.cycles + stats.missed_deadlines);
+    TEST_ASSERT_EQUAL(2000, stats.period_us);
+    TEST_ASSERT_FALSE(stats.realtime);
+    TEST_ASSERT_FALSE(stats.memory_locked);
+    TEST_ASSERT_EQUAL(-1, stats.cpu);
+    TEST_ASSERT_EQUAL(0, stats.interlock_trips);
+    TEST_ASSERT_FALSE(stats.interlock_active);
+
+    uint64_t jitter_total = 0;
+    uint64_t exec_total = 0;
+    for (uint32_t b = 0; b < CONTROL_EXECUTOR_HIST_BUCKETS; b++) {
+        jitter_total += stats.jitter_hist[b];
+        exec_total += stats.exec_hist[b];
+    }
+    TEST_ASSERT_EQUAL(stats.cycles, jitter_total);
+    TEST_ASSERT_EQUAL(stats.cycles, exec_total);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(stats.jitter_max_us, stats.jitter_p99_us);
+
+    // No sample_time gate in between: every executor cycle is a control cycle
+    control_stats_t control_stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_get_stats(&control_stats));
+    TEST_ASSERT_EQUAL(stats.cycles, control_stats.total_cycles);
+
+    control_mode_t mode;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_get_mode(&mode));
+    TEST_ASSERT_EQUAL(CONTROL_MODE_VELOCITY, mode);
+    tearDown();
+}
+
+void test_second_start_is_refused(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_start(&exec_cfg));
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_INITIALIZED, control_executor_start(&exec_cfg));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_stop());
+
+    // And it can be started again once stopped
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_start(&exec_cfg));
+    TEST_ASSERT_TRUE(control_executor_is_running());
+    tearDown();
+}
+
+void test_reset_stats_while_running(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_start(&exec_cfg));
+    usleep(100000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_reset_stats());
+    usleep(20000);
+
+    control_executor_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_get_stats(&stats));
+    TEST_ASSERT_TRUE(stats.running);
+    TEST_ASSERT_GREATER_THAN(0, stats.cycles);
+    TEST_ASSERT_LESS_THAN(30, stats.cycles);
+
+    // Stopped: cleared at once
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_stop());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_reset_stats());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_get_stats(&stats));
+    TEST_ASSERT_EQUAL(0, stats.cycles);
+    TEST_ASSERT_EQUAL(0, stats.jitter_max_us);
+    tearDown();
+}
+
+void test_estimator_follows_the_loop(void)
+{
+    setUp();
+    est1d_state_t before;
+    TEST_ASSERT_EQUAL(0, estimator_1d_get_state(&before));
+    TEST_ASSERT_FALSE(before.health_online);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_start(&exec_cfg));
+    usleep(50000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_stop());
+
+    est1d_state_t after;
+    TEST_ASSERT_EQUAL(0, estimator_1d_get_state(&after));
+    TEST_ASSERT_TRUE(after.health_online);
+    TEST_ASSERT_GREATER_THAN(0, after.last_update_ms);
+
+    // A disabled loop leaves the estimator alone
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_loop_disable());
+    (void)estimator_1d_init();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_start(&exec_cfg));
+    usleep(20000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, control_executor_stop());
+    TEST_ASSERT_EQUAL(0, estimator_1d_get_state(&after));
+    TEST_ASSERT_FALSE(after.health_online);
+    tearDown();
+}
+
+void test_bucket_limits(void)
+{
+    TEST_ASSERT_EQUAL(1, control_executor_bucket_limit_us(0));
+    TEST_ASSERT_EQUAL(2, control_executor_bucket_limit_us(1));
+    TEST_ASSERT_EQUAL(1024, control_executor_bucket_limit_us(10));
+    TEST_ASSERT_EQUAL(UINT32_MAX, control_executor_bucket_limit_us(CONTROL_EXECUTOR_HIST_BUCKETS - 1U));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== Control Executor Tests ===\n");
+
+    RUN_TEST(test_start_rejects_bad_config);
+    RUN_TEST(test_runs_one_control_cycle_per_period);
+    RUN_TEST(test_second_start_is_refused);
+    RUN_TEST(test_reset_stats_while_running);
+    RUN_TEST(test_estimator_follows_the_loop);
+    RUN_TEST(test_bucket_limits);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file test_http_event_server.c
+ * @brief Unit tests for the shared epoll HTTP server core over loopback
+ */
+
+#include "unity.h"
+#include "http_event_server.h"
+#include "hal_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define TEST_SLOW_HANDLER_MS    300
+#define TEST_FAST_LIMIT_MS      150
+#define TEST_RECV_TIMEOUT_SEC   2
+
+static http_event_server_t *server;
+
+typedef struct {
+    int status;
+    char body[256];
+    bool close;
+} test_response_t;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_keep_alive_reuses_connection(void);
+void test_pipelined_requests_split_across_writes(void);
+void test_slow_handler_does_not_block_other_clients(void);
+void test_route_latency_histograms(void);
+void test_framing_errors_and_connection_close(void);
+
+// Echoes method, target and body; /slow sleeps like an RS485-backed handler
+static void echo_handler(const http_event_request_t *request, http_event_response_t *response, void *user_data)
+{
+    (void)user_data;
+    char body[256];
+
+    if (strcmp(request->target, "/slow") == 0) {
+        usleep(TEST_SLOW_HANDLER_MS * 1000);
+    }
+    int len = snprintf(body, sizeof(body), "%s %s %.*s", request->method, request->target,
+                       (int)request->body_length, request->body ? request->body : "");
+    response->status_code = 200;
+    response->body = malloc((size_t)len);
+    memcpy(response->body, body, (size_t)len);
+    response->body_length = (size_t)len;
+    snprintf(response->route, sizeof(response->route), "%.63s", request->target);
+}
+
+static int connect_client(void)
+{
+    struct sockaddr_in addr;
+    struct timeval timeout = { .tv_sec = TEST_RECV_TIMEOUT_SEC, .tv_usec = 0 };
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(http_event_server_get_port(server));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    TEST_ASSERT_EQUAL(0, connect(fd, (struct sockaddr *)&addr, sizeof(addr)));
+    return fd;
+}
+
+static void send_text(int fd, const char *text)
+{
+    size_t len = strlen(text);
+    TEST_ASSERT_EQUAL((int)len, (int)send(fd, text, len, 0));
+}
+
+/**
+ * @brief Read exactly one response, leaving any following bytes in the socket
+ */
+static int read_response(int fd, test_response_t *out)
+{
+    char head[1024];
+    size_t head_len = 0;
+
+    memset(out, 0, sizeof(*out));
+    while (head_len < sizeof(head) - 1) {
+        ssize_t n = recv(fd, head + head_len, 1, 0);
+        if (n <= 0) {
+            return -1;
+        }
+        head_len++;
+        head[head_len] = '\0';
+        if (head_len >= 4 && strcmp(head + head_len - 4, "\r\n\r\n") == 0) {
+            break;
+        }
+    }
+
+    size_t body_len = 0;
+    const char *cl = strstr(head, "Content-Length: ");
+    if (sscanf(head, "HTTP/1.1 %d", &out->status) != 1 || cl == NULL) {
+        return -1;
+    }
+    body_len = (size_t)strtoul(cl + 16, NULL, 10);
+    out->close = strstr(head, "Connection: close") != NULL;
+
+    size_t got = 0;
+    while (got < body_len && got < sizeof(out->body) - 1) {
+        ssize_t n = recv(fd, out->body + got, body_len - got, 0);
+        if (n <= 0) {
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    out->body[got] = '\0';
+    return 0;
+}
+
+void setUp(void)
+{
+    http_event_server_config_t config = {
+        .port = 0,
+        .worker_count = 4,
+        .idle_timeout_ms = 5000,
+        .keep_alive = true,
+        .handler = echo_handler,
+        .name = "HTTP_TEST"
+    };
+
+    server = NULL;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_event_server_create(&config, &server));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_event_server_start(server));
+    TEST_ASSERT_TRUE(http_event_server_get_port(server) != 0);
+}
+
+void tearDown(void)
+{
+    http_event_server_destroy(server);
+    server = NULL;
+}
+
+void test_keep_alive_reuses_connection(void)
+{
+    setUp();
+    test_response_t response;
+    http_event_server_stats_t stats;
+    int fd = connect_client();
+
+    for (int i = 0; i < 3; i++) {
+        send_text(fd, "GET /a HTTP/1.1\r\nHost: x\r\n\r\n");
+        TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+        TEST_ASSERT_EQUAL(200, response.status);
+        TEST_ASSERT_EQUAL_STRING("GET /a ", response.body);
+        TEST_ASSERT_FALSE(response.close);
+    }
+    close(fd);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_event_server_get_stats(server, &stats));
+    TEST_ASSERT_EQUAL_UINT(1, stats.connections_accepted);
+    TEST_ASSERT_EQUAL_UINT(3, stats.requests);
+    TEST_ASSERT_EQUAL_UINT(2, stats.keepalive_reuses);
+    tearDown();
+}
+
+void test_pipelined_requests_split_across_writes(void)
+{
+    setUp();
+    static const char pipeline[] =
+        "POST /cmd HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello"
+        "GET /one HTTP/1.1\r\n\r\n"
+        "GET /two HTTP/1.1\r\n\r\n";
+    static const size_t cuts[] = { 7, 30, 41, 44, 60, sizeof(pipeline) - 1 };
+    test_response_t response;
+    http_event_server_stats_t stats;
+    int fd = connect_client();
+
+    // Dribble the bytes in so request heads and the body straddle reads
+    size_t sent = 0;
+    for (size_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++) {
+        TEST_ASSERT_EQUAL((int)(cuts[i] - sent), (int)send(fd, pipeline + sent, cuts[i] - sent, 0));
+        sent = cuts[i];
+        usleep(10000);
+    }
+
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_EQUAL_STRING("POST /cmd hello", response.body);
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_EQUAL_STRING("GET /one ", response.body);
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_EQUAL_STRING("GET /two ", response.body);
+    close(fd);
+
+    // All three in one write: the later two are framed from the buffer
+    fd = connect_client();
+    send_text(fd, pipeline);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    }
+    TEST_ASSERT_EQUAL_STRING("GET /two ", response.body);
+    close(fd);
+
+    http_event_server_get_stats(server, &stats);
+    TEST_ASSERT_EQUAL_UINT(6, stats.requests);
+    TEST_ASSERT_TRUE(stats.pipelined_requests >= 2);
+    tearDown();
+}
+
+typedef struct {
+    int fd;
+    test_response_t response;
+} slow_client_t;
+
+static void* slow_client_thread(void *arg)
+{
+    slow_client_t *client = (slow_client_t *)arg;
+    send_text(client->fd, "GET /slow HTTP/1.1\r\n\r\n");
+    read_response(client->fd, &client->response);
+    return NULL;
+}
+
+void test_slow_handler_does_not_block_other_clients(void)
+{
+    setUp();
+    slow_client_t slow = { .fd = connect_client() };
+    pthread_t thread;
+    test_response_t response;
+
+    pthread_create(&thread, NULL, slow_client_thread, &slow);
+    usleep(20000);  // Let /slow reach a worker first
+
+    int fd = connect_client();
+    uint64_t start_ms = hal_get_timestamp_ms();
+    send_text(fd, "GET /fast HTTP/1.1\r\n\r\n");
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    uint64_t fast_ms = hal_get_timestamp_ms() - start_ms;
+    TEST_ASSERT_EQUAL_STRING("GET /fast ", response.body);
+    TEST_ASSERT_LESS_THAN(TEST_FAST_LIMIT_MS, (int)fast_ms);
+
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQUAL(200, slow.response.status);
+    TEST_ASSERT_EQUAL_STRING("GET /slow ", slow.response.body);
+    close(fd);
+    close(slow.fd);
+    tearDown();
+}
+
+void test_route_latency_histograms(void)
+{
+    setUp();
+    http_event_route_stats_t routes[8];
+    uint32_t count = 0;
+    test_response_t response;
+    int fd = connect_client();
+
+    for (int i = 0; i < 4; i++) {
+        send_text(fd, "GET /fast HTTP/1.1\r\n\r\n");
+        read_response(fd, &response);
+    }
+    send_text(fd, "GET /slow HTTP/1.1\r\n\r\n");
+    read_response(fd, &response);
+    close(fd);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_event_server_get_route_stats(server, routes, 8, &count));
+    TEST_ASSERT_EQUAL_UINT(2, count);
+    for (uint32_t r = 0; r < count; r++) {
+        uint64_t bucket_total = 0;
+        for (int b = 0; b < HTTP_EVENT_LATENCY_BUCKETS; b++) {
+            bucket_total += routes[r].buckets[b];
+        }
+        TEST_ASSERT_TRUE(bucket_total == routes[r].count);
+
+        if (strcmp(routes[r].route, "/fast") == 0) {
+            TEST_ASSERT_EQUAL_UINT(4, routes[r].count);
+        } else {
+            TEST_ASSERT_EQUAL_STRING("/slow", routes[r].route);
+            TEST_ASSERT_EQUAL_UINT(1, routes[r].count);
+            // 300 ms lands in the +inf bucket
+            TEST_ASSERT_EQUAL_UINT(1, routes[r].buckets[HTTP_EVENT_LATENCY_BUCKETS - 1]);
+            TEST_ASSERT_TRUE(routes[r].max_us >= TEST_SLOW_HANDLER_MS * 1000ULL);
+        }
+    }
+    tearDown();
+}
+
+void test_framing_errors_and_connection_close(void)
+{
+    setUp();
+    test_response_t response;
+    http_event_server_stats_t stats;
+    char byte;
+
+    // Client asks to close: response says so and the server hangs up
+    int fd = connect_client();
+    send_text(fd, "GET /bye HTTP/1.1\r\nConnection: close\r\n\r\n");
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_TRUE(response.close);
+    TEST_ASSERT_EQUAL(0, (int)recv(fd, &byte, 1, 0));
+    close(fd);
+
+    // HTTP/1.0 without keep-alive is closed too
+    fd = connect_client();
+    send_text(fd, "GET /old HTTP/1.0\r\n\r\n");
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_TRUE(response.close);
+    close(fd);
+
+    // Body larger than the connection buffer
+    fd = connect_client();
+    send_text(fd, "POST /big HTTP/1.1\r\nContent-Length: 100000\r\n\r\n");
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_EQUAL(413, response.status);
+    TEST_ASSERT_EQUAL(0, (int)recv(fd, &byte, 1, 0));
+    close(fd);
+
+    // Garbage request line
+    fd = connect_client();
+    send_text(fd, "NONSENSE\r\n\r\n");
+    TEST_ASSERT_EQUAL(0, read_response(fd, &response));
+    TEST_ASSERT_EQUAL(400, response.status);
+    close(fd);
+
+    http_event_server_get_stats(server, &stats);
+    TEST_ASSERT_EQUAL_UINT(2, stats.parse_errors);
+    TEST_ASSERT_EQUAL_UINT(2, stats.requests);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== HTTP EVENT SERVER TESTS ===\n");
+
+    RUN_TEST(test_keep_alive_reuses_connection);
+    RUN_TEST(test_pipelined_requests_split_across_writes);
+    RUN_TEST(test_slow_handler_does_not_block_other_clients);
+    RUN_TEST(test_route_latency_histograms);
+    RUN_TEST(test_framing_errors_and_connection_close);
+
+    UNITY_END();
+    return 0;
+}
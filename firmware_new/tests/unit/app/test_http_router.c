@@ -0,0 +1,168 @@
+/**
+ * @file test_http_router.c
+ * @brief Unit tests for the path-segment trie route table
+ */
+
+#include "unity.h"
+#include "http_router.h"
+#include "hal_common.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TEST_GET    0
+#define TEST_POST   1
+#define TEST_LOOKUPS 100000
+
+static http_router_t *router;
+static int target_health;
+static int target_stats;
+static int target_telemetry;
+static int target_register_get;
+static int target_register_post;
+static int target_file;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_literal_and_typed_params(void);
+void test_literal_wins_over_param(void);
+void test_param_validation(void);
+void test_method_and_pattern_errors(void);
+void test_many_routes_lookup_cost(void);
+
+void setUp(void)
+{
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_create(&router));
+    http_router_add(router, TEST_GET, "/health", &target_health);
+    http_router_add(router, TEST_GET, "/api/v1/modules/stats", &target_stats);
+    http_router_add(router, TEST_GET, "/api/v1/modules/{id:u8}/telemetry", &target_telemetry);
+    http_router_add(router, TEST_GET, "/api/v1/modules/{id:u8}/registers/{reg:hex16}", &target_register_get);
+    http_router_add(router, TEST_POST, "/api/v1/modules/{id:u8}/registers/{reg:hex16}", &target_register_post);
+    http_router_add(router, TEST_GET, "/files/{name}", &target_file);
+}
+
+void tearDown(void)
+{
+    http_router_destroy(router);
+    router = NULL;
+}
+
+void test_literal_and_typed_params(void)
+{
+    setUp();
+    http_router_match_t match;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_match(router, TEST_GET, "/health", &match));
+    TEST_ASSERT_TRUE(match.target == &target_health);
+    TEST_ASSERT_EQUAL_UINT(0, match.param_count);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_match(router, TEST_POST, "/api/v1/modules/0x02/registers/0x0040?x=1", &match));
+    TEST_ASSERT_TRUE(match.target == &target_register_post);
+    TEST_ASSERT_EQUAL_STRING("/api/v1/modules/{id:u8}/registers/{reg:hex16}", match.pattern);
+    TEST_ASSERT_EQUAL_UINT(2, match.param_count);
+    TEST_ASSERT_EQUAL_STRING("id", match.params[0].name);
+    TEST_ASSERT_EQUAL_UINT(2, match.params[0].number);
+    TEST_ASSERT_EQUAL_UINT(0x40, http_router_find_param(match.params, match.param_count, "reg")->number);
+    TEST_ASSERT_TRUE(http_router_find_param(match.params, match.param_count, "missing") == NULL);
+
+    // Bare hex for hex16, decimal for u8, trailing slash tolerated
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_match(router, TEST_GET, "/api/v1/modules/3/registers/A1/", &match));
+    TEST_ASSERT_EQUAL_UINT(3, match.params[0].number);
+    TEST_ASSERT_EQUAL_UINT(0xA1, match.params[1].number);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_match(router, TEST_GET, "/files/log.txt", &match));
+    TEST_ASSERT_EQUAL_STRING("log.txt", match.params[0].value);
+    tearDown();
+}
+
+void test_literal_wins_over_param(void)
+{
+    setUp();
+    http_router_match_t match;
+
+    http_router_add(router, TEST_GET, "/api/v1/modules/{id:u8}", &target_telemetry);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_match(router, TEST_GET, "/api/v1/modules/stats", &match));
+    TEST_ASSERT_TRUE(match.target == &target_stats);
+    TEST_ASSERT_EQUAL_UINT(0, match.param_count);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_match(router, TEST_GET, "/api/v1/modules/5", &match));
+    TEST_ASSERT_TRUE(match.target == &target_telemetry);
+    tearDown();
+}
+
+void test_param_validation(void)
+{
+    setUp();
+    http_router_match_t match;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, http_router_match(router, TEST_GET, "/api/v1/modules/300/telemetry", &match));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, http_router_match(router, TEST_GET, "/api/v1/modules/two/telemetry", &match));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, http_router_match(router, TEST_GET, "/api/v1/modules/2/registers/0x10000", &match));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, http_router_match(router, TEST_GET, "/api/v1/modules/2/registers/zz", &match));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, http_router_match(router, TEST_GET, "/api/v1/modules/2", &match));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, http_router_match(router, TEST_GET, "/api/v1/modules/2/telemetry/extra", &match));
+    TEST_ASSERT_EQUAL_UINT(0, match.param_count);
+    tearDown();
+}
+
+void test_method_and_pattern_errors(void)
+{
+    setUp();
+    http_router_match_t match;
+    int other;
+
+    // Path exists, method does not: callers answer 405
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_SUPPORTED, http_router_match(router, TEST_POST, "/health", &match));
+    TEST_ASSERT_EQUAL_STRING("/health", match.pattern);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_EXISTS, http_router_add(router, TEST_GET, "/health", &other));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, http_router_add(router, TEST_GET, "/x/{id:float}", &other));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, http_router_add(router, TEST_GET, "/x/{}", &other));
+    // A second spelling of an existing capture position would be ambiguous
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER,
+                      http_router_add(router, TEST_GET, "/api/v1/modules/{addr:u8}/health", &other));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, http_router_add(router, HTTP_ROUTER_MAX_METHODS, "/y", &other));
+    TEST_ASSERT_EQUAL_UINT(6, http_router_route_count(router));
+    tearDown();
+}
+
+void test_many_routes_lookup_cost(void)
+{
+    setUp();
+    static char patterns[64][64];
+    static int targets[64];
+    http_router_match_t match;
+    struct timespec t0, t1;
+
+    for (int i = 0; i < 64; i++) {
+        snprintf(patterns[i], sizeof(patterns[i]), "/api/v1/group%d/item%d", i % 8, i);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_router_add(router, TEST_GET, patterns[i], &targets[i]));
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int n = 0; n < TEST_LOOKUPS; n++) {
+        http_router_match(router, TEST_GET, "/api/v1/group7/item63", &match);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    TEST_ASSERT_TRUE(match.target == &targets[63]);
+
+    double ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / TEST_LOOKUPS;
+    printf("Lookup of the last of 70 routes: %.0f ns\n", ns);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== HTTP ROUTER TESTS ===\n");
+
+    RUN_TEST(test_literal_and_typed_params);
+    RUN_TEST(test_literal_wins_over_param);
+    RUN_TEST(test_param_validation);
+    RUN_TEST(test_method_and_pattern_errors);
+    RUN_TEST(test_many_routes_lookup_cost);
+
+    UNITY_END();
+    return 0;
+}
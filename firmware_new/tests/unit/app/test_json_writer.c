@@ -0,0 +1,397 @@
+/**
+ * @file test_json_writer.c
+ * @brief Unit tests for the streaming JSON writer and its arena
+ */
+
+#include "unity.h"
+#include "json_writer.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_nesting_and_separators(void);
+void test_string_escaping(void);
+void test_integer_formatting(void);
+void test_fixed_point_formatting(void);
+void test_fixed_point_matches_printf(void);
+void test_hex_formatting(void);
+void test_fixed_buffer_never_truncates_silently(void);
+void test_misuse_is_reported(void);
+void test_heap_writer_grows(void);
+void test_arena_reuses_memory(void);
+void test_thread_arenas_are_separate(void);
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_nesting_and_separators(void)
+{
+    setUp();
+    char buf[256];
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_object(&w);
+    json_writer_field_bool(&w, "success", true);
+    json_writer_key(&w, "data");
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "name", "OHT-50");
+    json_writer_field_int(&w, "offset", -12);
+    json_writer_field_null(&w, "missing");
+    json_writer_key(&w, "bins");
+    json_writer_begin_array(&w);
+    json_writer_uint(&w, 1);
+    json_writer_uint(&w, 22);
+    json_writer_begin_object(&w);
+    json_writer_end_object(&w);
+    json_writer_begin_array(&w);
+    json_writer_end_array(&w);
+    json_writer_end_array(&w);
+    json_writer_end_object(&w);
+    json_writer_end_object(&w);
+
+    size_t len = 0;
+    const char *json = json_writer_data(&w, &len);
+    TEST_ASSERT_NOT_NULL(json);
+    TEST_ASSERT_EQUAL_STRING("{\"success\":true,\"data\":{\"name\":\"OHT-50\",\"offset\":-12,\"missing\":null,"
+                             "\"bins\":[1,22,{},[]]}}", json);
+    TEST_ASSERT_EQUAL((int)strlen(json), (int)len);
+    tearDown();
+}
+
+void test_string_escaping(void)
+{
+    setUp();
+    char buf[256];
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_array(&w);
+    json_writer_string(&w, "say \"hi\"\\ \n\t\r\b\f");
+    json_writer_string(&w, "\x01\x1f");
+    json_writer_string(&w, "caf\xc3\xa9 /");
+    json_writer_string_len(&w, "a\0b", 3);
+    json_writer_string(&w, NULL);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL_STRING("[\"say \\\"hi\\\"\\\\ \\n\\t\\r\\b\\f\",\"\\u0001\\u001F\",\"caf\xc3\xa9 /\","
+                             "\"a\\u0000b\",null]", json_writer_data(&w, NULL));
+
+    // Keys take the same escaping, on both sides of a plain key
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "a\"b", "");
+    json_writer_field_uint(&w, "plain", 1);
+    json_writer_field_bool(&w, "tab\there", true);
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL_STRING("{\"a\\\"b\":\"\",\"plain\":1,\"tab\\there\":true}", json_writer_data(&w, NULL));
+    tearDown();
+}
+
+void test_integer_formatting(void)
+{
+    setUp();
+    char buf[256];
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_array(&w);
+    json_writer_int(&w, 0);
+    json_writer_int(&w, 9);
+    json_writer_int(&w, -10);
+    json_writer_int(&w, INT64_MIN);
+    json_writer_int(&w, INT64_MAX);
+    json_writer_uint(&w, UINT64_MAX);
+    json_writer_uint(&w, 1000000);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL_STRING("[0,9,-10,-9223372036854775808,9223372036854775807,18446744073709551615,1000000]",
+                             json_writer_data(&w, NULL));
+    tearDown();
+}
+
+void test_fixed_point_formatting(void)
+{
+    setUp();
+    char buf[512];
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_array(&w);
+    json_writer_fixed(&w, 3.14159, 2);
+    json_writer_fixed(&w, 0.5, 3);
+    json_writer_fixed(&w, 123456.789, 2);
+    json_writer_fixed(&w, -2.75, 1);
+    json_writer_fixed(&w, -0.04, 1);
+    json_writer_fixed(&w, 7.0, 0);
+    json_writer_fixed(&w, 0.000001, 6);
+    json_writer_fixed(&w, NAN, 2);
+    json_writer_fixed(&w, INFINITY, 2);
+    json_writer_fixed(&w, 1.0e20, 1);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL_STRING("[3.14,0.500,123456.79,-2.8,0.0,7,0.000001,null,null,100000000000000000000.0]",
+                             json_writer_data(&w, NULL));
+
+    // Significant digits, like "%.6g"
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_array(&w);
+    json_writer_double(&w, 24.125, 6);
+    json_writer_double(&w, 1234567.0, 6);
+    json_writer_double(&w, -0.000125, 6);
+    json_writer_double(&w, NAN, 6);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL_STRING("[24.125,1.23457e+06,-0.000125,null]", json_writer_data(&w, NULL));
+    tearDown();
+}
+
+void test_fixed_point_matches_printf(void)
+{
+    setUp();
+    // Away from exact ties the result is the one printf gives
+    srand(50);
+    int mismatches = 0;
+    for (int i = 0; i < 20000; i++) {
+        double value = ((double)rand() / RAND_MAX - 0.5) * 2.0e6;
+        uint8_t decimals = (uint8_t)(i % 5);
+        char expected[64];
+        char buf[64];
+        snprintf(expected, sizeof(expected), "%.*f", (int)decimals, value);
+        json_writer_t w;
+        json_writer_init(&w, buf, sizeof(buf));
+        json_writer_fixed(&w, value, decimals);
+        const char *json = json_writer_data(&w, NULL);
+        TEST_ASSERT_NOT_NULL(json);
+        if (strcmp(expected, json) != 0) {
+            mismatches++;
+            // A tie rounded the other way: one unit in the last place
+            TEST_ASSERT_TRUE(fabs(strtod(expected, NULL) - strtod(json, NULL)) <= 1.01 / pow(10.0, decimals));
+        }
+    }
+    printf(" [%d/20000 last-digit ties]", mismatches);
+    TEST_ASSERT_LESS_THAN(20, mismatches);
+    tearDown();
+}
+
+void test_hex_formatting(void)
+{
+    setUp();
+    char buf[128];
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_object(&w);
+    json_writer_field_hex(&w, "reg", 0x000A, 4);
+    json_writer_field_hex(&w, "addr", 0x02, 2);
+    json_writer_field_hex(&w, "wide", 0x12345, 4);
+    json_writer_field_hex(&w, "max", 0xFFFFFFFFU, 1);
+    json_writer_key(&w, "data");
+    const uint8_t bytes[] = { 0x01, 0xAB, 0xFF };
+    json_writer_hex_bytes(&w, bytes, sizeof(bytes));
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL_STRING("{\"reg\":\"0x000A\",\"addr\":\"0x02\",\"wide\":\"0x12345\",\"max\":\"0xFFFFFFFF\","
+                             "\"data\":\"01ABFF\"}", json_writer_data(&w, NULL));
+    tearDown();
+}
+
+void test_fixed_buffer_never_truncates_silently(void)
+{
+    setUp();
+    char buf[32];
+    memset(buf, 'X', sizeof(buf));
+    json_writer_t w;
+    json_writer_init(&w, buf, 16);
+    json_writer_begin_object(&w);
+    json_writer_field_string(&w, "message", "this does not fit");
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL(HAL_STATUS_NO_MEMORY, json_writer_status(&w));
+    TEST_ASSERT_NULL(json_writer_data(&w, NULL));
+    for (size_t i = 16; i < sizeof(buf); i++) {
+        TEST_ASSERT_EQUAL('X', buf[i]);
+    }
+
+    // Exactly full is fine: 15 characters and the NUL
+    json_writer_init(&w, buf, 16);
+    json_writer_string(&w, "1234567890123");
+    TEST_ASSERT_EQUAL_STRING("\"1234567890123\"", json_writer_data(&w, NULL));
+    tearDown();
+}
+
+void test_misuse_is_reported(void)
+{
+    setUp();
+    char buf[128];
+    json_writer_t w;
+
+    // A value where a key is expected
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_object(&w);
+    json_writer_uint(&w, 1);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, json_writer_status(&w));
+
+    // A key inside an array
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_array(&w);
+    json_writer_key(&w, "k");
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, json_writer_status(&w));
+
+    // Mismatched close
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_object(&w);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, json_writer_status(&w));
+
+    // A key without a value
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_object(&w);
+    json_writer_key(&w, "k");
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, json_writer_status(&w));
+
+    // Unclosed document, then a second root
+    json_writer_init(&w, buf, sizeof(buf));
+    json_writer_begin_array(&w);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_writer_status(&w));
+    TEST_ASSERT_NULL(json_writer_data(&w, NULL));
+    json_writer_end_array(&w);
+    TEST_ASSERT_NOT_NULL(json_writer_data(&w, NULL));
+    json_writer_null(&w);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, json_writer_status(&w));
+
+    // Too deep
+    json_writer_init(&w, buf, sizeof(buf));
+    for (int i = 0; i <= JSON_WRITER_MAX_DEPTH; i++) {
+        json_writer_begin_array(&w);
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, json_writer_status(&w));
+    tearDown();
+}
+
+void test_heap_writer_grows(void)
+{
+    setUp();
+    json_writer_t w;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_writer_init_heap(&w, 8));
+    json_writer_begin_array(&w);
+    for (uint32_t i = 0; i < 10000; i++) {
+        json_writer_uint(&w, i);
+    }
+    json_writer_end_array(&w);
+    size_t len = 0;
+    char *json = json_writer_take(&w, &len);
+    TEST_ASSERT_NOT_NULL(json);
+    TEST_ASSERT_EQUAL(48891, (int)len);
+    TEST_ASSERT_EQUAL((int)len, (int)strlen(json));
+    TEST_ASSERT_EQUAL(0, strncmp(json, "[0,1,2,3,", 9));
+    TEST_ASSERT_EQUAL(0, strcmp(json + len - 6, ",9999]"));
+    free(json);
+    TEST_ASSERT_NULL(json_writer_take(&w, NULL));
+    tearDown();
+}
+
+static void write_document(json_arena_t *arena, uint32_t items)
+{
+    json_writer_t w;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_writer_init_arena(&w, arena, 64));
+    json_writer_begin_array(&w);
+    for (uint32_t i = 0; i < items; i++) {
+        json_writer_uint(&w, 1000000U + i);
+    }
+    json_writer_end_array(&w);
+    size_t len = 0;
+    TEST_ASSERT_NOT_NULL(json_writer_data(&w, &len));
+    TEST_ASSERT_EQUAL((int)(items * 8U + 1U), (int)len);
+}
+
+void test_arena_reuses_memory(void)
+{
+    setUp();
+    json_arena_t arena;
+    json_arena_stats_t stats;
+    json_arena_init(&arena, 4096);
+
+    // Fits one chunk: grown in place, one malloc
+    write_document(&arena, 400);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_arena_get_stats(&arena, &stats));
+    TEST_ASSERT_EQUAL(1, (int)stats.heap_allocs);
+    TEST_ASSERT_EQUAL(1, (int)stats.chunks);
+    TEST_ASSERT_TRUE(stats.used <= 4096U);
+
+    // Same again after a reset: no allocation at all
+    json_arena_reset(&arena);
+    write_document(&arena, 400);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_arena_get_stats(&arena, &stats));
+    TEST_ASSERT_EQUAL(1, (int)stats.heap_allocs);
+
+    // A larger document overflows into extra chunks ...
+    json_arena_reset(&arena);
+    write_document(&arena, 5000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_arena_get_stats(&arena, &stats));
+    TEST_ASSERT_GREATER_THAN(1, (int)stats.chunks);
+    uint64_t allocs = stats.heap_allocs;
+
+    // ... then one chunk of the high-water size serves it without further mallocs
+    json_arena_reset(&arena);
+    write_document(&arena, 5000);
+    json_arena_reset(&arena);
+    write_document(&arena, 5000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, json_arena_get_stats(&arena, &stats));
+    TEST_ASSERT_EQUAL(1, (int)stats.chunks);
+    TEST_ASSERT_EQUAL((int)allocs + 1, (int)stats.heap_allocs);
+    TEST_ASSERT_EQUAL(4, (int)stats.resets);
+
+    // Plain allocations are aligned and survive later writers
+    json_arena_reset(&arena);
+    char *a = (char *)json_arena_alloc(&arena, 3);
+    double *d = (double *)json_arena_alloc(&arena, sizeof(double));
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL(0, (int)((uintptr_t)d % JSON_ARENA_ALIGN));
+    memcpy(a, "ok", 3);
+    write_document(&arena, 100);
+    TEST_ASSERT_EQUAL_STRING("ok", a);
+    json_arena_destroy(&arena);
+    tearDown();
+}
+
+static void *arena_of_thread(void *arg)
+{
+    json_arena_t **out = (json_arena_t **)arg;
+    *out = json_arena_thread();
+    write_document(*out, 10);
+    return NULL;
+}
+
+void test_thread_arenas_are_separate(void)
+{
+    setUp();
+    json_arena_t *mine = json_arena_thread();
+    TEST_ASSERT_NOT_NULL(mine);
+    TEST_ASSERT_TRUE(mine == json_arena_thread());
+
+    json_arena_t *other = NULL;
+    pthread_t thread;
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, arena_of_thread, &other));
+    pthread_join(thread, NULL);
+    TEST_ASSERT_NOT_NULL(other);
+    TEST_ASSERT_TRUE(mine != other);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== JSON Writer Tests ===\n");
+
+    RUN_TEST(test_nesting_and_separators);
+    RUN_TEST(test_string_escaping);
+    RUN_TEST(test_integer_formatting);
+    RUN_TEST(test_fixed_point_formatting);
+    RUN_TEST(test_fixed_point_matches_printf);
+    RUN_TEST(test_hex_formatting);
+    RUN_TEST(test_fixed_buffer_never_truncates_silently);
+    RUN_TEST(test_misuse_is_reported);
+    RUN_TEST(test_heap_writer_grows);
+    RUN_TEST(test_arena_reuses_memory);
+    RUN_TEST(test_thread_arenas_are_separate);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file test_modbus_bus_master.c
+ * @brief Unit tests for Modbus bus master queueing and priority dispatch
+ */
+
+#include "unity.h"
+#include "modbus_bus_master.h"
+#include "hal_common.h"
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define MAX_RECORDED 64
+
+static pthread_mutex_t rec_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int exec_order[MAX_RECORDED];
+static int exec_count;
+static int done_count;
+static volatile bool gate_open;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_bus_master_jobs_run_inline_when_stopped(void);
+void test_bus_master_dispatches_by_priority(void);
+void test_bus_master_rejects_when_queue_full(void);
+void test_bus_master_stop_fails_queued_jobs(void);
+void test_bus_master_drops_timed_out_write(void);
+
+static hal_status_t gate_job(void *ctx)
+{
+    (void)ctx;
+    while (!gate_open) {
+        usleep(1000);
+    }
+    return HAL_STATUS_OK;
+}
+
+static hal_status_t record_job(void *ctx)
+{
+    pthread_mutex_lock(&rec_mutex);
+    if (exec_count < MAX_RECORDED) {
+        exec_order[exec_count++] = (int)(intptr_t)ctx;
+    }
+    pthread_mutex_unlock(&rec_mutex);
+    return HAL_STATUS_OK;
+}
+
+static void record_done(hal_status_t status, void *ctx)
+{
+    (void)status;
+    (void)ctx;
+    pthread_mutex_lock(&rec_mutex);
+    done_count++;
+    pthread_mutex_unlock(&rec_mutex);
+}
+
+static void wait_for_done(int expected)
+{
+    for (int i = 0; i < 2000; i++) {
+        pthread_mutex_lock(&rec_mutex);
+        int n = done_count;
+        pthread_mutex_unlock(&rec_mutex);
+        if (n >= expected) {
+            return;
+        }
+        usleep(1000);
+    }
+}
+
+void setUp(void)
+{
+    memset(exec_order, 0, sizeof(exec_order));
+    exec_count = 0;
+    done_count = 0;
+    gate_open = false;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_master_init());
+}
+
+void tearDown(void)
+{
+    gate_open = true;
+    modbus_bus_master_deinit();
+}
+
+void test_bus_master_jobs_run_inline_when_stopped(void)
+{
+    setUp();
+    TEST_ASSERT_FALSE(modbus_bus_master_is_running());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK,
+                      modbus_bus_submit_job(MODBUS_BUS_PRIO_TELEMETRY, record_job, (void *)(intptr_t)7,
+                                            record_done, NULL));
+    TEST_ASSERT_EQUAL(1, exec_count);
+    TEST_ASSERT_EQUAL(7, exec_order[0]);
+    TEST_ASSERT_EQUAL(1, done_count);
+    tearDown();
+}
+
+void test_bus_master_dispatches_by_priority(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_master_start());
+
+    // Hold the bus so everything below queues up behind the gate
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK,
+                      modbus_bus_submit_job(MODBUS_BUS_PRIO_DISCOVERY, gate_job, NULL, record_done, NULL));
+    usleep(20000);
+
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_DISCOVERY, record_job, (void *)(intptr_t)MODBUS_BUS_PRIO_DISCOVERY, record_done, NULL);
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_TELEMETRY, record_job, (void *)(intptr_t)MODBUS_BUS_PRIO_TELEMETRY, record_done, NULL);
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_COMMAND, record_job, (void *)(intptr_t)MODBUS_BUS_PRIO_COMMAND, record_done, NULL);
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_SAFETY, record_job, (void *)(intptr_t)MODBUS_BUS_PRIO_SAFETY, record_done, NULL);
+
+    gate_open = true;
+    wait_for_done(5);
+
+    TEST_ASSERT_EQUAL(4, exec_count);
+    TEST_ASSERT_EQUAL(MODBUS_BUS_PRIO_SAFETY, exec_order[0]);
+    TEST_ASSERT_EQUAL(MODBUS_BUS_PRIO_COMMAND, exec_order[1]);
+    TEST_ASSERT_EQUAL(MODBUS_BUS_PRIO_TELEMETRY, exec_order[2]);
+    TEST_ASSERT_EQUAL(MODBUS_BUS_PRIO_DISCOVERY, exec_order[3]);
+
+    modbus_bus_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_get_stats(&stats));
+    TEST_ASSERT_TRUE(stats.running);
+    TEST_ASSERT_EQUAL_UINT(2, stats.prio[MODBUS_BUS_PRIO_DISCOVERY].completed);
+    TEST_ASSERT_EQUAL_UINT(1, stats.prio[MODBUS_BUS_PRIO_SAFETY].completed);
+    TEST_ASSERT_EQUAL_UINT(0, stats.prio[MODBUS_BUS_PRIO_SAFETY].depth);
+    tearDown();
+}
+
+void test_bus_master_rejects_when_queue_full(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_master_start());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK,
+                      modbus_bus_submit_job(MODBUS_BUS_PRIO_SAFETY, gate_job, NULL, record_done, NULL));
+    usleep(20000);
+
+    for (int i = 0; i < MODBUS_BUS_QUEUE_DEPTH; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK,
+                          modbus_bus_submit_job(MODBUS_BUS_PRIO_TELEMETRY, record_job, NULL, record_done, NULL));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_BUSY,
+                      modbus_bus_submit_job(MODBUS_BUS_PRIO_TELEMETRY, record_job, NULL, record_done, NULL));
+
+    modbus_bus_stats_t stats;
+    modbus_bus_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT(1, stats.prio[MODBUS_BUS_PRIO_TELEMETRY].rejected);
+    TEST_ASSERT_EQUAL_UINT(MODBUS_BUS_QUEUE_DEPTH, stats.prio[MODBUS_BUS_PRIO_TELEMETRY].max_depth);
+
+    gate_open = true;
+    wait_for_done(MODBUS_BUS_QUEUE_DEPTH + 1);
+    TEST_ASSERT_EQUAL(MODBUS_BUS_QUEUE_DEPTH, exec_count);
+    tearDown();
+}
+
+void test_bus_master_stop_fails_queued_jobs(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_master_start());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK,
+                      modbus_bus_submit_job(MODBUS_BUS_PRIO_SAFETY, gate_job, NULL, NULL, NULL));
+    usleep(20000);
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_TELEMETRY, record_job, NULL, record_done, NULL);
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_TELEMETRY, record_job, NULL, record_done, NULL);
+
+    gate_open = true;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_master_stop());
+    TEST_ASSERT_FALSE(modbus_bus_master_is_running());
+
+    // Every queued job completes exactly once, either served or failed by stop
+    TEST_ASSERT_EQUAL(2, done_count);
+    tearDown();
+}
+
+void test_bus_master_drops_timed_out_write(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_master_start());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK,
+                      modbus_bus_submit_job(MODBUS_BUS_PRIO_SAFETY, gate_job, NULL, record_done, NULL));
+    usleep(20000);
+
+    // The write waits behind the gate until its caller gives up
+    TEST_ASSERT_EQUAL(HAL_STATUS_TIMEOUT, modbus_bus_write_single(MODBUS_BUS_PRIO_COMMAND, 0x03, 0x0001, 1));
+
+    // Once the bus frees up it must not be sent after the fact
+    gate_open = true;
+    wait_for_done(1);
+    modbus_bus_submit_job(MODBUS_BUS_PRIO_COMMAND, record_job, NULL, record_done, NULL);
+    wait_for_done(2);
+
+    modbus_bus_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_bus_get_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT(1, stats.prio[MODBUS_BUS_PRIO_COMMAND].timed_out);
+    TEST_ASSERT_EQUAL_UINT(1, stats.prio[MODBUS_BUS_PRIO_COMMAND].dropped);
+    TEST_ASSERT_EQUAL_UINT(1, stats.prio[MODBUS_BUS_PRIO_COMMAND].completed);
+    TEST_ASSERT_EQUAL_UINT(0, stats.prio[MODBUS_BUS_PRIO_COMMAND].failed);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bus_master_jobs_run_inline_when_stopped);
+    RUN_TEST(test_bus_master_dispatches_by_priority);
+    RUN_TEST(test_bus_master_rejects_when_queue_full);
+    RUN_TEST(test_bus_master_stop_fails_queued_jobs);
+    RUN_TEST(test_bus_master_drops_timed_out_write);
+
+    UNITY_END();
+    return 0;
+}
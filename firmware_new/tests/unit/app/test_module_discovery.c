@@ -0,0 +1,368 @@
+/**
+ * @file test_module_discovery.c
+ * @brief Tests for pipelined module discovery against the pty slave simulator
+ */
+
+#include "unity.h"
+#include "module_discovery.h"
+#include "communication_manager.h"
+#include "modbus_bus_master.h"
+#include "modbus_slave_sim.h"
+#include "hal_rs485.h"
+#include "hal_common.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TEST_CACHE_PATH     "/tmp/oht50_test_discovery_modules.yaml"
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_timeout_follows_rtt_estimate(void);
+void test_timeout_backs_off_only_for_known_slaves(void);
+void test_warm_start_brings_four_modules_online(void);
+void test_warm_start_probes_saved_addresses(void);
+void test_background_rescan_tracks_unplug_and_replug(void);
+void test_rescan_interleaves_with_telemetry(void);
+void test_scan_range_uses_engine(void);
+
+static bool g_bus_ready = false;
+
+static uint64_t test_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static void test_config(module_discovery_config_t *cfg)
+{
+    module_discovery_get_default_config(cfg);
+    cfg->range_start = 0x02;
+    cfg->range_end = 0x07;
+    cfg->rescan_interval_ms = 2;
+    snprintf(cfg->cache_path, sizeof(cfg->cache_path), "%s", TEST_CACHE_PATH);
+}
+
+static bool addr_online(uint8_t addr)
+{
+    module_discovery_addr_info_t info;
+    return module_discovery_get_addr_info(addr, &info) == HAL_STATUS_OK && info.online;
+}
+
+/**
+ * @brief Run the background step until the address reaches the wanted state
+ */
+static bool step_until(uint8_t addr, bool online, uint32_t max_ms)
+{
+    uint64_t deadline = test_now_ms() + max_ms;
+    while (test_now_ms() < deadline) {
+        module_discovery_step();
+        if (addr_online(addr) == online) {
+            return true;
+        }
+        usleep(1000);
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    module_discovery_config_t cfg;
+    registry_init();
+    remove(TEST_CACHE_PATH);
+    for (uint8_t addr = 0x02; addr <= 0x05; addr++) {
+        modbus_slave_sim_set_present(addr, true);
+    }
+    test_config(&cfg);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_init(&cfg));
+}
+
+void tearDown(void)
+{
+    module_discovery_deinit();
+    remove(TEST_CACHE_PATH);
+}
+
+void test_timeout_follows_rtt_estimate(void)
+{
+    setUp();
+    module_discovery_addr_info_t info;
+
+    // No samples anywhere on the bus yet: configured initial timeout
+    TEST_ASSERT_EQUAL(50, module_discovery_get_timeout_ms(0x09));
+
+    // 20 ms round trips: srtt 20 ms, rttvar settles towards 0 -> timeout towards srtt
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_observe(0x09, HAL_STATUS_OK, 20000));
+    TEST_ASSERT_EQUAL(60, module_discovery_get_timeout_ms(0x09));  // 20 + 4 * 10
+    for (int i = 0; i < 40; i++) {
+        module_discovery_observe(0x09, HAL_STATUS_OK, 20000);
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_get_addr_info(0x09, &info));
+    TEST_ASSERT_TRUE(info.has_rtt);
+    TEST_ASSERT_TRUE(info.online);
+    TEST_ASSERT_EQUAL(20000, info.srtt_us);
+    TEST_ASSERT_LESS_THAN(25, info.timeout_ms);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(20, info.timeout_ms);
+
+    // Addresses without samples borrow the bus-wide estimate instead of the initial timeout
+    TEST_ASSERT_LESS_THAN(50, module_discovery_get_timeout_ms(0x0A));
+
+    // Fast slave: clamped to the configured minimum
+    for (int i = 0; i < 40; i++) {
+        module_discovery_observe(0x0B, HAL_STATUS_OK, 300);
+    }
+    TEST_ASSERT_EQUAL(10, module_discovery_get_timeout_ms(0x0B));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, module_discovery_observe(0x00, HAL_STATUS_OK, 1));
+    tearDown();
+}
+
+void test_timeout_backs_off_only_for_known_slaves(void)
+{
+    setUp();
+    module_discovery_addr_info_t info;
+
+    for (int i = 0; i < 40; i++) {
+        module_discovery_observe(0x09, HAL_STATUS_OK, 20000);
+    }
+    uint32_t base = module_discovery_get_timeout_ms(0x09);
+
+    module_discovery_observe(0x09, HAL_STATUS_TIMEOUT, 0);
+    TEST_ASSERT_EQUAL(base * 2, module_discovery_get_timeout_ms(0x09));
+    TEST_ASSERT_TRUE(addr_online(0x09));                            // One miss is debounced
+    module_discovery_observe(0x09, HAL_STATUS_TIMEOUT, 0);
+    TEST_ASSERT_FALSE(addr_online(0x09));                           // miss_limit = 2
+    for (int i = 0; i < 6; i++) {
+        module_discovery_observe(0x09, HAL_STATUS_TIMEOUT, 0);
+    }
+    TEST_ASSERT_EQUAL(200, module_discovery_get_timeout_ms(0x09));  // Capped
+
+    // An answer (even an exception) resets misses and backoff
+    module_discovery_observe(0x09, HAL_STATUS_NOT_SUPPORTED, 20000);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_get_addr_info(0x09, &info));
+    TEST_ASSERT_TRUE(info.online);
+    TEST_ASSERT_EQUAL(0, info.misses);
+    TEST_ASSERT_EQUAL(0, info.backoff);
+
+    // Empty addresses keep the cheap timeout however often they miss
+    uint32_t empty = module_discovery_get_timeout_ms(0x0C);
+    for (int i = 0; i < 5; i++) {
+        module_discovery_observe(0x0C, HAL_STATUS_TIMEOUT, 0);
+    }
+    TEST_ASSERT_EQUAL(empty, module_discovery_get_timeout_ms(0x0C));
+    tearDown();
+}
+
+void test_warm_start_brings_four_modules_online(void)
+{
+    setUp();
+    module_discovery_addr_info_t info;
+    module_discovery_stats_t stats;
+    size_t online = 0;
+
+    TEST_ASSERT_TRUE(g_bus_ready);
+    modbus_slave_sim_set_register(0x04, 0x0105, 0x0102);
+
+    uint64_t start = test_now_ms();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_warm_start(800, &online));
+    uint64_t elapsed = test_now_ms() - start;
+    printf("Warm start: %llu ms\n", (unsigned long long)elapsed);
+
+    TEST_ASSERT_EQUAL(4, online);
+    TEST_ASSERT_EQUAL(4, registry_count_online());
+    TEST_ASSERT_LESS_THAN(1000, elapsed);
+
+    // One read per module carried the whole identity block
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_get_addr_info(0x04, &info));
+    TEST_ASSERT_EQUAL(1, info.probes);
+    TEST_ASSERT_EQUAL(0x0004, info.module_type);
+    TEST_ASSERT_EQUAL(0x0102, info.fw_version);
+    TEST_ASSERT_TRUE(info.has_rtt);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_get_stats(&stats));
+    TEST_ASSERT_EQUAL(4, stats.responses);
+    TEST_ASSERT_EQUAL(0, stats.in_flight);
+
+    // The online set changed, so the cache was written
+    TEST_ASSERT_EQUAL(0, access(TEST_CACHE_PATH, F_OK));
+    tearDown();
+}
+
+void test_warm_start_probes_saved_addresses(void)
+{
+    setUp();
+    size_t online = 0;
+    module_discovery_addr_info_t info;
+
+    // Cache from a previous boot: dock plus an extra module at 0x06 that is gone now
+    FILE *f = fopen(TEST_CACHE_PATH, "w");
+    TEST_ASSERT_NOT_NULL(f);
+    fprintf(f, "schema_version: 1\n\nmodule_0:\n  address: 5\n  type: 5\n  name: \"dock\"\n  status: 1\n\n"
+               "module_1:\n  address: 6\n  type: 0\n  name: \"aux\"\n  status: 1\n  version: \"v1.00\"\n\n");
+    fclose(f);
+    TEST_ASSERT_EQUAL(2, registry_load_yaml(TEST_CACHE_PATH));
+    TEST_ASSERT_EQUAL(0, registry_count_online());
+    TEST_ASSERT_TRUE(registry_has_offline_saved());
+
+    modbus_slave_sim_set_present(0x03, false);
+    TEST_ASSERT_EQUAL(HAL_STATUS_TIMEOUT, module_discovery_warm_start(800, &online));
+    TEST_ASSERT_EQUAL(3, online);
+
+    // The saved address was probed (twice: miss_limit) and stays offline
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_get_addr_info(0x06, &info));
+    TEST_ASSERT_EQUAL(2, info.probes);
+    TEST_ASSERT_FALSE(info.online);
+    TEST_ASSERT_TRUE(registry_has_offline_saved());
+    TEST_ASSERT_FALSE(addr_online(0x03));
+    tearDown();
+}
+
+void test_background_rescan_tracks_unplug_and_replug(void)
+{
+    setUp();
+    module_discovery_stats_t stats;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_warm_start(800, NULL));
+    TEST_ASSERT_EQUAL(4, registry_count_online());
+
+    modbus_slave_sim_set_present(0x05, false);
+    TEST_ASSERT_TRUE(step_until(0x05, false, 3000));
+    module_discovery_step();
+    TEST_ASSERT_EQUAL(3, registry_count_online());
+
+    modbus_slave_sim_set_present(0x05, true);
+    TEST_ASSERT_TRUE(step_until(0x05, true, 3000));
+    module_discovery_step();
+    TEST_ASSERT_EQUAL(4, registry_count_online());
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_get_stats(&stats));
+    TEST_ASSERT_GREATER_THAN(0, stats.sweeps_completed);
+
+    // Paused: nothing new is queued
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_pause());
+    usleep(20000);
+    module_discovery_step();
+    module_discovery_get_stats(&stats);
+    uint64_t probes = stats.probes;
+    for (int i = 0; i < 10; i++) {
+        usleep(3000);
+        module_discovery_step();
+    }
+    module_discovery_get_stats(&stats);
+    TEST_ASSERT_EQUAL(probes, stats.probes);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_resume());
+    tearDown();
+}
+
+void test_rescan_interleaves_with_telemetry(void)
+{
+    setUp();
+    uint16_t regs[4];
+    int ok = 0;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, module_discovery_warm_start(800, NULL));
+    modbus_slave_sim_set_present(0x02, false);
+
+    // Telemetry keeps flowing while the rescan probes the empty addresses
+    uint64_t deadline = test_now_ms() + 300;
+    while (test_now_ms() < deadline) {
+        module_discovery_step();
+        if (modbus_bus_read_holding(MODBUS_BUS_PRIO_TELEMETRY, 0x03, 0x0000, 4, regs) == HAL_STATUS_OK) {
+            ok++;
+        }
+    }
+    module_discovery_stats_t stats;
+    module_discovery_get_stats(&stats);
+    printf("Telemetry reads during rescan: %d, probes: %llu\n", ok, (unsigned long long)stats.probes);
+    TEST_ASSERT_GREATER_THAN(50, ok);
+    TEST_ASSERT_GREATER_THAN(10, stats.probes);
+    tearDown();
+}
+
+void test_scan_range_uses_engine(void)
+{
+    setUp();
+    module_discovery_stats_t stats;
+
+    modbus_slave_sim_set_present(0x04, false);
+    uint64_t start = test_now_ms();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, comm_manager_scan_range(0x02, 0x07));
+    uint64_t elapsed = test_now_ms() - start;
+    printf("Scan 0x02-0x07: %llu ms\n", (unsigned long long)elapsed);
+
+    TEST_ASSERT_EQUAL(3, registry_count_online());
+    TEST_ASSERT_FALSE(comm_manager_is_scanning());
+    TEST_ASSERT_LESS_THAN(1000, elapsed);
+    module_discovery_get_stats(&stats);
+    TEST_ASSERT_EQUAL(3, stats.responses);
+    TEST_ASSERT_EQUAL(6, stats.timeouts);   // 0x04, 0x06, 0x07 twice each
+    tearDown();
+}
+
+static hal_status_t open_bus(const char *device)
+{
+    rs485_config_t rs485_cfg = {
+        .baud_rate = RS485_BAUD_RATE,
+        .data_bits = RS485_DATA_BITS,
+        .stop_bits = RS485_STOP_BITS,
+        .parity = RS485_PARITY_NONE,
+        .timeout_ms = 100,
+        .retry_count = 0
+    };
+    snprintf(rs485_cfg.device_path, sizeof(rs485_cfg.device_path), "%s", device);
+    hal_status_t status = hal_rs485_init(&rs485_cfg);
+    if (status != HAL_STATUS_OK) {
+        return status;
+    }
+
+    comm_mgr_config_t comm_cfg = {
+        .baud_rate = RS485_BAUD_RATE,
+        .data_bits = 8,
+        .stop_bits = 1,
+        .parity = 0,
+        .timeout_ms = 100,
+        .retry_count = 0,
+        .retry_delay_ms = 0,
+        .modbus_slave_id = 0x02,
+        .enable_crc_check = true,
+        .enable_echo_suppression = true,
+        .buffer_size = 256
+    };
+    status = comm_manager_init(&comm_cfg);
+    if (status == HAL_STATUS_OK) {
+        status = modbus_bus_master_init();
+    }
+    if (status == HAL_STATUS_OK) {
+        status = modbus_bus_master_start();
+    }
+    return status;
+}
+
+int main(void)
+{
+    char device[MODBUS_SLAVE_SIM_PATH_MAX];
+
+    UNITY_BEGIN();
+
+    printf("=== MODULE DISCOVERY TESTS ===\n");
+
+    g_bus_ready = modbus_slave_sim_start(NULL, device, sizeof(device)) == HAL_STATUS_OK &&
+                  open_bus(device) == HAL_STATUS_OK;
+
+    RUN_TEST(test_timeout_follows_rtt_estimate);
+    RUN_TEST(test_timeout_backs_off_only_for_known_slaves);
+    RUN_TEST(test_warm_start_brings_four_modules_online);
+    RUN_TEST(test_warm_start_probes_saved_addresses);
+    RUN_TEST(test_background_rescan_tracks_unplug_and_replug);
+    RUN_TEST(test_rescan_interleaves_with_telemetry);
+    RUN_TEST(test_scan_range_uses_engine);
+
+    modbus_bus_master_deinit();
+    comm_manager_deinit();
+    modbus_slave_sim_stop();
+
+    UNITY_END();
+    return 0;
+}
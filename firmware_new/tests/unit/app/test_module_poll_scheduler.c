@@ -0,0 +1,275 @@
+/**
+ * @file test_module_poll_scheduler.c
+ * @brief Unit tests for the deadline-based multi-rate poll scheduler
+ */
+
+#include "unity.h"
+#include "module_poll_scheduler.h"
+#include "hal_common.h"
+#include <string.h>
+
+static module_poll_scheduler_t sched;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_scheduler_dispatches_earliest_deadline_first(void);
+void test_scheduler_runs_each_group_at_its_own_rate(void);
+void test_scheduler_counts_overrun_while_in_flight(void);
+void test_scheduler_resyncs_when_far_behind(void);
+void test_scheduler_remove_invalidates_handles(void);
+void test_scheduler_cancel_rearms_entry(void);
+void test_scheduler_records_lateness_and_jitter(void);
+void test_scheduler_skip_advances_without_polling(void);
+void test_scheduler_counts_starved_dispatch(void);
+void test_budget_limits_share_of_bus_time(void);
+void test_budget_settles_measured_cost(void);
+
+void setUp(void)
+{
+    module_poll_sched_init(&sched);
+}
+
+void tearDown(void)
+{
+}
+
+void test_scheduler_dispatches_earliest_deadline_first(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x02, 0, 1000, 300);
+    module_poll_sched_add(&sched, 0x03, 1, 500, 100);
+    module_poll_sched_add(&sched, 0x04, 2, 1000, 200);
+
+    TEST_ASSERT_EQUAL(-1, module_poll_sched_peek_due(&sched, 50));
+    TEST_ASSERT_EQUAL_UINT(50, module_poll_sched_time_to_next_ms(&sched, 50));
+
+    uint32_t handle;
+    int slot = module_poll_sched_dispatch_due(&sched, 400, &handle);
+    TEST_ASSERT_EQUAL(0x03, sched.entries[slot].address);
+    slot = module_poll_sched_dispatch_due(&sched, 400, &handle);
+    TEST_ASSERT_EQUAL(0x04, sched.entries[slot].address);
+    slot = module_poll_sched_dispatch_due(&sched, 400, &handle);
+    TEST_ASSERT_EQUAL(0x02, sched.entries[slot].address);
+    TEST_ASSERT_EQUAL(-1, module_poll_sched_dispatch_due(&sched, 400, &handle));
+    tearDown();
+}
+
+void test_scheduler_runs_each_group_at_its_own_rate(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x02, 0, 1000, 0);    // Power battery block
+    module_poll_sched_add(&sched, 0x02, 1, 5000, 0);    // Power charging block
+    module_poll_sched_add(&sched, 0x02, 2, 30000, 0);   // Power system-info block
+
+    // 60 s of main loop at 10 ms, every poll completing immediately
+    for (uint64_t now = 0; now < 60000; now += 10) {
+        uint32_t handle;
+        while (module_poll_sched_dispatch_due(&sched, now, &handle) >= 0) {
+            module_poll_sched_complete(&sched, handle, true);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT(60, sched.groups[0].dispatched);
+    TEST_ASSERT_EQUAL_UINT(12, sched.groups[1].dispatched);
+    TEST_ASSERT_EQUAL_UINT(2, sched.groups[2].dispatched);
+    TEST_ASSERT_EQUAL_UINT(60, sched.groups[0].completed);
+    TEST_ASSERT_EQUAL_UINT(0, sched.groups[0].overruns);
+    tearDown();
+}
+
+void test_scheduler_counts_overrun_while_in_flight(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x05, 0, 50, 0);
+
+    uint32_t first;
+    uint32_t second;
+    TEST_ASSERT_TRUE(module_poll_sched_dispatch_due(&sched, 0, &first) >= 0);
+    TEST_ASSERT_TRUE(module_poll_sched_dispatch_due(&sched, 50, &second) >= 0);
+    TEST_ASSERT_EQUAL_UINT(MODULE_POLL_HANDLE_INVALID, second);
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].overruns);
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].dispatched);
+
+    TEST_ASSERT_TRUE(module_poll_sched_complete(&sched, first, false) >= 0);
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].failed);
+    TEST_ASSERT_TRUE(module_poll_sched_dispatch_due(&sched, 100, &second) >= 0);
+    TEST_ASSERT_TRUE(second != MODULE_POLL_HANDLE_INVALID);
+    tearDown();
+}
+
+void test_scheduler_resyncs_when_far_behind(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x02, 0, 1000, 0);
+
+    uint32_t handle;
+    module_poll_sched_dispatch_due(&sched, 0, &handle);
+    module_poll_sched_complete(&sched, handle, true);
+
+    // Stalled for 5 periods: one catch-up poll, not five back to back
+    module_poll_sched_dispatch_due(&sched, 5500, &handle);
+    module_poll_sched_complete(&sched, handle, true);
+    TEST_ASSERT_EQUAL(-1, module_poll_sched_peek_due(&sched, 5500));
+    TEST_ASSERT_EQUAL_UINT(1000, module_poll_sched_time_to_next_ms(&sched, 5500));
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].resyncs);
+    tearDown();
+}
+
+void test_scheduler_remove_invalidates_handles(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x02, 0, 1000, 0);
+    module_poll_sched_add(&sched, 0x03, 1, 500, 0);
+    module_poll_sched_add(&sched, 0x02, 2, 30000, 0);
+
+    uint32_t handle;
+    int slot = module_poll_sched_dispatch_due(&sched, 0, &handle);
+    uint8_t address = sched.entries[slot].address;
+
+    TEST_ASSERT_EQUAL(address == 0x02 ? 2 : 1, module_poll_sched_remove_address(&sched, address));
+    TEST_ASSERT_EQUAL(-1, module_poll_sched_complete(&sched, handle, true));
+    TEST_ASSERT_EQUAL(address == 0x02 ? 1 : 2, sched.count);
+
+    // Heap still ordered after removal
+    uint64_t last_due = 0;
+    while (sched.count > 0) {
+        uint64_t due = sched.entries[sched.heap[0]].next_due_ms;
+        TEST_ASSERT_TRUE(due >= last_due);
+        last_due = due;
+        module_poll_sched_remove_address(&sched, sched.entries[sched.heap[0]].address);
+    }
+    tearDown();
+}
+
+void test_scheduler_cancel_rearms_entry(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x02, 0, 30000, 100);
+
+    uint32_t handle;
+    module_poll_sched_dispatch_due(&sched, 100, &handle);
+    TEST_ASSERT_EQUAL(-1, module_poll_sched_peek_due(&sched, 200));
+
+    // Bus queue was full: retried on the next pass instead of 30 s later
+    module_poll_sched_cancel(&sched, handle);
+    TEST_ASSERT_TRUE(module_poll_sched_peek_due(&sched, 200) >= 0);
+    TEST_ASSERT_EQUAL_UINT(0, sched.groups[0].dispatched);
+    tearDown();
+}
+
+void test_scheduler_records_lateness_and_jitter(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(0, module_poll_hist_bucket(0));
+    TEST_ASSERT_EQUAL(2, module_poll_hist_bucket(4));
+    TEST_ASSERT_EQUAL(MODULE_POLL_HIST_BUCKETS - 1, module_poll_hist_bucket(5000));
+
+    module_poll_sched_add(&sched, 0x03, 0, 500, 1000);
+
+    uint32_t handle;
+    module_poll_sched_dispatch_due(&sched, 1000, &handle);   // on time
+    module_poll_sched_complete(&sched, handle, true);
+    module_poll_sched_dispatch_due(&sched, 1530, &handle);   // 30 ms late
+    module_poll_sched_complete(&sched, handle, true);
+
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].lateness_hist[0]);
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].lateness_hist[module_poll_hist_bucket(30)]);
+    TEST_ASSERT_EQUAL_UINT(30, sched.groups[0].max_lateness_ms);
+    TEST_ASSERT_EQUAL_UINT(30, sched.groups[0].max_jitter_ms);
+
+    // Fixed-rate: the next deadline stays on the 500 ms grid despite the late dispatch
+    TEST_ASSERT_EQUAL_UINT(470, module_poll_sched_time_to_next_ms(&sched, 1530));
+    tearDown();
+}
+
+void test_scheduler_skip_advances_without_polling(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x05, 0, 200, 0);
+
+    // Group not allowed in the current state: deadline moves on, nothing dispatched
+    TEST_ASSERT_TRUE(module_poll_sched_skip_due(&sched, 1000) >= 0);
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].skipped);
+    TEST_ASSERT_EQUAL_UINT(0, sched.groups[0].dispatched);
+    TEST_ASSERT_EQUAL_UINT(200, module_poll_sched_time_to_next_ms(&sched, 1000));
+
+    // Allowed again: polled on time, not reported as starved
+    uint32_t handle;
+    module_poll_sched_dispatch_due(&sched, 1200, &handle);
+    TEST_ASSERT_EQUAL_UINT(0, sched.groups[0].starved);
+    TEST_ASSERT_EQUAL_UINT(0, sched.groups[0].max_jitter_ms);
+    tearDown();
+}
+
+void test_scheduler_counts_starved_dispatch(void)
+{
+    setUp();
+    module_poll_sched_add(&sched, 0x02, 0, 1000, 0);
+
+    uint32_t handle;
+    module_poll_sched_dispatch_due(&sched, 1500, &handle);   // 1.5 periods late
+    module_poll_sched_complete(&sched, handle, true);
+    TEST_ASSERT_EQUAL_UINT(0, sched.groups[0].starved);
+
+    module_poll_sched_dispatch_due(&sched, 6000, &handle);   // held back for several periods
+    TEST_ASSERT_EQUAL_UINT(1, sched.groups[0].starved);
+    tearDown();
+}
+
+void test_budget_limits_share_of_bus_time(void)
+{
+    module_poll_budget_t budget;
+    module_poll_budget_init(&budget, 350, 20000, 0);
+
+    // Burst drains the bucket
+    TEST_ASSERT_TRUE(module_poll_budget_consume(&budget, 12000));
+    TEST_ASSERT_FALSE(module_poll_budget_consume(&budget, 12000));
+
+    // 35% share: 10 ms of wall time grants 3.5 ms of bus time
+    module_poll_budget_refill(&budget, 10);
+    TEST_ASSERT_FALSE(module_poll_budget_consume(&budget, 12000));
+    module_poll_budget_refill(&budget, 20);
+    TEST_ASSERT_TRUE(module_poll_budget_consume(&budget, 12000));
+
+    // Never refills beyond the burst capacity
+    module_poll_budget_refill(&budget, 100000);
+    TEST_ASSERT_TRUE(module_poll_budget_consume(&budget, 20000));
+    TEST_ASSERT_FALSE(module_poll_budget_consume(&budget, 1));
+}
+
+void test_budget_settles_measured_cost(void)
+{
+    module_poll_budget_t budget;
+    module_poll_budget_init(&budget, 500, 10000, 0);
+
+    // A poll that needed retries costs more than estimated and pushes the bucket into debt
+    TEST_ASSERT_TRUE(module_poll_budget_consume(&budget, 8000));
+    module_poll_budget_settle(&budget, 8000, 30000);
+    TEST_ASSERT_TRUE(budget.tokens_us < 0);
+
+    module_poll_budget_refill(&budget, 40);
+    TEST_ASSERT_FALSE(module_poll_budget_consume(&budget, 1000));
+    module_poll_budget_refill(&budget, 60);
+    TEST_ASSERT_TRUE(module_poll_budget_consume(&budget, 1000));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scheduler_dispatches_earliest_deadline_first);
+    RUN_TEST(test_scheduler_runs_each_group_at_its_own_rate);
+    RUN_TEST(test_scheduler_counts_overrun_while_in_flight);
+    RUN_TEST(test_scheduler_resyncs_when_far_behind);
+    RUN_TEST(test_scheduler_remove_invalidates_handles);
+    RUN_TEST(test_scheduler_cancel_rearms_entry);
+    RUN_TEST(test_scheduler_records_lateness_and_jitter);
+    RUN_TEST(test_scheduler_skip_advances_without_polling);
+    RUN_TEST(test_scheduler_counts_starved_dispatch);
+    RUN_TEST(test_budget_limits_share_of_bus_time);
+    RUN_TEST(test_budget_settles_measured_cost);
+
+    UNITY_END();
+    return 0;
+}
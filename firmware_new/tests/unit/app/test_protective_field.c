@@ -0,0 +1,380 @@
+/**
+ * @file test_protective_field.c
+ * @brief Tests for the direction- and speed-dependent protective fields
+ */
+
+#include "unity.h"
+#include "protective_field.h"
+#include "hal_lidar.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Default field indices
+#define FIELD_STANDSTILL    0
+#define FIELD_FORWARD_SLOW  1
+#define FIELD_FORWARD_FAST  2
+#define FIELD_REVERSE_SLOW  3
+#define FIELD_REVERSE_FAST  4
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_init_loads_defaults_in_fallback(void);
+void test_sector_tables_cover_boundary_bins(void);
+void test_polygon_tables_follow_the_boundary(void);
+void test_mount_offset_rotates_tables(void);
+void test_selection_by_direction_and_speed(void);
+void test_slower_field_waits_for_hysteresis_and_hold(void);
+void test_slow_reverse_leaves_forward_field_at_once(void);
+void test_evaluate_single_pass(void);
+void test_malformed_fields_rejected(void);
+
+static lidar_scan_data_t g_scan;
+
+void setUp(void)
+{
+    protective_field_deinit();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_init(NULL));
+    memset(&g_scan, 0, sizeof(g_scan));
+    g_scan.point_count = LIDAR_POINTS_PER_SCAN;
+    g_scan.scan_complete = true;
+}
+
+void tearDown(void)
+{
+    protective_field_deinit();
+}
+
+/**
+ * @brief Put a return at a sensor angle; all other points have none
+ */
+static void add_return(uint16_t index, uint16_t deg, uint16_t distance_mm)
+{
+    g_scan.angle_q6[index] = (uint16_t)(deg * 64U);
+    g_scan.distance_mm[index] = distance_mm;
+}
+
+static uint8_t active_field(void)
+{
+    protective_field_status_t status;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_status(&status));
+    return status.active_field;
+}
+
+static void expect_thresholds(uint8_t field, uint16_t deg, uint16_t stop_mm, uint16_t warning_mm)
+{
+    uint16_t stop = 0;
+    uint16_t warning = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(field, deg, &stop, &warning));
+    TEST_ASSERT_EQUAL_UINT(stop_mm, stop);
+    TEST_ASSERT_EQUAL_UINT(warning_mm, warning);
+}
+
+void test_init_loads_defaults_in_fallback(void)
+{
+    setUp();
+    protective_field_status_t status;
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_INITIALIZED, protective_field_init(NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_status(&status));
+    TEST_ASSERT_TRUE(status.initialized);
+    TEST_ASSERT_EQUAL(5, status.field_count);
+    TEST_ASSERT_EQUAL(PROTECTIVE_FIELD_FALLBACK, status.active_field);
+    TEST_ASSERT_FALSE(status.velocity_valid);
+
+    // Fallback is the per-degree maximum: fast forward ahead, fast reverse behind, standstill beside
+    uint16_t stop = 0;
+    uint16_t warning = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(PROTECTIVE_FIELD_FALLBACK, 0, &stop, &warning));
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(2000, stop);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(3500, warning);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(PROTECTIVE_FIELD_FALLBACK, 180, &stop, &warning));
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(2000, stop);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(3500, warning);
+    expect_thresholds(PROTECTIVE_FIELD_FALLBACK, 90, 500, 1000);
+    tearDown();
+}
+
+void test_sector_tables_cover_boundary_bins(void)
+{
+    setUp();
+    // forward_slow: ahead 300..60, beside 60..120 and 240..300, nothing behind
+    expect_thresholds(FIELD_FORWARD_SLOW, 0, 800, 1500);
+    expect_thresholds(FIELD_FORWARD_SLOW, 359, 800, 1500);
+    expect_thresholds(FIELD_FORWARD_SLOW, 60, 800, 1500);
+    expect_thresholds(FIELD_FORWARD_SLOW, 61, 300, 500);
+    expect_thresholds(FIELD_FORWARD_SLOW, 119, 300, 500);
+    expect_thresholds(FIELD_FORWARD_SLOW, 180, 0, 0);
+    expect_thresholds(FIELD_STANDSTILL, 123, 500, 1000);
+
+    // Warning raised to the stop distance
+    protective_field_def_t field = {
+        .name = "narrow",
+        .direction = PROTECTIVE_FIELD_DIR_ANY,
+        .min_speed_mm_s = 0.0f,
+        .max_speed_mm_s = PROTECTIVE_FIELD_SPEED_UNBOUNDED,
+        .shape = PROTECTIVE_FIELD_SHAPE_SECTORS,
+        .sector_count = 1,
+        .sectors = { { 10, 20, 700, 100 } }
+    };
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_set_fields(&field, 1));
+    expect_thresholds(0, 9, 0, 0);
+    expect_thresholds(0, 10, 700, 700);
+    expect_thresholds(0, 20, 700, 700);
+    expect_thresholds(0, 21, 0, 0);
+    tearDown();
+}
+
+void test_polygon_tables_follow_the_boundary(void)
+{
+    setUp();
+    protective_field_def_t field = {
+        .name = "square",
+        .direction = PROTECTIVE_FIELD_DIR_ANY,
+        .min_speed_mm_s = 0.0f,
+        .max_speed_mm_s = PROTECTIVE_FIELD_SPEED_UNBOUNDED,
+        .shape = PROTECTIVE_FIELD_SHAPE_POLYGON,
+        .stop_vertex_count = 4,
+        .stop_polygon = { { -1000, -1000 }, { 1000, -1000 }, { 1000, 1000 }, { -1000, 1000 } }
+    };
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_set_fields(&field, 1));
+
+    uint16_t stop = 0;
+    uint16_t warning = 0;
+    // Farthest of the bin's edges: 1000 / cos(0.5 deg)
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(0, 0, &stop, &warning));
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(1000, stop);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(1001, stop);
+    TEST_ASSERT_EQUAL_UINT(stop, warning);
+    // Corner
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(0, 45, &stop, &warning));
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(1415, stop);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(1420, stop);
+
+    // Default rail rectangle: 400 mm beside, 200 mm behind
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_load_defaults());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(FIELD_FORWARD_FAST, 90, &stop, &warning));
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(400, stop);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(401, stop);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(600, warning);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_thresholds(FIELD_FORWARD_FAST, 180, &stop, &warning));
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(200, stop);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(201, stop);
+    tearDown();
+}
+
+void test_mount_offset_rotates_tables(void)
+{
+    setUp();
+    protective_field_deinit();
+    protective_field_options_t options = {
+        .standstill_mm_s = 20.0f,
+        .hysteresis_mm_s = 30.0f,
+        .hold_ms = 500,
+        .mount_offset_deg = 90
+    };
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_init(&options));
+
+    // Ahead of the vehicle is sensor 90 degrees, behind is sensor 270
+    expect_thresholds(FIELD_FORWARD_SLOW, 90, 800, 1500);
+    expect_thresholds(FIELD_FORWARD_SLOW, 270, 0, 0);
+    expect_thresholds(FIELD_FORWARD_SLOW, 0, 300, 500);
+    expect_thresholds(FIELD_REVERSE_SLOW, 270, 800, 1500);
+    tearDown();
+}
+
+void test_selection_by_direction_and_speed(void)
+{
+    setUp();
+    uint64_t now = 1000;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(0.0f, true, now));
+    TEST_ASSERT_EQUAL(FIELD_STANDSTILL, active_field());
+
+    // Faster fields are taken at once
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(200.0f, true, ++now));
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_SLOW, active_field());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(1200.0f, true, ++now));
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+
+    // Direction reversal is taken at once
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(-100.0f, true, ++now));
+    TEST_ASSERT_EQUAL(FIELD_REVERSE_SLOW, active_field());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(-800.0f, true, ++now));
+    TEST_ASSERT_EQUAL(FIELD_REVERSE_FAST, active_field());
+
+    // Unknown or non-finite velocity protects everything
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(0.0f, false, ++now));
+    TEST_ASSERT_EQUAL(PROTECTIVE_FIELD_FALLBACK, active_field());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(300.0f, true, ++now));
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_SLOW, active_field());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_update_motion(NAN, true, ++now));
+    TEST_ASSERT_EQUAL(PROTECTIVE_FIELD_FALLBACK, active_field());
+
+    protective_field_status_t status;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_status(&status));
+    TEST_ASSERT_EQUAL(8, status.field_switches);
+    tearDown();
+}
+
+void test_slower_field_waits_for_hysteresis_and_hold(void)
+{
+    setUp();
+    uint64_t now = 5000;
+    protective_field_update_motion(1000.0f, true, now);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+
+    // Within 30 mm/s of the 500 mm/s band edge: no switch however long
+    protective_field_update_motion(480.0f, true, now += 100);
+    protective_field_update_motion(480.0f, true, now += 1000);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+
+    // Below the margin: switch only after the hold time
+    protective_field_update_motion(400.0f, true, now += 100);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+    protective_field_update_motion(400.0f, true, now += 499);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+
+    // Speeding up restarts the hold
+    protective_field_update_motion(490.0f, true, now += 1);
+    protective_field_update_motion(400.0f, true, now += 100);
+    protective_field_update_motion(400.0f, true, now += 400);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+    protective_field_update_motion(400.0f, true, now += 100);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_SLOW, active_field());
+
+    // Back up to speed: immediate
+    protective_field_update_motion(520.0f, true, now += 1);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, active_field());
+    tearDown();
+}
+
+void test_slow_reverse_leaves_forward_field_at_once(void)
+{
+    setUp();
+    uint64_t now = 8000;
+    protective_field_update_motion(100.0f, true, now);
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_SLOW, active_field());
+
+    // Creeping backwards matches standstill, which is "slower" and inside the
+    // hysteresis margin, but forward_slow has nothing behind: leave it at once
+    protective_field_update_motion(-40.0f, true, now += 10);
+    TEST_ASSERT_EQUAL(FIELD_STANDSTILL, active_field());
+    for (int i = 0; i < 50; i++) {
+        protective_field_update_motion(-45.0f, true, now += 100);
+    }
+    TEST_ASSERT_EQUAL(FIELD_STANDSTILL, active_field());
+    expect_thresholds(FIELD_STANDSTILL, 180, 500, 1000);
+
+    // Same for the reverse fields when creeping forwards
+    protective_field_update_motion(-100.0f, true, now += 10);
+    TEST_ASSERT_EQUAL(FIELD_REVERSE_SLOW, active_field());
+    protective_field_update_motion(30.0f, true, now += 10);
+    TEST_ASSERT_EQUAL(FIELD_STANDSTILL, active_field());
+    tearDown();
+}
+
+void test_evaluate_single_pass(void)
+{
+    setUp();
+    protective_field_result_t result;
+
+    // Obstacle 1 m behind, rail structure 550 mm beside, a point without a return
+    add_return(0, 180, 1000);
+    add_return(1, 90, 550);
+    add_return(2, 0, 0);
+
+    // Unknown velocity: the obstacle behind stops the vehicle
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_evaluate(&g_scan, &result));
+    TEST_ASSERT_EQUAL(PROTECTIVE_FIELD_FALLBACK, result.field);
+    TEST_ASSERT_TRUE(result.stop_violated);
+    TEST_ASSERT_EQUAL(1, result.stop_points);
+    TEST_ASSERT_EQUAL(2, result.warning_points);
+    TEST_ASSERT_EQUAL_UINT(550, result.nearest_mm);
+    TEST_ASSERT_EQUAL_UINT(90, result.nearest_angle_deg);
+
+    // Travelling forward fast: nothing behind matters, the rail is only a warning
+    protective_field_update_motion(1500.0f, true, 100);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_evaluate(&g_scan, &result));
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_FAST, result.field);
+    TEST_ASSERT_FALSE(result.stop_violated);
+    TEST_ASSERT_TRUE(result.warning_violated);
+    TEST_ASSERT_EQUAL(0, result.stop_points);
+    TEST_ASSERT_EQUAL(1, result.warning_points);
+    TEST_ASSERT_EQUAL_UINT(550, result.nearest_mm);
+
+    // An obstacle 1.8 m ahead is inside the fast stop field but outside the slow one
+    add_return(3, 0, 1800);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_evaluate(&g_scan, &result));
+    TEST_ASSERT_TRUE(result.stop_violated);
+    TEST_ASSERT_EQUAL(1, result.stop_points);
+    TEST_ASSERT_EQUAL(2, result.warning_points);
+
+    protective_field_update_motion(-1500.0f, true, 200);
+    protective_field_update_motion(200.0f, true, 300);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_evaluate(&g_scan, &result));
+    TEST_ASSERT_EQUAL(FIELD_FORWARD_SLOW, result.field);
+    TEST_ASSERT_FALSE(result.stop_violated);
+    TEST_ASSERT_FALSE(result.warning_violated);
+    TEST_ASSERT_EQUAL_UINT(0, result.nearest_mm);
+
+    protective_field_status_t status;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_status(&status));
+    TEST_ASSERT_EQUAL(4, status.evaluations);
+    TEST_ASSERT_EQUAL(2, status.stop_violations);
+    TEST_ASSERT_EQUAL(1, status.warning_violations);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, protective_field_evaluate(NULL, &result));
+    tearDown();
+}
+
+void test_malformed_fields_rejected(void)
+{
+    setUp();
+    protective_field_def_t field = {
+        .name = "bad",
+        .direction = PROTECTIVE_FIELD_DIR_FORWARD,
+        .min_speed_mm_s = 500.0f,
+        .max_speed_mm_s = 100.0f,
+        .shape = PROTECTIVE_FIELD_SHAPE_SECTORS,
+        .sector_count = 1,
+        .sectors = { { 0, 90, 100, 200 } }
+    };
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, protective_field_set_fields(&field, 1));
+    field.max_speed_mm_s = 1000.0f;
+    field.sectors[0].end_deg = 360;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, protective_field_set_fields(&field, 1));
+    field.sectors[0].end_deg = 90;
+    field.shape = PROTECTIVE_FIELD_SHAPE_POLYGON;
+    field.stop_vertex_count = 2;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, protective_field_set_fields(&field, 1));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, protective_field_set_fields(&field, 0));
+
+    // The old set stays
+    protective_field_status_t status;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, protective_field_get_status(&status));
+    TEST_ASSERT_EQUAL(5, status.field_count);
+    tearDown();
+
+    protective_field_result_t result;
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, protective_field_evaluate(&g_scan, &result));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, protective_field_update_motion(0.0f, true, 0));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== Protective Field Tests ===\n");
+
+    RUN_TEST(test_init_loads_defaults_in_fallback);
+    RUN_TEST(test_sector_tables_cover_boundary_bins);
+    RUN_TEST(test_polygon_tables_follow_the_boundary);
+    RUN_TEST(test_mount_offset_rotates_tables);
+    RUN_TEST(test_selection_by_direction_and_speed);
+    RUN_TEST(test_slower_field_waits_for_hysteresis_and_hold);
+    RUN_TEST(test_slow_reverse_leaves_forward_field_at_once);
+    RUN_TEST(test_evaluate_single_pass);
+    RUN_TEST(test_malformed_fields_rejected);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file test_register_poll_planner.c
+ * @brief Unit tests for the register-block coalescing poll planner
+ */
+
+#include "unity.h"
+#include "register_poll_planner.h"
+#include "register_value_cache.h"
+#include "hal_common.h"
+#include <string.h>
+#include <stdio.h>
+
+static register_poll_plan_t plan;
+static register_poll_result_t result;
+
+// Fake slave: register value = address, optionally rejecting reads that touch one address
+static uint16_t fake_reject_addr;
+static bool fake_reject_enabled;
+static int fake_reads;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_planner_merges_within_gap_tolerance(void);
+void test_planner_splits_beyond_gap_tolerance(void);
+void test_planner_respects_block_limit(void);
+void test_planner_deduplicates_overlapping_ranges(void);
+void test_planner_power_layout_uses_two_reads(void);
+void test_planner_execute_scatters_results(void);
+void test_planner_execute_falls_back_on_gap_rejection(void);
+void test_planner_subtract_drops_registers_owned_elsewhere(void);
+void test_planner_estimates_bus_time(void);
+
+static hal_status_t fake_read(uint8_t slave_id, uint16_t start_address, uint16_t quantity,
+                              uint16_t *data, void *ctx)
+{
+    (void)slave_id;
+    (void)ctx;
+    fake_reads++;
+    if (fake_reject_enabled &&
+        fake_reject_addr >= start_address && fake_reject_addr < start_address + quantity) {
+        return HAL_STATUS_ERROR;  // Illegal data address exception
+    }
+    for (uint16_t i = 0; i < quantity; i++) {
+        data[i] = (uint16_t)(start_address + i);
+    }
+    return HAL_STATUS_OK;
+}
+
+void setUp(void)
+{
+    register_poll_plan_init(&plan, 4, REGISTER_POLL_MAX_BLOCK_REGS);
+    memset(&result, 0, sizeof(result));
+    fake_reject_enabled = false;
+    fake_reads = 0;
+    register_cache_init();
+}
+
+void tearDown(void)
+{
+    register_cache_clear_all();
+}
+
+void test_planner_merges_within_gap_tolerance(void)
+{
+    setUp();
+    register_poll_plan_add_range(&plan, 0x0000, 4);
+    register_poll_plan_add_range(&plan, 0x0008, 2);   // gap of 4 -> merged
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_build(&plan));
+    TEST_ASSERT_EQUAL(1, plan.block_count);
+    TEST_ASSERT_EQUAL(0x0000, plan.blocks[0].start);
+    TEST_ASSERT_EQUAL(10, plan.blocks[0].count);
+    TEST_ASSERT_EQUAL(6, plan.blocks[0].wanted_count);
+    tearDown();
+}
+
+void test_planner_splits_beyond_gap_tolerance(void)
+{
+    setUp();
+    register_poll_plan_add_range(&plan, 0x0000, 4);
+    register_poll_plan_add_range(&plan, 0x0009, 2);   // gap of 5 -> separate
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_build(&plan));
+    TEST_ASSERT_EQUAL(2, plan.block_count);
+    TEST_ASSERT_EQUAL(0x0009, plan.blocks[1].start);
+    TEST_ASSERT_EQUAL(2, plan.blocks[1].count);
+    tearDown();
+}
+
+void test_planner_respects_block_limit(void)
+{
+    setUp();
+    register_poll_plan_init(&plan, 200, REGISTER_POLL_MAX_BLOCK_REGS);
+    register_poll_plan_add_range(&plan, 0x0000, 1);
+    register_poll_plan_add_range(&plan, 0x007C, 1);   // span 125 -> fits
+    register_poll_plan_add_range(&plan, 0x007D, 1);   // span 126 -> new block
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_build(&plan));
+    TEST_ASSERT_EQUAL(2, plan.block_count);
+    TEST_ASSERT_EQUAL(125, plan.blocks[0].count);
+    TEST_ASSERT_EQUAL(0x007D, plan.blocks[1].start);
+    tearDown();
+}
+
+void test_planner_deduplicates_overlapping_ranges(void)
+{
+    setUp();
+    register_poll_plan_add_range(&plan, 0x0104, 4);
+    register_poll_plan_add_range(&plan, 0x0100, 8);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_build(&plan));
+    TEST_ASSERT_EQUAL(8, plan.wanted_count);
+    TEST_ASSERT_EQUAL(1, plan.block_count);
+    TEST_ASSERT_EQUAL(8, plan.blocks[0].count);
+    tearDown();
+}
+
+void test_planner_power_layout_uses_two_reads(void)
+{
+    static const register_poll_range_t power[] = {
+        {0x0000, 11}, {0x0014, 6}, {0x001C, 6}, {0x0030, 8}, {0x003E, 1},
+        {0x0040, 9}, {0x0049, 4}, {0x004D, 1}, {0x0100, 8},
+    };
+    setUp();
+    register_poll_plan_init(&plan, REGISTER_POLL_DEFAULT_MAX_GAP, REGISTER_POLL_MAX_BLOCK_REGS);
+    register_poll_plan_add_ranges(&plan, power, (uint16_t)(sizeof(power) / sizeof(power[0])));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_build(&plan));
+    TEST_ASSERT_EQUAL(2, plan.block_count);
+    TEST_ASSERT_EQUAL(0x0000, plan.blocks[0].start);
+    TEST_ASSERT_EQUAL(0x004E, plan.blocks[0].count);
+    TEST_ASSERT_EQUAL(0x0100, plan.blocks[1].start);
+    tearDown();
+}
+
+void test_planner_execute_scatters_results(void)
+{
+    setUp();
+    register_poll_plan_add_range(&plan, 0x0010, 2);
+    register_poll_plan_add_range(&plan, 0x0014, 1);
+    register_poll_plan_build(&plan);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_execute(&plan, 0x02, fake_read, NULL, &result));
+    TEST_ASSERT_EQUAL(1, result.transactions);
+    TEST_ASSERT_EQUAL(3, result.valid_count);
+
+    uint16_t value = 0;
+    TEST_ASSERT_TRUE(register_poll_result_get(&plan, &result, 0x0014, &value));
+    TEST_ASSERT_EQUAL(0x0014, value);
+    TEST_ASSERT_FALSE(register_poll_result_get(&plan, &result, 0x0012, &value));  // gap filler
+
+    // Wanted registers land in the cache, gap fillers do not
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get(0x02, 0x0011, &value, NULL));
+    TEST_ASSERT_EQUAL(0x0011, value);
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, register_cache_get(0x02, 0x0012, &value, NULL));
+    tearDown();
+}
+
+void test_planner_execute_falls_back_on_gap_rejection(void)
+{
+    setUp();
+    register_poll_plan_add_range(&plan, 0x0020, 2);
+    register_poll_plan_add_range(&plan, 0x0024, 2);
+    register_poll_plan_build(&plan);
+    TEST_ASSERT_EQUAL(1, plan.block_count);
+
+    fake_reject_enabled = true;
+    fake_reject_addr = 0x0022;  // unmapped gap register
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_execute(&plan, 0x03, fake_read, NULL, &result));
+    TEST_ASSERT_EQUAL(3, result.transactions);   // merged read + 2 runs
+    TEST_ASSERT_EQUAL(1, result.failed_blocks);
+    TEST_ASSERT_EQUAL(4, result.valid_count);
+    tearDown();
+}
+
+void test_planner_subtract_drops_registers_owned_elsewhere(void)
+{
+    register_poll_plan_t fast;
+    setUp();
+    register_poll_plan_init(&fast, 4, REGISTER_POLL_MAX_BLOCK_REGS);
+    register_poll_plan_add_range(&fast, 0x0000, 4);
+    register_poll_plan_build(&fast);
+
+    register_poll_plan_add_range(&plan, 0x0000, 8);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_subtract(&plan, &fast));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_poll_plan_build(&plan));
+    TEST_ASSERT_EQUAL(4, plan.wanted_count);
+    TEST_ASSERT_EQUAL(0x0004, plan.blocks[0].start);
+    tearDown();
+}
+
+void test_planner_estimates_bus_time(void)
+{
+    setUp();
+    register_poll_plan_add_range(&plan, 0x0100, 8);
+    register_poll_plan_build(&plan);
+
+    // 8 + 21 chars at 11 bits / 115200 baud = 2769 us, + 2 x 1750 us t3.5 + turnaround
+    uint32_t est = register_poll_plan_estimate_us(&plan, 115200);
+    TEST_ASSERT_EQUAL_UINT(2769 + 3500 + REGISTER_POLL_TURNAROUND_US, est);
+
+    // Two blocks cost two turnarounds
+    register_poll_plan_add_range(&plan, 0x0200, 8);
+    register_poll_plan_build(&plan);
+    TEST_ASSERT_GREATER_THAN(2 * est - 10, register_poll_plan_estimate_us(&plan, 115200));
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_planner_merges_within_gap_tolerance);
+    RUN_TEST(test_planner_splits_beyond_gap_tolerance);
+    RUN_TEST(test_planner_respects_block_limit);
+    RUN_TEST(test_planner_deduplicates_overlapping_ranges);
+    RUN_TEST(test_planner_power_layout_uses_two_reads);
+    RUN_TEST(test_planner_execute_scatters_results);
+    RUN_TEST(test_planner_execute_falls_back_on_gap_rejection);
+    RUN_TEST(test_planner_subtract_drops_registers_owned_elsewhere);
+    RUN_TEST(test_planner_estimates_bus_time);
+
+    UNITY_END();
+    return 0;
+}
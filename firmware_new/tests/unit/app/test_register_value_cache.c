@@ -0,0 +1,255 @@
+/**
+ * @file test_register_value_cache.c
+ * @brief Unit tests for the seqlock register value cache
+ */
+
+#include "unity.h"
+#include "register_value_cache.h"
+#include "hal_common.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <stdio.h>
+
+#define STRESS_MODULE       0x02
+#define STRESS_START_ADDR   0x0040
+#define STRESS_COUNT        32
+#define STRESS_ITERATIONS   20000
+
+static register_cache_snapshot_t snapshot;
+static atomic_bool stress_done;
+static atomic_int stress_torn_reads;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_cache_store_and_get(void);
+void test_cache_miss_reports_not_found(void);
+void test_cache_batch_shares_timestamp(void);
+void test_cache_snapshot_sorted_and_searchable(void);
+void test_cache_clear_module(void);
+void test_cache_full_rejects_new_registers(void);
+void test_cache_readers_never_see_torn_batches(void);
+
+void setUp(void)
+{
+    register_cache_init();
+    memset(&snapshot, 0, sizeof(snapshot));
+}
+
+void tearDown(void)
+{
+    register_cache_clear_all();
+}
+
+void test_cache_store_and_get(void)
+{
+    setUp();
+    uint16_t value = 0;
+    uint64_t timestamp = 0;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store(0x03, 0x1234, 0xBEEF));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get(0x03, 0x1234, &value, &timestamp));
+    TEST_ASSERT_EQUAL_UINT(0xBEEF, value);
+    TEST_ASSERT_TRUE(timestamp > 0);
+    TEST_ASSERT_TRUE(register_cache_has_data(0x03));
+    TEST_ASSERT_FALSE(register_cache_has_data(0x04));
+
+    // Overwrite keeps a single entry
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store(0x03, 0x1234, 0x0001));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_snapshot(0x03, &snapshot));
+    TEST_ASSERT_EQUAL_UINT(1, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT(0x0001, snapshot.entries[0].value);
+    tearDown();
+}
+
+void test_cache_miss_reports_not_found(void)
+{
+    setUp();
+    uint16_t value = 0;
+    uint64_t timestamp = 0;
+
+    register_cache_store(0x05, 0x0100, 7);
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, register_cache_get(0x05, 0x0101, &value, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, register_cache_get(0x05, 0x0200, &value, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, register_cache_get_last_update(0x06, &timestamp));
+
+    cache_statistics_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get_statistics(&stats));
+    TEST_ASSERT_EQUAL_UINT(2, stats.cache_misses);
+    tearDown();
+}
+
+void test_cache_batch_shares_timestamp(void)
+{
+    setUp();
+    uint16_t values[4] = {10, 11, 12, 13};
+    uint64_t last_update = 0;
+
+    // Batch straddles a page boundary
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store_batch(0x02, 0x00FE, values, 4));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_snapshot(0x02, &snapshot));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get_last_update(0x02, &last_update));
+
+    TEST_ASSERT_EQUAL_UINT(4, snapshot.count);
+    for (uint16_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT(0x00FE + i, snapshot.entries[i].address);
+        TEST_ASSERT_EQUAL_UINT(values[i], snapshot.entries[i].value);
+        TEST_ASSERT_TRUE(snapshot.entries[i].timestamp_ms == last_update);
+    }
+    tearDown();
+}
+
+void test_cache_snapshot_sorted_and_searchable(void)
+{
+    setUp();
+    static const uint16_t addrs[] = {0x7000, 0x0003, 0x00FF, 0x0100, 0x0001, 0xFFFF};
+    uint16_t value = 0;
+
+    for (uint16_t i = 0; i < sizeof(addrs) / sizeof(addrs[0]); i++) {
+        register_cache_store(0x04, addrs[i], (uint16_t)(addrs[i] ^ 0x5A5A));
+    }
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_snapshot(0x04, &snapshot));
+    TEST_ASSERT_EQUAL_UINT(6, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT(0x04, snapshot.module_address);
+    for (uint16_t i = 1; i < snapshot.count; i++) {
+        TEST_ASSERT_TRUE(snapshot.entries[i - 1].address < snapshot.entries[i].address);
+    }
+
+    for (uint16_t i = 0; i < sizeof(addrs) / sizeof(addrs[0]); i++) {
+        TEST_ASSERT_TRUE(register_cache_snapshot_find(&snapshot, addrs[i], &value, NULL));
+        TEST_ASSERT_EQUAL_UINT(addrs[i] ^ 0x5A5A, value);
+    }
+    TEST_ASSERT_FALSE(register_cache_snapshot_find(&snapshot, 0x0002, &value, NULL));
+
+    // get_all returns the same ordered view, truncated to the caller's buffer
+    register_value_entry_t entries[3];
+    uint16_t count = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get_all(0x04, entries, 3, &count));
+    TEST_ASSERT_EQUAL_UINT(3, count);
+    TEST_ASSERT_EQUAL_UINT(0x0001, entries[0].address);
+    TEST_ASSERT_EQUAL_UINT(0x00FF, entries[2].address);
+    tearDown();
+}
+
+void test_cache_clear_module(void)
+{
+    setUp();
+    uint16_t value = 0;
+
+    register_cache_store(0x02, 0x0000, 1);
+    register_cache_store(0x03, 0x0000, 2);
+    uint32_t version_before = 0;
+    register_cache_snapshot(0x02, &snapshot);
+    version_before = snapshot.version;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_clear_module(0x02));
+    TEST_ASSERT_FALSE(register_cache_has_data(0x02));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, register_cache_get(0x02, 0x0000, &value, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get(0x03, 0x0000, &value, NULL));
+
+    register_cache_snapshot(0x02, &snapshot);
+    TEST_ASSERT_EQUAL_UINT(0, snapshot.count);
+    TEST_ASSERT_TRUE(snapshot.version > version_before);
+    tearDown();
+}
+
+void test_cache_full_rejects_new_registers(void)
+{
+    setUp();
+    uint16_t value = 0;
+
+    for (uint32_t i = 0; i < MAX_CACHED_REGISTERS_PER_MODULE; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store(0x07, (uint16_t)(i * 3U), (uint16_t)i));
+    }
+
+    // New address is rejected, existing ones can still be updated
+    TEST_ASSERT_EQUAL(HAL_STATUS_ERROR, register_cache_store(0x07, 0x0001, 1));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store(0x07, 0x0003, 0x1111));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get(0x07, 0x0003, &value, NULL));
+    TEST_ASSERT_EQUAL_UINT(0x1111, value);
+
+    register_cache_snapshot(0x07, &snapshot);
+    TEST_ASSERT_EQUAL_UINT(MAX_CACHED_REGISTERS_PER_MODULE, snapshot.count);
+    tearDown();
+}
+
+static void* stress_writer(void *arg)
+{
+    (void)arg;
+    uint16_t values[STRESS_COUNT];
+
+    for (uint16_t iter = 1; iter <= STRESS_ITERATIONS; iter++) {
+        for (uint16_t i = 0; i < STRESS_COUNT; i++) {
+            values[i] = iter;
+        }
+        register_cache_store_batch(STRESS_MODULE, STRESS_START_ADDR, values, STRESS_COUNT);
+    }
+    atomic_store(&stress_done, true);
+    return NULL;
+}
+
+static void* stress_reader(void *arg)
+{
+    register_cache_snapshot_t *local = (register_cache_snapshot_t *)arg;
+
+    while (!atomic_load(&stress_done)) {
+        if (register_cache_snapshot(STRESS_MODULE, local) != HAL_STATUS_OK || local->count == 0) {
+            continue;
+        }
+        // Every register of a batch must come from the same store
+        for (uint16_t i = 1; i < local->count; i++) {
+            if (local->entries[i].value != local->entries[0].value) {
+                atomic_fetch_add(&stress_torn_reads, 1);
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+void test_cache_readers_never_see_torn_batches(void)
+{
+    setUp();
+    static register_cache_snapshot_t reader_snapshots[2];
+    pthread_t writer;
+    pthread_t readers[2];
+    uint16_t value = 0;
+
+    atomic_store(&stress_done, false);
+    atomic_store(&stress_torn_reads, 0);
+
+    for (int i = 0; i < 2; i++) {
+        pthread_create(&readers[i], NULL, stress_reader, &reader_snapshots[i]);
+    }
+    pthread_create(&writer, NULL, stress_writer, NULL);
+
+    pthread_join(writer, NULL);
+    for (int i = 0; i < 2; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL(0, atomic_load(&stress_torn_reads));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_get(STRESS_MODULE, STRESS_START_ADDR, &value, NULL));
+    TEST_ASSERT_EQUAL_UINT(STRESS_ITERATIONS, value);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== REGISTER VALUE CACHE TESTS ===\n");
+
+    RUN_TEST(test_cache_store_and_get);
+    RUN_TEST(test_cache_miss_reports_not_found);
+    RUN_TEST(test_cache_batch_shares_timestamp);
+    RUN_TEST(test_cache_snapshot_sorted_and_searchable);
+    RUN_TEST(test_cache_clear_module);
+    RUN_TEST(test_cache_full_rejects_new_registers);
+    RUN_TEST(test_cache_readers_never_see_torn_batches);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file test_safety_monitor_lidar.c
+ * @brief Tests for the LiDAR safety handler registered with hal_lidar
+ *
+ * Scans are driven through safety_monitor_lidar_handler() exactly as the
+ * pipeline's safety worker and the main loop call it. The E-Stop runs on a
+ * fake sysfs pin and is shared with the monitor, as in main.c.
+ */
+
+#include "unity.h"
+#include "safety_monitor.h"
+#include "hal_lidar.h"
+#include "hal_lidar_pipeline.h"
+#include "hal_estop.h"
+#include "hal_gpio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#define TEST_PIN            59
+#define TEST_FRAME_US       1000000ULL
+
+static char fake_root[64];
+static int fifo_fd = -1;
+static lidar_scan_data_t g_scan;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_handler_rejects_uninitialized_monitor(void);
+void test_obstacle_in_stop_field_triggers_estop(void);
+void test_clear_scan_does_not_stop(void);
+void test_frame_is_decided_once(void);
+void test_safety_worker_scan_produces_stop(void);
+
+static void write_file(const char *dir, const char *name, const char *content)
+{
+    char path[160];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *fp = fopen(path, "w");
+    if (fp != NULL) {
+        fputs(content, fp);
+        fclose(fp);
+    }
+}
+
+static hal_status_t standstill_velocity(float *velocity_mm_s)
+{
+    *velocity_mm_s = 0.0f;
+    return HAL_STATUS_OK;
+}
+
+/**
+ * @brief Full revolution with every point at the same distance
+ */
+static void fill_scan(uint16_t distance_mm, uint64_t frame_us)
+{
+    memset(&g_scan, 0, sizeof(g_scan));
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        g_scan.angle_q6[i] = (uint16_t)((uint32_t)i * 360U * 64U / LIDAR_POINTS_PER_SCAN);
+        g_scan.distance_mm[i] = distance_mm;
+        g_scan.quality[i] = 200;
+    }
+    g_scan.point_count = LIDAR_POINTS_PER_SCAN;
+    g_scan.scan_complete = true;
+    g_scan.base_timestamp_us = frame_us;
+}
+
+// Handler as registered with hal_lidar_set_safety_handler() in main.c
+static lidar_safety_handler_t g_handler = safety_monitor_lidar_handler;
+static hal_status_t g_handler_status;
+
+/**
+ * @brief Safety stage as hal_lidar runs it: the registered handler on the safety worker
+ */
+static void safety_stage(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    __atomic_store_n(&g_handler_status, g_handler(NULL, scan), __ATOMIC_RELEASE);
+}
+
+static bool estop_active(void)
+{
+    bool active = false;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_is_estop_active(&active));
+    return active;
+}
+
+void setUp(void)
+{
+    char pin_dir[128];
+    char value_path[160];
+    estop_config_t config = {
+        .pin = TEST_PIN,
+        .response_timeout_ms = ESTOP_RESPONSE_TIME_MS,
+        .debounce_time_ms = ESTOP_DEBOUNCE_TIME_MS,
+        .auto_reset_enabled = false
+    };
+
+    snprintf(fake_root, sizeof(fake_root), "/tmp/oht50_safety_XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(fake_root));
+    snprintf(pin_dir, sizeof(pin_dir), "%s/gpio%d", fake_root, TEST_PIN);
+    mkdir(pin_dir, 0755);
+    write_file(fake_root, "export", "");
+    write_file(fake_root, "unexport", "");
+    write_file(pin_dir, "direction", "in");
+    write_file(pin_dir, "edge", "none");
+    snprintf(value_path, sizeof(value_path), "%s/value", pin_dir);
+    mkfifo(value_path, 0644);
+    fifo_fd = open(value_path, O_RDWR | O_NONBLOCK);
+    TEST_ASSERT_EQUAL(1, (int)write(fifo_fd, "1", 1));
+
+    hal_gpio_set_sysfs_root(fake_root);
+    hal_gpio_init();
+
+    // E-Stop first, then the monitor shares it (main.c order)
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_estop_init(&config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_init(NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_set_velocity_source(standstill_velocity));
+}
+
+void tearDown(void)
+{
+    char cmd[96];
+
+    safety_monitor_deinit();
+    hal_estop_deinit();
+    hal_gpio_deinit();
+    hal_gpio_set_sysfs_root(NULL);
+    if (fifo_fd >= 0) {
+        close(fifo_fd);
+        fifo_fd = -1;
+    }
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", fake_root);
+    (void)system(cmd);
+}
+
+void test_handler_rejects_uninitialized_monitor(void)
+{
+    fill_scan(300, TEST_FRAME_US);
+
+    // The HAL treats any non-OK return as an emergency stop
+    TEST_ASSERT_TRUE(safety_monitor_lidar_handler(NULL, &g_scan) != HAL_STATUS_OK);
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, safety_monitor_set_velocity_source(standstill_velocity));
+}
+
+void test_obstacle_in_stop_field_triggers_estop(void)
+{
+    setUp();
+    safety_monitor_status_t status;
+    safety_fault_code_t fault;
+
+    // 300 mm all round is inside the standstill stop field
+    fill_scan(300, TEST_FRAME_US);
+    TEST_ASSERT_FALSE(estop_active());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_lidar_handler(NULL, &g_scan));
+
+    TEST_ASSERT_TRUE(estop_active());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_get_status(&status));
+    TEST_ASSERT_EQUAL(SAFETY_MONITOR_STATE_ESTOP, status.current_state);
+    TEST_ASSERT_TRUE(status.safety_zones.emergency_violated);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_get_last_fault(&fault));
+    TEST_ASSERT_EQUAL(SAFETY_FAULT_CODE_ZONE_VIOLATION, fault);
+    tearDown();
+}
+
+void test_clear_scan_does_not_stop(void)
+{
+    setUp();
+    safety_monitor_status_t status;
+
+    fill_scan(5000, TEST_FRAME_US);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_lidar_handler(NULL, &g_scan));
+
+    TEST_ASSERT_FALSE(estop_active());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_get_status(&status));
+    TEST_ASSERT_FALSE(status.zone_violation);
+    TEST_ASSERT_EQUAL(5000, status.safety_zones.min_distance_mm);
+    tearDown();
+}
+
+void test_frame_is_decided_once(void)
+{
+    setUp();
+    safety_monitor_stats_t stats;
+
+    // Warning-zone return: counted as a violation without latching a stop
+    fill_scan(800, TEST_FRAME_US);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_lidar_handler(NULL, &g_scan));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_lidar_handler(NULL, &g_scan));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_get_stats(&stats));
+    TEST_ASSERT_EQUAL(1, stats.zone_violations);
+    TEST_ASSERT_FALSE(estop_active());
+
+    // The next revolution is decided again
+    fill_scan(800, TEST_FRAME_US + 100000ULL);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_lidar_handler(NULL, &g_scan));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_get_stats(&stats));
+    TEST_ASSERT_EQUAL(2, stats.zone_violations);
+    tearDown();
+}
+
+void test_safety_worker_scan_produces_stop(void)
+{
+    setUp();
+    static lidar_pipeline_t pipeline;
+    lidar_pipeline_config_t config = {
+        .workers = 2,
+        .safety_cpu = LIDAR_PIPELINE_CPU_NONE,
+        .safety_priority = 0,
+        .stages = {
+            [LIDAR_STAGE_SAFETY] = { safety_stage, NULL },
+        },
+    };
+
+    g_handler_status = HAL_STATUS_ERROR;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_init(&pipeline));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&pipeline, &config));
+
+    // One revolution with an obstacle inside the stop field
+    lidar_scan_data_t *frame = lidar_pipeline_acquire(&pipeline);
+    TEST_ASSERT_NOT_NULL(frame);
+    fill_scan(300, TEST_FRAME_US);
+    *frame = g_scan;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_submit(&pipeline, frame, 0));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&pipeline, 2000));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, __atomic_load_n(&g_handler_status, __ATOMIC_ACQUIRE));
+    TEST_ASSERT_TRUE(estop_active());
+
+    // The main loop's later look at the same frame changes nothing
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_lidar_handler(NULL, &g_scan));
+    safety_monitor_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, safety_monitor_get_stats(&stats));
+    TEST_ASSERT_EQUAL(1, stats.zone_violations);
+
+    lidar_pipeline_deinit(&pipeline);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== Safety Monitor LiDAR Handler Tests ===\n");
+
+    RUN_TEST(test_handler_rejects_uninitialized_monitor);
+    RUN_TEST(test_obstacle_in_stop_field_triggers_estop);
+    RUN_TEST(test_clear_scan_does_not_stop);
+    RUN_TEST(test_frame_is_decided_once);
+    RUN_TEST(test_safety_worker_scan_produces_stop);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file test_telemetry_stream.c
+ * @brief Unit tests for the telemetry push stream and its chunked transport
+ */
+
+#include "unity.h"
+#include "telemetry_stream.h"
+#include "register_value_cache.h"
+#include "http_event_server.h"
+#include "hal_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define TEST_MODULE             0x02
+#define TEST_INTERVAL_MS        200
+#define TEST_RECV_TIMEOUT_SEC   2
+
+static int notify_count;
+static char out[8192];
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_parse_filter(void);
+void test_cache_changes_reach_subscriber(void);
+void test_coalescing_and_drop_oldest(void);
+void test_min_interval_limits_batches(void);
+void test_chunked_stream_over_http(void);
+
+static void count_notify(void *ctx)
+{
+    (void)ctx;
+    notify_count++;
+}
+
+void setUp(void)
+{
+    notify_count = 0;
+    memset(out, 0, sizeof(out));
+    telemetry_stream_init();
+    register_cache_init();
+    register_cache_set_change_listener(telemetry_stream_on_registers, NULL);
+}
+
+void tearDown(void)
+{
+    register_cache_set_change_listener(NULL, NULL);
+    register_cache_deinit();
+    telemetry_stream_deinit();
+}
+
+void test_parse_filter(void)
+{
+    setUp();
+    telemetry_stream_filter_t filter;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, telemetry_stream_parse_filter(NULL, &filter));
+    TEST_ASSERT_TRUE(filter.all_modules);
+    TEST_ASSERT_EQUAL(TELEMETRY_STREAM_FORMAT_SSE, filter.format);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, telemetry_stream_parse_filter(
+        "modules=2,3&registers=0x40,0x41&interval_ms=100&format=ndjson&events=0", &filter));
+    TEST_ASSERT_FALSE(filter.all_modules);
+    TEST_ASSERT_TRUE((filter.module_mask[0] & 0x0C) == 0x0C);
+    TEST_ASSERT_EQUAL_UINT(2, filter.register_count);
+    TEST_ASSERT_EQUAL_UINT(0x41, filter.registers[1]);
+    TEST_ASSERT_EQUAL_UINT(100, filter.min_interval_ms);
+    TEST_ASSERT_EQUAL(TELEMETRY_STREAM_FORMAT_NDJSON, filter.format);
+    TEST_ASSERT_FALSE(filter.include_events);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, telemetry_stream_parse_filter("modules=300", &filter));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, telemetry_stream_parse_filter("format=xml", &filter));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, telemetry_stream_parse_filter("registers=0x40,x", &filter));
+    tearDown();
+}
+
+void test_cache_changes_reach_subscriber(void)
+{
+    setUp();
+    telemetry_stream_filter_t filter;
+    uint32_t id = 0;
+    uint16_t values[3] = { 10, 20, 30 };
+
+    telemetry_stream_parse_filter("modules=2&registers=0x40,0x42&events=0", &filter);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, telemetry_stream_subscribe(&filter, count_notify, NULL, &id));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store_batch(TEST_MODULE, 0x40, values, 3));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, register_cache_store_batch(TEST_MODULE + 1, 0x40, values, 3));
+    TEST_ASSERT_EQUAL(1, notify_count);
+
+    size_t len = telemetry_stream_read(id, out, sizeof(out));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_NOT_NULL(strstr(out, "event: registers\ndata: {\"module\":2,"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"address\":\"0x0040\",\"value\":10},{\"address\":\"0x0042\",\"value\":30}]}\n\n"));
+    TEST_ASSERT_TRUE(strstr(out, "0x0041") == NULL);
+
+    // Unchanged values are not re-sent; a changed one is
+    register_cache_store_batch(TEST_MODULE, 0x40, values, 3);
+    TEST_ASSERT_EQUAL_UINT(0, telemetry_stream_read(id, out, sizeof(out)));
+    register_cache_store(TEST_MODULE, 0x42, 31);
+    TEST_ASSERT_TRUE(telemetry_stream_read(id, out, sizeof(out)) > 0);
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"value\":31"));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, telemetry_stream_unsubscribe(id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, telemetry_stream_unsubscribe(id));
+    tearDown();
+}
+
+void test_coalescing_and_drop_oldest(void)
+{
+    setUp();
+    telemetry_stream_filter_t filter;
+    telemetry_stream_stats_t stats;
+    uint32_t id = 0;
+
+    telemetry_stream_parse_filter("format=ndjson", &filter);
+    telemetry_stream_subscribe(&filter, count_notify, NULL, &id);
+
+    // Three writes of one register leave one queued value
+    for (uint16_t v = 1; v <= 3; v++) {
+        telemetry_stream_on_registers(TEST_MODULE, 0x10, &v, 1, 1000 + v, NULL);
+    }
+    size_t len = telemetry_stream_read(id, out, sizeof(out));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"type\":\"registers\",\"module\":2,\"timestamp\":1003,\"dropped\":0,"
+                                     "\"registers\":[{\"address\":\"0x0010\",\"value\":3}]}\n"));
+
+    // Two more distinct registers than the queue holds evict the two oldest
+    uint16_t values[TELEMETRY_STREAM_QUEUE_DEPTH + 2];
+    for (uint16_t i = 0; i < TELEMETRY_STREAM_QUEUE_DEPTH + 2; i++) {
+        values[i] = i;
+    }
+    telemetry_stream_on_registers(TEST_MODULE, 0x100, values, TELEMETRY_STREAM_QUEUE_DEPTH + 2, 2000, NULL);
+    telemetry_stream_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT(2, stats.deltas_dropped);
+    TEST_ASSERT_EQUAL_UINT(2, stats.deltas_coalesced);
+
+    // Batches larger than one read are split without losing entries
+    char small[1024];
+    size_t total_entries = 0;
+    bool first = true;
+    while ((len = telemetry_stream_read(id, small, sizeof(small))) > 0) {
+        small[len] = '\0';
+        if (first) {
+            TEST_ASSERT_NOT_NULL(strstr(small, "\"dropped\":2,"));
+            TEST_ASSERT_NOT_NULL(strstr(small, "{\"address\":\"0x0102\",\"value\":2}"));
+            first = false;
+        }
+        for (const char *p = strstr(small, "\"address\""); p != NULL; p = strstr(p + 1, "\"address\"")) {
+            total_entries++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT(TELEMETRY_STREAM_QUEUE_DEPTH, total_entries);
+    tearDown();
+}
+
+void test_min_interval_limits_batches(void)
+{
+    setUp();
+    telemetry_stream_filter_t filter;
+    uint32_t id = 0;
+    uint16_t value = 1;
+
+    telemetry_stream_parse_filter("interval_ms=200", &filter);
+    telemetry_stream_subscribe(&filter, count_notify, NULL, &id);
+
+    telemetry_stream_on_registers(TEST_MODULE, 0x20, &value, 1, 1, NULL);
+    TEST_ASSERT_TRUE(telemetry_stream_read(id, out, sizeof(out)) > 0);
+
+    // Changes inside the interval wait, then go out coalesced
+    value = 2;
+    telemetry_stream_on_registers(TEST_MODULE, 0x20, &value, 1, 2, NULL);
+    value = 3;
+    telemetry_stream_on_registers(TEST_MODULE, 0x20, &value, 1, 3, NULL);
+    TEST_ASSERT_EQUAL_UINT(0, telemetry_stream_read(id, out, sizeof(out)));
+
+    // Events are not held back by the register interval
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, telemetry_stream_publish_event("status", "{\n  \"state\": \"idle mode\"\n}"));
+    size_t len = telemetry_stream_read(id, out, sizeof(out));
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("event: status\ndata: {\"state\":\"idle mode\"}\n\n", out);
+
+    usleep((TEST_INTERVAL_MS + 20) * 1000);
+    len = telemetry_stream_read(id, out, sizeof(out));
+    out[len] = '\0';
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"value\":3}"));
+    TEST_ASSERT_TRUE(strstr(out, "\"value\":2}") == NULL);
+    tearDown();
+}
+
+static http_event_server_t *server;
+
+typedef struct {
+    uint32_t subscriber_id;
+    uint64_t connection_id;
+} test_stream_t;
+
+static void stream_notify(void *ctx)
+{
+    (void)http_event_server_stream_notify(server, ((test_stream_t *)ctx)->connection_id);
+}
+
+static size_t stream_read(void *ctx, char *buf, size_t capacity)
+{
+    return telemetry_stream_read(((test_stream_t *)ctx)->subscriber_id, buf, capacity);
+}
+
+static void stream_close(void *ctx)
+{
+    telemetry_stream_unsubscribe(((test_stream_t *)ctx)->subscriber_id);
+    free(ctx);
+}
+
+static void stream_handler(const http_event_request_t *request, http_event_response_t *response, void *user_data)
+{
+    (void)user_data;
+    telemetry_stream_filter_t filter;
+    test_stream_t *stream = calloc(1, sizeof(test_stream_t));
+
+    telemetry_stream_parse_filter("format=ndjson", &filter);
+    stream->connection_id = request->connection_id;
+    telemetry_stream_subscribe(&filter, stream_notify, stream, &stream->subscriber_id);
+    response->status_code = 200;
+    snprintf(response->content_type, sizeof(response->content_type), "application/x-ndjson");
+    response->stream_read = stream_read;
+    response->stream_close = stream_close;
+    response->stream_ctx = stream;
+}
+
+/**
+ * @brief Receive until needle shows up in the accumulated text
+ */
+static bool recv_until(int fd, char *buf, size_t capacity, size_t *len, const char *needle)
+{
+    while (strstr(buf, needle) == NULL) {
+        ssize_t n = recv(fd, buf + *len, capacity - *len - 1, 0);
+        if (n <= 0) {
+            return false;
+        }
+        *len += (size_t)n;
+        buf[*len] = '\0';
+    }
+    return true;
+}
+
+void test_chunked_stream_over_http(void)
+{
+    setUp();
+    http_event_server_config_t config = {
+        .port = 0,
+        .worker_count = 2,
+        .keep_alive = true,
+        .handler = stream_handler,
+        .name = "TEST_STREAM",
+    };
+    http_event_server_stats_t stats;
+    telemetry_stream_stats_t stream_stats;
+    struct sockaddr_in addr;
+    struct timeval timeout = { .tv_sec = TEST_RECV_TIMEOUT_SEC, .tv_usec = 0 };
+    size_t len = 0;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_event_server_create(&config, &server));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, http_event_server_start(server));
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(http_event_server_get_port(server));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    TEST_ASSERT_EQUAL(0, connect(fd, (struct sockaddr *)&addr, sizeof(addr)));
+
+    const char *request = "GET /stream HTTP/1.1\r\nHost: x\r\n\r\n";
+    send(fd, request, strlen(request), 0);
+    TEST_ASSERT_TRUE(recv_until(fd, out, sizeof(out), &len, "\r\n\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "HTTP/1.1 200 OK\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "Transfer-Encoding: chunked\r\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "Content-Type: application/x-ndjson\r\n"));
+    TEST_ASSERT_TRUE(strstr(out, "Content-Length") == NULL);
+
+    // A cache store on another thread is pushed without the client asking again
+    uint16_t value = 77;
+    register_cache_store_batch(TEST_MODULE, 0x40, &value, 1);
+    TEST_ASSERT_TRUE(recv_until(fd, out, sizeof(out), &len, "\"value\":77}]}\n\r\n"));
+    const char *chunk = strstr(out, "\r\n\r\n") + 4;
+    size_t chunk_size = (size_t)strtoul(chunk, NULL, 16);
+    const char *payload = strstr(chunk, "\r\n") + 2;
+    TEST_ASSERT_EQUAL_UINT(strlen(payload) - 2, chunk_size);
+
+    telemetry_stream_publish_event("status", "{\"state\":\"run\"}");
+    TEST_ASSERT_TRUE(recv_until(fd, out, sizeof(out), &len, "{\"type\":\"event\",\"event\":\"status\""));
+
+    http_event_server_get_stats(server, &stats);
+    TEST_ASSERT_EQUAL_UINT(1, stats.streams_active);
+    TEST_ASSERT_TRUE(stats.stream_chunks >= 2);
+
+    // Client hang-up releases the subscription
+    close(fd);
+    for (int waited = 0; waited < 100; waited++) {
+        telemetry_stream_get_stats(&stream_stats);
+        if (stream_stats.subscribers == 0) {
+            break;
+        }
+        usleep(10000);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, stream_stats.subscribers);
+    http_event_server_get_stats(server, &stats);
+    TEST_ASSERT_EQUAL_UINT(0, stats.streams_active);
+
+    http_event_server_destroy(server);
+    server = NULL;
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== TELEMETRY STREAM TESTS ===\n");
+
+    RUN_TEST(test_parse_filter);
+    RUN_TEST(test_cache_changes_reach_subscriber);
+    RUN_TEST(test_coalescing_and_drop_oldest);
+    RUN_TEST(test_min_interval_limits_batches);
+    RUN_TEST(test_chunked_stream_over_http);
+
+    UNITY_END();
+    return 0;
+}
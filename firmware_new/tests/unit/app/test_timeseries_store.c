@@ -0,0 +1,438 @@
+/**
+ * @file test_timeseries_store.c
+ * @brief Tests for the on-disk time-series store
+ */
+
+#include "unity.h"
+#include "timeseries_store.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_open_rejects_bad_config(void);
+void test_register_samples_round_trip(void);
+void test_telemetry_floats_round_trip_exactly(void);
+void test_steady_polling_compresses_well(void);
+void test_history_survives_reopen(void);
+void test_downsampling_min_max_avg(void);
+void test_retention_drops_whole_segments_over_budget(void);
+void test_retention_drops_expired_segments(void);
+void test_clock_step_back_keeps_both_runs(void);
+void test_unindexed_tail_is_cut_on_reopen(void);
+void test_list_series_by_module(void);
+
+#define T0_MS   1700000000000ULL
+
+static char g_dir[64];
+static ts_store_config_t g_config;
+static ts_point_t g_points[4096];
+
+static void remove_dir(const char *path)
+{
+    DIR *dir = opendir(path);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (strcmp(ent->d_name, ".") != 0 && strcmp(ent->d_name, "..") != 0) {
+            char file[320];
+            snprintf(file, sizeof(file), "%s/%s", path, ent->d_name);
+            unlink(file);
+        }
+    }
+    closedir(dir);
+    rmdir(path);
+}
+
+void setUp(void)
+{
+    snprintf(g_dir, sizeof(g_dir), "/tmp/ts_store_test_XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(g_dir));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_get_default_config(&g_config));
+    snprintf(g_config.directory, sizeof(g_config.directory), "%s/history", g_dir);
+}
+
+void tearDown(void)
+{
+    if (ts_store_is_open()) {
+        ts_store_close();
+    }
+    char sub[96];
+    snprintf(sub, sizeof(sub), "%s/history", g_dir);
+    remove_dir(sub);
+    remove_dir(g_dir);
+}
+
+static ts_series_key_t reg_key(uint8_t module, uint16_t reg)
+{
+    ts_series_key_t key = { module, TS_SERIES_REGISTER, reg };
+    return key;
+}
+
+static uint32_t query_raw(ts_series_key_t key, uint64_t from_ms, uint64_t to_ms)
+{
+    uint32_t count = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_query(key, from_ms, to_ms, 0, g_points, 4096, &count));
+    return count;
+}
+
+void test_open_rejects_bad_config(void)
+{
+    setUp();
+    ts_store_config_t config = g_config;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, ts_store_open(NULL));
+    config.segment_bytes = 16;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, ts_store_open(&config));
+    config = g_config;
+    config.max_bytes = config.segment_bytes * TS_STORE_MAX_SEGMENTS;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, ts_store_open(&config));
+
+    // Not open: writes and reads are refused
+    uint32_t count;
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, ts_store_append(reg_key(2, 0), T0_MS, 1.0f));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, ts_store_query(reg_key(2, 0), 0, T0_MS, 0, g_points, 1, &count));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_INITIALIZED, ts_store_open(&g_config));
+    ts_series_key_t bad = { 2, TS_SERIES_TELEMETRY, TS_TELEMETRY_FIELD_COUNT };
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, ts_store_append(bad, T0_MS, 1.0f));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_close());
+    tearDown();
+}
+
+void test_register_samples_round_trip(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+
+    // Jittery 100 ms polling with values that jump around, across several blocks
+    uint64_t t = T0_MS;
+    uint32_t x = 7;
+    static uint64_t times[1000];
+    static uint16_t values[1000];
+    for (int i = 0; i < 1000; i++) {
+        x = x * 1103515245U + 12345U;
+        t += 95U + (x >> 16) % 11U;
+        times[i] = t;
+        values[i] = (i % 100 == 0) ? (uint16_t)(x >> 8) : (uint16_t)(24000U + (unsigned)i % 7U);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0000, &values[i], 1, t));
+    }
+
+    // Read back before anything is written (open and pending blocks) and after
+    for (int pass = 0; pass < 2; pass++) {
+        TEST_ASSERT_EQUAL(1000, query_raw(reg_key(2, 0), T0_MS, t));
+        for (int i = 0; i < 1000; i++) {
+            TEST_ASSERT_EQUAL(times[i], g_points[i].timestamp_ms);
+            TEST_ASSERT_EQUAL_FLOAT((float)values[i], g_points[i].avg, 0.0f);
+            TEST_ASSERT_EQUAL(1, g_points[i].count);
+        }
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    }
+
+    // Sub-range and point cap
+    uint32_t count = query_raw(reg_key(2, 0), times[10], times[19]);
+    TEST_ASSERT_EQUAL(10, count);
+    TEST_ASSERT_EQUAL(times[10], g_points[0].timestamp_ms);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_query(reg_key(2, 0), T0_MS, t, 0, g_points, 5, &count));
+    TEST_ASSERT_EQUAL(5, count);
+    TEST_ASSERT_EQUAL(times[0], g_points[0].timestamp_ms);
+    TEST_ASSERT_EQUAL(0, query_raw(reg_key(2, 1), T0_MS, t));
+    tearDown();
+}
+
+void test_telemetry_floats_round_trip_exactly(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+
+    const float values[] = { 24.0f, 24.1f, 24.1f, 23.95f, -3.5f, 0.0f, 1e-7f, 65535.5f, 24.0f, 24.0f };
+    ts_series_key_t key = { 3, TS_SERIES_TELEMETRY, TS_TELEMETRY_VOLTAGE };
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append(key, T0_MS + (uint64_t)i * 1000U, values[i]));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+
+    TEST_ASSERT_EQUAL(10, query_raw(key, T0_MS, T0_MS + 10000U));
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(memcmp(&values[i], &g_points[i].avg, sizeof(float)) == 0);
+    }
+    TEST_ASSERT_EQUAL_STRING("voltage", ts_store_telemetry_field_name(TS_TELEMETRY_VOLTAGE));
+    tearDown();
+}
+
+void test_steady_polling_compresses_well(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+
+    // Eleven battery registers polled every 500 ms for an hour, slowly drifting
+    uint16_t regs[11];
+    for (int i = 0; i < 7200; i++) {
+        for (int r = 0; r < 11; r++) {
+            regs[r] = (uint16_t)(1000U * (unsigned)r + (unsigned)(i / 60));
+        }
+        uint64_t t = T0_MS + (uint64_t)i * 500U;
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0000, regs, 11, t));
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_maintain(t));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+
+    ts_store_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_get_stats(&stats));
+    TEST_ASSERT_EQUAL(7200U * 11U, stats.samples_appended);
+    TEST_ASSERT_EQUAL(0, stats.samples_dropped);
+    TEST_ASSERT_EQUAL(11, stats.series);
+    // Raw records are 8-byte timestamp + 2-byte value; expect better than 4 bytes a sample
+    printf(" [%.2f bytes/sample]", (double)stats.bytes_written / (double)stats.samples_appended);
+    TEST_ASSERT_LESS_THAN(4U * 7200U * 11U, stats.bytes_written);
+    TEST_ASSERT_EQUAL(stats.bytes_written, stats.disk_bytes);
+    tearDown();
+}
+
+void test_history_survives_reopen(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    for (uint16_t i = 0; i < 600; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(4, 0x0100, &i, 1, T0_MS + i * 1000U));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_close());
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    TEST_ASSERT_EQUAL(600, query_raw(reg_key(4, 0x0100), T0_MS, T0_MS + 600000U));
+    TEST_ASSERT_EQUAL_FLOAT(599.0f, g_points[599].avg, 0.0f);
+
+    // Appending after reopen continues the same series
+    uint16_t v = 600;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(4, 0x0100, &v, 1, T0_MS + 600000U));
+    TEST_ASSERT_EQUAL(601, query_raw(reg_key(4, 0x0100), T0_MS, T0_MS + 600000U));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_close());
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    TEST_ASSERT_EQUAL(601, query_raw(reg_key(4, 0x0100), T0_MS, T0_MS + 600000U));
+    tearDown();
+}
+
+void test_downsampling_min_max_avg(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+
+    // One sample a second, value = second of the minute; 10 minutes
+    for (uint16_t i = 0; i < 600; i++) {
+        uint16_t v = (uint16_t)(i % 60U);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(5, 0x0010, &v, 1, T0_MS + i * 1000U));
+    }
+
+    // Half in RAM, half on disk after the flush: both give the same buckets
+    for (int pass = 0; pass < 2; pass++) {
+        uint32_t count = 0;
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_query(reg_key(5, 0x0010), T0_MS, T0_MS + 599999U, 60000U,
+                                                        g_points, 100, &count));
+        TEST_ASSERT_EQUAL(10, count);
+        for (uint32_t b = 0; b < count; b++) {
+            TEST_ASSERT_EQUAL(T0_MS + b * 60000U, g_points[b].timestamp_ms);
+            TEST_ASSERT_EQUAL_FLOAT(0.0f, g_points[b].min, 0.0f);
+            TEST_ASSERT_EQUAL_FLOAT(59.0f, g_points[b].max, 0.0f);
+            TEST_ASSERT_EQUAL_FLOAT(29.5f, g_points[b].avg, 0.001f);
+            TEST_ASSERT_EQUAL(60, g_points[b].count);
+        }
+
+        // One bucket over everything is served from the block summaries
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_query(reg_key(5, 0x0010), T0_MS, T0_MS + 3600000U, 3600000U,
+                                                        g_points, 100, &count));
+        TEST_ASSERT_EQUAL(1, count);
+        TEST_ASSERT_EQUAL(600, g_points[0].count);
+        TEST_ASSERT_EQUAL_FLOAT(29.5f, g_points[0].avg, 0.001f);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    }
+    tearDown();
+}
+
+void test_retention_drops_whole_segments_over_budget(void)
+{
+    setUp();
+    g_config.segment_bytes = 4096;
+    g_config.max_bytes = 16384;
+    g_config.flush_interval_ms = 1000;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+
+    // Noisy values so blocks stay large; two hours at 1 Hz over 8 registers
+    uint32_t x = 99;
+    uint16_t regs[8];
+    uint64_t t = T0_MS;
+    for (int i = 0; i < 7200; i++) {
+        for (int r = 0; r < 8; r++) {
+            x = x * 1103515245U + 12345U;
+            regs[r] = (uint16_t)(x >> 16);
+        }
+        t = T0_MS + (uint64_t)i * 1000U;
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(3, 0x0000, regs, 8, t));
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_maintain(t));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_maintain(t + 2000U));
+
+    ts_store_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_get_stats(&stats));
+    TEST_ASSERT_GREATER_THAN(0, stats.segments_dropped);
+    TEST_ASSERT_GREATER_THAN(0, stats.blocks_dropped);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(g_config.max_bytes, stats.disk_bytes);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(g_config.max_bytes / g_config.segment_bytes + 1U, stats.segments);
+    TEST_ASSERT_EQUAL(0, stats.samples_dropped);
+
+    // The oldest data is gone, the newest is still there and in order
+    TEST_ASSERT_EQUAL(0, query_raw(reg_key(3, 0), T0_MS, T0_MS + 60000U));
+    uint32_t count = query_raw(reg_key(3, 0), T0_MS, t);
+    TEST_ASSERT_GREATER_THAN(0, count);
+    TEST_ASSERT_EQUAL(t, g_points[count - 1].timestamp_ms);
+    for (uint32_t i = 1; i < count; i++) {
+        TEST_ASSERT_EQUAL(g_points[i - 1].timestamp_ms + 1000U, g_points[i].timestamp_ms);
+    }
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(stats.oldest_ms, g_points[0].timestamp_ms);
+    tearDown();
+}
+
+void test_retention_drops_expired_segments(void)
+{
+    setUp();
+    g_config.segment_bytes = 1024;
+    g_config.max_bytes = 32768;
+    g_config.retention_hours = 1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+
+    // An old burst, then fresh data three hours later in later segments
+    uint32_t x = 5;
+    for (uint16_t i = 0; i < 200; i++) {
+        x = x * 1103515245U + 12345U;
+        uint16_t v = (uint16_t)(x >> 16);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0001, &v, 1, T0_MS + i * 1000U));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    uint64_t later = T0_MS + 3U * 3600000U;
+    for (uint16_t i = 0; i < 200; i++) {
+        x = x * 1103515245U + 12345U;
+        uint16_t v = (uint16_t)(x >> 16);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0001, &v, 1, later + i * 1000U));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    TEST_ASSERT_EQUAL(400, query_raw(reg_key(2, 1), T0_MS, later + 200000U));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_maintain(later + 200000U));
+    TEST_ASSERT_EQUAL(0, query_raw(reg_key(2, 1), T0_MS, later - 1U));
+    TEST_ASSERT_EQUAL(200, query_raw(reg_key(2, 1), later, later + 200000U));
+    tearDown();
+}
+
+void test_clock_step_back_keeps_both_runs(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    ts_series_key_t key = { 2, TS_SERIES_TELEMETRY, TS_TELEMETRY_TEMPERATURE };
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append(key, T0_MS + 10000U, 30.0f));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append(key, T0_MS + 11000U, 31.0f));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append(key, T0_MS + 5000U, 32.0f));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append(key, T0_MS + 6000U, 33.0f));
+
+    TEST_ASSERT_EQUAL(4, query_raw(key, T0_MS, T0_MS + 20000U));
+    TEST_ASSERT_EQUAL(T0_MS + 5000U, g_points[2].timestamp_ms);
+    TEST_ASSERT_EQUAL_FLOAT(33.0f, g_points[3].avg, 0.0f);
+
+    ts_store_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_get_stats(&stats));
+    TEST_ASSERT_EQUAL(1, stats.blocks_sealed);
+    tearDown();
+}
+
+void test_unindexed_tail_is_cut_on_reopen(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    for (uint16_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0002, &i, 1, T0_MS + i * 1000U));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_close());
+
+    // A write that never reached the index, as after a power cut
+    char path[192];
+    snprintf(path, sizeof(path), "%s/seg-00000000.tsd", g_config.directory);
+    int fd = open(path, O_WRONLY | O_APPEND);
+    TEST_ASSERT_TRUE(fd >= 0);
+    const char junk[37] = "not a block, never indexed ........";
+    TEST_ASSERT_EQUAL((ssize_t)sizeof(junk), write(fd, junk, sizeof(junk)));
+    close(fd);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    ts_store_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_get_stats(&stats));
+    TEST_ASSERT_EQUAL(1, stats.index_entries);
+    uint64_t before = stats.disk_bytes;
+
+    for (uint16_t i = 100; i < 110; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0002, &i, 1, T0_MS + i * 1000U));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    TEST_ASSERT_EQUAL(110, query_raw(reg_key(2, 2), T0_MS, T0_MS + 110000U));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_get_stats(&stats));
+    TEST_ASSERT_EQUAL(0, stats.corrupt_blocks);
+    TEST_ASSERT_GREATER_THAN(before, stats.disk_bytes);
+    tearDown();
+}
+
+void test_list_series_by_module(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_open(&g_config));
+    uint16_t regs[3] = { 1, 2, 3 };
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0100, regs, 3, T0_MS));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_flush());
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(2, 0x0005, regs, 1, T0_MS));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append_registers(3, 0x0000, regs, 1, T0_MS));
+    ts_series_key_t current = { 2, TS_SERIES_TELEMETRY, TS_TELEMETRY_CURRENT };
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_append(current, T0_MS, 1.5f));
+
+    ts_series_key_t keys[16];
+    uint32_t count = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_list_series(2, keys, 16, &count));
+    TEST_ASSERT_EQUAL(5, count);
+    TEST_ASSERT_EQUAL(0x0005, keys[0].id);
+    TEST_ASSERT_EQUAL(0x0100, keys[1].id);
+    TEST_ASSERT_EQUAL(0x0102, keys[3].id);
+    TEST_ASSERT_EQUAL(TS_SERIES_TELEMETRY, keys[4].kind);
+    TEST_ASSERT_EQUAL(TS_TELEMETRY_CURRENT, keys[4].id);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_list_series(2, keys, 2, &count));
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, ts_store_list_series(9, keys, 16, &count));
+    TEST_ASSERT_EQUAL(0, count);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== Timeseries Store Tests ===\n");
+
+    RUN_TEST(test_open_rejects_bad_config);
+    RUN_TEST(test_register_samples_round_trip);
+    RUN_TEST(test_telemetry_floats_round_trip_exactly);
+    RUN_TEST(test_steady_polling_compresses_well);
+    RUN_TEST(test_history_survives_reopen);
+    RUN_TEST(test_downsampling_min_max_avg);
+    RUN_TEST(test_retention_drops_whole_segments_over_budget);
+    RUN_TEST(test_retention_drops_expired_segments);
+    RUN_TEST(test_clock_step_back_keeps_both_runs);
+    RUN_TEST(test_unindexed_tail_is_cut_on_reopen);
+    RUN_TEST(test_list_series_by_module);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,351 @@
+/**
+ * @file test_hal_gpio_events.c
+ * @brief Event-driven GPIO input and E-Stop tests against a fake sysfs tree
+ *
+ * The value node of each fake pin is a FIFO; writing '0'/'1' to it plays the
+ * role of an edge, so wakeup latency and idle wakeups can be measured on any
+ * Linux host.
+ */
+
+#include "unity.h"
+#include "hal_gpio.h"
+#include "hal_estop.h"
+#include "hal_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define TEST_PIN            59
+#define TEST_EVENT_WAIT_MS  500
+#define TEST_MAX_LATENCY_US 20000
+
+static char fake_root[64];
+static int fifo_fd = -1;
+
+static pthread_mutex_t events_mutex = PTHREAD_MUTEX_INITIALIZER;
+static gpio_event_t events[16];
+static uint64_t event_seen_us[16];
+static int event_count;
+
+static int estop_triggered_events;
+static int estop_safe_events;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_gpio_watch_reports_edges_with_low_latency(void);
+void test_gpio_watch_idle_does_not_wake(void);
+void test_gpio_watch_filters_edges(void);
+void test_gpio_unwatch_stops_callbacks(void);
+void test_estop_triggers_from_edge_event(void);
+void test_gpio_watch_reports_released_pulse(void);
+void test_estop_latches_released_press(void);
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void write_file(const char *dir, const char *name, const char *content)
+{
+    char path[160];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *fp = fopen(path, "w");
+    if (fp != NULL) {
+        fputs(content, fp);
+        fclose(fp);
+    }
+}
+
+static void set_level(bool level)
+{
+    char c = level ? '1' : '0';
+    TEST_ASSERT_EQUAL(1, (int)write(fifo_fd, &c, 1));
+}
+
+// Low pulse that is over before the event thread reads the level
+static void released_low_pulse(void)
+{
+    TEST_ASSERT_EQUAL(2, (int)write(fifo_fd, "01", 2));
+}
+
+static void record_event(const gpio_event_t *event, void *user_data)
+{
+    (void)user_data;
+    pthread_mutex_lock(&events_mutex);
+    if (event_count < 16) {
+        events[event_count] = *event;
+        event_seen_us[event_count] = now_us();
+        event_count++;
+    }
+    pthread_mutex_unlock(&events_mutex);
+}
+
+static int wait_for_events(int expected)
+{
+    for (int waited = 0; waited < TEST_EVENT_WAIT_MS; waited++) {
+        pthread_mutex_lock(&events_mutex);
+        int count = event_count;
+        pthread_mutex_unlock(&events_mutex);
+        if (count >= expected) {
+            return count;
+        }
+        usleep(1000);
+    }
+    return event_count;
+}
+
+static void estop_test_callback(estop_state_t state, estop_fault_t fault)
+{
+    (void)fault;
+    if (state == ESTOP_STATE_TRIGGERED) {
+        estop_triggered_events++;
+    } else if (state == ESTOP_STATE_SAFE) {
+        estop_safe_events++;
+    }
+}
+
+void setUp(void)
+{
+    char pin_dir[128];
+
+    snprintf(fake_root, sizeof(fake_root), "/tmp/oht50_gpio_XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(fake_root));
+    snprintf(pin_dir, sizeof(pin_dir), "%s/gpio%d", fake_root, TEST_PIN);
+    mkdir(pin_dir, 0755);
+    write_file(fake_root, "export", "");
+    write_file(fake_root, "unexport", "");
+    write_file(pin_dir, "direction", "in");
+    write_file(pin_dir, "edge", "none");
+
+    char value_path[160];
+    snprintf(value_path, sizeof(value_path), "%s/value", pin_dir);
+    mkfifo(value_path, 0644);
+    fifo_fd = open(value_path, O_RDWR | O_NONBLOCK);
+
+    event_count = 0;
+    estop_triggered_events = 0;
+    estop_safe_events = 0;
+
+    hal_gpio_set_sysfs_root(fake_root);
+    hal_gpio_init();
+}
+
+void tearDown(void)
+{
+    char cmd[96];
+
+    hal_gpio_deinit();
+    hal_gpio_set_sysfs_root(NULL);
+    if (fifo_fd >= 0) {
+        close(fifo_fd);
+        fifo_fd = -1;
+    }
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", fake_root);
+    (void)system(cmd);
+}
+
+void test_gpio_watch_reports_edges_with_low_latency(void)
+{
+    setUp();
+    gpio_event_source_t source = GPIO_EVENT_SOURCE_SYSFS;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_BOTH, record_event, NULL));
+    TEST_ASSERT_TRUE(hal_gpio_is_watched(TEST_PIN, &source));
+    TEST_ASSERT_EQUAL(GPIO_EVENT_SOURCE_STREAM, source);
+
+    uint64_t written_us = now_us();
+    set_level(true);
+    TEST_ASSERT_EQUAL(1, wait_for_events(1));
+    TEST_ASSERT_TRUE(events[0].value);
+    TEST_ASSERT_EQUAL(GPIO_EDGE_RISING, events[0].edge);
+    TEST_ASSERT_EQUAL(TEST_PIN, events[0].pin_number);
+    TEST_ASSERT_LESS_THAN(TEST_MAX_LATENCY_US, (int)(event_seen_us[0] - written_us));
+    TEST_ASSERT_TRUE(events[0].timestamp_us >= written_us);
+
+    set_level(false);
+    TEST_ASSERT_EQUAL(2, wait_for_events(2));
+    TEST_ASSERT_FALSE(events[1].value);
+    TEST_ASSERT_EQUAL(GPIO_EDGE_FALLING, events[1].edge);
+
+    // Reads of a watched pin come from the open node, not a reopen
+    bool value = true;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_get_value(TEST_PIN, &value));
+    TEST_ASSERT_FALSE(value);
+    tearDown();
+}
+
+void test_gpio_watch_idle_does_not_wake(void)
+{
+    setUp();
+    gpio_statistics_t before;
+    gpio_statistics_t after;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_BOTH, record_event, NULL));
+    hal_gpio_get_statistics(&before);
+    usleep(200000);
+    hal_gpio_get_statistics(&after);
+
+    // A 1 ms poller would have woken ~200 times
+    TEST_ASSERT_EQUAL_UINT(before.wakeups, after.wakeups);
+    TEST_ASSERT_EQUAL(0, event_count);
+    tearDown();
+}
+
+void test_gpio_watch_filters_edges(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_FALLING, record_event, NULL));
+
+    // Space the writes so each one is seen as its own wakeup
+    set_level(true);
+    usleep(20000);
+    set_level(false);
+    usleep(20000);
+    set_level(false);   // No level change, no edge
+    TEST_ASSERT_EQUAL(1, wait_for_events(1));
+    usleep(20000);
+    TEST_ASSERT_EQUAL(1, event_count);
+    TEST_ASSERT_EQUAL(GPIO_EDGE_FALLING, events[0].edge);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_INITIALIZED,
+                      hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_BOTH, record_event, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER,
+                      hal_gpio_watch_pin(TEST_PIN + 1, GPIO_EDGE_NONE, record_event, NULL));
+    tearDown();
+}
+
+void test_gpio_unwatch_stops_callbacks(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_BOTH, record_event, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_unwatch_pin(TEST_PIN));
+    TEST_ASSERT_FALSE(hal_gpio_is_watched(TEST_PIN, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, hal_gpio_unwatch_pin(TEST_PIN));
+
+    set_level(true);
+    usleep(20000);
+    TEST_ASSERT_EQUAL(0, event_count);
+    tearDown();
+}
+
+void test_estop_triggers_from_edge_event(void)
+{
+    setUp();
+    estop_config_t config = {
+        .pin = TEST_PIN,
+        .response_timeout_ms = ESTOP_RESPONSE_TIME_MS,
+        .debounce_time_ms = ESTOP_DEBOUNCE_TIME_MS,
+        .auto_reset_enabled = true
+    };
+    bool triggered = true;
+
+    // Pin is high (safe) before the E-Stop starts watching it
+    set_level(true);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_estop_init(&config));
+    TEST_ASSERT_TRUE(hal_gpio_is_watched(TEST_PIN, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_estop_set_callback(estop_test_callback));
+    hal_estop_is_triggered(&triggered);
+    TEST_ASSERT_FALSE(triggered);
+
+    // Falling edge: triggered without anyone calling hal_estop_update()
+    uint64_t pressed_us = now_us();
+    set_level(false);
+    for (int waited = 0; waited < TEST_EVENT_WAIT_MS && estop_triggered_events == 0; waited++) {
+        usleep(1000);
+    }
+    uint64_t reaction_us = now_us() - pressed_us;
+    TEST_ASSERT_EQUAL(1, estop_triggered_events);
+    TEST_ASSERT_LESS_THAN(ESTOP_RESPONSE_TIME_MS * 1000, (int)reaction_us);
+    hal_estop_is_triggered(&triggered);
+    TEST_ASSERT_TRUE(triggered);
+
+    // Release auto-resets
+    set_level(true);
+    for (int waited = 0; waited < TEST_EVENT_WAIT_MS && estop_safe_events == 0; waited++) {
+        usleep(1000);
+    }
+    TEST_ASSERT_EQUAL(1, estop_safe_events);
+
+    hal_estop_deinit();
+    TEST_ASSERT_FALSE(hal_gpio_is_watched(TEST_PIN, NULL));
+    tearDown();
+}
+
+void test_gpio_watch_reports_released_pulse(void)
+{
+    setUp();
+    set_level(true);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_BOTH, record_event, NULL));
+
+    // One wakeup for both edges: the press is reported, value is the level now
+    released_low_pulse();
+    TEST_ASSERT_EQUAL(1, wait_for_events(1));
+    usleep(20000);
+    TEST_ASSERT_EQUAL(1, event_count);
+    TEST_ASSERT_EQUAL(GPIO_EDGE_FALLING, events[0].edge);
+    TEST_ASSERT_TRUE(events[0].value);
+
+    // A rising-only watch gets the release out of the same pulse
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_unwatch_pin(TEST_PIN));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_gpio_watch_pin(TEST_PIN, GPIO_EDGE_RISING, record_event, NULL));
+    released_low_pulse();
+    TEST_ASSERT_EQUAL(2, wait_for_events(2));
+    TEST_ASSERT_EQUAL(GPIO_EDGE_RISING, events[1].edge);
+    tearDown();
+}
+
+void test_estop_latches_released_press(void)
+{
+    setUp();
+    estop_config_t config = {
+        .pin = TEST_PIN,
+        .response_timeout_ms = ESTOP_RESPONSE_TIME_MS,
+        .debounce_time_ms = ESTOP_DEBOUNCE_TIME_MS,
+        .auto_reset_enabled = false
+    };
+    bool triggered = true;
+
+    set_level(true);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_estop_init(&config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_estop_set_callback(estop_test_callback));
+    hal_estop_is_triggered(&triggered);
+    TEST_ASSERT_FALSE(triggered);
+
+    // Pressed and released before the level is read: still latched
+    released_low_pulse();
+    for (int waited = 0; waited < TEST_EVENT_WAIT_MS && estop_triggered_events == 0; waited++) {
+        usleep(1000);
+    }
+    TEST_ASSERT_EQUAL(1, estop_triggered_events);
+    hal_estop_is_triggered(&triggered);
+    TEST_ASSERT_TRUE(triggered);
+
+    hal_estop_deinit();
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== GPIO EVENT TESTS (fake sysfs) ===\n");
+
+    RUN_TEST(test_gpio_watch_reports_edges_with_low_latency);
+    RUN_TEST(test_gpio_watch_idle_does_not_wake);
+    RUN_TEST(test_gpio_watch_filters_edges);
+    RUN_TEST(test_gpio_unwatch_stops_callbacks);
+    RUN_TEST(test_estop_triggers_from_edge_event);
+    RUN_TEST(test_gpio_watch_reports_released_pulse);
+    RUN_TEST(test_estop_latches_released_press);
+
+    UNITY_END();
+    return 0;
+}
@@ -46,10 +46,9 @@ void setUp(void)
     
     // Add some test points
     for (int i = 0; i < 10; i++) {
-        test_scan_data.points[i].distance_mm = 1000 + (i * 100);
-        test_scan_data.points[i].angle_deg = i * 36;
-        test_scan_data.points[i].quality = 200 + i;
-        test_scan_data.points[i].timestamp_us = i * 1000;
+        test_scan_data.distance_mm[i] = (uint16_t)(1000 + (i * 100));
+        test_scan_data.angle_q6[i] = (uint16_t)(i * 36 * 64);
+        test_scan_data.quality[i] = (uint8_t)(200 + i);
     }
     
     // Initialize test safety status
@@ -316,10 +315,9 @@ void test_lidar_calculate_min_distance(void)
     sd.point_count = 10;
     sd.scan_quality = 255;
     for (int i = 0; i < 10; i++) {
-        sd.points[i].distance_mm = 1000 + (i * 100);
-        sd.points[i].angle_deg = i * 36;
-        sd.points[i].quality = 200 + i;
-        sd.points[i].timestamp_us = i * 1000;
+        sd.distance_mm[i] = (uint16_t)(1000 + (i * 100));
+        sd.angle_q6[i] = (uint16_t)(i * 36 * 64);
+        sd.quality[i] = (uint8_t)(200 + i);
     }
     
     uint16_t min_distance = lidar_calculate_min_distance(&sd);
@@ -348,10 +346,9 @@ void test_lidar_calculate_max_distance(void)
     sd.point_count = 10;
     sd.scan_quality = 255;
     for (int i = 0; i < 10; i++) {
-        sd.points[i].distance_mm = 1000 + (i * 100);
-        sd.points[i].angle_deg = i * 36;
-        sd.points[i].quality = 200 + i;
-        sd.points[i].timestamp_us = i * 1000;
+        sd.distance_mm[i] = (uint16_t)(1000 + (i * 100));
+        sd.angle_q6[i] = (uint16_t)(i * 36 * 64);
+        sd.quality[i] = (uint8_t)(200 + i);
     }
     
     uint16_t max_distance = lidar_calculate_max_distance(&sd);
@@ -379,10 +376,9 @@ void test_lidar_is_obstacle_detected_true(void)
     sd.scan_complete = true;
     sd.point_count = 10;
     for (int i = 0; i < 10; i++) {
-        sd.points[i].distance_mm = 1000 + (i * 100);
-        sd.points[i].angle_deg = i * 36;
-        sd.points[i].quality = 200 + i;
-        sd.points[i].timestamp_us = i * 1000;
+        sd.distance_mm[i] = (uint16_t)(1000 + (i * 100));
+        sd.angle_q6[i] = (uint16_t)(i * 36 * 64);
+        sd.quality[i] = (uint8_t)(200 + i);
     }
     
     bool detected = lidar_is_obstacle_detected(&sd, 1500);
@@ -499,10 +495,9 @@ void test_lidar_data_structures(void)
     local_scan_data.point_count = 10;
     local_scan_data.scan_quality = 255;
     for (int i = 0; i < 10; i++) {
-        local_scan_data.points[i].distance_mm = 1000 + (i * 100);
-        local_scan_data.points[i].angle_deg = i * 36;
-        local_scan_data.points[i].quality = 200 + i;
-        local_scan_data.points[i].timestamp_us = i * 1000;
+        local_scan_data.distance_mm[i] = (uint16_t)(1000 + (i * 100));
+        local_scan_data.angle_q6[i] = (uint16_t)(i * 36 * 64);
+        local_scan_data.quality[i] = (uint8_t)(200 + i);
     }
     
     TEST_ASSERT_EQUAL(10, local_scan_data.point_count);
@@ -0,0 +1,328 @@
+/**
+ * @file test_hal_lidar_frame.c
+ * @brief Tests for zero-copy LiDAR frame publication
+ */
+
+#include "unity.h"
+#include "hal_lidar_frame.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_nothing_published_yet(void);
+void test_publish_and_acquire_latest(void);
+void test_held_view_is_never_rewritten(void);
+void test_writer_drops_when_every_slot_is_held(void);
+void test_wait_returns_newer_frame_or_times_out(void);
+void test_close_wakes_waiters(void);
+void test_concurrent_readers_never_see_torn_frames(void);
+
+static lidar_frame_publisher_t g_pub;
+
+static void fill_frame(lidar_scan_data_t *scan, uint16_t tag)
+{
+    scan->point_count = LIDAR_POINTS_PER_SCAN;
+    scan->scan_complete = true;
+    scan->scan_timestamp_us = tag;
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        scan->distance_mm[i] = tag;
+        scan->angle_q6[i] = tag;
+        scan->quality[i] = (uint8_t)tag;
+    }
+}
+
+static uint64_t publish_frame(uint16_t tag)
+{
+    lidar_scan_data_t *scan = lidar_frame_publisher_begin(&g_pub);
+    if (scan == NULL) {
+        return 0;
+    }
+    fill_frame(scan, tag);
+    return lidar_frame_publisher_publish(&g_pub, tag);
+}
+
+static bool frame_is_consistent(const lidar_scan_data_t *scan)
+{
+    uint16_t tag = (uint16_t)scan->scan_timestamp_us;
+    if (scan->point_count != LIDAR_POINTS_PER_SCAN) {
+        return false;
+    }
+    for (uint16_t i = 0; i < LIDAR_POINTS_PER_SCAN; i++) {
+        if (scan->distance_mm[i] != tag || scan->angle_q6[i] != tag) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void setUp(void)
+{
+    memset(&g_pub, 0, sizeof(g_pub));
+    lidar_frame_publisher_init(&g_pub);
+}
+
+void tearDown(void)
+{
+    lidar_frame_publisher_deinit(&g_pub);
+}
+
+void test_nothing_published_yet(void)
+{
+    setUp();
+    lidar_frame_view_t view;
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, lidar_frame_publisher_acquire(&g_pub, &view));
+    TEST_ASSERT_NULL(view.scan);
+    TEST_ASSERT_EQUAL(0, lidar_frame_publisher_sequence(&g_pub));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_frame_publisher_acquire(&g_pub, NULL));
+    TEST_ASSERT_EQUAL(0, lidar_frame_publisher_publish(&g_pub, 1));   // Nothing begun
+    tearDown();
+}
+
+void test_publish_and_acquire_latest(void)
+{
+    setUp();
+    lidar_frame_view_t view;
+    lidar_frame_stats_t stats;
+
+    TEST_ASSERT_EQUAL(1, publish_frame(100));
+    TEST_ASSERT_EQUAL(2, publish_frame(200));
+    TEST_ASSERT_EQUAL(2, lidar_frame_publisher_sequence(&g_pub));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_frame_publisher_acquire(&g_pub, &view));
+    TEST_ASSERT_NOT_NULL(view.scan);
+    TEST_ASSERT_EQUAL(2, view.sequence);
+    TEST_ASSERT_EQUAL(200, view.published_us);
+    TEST_ASSERT_EQUAL(200, view.scan->distance_mm[LIDAR_POINTS_PER_SCAN - 1]);
+
+    lidar_frame_publisher_get_stats(&g_pub, &stats);
+    TEST_ASSERT_EQUAL(1, stats.readers);
+    TEST_ASSERT_EQUAL(2, stats.published);
+    TEST_ASSERT_EQUAL(HAL_STATUS_BUSY, lidar_frame_publisher_deinit(&g_pub));
+
+    lidar_frame_publisher_release(&g_pub, &view);
+    TEST_ASSERT_NULL(view.scan);
+    lidar_frame_publisher_release(&g_pub, &view);                      // Second release is a no-op
+    lidar_frame_publisher_get_stats(&g_pub, &stats);
+    TEST_ASSERT_EQUAL(0, stats.readers);
+    tearDown();
+}
+
+void test_held_view_is_never_rewritten(void)
+{
+    setUp();
+    lidar_frame_view_t old_view;
+
+    publish_frame(1);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_frame_publisher_acquire(&g_pub, &old_view));
+
+    // Many newer frames cycle through the remaining slots
+    for (uint16_t tag = 2; tag < 50; tag++) {
+        TEST_ASSERT_GREATER_THAN(0, publish_frame(tag));
+    }
+    TEST_ASSERT_EQUAL(1, old_view.sequence);
+    TEST_ASSERT_EQUAL(1, old_view.scan->distance_mm[0]);
+    TEST_ASSERT_TRUE(frame_is_consistent(old_view.scan));
+
+    // The writer buffer is never the slot a reader holds or the latest one
+    lidar_scan_data_t *writer = lidar_frame_publisher_begin(&g_pub);
+    lidar_frame_view_t latest;
+    lidar_frame_publisher_acquire(&g_pub, &latest);
+    TEST_ASSERT_TRUE(writer != old_view.scan);
+    TEST_ASSERT_TRUE(writer != latest.scan);
+    TEST_ASSERT_TRUE(writer == lidar_frame_publisher_begin(&g_pub));  // Same buffer until published
+
+    lidar_frame_publisher_release(&g_pub, &latest);
+    lidar_frame_publisher_release(&g_pub, &old_view);
+    tearDown();
+}
+
+void test_writer_drops_when_every_slot_is_held(void)
+{
+    setUp();
+    lidar_frame_view_t views[LIDAR_FRAME_SLOTS];
+    lidar_frame_stats_t stats;
+
+    // Readers pin LIDAR_FRAME_SLOTS - 1 distinct frames; the last slot is the latest one
+    for (int i = 0; i < LIDAR_FRAME_SLOTS; i++) {
+        publish_frame((uint16_t)(10 + i));
+        lidar_frame_publisher_acquire(&g_pub, &views[i]);
+    }
+    TEST_ASSERT_NULL(lidar_frame_publisher_begin(&g_pub));
+    lidar_frame_publisher_get_stats(&g_pub, &stats);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+    TEST_ASSERT_EQUAL(LIDAR_FRAME_SLOTS, stats.max_readers);
+
+    // One release frees a slot again
+    lidar_frame_publisher_release(&g_pub, &views[0]);
+    TEST_ASSERT_EQUAL(LIDAR_FRAME_SLOTS + 1, publish_frame(99));
+    for (int i = 1; i < LIDAR_FRAME_SLOTS; i++) {
+        TEST_ASSERT_TRUE(frame_is_consistent(views[i].scan));
+        TEST_ASSERT_EQUAL(10 + i, views[i].scan->distance_mm[0]);
+        lidar_frame_publisher_release(&g_pub, &views[i]);
+    }
+    tearDown();
+}
+
+static void *delayed_publisher(void *arg)
+{
+    usleep(20000);
+    publish_frame((uint16_t)(uintptr_t)arg);
+    return NULL;
+}
+
+void test_wait_returns_newer_frame_or_times_out(void)
+{
+    setUp();
+    lidar_frame_view_t view;
+    lidar_frame_stats_t stats;
+    pthread_t thread;
+
+    publish_frame(5);
+
+    // A frame newer than 0 is already there
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_frame_publisher_wait(&g_pub, 0, 10, &view));
+    TEST_ASSERT_EQUAL(1, view.sequence);
+    lidar_frame_publisher_release(&g_pub, &view);
+
+    // Nothing newer than 1 arrives
+    TEST_ASSERT_EQUAL(HAL_STATUS_TIMEOUT, lidar_frame_publisher_wait(&g_pub, 1, 20, &view));
+    TEST_ASSERT_NULL(view.scan);
+
+    // Blocks until the writer publishes
+    pthread_create(&thread, NULL, delayed_publisher, (void *)(uintptr_t)6);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_frame_publisher_wait(&g_pub, 1, 1000, &view));
+    TEST_ASSERT_EQUAL(2, view.sequence);
+    TEST_ASSERT_EQUAL(6, view.scan->distance_mm[0]);
+    lidar_frame_publisher_release(&g_pub, &view);
+    pthread_join(thread, NULL);
+
+    lidar_frame_publisher_get_stats(&g_pub, &stats);
+    TEST_ASSERT_EQUAL(3, stats.waits);
+    TEST_ASSERT_EQUAL(1, stats.wait_timeouts);
+    tearDown();
+}
+
+static void *delayed_close(void *arg)
+{
+    (void)arg;
+    usleep(20000);
+    lidar_frame_publisher_close(&g_pub);
+    return NULL;
+}
+
+void test_close_wakes_waiters(void)
+{
+    setUp();
+    lidar_frame_view_t view;
+    pthread_t thread;
+
+    pthread_create(&thread, NULL, delayed_close, NULL);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, lidar_frame_publisher_wait(&g_pub, 0, 5000, &view));
+    pthread_join(thread, NULL);
+
+    // Reset reopens and forgets the latest frame
+    publish_frame(1);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_frame_publisher_reset(&g_pub));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, lidar_frame_publisher_acquire(&g_pub, &view));
+    TEST_ASSERT_EQUAL(2, publish_frame(2));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_frame_publisher_wait(&g_pub, 1, 10, &view));
+    lidar_frame_publisher_release(&g_pub, &view);
+    tearDown();
+}
+
+#define TORN_TEST_FRAMES    3000
+#define TORN_TEST_READERS   3
+
+static volatile bool g_writer_done;
+static int g_torn[TORN_TEST_READERS];
+static int g_seen[TORN_TEST_READERS];
+
+static void *torn_writer(void *arg)
+{
+    (void)arg;
+    for (int i = 1; i <= TORN_TEST_FRAMES; i++) {
+        publish_frame((uint16_t)i);
+        usleep(20);     // Let readers overlap with every publication
+    }
+    g_writer_done = true;
+    return NULL;
+}
+
+static void *torn_reader(void *arg)
+{
+    int id = (int)(uintptr_t)arg;
+    uint64_t last = 0;
+    while (!g_writer_done) {
+        lidar_frame_view_t view;
+        hal_status_t status = (id == 0) ? lidar_frame_publisher_wait(&g_pub, last, 100, &view)
+                                        : lidar_frame_publisher_acquire(&g_pub, &view);
+        if (status != HAL_STATUS_OK) {
+            continue;
+        }
+        if (!frame_is_consistent(view.scan) || view.sequence < last) {
+            g_torn[id]++;
+        }
+        if (view.sequence != last) {
+            g_seen[id]++;
+        }
+        last = view.sequence;
+        lidar_frame_publisher_release(&g_pub, &view);
+    }
+    return NULL;
+}
+
+void test_concurrent_readers_never_see_torn_frames(void)
+{
+    setUp();
+    pthread_t writer;
+    pthread_t readers[TORN_TEST_READERS];
+    lidar_frame_stats_t stats;
+
+    g_writer_done = false;
+    for (int i = 0; i < TORN_TEST_READERS; i++) {
+        g_torn[i] = 0;
+        g_seen[i] = 0;
+        pthread_create(&readers[i], NULL, torn_reader, (void *)(uintptr_t)i);
+    }
+    pthread_create(&writer, NULL, torn_writer, NULL);
+    pthread_join(writer, NULL);
+    for (int i = 0; i < TORN_TEST_READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    lidar_frame_publisher_get_stats(&g_pub, &stats);
+    printf("Published %llu, dropped %llu, reader frames %d/%d/%d\n",
+           (unsigned long long)stats.published, (unsigned long long)stats.dropped,
+           g_seen[0], g_seen[1], g_seen[2]);
+    for (int i = 0; i < TORN_TEST_READERS; i++) {
+        TEST_ASSERT_EQUAL(0, g_torn[i]);
+        TEST_ASSERT_GREATER_THAN(10, g_seen[i]);
+    }
+    TEST_ASSERT_EQUAL(TORN_TEST_FRAMES, stats.published + stats.dropped);
+    TEST_ASSERT_EQUAL(0, stats.readers);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== LIDAR FRAME PUBLISHER TESTS ===\n");
+
+    RUN_TEST(test_nothing_published_yet);
+    RUN_TEST(test_publish_and_acquire_latest);
+    RUN_TEST(test_held_view_is_never_rewritten);
+    RUN_TEST(test_writer_drops_when_every_slot_is_held);
+    RUN_TEST(test_wait_returns_newer_frame_or_times_out);
+    RUN_TEST(test_close_wakes_waiters);
+    RUN_TEST(test_concurrent_readers_never_see_torn_frames);
+
+    UNITY_END();
+    return 0;
+}
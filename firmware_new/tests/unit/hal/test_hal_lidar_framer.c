@@ -0,0 +1,302 @@
+/**
+ * @file test_hal_lidar_framer.c
+ * @brief Tests for the streaming RPLIDAR standard-scan framer
+ */
+
+#include "unity.h"
+#include "hal_lidar_framer.h"
+#include <stdio.h>
+#include <string.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_decodes_nodes_after_descriptor(void);
+void test_reads_split_at_any_offset_give_same_frames(void);
+void test_locks_on_stream_without_descriptor(void);
+void test_bad_check_bit_resyncs_and_drops_gappy_revolution(void);
+void test_point_timestamps_interpolated_across_read(void);
+void test_invalid_and_overflow_points_are_counted(void);
+void test_revolution_dropped_without_buffer(void);
+
+#define TEST_STREAM_MAX     (8 + 6 * 600 * LIDAR_FRAMER_NODE_SIZE)
+#define TEST_MAX_REVS       8
+
+static const uint8_t g_descriptor[] = { 0xA5, 0x5A, 0x05, 0x00, 0x00, 0x40, 0x81 };
+
+static lidar_framer_t g_framer;
+static lidar_scan_data_t g_buffers[2];
+static int g_next_buffer;
+static bool g_give_buffers;
+
+// Summary of every revolution handed to the callback
+static int g_rev_count;
+static uint16_t g_rev_points[TEST_MAX_REVS];
+static uint16_t g_rev_first_distance[TEST_MAX_REVS];
+static uint16_t g_rev_last_angle[TEST_MAX_REVS];
+static uint8_t g_rev_quality[TEST_MAX_REVS];
+
+static uint8_t g_stream[TEST_STREAM_MAX];
+static size_t g_stream_len;
+
+static lidar_scan_data_t *on_revolution(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    if (scan && g_rev_count < TEST_MAX_REVS) {
+        TEST_ASSERT_TRUE(scan->scan_complete);
+        g_rev_points[g_rev_count] = scan->point_count;
+        g_rev_first_distance[g_rev_count] = scan->distance_mm[0];
+        g_rev_last_angle[g_rev_count] = lidar_angle_q6_to_deg(scan->angle_q6[scan->point_count - 1]);
+        g_rev_quality[g_rev_count] = scan->scan_quality;
+        g_rev_count++;
+    }
+    if (!g_give_buffers) {
+        return NULL;
+    }
+    g_next_buffer ^= 1;
+    return &g_buffers[g_next_buffer];
+}
+
+static void emit(const uint8_t *bytes, size_t len)
+{
+    TEST_ASSERT_TRUE(g_stream_len + len <= sizeof(g_stream));
+    memcpy(&g_stream[g_stream_len], bytes, len);
+    g_stream_len += len;
+}
+
+static void emit_node(bool start, uint8_t quality, uint32_t angle_q6, uint16_t distance_mm)
+{
+    uint32_t distance_q2 = (uint32_t)distance_mm * 4U;
+    uint8_t node[LIDAR_FRAMER_NODE_SIZE] = {
+        (uint8_t)((quality << 2) | (start ? 0x01 : 0x02)),
+        (uint8_t)(((angle_q6 & 0x7FU) << 1) | 0x01U),
+        (uint8_t)(angle_q6 >> 7),
+        (uint8_t)(distance_q2 & 0xFFU),
+        (uint8_t)(distance_q2 >> 8)
+    };
+    emit(node, sizeof(node));
+}
+
+/**
+ * @brief One revolution; revolution r has distances 1000 + r, angles 0..359.x
+ */
+static void emit_revolution(int r, uint16_t nodes)
+{
+    for (uint16_t i = 0; i < nodes; i++) {
+        uint32_t angle_q6 = (uint32_t)i * 360U * 64U / nodes;
+        emit_node(i == 0, (uint8_t)(10 + r), angle_q6, (uint16_t)(1000 + r));
+    }
+}
+
+void setUp(void)
+{
+    memset(g_buffers, 0, sizeof(g_buffers));
+    g_next_buffer = 0;
+    g_give_buffers = true;
+    g_rev_count = 0;
+    g_stream_len = 0;
+    lidar_framer_init(&g_framer, 200, on_revolution, NULL, &g_buffers[0]);
+}
+
+void tearDown(void)
+{
+}
+
+void test_decodes_nodes_after_descriptor(void)
+{
+    setUp();
+    lidar_framer_stats_t stats;
+
+    emit(g_descriptor, sizeof(g_descriptor));
+    for (int r = 0; r < 3; r++) {
+        emit_revolution(r, 400);
+    }
+
+    // The third revolution completes only when the next start node arrives
+    TEST_ASSERT_EQUAL(2, lidar_framer_feed(&g_framer, g_stream, g_stream_len, 1000000));
+    TEST_ASSERT_EQUAL(2, g_rev_count);
+    TEST_ASSERT_EQUAL(400, g_rev_points[0]);
+    TEST_ASSERT_EQUAL(1000, g_rev_first_distance[0]);
+    TEST_ASSERT_EQUAL(1001, g_rev_first_distance[1]);
+    TEST_ASSERT_EQUAL(359, g_rev_last_angle[0]);   // 359.1 deg
+    TEST_ASSERT_EQUAL(11, g_rev_quality[1]);
+
+    lidar_framer_get_stats(&g_framer, &stats);
+    TEST_ASSERT_EQUAL(1, stats.descriptors);
+    TEST_ASSERT_EQUAL(1200, stats.nodes);
+    TEST_ASSERT_EQUAL(0, stats.discarded_bytes);
+    TEST_ASSERT_EQUAL(0, stats.resyncs);
+    tearDown();
+}
+
+void test_reads_split_at_any_offset_give_same_frames(void)
+{
+    setUp();
+    emit(g_descriptor, sizeof(g_descriptor));
+    for (int r = 0; r < 4; r++) {
+        emit_revolution(r, 360);
+    }
+
+    for (size_t chunk = 1; chunk <= 13; chunk++) {
+        lidar_framer_init(&g_framer, 200, on_revolution, NULL, &g_buffers[0]);
+        g_rev_count = 0;
+        size_t completed = 0;
+        for (size_t pos = 0; pos < g_stream_len; pos += chunk) {
+            size_t n = (g_stream_len - pos < chunk) ? g_stream_len - pos : chunk;
+            completed += lidar_framer_feed(&g_framer, &g_stream[pos], n, 1000000 + pos);
+        }
+        TEST_ASSERT_EQUAL(3, completed);
+        for (int r = 0; r < 3; r++) {
+            TEST_ASSERT_EQUAL(360, g_rev_points[r]);
+            TEST_ASSERT_EQUAL(1000 + r, g_rev_first_distance[r]);
+        }
+    }
+    tearDown();
+}
+
+void test_locks_on_stream_without_descriptor(void)
+{
+    setUp();
+    lidar_framer_stats_t stats;
+    const uint8_t garbage[] = { 0x00, 0xFF, 0x13 };
+
+    // Joined mid-revolution, after some line noise
+    emit(garbage, sizeof(garbage));
+    for (uint16_t i = 200; i < 400; i++) {
+        emit_node(false, 20, (uint32_t)i * 360U * 64U / 400U, 2500);
+    }
+    emit_revolution(1, 400);
+    emit_revolution(2, 400);
+
+    TEST_ASSERT_EQUAL(1, lidar_framer_feed(&g_framer, g_stream, g_stream_len, 1000000));
+    TEST_ASSERT_EQUAL(1, g_rev_count);               // The partial first revolution is not delivered
+    TEST_ASSERT_EQUAL(400, g_rev_points[0]);
+    TEST_ASSERT_EQUAL(1001, g_rev_first_distance[0]);
+
+    lidar_framer_get_stats(&g_framer, &stats);
+    TEST_ASSERT_EQUAL(0, stats.descriptors);
+    TEST_ASSERT_EQUAL(sizeof(garbage), stats.discarded_bytes);
+    tearDown();
+}
+
+void test_bad_check_bit_resyncs_and_drops_gappy_revolution(void)
+{
+    setUp();
+    lidar_framer_stats_t stats;
+
+    emit(g_descriptor, sizeof(g_descriptor));
+    emit_revolution(0, 400);
+    size_t corrupt_at = g_stream_len + 100 * LIDAR_FRAMER_NODE_SIZE + 1;
+    emit_revolution(1, 400);
+    emit_revolution(2, 400);
+    emit_revolution(3, 400);
+    g_stream[corrupt_at] &= (uint8_t)~0x01U;         // Clear C of one node in revolution 1
+
+    lidar_framer_feed(&g_framer, g_stream, g_stream_len, 1000000);
+    lidar_framer_get_stats(&g_framer, &stats);
+    TEST_ASSERT_EQUAL(1, stats.resyncs);
+    TEST_ASSERT_GREATER_THAN(0, stats.discarded_bytes);
+
+    // Revolution 1 had a gap: 0 and 2 are delivered, 1 is not
+    TEST_ASSERT_EQUAL(2, g_rev_count);
+    TEST_ASSERT_EQUAL(1000, g_rev_first_distance[0]);
+    TEST_ASSERT_EQUAL(1002, g_rev_first_distance[1]);
+    TEST_ASSERT_EQUAL(400, g_rev_points[1]);
+    tearDown();
+}
+
+void test_point_timestamps_interpolated_across_read(void)
+{
+    setUp();
+    lidar_scan_data_t *scan = &g_buffers[0];
+
+    emit(g_descriptor, sizeof(g_descriptor));
+    for (uint16_t i = 0; i < 10; i++) {
+        emit_node(i == 0, 30, (uint32_t)i * 64U, 800);
+    }
+    // Half of an 11th node stays in the ring for the next read
+    emit_node(false, 30, 640, 800);
+    g_stream_len -= 3;
+
+    lidar_framer_feed(&g_framer, g_stream, g_stream_len, 5000000);
+    TEST_ASSERT_EQUAL(10, scan->point_count);
+    TEST_ASSERT_EQUAL(5000000 - 9 * 200, scan->base_timestamp_us);
+    TEST_ASSERT_EQUAL(200, scan->point_period_us);
+    TEST_ASSERT_EQUAL(5000000 - 5 * 200, lidar_point_timestamp_us(scan, 4));
+
+    // The carried-over node completes on the next read and takes its time
+    const uint8_t rest[] = { g_stream[g_stream_len], g_stream[g_stream_len + 1], g_stream[g_stream_len + 2] };
+    lidar_framer_feed(&g_framer, rest, sizeof(rest), 5000400);
+    TEST_ASSERT_EQUAL(11, scan->point_count);
+    TEST_ASSERT_EQUAL(640, scan->angle_q6[10]);
+    TEST_ASSERT_EQUAL(10, lidar_angle_q6_to_deg(scan->angle_q6[10]));
+    TEST_ASSERT_EQUAL(800, scan->distance_mm[10]);
+    TEST_ASSERT_EQUAL(30, scan->quality[10]);
+
+    // Finishing the revolution spreads the read gap over the point spacing
+    g_stream_len = 0;
+    emit_node(true, 30, 0, 800);
+    lidar_framer_feed(&g_framer, g_stream, g_stream_len, 5000600);
+    TEST_ASSERT_EQUAL(1, g_rev_count);
+    TEST_ASSERT_EQUAL(5000400, scan->scan_timestamp_us);
+    TEST_ASSERT_EQUAL(4998200, scan->base_timestamp_us);
+    TEST_ASSERT_EQUAL(220, scan->point_period_us);
+    tearDown();
+}
+
+void test_invalid_and_overflow_points_are_counted(void)
+{
+    setUp();
+    lidar_framer_stats_t stats;
+
+    emit(g_descriptor, sizeof(g_descriptor));
+    emit_node(true, 10, 0, 0);                       // No return
+    for (uint16_t i = 1; i < LIDAR_POINTS_PER_SCAN + 20; i++) {
+        emit_node(false, 10, (uint32_t)i * 32U, 1500);
+    }
+    emit_node(true, 10, 0, 1500);
+
+    TEST_ASSERT_EQUAL(1, lidar_framer_feed(&g_framer, g_stream, g_stream_len, 1000000));
+    TEST_ASSERT_EQUAL(LIDAR_POINTS_PER_SCAN, g_rev_points[0]);
+    lidar_framer_get_stats(&g_framer, &stats);
+    TEST_ASSERT_EQUAL(1, stats.invalid_points);
+    TEST_ASSERT_EQUAL(19, stats.overflow_points);
+    tearDown();
+}
+
+void test_revolution_dropped_without_buffer(void)
+{
+    setUp();
+    lidar_framer_stats_t stats;
+
+    g_give_buffers = false;
+    emit(g_descriptor, sizeof(g_descriptor));
+    for (int r = 0; r < 4; r++) {
+        emit_revolution(r, 100);
+    }
+
+    lidar_framer_feed(&g_framer, g_stream, g_stream_len, 1000000);
+    lidar_framer_get_stats(&g_framer, &stats);
+    TEST_ASSERT_EQUAL(1, stats.revolutions);         // The initial buffer
+    TEST_ASSERT_EQUAL(2, stats.dropped_revolutions);
+    TEST_ASSERT_EQUAL(1, g_rev_count);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== LIDAR FRAMER TESTS ===\n");
+
+    RUN_TEST(test_decodes_nodes_after_descriptor);
+    RUN_TEST(test_reads_split_at_any_offset_give_same_frames);
+    RUN_TEST(test_locks_on_stream_without_descriptor);
+    RUN_TEST(test_bad_check_bit_resyncs_and_drops_gappy_revolution);
+    RUN_TEST(test_point_timestamps_interpolated_across_read);
+    RUN_TEST(test_invalid_and_overflow_points_are_counted);
+    RUN_TEST(test_revolution_dropped_without_buffer);
+
+    UNITY_END();
+    return 0;
+}
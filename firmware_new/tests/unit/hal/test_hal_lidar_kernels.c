@@ -0,0 +1,268 @@
+/**
+ * @file test_hal_lidar_kernels.c
+ * @brief Tests for the vectorised LiDAR scan kernels
+ */
+
+#include "unity.h"
+#include "hal_lidar_kernels.h"
+#include "hal_lidar.h"
+#include <stdio.h>
+#include <string.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_self_test_and_selection(void);
+void test_extremes_skip_points_without_return(void);
+void test_extremes_empty_and_all_zero_frames(void);
+void test_sector_min_plain_wrapped_and_empty(void);
+void test_below_mask_marks_close_returns(void);
+void test_every_impl_matches_scalar_on_random_frames(void);
+void test_scan_helpers_use_kernels(void);
+
+static uint16_t g_distance[LIDAR_POINTS_PER_SCAN];
+static uint16_t g_angle[LIDAR_POINTS_PER_SCAN];
+
+static lidar_kernel_impl_t g_default_impl;
+
+void setUp(void)
+{
+    memset(g_distance, 0, sizeof(g_distance));
+    memset(g_angle, 0, sizeof(g_angle));
+}
+
+void tearDown(void)
+{
+    lidar_kernel_select(g_default_impl);
+}
+
+/**
+ * @brief One point per 0.72 degrees, distances 1000 + i
+ */
+static void fill_ramp(uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        g_distance[i] = (uint16_t)(1000 + i);
+        g_angle[i] = (uint16_t)((uint32_t)i * LIDAR_ANGLE_Q6_FULL_TURN / count);
+    }
+}
+
+void test_self_test_and_selection(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_kernel_self_test());
+    TEST_ASSERT_TRUE(lidar_kernel_impl_available(LIDAR_KERNEL_IMPL_SCALAR));
+    TEST_ASSERT_TRUE(lidar_kernel_impl_available(g_default_impl));
+#if defined(__x86_64__)
+    TEST_ASSERT_TRUE(lidar_kernel_impl_available(LIDAR_KERNEL_IMPL_SSE2));
+    TEST_ASSERT_TRUE(g_default_impl != LIDAR_KERNEL_IMPL_SCALAR);
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_SUPPORTED, lidar_kernel_select(LIDAR_KERNEL_IMPL_NEON));
+#endif
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_SUPPORTED, lidar_kernel_select(LIDAR_KERNEL_IMPL_COUNT));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_kernel_select(LIDAR_KERNEL_IMPL_SCALAR));
+    TEST_ASSERT_EQUAL(LIDAR_KERNEL_IMPL_SCALAR, lidar_kernel_active_impl());
+    TEST_ASSERT_EQUAL_STRING("scalar", lidar_kernel_impl_name(LIDAR_KERNEL_IMPL_SCALAR));
+    printf("  default kernels: %s\n", lidar_kernel_impl_name(g_default_impl));
+    tearDown();
+}
+
+void test_extremes_skip_points_without_return(void)
+{
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        if (lidar_kernel_select((lidar_kernel_impl_t)impl) != HAL_STATUS_OK) {
+            continue;
+        }
+        setUp();
+        lidar_kernel_extremes_t e;
+        fill_ramp(500);
+        g_distance[3] = 0;                          // No return, must not be the minimum
+        g_distance[0] = 0;
+        g_distance[137] = 120;
+        g_distance[401] = 120;                      // Tie: the first index wins
+        g_distance[499] = 9000;
+        g_distance[250] = 9000;
+
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_kernel_extremes(g_distance, 500, &e));
+        TEST_ASSERT_EQUAL(120, e.min_mm);
+        TEST_ASSERT_EQUAL(137, e.min_index);
+        TEST_ASSERT_EQUAL(9000, e.max_mm);
+        TEST_ASSERT_EQUAL(250, e.max_index);
+        TEST_ASSERT_EQUAL(498, e.valid);
+
+        // Minimum in the scalar tail after the last full vector
+        g_distance[498] = 7;
+        lidar_kernel_extremes(g_distance, 499, &e);
+        TEST_ASSERT_EQUAL(7, e.min_mm);
+        TEST_ASSERT_EQUAL(498, e.min_index);
+        tearDown();
+    }
+}
+
+void test_extremes_empty_and_all_zero_frames(void)
+{
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        if (lidar_kernel_select((lidar_kernel_impl_t)impl) != HAL_STATUS_OK) {
+            continue;
+        }
+        setUp();
+        lidar_kernel_extremes_t e;
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_kernel_extremes(g_distance, 0, &e));
+        TEST_ASSERT_EQUAL(UINT16_MAX, e.min_mm);
+        TEST_ASSERT_EQUAL(0, e.max_mm);
+        TEST_ASSERT_EQUAL(0, e.valid);
+
+        lidar_kernel_extremes(g_distance, 100, &e);  // All zero
+        TEST_ASSERT_EQUAL(UINT16_MAX, e.min_mm);
+        TEST_ASSERT_EQUAL(0, e.min_index);
+        TEST_ASSERT_EQUAL(0, e.max_mm);
+        TEST_ASSERT_EQUAL(0, e.valid);
+
+        TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_kernel_extremes(NULL, 10, &e));
+        TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_kernel_extremes(g_distance, 10, NULL));
+        tearDown();
+    }
+}
+
+void test_sector_min_plain_wrapped_and_empty(void)
+{
+    static const lidar_kernel_sector_t sectors[] = {
+        { 0, 90 * 64 },                             // Front-right quadrant
+        { 315 * 64, 45 * 64 },                      // Front, wraps through 0
+        { 100 * 64, 100 * 64 },                     // Empty
+        { 180 * 64, LIDAR_ANGLE_Q6_FULL_TURN }      // Rear half
+    };
+    uint16_t min_mm[4];
+
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        if (lidar_kernel_select((lidar_kernel_impl_t)impl) != HAL_STATUS_OK) {
+            continue;
+        }
+        setUp();
+        fill_ramp(500);
+        g_distance[10] = 0;                         // 7.2 deg, no return
+        g_distance[20] = 300;                       // 14.4 deg
+        g_distance[480] = 250;                      // 345.6 deg
+        g_distance[300] = 200;                      // 216 deg
+
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_kernel_sector_min(g_distance, g_angle, 500, sectors, 4, min_mm));
+        TEST_ASSERT_EQUAL(300, min_mm[0]);
+        TEST_ASSERT_EQUAL(250, min_mm[1]);
+        TEST_ASSERT_EQUAL(UINT16_MAX, min_mm[2]);
+        TEST_ASSERT_EQUAL(200, min_mm[3]);
+        tearDown();
+    }
+}
+
+void test_below_mask_marks_close_returns(void)
+{
+    uint8_t mask[LIDAR_POINTS_PER_SCAN];
+
+    for (int impl = 0; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+        if (lidar_kernel_select((lidar_kernel_impl_t)impl) != HAL_STATUS_OK) {
+            continue;
+        }
+        setUp();
+        fill_ramp(500);
+        g_distance[0] = 0;
+        g_distance[17] = 499;
+        g_distance[18] = 500;                       // Threshold is exclusive
+        g_distance[496] = 1;
+
+        memset(mask, 0xAA, sizeof(mask));
+        TEST_ASSERT_EQUAL(2, lidar_kernel_below_mask(g_distance, 500, 500, mask));
+        for (uint16_t i = 0; i < 500; i++) {
+            TEST_ASSERT_EQUAL((i == 17 || i == 496) ? 1 : 0, mask[i]);
+        }
+        TEST_ASSERT_EQUAL(2, lidar_kernel_below_mask(g_distance, 500, 500, NULL));
+        TEST_ASSERT_EQUAL(0, lidar_kernel_below_mask(g_distance, 500, 0, mask));
+        TEST_ASSERT_EQUAL(499, lidar_kernel_below_mask(g_distance, 500, UINT16_MAX, mask));
+        tearDown();
+    }
+}
+
+void test_every_impl_matches_scalar_on_random_frames(void)
+{
+    static const lidar_kernel_sector_t sectors[] = { { 0, 5760 }, { 17280, 1000 }, { 4000, 4100 } };
+    uint32_t x = 12345U;
+
+    for (uint16_t n = 1; n <= LIDAR_POINTS_PER_SCAN; n = (uint16_t)(n + 7U)) {
+        setUp();
+        for (uint16_t i = 0; i < n; i++) {
+            x = x * 1103515245U + 12345U;
+            g_distance[i] = (x >> 16) % 9U == 0 ? 0 : (uint16_t)((x >> 8) % 12000U);
+            g_angle[i] = (uint16_t)((x >> 3) % LIDAR_ANGLE_Q6_FULL_TURN);
+        }
+
+        lidar_kernel_select(LIDAR_KERNEL_IMPL_SCALAR);
+        lidar_kernel_extremes_t ref;
+        uint16_t ref_min[3];
+        lidar_kernel_extremes(g_distance, n, &ref);
+        lidar_kernel_sector_min(g_distance, g_angle, n, sectors, 3, ref_min);
+        uint16_t ref_below = lidar_kernel_below_mask(g_distance, n, 1500, NULL);
+
+        for (int impl = 1; impl < LIDAR_KERNEL_IMPL_COUNT; impl++) {
+            if (lidar_kernel_select((lidar_kernel_impl_t)impl) != HAL_STATUS_OK) {
+                continue;
+            }
+            lidar_kernel_extremes_t got;
+            uint16_t got_min[3];
+            lidar_kernel_extremes(g_distance, n, &got);
+            lidar_kernel_sector_min(g_distance, g_angle, n, sectors, 3, got_min);
+            TEST_ASSERT_EQUAL(0, memcmp(&ref, &got, sizeof(ref)));
+            TEST_ASSERT_EQUAL(0, memcmp(ref_min, got_min, sizeof(ref_min)));
+            TEST_ASSERT_EQUAL(ref_below, lidar_kernel_below_mask(g_distance, n, 1500, NULL));
+        }
+        tearDown();
+    }
+}
+
+void test_scan_helpers_use_kernels(void)
+{
+    setUp();
+    static lidar_scan_data_t scan;
+    memset(&scan, 0, sizeof(scan));
+    scan.point_count = 4;
+    scan.scan_complete = true;
+    scan.base_timestamp_us = 1000;
+    scan.point_period_us = 200;
+    const uint16_t d[] = { 0, 2500, 800, 14000 };
+    const uint16_t a[] = { 0, 5760, 11520, 23039 };
+    for (uint16_t i = 0; i < 4; i++) {
+        scan.distance_mm[i] = d[i];
+        scan.angle_q6[i] = a[i];
+        scan.quality[i] = 40;
+    }
+
+    TEST_ASSERT_EQUAL(800, lidar_calculate_min_distance(&scan));
+    TEST_ASSERT_EQUAL(14000, lidar_calculate_max_distance(&scan));
+    TEST_ASSERT_TRUE(lidar_is_obstacle_detected(&scan, 1000));
+
+    lidar_point_t p = lidar_scan_get_point(&scan, 3);
+    TEST_ASSERT_EQUAL(0, p.angle_deg);              // 359.98 deg rounds to 0
+    TEST_ASSERT_EQUAL(1600, p.timestamp_us);
+    TEST_ASSERT_EQUAL(90, lidar_angle_q6_to_deg(scan.angle_q6[1]));
+
+    // Three arrays instead of padded records
+    TEST_ASSERT_LESS_THAN(LIDAR_POINTS_PER_SCAN * sizeof(lidar_point_t) / 2, sizeof(lidar_scan_data_t));
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== LIDAR KERNEL TESTS ===\n");
+
+    g_default_impl = lidar_kernel_active_impl();
+
+    RUN_TEST(test_self_test_and_selection);
+    RUN_TEST(test_extremes_skip_points_without_return);
+    RUN_TEST(test_extremes_empty_and_all_zero_frames);
+    RUN_TEST(test_sector_min_plain_wrapped_and_empty);
+    RUN_TEST(test_below_mask_marks_close_returns);
+    RUN_TEST(test_every_impl_matches_scalar_on_random_frames);
+    RUN_TEST(test_scan_helpers_use_kernels);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file test_hal_lidar_pipeline.c
+ * @brief Tests for the staged LiDAR worker pipeline
+ */
+
+#include "unity.h"
+#include "hal_lidar_pipeline.h"
+#include "hal_lidar.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_start_rejects_bad_config(void);
+void test_stages_run_in_order_for_every_worker_count(void);
+void test_filter_output_reaches_later_stages(void);
+void test_acquire_starves_when_all_frames_in_flight(void);
+void test_flush_times_out_while_a_stage_blocks(void);
+void test_stats_record_stage_time_and_decision_latency(void);
+void test_restart_resets_frames_and_stats(void);
+void test_safety_stage_runs_on_its_own_worker(void);
+
+#define TEST_FRAMES     64
+
+static lidar_pipeline_t g_pipeline;
+
+// Per-stage trace, written only by the worker that owns the stage
+static uint32_t g_seen[LIDAR_STAGE_COUNT][TEST_FRAMES];
+static uint32_t g_seen_count[LIDAR_STAGE_COUNT];
+static pthread_t g_stage_thread[LIDAR_STAGE_COUNT];
+
+// Set to hold the safety stage until released
+static volatile int g_block_safety;
+
+void setUp(void)
+{
+    memset(g_seen, 0, sizeof(g_seen));
+    memset(g_seen_count, 0, sizeof(g_seen_count));
+    g_block_safety = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_init(&g_pipeline));
+}
+
+void tearDown(void)
+{
+    g_block_safety = 0;
+    lidar_pipeline_deinit(&g_pipeline);
+}
+
+static void trace_stage(void *ctx, lidar_scan_data_t *scan)
+{
+    lidar_stage_id_t stage = (lidar_stage_id_t)(intptr_t)ctx;
+    uint32_t n = g_seen_count[stage];
+    if (n < TEST_FRAMES) {
+        g_seen[stage][n] = scan->scan_quality;
+    }
+    g_stage_thread[stage] = pthread_self();
+    __atomic_store_n(&g_seen_count[stage], n + 1U, __ATOMIC_RELEASE);
+
+    if (stage == LIDAR_STAGE_FILTER) {
+        // Later stages must see what the filter wrote
+        scan->distance_mm[0] = (uint16_t)(scan->distance_mm[0] + 1U);
+    } else if (stage == LIDAR_STAGE_SAFETY) {
+        while (g_block_safety) {
+            usleep(100);
+        }
+    }
+}
+
+static lidar_pipeline_config_t trace_config(uint8_t workers)
+{
+    lidar_pipeline_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.workers = workers;
+    config.safety_cpu = LIDAR_PIPELINE_CPU_NONE;
+    for (int s = LIDAR_STAGE_FILTER; s < LIDAR_STAGE_COUNT; s++) {
+        config.stages[s].fn = trace_stage;
+        config.stages[s].ctx = (void *)(intptr_t)s;
+    }
+    return config;
+}
+
+static void submit_frame(uint32_t id)
+{
+    lidar_scan_data_t *scan = NULL;
+    // Frames come back as the reduce stage finishes with them
+    for (int tries = 0; tries < 10000 && scan == NULL; tries++) {
+        scan = lidar_pipeline_acquire(&g_pipeline);
+        if (scan == NULL) {
+            usleep(100);
+        }
+    }
+    TEST_ASSERT_NOT_NULL(scan);
+    if (scan == NULL) {
+        return;
+    }
+    memset(scan, 0, sizeof(*scan));
+    scan->scan_quality = (uint8_t)id;
+    scan->distance_mm[0] = (uint16_t)(id * 10U);
+    scan->scan_complete = true;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_submit(&g_pipeline, scan, 1000));
+}
+
+void test_start_rejects_bad_config(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(0);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_pipeline_start(&g_pipeline, &config));
+    config.workers = LIDAR_PIPELINE_MAX_WORKERS + 1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_pipeline_start(&g_pipeline, &config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_pipeline_start(&g_pipeline, NULL));
+
+    // Not started: nothing to submit to, no workers to query
+    pthread_t thread;
+    lidar_scan_data_t *scan = lidar_pipeline_acquire(&g_pipeline);
+    TEST_ASSERT_NOT_NULL(scan);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_STATE, lidar_pipeline_submit(&g_pipeline, scan, 0));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, lidar_pipeline_get_worker(&g_pipeline, 0, &thread));
+
+    lidar_scan_data_t outside;
+    config.workers = 1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_ACTIVE, lidar_pipeline_start(&g_pipeline, &config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_pipeline_submit(&g_pipeline, &outside, 0));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_worker(&g_pipeline, 0, &thread));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_FOUND, lidar_pipeline_get_worker(&g_pipeline, 1, &thread));
+    tearDown();
+}
+
+void test_stages_run_in_order_for_every_worker_count(void)
+{
+    for (uint8_t workers = 1; workers <= LIDAR_PIPELINE_MAX_WORKERS; workers++) {
+        setUp();
+        lidar_pipeline_config_t config = trace_config(workers);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+
+        for (uint32_t id = 1; id <= TEST_FRAMES; id++) {
+            submit_frame(id);
+        }
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+
+        // Every stage saw every frame, in submission order
+        for (int s = LIDAR_STAGE_FILTER; s < LIDAR_STAGE_COUNT; s++) {
+            TEST_ASSERT_EQUAL_UINT(TEST_FRAMES, __atomic_load_n(&g_seen_count[s], __ATOMIC_ACQUIRE));
+            for (uint32_t i = 0; i < TEST_FRAMES; i++) {
+                TEST_ASSERT_EQUAL_UINT(i + 1U, g_seen[s][i]);
+            }
+        }
+
+        lidar_pipeline_stats_t stats;
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_stats(&g_pipeline, &stats));
+        TEST_ASSERT_EQUAL(workers, stats.workers);
+        TEST_ASSERT_EQUAL(TEST_FRAMES, stats.submitted);
+        TEST_ASSERT_EQUAL(TEST_FRAMES, stats.completed);
+        tearDown();
+    }
+}
+
+static uint16_t g_safety_saw_mm;
+
+static void record_distance(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    g_safety_saw_mm = scan->distance_mm[0];
+}
+
+void test_filter_output_reaches_later_stages(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(3);
+    config.stages[LIDAR_STAGE_SAFETY].fn = record_distance;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+
+    submit_frame(7);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+    TEST_ASSERT_EQUAL(71, g_safety_saw_mm);
+    tearDown();
+}
+
+void test_acquire_starves_when_all_frames_in_flight(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(2);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+    g_block_safety = 1;
+
+    // One frame sits in safety, the rest queue behind it
+    for (uint32_t id = 1; id <= LIDAR_PIPELINE_FRAMES; id++) {
+        submit_frame(id);
+    }
+    TEST_ASSERT_NULL(lidar_pipeline_acquire(&g_pipeline));
+    TEST_ASSERT_NULL(lidar_pipeline_acquire(&g_pipeline));
+
+    lidar_pipeline_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_stats(&g_pipeline, &stats));
+    TEST_ASSERT_EQUAL(2, stats.starved);
+    TEST_ASSERT_EQUAL(LIDAR_PIPELINE_FRAMES, stats.submitted);
+
+    // Released: everything drains and the buffers come back
+    g_block_safety = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+    TEST_ASSERT_NOT_NULL(lidar_pipeline_acquire(&g_pipeline));
+    tearDown();
+}
+
+void test_flush_times_out_while_a_stage_blocks(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(1);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+    g_block_safety = 1;
+    submit_frame(1);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_TIMEOUT, lidar_pipeline_flush(&g_pipeline, 20));
+    g_block_safety = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+    tearDown();
+}
+
+static void slow_safety(void *ctx, lidar_scan_data_t *scan)
+{
+    (void)ctx;
+    (void)scan;
+    usleep(2000);
+}
+
+void test_stats_record_stage_time_and_decision_latency(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(2);
+    config.stages[LIDAR_STAGE_SAFETY].fn = slow_safety;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+
+    for (uint32_t id = 1; id <= 4; id++) {
+        submit_frame(id);
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+
+    lidar_pipeline_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_stats(&g_pipeline, &stats));
+    for (int s = LIDAR_STAGE_FRAMING; s < LIDAR_STAGE_COUNT; s++) {
+        TEST_ASSERT_EQUAL(4, stats.stages[s].frames);
+    }
+
+    // Framing time is what the producer reported
+    TEST_ASSERT_EQUAL(4000, stats.stages[LIDAR_STAGE_FRAMING].total_ns);
+    TEST_ASSERT_EQUAL(1000, stats.stages[LIDAR_STAGE_FRAMING].max_ns);
+
+    // The safety stage sleeps 2 ms, so each decision takes at least that long
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(2000000, stats.stages[LIDAR_STAGE_SAFETY].last_ns);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(8000000, stats.stages[LIDAR_STAGE_SAFETY].total_ns);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(2000, stats.decision_last_us);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(stats.decision_last_us, stats.decision_max_us);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(8000, stats.decision_total_us);
+    tearDown();
+}
+
+void test_restart_resets_frames_and_stats(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(3);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+    g_block_safety = 1;
+    for (uint32_t id = 1; id <= 3; id++) {
+        submit_frame(id);
+    }
+    g_block_safety = 0;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_stop(&g_pipeline));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_stop(&g_pipeline));
+
+    lidar_pipeline_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_stats(&g_pipeline, &stats));
+    TEST_ASSERT_EQUAL(0, stats.workers);
+
+    // All buffers are free again and the counters start over
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_stats(&g_pipeline, &stats));
+    TEST_ASSERT_EQUAL(0, stats.submitted);
+    TEST_ASSERT_EQUAL(0, stats.completed);
+    TEST_ASSERT_EQUAL(3, stats.workers);
+    for (uint32_t id = 1; id <= LIDAR_PIPELINE_FRAMES; id++) {
+        submit_frame(id);
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+    tearDown();
+}
+
+void test_safety_stage_runs_on_its_own_worker(void)
+{
+    setUp();
+    lidar_pipeline_config_t config = trace_config(2);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_start(&g_pipeline, &config));
+    submit_frame(1);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_flush(&g_pipeline, 2000));
+
+    pthread_t filter_worker;
+    pthread_t safety_worker;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_worker(&g_pipeline, 0, &filter_worker));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_worker(&g_pipeline, 1, &safety_worker));
+    TEST_ASSERT_TRUE(pthread_equal(g_stage_thread[LIDAR_STAGE_FILTER], filter_worker));
+    TEST_ASSERT_TRUE(pthread_equal(g_stage_thread[LIDAR_STAGE_REDUCE], filter_worker));
+    TEST_ASSERT_TRUE(pthread_equal(g_stage_thread[LIDAR_STAGE_SAFETY], safety_worker));
+
+    // Placement was not requested
+    lidar_pipeline_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_pipeline_get_stats(&g_pipeline, &stats));
+    TEST_ASSERT_EQUAL(-1, stats.safety_cpu);
+    TEST_ASSERT_FALSE(stats.safety_realtime);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== LiDAR Pipeline Tests ===\n");
+
+    RUN_TEST(test_start_rejects_bad_config);
+    RUN_TEST(test_stages_run_in_order_for_every_worker_count);
+    RUN_TEST(test_filter_output_reaches_later_stages);
+    RUN_TEST(test_acquire_starves_when_all_frames_in_flight);
+    RUN_TEST(test_flush_times_out_while_a_stage_blocks);
+    RUN_TEST(test_stats_record_stage_time_and_decision_latency);
+    RUN_TEST(test_restart_resets_frames_and_stats);
+    RUN_TEST(test_safety_stage_runs_on_its_own_worker);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file test_hal_lidar_window.c
+ * @brief Tests for the angle-binned sliding-window LiDAR statistics
+ */
+
+#include "unity.h"
+#include "hal_lidar_window.h"
+#include "hal_lidar.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_init_rejects_bad_lengths(void);
+void test_single_frame_one_sample_per_bin(void);
+void test_frames_match_by_angle_not_index(void);
+void test_window_slides_and_evicts(void);
+void test_quality_weighted_mean(void);
+void test_sigma_gate_matches_z_score(void);
+void test_matches_brute_force_over_random_frames(void);
+
+static lidar_window_t g_window;
+static lidar_scan_data_t g_scan;
+
+void setUp(void)
+{
+    memset(&g_window, 0, sizeof(g_window));
+    memset(&g_scan, 0, sizeof(g_scan));
+}
+
+void tearDown(void)
+{
+}
+
+static void add_point(uint16_t deg_x10, uint16_t distance_mm, uint8_t quality)
+{
+    uint16_t i = g_scan.point_count++;
+    g_scan.angle_q6[i] = (uint16_t)((uint32_t)deg_x10 * 64U / 10U);
+    g_scan.distance_mm[i] = distance_mm;
+    g_scan.quality[i] = quality;
+}
+
+static lidar_window_stats_t bin_stats(uint16_t bin)
+{
+    lidar_window_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_get_stats(&g_window, bin, &stats));
+    return stats;
+}
+
+void test_init_rejects_bad_lengths(void)
+{
+    setUp();
+    lidar_window_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_window_init(&g_window, 0));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_window_init(&g_window, LIDAR_WINDOW_MAX_FRAMES + 1));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_window_init(NULL, 3));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_window_push(&g_window, &g_scan));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, LIDAR_WINDOW_MAX_FRAMES));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_window_get_stats(&g_window, LIDAR_WINDOW_BINS, &stats));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, lidar_window_push(&g_window, NULL));
+    tearDown();
+}
+
+void test_single_frame_one_sample_per_bin(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, 4));
+
+    // Two returns in degree 10 are averaged, a return without distance is ignored
+    add_point(100, 1000, 40);
+    add_point(104, 1101, 20);
+    add_point(200, 0, 50);
+    add_point(3598, 2500, 10);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+
+    lidar_window_stats_t stats = bin_stats(10);
+    TEST_ASSERT_EQUAL(1, stats.count);
+    TEST_ASSERT_EQUAL_FLOAT(1051.0f, stats.mean_mm, 0.01f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.variance_mm2, 0.01f);
+    TEST_ASSERT_EQUAL(0, bin_stats(20).count);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bin_stats(20).mean_mm, 0.01f);
+
+    // 359.8 degrees rounds to bin 0
+    TEST_ASSERT_EQUAL(1, bin_stats(0).count);
+    TEST_ASSERT_EQUAL_FLOAT(2500.0f, bin_stats(0).mean_mm, 0.01f);
+    TEST_ASSERT_EQUAL(1, g_window.filled);
+    tearDown();
+}
+
+void test_frames_match_by_angle_not_index(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, 3));
+
+    // The same wall at 45 degrees lands at different array indices in each frame
+    add_point(450, 3000, 30);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+
+    memset(&g_scan, 0, sizeof(g_scan));
+    add_point(10, 800, 30);
+    add_point(20, 810, 30);
+    add_point(451, 3010, 30);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+
+    lidar_window_stats_t stats = bin_stats(45);
+    TEST_ASSERT_EQUAL(2, stats.count);
+    TEST_ASSERT_EQUAL_FLOAT(3005.0f, stats.mean_mm, 0.01f);
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, stats.variance_mm2, 0.01f);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, stats.stddev_mm, 0.01f);
+    TEST_ASSERT_EQUAL(1, bin_stats(1).count);
+    TEST_ASSERT_EQUAL(1, bin_stats(2).count);
+    tearDown();
+}
+
+void test_window_slides_and_evicts(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, 3));
+
+    for (uint16_t f = 0; f < 5; f++) {
+        memset(&g_scan, 0, sizeof(g_scan));
+        add_point(100, (uint16_t)(1000 + 100 * f), 30);
+        // Degree 11 only in the first frame
+        if (f == 0) {
+            add_point(110, 500, 30);
+        }
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+    }
+
+    // Last three frames: 1200, 1300, 1400
+    lidar_window_stats_t stats = bin_stats(10);
+    TEST_ASSERT_EQUAL(3, stats.count);
+    TEST_ASSERT_EQUAL_FLOAT(1300.0f, stats.mean_mm, 0.01f);
+    TEST_ASSERT_EQUAL_FLOAT(20000.0f / 3.0f, stats.variance_mm2, 0.1f);
+    TEST_ASSERT_EQUAL(0, bin_stats(11).count);
+    TEST_ASSERT_EQUAL(3, g_window.filled);
+    TEST_ASSERT_EQUAL(5, g_window.pushes);
+
+    lidar_window_reset(&g_window);
+    TEST_ASSERT_EQUAL(0, bin_stats(10).count);
+    TEST_ASSERT_EQUAL(3, g_window.frames);
+    tearDown();
+}
+
+void test_quality_weighted_mean(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, 2));
+
+    add_point(900, 1000, 60);
+    add_point(1800, 700, 0);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+    memset(&g_scan, 0, sizeof(g_scan));
+    add_point(900, 2000, 20);
+    add_point(1800, 900, 0);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+
+    // (1000 * 60 + 2000 * 20) / 80
+    lidar_window_stats_t stats = bin_stats(90);
+    TEST_ASSERT_EQUAL_FLOAT(1500.0f, stats.mean_mm, 0.01f);
+    TEST_ASSERT_EQUAL_FLOAT(1250.0f, stats.weighted_mean_mm, 0.01f);
+
+    // No quality at all: plain mean
+    stats = bin_stats(180);
+    TEST_ASSERT_EQUAL_FLOAT(800.0f, stats.weighted_mean_mm, 0.01f);
+    tearDown();
+}
+
+void test_sigma_gate_matches_z_score(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, 4));
+
+    // 1000, 1010, 990, 1000: mean 1000, stddev ~7.07
+    const uint16_t d[4] = { 1000, 1010, 990, 1000 };
+    for (int f = 0; f < 4; f++) {
+        memset(&g_scan, 0, sizeof(g_scan));
+        add_point(300, d[f], 30);
+        add_point(310, 500, 30);
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+    }
+
+    TEST_ASSERT_EQUAL(4, lidar_window_count(&g_window, 30));
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, lidar_window_mean_mm(&g_window, 30), 0.01f);
+    TEST_ASSERT_FALSE(lidar_window_exceeds_sigma(&g_window, 30, 1014, 2.0f));
+    TEST_ASSERT_TRUE(lidar_window_exceeds_sigma(&g_window, 30, 1015, 2.0f));
+    TEST_ASSERT_TRUE(lidar_window_exceeds_sigma(&g_window, 30, 985, 2.0f));
+    TEST_ASSERT_FALSE(lidar_window_exceeds_sigma(&g_window, 30, 1021, 3.0f));
+
+    // No spread: z-score undefined, nothing is gated
+    TEST_ASSERT_FALSE(lidar_window_exceeds_sigma(&g_window, 31, 900, 2.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lidar_window_mean_mm(&g_window, 32), 0.01f);
+    tearDown();
+}
+
+void test_matches_brute_force_over_random_frames(void)
+{
+    setUp();
+    static uint16_t history[32][LIDAR_WINDOW_BINS];
+    const uint8_t frames = 7;
+    uint32_t x = 12345;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_init(&g_window, frames));
+
+    for (uint16_t f = 0; f < 32; f++) {
+        memset(&g_scan, 0, sizeof(g_scan));
+        memset(history[f], 0, sizeof(history[f]));
+        // One return per degree, some missing
+        for (uint16_t deg = 0; deg < LIDAR_WINDOW_BINS; deg++) {
+            x = x * 1103515245U + 12345U;
+            uint16_t d = ((x >> 16) % 7U == 0) ? 0 : (uint16_t)(200U + (x >> 16) % 60000U);
+            add_point((uint16_t)(deg * 10U), d, (uint8_t)(x >> 24));
+            history[f][deg] = d;
+        }
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, lidar_window_push(&g_window, &g_scan));
+
+        for (uint16_t deg = 0; deg < LIDAR_WINDOW_BINS; deg += 7) {
+            double sum = 0.0;
+            double sum_sq = 0.0;
+            uint8_t n = 0;
+            for (int k = (int)f; k >= 0 && k > (int)f - frames; k--) {
+                if (history[k][deg] != 0) {
+                    sum += history[k][deg];
+                    sum_sq += (double)history[k][deg] * history[k][deg];
+                    n++;
+                }
+            }
+            lidar_window_stats_t stats = bin_stats(deg);
+            TEST_ASSERT_EQUAL(n, stats.count);
+            if (n > 0) {
+                double mean = sum / n;
+                double variance = sum_sq / n - mean * mean;
+                TEST_ASSERT_EQUAL_FLOAT((float)mean, stats.mean_mm, 0.05f);
+                TEST_ASSERT_EQUAL_FLOAT((float)variance, stats.variance_mm2, (float)(variance * 1e-5 + 1.0));
+            }
+        }
+    }
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== LiDAR Sliding Window Tests ===\n");
+
+    RUN_TEST(test_init_rejects_bad_lengths);
+    RUN_TEST(test_single_frame_one_sample_per_bin);
+    RUN_TEST(test_frames_match_by_angle_not_index);
+    RUN_TEST(test_window_slides_and_evicts);
+    RUN_TEST(test_quality_weighted_mean);
+    RUN_TEST(test_sigma_gate_matches_z_score);
+    RUN_TEST(test_matches_brute_force_over_random_frames);
+
+    UNITY_END();
+    return 0;
+}
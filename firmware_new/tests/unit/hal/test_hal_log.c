@@ -0,0 +1,278 @@
+/**
+ * @file test_hal_log.c
+ * @brief Tests for component-level logging, the writer rings, rate limiting and the frame trace
+ */
+
+#include "unity.h"
+#include "hal_log.h"
+#include "hal_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define TEST_THREADS            4
+#define TEST_RECORDS_PER_THREAD 50
+
+static FILE *log_file;
+static char log_text[65536];
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_level_and_component_names(void);
+void test_disabled_levels_do_not_evaluate_arguments(void);
+void test_direct_write_without_writer(void);
+void test_writer_drains_thread_rings(void);
+void test_ratelimit_suppresses_and_reports(void);
+void test_trace_only_records_enabled_modules(void);
+void test_trace_ring_keeps_newest_records(void);
+
+void setUp(void)
+{
+    log_file = tmpfile();
+    hal_log_set_output(log_file);
+    for (int c = 0; c < HAL_LOG_COMP_COUNT; c++) {
+        hal_log_set_component_level((hal_log_component_t)c, HAL_LOG_LEVEL_INFO);
+    }
+}
+
+void tearDown(void)
+{
+    (void)hal_log_stop();
+    hal_log_set_output(NULL);
+    if (log_file != NULL) {
+        fclose(log_file);
+        log_file = NULL;
+    }
+}
+
+// Everything written to the log file so far
+static const char* read_log(void)
+{
+    hal_log_flush();
+    rewind(log_file);
+    size_t n = fread(log_text, 1, sizeof(log_text) - 1, log_file);
+    log_text[n] = '\0';
+    return log_text;
+}
+
+static int count_lines(const char *text)
+{
+    int lines = 0;
+    for (; *text; text++) {
+        if (*text == '\n') {
+            lines++;
+        }
+    }
+    return lines;
+}
+
+void test_level_and_component_names(void)
+{
+    setUp();
+    hal_log_level_t level;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_log_level_from_name("warning", &level));
+    TEST_ASSERT_EQUAL(HAL_LOG_LEVEL_WARNING, level);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_log_level_from_name("off", &level));
+    TEST_ASSERT_EQUAL(HAL_LOG_LEVEL_OFF, level);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_log_level_from_name("verbose", &level));
+
+    TEST_ASSERT_EQUAL(HAL_LOG_COMP_RS485, hal_log_component_from_name("rs485"));
+    TEST_ASSERT_EQUAL(HAL_LOG_COMP_COUNT, hal_log_component_from_name("uart"));
+    TEST_ASSERT_EQUAL_STRING("polling", hal_log_component_name(HAL_LOG_COMP_POLLING));
+    TEST_ASSERT_EQUAL_STRING("debug", hal_log_level_name(HAL_LOG_LEVEL_DEBUG));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_log_set_component_level(HAL_LOG_COMP_MODBUS, HAL_LOG_LEVEL_ERROR));
+    TEST_ASSERT_EQUAL(HAL_LOG_LEVEL_ERROR, hal_log_get_component_level(HAL_LOG_COMP_MODBUS));
+    TEST_ASSERT_EQUAL(HAL_LOG_LEVEL_INFO, hal_log_get_component_level(HAL_LOG_COMP_RS485));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_log_set_component_level(HAL_LOG_COMP_COUNT, HAL_LOG_LEVEL_INFO));
+    tearDown();
+}
+
+void test_disabled_levels_do_not_evaluate_arguments(void)
+{
+    setUp();
+    int evaluated = 0;
+
+    hal_log_set_component_level(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_WARNING);
+    HAL_LOGI(HAL_LOG_COMP_RS485, "value %d", ++evaluated);
+    TEST_ASSERT_EQUAL(0, evaluated);
+    HAL_LOGW(HAL_LOG_COMP_RS485, "value %d", ++evaluated);
+    TEST_ASSERT_EQUAL(1, evaluated);
+
+    hal_log_set_component_level(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_OFF);
+    HAL_LOGE(HAL_LOG_COMP_RS485, "value %d", ++evaluated);
+    TEST_ASSERT_EQUAL(1, evaluated);
+
+    // DEBUG statements are compiled out entirely when HAL_LOG_COMPILE_LEVEL is above DEBUG
+    hal_log_set_component_level(HAL_LOG_COMP_RS485, HAL_LOG_LEVEL_DEBUG);
+    HAL_LOGD(HAL_LOG_COMP_RS485, "value %d", ++evaluated);
+    TEST_ASSERT_EQUAL(HAL_LOG_COMPILE_LEVEL > HAL_LOG_LEVEL_DEBUG ? 1 : 2, evaluated);
+
+    const char *text = read_log();
+    TEST_ASSERT_NOT_NULL(strstr(text, "[WARNING] [rs485] value 1\n"));
+    TEST_ASSERT_NULL(strstr(text, "[rs485] value 0"));
+    tearDown();
+}
+
+void test_direct_write_without_writer(void)
+{
+    setUp();
+    hal_log_stats_t before, after;
+    hal_log_get_stats(&before);
+
+    HAL_LOGI(HAL_LOG_COMP_MODBUS, "direct %s", "record");
+
+    hal_log_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.records_direct + 1, after.records_direct);
+    TEST_ASSERT_NOT_NULL(strstr(read_log(), "[INFO] [modbus] direct record\n"));
+    tearDown();
+}
+
+static void* log_thread_main(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    for (int i = 0; i < TEST_RECORDS_PER_THREAD; i++) {
+        HAL_LOGI(HAL_LOG_COMP_BUS, "thread %d record %d", id, i);
+    }
+    return NULL;
+}
+
+void test_writer_drains_thread_rings(void)
+{
+    setUp();
+    hal_log_stats_t before, after;
+    hal_log_get_stats(&before);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_log_start(log_file));
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_ACTIVE, hal_log_start(log_file));
+
+    pthread_t threads[TEST_THREADS];
+    for (int t = 0; t < TEST_THREADS; t++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[t], NULL, log_thread_main, (void *)(intptr_t)t));
+    }
+    for (int t = 0; t < TEST_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_log_stop());
+
+    hal_log_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.records_written + TEST_THREADS * TEST_RECORDS_PER_THREAD, after.records_written);
+    TEST_ASSERT_EQUAL(before.records_dropped, after.records_dropped);
+    TEST_ASSERT_EQUAL(before.records_direct, after.records_direct);
+
+    const char *text = read_log();
+    TEST_ASSERT_EQUAL(TEST_THREADS * TEST_RECORDS_PER_THREAD, count_lines(text));
+    TEST_ASSERT_NOT_NULL(strstr(text, "[INFO] [bus] thread 3 record 49\n"));
+    tearDown();
+}
+
+void test_ratelimit_suppresses_and_reports(void)
+{
+    setUp();
+    hal_log_stats_t before, after;
+    hal_log_get_stats(&before);
+
+    for (int i = 0; i < 100; i++) {
+        HAL_LOG_RATELIMITED(HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING, 60000, "burst %d", i);
+    }
+    hal_log_get_stats(&after);
+    TEST_ASSERT_EQUAL(before.records_suppressed + 99, after.records_suppressed);
+    TEST_ASSERT_EQUAL(1, count_lines(read_log()));
+
+    hal_log_ratelimit_t rl = {0};
+    TEST_ASSERT_TRUE(hal_log_ratelimit_pass(&rl, 20, HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING));
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_FALSE(hal_log_ratelimit_pass(&rl, 20, HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING));
+    }
+    usleep(30000);
+    TEST_ASSERT_TRUE(hal_log_ratelimit_pass(&rl, 20, HAL_LOG_COMP_COMM, HAL_LOG_LEVEL_WARNING));
+    TEST_ASSERT_NOT_NULL(strstr(read_log(), "[WARNING] [comm] (5 similar messages suppressed)\n"));
+    tearDown();
+}
+
+void test_trace_only_records_enabled_modules(void)
+{
+    setUp();
+    const uint8_t request[] = { 0x02, 0x03, 0x00, 0x00, 0x00, 0x02, 0xC4, 0x38 };
+    const uint8_t response[] = { 0x02, 0x03, 0x04, 0x00, 0x01, 0x00, 0x02, 0x2A, 0x32 };
+    hal_log_trace_record_t records[8];
+
+    hal_log_trace_enable(0x02, false);
+    HAL_LOG_TRACE_FRAME(0x02, HAL_LOG_TRACE_TX, request, sizeof(request));
+    TEST_ASSERT_EQUAL(0, hal_log_trace_read(0x02, 0, records, 8));
+
+    hal_log_trace_enable(0x02, true);
+    hal_log_trace_enable(0x03, true);
+    TEST_ASSERT_TRUE(hal_log_trace_is_enabled(0x02));
+    HAL_LOG_TRACE_FRAME(0x02, HAL_LOG_TRACE_TX, request, sizeof(request));
+    HAL_LOG_TRACE_FRAME(0x03, HAL_LOG_TRACE_TX, request, sizeof(request));
+    HAL_LOG_TRACE_FRAME(0x02, HAL_LOG_TRACE_RX, response, sizeof(response));
+
+    uint32_t count = hal_log_trace_read(0x02, 0, records, 8);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(HAL_LOG_TRACE_TX, records[0].dir);
+    TEST_ASSERT_EQUAL(sizeof(request), records[0].length);
+    TEST_ASSERT_EQUAL(0, memcmp(request, records[0].data, sizeof(request)));
+    TEST_ASSERT_EQUAL(HAL_LOG_TRACE_RX, records[1].dir);
+    TEST_ASSERT_EQUAL(0, memcmp(response, records[1].data, sizeof(response)));
+    TEST_ASSERT_TRUE(records[1].seq > records[0].seq);
+
+    // Incremental read continues after the last sequence number seen
+    TEST_ASSERT_EQUAL(1, hal_log_trace_read(0x02, records[0].seq, records, 8));
+    TEST_ASSERT_EQUAL(HAL_LOG_TRACE_RX, records[0].dir);
+    TEST_ASSERT_EQUAL(0, hal_log_trace_read(0x02, records[0].seq, records, 8));
+
+    hal_log_trace_enable(0x02, false);
+    hal_log_trace_enable(0x03, false);
+    TEST_ASSERT_FALSE(hal_log_trace_is_enabled(0x03));
+    tearDown();
+}
+
+void test_trace_ring_keeps_newest_records(void)
+{
+    setUp();
+    static hal_log_trace_record_t records[HAL_LOG_TRACE_RECORDS * 2];
+    uint8_t frame[100];
+    for (uint32_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)i;
+    }
+
+    hal_log_trace_enable(0x04, true);
+    for (int i = 0; i < HAL_LOG_TRACE_RECORDS + 44; i++) {
+        frame[0] = (uint8_t)i;
+        HAL_LOG_TRACE_FRAME(0x04, HAL_LOG_TRACE_TX, frame, sizeof(frame));
+    }
+    hal_log_trace_enable(0x04, false);
+
+    uint32_t count = hal_log_trace_read(0x04, 0, records, HAL_LOG_TRACE_RECORDS * 2);
+    TEST_ASSERT_EQUAL(HAL_LOG_TRACE_RECORDS, count);
+    TEST_ASSERT_EQUAL((uint8_t)44, records[0].data[0]);
+    TEST_ASSERT_EQUAL((uint8_t)(HAL_LOG_TRACE_RECORDS + 43), records[count - 1].data[0]);
+    TEST_ASSERT_EQUAL(sizeof(frame), records[count - 1].length);
+    TEST_ASSERT_EQUAL(HAL_LOG_TRACE_BYTES - 1, records[count - 1].data[HAL_LOG_TRACE_BYTES - 1]);
+    for (uint32_t i = 1; i < count; i++) {
+        TEST_ASSERT_EQUAL(records[i - 1].seq + 1, records[i].seq);
+    }
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== HAL LOG TESTS ===\n");
+
+    RUN_TEST(test_level_and_component_names);
+    RUN_TEST(test_disabled_levels_do_not_evaluate_arguments);
+    RUN_TEST(test_direct_write_without_writer);
+    RUN_TEST(test_writer_drains_thread_rings);
+    RUN_TEST(test_ratelimit_suppresses_and_reports);
+    RUN_TEST(test_trace_only_records_enabled_modules);
+    RUN_TEST(test_trace_ring_keeps_newest_records);
+
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_hal_modbus_crc.c
+ * @brief Tests for the shared Modbus RTU CRC16 kernels
+ */
+
+#include "unity.h"
+#include "hal_modbus_crc.h"
+#include "hal_rs485.h"
+#include <stdio.h>
+#include <string.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_crc_matches_published_check_value(void);
+void test_kernels_agree_on_every_length(void);
+void test_incremental_update_matches_one_shot(void);
+void test_append_and_check_frame(void);
+void test_self_test_selects_slice8(void);
+void test_rs485_crc_helpers_use_shared_kernel(void);
+
+static uint8_t g_buf[600];
+
+void setUp(void)
+{
+    uint32_t x = 0x12345678U;
+    for (size_t i = 0; i < sizeof(g_buf); i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        g_buf[i] = (uint8_t)x;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+void test_crc_matches_published_check_value(void)
+{
+    setUp();
+    const uint8_t check[] = "123456789";
+    // FC03 request for 2 registers at 0x0000 from slave 1: 01 03 00 00 00 02 C4 0B
+    const uint8_t request[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x02 };
+
+    TEST_ASSERT_EQUAL(0x4B37, modbus_crc16(check, 9));
+    TEST_ASSERT_EQUAL(0x0BC4, modbus_crc16(request, sizeof(request)));
+    TEST_ASSERT_EQUAL(MODBUS_CRC16_INIT, modbus_crc16(check, 0));
+    tearDown();
+}
+
+void test_kernels_agree_on_every_length(void)
+{
+    setUp();
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length + offset <= sizeof(g_buf); length += (length < 64U) ? 1U : 29U) {
+            uint16_t ref = modbus_crc16_update_with(MODBUS_CRC16_IMPL_BITWISE, MODBUS_CRC16_INIT, g_buf + offset, length);
+            TEST_ASSERT_EQUAL(ref, modbus_crc16_update_with(MODBUS_CRC16_IMPL_TABLE, MODBUS_CRC16_INIT,
+                                                            g_buf + offset, length));
+            TEST_ASSERT_EQUAL(ref, modbus_crc16_update_with(MODBUS_CRC16_IMPL_SLICE8, MODBUS_CRC16_INIT,
+                                                            g_buf + offset, length));
+            TEST_ASSERT_EQUAL(ref, modbus_crc16(g_buf + offset, length));
+        }
+    }
+    tearDown();
+}
+
+void test_incremental_update_matches_one_shot(void)
+{
+    setUp();
+    uint16_t one_shot = modbus_crc16(g_buf, 256);
+
+    // Byte at a time, as a receiver folding in single reads would
+    uint16_t crc = MODBUS_CRC16_INIT;
+    for (size_t i = 0; i < 256; i++) {
+        crc = modbus_crc16_update(crc, &g_buf[i], 1);
+    }
+    TEST_ASSERT_EQUAL(one_shot, crc);
+
+    // Uneven chunks crossing slice boundaries
+    const size_t chunks[] = { 3, 13, 1, 40, 7, 64, 128 };
+    size_t pos = 0;
+    crc = MODBUS_CRC16_INIT;
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        crc = modbus_crc16_update(crc, g_buf + pos, chunks[c]);
+        pos += chunks[c];
+    }
+    TEST_ASSERT_EQUAL(256, pos);
+    TEST_ASSERT_EQUAL(one_shot, crc);
+    tearDown();
+}
+
+void test_append_and_check_frame(void)
+{
+    setUp();
+    uint8_t frame[16] = { 0x02, 0x03, 0x00, 0x00, 0x00, 0x0A };
+
+    TEST_ASSERT_EQUAL(8, modbus_crc16_append(frame, 6));
+    uint16_t crc = modbus_crc16(frame, 6);
+    TEST_ASSERT_EQUAL(crc & 0xFF, frame[6]);
+    TEST_ASSERT_EQUAL(crc >> 8, frame[7]);
+    TEST_ASSERT_TRUE(modbus_crc16_check_frame(frame, 8));
+    TEST_ASSERT_EQUAL(MODBUS_CRC16_RESIDUE, modbus_crc16(frame, 8));
+
+    frame[3] ^= 0x01;
+    TEST_ASSERT_FALSE(modbus_crc16_check_frame(frame, 8));
+    TEST_ASSERT_FALSE(modbus_crc16_check_frame(frame, 2));
+    TEST_ASSERT_FALSE(modbus_crc16_check_frame(NULL, 8));
+    tearDown();
+}
+
+void test_self_test_selects_slice8(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, modbus_crc16_self_test());
+    TEST_ASSERT_EQUAL(MODBUS_CRC16_IMPL_SLICE8, modbus_crc16_active_impl());
+    TEST_ASSERT_EQUAL_STRING("slice8", modbus_crc16_impl_name(MODBUS_CRC16_IMPL_SLICE8));
+    tearDown();
+}
+
+void test_rs485_crc_helpers_use_shared_kernel(void)
+{
+    setUp();
+    const uint8_t request[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x02 };
+    TEST_ASSERT_EQUAL(0x0BC4, modbus_calculate_crc(request, sizeof(request)));
+    TEST_ASSERT_TRUE(modbus_verify_crc(request, sizeof(request), 0x0BC4));
+    TEST_ASSERT_FALSE(modbus_verify_crc(request, sizeof(request), 0x0BC5));
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== MODBUS CRC16 TESTS ===\n");
+
+    RUN_TEST(test_crc_matches_published_check_value);
+    RUN_TEST(test_kernels_agree_on_every_length);
+    RUN_TEST(test_incremental_update_matches_one_shot);
+    RUN_TEST(test_append_and_check_frame);
+    RUN_TEST(test_self_test_selects_slice8);
+    RUN_TEST(test_rs485_crc_helpers_use_shared_kernel);
+
+    UNITY_END();
+    return 0;
+}
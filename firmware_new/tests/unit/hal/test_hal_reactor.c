@@ -0,0 +1,336 @@
+/**
+ * @file test_hal_reactor.c
+ * @brief Unit tests for the main-thread event reactor
+ */
+
+#include "unity.h"
+#include "hal_reactor.h"
+#include "hal_common.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+static int g_runs[4];
+static int g_self_remove_id = -1;
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_rejects_bad_parameters(void);
+void test_periodic_tasks_keep_their_rate(void);
+void test_idle_reactor_sleeps(void);
+void test_signal_from_another_thread(void);
+void test_signals_coalesce(void);
+void test_fd_watcher(void);
+void test_stop_from_another_thread(void);
+void test_overrun_skips_periods(void);
+void test_remove_and_set_period(void);
+
+static void count_task(void *context)
+{
+    g_runs[(intptr_t)context]++;
+}
+
+static void slow_task(void *context)
+{
+    g_runs[(intptr_t)context]++;
+    usleep(35000);
+}
+
+static void self_removing_task(void *context)
+{
+    g_runs[(intptr_t)context]++;
+    (void)hal_reactor_remove(g_self_remove_id);
+}
+
+static void read_pipe(int fd, uint32_t events, void *context)
+{
+    char buf[16];
+    if ((events & EPOLLIN) != 0 && read(fd, buf, sizeof(buf)) > 0) {
+        g_runs[(intptr_t)context]++;
+    }
+}
+
+static void run_for_ms(uint32_t ms)
+{
+    uint64_t end = hal_time_now_ms() + ms;
+    while (hal_time_now_ms() < end) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once((int)(end - hal_time_now_ms()) + 1));
+    }
+}
+
+void setUp(void)
+{
+    memset(g_runs, 0, sizeof(g_runs));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_init());
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_deinit());
+}
+
+void test_rejects_bad_parameters(void)
+{
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, hal_reactor_run_once(0));
+    TEST_ASSERT_EQUAL(HAL_STATUS_NOT_INITIALIZED, hal_reactor_add_periodic("t", 10, count_task, NULL, NULL));
+
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_ALREADY_INITIALIZED, hal_reactor_init());
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_add_periodic("t", 0, count_task, NULL, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_add_periodic("t", 10, NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_add_fd("t", -1, EPOLLIN, read_pipe, NULL, NULL));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_remove(3));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_signal(HAL_REACTOR_MAX_TASKS));
+
+    // Only event tasks can be signalled
+    int id = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("t", 10, count_task, (void *)0, &id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_signal(id));
+
+    // The table is finite
+    for (int i = 1; i < HAL_REACTOR_MAX_TASKS; i++) {
+        TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_event("e", count_task, (void *)0, NULL));
+    }
+    TEST_ASSERT_EQUAL(HAL_STATUS_NO_MEMORY, hal_reactor_add_event("e", count_task, (void *)0, NULL));
+    tearDown();
+}
+
+void test_periodic_tasks_keep_their_rate(void)
+{
+    setUp();
+    int fast = -1;
+    int slow = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("fast", 5, count_task, (void *)0, &fast));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("slow", 50, count_task, (void *)1, &slow));
+    run_for_ms(300);
+    printf(" [fast %d runs, slow %d runs]", g_runs[0], g_runs[1]);
+
+    // Both are due at once, then every period
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(50, g_runs[0]);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(64, g_runs[0]);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(5, g_runs[1]);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(8, g_runs[1]);
+
+    hal_reactor_task_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_task_stats(fast, &stats));
+    TEST_ASSERT_EQUAL_STRING("fast", stats.name);
+    TEST_ASSERT_EQUAL(HAL_REACTOR_TASK_PERIODIC, stats.type);
+    TEST_ASSERT_EQUAL(5, stats.period_ms);
+    TEST_ASSERT_EQUAL(g_runs[0], (int)stats.runs);
+    TEST_ASSERT_EQUAL(0, (int)stats.missed_periods);
+    tearDown();
+}
+
+void test_idle_reactor_sleeps(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("heartbeat", 100, count_task, (void *)0, NULL));
+    run_for_ms(400);
+
+    // One wakeup per run (plus a rare early one), not one per scheduler quantum
+    hal_reactor_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_stats(&stats));
+    printf(" [%llu wakeups, %llu us busy, %llu us idle]", (unsigned long long)stats.wakeups,
+           (unsigned long long)stats.busy_us, (unsigned long long)stats.idle_us);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(10, (int)stats.wakeups);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(3, g_runs[0]);
+    TEST_ASSERT_TRUE(stats.idle_us > stats.busy_us * 10U);
+    TEST_ASSERT_EQUAL(1, (int)stats.task_count);
+    tearDown();
+}
+
+typedef struct {
+    int task_id;
+    uint32_t delay_us;
+    int count;
+} signaller_t;
+
+static void *signaller(void *arg)
+{
+    const signaller_t *s = (const signaller_t *)arg;
+    usleep(s->delay_us);
+    for (int i = 0; i < s->count; i++) {
+        (void)hal_reactor_signal(s->task_id);
+    }
+    return NULL;
+}
+
+void test_signal_from_another_thread(void)
+{
+    setUp();
+    int id = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_event("estop", count_task, (void *)2, &id));
+
+    signaller_t s = { id, 20000, 1 };
+    pthread_t thread;
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, signaller, &s));
+    uint64_t start = hal_time_now_us();
+    // Nothing else is scheduled: the reactor sleeps until the signal
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(1000));
+    uint64_t waited = hal_time_now_us() - start;
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_EQUAL(1, g_runs[2]);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(15000, (int)waited);
+    TEST_ASSERT_LESS_THAN(500000, (int)waited);
+
+    hal_reactor_task_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_task_stats(id, &stats));
+    printf(" [signal-to-run %u us]", stats.max_late_us);
+    TEST_ASSERT_EQUAL(HAL_REACTOR_TASK_EVENT, stats.type);
+    TEST_ASSERT_EQUAL(1, (int)stats.signals);
+    TEST_ASSERT_LESS_THAN(10000, (int)stats.max_late_us);
+    tearDown();
+}
+
+void test_signals_coalesce(void)
+{
+    setUp();
+    int id = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_event("frame", count_task, (void *)2, &id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_signal(id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_signal(id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_signal(id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(0));
+    TEST_ASSERT_EQUAL(1, g_runs[2]);
+
+    // Nothing pending now
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(0));
+    TEST_ASSERT_EQUAL(1, g_runs[2]);
+
+    hal_reactor_task_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_task_stats(id, &stats));
+    TEST_ASSERT_EQUAL(3, (int)stats.signals);
+    TEST_ASSERT_EQUAL(1, (int)stats.runs);
+
+    // A removed event task drops its pending signal
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_signal(id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_remove(id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(0));
+    TEST_ASSERT_EQUAL(1, g_runs[2]);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_signal(id));
+    tearDown();
+}
+
+void test_fd_watcher(void)
+{
+    setUp();
+    int fds[2];
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    int id = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_fd("pipe", fds[0], EPOLLIN, read_pipe, (void *)3, &id));
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(0));
+    TEST_ASSERT_EQUAL(0, g_runs[3]);
+    TEST_ASSERT_EQUAL(1, (int)write(fds[1], "x", 1));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(100));
+    TEST_ASSERT_EQUAL(1, g_runs[3]);
+
+    hal_reactor_task_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_task_stats(id, &stats));
+    TEST_ASSERT_EQUAL(HAL_REACTOR_TASK_FD, stats.type);
+    TEST_ASSERT_EQUAL(1, (int)stats.runs);
+
+    // Unwatched: data stays in the pipe
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_remove(id));
+    TEST_ASSERT_EQUAL(1, (int)write(fds[1], "y", 1));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run_once(20));
+    TEST_ASSERT_EQUAL(1, g_runs[3]);
+    close(fds[0]);
+    close(fds[1]);
+    tearDown();
+}
+
+static void *stopper(void *arg)
+{
+    usleep(*(const uint32_t *)arg);
+    hal_reactor_stop();
+    return NULL;
+}
+
+void test_stop_from_another_thread(void)
+{
+    setUp();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("tick", 10, count_task, (void *)0, NULL));
+    uint32_t delay_us = 100000;
+    pthread_t thread;
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, stopper, &delay_us));
+    uint64_t start = hal_time_now_ms();
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_run());
+    uint64_t elapsed = hal_time_now_ms() - start;
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(90, (int)elapsed);
+    TEST_ASSERT_LESS_THAN(400, (int)elapsed);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(8, g_runs[0]);
+
+    hal_reactor_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_stats(&stats));
+    TEST_ASSERT_FALSE(stats.running);
+    tearDown();
+}
+
+void test_overrun_skips_periods(void)
+{
+    setUp();
+    int id = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("slow", 10, slow_task, (void *)0, &id));
+    run_for_ms(200);
+
+    // Each 35 ms run covers three further periods, which are skipped rather than queued
+    hal_reactor_task_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_task_stats(id, &stats));
+    printf(" [%llu runs, %llu missed]", (unsigned long long)stats.runs, (unsigned long long)stats.missed_periods);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(7, (int)stats.runs);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(2 * (int)(stats.runs - 1U), (int)stats.missed_periods);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(35000, (int)stats.max_us);
+    tearDown();
+}
+
+void test_remove_and_set_period(void)
+{
+    setUp();
+    int id = -1;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("once", 5, self_removing_task, (void *)0, &g_self_remove_id));
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_add_periodic("retimed", 5, count_task, (void *)1, &id));
+    run_for_ms(50);
+    TEST_ASSERT_EQUAL(1, g_runs[0]);
+    TEST_ASSERT_EQUAL(HAL_STATUS_INVALID_PARAMETER, hal_reactor_remove(g_self_remove_id));
+
+    int before = g_runs[1];
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(8, before);
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_set_period(id, 40));
+    run_for_ms(100);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(2, g_runs[1] - before);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(3, g_runs[1] - before);
+
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_reset_stats());
+    hal_reactor_task_stats_t stats;
+    TEST_ASSERT_EQUAL(HAL_STATUS_OK, hal_reactor_get_task_stats(id, &stats));
+    TEST_ASSERT_EQUAL(0, (int)stats.runs);
+    TEST_ASSERT_EQUAL(40, stats.period_ms);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== HAL Reactor Tests ===\n");
+
+    RUN_TEST(test_rejects_bad_parameters);
+    RUN_TEST(test_periodic_tasks_keep_their_rate);
+    RUN_TEST(test_idle_reactor_sleeps);
+    RUN_TEST(test_signal_from_another_thread);
+    RUN_TEST(test_signals_coalesce);
+    RUN_TEST(test_fd_watcher);
+    RUN_TEST(test_stop_from_another_thread);
+    RUN_TEST(test_overrun_skips_periods);
+    RUN_TEST(test_remove_and_set_period);
+
+    UNITY_END();
+    return 0;
+}
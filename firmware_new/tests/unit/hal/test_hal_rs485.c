@@ -37,6 +37,8 @@ void test_modbus_config_validation(void);
 void test_rs485_buffer_size_validation(void);
 void test_modbus_address_validation(void);
 void test_modbus_quantity_validation(void);
+void test_modbus_rtu_expected_frame_length(void);
+void test_modbus_rtu_t35_us(void);
 
 void setUp(void)
 {
@@ -246,6 +248,46 @@ void test_modbus_quantity_validation(void)
     }
 }
 
+void test_modbus_rtu_expected_frame_length(void)
+{
+    // Not enough header bytes yet
+    const uint8_t partial[] = {0x02};
+    TEST_ASSERT_EQUAL(0, modbus_rtu_expected_frame_length(partial, sizeof(partial)));
+    
+    const uint8_t fc03_header[] = {0x02, 0x03};
+    TEST_ASSERT_EQUAL(0, modbus_rtu_expected_frame_length(fc03_header, sizeof(fc03_header)));
+    
+    // FC03/FC04: addr + fc + byte_count + data + crc
+    const uint8_t fc03[] = {0x02, 0x03, 0x14};
+    TEST_ASSERT_EQUAL(25, modbus_rtu_expected_frame_length(fc03, sizeof(fc03)));
+    const uint8_t fc04[] = {0x02, 0x04, 0x02};
+    TEST_ASSERT_EQUAL(7, modbus_rtu_expected_frame_length(fc04, sizeof(fc04)));
+    
+    // FC06/FC10: fixed echo length
+    const uint8_t fc06[] = {0x03, 0x06};
+    TEST_ASSERT_EQUAL(8, modbus_rtu_expected_frame_length(fc06, sizeof(fc06)));
+    const uint8_t fc10[] = {0x03, 0x10};
+    TEST_ASSERT_EQUAL(8, modbus_rtu_expected_frame_length(fc10, sizeof(fc10)));
+    
+    // Exception frames
+    const uint8_t exception[] = {0x04, 0x83};
+    TEST_ASSERT_EQUAL(5, modbus_rtu_expected_frame_length(exception, sizeof(exception)));
+    
+    // Unknown function code falls back to silence detection
+    const uint8_t unknown[] = {0x04, 0x2B, 0x0E};
+    TEST_ASSERT_EQUAL(0, modbus_rtu_expected_frame_length(unknown, sizeof(unknown)));
+}
+
+void test_modbus_rtu_t35_us(void)
+{
+    // Fixed 1.75 ms above 19200 baud
+    TEST_ASSERT_EQUAL(1750, modbus_rtu_t35_us(115200));
+    TEST_ASSERT_EQUAL(1750, modbus_rtu_t35_us(38400));
+    // 3.5 chars * 11 bits at 9600 baud = 4010 us
+    TEST_ASSERT_EQUAL(4010, modbus_rtu_t35_us(9600));
+    TEST_ASSERT_EQUAL(2005, modbus_rtu_t35_us(19200));
+}
+
 // ============================================================================
 // MAIN TEST RUNNER
 // ============================================================================
@@ -281,6 +323,10 @@ int main(void)
     RUN_TEST(test_modbus_address_validation);
     RUN_TEST(test_modbus_quantity_validation);
     
+    // Modbus RTU framing tests
+    RUN_TEST(test_modbus_rtu_expected_frame_length);
+    RUN_TEST(test_modbus_rtu_t35_us);
+    
     UNITY_END();
     return 0;
 }
@@ -0,0 +1,164 @@
+/**
+ * @file test_hal_time.c
+ * @brief Unit tests for the monotonic time base
+ */
+
+#include "unity.h"
+#include "hal_time.h"
+#include "hal_common.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+// Function prototypes
+void setUp(void);
+void tearDown(void);
+void test_monotonic_units_agree(void);
+void test_monotonic_never_goes_back(void);
+void test_coarse_tracks_precise(void);
+void test_tick_latches_now(void);
+void test_wall_clock_mapping(void);
+void test_legacy_timestamps_are_monotonic(void);
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_monotonic_units_agree(void)
+{
+    setUp();
+    uint64_t ns = hal_time_now_ns();
+    uint64_t us = hal_time_now_us();
+    uint64_t ms = hal_time_now_ms();
+    TEST_ASSERT_TRUE(ns > 0);
+    TEST_ASSERT_TRUE(us >= ns / 1000ULL && us - ns / 1000ULL < 100000ULL);
+    TEST_ASSERT_TRUE(ms >= us / 1000ULL && ms - us / 1000ULL < 100ULL);
+
+    // Same clock as CLOCK_MONOTONIC
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t reference_ms = (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+    uint64_t now_ms = hal_time_now_ms();
+    TEST_ASSERT_TRUE(now_ms >= reference_ms);
+    TEST_ASSERT_LESS_THAN(100, now_ms - reference_ms);
+    tearDown();
+}
+
+void test_monotonic_never_goes_back(void)
+{
+    setUp();
+    uint64_t last = hal_time_now_ns();
+    bool backwards = false;
+    for (int i = 0; i < 100000; i++) {
+        uint64_t now = hal_time_now_ns();
+        if (now < last) {
+            backwards = true;
+        }
+        last = now;
+    }
+    TEST_ASSERT_FALSE(backwards);
+
+    uint64_t before = hal_time_now_us();
+    usleep(20000);
+    uint64_t elapsed = hal_time_now_us() - before;
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(20000, elapsed);
+    TEST_ASSERT_LESS_THAN(500000, elapsed);
+    tearDown();
+}
+
+void test_coarse_tracks_precise(void)
+{
+    setUp();
+    uint64_t resolution_ns = hal_time_coarse_resolution_ns();
+    TEST_ASSERT_TRUE(resolution_ns > 0);
+    printf(" [coarse resolution %llu ns]", (unsigned long long)resolution_ns);
+
+    // Same epoch, behind by at most about one step
+    uint64_t slack_ms = resolution_ns / 1000000ULL + 2ULL;
+    uint64_t coarse = hal_time_coarse_ms();
+    uint64_t precise = hal_time_now_ms();
+    TEST_ASSERT_TRUE(coarse <= precise);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(slack_ms, precise - coarse);
+
+    uint64_t before = hal_time_coarse_ms();
+    usleep(30000);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(20, hal_time_coarse_ms() - before);
+    tearDown();
+}
+
+void test_tick_latches_now(void)
+{
+    setUp();
+    uint64_t before = hal_time_now_us();
+    uint64_t tick = hal_time_tick();
+    TEST_ASSERT_TRUE(tick >= before);
+    TEST_ASSERT_TRUE(hal_time_tick_us() == tick);
+    TEST_ASSERT_TRUE(hal_time_tick_ms() == tick / 1000ULL);
+
+    // Readers see the latched value until the next tick
+    usleep(5000);
+    TEST_ASSERT_TRUE(hal_time_tick_us() == tick);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(5000, hal_time_now_us() - tick);
+
+    uint64_t next = hal_time_tick();
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(5000, next - tick);
+    TEST_ASSERT_TRUE(hal_time_tick_us() == next);
+    tearDown();
+}
+
+void test_wall_clock_mapping(void)
+{
+    setUp();
+    uint64_t reference = (uint64_t)time(NULL) * 1000ULL;
+    uint64_t wall = hal_time_wall_ms();
+    TEST_ASSERT_TRUE(wall >= reference);
+    TEST_ASSERT_LESS_THAN(2000, wall - reference);
+
+    // Now maps to now; a timestamp 1.5 s old maps to 1.5 s ago
+    uint64_t mono = hal_time_now_ms();
+    uint64_t mapped_now = hal_time_to_wall_ms(mono);
+    uint64_t wall_now = hal_time_wall_ms();
+    TEST_ASSERT_TRUE(mapped_now + 5ULL >= wall_now && mapped_now <= wall_now + 5ULL);
+    uint64_t mapped_old = hal_time_to_wall_ms(mono - 1500ULL);
+    TEST_ASSERT_GREATER_THAN_OR_EQUAL(1495, mapped_now - mapped_old);
+    TEST_ASSERT_LESS_THAN_OR_EQUAL(1505, mapped_now - mapped_old);
+
+    // Monotonic 0 is boot time, in the past
+    TEST_ASSERT_TRUE(hal_time_to_wall_ms(0) < wall_now);
+    tearDown();
+}
+
+void test_legacy_timestamps_are_monotonic(void)
+{
+    setUp();
+    uint64_t mono = hal_time_now_us();
+    uint64_t legacy = hal_get_timestamp_us();
+    TEST_ASSERT_TRUE(legacy >= mono);
+    TEST_ASSERT_LESS_THAN(100000, legacy - mono);
+    uint64_t legacy_ms = hal_get_timestamp_ms();
+    TEST_ASSERT_TRUE(legacy_ms >= legacy / 1000ULL);
+    TEST_ASSERT_LESS_THAN(100, legacy_ms - legacy / 1000ULL);
+    tearDown();
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    printf("=== HAL Time Tests ===\n");
+
+    RUN_TEST(test_monotonic_units_agree);
+    RUN_TEST(test_monotonic_never_goes_back);
+    RUN_TEST(test_coarse_tracks_precise);
+    RUN_TEST(test_tick_latches_now);
+    RUN_TEST(test_wall_clock_mapping);
+    RUN_TEST(test_legacy_timestamps_are_monotonic);
+
+    UNITY_END();
+    return 0;
+}